@@ -81,6 +81,7 @@ typedef struct NX_Animation {
 typedef struct NX_AnimationLib {
     NX_Animation* animations;       ///< Array of animations included in this library.
     int count;                      ///< Number of animations contained in the library.
+    struct INX_AnimationLibData* internal;  ///< Internal sampling data (bone lookup tables, keyframes laid out for sampling), built on first use when left null.
 } NX_AnimationLib;
 
 // ============================================================================
@@ -93,6 +94,7 @@ extern "C" {
 
 /**
  * @brief Loads animations from a model file.
+ * @note A model cache written by NX_SaveModelCache() is accepted as well.
  * @param filePath Path to the model file containing animations.
  * @param targetFrameRate Desired frame rate (FPS) for sampling the animations.
  * @return Pointer to an array of NX_Animation, or NULL on failure.
@@ -117,6 +119,26 @@ NXAPI NX_AnimationLib* NX_LoadAnimationLibFromData(const void* data, unsigned in
  */
 NXAPI void NX_DestroyAnimationLib(NX_AnimationLib* animLib);
 
+/**
+ * @brief Compresses the keyframes of an animation library for playback.
+ *
+ * Tracks whose keys stay within the tolerance of a constant or of a straight
+ * line are reduced to one or two keys. Other tracks are resampled with
+ * uniformly spaced keys, which drops key times, and quantized to 16 bits per
+ * component, rotations using the smallest three encoding. Tracks that cannot
+ * fit the tolerance this way keep their original keys.
+ *
+ * Players, existing or not, then sample the compressed keys. The keyframe
+ * arrays of the channels are released, their counts set to zero, so
+ * compressing the library again has no effect.
+ *
+ * @param animLib Pointer to the animation library to compress.
+ * @param tolerance Largest difference allowed on a component, in units for translations
+ *                  and scales and on normalized quaternions for rotations. If <= 0, defaults to 1e-3.
+ * @return True on success, false on allocation failure, the library is unchanged then.
+ */
+NXAPI bool NX_CompressAnimationLib(NX_AnimationLib* animLib, float tolerance);
+
 /**
  * @brief Retrieves the index of a named animation within an animation library.
  * @param animLib Pointer to the animation library.
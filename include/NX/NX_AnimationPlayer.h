@@ -11,6 +11,8 @@
 
 #include "./NX_Animation.h"
 #include "./NX_Skeleton.h"
+#include "./NX_Camera.h"
+#include "./NX_Shape.h"
 
 // ============================================================================
 // TYPES DEFINITIONS
@@ -28,6 +30,19 @@ typedef struct NX_AnimationState {
     bool loop;          ///< True to enable looping playback.
 } NX_AnimationState;
 
+/**
+ * @brief Describes a level of detail of an animation player.
+ *
+ * Distant or small models can be animated at a lower rate and with fewer
+ * bones. Between two pose evaluations, poses are interpolated so that the
+ * motion stays smooth.
+ */
+typedef struct NX_AnimationLOD {
+    float maxScreenSize;    ///< Largest fraction of the screen height covered by the model for NX_SelectAnimationPlayerLOD() to pick this level.
+    int updateInterval;     ///< Number of updates between two pose evaluations. If <= 1, poses are evaluated on every update.
+    const bool* boneMask;   ///< Bones to evaluate, one entry per skeleton bone, others keep their bind pose. If NULL, all bones are evaluated.
+} NX_AnimationLOD;
+
 /**
  * @brief Controls playback and blending of animations for a skeleton.
  *
@@ -42,6 +57,8 @@ typedef struct NX_AnimationPlayer {
     const NX_Skeleton* skeleton;    ///< Target skeleton to animate.
     NX_AnimationState* states;      ///< Array of active animation states.
     NX_Mat4* currentPose;           ///< Array of bone transforms representing the blended pose.
+    NX_Mat4* skinningPose;          ///< Bone offsets multiplied by the current pose, NULL unless enabled with NX_SetAnimationPlayerSkinning().
+    struct INX_AnimationPlayerData* internal;   ///< Internal playback data (keyframe cursors, blending buffers).
 } NX_AnimationPlayer;
 
 // ============================================================================
@@ -82,6 +99,78 @@ NXAPI void NX_DestroyAnimationPlayer(NX_AnimationPlayer* player);
  */
 NXAPI void NX_UpdateAnimationPlayer(NX_AnimationPlayer* player, float dt);
 
+/**
+ * @brief Updates several animation players at once, spread across the worker threads.
+ *
+ * Produces the same poses as calling NX_UpdateAnimationPlayer() on each player.
+ * Players are independent, but the same player must not appear twice in the array.
+ *
+ * @param players Array of pointers to the animation players to update.
+ * @param count Number of players in the array.
+ * @param dt Delta time since the last update, in seconds.
+ *
+ * @note The number of worker threads is set by `NX_AppDesc::workerCount`.
+ */
+NXAPI void NX_UpdateAnimationPlayers(NX_AnimationPlayer* const* players, int count, float dt);
+
+/**
+ * @brief Enables or disables the computation of final skinning matrices on update.
+ *
+ * When enabled, each update also multiplies the skeleton bone offsets by the
+ * current pose into `skinningPose`. This work is then done during the update,
+ * possibly on worker threads, and models drawn with this player only copy the
+ * matrices instead of computing them for every draw.
+ *
+ * @param player Pointer to the animation player.
+ * @param enabled True to compute skinning matrices, false to release them.
+ */
+NXAPI void NX_SetAnimationPlayerSkinning(NX_AnimationPlayer* player, bool enabled);
+
+/**
+ * @brief Sets the levels of detail available to an animation player.
+ *
+ * Levels are copied, bone masks included, and must be ordered from the most
+ * to the least detailed, that is by decreasing `maxScreenSize`. The player
+ * is reset to full detail (level -1).
+ *
+ * @param player Pointer to the animation player.
+ * @param lods Array of levels of detail, or NULL to remove them.
+ * @param count Number of levels in the array.
+ */
+NXAPI void NX_SetAnimationPlayerLODs(NX_AnimationPlayer* player, const NX_AnimationLOD* lods, int count);
+
+/**
+ * @brief Selects the level of detail used by the next updates.
+ *
+ * @param player Pointer to the animation player.
+ * @param level Index of the level, clamped to the available ones, or -1 for full detail.
+ */
+NXAPI void NX_SetAnimationPlayerLOD(NX_AnimationPlayer* player, int level);
+
+/**
+ * @brief Returns the level of detail currently used by an animation player.
+ *
+ * @param player Pointer to the animation player.
+ * @return Index of the level, or -1 for full detail.
+ */
+NXAPI int NX_GetAnimationPlayerLOD(const NX_AnimationPlayer* player);
+
+/**
+ * @brief Selects the level of detail from the screen size of a model.
+ *
+ * Projects the bounding sphere of the box with the camera, and selects the
+ * least detailed level whose `maxScreenSize` is not below the fraction of the
+ * screen height it covers. Typically called once per frame before the update.
+ *
+ * @param player Pointer to the animation player.
+ * @param camera Camera the model is seen from.
+ * @param aabb Bounding box of the model in local space, such as `NX_Model::aabb`.
+ * @param transform Transform of the model, or NULL for identity.
+ * @return Index of the selected level, or -1 for full detail.
+ */
+NXAPI int NX_SelectAnimationPlayerLOD(NX_AnimationPlayer* player, const NX_Camera* camera,
+                                      const NX_BoundingBox3D* aabb, const NX_Transform* transform);
+
 #if defined(__cplusplus)
 } // extern "C"
 #endif
@@ -0,0 +1,163 @@
+/* NX_AssetLoader.h -- API declaration for Nexium's asynchronous asset loading module
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef NX_ASSET_LOADER_H
+#define NX_ASSET_LOADER_H
+
+#include "./NX_AudioClip.h"
+#include "./NX_Texture.h"
+#include "./NX_Model.h"
+#include "./NX_Font.h"
+#include "./NX_API.h"
+
+// ============================================================================
+// TYPES DEFINITIONS
+// ============================================================================
+
+/**
+ * @brief Handle of an asset loaded in the background.
+ *
+ * Reading and decoding the file run on the worker threads (see NX_AppDesc::workerCount).
+ * GPU and audio resources are then created on the main thread by NX_FrameStep(), within
+ * the upload budget of each frame (see NX_AppDesc::assets), or at once by NX_WaitAsset().
+ */
+typedef struct NX_AssetRequest NX_AssetRequest;
+
+/**
+ * @brief Loading state of an asset request.
+ */
+typedef enum NX_AssetStatus {
+    NX_ASSET_PENDING,       ///< Still being decoded or uploaded.
+    NX_ASSET_READY,         ///< Loaded, the asset can be retrieved.
+    NX_ASSET_FAILED         ///< Loading failed, no asset was created.
+} NX_AssetStatus;
+
+/**
+ * @brief Function called on the main thread once a request completes, whether it succeeded or not.
+ *
+ * The request can be released from the callback.
+ */
+typedef void (*NX_AssetCallback)(NX_AssetRequest* request, void* userData);
+
+// ============================================================================
+// FUNCTIONS DECLARATIONS
+// ============================================================================
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Starts loading a texture in the background, like NX_LoadTexture().
+ * @param filePath Path to the texture file.
+ * @param callback Optional function called once the request completes.
+ * @param userData Value given back to the callback.
+ * @return Request to query, or NULL on failure. Must be released with NX_ReleaseAssetRequest().
+ */
+NXAPI NX_AssetRequest* NX_LoadTextureAsync(const char* filePath, NX_AssetCallback callback, void* userData);
+
+/**
+ * @brief Starts loading raw texture data in the background, like NX_LoadTextureAsData().
+ * @param filePath Path to the texture file.
+ * @param callback Optional function called once the request completes.
+ * @param userData Value given back to the callback.
+ * @return Request to query, or NULL on failure. Must be released with NX_ReleaseAssetRequest().
+ */
+NXAPI NX_AssetRequest* NX_LoadTextureAsDataAsync(const char* filePath, NX_AssetCallback callback, void* userData);
+
+/**
+ * @brief Starts loading a 3D model in the background, like NX_LoadModel().
+ *
+ * Its meshes and textures are created over several frames if they exceed the upload budget.
+ *
+ * @param filePath Path to the model file.
+ * @param callback Optional function called once the request completes.
+ * @param userData Value given back to the callback.
+ * @return Request to query, or NULL on failure. Must be released with NX_ReleaseAssetRequest().
+ */
+NXAPI NX_AssetRequest* NX_LoadModelAsync(const char* filePath, NX_AssetCallback callback, void* userData);
+
+/**
+ * @brief Starts loading an audio clip in the background, like NX_LoadAudioClip().
+ * @param filePath Path to the clip file (supports WAV, FLAC, MP3, OGG).
+ * @param channelCount Number of channels for polyphony (must be > 0).
+ * @param callback Optional function called once the request completes.
+ * @param userData Value given back to the callback.
+ * @return Request to query, or NULL on failure. Must be released with NX_ReleaseAssetRequest().
+ */
+NXAPI NX_AssetRequest* NX_LoadAudioClipAsync(const char* filePath, int channelCount, NX_AssetCallback callback, void* userData);
+
+/**
+ * @brief Starts loading a font in the background, like NX_LoadFont().
+ *
+ * The initial glyphs are rasterized on a worker, only the atlas texture is created on the main thread.
+ *
+ * @param filePath Path to the font file.
+ * @param type Font type (bitmap or SDF).
+ * @param baseSize Base size of the font in pixels.
+ * @param codepoints Array of Unicode codepoints to load (can be NULL to load default set), copied by the request.
+ * @param codepointCount Number of codepoints in the array.
+ * @param callback Optional function called once the request completes.
+ * @param userData Value given back to the callback.
+ * @return Request to query, or NULL on failure. Must be released with NX_ReleaseAssetRequest().
+ */
+NXAPI NX_AssetRequest* NX_LoadFontAsync(const char* filePath, NX_FontType type, int baseSize,
+                                        const int* codepoints, int codepointCount,
+                                        NX_AssetCallback callback, void* userData);
+
+/**
+ * @brief Returns the loading state of a request.
+ * @param request Request to query.
+ */
+NXAPI NX_AssetStatus NX_GetAssetStatus(const NX_AssetRequest* request);
+
+/**
+ * @brief Returns the texture of a ready request, NULL otherwise.
+ * @note The texture belongs to the caller and must be destroyed with NX_DestroyTexture().
+ */
+NXAPI NX_Texture* NX_GetAssetTexture(const NX_AssetRequest* request);
+
+/**
+ * @brief Returns the model of a ready request, NULL otherwise.
+ * @note The model belongs to the caller and must be destroyed with NX_DestroyModel().
+ */
+NXAPI NX_Model* NX_GetAssetModel(const NX_AssetRequest* request);
+
+/**
+ * @brief Returns the audio clip of a ready request, NULL otherwise.
+ * @note The clip belongs to the caller and must be destroyed with NX_DestroyAudioClip().
+ */
+NXAPI NX_AudioClip* NX_GetAssetAudioClip(const NX_AssetRequest* request);
+
+/**
+ * @brief Returns the font of a ready request, NULL otherwise.
+ * @note The font belongs to the caller and must be destroyed with NX_DestroyFont().
+ */
+NXAPI NX_Font* NX_GetAssetFont(const NX_AssetRequest* request);
+
+/**
+ * @brief Blocks until a request completes, creating its GPU resources without budget.
+ * @param request Request to wait for.
+ * @return Final state of the request, NX_ASSET_READY or NX_ASSET_FAILED.
+ */
+NXAPI NX_AssetStatus NX_WaitAsset(NX_AssetRequest* request);
+
+/**
+ * @brief Releases a request, cancelling it if it is still pending.
+ *
+ * An asset already loaded is not destroyed, it stays owned by the caller.
+ *
+ * @param request Request to release, can be NULL.
+ */
+NXAPI void NX_ReleaseAssetRequest(NX_AssetRequest* request);
+
+#if defined(__cplusplus)
+} // extern "C"
+#endif
+
+#endif // NX_ASSET_LOADER_H
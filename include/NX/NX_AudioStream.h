@@ -11,6 +11,7 @@
 
 #include "./NX_API.h"
 #include <stdbool.h>
+#include <stddef.h>
 
 // ============================================================================
 // TYPES DEFINITIONS
@@ -33,6 +34,14 @@ extern "C" {
  */
 NXAPI NX_AudioStream* NX_LoadAudioStream(const char* filePath);
 
+/**
+ * @brief Load stream from memory
+ * @param data Pointer to the encoded audio data, copied by the stream
+ * @param size Size of the data in bytes
+ * @return Stream pointer on success, NULL on failure
+ */
+NXAPI NX_AudioStream* NX_LoadAudioStreamFromData(const void* data, size_t size);
+
 /**
  * @brief Destroy loaded stream
  * @param stream Stream pointer
@@ -84,6 +93,26 @@ NXAPI bool NX_GetAudioStreamLoop(NX_AudioStream* stream);
  */
 NXAPI void NX_SetAudioStreamLoop(NX_AudioStream* stream, bool loop);
 
+/**
+ * @brief Set the buffering of a stream, stopping it like NX_StopAudioStream()
+ *
+ * More or larger buffers make underruns less likely at the cost of memory.
+ * The defaults are given by NX_AppDesc::audio.
+ *
+ * @param stream Stream pointer
+ * @param bufferCount Number of buffers queued, if <= 1 uses the default
+ * @param bufferFrames Number of frames per buffer, if <= 0 uses the default
+ * @return true on success, false if the buffers could not be created
+ */
+NXAPI bool NX_SetAudioStreamBuffering(NX_AudioStream* stream, int bufferCount, int bufferFrames);
+
+/**
+ * @brief Get the number of times the stream ran out of decoded audio while playing
+ * @param stream Stream pointer
+ * @return Number of underruns since the stream was loaded
+ */
+NXAPI int NX_GetAudioStreamUnderruns(const NX_AudioStream* stream);
+
 /**
  * @brief Get the total duration of the audio stream in seconds.
  * @param stream Pointer to the audio stream.
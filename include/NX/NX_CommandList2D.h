@@ -0,0 +1,67 @@
+/* NX_CommandList2D.h -- API declaration for Nexium's 2D command list module
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef NX_COMMAND_LIST_2D_H
+#define NX_COMMAND_LIST_2D_H
+
+#include "./NX_API.h"
+
+// ============================================================================
+// TYPES DEFINITIONS
+// ============================================================================
+
+/**
+ * @brief Opaque handle to a recorded list of 2D draws.
+ *
+ * Stores the vertices, indices and draw calls produced by the 2D draw
+ * functions called between 'NX_BeginCommandList2D' and 'NX_EndCommandList2D',
+ * uploaded once to static GPU buffers. Replaying the list with
+ * 'NX_DrawCommandList2D' issues its draw calls directly, without generating
+ * any geometry, so static panels or vector maps only pay for it when recorded.
+ */
+typedef struct NX_CommandList2D NX_CommandList2D;
+
+// ============================================================================
+// FUNCTIONS DECLARATIONS
+// ============================================================================
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Creates an empty 2D command list.
+ * @return Pointer to the newly created NX_CommandList2D.
+ */
+NXAPI NX_CommandList2D* NX_CreateCommandList2D(void);
+
+/**
+ * @brief Destroys a 2D command list.
+ * @param list Pointer to the NX_CommandList2D to destroy.
+ */
+NXAPI void NX_DestroyCommandList2D(NX_CommandList2D* list);
+
+/**
+ * @brief Returns the number of draw calls issued when replaying the list.
+ * @param list Pointer to the NX_CommandList2D to query.
+ * @return Number of recorded draw calls, zero for an empty list.
+ */
+NXAPI int NX_GetCommandList2DDrawCount(const NX_CommandList2D* list);
+
+/**
+ * @brief Returns the number of vertices stored by the list.
+ * @param list Pointer to the NX_CommandList2D to query.
+ * @return Number of recorded vertices.
+ */
+NXAPI int NX_GetCommandList2DVertexCount(const NX_CommandList2D* list);
+
+#if defined(__cplusplus)
+} // extern "C"
+#endif
+
+#endif // NX_COMMAND_LIST_2D_H
@@ -49,6 +49,9 @@ extern "C" {
  * @param baseSize Base size of the font in pixels.
  * @param codepoints Array of Unicode codepoints to load (can be NULL to load default set).
  * @param codepointCount Number of codepoints in the array.
+ * @note Codepoints missing from this set are rasterized into the atlas the first time
+ *       they are drawn or measured, the atlas growing if needed. Codepoints that the
+ *       font does not provide are drawn with the '?' glyph.
  * @return Pointer to a newly loaded NX_Font.
  */
 NXAPI NX_Font* NX_LoadFont(const char* filePath, NX_FontType type, int baseSize, const int* codepoints, int codepointCount);
@@ -61,6 +64,9 @@ NXAPI NX_Font* NX_LoadFont(const char* filePath, NX_FontType type, int baseSize,
  * @param baseSize Base size of the font in pixels.
  * @param codepoints Array of Unicode codepoints to load (can be NULL to load default set).
  * @param codepointCount Number of codepoints in the array.
+ * @note Codepoints missing from this set are rasterized into the atlas the first time
+ *       they are drawn or measured, the atlas growing if needed. Codepoints that the
+ *       font does not provide are drawn with the '?' glyph.
  * @return Pointer to a newly loaded NX_Font.
  */
 NXAPI NX_Font* NX_LoadFontFromData(const void* fileData, size_t dataSize, NX_FontType type, int baseSize, const int* codepoints, int codepointCount);
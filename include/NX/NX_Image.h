@@ -35,6 +35,19 @@ typedef enum NX_PixelFormat {
     NX_PIXEL_FORMAT_RGBA32F,    ///< Four channel 32-bit float red-green-blue-alpha
 } NX_PixelFormat;
 
+/**
+ * @brief Resampling filter used to resize images on the CPU
+ *
+ * Filters are widened by the scale factor when downscaling, so every source
+ * pixel contributes to the result.
+ */
+typedef enum NX_ImageFilter {
+    NX_IMAGE_FILTER_BOX,        ///< Average of the covered source pixels, exact for power of two reductions
+    NX_IMAGE_FILTER_BILINEAR,   ///< Triangle filter, smooth and cheap
+    NX_IMAGE_FILTER_LANCZOS,    ///< Lanczos windowed sinc with 3 lobes, sharp but can ring on hard edges
+    NX_IMAGE_FILTER_KAISER,     ///< Kaiser windowed sinc with 3 lobes, sharp with little ringing, good for mipmaps
+} NX_ImageFilter;
+
 /**
  * @brief Image data structure
  */
@@ -278,7 +291,8 @@ NXAPI void NX_InvertImage(const NX_Image* image);
  *
  * Copies and scales a rectangular region from the source image to a rectangular region in the
  * destination image using nearest neighbor sampling with fixed-point 16.16 arithmetic.
- * Regions are automatically clamped to image boundaries.
+ * Regions are automatically clamped to image boundaries. Source and destination may be
+ * the same image, overlapping regions are copied as they were before the blit.
  *
  * @param src Source image to copy from
  * @param srcX Source rectangle X coordinate
@@ -295,6 +309,43 @@ NXAPI void NX_BlitImage(
     const NX_Image* src, int srcX, int srcY, int srcW, int srcH,
     const NX_Image* dst, int dstX, int dstY, int dstW, int dstH);
 
+/**
+ * @brief Creates a resized copy of an image using a separable resampling filter.
+ *
+ * Filtering is done in linear space on floating point values. When 'srgb' is true,
+ * the color channels are decoded from sRGB before filtering and encoded back after,
+ * the alpha channel is always linear. Four channel images are filtered with
+ * premultiplied alpha so that transparent pixels do not bleed into their neighbors.
+ *
+ * Large images are processed by the worker threads of the engine.
+ *
+ * @param image Source image
+ * @param w Width of the new image in pixels
+ * @param h Height of the new image in pixels
+ * @param filter Resampling filter
+ * @param srgb Whether the color channels are sRGB encoded
+ * @return New image with the same pixel format, or an empty image on failure
+ */
+NXAPI NX_Image NX_ResizeImage(const NX_Image* image, int w, int h, NX_ImageFilter filter, bool srgb);
+
+/**
+ * @brief Generates the mip chain of an image.
+ *
+ * The image is decoded once, each level is then filtered from the previous one
+ * and halves its dimensions (rounded down, at least 1) until reaching 1x1.
+ * Filtering rules are the same as for NX_ResizeImage().
+ *
+ * @param image Base image (level 0), it is not included in the output
+ * @param mipmaps Array receiving at most 'maxLevels' levels starting from level 1 (can be NULL to only query the count)
+ * @param maxLevels Capacity of the 'mipmaps' array
+ * @param filter Resampling filter
+ * @param srgb Whether the color channels are sRGB encoded
+ * @return Number of levels below the base image, or written to 'mipmaps', 0 on failure
+ *
+ * @note Each generated level must be released with NX_DestroyImage().
+ */
+NXAPI int NX_GenImageMipmaps(const NX_Image* image, NX_Image* mipmaps, int maxLevels, NX_ImageFilter filter, bool srgb);
+
 /**
  * @brief Get the number of bytes per pixel for a given format
  * @param format The pixel format
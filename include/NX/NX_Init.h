@@ -62,6 +62,7 @@ typedef struct NX_AppDesc {
 
     NX_Flags flags;             ///< Combination of NX_FLAG_XXX values
     int targetFPS;              ///< Target framerate for CPU limiting, if <= 0 no limit is applied
+    int workerCount;            ///< Worker threads for parallel CPU work and asynchronous asset loading, if 0 uses logical cores minus one, if < 0 runs all work on the calling thread
 
     const char* name;           ///< Application name
     const char* version;        ///< Application version string
@@ -76,8 +77,20 @@ typedef struct NX_AppDesc {
     struct {
         NX_IVec2 resolution;    ///< Internal framebuffer dimensions, if component <= 0 uses primary monitor resolution
         int sampleCount;        ///< MSAA sample count for 2D rendering, if <= 1 disables MSAA
+        int batchVertices;      ///< Initial vertex capacity of the 2D batch, doubled when a frame exceeds it, if <= 0 defaults to 16384
+        bool batchIndices32;    ///< Uses 32-bit indices, lifting the limit of 65536 vertices per batch
     } render2D;
 
+    struct {
+        int streamBufferCount;  ///< Buffers queued per audio stream, if <= 1 defaults to 4
+        int streamBufferFrames; ///< Frames decoded per audio stream buffer, if <= 0 defaults to 4096
+        int streamDecoders;     ///< Threads decoding audio streams, if <= 0 defaults to 2
+    } audio;
+
+    struct {
+        float uploadBudget;     ///< Milliseconds per frame spent creating GPU resources of assets loaded asynchronously, if <= 0 defaults to 2
+    } assets;
+
     /**
      * @brief Custom memory allocator functions
      *
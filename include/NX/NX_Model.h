@@ -22,6 +22,11 @@
  * @brief Represents a complete 3D model with meshes and materials.
  *
  * Contains multiple meshes and their associated materials, along with animation or bounding information.
+ *
+ * The material textures can be shared with other loaded models using the same images,
+ * see NX_TextureImportStats. Modifying them through NX_SetTextureParameters(),
+ * NX_UploadTexture() or similar also modifies the other models, assign a new texture
+ * to the material instead.
  */
 typedef struct NX_Model {
 
@@ -39,6 +44,23 @@ typedef struct NX_Model {
 
 } NX_Model;
 
+/**
+ * @brief Statistics of the textures shared between imported models.
+ *
+ * Material textures are identified by their file path, or by the content of
+ * embedded images, along with their sampler and color space. A texture already
+ * used by a loaded model, or by another material of the same model, is reused
+ * instead of being decoded and uploaded again. Hits and bytes saved accumulate
+ * since initialization.
+ */
+typedef struct NX_TextureImportStats {
+    int textures;           ///< Number of shared textures currently alive
+    int references;         ///< Number of material references to them
+    int hits;               ///< Number of times an existing texture was reused
+    int misses;             ///< Number of textures created by the import
+    int64_t bytesSaved;     ///< Pixel data that was not uploaded again thanks to hits, in bytes
+} NX_TextureImportStats;
+
 // ============================================================================
 // FUNCTIONS DECLARATIONS
 // ============================================================================
@@ -63,12 +85,36 @@ NXAPI NX_Model* NX_LoadModel(const char* filePath);
  */
 NXAPI NX_Model* NX_LoadModelFromData(const void* data, size_t size, const char* hint);
 
+/**
+ * @brief Imports a model file and saves it as a model cache.
+ *
+ * The cache holds the meshes, materials, skeleton and animations ready to be
+ * uploaded, with decoded textures, so it is larger than the source file.
+ * NX_LoadModel() and NX_LoadAnimationLib() recognize a cache by its content
+ * and read it without importing anything. A cache is only valid for the
+ * version of Nexium that wrote it, an outdated one fails to load.
+ *
+ * @param modelPath Path to the model file to import.
+ * @param cachePath Path of the cache file to write.
+ * @return true on success, false otherwise.
+ */
+NXAPI bool NX_SaveModelCache(const char* modelPath, const char* cachePath);
+
 /**
  * @brief Destroys a 3D model and frees its resources.
+ *
+ * Textures shared with other models are only destroyed with their last user.
+ *
  * @param model Pointer to the NX_Model to destroy.
  */
 NXAPI void NX_DestroyModel(NX_Model* model);
 
+/**
+ * @brief Gets the statistics of the textures shared between imported models.
+ * @return Current shared textures and references, with the hits and bytes saved since initialization.
+ */
+NXAPI NX_TextureImportStats NX_GetTextureImportStats(void);
+
 /**
  * @brief Updates the axis-aligned bounding box (AABB) of a model.
  *
@@ -27,6 +27,11 @@
 #    include <immintrin.h>
 #endif
 
+#if defined(__F16C__)
+#    define NX_HAS_F16C
+#    include <immintrin.h>
+#endif
+
 #if defined(__AVX2__)
 #    define NX_HAS_AVX2
 #    include <immintrin.h>
@@ -9,7 +9,9 @@
 #ifndef NX_RENDER_2D_H
 #define NX_RENDER_2D_H
 
+#include "./NX_CommandList2D.h"
 #include "./NX_RenderTexture.h"
+#include "./NX_TextLayout.h"
 #include "./NX_Shader2D.h"
 #include "./NX_Texture.h"
 #include "./NX_Vertex.h"
@@ -17,6 +19,33 @@
 #include "./NX_Math.h"
 #include "./NX_API.h"
 
+// ============================================================================
+// TYPES DEFINITIONS
+// ============================================================================
+
+/**
+ * @brief Describes a sprite drawn with 'NX_DrawSprites2D'.
+ */
+typedef struct NX_Sprite2D {
+    NX_Vec2 position;       ///< Position of the sprite center in 2D space
+    NX_Vec2 size;           ///< Width and height of the sprite
+    float rotation;         ///< Rotation around the center, in radians
+    NX_Vec4 uvRect;         ///< Texture region (x, y, width, height) in normalized coordinates, a zero size selects the whole texture
+    NX_Color color;         ///< Color multiplied with the texture
+} NX_Sprite2D;
+
+/**
+ * @brief Statistics of the 2D batching.
+ */
+typedef struct NX_Render2DStats {
+    int flushes;            ///< Number of times the batch was submitted
+    int drawCalls;          ///< Number of draw calls issued
+    int vertices;           ///< Number of vertices submitted
+    int indices;            ///< Number of indices submitted
+    int sprites;            ///< Number of sprite instances submitted
+    int batchCapacity;      ///< Current vertex capacity of a frame, shared by all its flushes
+} NX_Render2DStats;
+
 // ============================================================================
 // FUNCTIONS DECLARATIONS
 // ============================================================================
@@ -41,6 +70,18 @@ NXAPI void NX_Begin2D(NX_RenderTexture* target);
  */
 NXAPI void NX_End2D(void);
 
+/**
+ * @brief Gets the 2D batching statistics of the last frame.
+ *
+ * A flush happens at the end of each 2D pass, when the batch is full, or when
+ * a font atlas is grown. The flushes of a frame follow each other in the same
+ * streamed memory, whose capacity is doubled each time a frame fills it up,
+ * so flushes caused by the capacity should disappear after a few frames.
+ *
+ * @return Statistics of the previous frame, all 2D passes included.
+ */
+NXAPI NX_Render2DStats NX_GetRender2DStats(void);
+
 /**
  * @brief Sets the default color for 2D drawing.
  * @param color Color to use for subsequent 2D drawing operations.
@@ -385,6 +426,79 @@ NXAPI void NX_DrawCodepoints2D(const int* codepoints, int length, NX_Vec2 positi
  */
 NXAPI void NX_DrawText2D(const char* text, NX_Vec2 position, float fontSize, NX_Vec2 spacing);
 
+/**
+ * @brief Draws a precomputed text layout in 2D.
+ *
+ * Glyph quads are copied from the layout into the batch with a single
+ * transform, the current color being applied to all of them. The layout
+ * is only computed again if it was invalidated since the last draw.
+ *
+ * @param layout Text layout to draw, with its own font, size and spacing.
+ * @param position Position of the top-left corner of the text in 2D space.
+ */
+NXAPI void NX_DrawTextLayout2D(const NX_TextLayout* layout, NX_Vec2 position);
+
+/**
+ * @brief Draws a sprite using the current texture and color.
+ *
+ * Sprites are submitted as a single compact instance each and expanded on the
+ * GPU, which is much cheaper than 'NX_DrawRect2D' for large amounts of them.
+ * Custom shaders receive them through the same vertex() and fragment() stages.
+ *
+ * @param position Position of the sprite center in 2D space.
+ * @param size Width and height of the sprite.
+ * @param rotation Rotation around the center, in radians.
+ */
+NXAPI void NX_DrawSprite2D(NX_Vec2 position, NX_Vec2 size, float rotation);
+
+/**
+ * @brief Draws an array of sprites using the current texture.
+ *
+ * Each sprite has its own texture region and color, the current color is ignored.
+ *
+ * @param sprites Array of sprites to draw.
+ * @param count Number of sprites in the array.
+ * @note Rotated sprites under a transform that scales non-uniformly or shears
+ *       are not rectangles anymore, those are drawn as regular quads instead.
+ *       So are sprites whose texture region goes outside of [0, 1], to keep
+ *       the texture wrap mode.
+ */
+NXAPI void NX_DrawSprites2D(const NX_Sprite2D* sprites, int count);
+
+/**
+ * @brief Starts recording the following 2D draws into a command list.
+ *
+ * Draws are recorded in the list space, the current transformation starting
+ * from the identity, and nothing is rendered until the list is drawn. The
+ * previous content of the list is replaced.
+ *
+ * @param list Command list to record into.
+ * @note Only one list can be recorded at a time. Sprites are recorded as quads.
+ *       Glyphs keep their codepoint, their texture coordinates are resolved again
+ *       when the list is drawn after the atlas of their font grew.
+ */
+NXAPI void NX_BeginCommandList2D(NX_CommandList2D* list);
+
+/**
+ * @brief Ends the recording started with 'NX_BeginCommandList2D'.
+ *
+ * The recorded vertices and indices are uploaded once to static GPU buffers.
+ */
+NXAPI void NX_EndCommandList2D(void);
+
+/**
+ * @brief Draws a recorded command list in 2D.
+ *
+ * The list draw calls are issued as they were recorded, transformed and tinted
+ * on the GPU by the current transformation and color, without generating any
+ * geometry. Drawn while recording another list, its content is copied into it.
+ *
+ * @param list Command list to draw.
+ * @param position Position of the list origin in 2D space.
+ * @note The current shader uniforms and textures of each recorded shader are used.
+ */
+NXAPI void NX_DrawCommandList2D(const NX_CommandList2D* list, NX_Vec2 position);
+
 #if defined(__cplusplus)
 } // extern "C"
 #endif
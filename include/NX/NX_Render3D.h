@@ -31,12 +31,59 @@
  *
  * These flags allow enabling or disabling automatic operations such as 
  * frustum culling and draw call sorting for specific rendering passes.
+ *
+ * Sorting uses 64-bit keys and a radix sort, in linear time. NX_RENDER_SORT_OPAQUE
+ * draws opaque objects front-to-back to limit overdraw, NX_RENDER_SORT_STATE draws
+ * them grouped by shader and material first, then front-to-back within a group, to
+ * limit state changes when the frame is CPU bound. It takes precedence when both
+ * are set. Draw calls with equal keys keep their submission order.
+ *
+ * With NX_RENDER_MULTITHREADED, the per draw GPU data and sort keys are
+ * computed in parallel at the end of the pass. The output is identical to the
+ * single threaded path, each draw call always lands in the same slot.
+ *
+ * With NX_RENDER_INSTANCE_CULLING, instanced draws of scene and shadow passes are
+ * culled per instance on the GPU, only the visible instances are drawn. With
+ * NX_RENDER_OCCLUSION_CULLING as well, the instances hidden behind the depth
+ * pre-pass of the scene are also rejected, it has no effect with multisampling.
+ *
+ * With NX_RENDER_MULTI_DRAW, the opaque lit draws of a scene pass that share
+ * their material state, shader and mesh buffer are submitted together with one
+ * multi-draw indirect call. Instanced draws are not grouped. The flag has no
+ * effect when the context does not support multi-draw indirect.
+ *
+ * When the context supports GL_ARB_bindless_texture, material textures are
+ * sampled through resident handles instead of being bound, so draws that only
+ * differ by their material textures are grouped and sorted together.
+ * Otherwise, material textures are stored as layers of texture arrays grouped by
+ * size, format and sampling parameters, and draws whose textures share the same
+ * arrays are grouped the same way. Textures also used outside of materials, such
+ * as render texture colors, keep their own copy next to their layer.
+ * Shaders whose code samples uTexAlbedo, uTexEmission, uTexORM or uTexNormal by
+ * name keep plain bound textures.
  */
 typedef uint32_t NX_RenderFlags;
 
 #define NX_RENDER_FRUSTUM_CULLING          (1 << 0)     ///< Enables naive frustum culling over all draw calls
 #define NX_RENDER_SORT_OPAQUE              (1 << 1)     ///< Sort opaque objects front-to-back
 #define NX_RENDER_SORT_TRANSPARENT         (1 << 2)     ///< Sort transparent objects back-to-front
+#define NX_RENDER_MULTITHREADED            (1 << 3)     ///< Pack draw call data and sort keys on the worker threads
+#define NX_RENDER_OCCLUSION_CULLING        (1 << 4)     ///< Also cull the instances hidden behind the depth pre-pass, needs NX_RENDER_INSTANCE_CULLING
+#define NX_RENDER_INSTANCE_CULLING         (1 << 5)     ///< Cull the instances of instanced draws on the GPU
+#define NX_RENDER_MULTI_DRAW               (1 << 6)     ///< Group compatible opaque draws into multi-draw indirect calls
+#define NX_RENDER_SORT_STATE               (1 << 7)     ///< Sort opaque objects by shader and material, then front-to-back
+
+/**
+ * @brief Describes a multi-draw group of the last scene pass.
+ *
+ * 'savedCalls' counts the renderer calls (state changes, index uniforms and draws)
+ * avoided by submitting the group at once, over both the depth pre-pass and the
+ * lighting pass.
+ */
+typedef struct NX_MultiDrawGroup3D {
+    int drawCount;      ///< Number of draw calls submitted by the group
+    int savedCalls;     ///< Renderer calls avoided compared to drawing each call separately
+} NX_MultiDrawGroup3D;
 
 // ============================================================================
 // FUNCTIONS DECLARATIONS
@@ -102,7 +149,7 @@ NXAPI void NX_End3D(void);
  *               and for correct rendering of billboard shadows. Can be NULL in other cases,
  *               in which case the default camera will be used.
  * @param flags Render flags controlling optional per-pass behaviors 
- *              (currently only affects frustum culling; sorting flags are ignored).
+ *              (affects frustum culling and multithreading; sorting flags are ignored).
  *
  * @note You must call NX_EndShadow3D() to finalize the shadow rendering pass.
  * @note Ensure no other render pass is active when calling this function.
@@ -244,6 +291,17 @@ NXAPI void NX_DrawModelInstanced3D(const NX_Model* model, const NX_InstanceBuffe
  */
 NXAPI void NX_DrawReflectionProbe3D(const NX_IndirectLight* indirectLight, const NX_Probe* probe);
 
+/**
+ * @brief Retrieves the multi-draw groups of the last scene pass.
+ *
+ * Groups are only formed when the pass was begun with NX_RENDER_MULTI_DRAW.
+ *
+ * @param groups Array receiving at most 'maxGroups' groups (can be NULL to only query the count).
+ * @param maxGroups Capacity of the 'groups' array.
+ * @return Number of groups formed by the last NX_End3D().
+ */
+NXAPI int NX_GetMultiDrawGroups3D(NX_MultiDrawGroup3D* groups, int maxGroups);
+
 #if defined(__cplusplus)
 } // extern "C"
 #endif
@@ -61,6 +61,16 @@ NXAPI int NX_GetFPS(void);
  */
 NXAPI void NX_SetTargetFPS(int fps);
 
+/**
+ * @brief Gets the number of texture bind calls issued during the last frame.
+ *
+ * Only calls that actually changed a texture unit are counted. Material textures
+ * sampled through bindless handles are never bound and do not appear here.
+ *
+ * @return Texture bind calls of the previous frame.
+ */
+NXAPI int NX_GetTextureBindCount(void);
+
 /**
  * @brief Sets the vertical synchronization mode.
  *
@@ -0,0 +1,137 @@
+/* NX_SceneObject.h -- API declaration for Nexium's retained scene object module
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef NX_SCENE_OBJECT_H
+#define NX_SCENE_OBJECT_H
+
+#include "./NX_Material.h"
+#include "./NX_Camera.h"
+#include "./NX_Mesh.h"
+#include "./NX_Math.h"
+#include "./NX_API.h"
+
+// ============================================================================
+// TYPES DEFINITIONS
+// ============================================================================
+
+/**
+ * @brief Opaque handle to a retained scene object.
+ *
+ * A scene object keeps a mesh, a material, a transform and a layer mask
+ * alive across frames. Unlike NX_DrawMesh3D(), it does not need to be
+ * submitted every frame: every active scene object is automatically
+ * considered by each 3D render pass (scene, shadow and cubemap).
+ *
+ * Its GPU data lives in a persistent slot and is only re-uploaded
+ * when the object's transform, material or layer mask changes.
+ */
+typedef struct NX_SceneObject NX_SceneObject;
+
+// ============================================================================
+// FUNCTIONS DECLARATIONS
+// ============================================================================
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Creates a new scene object.
+ * @param mesh Mesh to render (must remain valid while the object uses it).
+ * @param material Material to use (can be NULL to use the default material).
+ * @return Pointer to a newly created NX_SceneObject, or NULL on failure.
+ * @note Scene objects are active after creation, with an identity transform and the mesh's layer mask.
+ */
+NXAPI NX_SceneObject* NX_CreateSceneObject(const NX_Mesh* mesh, const NX_Material* material);
+
+/**
+ * @brief Destroys a scene object.
+ * @param object Pointer to the NX_SceneObject to destroy.
+ * @note The mesh and the material resources are not destroyed.
+ */
+NXAPI void NX_DestroySceneObject(NX_SceneObject* object);
+
+/**
+ * @brief Checks if a scene object is active.
+ * @param object Pointer to the NX_SceneObject.
+ * @return true if the object is rendered, false otherwise.
+ */
+NXAPI bool NX_IsSceneObjectActive(const NX_SceneObject* object);
+
+/**
+ * @brief Activates or deactivates a scene object.
+ * @param object Pointer to the NX_SceneObject.
+ * @param active true to render the object, false to skip it.
+ * @note Toggling the active state does not trigger any GPU upload.
+ */
+NXAPI void NX_SetSceneObjectActive(NX_SceneObject* object, bool active);
+
+/**
+ * @brief Gets the mesh rendered by a scene object.
+ * @param object Pointer to the NX_SceneObject.
+ * @return Pointer to the mesh.
+ */
+NXAPI const NX_Mesh* NX_GetSceneObjectMesh(const NX_SceneObject* object);
+
+/**
+ * @brief Sets the mesh rendered by a scene object.
+ * @param object Pointer to the NX_SceneObject.
+ * @param mesh Mesh to render (must remain valid while the object uses it).
+ * @note The mesh's bounding box is read at this point, update the mesh again if it changes.
+ */
+NXAPI void NX_SetSceneObjectMesh(NX_SceneObject* object, const NX_Mesh* mesh);
+
+/**
+ * @brief Gets the material of a scene object.
+ * @param object Pointer to the NX_SceneObject.
+ * @return Copy of the material.
+ */
+NXAPI NX_Material NX_GetSceneObjectMaterial(const NX_SceneObject* object);
+
+/**
+ * @brief Sets the material of a scene object.
+ * @param object Pointer to the NX_SceneObject.
+ * @param material Material to copy (can be NULL to use the default material).
+ * @note Marks the object's material data for re-upload.
+ */
+NXAPI void NX_SetSceneObjectMaterial(NX_SceneObject* object, const NX_Material* material);
+
+/**
+ * @brief Gets the transform of a scene object.
+ * @param object Pointer to the NX_SceneObject.
+ * @return Current transform.
+ */
+NXAPI NX_Transform NX_GetSceneObjectTransform(const NX_SceneObject* object);
+
+/**
+ * @brief Sets the transform of a scene object.
+ * @param object Pointer to the NX_SceneObject.
+ * @param transform New transform.
+ * @note Marks the object's transform data for re-upload.
+ */
+NXAPI void NX_SetSceneObjectTransform(NX_SceneObject* object, const NX_Transform* transform);
+
+/**
+ * @brief Gets the layer mask of a scene object.
+ * @param object Pointer to the NX_SceneObject.
+ * @return Current layer mask.
+ */
+NXAPI NX_Layer NX_GetSceneObjectLayerMask(const NX_SceneObject* object);
+
+/**
+ * @brief Sets the layer mask of a scene object.
+ * @param object Pointer to the NX_SceneObject.
+ * @param layers Layer mask to set, tested against the camera, light or probe cull mask.
+ */
+NXAPI void NX_SetSceneObjectLayerMask(NX_SceneObject* object, NX_Layer layers);
+
+#if defined(__cplusplus)
+} // extern "C"
+#endif
+
+#endif // NX_SCENE_OBJECT_H
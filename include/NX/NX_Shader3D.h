@@ -24,6 +24,34 @@
  */
 typedef struct NX_Shader3D NX_Shader3D;
 
+/**
+ * @brief Bitmask of the programs built from a 3D shader.
+ *
+ * Each variant is compiled the first time a draw needs it, or ahead of time
+ * with NX_PrecompileShader3D().
+ */
+typedef uint32_t NX_Shader3DVariants;
+
+#define NX_SHADER3D_VARIANT_LIT             (1 << 0)    ///< Forward lighting, opaque or transparent
+#define NX_SHADER3D_VARIANT_LIT_PREPASS     (1 << 1)    ///< Forward lighting of opaque objects after the depth pre-pass
+#define NX_SHADER3D_VARIANT_UNLIT           (1 << 2)    ///< Materials using NX_SHADING_UNLIT
+#define NX_SHADER3D_VARIANT_PREPASS         (1 << 3)    ///< Depth pre-pass of opaque objects
+#define NX_SHADER3D_VARIANT_SHADOW          (1 << 4)    ///< Shadow map rendering
+#define NX_SHADER3D_VARIANT_ALL             (0x1F)      ///< Every variant
+
+#define NX_SHADER3D_VARIANT_COUNT           5           ///< Number of variants, in the order of their bits
+
+/**
+ * @brief Compilation state of the variants of a 3D shader.
+ */
+typedef struct NX_Shader3DStats {
+    NX_Shader3DVariants compiled;                   ///< Variants ready to draw
+    NX_Shader3DVariants pending;                    ///< Variants compiling in the background
+    NX_Shader3DVariants failed;                     ///< Variants that failed to compile, they are not retried
+    int compiledCount;                              ///< Number of variants ready to draw
+    float compileTime[NX_SHADER3D_VARIANT_COUNT];   ///< Time taken by each variant to become ready, in milliseconds, 0 if not compiled
+} NX_Shader3DStats;
+
 // ============================================================================
 // FUNCTIONS DECLARATIONS
 // ============================================================================
@@ -126,6 +154,38 @@ NXAPI void NX_UpdateStaticShader3DBuffer(NX_Shader3D* shader, size_t offset, siz
  */
 NXAPI void NX_UpdateDynamicShader3DBuffer(NX_Shader3D* shader, size_t size, const void* data);
 
+/**
+ * @brief Compiles a set of variants of a 3D shader ahead of their first use.
+ *
+ * Variants are otherwise compiled when a draw first needs them, which can
+ * stall that frame. Call this during loading screens for the variants that
+ * will be drawn. Variants already compiled or compiling are skipped.
+ *
+ * With `background` set, and when the driver supports `KHR_parallel_shader_compile`,
+ * the compilation runs on the driver threads and this function returns immediately.
+ * Finished variants are picked up at the end of each frame, a variant drawn before
+ * it finished waits for it. Without driver support, variants are compiled here.
+ *
+ * Programs found in the program cache are loaded instead of being compiled.
+ *
+ * @param shader Pointer to the NX_Shader3D.
+ * @param variants Variants to compile, a combination of NX_SHADER3D_VARIANT_* bits.
+ * @param background Compile on the driver threads when supported.
+ */
+NXAPI void NX_PrecompileShader3D(NX_Shader3D* shader, NX_Shader3DVariants variants, bool background);
+
+/**
+ * @brief Gets the compilation state of the variants of a 3D shader.
+ *
+ * Background compilations that finished since the last frame are picked up first.
+ * The time of a variant compiled in the background covers the whole time it spent
+ * compiling, frames in between included.
+ *
+ * @param shader Pointer to the NX_Shader3D.
+ * @return Compiled, pending and failed variants, with their compile times.
+ */
+NXAPI NX_Shader3DStats NX_GetShader3DStats(NX_Shader3D* shader);
+
 #if defined(__cplusplus)
 } // extern "C"
 #endif
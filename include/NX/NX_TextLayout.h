@@ -0,0 +1,103 @@
+/* NX_TextLayout.h -- API declaration for Nexium's text layout module
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef NX_TEXT_LAYOUT_H
+#define NX_TEXT_LAYOUT_H
+
+#include "./NX_Font.h"
+#include "./NX_Math.h"
+#include "./NX_API.h"
+
+// ============================================================================
+// TYPES DEFINITIONS
+// ============================================================================
+
+/**
+ * @brief Opaque handle to a precomputed text layout.
+ *
+ * Stores the decoded codepoints of a string, its line breaks, the quad of
+ * each visible glyph and the measured bounds. The layout is only computed
+ * again when its text, font, size or spacing changes, so static strings can
+ * be drawn every frame with 'NX_DrawTextLayout2D' without decoding UTF-8 or
+ * looking up glyphs.
+ */
+typedef struct NX_TextLayout NX_TextLayout;
+
+// ============================================================================
+// FUNCTIONS DECLARATIONS
+// ============================================================================
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Creates a text layout.
+ * @param font Font used to lay out the text (can be NULL to use the default font).
+ * @param text Null-terminated UTF-8 string (can be NULL for an empty layout).
+ * @param fontSize Font size in pixels.
+ * @param spacing Additional spacing between characters and lines.
+ * @return Pointer to the newly created NX_TextLayout.
+ * @note The font must outlive the layout, or be replaced before being destroyed.
+ */
+NXAPI NX_TextLayout* NX_CreateTextLayout(const NX_Font* font, const char* text, float fontSize, NX_Vec2 spacing);
+
+/**
+ * @brief Destroys a text layout.
+ * @param layout Pointer to the NX_TextLayout to destroy.
+ */
+NXAPI void NX_DestroyTextLayout(NX_TextLayout* layout);
+
+/**
+ * @brief Replaces the text of the layout.
+ * @param layout Pointer to the NX_TextLayout to modify.
+ * @param text Null-terminated UTF-8 string (can be NULL for an empty layout).
+ * @note The layout is only invalidated if the text differs from the current one.
+ */
+NXAPI void NX_SetTextLayoutText(NX_TextLayout* layout, const char* text);
+
+/**
+ * @brief Replaces the font of the layout.
+ * @param layout Pointer to the NX_TextLayout to modify.
+ * @param font Font to use (can be NULL to use the default font).
+ */
+NXAPI void NX_SetTextLayoutFont(NX_TextLayout* layout, const NX_Font* font);
+
+/**
+ * @brief Sets the font size of the layout.
+ * @param layout Pointer to the NX_TextLayout to modify.
+ * @param fontSize Font size in pixels.
+ */
+NXAPI void NX_SetTextLayoutFontSize(NX_TextLayout* layout, float fontSize);
+
+/**
+ * @brief Sets the spacing of the layout.
+ * @param layout Pointer to the NX_TextLayout to modify.
+ * @param spacing Additional spacing between characters and lines.
+ */
+NXAPI void NX_SetTextLayoutSpacing(NX_TextLayout* layout, NX_Vec2 spacing);
+
+/**
+ * @brief Returns the size of the laid out text.
+ * @param layout Pointer to the NX_TextLayout to query.
+ * @return Width and height of the text, the same as returned by 'NX_MeasureText'.
+ */
+NXAPI NX_Vec2 NX_GetTextLayoutSize(const NX_TextLayout* layout);
+
+/**
+ * @brief Returns the number of lines of the laid out text.
+ * @param layout Pointer to the NX_TextLayout to query.
+ * @return Number of lines, at least one.
+ */
+NXAPI int NX_GetTextLayoutLineCount(const NX_TextLayout* layout);
+
+#if defined(__cplusplus)
+} // extern "C"
+#endif
+
+#endif // NX_TEXT_LAYOUT_H
@@ -43,6 +43,10 @@ typedef enum NX_TextureWrap {
  *
  * Represents a 2D image stored on the GPU.
  * Can be used for material maps or UI elements.
+ *
+ * Material textures of imported models may be shared with other models, see
+ * NX_TextureImportStats. Changing the parameters or the content of such a texture
+ * affects every material using it, replace it with a new texture to only change one.
  */
 typedef struct NX_Texture NX_Texture;
 
@@ -144,6 +148,11 @@ NXAPI NX_Texture* NX_LoadTextureAsData(const char* filePath);
 
 /**
  * @brief Destroys a GPU texture and frees its resources.
+ *
+ * Material textures of imported models can be shared between models, see
+ * NX_TextureImportStats. Each material referencing them releases one reference,
+ * and the texture is only destroyed with the last one.
+ *
  * @param texture Pointer to the NX_Texture to destroy.
  */
 NXAPI void NX_DestroyTexture(NX_Texture* texture);
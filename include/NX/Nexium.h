@@ -60,9 +60,13 @@
 #include "./NX_Animation.h"
 #include "./NX_Filesystem.h"
 #include "./NX_AudioStream.h"
+#include "./NX_SceneObject.h"
+#include "./NX_TextLayout.h"
+#include "./NX_CommandList2D.h"
 #include "./NX_Environment.h"
 #include "./NX_RenderTexture.h"
 #include "./NX_InstanceBuffer.h"
 #include "./NX_IndirectLight.h"
+#include "./NX_AssetLoader.h"
 
 #endif // NEXIUM_H
@@ -30,4 +30,45 @@ struct DrawUnique {
     vec2 texScale;
     int billboard;
     uint layerMask;
+    uvec2 texAlbedo;        //< Bindless handles, or array layers in 'x', zero when textures are bound
+    uvec2 texEmission;
+    uvec2 texORM;
+    uvec2 texNormal;
 };
+
+/* === Draw Indices === */
+
+// The index uniforms only hold a base within multi-draw groups, custom shaders
+// reading them by these names get the record indices of the current draw
+
+#define uDrawSharedIndex DrawSharedIndex
+#define uDrawUniqueIndex vDrawUniqueIndex
+
+/* === Bindless Material Textures === */
+
+// With bindless textures the material samplers are built from the handles
+// of the current draw call, instead of being declared as bound uniforms
+
+#if defined(BINDLESS)
+#define uTexAlbedo sampler2D(sDrawUnique[vDrawUniqueIndex].texAlbedo)
+#define uTexEmission sampler2D(sDrawUnique[vDrawUniqueIndex].texEmission)
+#define uTexORM sampler2D(sDrawUnique[vDrawUniqueIndex].texORM)
+#define uTexNormal sampler2D(sDrawUnique[vDrawUniqueIndex].texNormal)
+#endif
+
+/* === Material Texture Arrays === */
+
+// Without bindless support, the material samplers of the default shaders are
+// texture arrays and the records give the layer of each texture in its array
+
+#if defined(TEXTURE_ARRAYS)
+#define TextureAlbedo(uv) texture(uTexAlbedo, vec3(uv, float(sDrawUnique[vDrawUniqueIndex].texAlbedo.x)))
+#define TextureEmission(uv) texture(uTexEmission, vec3(uv, float(sDrawUnique[vDrawUniqueIndex].texEmission.x)))
+#define TextureORM(uv) texture(uTexORM, vec3(uv, float(sDrawUnique[vDrawUniqueIndex].texORM.x)))
+#define TextureNormal(uv) texture(uTexNormal, vec3(uv, float(sDrawUnique[vDrawUniqueIndex].texNormal.x)))
+#else
+#define TextureAlbedo(uv) texture(uTexAlbedo, uv)
+#define TextureEmission(uv) texture(uTexEmission, uv)
+#define TextureORM(uv) texture(uTexORM, uv)
+#define TextureNormal(uv) texture(uTexNormal, uv)
+#endif
@@ -25,6 +25,11 @@ layout(std140, binding = 0) uniform UniformBlock {
     float uTime;
 };
 
+/* === Uniforms === */
+
+layout(location = 1) uniform vec4 uTint;            //< Command list tint, white otherwise
+layout(location = 2) uniform mat3 uTransform;       //< Command list transform, identity otherwise
+
 /* === Varyings === */
 
 layout(location = 0) out vec2 vPosition;
@@ -0,0 +1,97 @@
+/* sprite.vert -- Sprite vertex shader for instanced overlay rendering
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+/* === Profile Specific === */
+
+#ifdef GL_ES
+precision highp float; //< Sprites are expanded here, positions need full precision
+#endif
+
+/* === Structures === */
+
+struct Sprite {
+    vec2 position;      //< Center of the sprite, already transformed
+    vec2 size;          //< Can be negative to mirror the sprite
+    float rotation;     //< Radians, around the center
+    uint color;         //< RGBA8
+    uint uvMin;         //< Unorm16x2
+    uint uvMax;         //< Unorm16x2
+};
+
+/* === Storage Buffers === */
+
+layout(std430, binding = 0) readonly buffer S_SpriteBuffer {
+    Sprite sSprites[];
+};
+
+/* === Uniform Buffers === */
+
+layout(std140, binding = 0) uniform UniformBlock {
+    mat4 uProjection;
+    float uTime;
+};
+
+/* === Uniforms === */
+
+layout(location = 0) uniform uint uSpriteOffset;
+layout(location = 1) uniform vec4 uTint;            //< Command list tint, white otherwise
+layout(location = 2) uniform mat3 uTransform;       //< Command list transform, identity otherwise
+
+/* === Varyings === */
+
+layout(location = 0) out vec2 vPosition;
+layout(location = 1) out vec2 vTexCoord;
+layout(location = 2) out vec4 vColor;
+
+layout(location = 3) out smooth vec4 vUsrData4f;
+layout(location = 4) out flat ivec4 vUsrData4i;
+
+/* === Constants === */
+
+const vec2 CORNERS[6] = vec2[6](
+    vec2(-0.5, -0.5), vec2(-0.5, +0.5), vec2(+0.5, +0.5),
+    vec2(-0.5, -0.5), vec2(+0.5, +0.5), vec2(+0.5, -0.5)
+);
+
+/* === Inputs === */
+
+// Sprites have no vertex attributes, the inputs of the
+// override are computed from the instance record instead
+
+vec2 aPosition;
+vec2 aTexCoord;
+vec4 aColor;
+
+/* === Vertex Override === */
+
+#include "../override/shape.vert"
+
+/* === Program === */
+
+void main()
+{
+    Sprite sprite = sSprites[uSpriteOffset + uint(gl_InstanceID)];
+
+    vec2 corner = CORNERS[gl_VertexID];
+    vec2 local = corner * sprite.size;
+
+    float c = cos(sprite.rotation);
+    float s = sin(sprite.rotation);
+
+    aPosition = sprite.position + vec2(c * local.x - s * local.y, s * local.x + c * local.y);
+    aTexCoord = mix(unpackUnorm2x16(sprite.uvMin), unpackUnorm2x16(sprite.uvMax), corner + 0.5);
+    aColor = unpackUnorm4x8(sprite.color);
+
+    VertexOverride();
+
+    vPosition = POSITION;
+    vTexCoord = TEXCOORD;
+    vColor = COLOR;
+
+    gl_Position = uProjection * vec4(vec3(POSITION, 0.0), 1.0);
+}
@@ -36,21 +36,21 @@ float NORMAL_SCALE      = 1.0;
 
 void FragmentOverride()
 {
-    DrawUnique drawUnique = sDrawUnique[uDrawUniqueIndex];
+    DrawUnique drawUnique = sDrawUnique[vDrawUniqueIndex];
 
-    ALBEDO = vInt.color * drawUnique.albedoColor * texture(uTexAlbedo, vInt.texCoord);
+    ALBEDO = vInt.color * drawUnique.albedoColor * TextureAlbedo(vInt.texCoord);
 
-    EMISSION = drawUnique.emissionColor * texture(uTexEmission, vInt.texCoord).rgb;
+    EMISSION = drawUnique.emissionColor * TextureEmission(vInt.texCoord).rgb;
     EMISSION *= drawUnique.emissionEnergy;
 
     AO_LIGHT_AFFECT = drawUnique.aoLightAffect;
 
-    vec3 orm = texture(uTexORM, vInt.texCoord).rgb;
+    vec3 orm = TextureORM(vInt.texCoord).rgb;
     OCCLUSION = drawUnique.occlusion * orm.x;
     ROUGHNESS = drawUnique.roughness * orm.y;
     METALNESS = drawUnique.metalness * orm.z;
 
-    NORMAL_MAP = texture(uTexNormal, vInt.texCoord).rgb;
+    NORMAL_MAP = TextureNormal(vInt.texCoord).rgb;
     NORMAL_SCALE = drawUnique.normalScale;
 
     fragment();
@@ -31,7 +31,7 @@ vec4 TANGENT    = vec4(0.0, 0.0, 0.0, 1.0);
 
 void VertexOverride()
 {
-    DrawUnique drawUnique = sDrawUnique[uDrawUniqueIndex];
+    DrawUnique drawUnique = sDrawUnique[vDrawUniqueIndex];
 
     POSITION = aPosition;
     TEXCOORD = drawUnique.texOffset + aTexCoord * drawUnique.texScale;
@@ -28,9 +28,9 @@ vec4 COLOR      = vec4(1.0);
 
 void VertexOverride()
 {
-    POSITION = aPosition;
+    POSITION = (uTransform * vec3(aPosition, 1.0)).xy;
     TEXCOORD = aTexCoord;
-    COLOR = aColor;
+    COLOR = aColor * uTint;
 
     vertex();
 }
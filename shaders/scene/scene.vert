@@ -35,6 +35,7 @@ layout(location = 8) in vec4 iRotation;
 layout(location = 9) in vec3 iScale;
 layout(location = 10) in vec4 iColor;
 layout(location = 11) in vec4 iCustom;
+layout(location = 12) in ivec2 iDrawIndex;
 
 /* === Storage Buffers === */
 
@@ -62,8 +63,9 @@ layout(std140, binding = 1) uniform U_ViewFrustum {
 
 /* === Uniforms === */
 
-layout(location = 0) uniform uint uDrawSharedIndex;
-layout(location = 1) uniform uint uDrawUniqueIndex;
+// Multi-draw groups set both to zero and pass the indices of each draw through 'iDrawIndex'
+layout(location = 0) uniform uint uDrawSharedBase;
+layout(location = 1) uniform uint uDrawUniqueBase;
 
 /* === Varyings === */
 
@@ -74,6 +76,12 @@ layout(location = 0) out VaryInternal {
     mat3 tbn;
 } vInt;
 
+layout(location = 9) flat out uint vDrawUniqueIndex;
+
+/* === Draw Indices === */
+
+uint DrawSharedIndex;   //< Set with 'vDrawUniqueIndex' before anything else
+
 layout(location = 10) out VaryUser {
     smooth vec4 data4f;
     flat ivec4 data4i;
@@ -97,9 +105,17 @@ mat4 SkinMatrix(ivec4 boneIDs, vec4 weights, int offset)
 
 void main()
 {
+    /* --- Get draw call records --- */
+
+    uint drawSharedIndex = uDrawSharedBase + uint(iDrawIndex.x);
+    uint drawUniqueIndex = uDrawUniqueBase + uint(iDrawIndex.y);
+
+    DrawSharedIndex = drawSharedIndex;
+    vDrawUniqueIndex = drawUniqueIndex;
+
     /* --- Calculation of matrices --- */
 
-    DrawShared drawShared = sDrawShared[uDrawSharedIndex];
+    DrawShared drawShared = sDrawShared[drawSharedIndex];
 
     mat4 matModel = drawShared.matModel;
     mat3 matNormal = mat3(drawShared.matNormal);
@@ -116,7 +132,7 @@ void main()
         matNormal = mat3(transpose(inverse(iMatModel))) * matNormal;
     }
 
-    switch(sDrawUnique[uDrawUniqueIndex].billboard) {
+    switch(sDrawUnique[drawUniqueIndex].billboard) {
     case BILLBOARD_NONE:
         break;
     case BILLBOARD_FRONT:
@@ -156,8 +172,8 @@ void main()
 
     /* --- Apply depth offset --- */
 
-    float dOffset = sDrawUnique[uDrawUniqueIndex].depthOffset;
-    float dScale = sDrawUnique[uDrawUniqueIndex].depthScale;
+    float dOffset = sDrawUnique[drawUniqueIndex].depthOffset;
+    float dScale = sDrawUnique[drawUniqueIndex].depthScale;
 
     gl_Position.z = dOffset * gl_Position.w + (gl_Position.z * dScale);
 }
@@ -8,6 +8,10 @@
 
 /* === Profile Specific === */
 
+#if defined(BINDLESS)
+#extension GL_ARB_bindless_texture : require
+#endif
+
 #ifdef GL_ES
 precision highp float;
 precision mediump int;
@@ -94,6 +98,8 @@ layout(location = 0) in VaryInternal {
     mat3 tbn;
 } vInt;
 
+layout(location = 9) flat in uint vDrawUniqueIndex;
+
 layout(location = 10) in VaryUser {
     smooth vec4 data4f;
     flat ivec4 data4i;
@@ -156,10 +162,17 @@ layout(std430, binding = 7) buffer S_IndexBuffer {
 
 /* === Samplers === */
 
+#if defined(TEXTURE_ARRAYS)
+layout(binding = 0) uniform mediump sampler2DArray uTexAlbedo;
+layout(binding = 1) uniform mediump sampler2DArray uTexEmission;
+layout(binding = 2) uniform mediump sampler2DArray uTexORM;
+layout(binding = 3) uniform mediump sampler2DArray uTexNormal;
+#elif !defined(BINDLESS)
 layout(binding = 0) uniform sampler2D uTexAlbedo;
 layout(binding = 1) uniform sampler2D uTexEmission;
 layout(binding = 2) uniform sampler2D uTexORM;
 layout(binding = 3) uniform sampler2D uTexNormal;
+#endif
 
 layout(binding = 4) uniform sampler2D uTexBrdfLut;
 layout(binding = 5) uniform highp samplerCubeArray uTexIrradiance;
@@ -190,8 +203,6 @@ layout(std140, binding = 2) uniform U_Environment {
 
 /* === Uniforms === */
 
-layout(location = 1) uniform uint uDrawUniqueIndex;
-
 #if defined(PREPASS)
 layout(location = 2) uniform vec2 uInvResolution;
 #endif
@@ -233,7 +244,7 @@ vec3 LightDir(uint lightIndex, const in LightParams params)
 {
     /* --- Checking the layer mask for lighting --- */
 
-    if ((sLights[lightIndex].cullMask & sDrawUnique[uDrawUniqueIndex].layerMask) == 0u) {
+    if ((sLights[lightIndex].cullMask & sDrawUnique[vDrawUniqueIndex].layerMask) == 0u) {
         return vec3(0.0);
     }
 
@@ -302,7 +313,7 @@ vec3 LightSpot(uint lightIndex, const in LightParams params)
 {
     /* --- Checking the layer mask for lighting --- */
 
-    if ((sLights[lightIndex].cullMask & sDrawUnique[uDrawUniqueIndex].layerMask) == 0u) {
+    if ((sLights[lightIndex].cullMask & sDrawUnique[vDrawUniqueIndex].layerMask) == 0u) {
         return vec3(0.0);
     }
 
@@ -387,7 +398,7 @@ vec3 LightOmni(uint lightIndex, const in LightParams params)
 {
     /* --- Checking the layer mask for lighting --- */
 
-    if ((sLights[lightIndex].cullMask & sDrawUnique[uDrawUniqueIndex].layerMask) == 0u) {
+    if ((sLights[lightIndex].cullMask & sDrawUnique[vDrawUniqueIndex].layerMask) == 0u) {
         return vec3(0.0);
     }
 
@@ -516,7 +527,7 @@ void main()
     // TODO: Test pre-pass on mobile
 
 //#if defined(GL_ES)
-//    if (ALBEDO.a < sDrawUnique[uDrawUniqueIndex].alphaCutOff) {
+//    if (ALBEDO.a < sDrawUnique[vDrawUniqueIndex].alphaCutOff) {
 //        discard;
 //    }
 //#endif
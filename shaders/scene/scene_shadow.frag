@@ -8,6 +8,10 @@
 
 /* === Profile Specific === */
 
+#if defined(BINDLESS)
+#extension GL_ARB_bindless_texture : require
+#endif
+
 #ifdef GL_ES
 precision highp float;
 #endif
@@ -34,6 +38,8 @@ layout(location = 0) in VaryInternal {
     mat3 tbn;
 } vInt;
 
+layout(location = 9) flat in uint vDrawUniqueIndex;
+
 layout(location = 10) in VaryUser {
     smooth vec4 data4f;
     flat ivec4 data4i;
@@ -47,7 +53,11 @@ layout(std430, binding = 1) buffer S_DrawUniqueBuffer {
 
 /* === Samplers === */
 
+#if defined(TEXTURE_ARRAYS)
+layout(binding = 0) uniform mediump sampler2DArray uTexAlbedo;
+#elif !defined(BINDLESS)
 layout(binding = 0) uniform sampler2D uTexAlbedo;
+#endif
 
 /* === Uniform Buffers === */
 
@@ -55,10 +65,6 @@ layout(std140, binding = 0) uniform U_Frame {
     Frame uFrame;
 };
 
-/* === Uniforms === */
-
-layout(location = 1) uniform uint uDrawUniqueIndex;
-
 /* === Fragments === */
 
 layout(location = 0) out vec4 FragDistance;
@@ -67,8 +73,8 @@ layout(location = 0) out vec4 FragDistance;
 
 void main()
 {
-    float alpha = vInt.color.a * texture(uTexAlbedo, vInt.texCoord).a;
-    if (alpha < sDrawUnique[uDrawUniqueIndex].alphaCutOff) discard;
+    float alpha = vInt.color.a * TextureAlbedo(vInt.texCoord).a;
+    if (alpha < sDrawUnique[vDrawUniqueIndex].alphaCutOff) discard;
 
     float depth = gl_FragCoord.z;
     if (uFrame.lightType != LIGHT_DIR) {
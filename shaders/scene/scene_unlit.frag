@@ -8,6 +8,10 @@
 
 /* === Profile Specific === */
 
+#if defined(BINDLESS)
+#extension GL_ARB_bindless_texture : require
+#endif
+
 #ifdef GL_ES
 precision highp float;
 #endif
@@ -29,6 +33,8 @@ layout(location = 0) in VaryInternal {
     mat3 tbn;
 } vInt;
 
+layout(location = 9) flat in uint vDrawUniqueIndex;
+
 layout(location = 10) in VaryUser {
     smooth vec4 data4f;
     flat ivec4 data4i;
@@ -42,10 +48,17 @@ layout(std430, binding = 1) buffer S_DrawUniqueBuffer {
 
 /* === Samplers === */
 
+#if defined(TEXTURE_ARRAYS)
+layout(binding = 0) uniform mediump sampler2DArray uTexAlbedo;
+layout(binding = 1) uniform mediump sampler2DArray uTexEmission;
+layout(binding = 2) uniform mediump sampler2DArray uTexORM;
+layout(binding = 3) uniform mediump sampler2DArray uTexNormal;
+#elif !defined(BINDLESS)
 layout(binding = 0) uniform sampler2D uTexAlbedo;
 layout(binding = 1) uniform sampler2D uTexEmission;
 layout(binding = 2) uniform sampler2D uTexORM;
 layout(binding = 3) uniform sampler2D uTexNormal;
+#endif
 
 /* === Uniform Buffers === */
 
@@ -61,10 +74,6 @@ layout(std140, binding = 2) uniform U_Environment {
     Environment uEnv;
 };
 
-/* === Uniforms === */
-
-layout(location = 1) uniform uint uDrawUniqueIndex;
-
 /* === Fragments === */
 
 layout(location = 0) out vec4 FragColor;
@@ -83,7 +92,7 @@ void main()
 
     /* --- Alpha cutoff (no pre-pass for unlit opaque) --- */
 
-    if (ALBEDO.a < sDrawUnique[uDrawUniqueIndex].alphaCutOff) {
+    if (ALBEDO.a < sDrawUnique[vDrawUniqueIndex].alphaCutOff) {
         discard;
     }
 
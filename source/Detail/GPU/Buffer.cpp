@@ -22,6 +22,11 @@ void Buffer::Realloc(GLsizeiptr newSize, const void* data) noexcept
         return;
     }
 
+    if (mImmutable) {
+        NX_LOG(E, "GPU: Cannot realloc an immutable buffer (id=%u)", mID);
+        return;
+    }
+
     if (newSize <= 0) {
         NX_LOG(E, "GPU: Invalid buffer size: %lld", static_cast<long long>(newSize));
         return;
@@ -57,6 +62,11 @@ void Buffer::Realloc(GLsizeiptr newSize, bool keepData) noexcept
         return;
     }
 
+    if (mImmutable) {
+        NX_LOG(E, "GPU: Cannot realloc an immutable buffer (id=%u)", mID);
+        return;
+    }
+
     if (newSize <= 0) {
         NX_LOG(E, "GPU: Invalid buffer size: %lld", static_cast<long long>(newSize));
         return;
@@ -240,8 +250,66 @@ bool Buffer::Unmap() noexcept
     return (result == GL_TRUE);
 }
 
+void* Buffer::MapPersistent() noexcept
+{
+    // Not exposed by the GLES headers, same values for the core and EXT versions
+    constexpr GLbitfield MAP_PERSISTENT_BIT = 0x0040;
+    constexpr GLbitfield MAP_COHERENT_BIT = 0x0080;
+
+    if (!IsValid() || mImmutable) {
+        NX_LOG(E, "GPU: Cannot map persistently an invalid or already immutable buffer (id=%u)", mID);
+        return nullptr;
+    }
+
+    BufferStorageProc bufferStorage = GetBufferStorage();
+    if (bufferStorage == nullptr) {
+        NX_LOG(E, "GPU: Persistent mapping requires buffer storage support");
+        return nullptr;
+    }
+
+    const GLbitfield flags = GL_MAP_WRITE_BIT | MAP_PERSISTENT_BIT | MAP_COHERENT_BIT;
+
+    void* ptr = nullptr;
+    Pipeline::WithBufferBind(mTarget, mID, [&]() {
+        // Replaces the mutable data store allocated on creation, previous errors
+        // are cleared first so that only the allocation can fail the check below
+        while (glGetError() != GL_NO_ERROR) { }
+        bufferStorage(mTarget, mSize, nullptr, flags);
+        if (glGetError() != GL_NO_ERROR) {
+            NX_LOG(E, "GPU: Failed to allocate immutable buffer storage (id=%u)", mID);
+            return;
+        }
+        mImmutable = true;
+        ptr = glMapBufferRange(mTarget, 0, mSize, flags);
+        if (!ptr) {
+            NX_LOG(E, "GPU: Failed to map buffer persistently (id=%u)", mID);
+        }
+    });
+
+    return ptr;
+}
+
 /* === Private Implementation === */
 
+Buffer::BufferStorageProc Buffer::GetBufferStorage() noexcept
+{
+    static bool loaded{false};
+    static BufferStorageProc proc{nullptr};
+
+    if (!loaded) {
+        // Core since GL 4.4, on ES only provided by 'GL_EXT_buffer_storage'
+        if (INX_Display.glProfile != SDL_GL_CONTEXT_PROFILE_ES) {
+            proc = reinterpret_cast<BufferStorageProc>(SDL_GL_GetProcAddress("glBufferStorage"));
+        }
+        else if (SDL_GL_ExtensionSupported("GL_EXT_buffer_storage")) {
+            proc = reinterpret_cast<BufferStorageProc>(SDL_GL_GetProcAddress("glBufferStorageEXT"));
+        }
+        loaded = true;
+    }
+
+    return proc;
+}
+
 void Buffer::createBuffer(const void* data, GLenum usage) noexcept
 {
     glGenBuffers(1, &mID);
@@ -63,12 +63,20 @@ public:
 
     bool Unmap() noexcept;
 
+    /** Persistent mapping */
+    void* MapPersistent() noexcept;                                             // Turns the buffer into immutable storage mapped for writing until destruction
+    bool IsImmutable() const noexcept;
+
+    /** Hardware info getters */
+    static bool HasBufferStorage() noexcept;
+
 private:
     /** Member variables */
     GLuint mID{0};
     GLenum mTarget{GL_ARRAY_BUFFER};
     GLsizeiptr mSize{0};
     GLenum mUsage{GL_STATIC_DRAW};
+    bool mImmutable{false};
 
     /** Utility functions */
     void createBuffer(const void* data, GLenum usage) noexcept;
@@ -79,6 +87,10 @@ private:
     static bool IsValidMapAccess(GLbitfield access) noexcept;
     static const char* TargetToString(GLenum target) noexcept;
     static const char* UsageToString(GLenum usage) noexcept;
+
+    /** Extension procs */
+    using BufferStorageProc = void (GLAD_API_PTR*)(GLenum, GLsizeiptr, const void*, GLbitfield);
+    static BufferStorageProc GetBufferStorage() noexcept;
 };
 
 /* === Public Implementation === */
@@ -118,6 +130,7 @@ inline Buffer::Buffer(Buffer&& other) noexcept
     , mTarget(other.mTarget)
     , mSize(other.mSize)
     , mUsage(other.mUsage)
+    , mImmutable(other.mImmutable)
 { }
 
 inline Buffer& Buffer::operator=(Buffer&& other) noexcept
@@ -128,6 +141,7 @@ inline Buffer& Buffer::operator=(Buffer&& other) noexcept
         mTarget = other.mTarget;
         mSize = other.mSize;
         mUsage = other.mUsage;
+        mImmutable = other.mImmutable;
     }
     return *this;
 }
@@ -157,6 +171,16 @@ inline GLenum Buffer::GetUsage() const noexcept
     return mUsage;
 }
 
+inline bool Buffer::IsImmutable() const noexcept
+{
+    return mImmutable;
+}
+
+inline bool Buffer::HasBufferStorage() noexcept
+{
+    return (GetBufferStorage() != nullptr);
+}
+
 inline void Buffer::Reserve(GLsizeiptr size, bool keepData) noexcept
 {
     if (size > mSize) {
@@ -202,6 +226,7 @@ inline bool Buffer::IsValidTarget(GLenum target) noexcept
     case GL_TRANSFORM_FEEDBACK_BUFFER:
     case GL_UNIFORM_BUFFER:
     case GL_SHADER_STORAGE_BUFFER:
+    case GL_DRAW_INDIRECT_BUFFER:
         return true;
     default:
         return false;
@@ -18,6 +18,7 @@
 #include "./Buffer.hpp"
 
 #include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_video.h>
 #include <glad/gles2.h>
 
 #include <initializer_list>
@@ -150,12 +151,16 @@ public:
 
     void DrawElements(GLenum mode, GLenum type, GLsizei count) const noexcept;
     void DrawElements(GLenum mode, GLenum type, GLint first, GLsizei count) const noexcept;
+    void DrawElementsBaseVertex(GLenum mode, GLenum type, GLint first, GLsizei count, GLint baseVertex) const noexcept;
 
     void DrawElementsInstanced(GLenum mode, GLenum type, GLsizei count, GLsizei instanceCount) const noexcept;
     void DrawElementsInstanced(GLenum mode, GLenum type, GLint first, GLsizei count, GLsizei instanceCount) const noexcept;
 
     void DrawArraysIndirect(GLenum mode, const void* indirect) const noexcept;
     void DrawElementsIndirect(GLenum mode, GLenum type, const void* indirect) const noexcept;
+    void DrawArraysIndirect(GLenum mode, const Buffer& commands, size_t offset) const noexcept;
+    void DrawElementsIndirect(GLenum mode, GLenum type, const Buffer& commands, size_t offset) const noexcept;
+    void MultiDrawElementsIndirect(GLenum mode, GLenum type, const Buffer& commands, size_t offset, GLsizei drawCount) const noexcept;
 
     void DispatchCompute(GLuint numGroupsX, GLuint numGroupsY, GLuint numGroupsZ) const noexcept;
     void DispatchComputeIndirect(GLintptr indirect) const noexcept;
@@ -170,6 +175,12 @@ public:
     static int GetStorageBufferOffsetAlignment() noexcept;
     static int GetMaxUniformBufferSize() noexcept;
     static int GetMaxStorageBufferSize() noexcept;
+    static bool HasMultiDrawIndirect() noexcept;
+
+private:
+    /** Entry point of glMultiDrawElementsIndirect, not exposed by the ES loader */
+    using MultiDrawElementsIndirectProc = void (GLAD_API_PTR*)(GLenum, GLenum, const void*, GLsizei, GLsizei);
+    static MultiDrawElementsIndirectProc GetMultiDrawElementsIndirect() noexcept;
 
 private:
     // Prevents reentrancy for 'withXBind' functions
@@ -425,6 +436,8 @@ inline void Pipeline::BindTexture(int slot, const Texture& texture) const noexce
 
     glBindTexture(texture.GetTarget(), texture.GetID());
     sBindTexture[slot] = &texture;
+
+    INX_Frame.textureBinds++;
 }
 
 inline void Pipeline::BindImageTexture(int slot, const Texture& texture, int level, int layer, GLenum access) const noexcept
@@ -461,7 +474,8 @@ inline void Pipeline::BindImageTexture(int slot, const Texture& texture, int lev
 
 inline void Pipeline::BindStorage(int slot, const Buffer& storage) const noexcept
 {
-    SDL_assert(storage.GetTarget() == GL_SHADER_STORAGE_BUFFER);
+    // Vertex buffers can also be read and written by compute shaders
+    SDL_assert(storage.GetTarget() == GL_SHADER_STORAGE_BUFFER || storage.GetTarget() == GL_ARRAY_BUFFER);
     SDL_assert(slot < sBindStorage.size());
 
     BufferRange range(0, storage.GetSize());
@@ -754,6 +768,18 @@ inline void Pipeline::DrawElements(GLenum mode, GLenum type, GLint first, GLsize
     glDrawElements(mode, count, type, reinterpret_cast<const void*>(first * typeSize));
 }
 
+inline void Pipeline::DrawElementsBaseVertex(GLenum mode, GLenum type, GLint first, GLsizei count, GLint baseVertex) const noexcept
+{
+    size_t typeSize = 0;
+    switch (type) {
+        case GL_UNSIGNED_BYTE:  typeSize = 1; break;
+        case GL_UNSIGNED_SHORT: typeSize = 2; break;
+        case GL_UNSIGNED_INT:   typeSize = 4; break;
+        default: break;
+    }
+    glDrawElementsBaseVertex(mode, count, type, reinterpret_cast<const void*>(first * typeSize), baseVertex);
+}
+
 inline void Pipeline::DrawElementsInstanced(GLenum mode, GLenum type, GLsizei count, GLsizei instanceCount) const noexcept
 {
     glDrawElementsInstanced(mode, count, type, nullptr, instanceCount);
@@ -781,6 +807,26 @@ inline void Pipeline::DrawElementsIndirect(GLenum mode, GLenum type, const void*
     glDrawElementsIndirect(mode, type, indirect);
 }
 
+inline void Pipeline::DrawArraysIndirect(GLenum mode, const Buffer& commands, size_t offset) const noexcept
+{
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commands.GetID());
+    glDrawArraysIndirect(mode, reinterpret_cast<const void*>(offset));
+}
+
+inline void Pipeline::DrawElementsIndirect(GLenum mode, GLenum type, const Buffer& commands, size_t offset) const noexcept
+{
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commands.GetID());
+    glDrawElementsIndirect(mode, type, reinterpret_cast<const void*>(offset));
+}
+
+inline void Pipeline::MultiDrawElementsIndirect(GLenum mode, GLenum type, const Buffer& commands, size_t offset, GLsizei drawCount) const noexcept
+{
+    SDL_assert(HasMultiDrawIndirect());
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commands.GetID());
+    GetMultiDrawElementsIndirect()(mode, type, reinterpret_cast<const void*>(offset), drawCount, 0);
+}
+
 inline void Pipeline::DispatchCompute(GLuint numGroupsX, GLuint numGroupsY, GLuint numGroupsZ) const noexcept
 {
     glDispatchCompute(numGroupsX, numGroupsY, numGroupsZ);
@@ -859,6 +905,30 @@ inline int Pipeline::GetMaxStorageBufferSize() noexcept
     return value;
 }
 
+inline bool Pipeline::HasMultiDrawIndirect() noexcept
+{
+    return (GetMultiDrawElementsIndirect() != nullptr);
+}
+
+inline Pipeline::MultiDrawElementsIndirectProc Pipeline::GetMultiDrawElementsIndirect() noexcept
+{
+    static bool loaded{false};
+    static MultiDrawElementsIndirectProc proc{nullptr};
+
+    if (!loaded) {
+        // Core since GL 4.3, on ES the base instance of the commands is only read with 'GL_EXT_base_instance'
+        if (INX_Display.glProfile != SDL_GL_CONTEXT_PROFILE_ES) {
+            proc = reinterpret_cast<MultiDrawElementsIndirectProc>(SDL_GL_GetProcAddress("glMultiDrawElementsIndirect"));
+        }
+        else if (SDL_GL_ExtensionSupported("GL_EXT_multi_draw_indirect") && SDL_GL_ExtensionSupported("GL_EXT_base_instance")) {
+            proc = reinterpret_cast<MultiDrawElementsIndirectProc>(SDL_GL_GetProcAddress("glMultiDrawElementsIndirectEXT"));
+        }
+        loaded = true;
+    }
+
+    return proc;
+}
+
 /* === Private Implementation === */
 
 template <typename F>
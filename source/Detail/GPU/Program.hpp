@@ -17,22 +17,38 @@
 #include "./Shader.hpp"
 
 #include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_video.h>
 #include <glad/gles2.h>
+#include <initializer_list>
 #include <cstring>
 #include <string>
 #include <array>
 
+#ifndef GL_COMPLETION_STATUS_KHR
+#   define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
 namespace gpu {
 
 /* === Declaration === */
 
 class Program {
+public:
+    /** Stage source given to BeginLink(), built with Shader::BuildSource() */
+    struct Source {
+        GLenum stage;
+        const char* code;
+    };
+
 public:
     Program() = default;
 
     template<typename... Shaders>
     explicit Program(const Shaders&... shaders) noexcept;
 
+    /** Takes ownership of an already linked program, such as one loaded from a binary */
+    explicit Program(GLuint linkedProgram) noexcept;
+
     ~Program() noexcept;
 
     Program(const Program&) = delete;
@@ -53,10 +69,22 @@ public:
     /** Set uniform binding point */
     void SetUniformBlockBinding(int blockIndex, uint32_t blockBinding) noexcept;
 
+    /** Compiles and links without waiting for the driver, the program is valid once FinishLink() succeeds */
+    void BeginLink(std::initializer_list<Source> sources) noexcept;
+
+    /** Returns true while the driver threads are still compiling, never without parallel compile support */
+    bool IsLinkPending() const noexcept;
+
+    /** Waits for the link started by BeginLink() and checks it, the program is released on failure */
+    bool FinishLink() noexcept;
+
     /** Simple getters */
     bool IsValid() const noexcept;
     GLuint GetID() const noexcept;
 
+    /** Returns true if KHR/ARB_parallel_shader_compile is supported */
+    static bool HasParallelCompile() noexcept;
+
 private:
     friend class Pipeline;
 
@@ -91,6 +119,7 @@ private:
 
 private:
     GLuint mID{0};
+    bool mLinking{false};   //< Set between BeginLink() and FinishLink()
 
 private:
     mutable util::FixedArray<std::array<uint8_t, 64>> mUniformCache{};
@@ -108,6 +137,15 @@ inline Program::Program(const Shaders&... shaders) noexcept
     }
 }
 
+inline Program::Program(GLuint linkedProgram) noexcept
+    : mID(linkedProgram)
+{
+    if (mID != 0 && !CreateUniformCache()) {
+        NX_LOG(E, "GPU: Failed to create uniform cache");
+        Cleanup();
+    }
+}
+
 inline Program::~Program() noexcept
 {
     Cleanup();
@@ -115,6 +153,7 @@ inline Program::~Program() noexcept
 
 inline Program::Program(Program&& other) noexcept
     : mID(std::exchange(other.mID, 0))
+    , mLinking(std::exchange(other.mLinking, false))
     , mUniformCache(std::move(other.mUniformCache))
 { }
 
@@ -123,6 +162,7 @@ inline Program& Program::operator=(Program&& other) noexcept
     if (this != &other) {
         Cleanup();
         mID = std::exchange(other.mID, 0);
+        mLinking = std::exchange(other.mLinking, false);
         mUniformCache = std::move(other.mUniformCache);
     }
     return *this;
@@ -160,9 +200,97 @@ inline void Program::SetUniformBlockBinding(int blockIndex, uint32_t blockBindin
     glUniformBlockBinding(mID, blockIndex, blockBinding);
 }
 
+inline void Program::BeginLink(std::initializer_list<Source> sources) noexcept
+{
+    Cleanup();
+
+    mID = glCreateProgram();
+    if (mID == 0) {
+        NX_LOG(E, "GPU: Failed to create program object");
+        return;
+    }
+
+    // No status is queried here, so the driver can compile on its own threads
+    for (const Source& source : sources) {
+        GLuint shader = glCreateShader(source.stage);
+        glShaderSource(shader, 1, &source.code, nullptr);
+        glCompileShader(shader);
+        glAttachShader(mID, shader);
+        glDeleteShader(shader);     //< Released once detached by FinishLink()
+    }
+
+    glProgramParameteri(mID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glLinkProgram(mID);
+
+    mLinking = true;
+}
+
+inline bool Program::IsLinkPending() const noexcept
+{
+    if (!mLinking || !HasParallelCompile()) {
+        return false;
+    }
+
+    GLint completed = GL_TRUE;
+    glGetProgramiv(mID, GL_COMPLETION_STATUS_KHR, &completed);
+
+    return (completed == GL_FALSE);
+}
+
+inline bool Program::FinishLink() noexcept
+{
+    if (!mLinking) {
+        return IsValid();
+    }
+
+    mLinking = false;
+
+    GLint success = GL_FALSE;
+    glGetProgramiv(mID, GL_LINK_STATUS, &success);
+
+    /* --- Report the stages that failed, then release them --- */
+
+    GLuint shaders[8]{};
+    GLsizei shaderCount = 0;
+    glGetAttachedShaders(mID, 8, &shaderCount, shaders);
+
+    for (GLsizei i = 0; i < shaderCount; i++) {
+        GLint compiled = GL_TRUE;
+        glGetShaderiv(shaders[i], GL_COMPILE_STATUS, &compiled);
+        if (!compiled) {
+            GLint logLength = 0;
+            glGetShaderiv(shaders[i], GL_INFO_LOG_LENGTH, &logLength);
+            std::string errorLog(NX_MAX(logLength, 1), '\0');
+            glGetShaderInfoLog(shaders[i], logLength, nullptr, errorLog.data());
+            NX_LOG(E, "GPU: Failed to compile shader:\n%s", errorLog.c_str());
+        }
+        glDetachShader(mID, shaders[i]);
+    }
+
+    /* --- Check the link --- */
+
+    if (!success) {
+        GLint logLength = 0;
+        glGetProgramiv(mID, GL_INFO_LOG_LENGTH, &logLength);
+        std::string errorLog(NX_MAX(logLength, 1), '\0');
+        glGetProgramInfoLog(mID, logLength, nullptr, errorLog.data());
+        NX_LOG(E, "GPU: Failed to link program: %s", errorLog.c_str());
+        Cleanup();
+        return false;
+    }
+
+    if (!CreateUniformCache()) {
+        NX_LOG(E, "GPU: Failed to create uniform cache");
+        Cleanup();
+        return false;
+    }
+
+    return true;
+}
+
 inline bool Program::IsValid() const noexcept
 {
-    return (mID > 0);
+    return (mID > 0 && !mLinking);
 }
 
 inline GLuint Program::GetID() const noexcept
@@ -170,6 +298,34 @@ inline GLuint Program::GetID() const noexcept
     return mID;
 }
 
+inline bool Program::HasParallelCompile() noexcept
+{
+    static bool loaded{false};
+    static bool supported{false};
+
+    if (!loaded) {
+        using MaxShaderCompilerThreadsProc = void (GLAD_API_PTR*)(GLuint count);
+        MaxShaderCompilerThreadsProc proc{nullptr};
+
+        if (SDL_GL_ExtensionSupported("GL_KHR_parallel_shader_compile")) {
+            proc = reinterpret_cast<MaxShaderCompilerThreadsProc>(SDL_GL_GetProcAddress("glMaxShaderCompilerThreadsKHR"));
+        }
+        else if (SDL_GL_ExtensionSupported("GL_ARB_parallel_shader_compile")) {
+            proc = reinterpret_cast<MaxShaderCompilerThreadsProc>(SDL_GL_GetProcAddress("glMaxShaderCompilerThreadsARB"));
+        }
+
+        // Lets the driver pick its number of compiler threads
+        if (proc != nullptr) {
+            proc(0xFFFFFFFF);
+            supported = true;
+        }
+
+        loaded = true;
+    }
+
+    return supported;
+}
+
 /* === Private Implementation === */
 
 inline void Program::SetUint1(int location, uint32_t value) const noexcept
@@ -422,6 +578,9 @@ inline bool Program::InitProgram(const Shaders&... shaders) noexcept
 
     (glAttachShader(mID, shaders.GetID()), ...);
 
+    // Allows the linked program to be stored in the program binary cache
+    glProgramParameteri(mID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
     if (!LinkProgram()) {
         NX_LOG(E, "GPU: Failed to link program");
         return false;
@@ -573,6 +732,7 @@ inline void Program::Cleanup() noexcept
         glDeleteProgram(mID);
         mID = 0;
     }
+    mLinking = false;
 }
 
 } // namespace gpu
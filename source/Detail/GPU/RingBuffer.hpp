@@ -0,0 +1,223 @@
+/* RingBuffer.hpp -- Allows high-level management of buffers streamed every frame
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef NX_GPU_RING_BUFFER_HPP
+#define NX_GPU_RING_BUFFER_HPP
+
+#include "../Util/DynamicArray.hpp"
+#include "./Buffer.hpp"
+
+#include <array>
+
+namespace gpu {
+
+/* === Declaration === */
+
+/**
+ * Buffer split in one segment per frame in flight, written by the CPU while the
+ * GPU reads the segments of the previous frames. Within a frame, each commit
+ * sub-allocates the segment after the previous one, so any number of flushes
+ * share the segment. The segment is fenced once at the end of the frame and only
+ * waited on when the ring comes back to it, frames in flight later.
+ *
+ * With buffer storage support the whole buffer is persistently mapped, data
+ * is written directly in GPU-visible memory and committing costs nothing.
+ * Otherwise data is written in a CPU copy uploaded in the segment on commit.
+ */
+class RingBuffer {
+public:
+    static constexpr int SegmentCount = 3;     //< Frames in flight
+
+public:
+    /** Constructors */
+    RingBuffer() = default;
+    RingBuffer(GLenum target, GLsizeiptr segmentSize) noexcept;
+
+    /** Destructor and Move semantics */
+    ~RingBuffer() noexcept;
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+    RingBuffer(RingBuffer&& other) noexcept;
+    RingBuffer& operator=(RingBuffer&& other) noexcept;
+
+    /** Getters */
+    bool IsValid() const noexcept;
+    bool IsPersistent() const noexcept;
+    Buffer& GetBuffer() noexcept;
+    const Buffer& GetBuffer() const noexcept;
+    GLsizeiptr GetSegmentSize() const noexcept;
+    GLsizeiptr GetAvailable() const noexcept;   // Bytes left in the current segment after the committed ones
+
+    /** Streaming */
+    void* Acquire() noexcept;                   // Returns the memory following the committed data, waiting for the GPU to be done reading the segment when starting it
+    GLintptr Commit(GLsizeiptr size) noexcept;  // Makes the 'size' bytes written after the previous commit visible to the GPU, returns their offset in the buffer
+    void Advance() noexcept;                    // Fences the current segment once the frame reading it is submitted and moves to the next one
+
+private:
+    void ReleaseFences() noexcept;
+
+private:
+    Buffer mBuffer{};
+    util::DynamicArray<uint8_t> mStaging{};     //< Used when buffer storage is not supported
+    std::array<GLsync, SegmentCount> mFences{};
+    uint8_t* mMapped{nullptr};
+    GLsizeiptr mSegmentSize{0};
+    GLsizeiptr mCursor{0};                      //< Committed bytes of the current segment
+    int mSegment{0};
+};
+
+/* === Public Implementation === */
+
+inline RingBuffer::RingBuffer(GLenum target, GLsizeiptr segmentSize) noexcept
+    : mBuffer(target, SegmentCount * segmentSize, nullptr, GL_STREAM_DRAW)
+    , mSegmentSize(segmentSize)
+{
+    if (!mBuffer.IsValid()) {
+        return;
+    }
+
+    if (Buffer::HasBufferStorage()) {
+        mMapped = static_cast<uint8_t*>(mBuffer.MapPersistent());
+        if (mMapped != nullptr) {
+            return;
+        }
+        // The storage may have been made immutable before the mapping failed
+        mBuffer = Buffer(target, SegmentCount * segmentSize, nullptr, GL_STREAM_DRAW);
+        NX_LOG(W, "GPU: Falling back to uploaded ring buffer segments");
+    }
+
+    if (!mStaging.Resize(segmentSize)) {
+        NX_LOG(E, "GPU: Ring buffer staging memory allocation failed (requested: %lld bytes)",
+               static_cast<long long>(segmentSize));
+    }
+}
+
+inline RingBuffer::~RingBuffer() noexcept
+{
+    ReleaseFences();
+}
+
+inline RingBuffer::RingBuffer(RingBuffer&& other) noexcept
+    : mBuffer(std::move(other.mBuffer))
+    , mStaging(std::move(other.mStaging))
+    , mFences(std::exchange(other.mFences, {}))
+    , mMapped(std::exchange(other.mMapped, nullptr))
+    , mSegmentSize(other.mSegmentSize)
+    , mCursor(other.mCursor)
+    , mSegment(other.mSegment)
+{ }
+
+inline RingBuffer& RingBuffer::operator=(RingBuffer&& other) noexcept
+{
+    if (this != &other) {
+        ReleaseFences();
+        mBuffer = std::move(other.mBuffer);
+        mStaging = std::move(other.mStaging);
+        mFences = std::exchange(other.mFences, {});
+        mMapped = std::exchange(other.mMapped, nullptr);
+        mSegmentSize = other.mSegmentSize;
+        mCursor = other.mCursor;
+        mSegment = other.mSegment;
+    }
+    return *this;
+}
+
+inline bool RingBuffer::IsValid() const noexcept
+{
+    return mBuffer.IsValid();
+}
+
+inline bool RingBuffer::IsPersistent() const noexcept
+{
+    return (mMapped != nullptr);
+}
+
+inline Buffer& RingBuffer::GetBuffer() noexcept
+{
+    return mBuffer;
+}
+
+inline const Buffer& RingBuffer::GetBuffer() const noexcept
+{
+    return mBuffer;
+}
+
+inline GLsizeiptr RingBuffer::GetSegmentSize() const noexcept
+{
+    return mSegmentSize;
+}
+
+inline GLsizeiptr RingBuffer::GetAvailable() const noexcept
+{
+    return mSegmentSize - mCursor;
+}
+
+inline void* RingBuffer::Acquire() noexcept
+{
+    if (mMapped == nullptr) {
+        return mStaging.GetData() + mCursor;
+    }
+
+    GLsync& fence = mFences[mSegment];
+
+    if (fence != nullptr) {
+        // Segments are three frames old, this should almost never block
+        GLenum status = glClientWaitSync(fence, 0, 0);
+        while (status == GL_TIMEOUT_EXPIRED) {
+            status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+        }
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    return mMapped + mSegment * mSegmentSize + mCursor;
+}
+
+inline GLintptr RingBuffer::Commit(GLsizeiptr size) noexcept
+{
+    SDL_assert(size <= GetAvailable());
+
+    const GLintptr offset = mSegment * mSegmentSize + mCursor;
+
+    if (mMapped == nullptr && size > 0) {
+        mBuffer.Upload(offset, size, mStaging.GetData() + mCursor);
+    }
+
+    mCursor += size;
+
+    return offset;
+}
+
+inline void RingBuffer::Advance() noexcept
+{
+    if (mMapped != nullptr) {
+        if (mFences[mSegment] != nullptr) {
+            glDeleteSync(mFences[mSegment]); //< Segment advanced without being acquired
+        }
+        mFences[mSegment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    mSegment = (mSegment + 1) % SegmentCount;
+    mCursor = 0;
+}
+
+/* === Private Implementation === */
+
+inline void RingBuffer::ReleaseFences() noexcept
+{
+    for (GLsync& fence : mFences) {
+        if (fence != nullptr) {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+}
+
+} // namespace gpu
+
+#endif // NX_GPU_RING_BUFFER_HPP
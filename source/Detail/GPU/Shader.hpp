@@ -28,6 +28,7 @@ class Shader {
 public:
     Shader() = default;
     explicit Shader(GLenum stage, const char* source, std::initializer_list<const char*> defines = {}) noexcept;
+    explicit Shader(GLenum stage, const std::string& builtSource) noexcept;  //< Source from 'BuildSource()'
     ~Shader() noexcept;
 
     Shader(const Shader&) = delete;
@@ -40,6 +41,12 @@ public:
     GLuint GetID() const noexcept;
     GLenum GetStage() const noexcept;
 
+    /** Returns the source given to the driver, with the version directive and the defines */
+    static std::string BuildSource(const char* source, std::initializer_list<const char*> defines = {});
+
+private:
+    void Compile(const char* builtSource) noexcept;
+
 private:
     GLuint mID{0};
     GLenum mStage{};
@@ -59,17 +66,57 @@ inline Shader::Shader(GLenum stage, const char* source, std::initializer_list<co
         return;
     }
 
-    /* --- Creating the shader --- */
+    Compile(BuildSource(source, defines).c_str());
+}
 
-    mID = glCreateShader(stage);
-    if (mID == 0) {
-        NX_LOG(E, "GPU: Failed to create shader object");
-        SDL_assert(false);
-        return;
+inline Shader::Shader(GLenum stage, const std::string& builtSource) noexcept
+    : mStage(stage)
+{
+    Compile(builtSource.c_str());
+}
+
+inline Shader::~Shader() noexcept
+{
+    if (mID != 0) {
+        glDeleteShader(mID);
+        mID = 0;
+    }
+}
+
+inline Shader::Shader(Shader&& other) noexcept
+    : mID(std::exchange(other.mID, 0))
+    , mStage(other.mStage)
+{ }
+
+inline Shader& Shader::operator=(Shader&& other) noexcept
+{
+    if (this != &other) {
+        if (mID != 0) {
+            glDeleteShader(mID);
+        }
+        mID = std::exchange(other.mID, 0);
+        mStage = other.mStage;
     }
+    return *this;
+}
+
+inline bool Shader::IsValid() const noexcept
+{
+    return (mID > 0);
+}
 
-    /* --- Building final source with defines --- */
+inline GLuint Shader::GetID() const noexcept
+{
+    return mID;
+}
 
+inline GLenum Shader::GetStage() const noexcept
+{
+    return mStage;
+}
+
+inline std::string Shader::BuildSource(const char* source, std::initializer_list<const char*> defines)
+{
     std::string finalSource;
 
     if (INX_Display.glProfile == SDL_GL_CONTEXT_PROFILE_ES) {
@@ -87,12 +134,29 @@ inline Shader::Shader(GLenum stage, const char* source, std::initializer_list<co
         }
     }
 
-    finalSource += source;
+    if (source) {
+        finalSource += source;
+    }
+
+    return finalSource;
+}
+
+/* === Private Implementation === */
+
+inline void Shader::Compile(const char* builtSource) noexcept
+{
+    /* --- Creating the shader --- */
+
+    mID = glCreateShader(mStage);
+    if (mID == 0) {
+        NX_LOG(E, "GPU: Failed to create shader object");
+        SDL_assert(false);
+        return;
+    }
 
     /* --- Compiling the shader --- */
 
-    const char* finalSourcePtr = finalSource.c_str();
-    glShaderSource(mID, 1, &finalSourcePtr, nullptr);
+    glShaderSource(mID, 1, &builtSource, nullptr);
     glCompileShader(mID);
 
     /* --- Compilation Check --- */
@@ -107,10 +171,10 @@ inline Shader::Shader(GLenum stage, const char* source, std::initializer_list<co
         if (logLength > 0) {
             std::string errorLog(logLength, '\0');
             glGetShaderInfoLog(mID, logLength, nullptr, errorLog.data());
-            NX_LOG(E, "GPU: Failed to compile %s shader:\n%s", StageToString(stage), errorLog.c_str());
+            NX_LOG(E, "GPU: Failed to compile %s shader:\n%s", StageToString(mStage), errorLog.c_str());
         }
         else {
-            NX_LOG(E, "GPU: Failed to compile %s shader (no error log available)", StageToString(stage));
+            NX_LOG(E, "GPU: Failed to compile %s shader (no error log available)", StageToString(mStage));
         }
 
         glDeleteShader(mID);
@@ -120,46 +184,6 @@ inline Shader::Shader(GLenum stage, const char* source, std::initializer_list<co
     }
 }
 
-inline Shader::~Shader() noexcept
-{
-    if (mID != 0) {
-        glDeleteShader(mID);
-        mID = 0;
-    }
-}
-
-inline Shader::Shader(Shader&& other) noexcept
-    : mID(std::exchange(other.mID, 0))
-    , mStage(other.mStage)
-{ }
-
-inline Shader& Shader::operator=(Shader&& other) noexcept
-{
-    if (this != &other) {
-        if (mID != 0) {
-            glDeleteShader(mID);
-        }
-        mID = std::exchange(other.mID, 0);
-        mStage = other.mStage;
-    }
-    return *this;
-}
-
-inline bool Shader::IsValid() const noexcept
-{
-    return (mID > 0);
-}
-
-inline GLuint Shader::GetID() const noexcept
-{
-    return mID;
-}
-
-inline GLenum Shader::GetStage() const noexcept
-{
-    return mStage;
-}
-
 inline const char* Shader::StageToString(GLenum stage) noexcept
 {
     switch (stage) {
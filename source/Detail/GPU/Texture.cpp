@@ -22,6 +22,8 @@ Texture::Texture(const TextureConfig& config, const TextureParam& param) noexcep
         return;
     }
 
+    BumpRevision();
+
     Pipeline::WithTextureBind(mTarget, mID,
         [&]()
         {
@@ -68,6 +70,9 @@ void Texture::Realloc(const TextureConfig& config) noexcept
         return;
     }
 
+    ReleaseBindlessHandle(false);
+    BumpRevision();
+
     Pipeline::WithTextureBind(mTarget, mID,
         [&]()
         {
@@ -176,6 +181,8 @@ void Texture::Upload(const void* data, int depth, int level) noexcept
     region.depth = depth;
     region.level = level;
 
+    BumpRevision();
+
     Pipeline::WithTextureBind(mTarget, mID, [&]() {
         UploadData_Bound(data, region);
     });
@@ -185,6 +192,8 @@ void Texture::Upload(const void* data, const UploadRegion& region) noexcept
 {
     SDL_assert(IsValid() && "Cannot upload data to invalid texture"); // NOLINT
 
+    BumpRevision();
+
     Pipeline::WithTextureBind(mTarget, mID, [&]() {
         UploadData_Bound(data, region);
     });
@@ -195,6 +204,8 @@ void Texture::UploadCube(const void* const* data, int level) noexcept
     SDL_assert(IsValid() && "Cannot upload cube data to invalid texture"); // NOLINT
     SDL_assert(mTarget == GL_TEXTURE_CUBE_MAP);
 
+    BumpRevision();
+
     Pipeline::WithTextureBind(mTarget, mID, [&]() {
         GLenum format, type;
         GetFormatAndType(mInternalFormat, format, type);
@@ -209,6 +220,9 @@ void Texture::SetMipLevelRange(int baseLevel, int maxLevel) noexcept
 {
     SDL_assert(IsValid() && "Cannot set sampling levels on invalid texture"); // NOLINT
 
+    ReleaseBindlessHandle(true);
+    BumpRevision();
+
     Pipeline::WithTextureBind(mTarget, mID, [&]() {
         SetMipLevelRange_Bound(baseLevel, maxLevel);
     });
@@ -223,6 +237,8 @@ void Texture::SetParameters(const TextureParam& parameters) noexcept
     }
 
     mParameters = parameters;
+    ReleaseBindlessHandle(true);
+    BumpRevision();
 
     Pipeline::WithTextureBind(mTarget, mID, [&]() {
         SetFilter_Bound(parameters.minFilter, parameters.magFilter);
@@ -242,6 +258,8 @@ void Texture::SetWrap(GLenum sWrap, GLenum tWrap, GLenum rWrap) noexcept
     mParameters.sWrap = sWrap;
     mParameters.tWrap = tWrap;
     mParameters.rWrap = rWrap;
+    ReleaseBindlessHandle(true);
+    BumpRevision();
 
     Pipeline::WithTextureBind(mTarget, mID, [&]() {
         SetWrap_Bound(sWrap, tWrap, rWrap);
@@ -258,6 +276,8 @@ void Texture::SetFilter(GLenum minFilter, GLenum magFilter) noexcept
 
     mParameters.minFilter = minFilter;
     mParameters.magFilter = magFilter;
+    ReleaseBindlessHandle(true);
+    BumpRevision();
 
     Pipeline::WithTextureBind(mTarget, mID, [&]() {
         SetFilter_Bound(minFilter, magFilter);
@@ -273,6 +293,8 @@ void Texture::SetAnisotropy(float anisotropy) noexcept
     }
 
     mParameters.anisotropy = anisotropy;
+    ReleaseBindlessHandle(true);
+    BumpRevision();
 
     Pipeline::WithTextureBind(mTarget, mID, [&]() {
         SetAnisotropy_Bound(anisotropy);
@@ -283,13 +305,111 @@ void Texture::GenerateMipmap() noexcept
 {
     SDL_assert(IsValid() && "Cannot generate mipmap on invalid texture"); // NOLINT
 
+    BumpRevision();
+
     Pipeline::WithTextureBind(mTarget, mID, [&]() {
         GenerateMipmap_Bound();
     });
 }
 
+bool Texture::HasBindless() noexcept
+{
+    return (GetBindlessProcs() != nullptr);
+}
+
+GLuint64 Texture::MakeResident() const noexcept
+{
+    SDL_assert(IsValid() && "Cannot make an invalid texture resident"); // NOLINT
+
+    if (mBindlessHandle != 0) {
+        return mBindlessHandle;
+    }
+
+    const BindlessProcs* procs = GetBindlessProcs();
+    if (procs == nullptr) {
+        return 0;
+    }
+
+    mBindlessHandle = procs->getTextureHandle(mID);
+    if (mBindlessHandle == 0) {
+        NX_LOG(E, "GPU: Failed to get bindless handle of %s", TargetToString(mTarget));
+        return 0;
+    }
+
+    procs->makeTextureHandleResident(mBindlessHandle);
+
+    return mBindlessHandle;
+}
+
 /* === Private Implementation === */
 
+const Texture::BindlessProcs* Texture::GetBindlessProcs() noexcept
+{
+    static bool loaded{false};
+    static BindlessProcs procs{};
+    static const BindlessProcs* result{nullptr};
+
+    if (!loaded) {
+        // Desktop only, the ES equivalent (GL_NV_bindless_texture) is too rarely exposed
+        if (INX_Display.glProfile != SDL_GL_CONTEXT_PROFILE_ES && SDL_GL_ExtensionSupported("GL_ARB_bindless_texture")) {
+            procs.getTextureHandle = reinterpret_cast<decltype(procs.getTextureHandle)>(SDL_GL_GetProcAddress("glGetTextureHandleARB"));
+            procs.makeTextureHandleResident = reinterpret_cast<decltype(procs.makeTextureHandleResident)>(SDL_GL_GetProcAddress("glMakeTextureHandleResidentARB"));
+            procs.makeTextureHandleNonResident = reinterpret_cast<decltype(procs.makeTextureHandleNonResident)>(SDL_GL_GetProcAddress("glMakeTextureHandleNonResidentARB"));
+            if (procs.getTextureHandle && procs.makeTextureHandleResident && procs.makeTextureHandleNonResident) {
+                result = &procs;
+            }
+        }
+        loaded = true;
+    }
+
+    return result;
+}
+
+void Texture::ReleaseBindlessHandle(bool keepData) noexcept
+{
+    if (mBindlessHandle == 0) {
+        return;
+    }
+
+    /* --- Create a new object with the same storage --- */
+
+    TextureConfig config {
+        .target = mTarget,
+        .internalFormat = mInternalFormat,
+        .data = nullptr,
+        .width = mWidth,
+        .height = mHeight,
+        .depth = mDepth,
+        .mipmap = (mMipLevels > 1),
+        .immutable = mImmutable
+    };
+
+    Texture newTexture(config, mParameters);
+
+    if (!newTexture.IsValid()) {
+        NX_LOG(E, "GPU: Failed to replace texture referenced by a bindless handle");
+        return;
+    }
+
+    /* --- Copy all levels, the old object and its handle are released by the move --- */
+
+    if (keepData) {
+        const int levels = NX_MIN(mMipLevels, newTexture.GetNumLevels());
+        const int layers = (mTarget == GL_TEXTURE_CUBE_MAP) ? 6 : (mTarget == GL_TEXTURE_CUBE_MAP_ARRAY) ? 6 * mDepth : NX_MAX(mDepth, 1);
+        for (int mip = 0; mip < levels; mip++) {
+            glCopyImageSubData(
+                mID, mTarget, mip, 0, 0, 0,
+                newTexture.GetID(), newTexture.GetTarget(), mip, 0, 0, 0,
+                NX_MAX(1, mWidth >> mip), NX_MAX(1, mHeight >> mip),
+                (mTarget == GL_TEXTURE_3D) ? NX_MAX(1, mDepth >> mip) : layers
+            );
+        }
+    }
+
+    *this = std::move(newTexture);
+    sBindlessGeneration++;
+}
+
 void Texture::AllocateTexture(const TextureConfig& config) noexcept
 {
     FormatKey key = {config.target, config.internalFormat};
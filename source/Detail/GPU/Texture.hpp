@@ -162,6 +162,22 @@ public:
     void SetAnisotropy(float anisotropy) noexcept;
     void GenerateMipmap() noexcept;
 
+    /**
+     * Bindless access (GL_ARB_bindless_texture), a resident texture can be sampled through
+     * its handle without being bound. Handles are created on the first 'MakeResident' call,
+     * which must come from the GL thread, 'GetBindlessHandle' can then be read from any thread.
+     */
+    static bool HasBindless() noexcept;
+    static uint32_t GetBindlessGeneration() noexcept;
+    GLuint64 MakeResident() const noexcept;
+    GLuint64 GetBindlessHandle() const noexcept;
+
+    /** Changes on each upload, parameter change or reallocation, so that copies of the texture can be refreshed */
+    uint32_t GetRevision() const noexcept;
+
+    /** Marks the texture as changed, also to be called after rendering into it */
+    void BumpRevision() noexcept;
+
 private:
     /** Member variables */
     GLuint mID{0};
@@ -172,6 +188,16 @@ private:
     TextureParam mParameters{};
     bool mImmutable{};
 
+    /** Last change of the texture, taken from a counter shared by all textures */
+    uint32_t mRevision{0};
+    static inline uint32_t sRevisionCounter = 0;
+
+    /** Bindless handle, zero if the texture has never been made resident */
+    mutable GLuint64 mBindlessHandle{0};
+
+    /** Incremented each time a handle is invalidated, so that stored handles can be refreshed */
+    static inline uint32_t sBindlessGeneration = 0;
+
     /** Anisotropy support */
     static inline bool sAnisotropyInitialized = false;
     static inline float sMaxAnisotropy = 1.0f;
@@ -185,6 +211,17 @@ private:
     };
     static inline std::unordered_map<FormatKey, GLenum, FormatKeyHash> sFormatFallbacks;
 
+    /** Bindless entry points, not exposed by the ES loader */
+    struct BindlessProcs {
+        GLuint64 (GLAD_API_PTR* getTextureHandle)(GLuint);
+        void (GLAD_API_PTR* makeTextureHandleResident)(GLuint64);
+        void (GLAD_API_PTR* makeTextureHandleNonResident)(GLuint64);
+    };
+    static const BindlessProcs* GetBindlessProcs() noexcept;
+
+    /** The parameters and storage of a texture referenced by a handle are frozen, the object is replaced instead */
+    void ReleaseBindlessHandle(bool keepData) noexcept;
+
     /** Creation and allocation */
     void AllocateTexture(const TextureConfig& config) noexcept;         // Allocates texture (mutable or immtuable), tests fallbacks
     bool AllocateMutableWithFormat(GLenum internalFormat) noexcept;     // Attempts mutable texture allocation with a specific format
@@ -226,6 +263,8 @@ inline Texture::Texture(Texture&& other) noexcept
     , mMipLevels(other.mMipLevels)
     , mImmutable(other.mImmutable)
     , mParameters(other.mParameters)
+    , mRevision(other.mRevision)
+    , mBindlessHandle(std::exchange(other.mBindlessHandle, 0))
 { }
 
 inline Texture& Texture::operator=(Texture&& other) noexcept
@@ -241,6 +280,8 @@ inline Texture& Texture::operator=(Texture&& other) noexcept
         mMipLevels = other.mMipLevels;
         mImmutable = other.mImmutable;
         mParameters = other.mParameters;
+        mRevision = other.mRevision;
+        mBindlessHandle = std::exchange(other.mBindlessHandle, 0);
     }
     return *this;
 }
@@ -318,6 +359,26 @@ inline const TextureParam& Texture::GetParameters() const noexcept
     return mParameters;
 }
 
+inline uint32_t Texture::GetBindlessGeneration() noexcept
+{
+    return sBindlessGeneration;
+}
+
+inline GLuint64 Texture::GetBindlessHandle() const noexcept
+{
+    return mBindlessHandle;
+}
+
+inline uint32_t Texture::GetRevision() const noexcept
+{
+    return mRevision;
+}
+
+inline void Texture::BumpRevision() noexcept
+{
+    mRevision = ++sRevisionCounter;
+}
+
 inline void Texture::Realloc(int w, int h, int d, const void* data) noexcept
 {
     TextureConfig config {
@@ -387,6 +448,10 @@ inline void Texture::ReserveLayers(int count, bool keepData) noexcept
 
 inline void Texture::DestroyTexture() noexcept
 {
+    if (mBindlessHandle != 0) {
+        GetBindlessProcs()->makeTextureHandleNonResident(mBindlessHandle);
+        mBindlessHandle = 0;
+    }
     if (mID != 0) {
         glDeleteTextures(1, &mID);
         mID = 0;
@@ -12,6 +12,7 @@
 #include <NX/NX_Math.h>
 
 #include "./DynamicArray.hpp"
+#include "./RadixSort.hpp"
 
 #include <SDL3/SDL_assert.h>
 #include <type_traits>
@@ -148,6 +149,14 @@ public:
     template<typename Compare>
     void Sort(Category cat, Compare&& comp) noexcept;
 
+    /**
+     * Stable sort of a category by ascending 64-bit key, in linear time.
+     * The key of each element is queried once. Returns false and keeps
+     * the current order if the sort buffers could not be allocated.
+     */
+    template<typename GetKey>
+    bool SortByKey(Category cat, GetKey&& getKey) noexcept;
+
     /** 
      * Removes all objects for which the given condition returns true.
      * Updates both the object storage and the category buckets.
@@ -184,6 +193,8 @@ private:
     DynamicArray<T> mObjects;                                       // Object storage
     DynamicArray<std::pair<Category, size_t>> mObjectCategoryMap;   // Object to bucket map
     std::array<DynamicArray<size_t>, N> mBuckets;                   // Index buckets per category
+    DynamicArray<RadixEntry> mSortEntries;                          // Key sort buffers
+    DynamicArray<RadixEntry> mSortScratch;                          // Key sort buffers
 };
 
 /* === Public Implementation === */
@@ -255,6 +266,35 @@ void BucketArray<T, Category, N>::Sort(Category cat, Compare&& comp) noexcept
     });
 }
 
+template<typename T, typename Category, size_t N>
+template<typename GetKey>
+bool BucketArray<T, Category, N>::SortByKey(Category cat, GetKey&& getKey) noexcept
+{
+    auto& bucket = mBuckets[static_cast<size_t>(cat)];
+    const size_t count = bucket.GetSize();
+
+    if (count < 2) {
+        return true;
+    }
+
+    if (!mSortEntries.Resize(count) || !mSortScratch.Resize(count)) {
+        return false;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        mSortEntries[i] = RadixEntry{ static_cast<uint64_t>(getKey(mObjects[bucket[i]])), bucket[i] };
+    }
+
+    RadixSort(mSortEntries.GetData(), mSortScratch.GetData(), count);
+
+    for (size_t i = 0; i < count; i++) {
+        bucket[i] = mSortEntries[i].value;
+        mObjectCategoryMap[bucket[i]].second = i;
+    }
+
+    return true;
+}
+
 template<typename T, typename Category, size_t N>
 template<typename Condition>
 void BucketArray<T, Category, N>::RemoveIf(Condition&& cond) noexcept
@@ -0,0 +1,95 @@
+/* RadixSort.hpp -- Stable radix sort of 64-bit keys
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef NX_UTIL_RADIX_SORT_HPP
+#define NX_UTIL_RADIX_SORT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace util {
+
+/**
+ * @brief Key and payload sorted by 'RadixSort'
+ */
+struct RadixEntry {
+    uint64_t key;
+    size_t value;
+};
+
+/**
+ * @brief Sorts entries by ascending key in linear time
+ *
+ * Least significant digit first, one byte per pass. The histograms of the eight
+ * bytes are built in a single read of the keys, then bytes that are the same for
+ * every key are skipped, so narrow or partially constant keys cost fewer passes.
+ *
+ * The sort is stable, entries with equal keys keep their relative order.
+ *
+ * @param entries Entries to sort, the result is always written back here
+ * @param scratch Temporary storage of at least 'count' entries
+ * @param count Number of entries
+ */
+inline void RadixSort(RadixEntry* entries, RadixEntry* scratch, size_t count) noexcept
+{
+    constexpr int digitCount = 8;
+
+    if (count < 2) {
+        return;
+    }
+
+    /* --- Histograms of all the digits --- */
+
+    size_t histograms[digitCount][256] = {};
+
+    for (size_t i = 0; i < count; i++) {
+        uint64_t key = entries[i].key;
+        for (int d = 0; d < digitCount; d++) {
+            histograms[d][(key >> (8 * d)) & 0xFF]++;
+        }
+    }
+
+    /* --- Scatter passes, from the least significant digit --- */
+
+    RadixEntry* src = entries;
+    RadixEntry* dst = scratch;
+
+    for (int d = 0; d < digitCount; d++)
+    {
+        const int shift = 8 * d;
+        size_t* offsets = histograms[d];
+
+        // All the keys fall in the same bucket, the pass would not move anything
+        if (offsets[(src[0].key >> shift) & 0xFF] == count) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (int b = 0; b < 256; b++) {
+            size_t bucketSize = offsets[b];
+            offsets[b] = offset;
+            offset += bucketSize;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            dst[offsets[(src[i].key >> shift) & 0xFF]++] = src[i];
+        }
+
+        std::swap(src, dst);
+    }
+
+    if (src != entries) {
+        std::copy(src, src + count, entries);
+    }
+}
+
+} // namespace util
+
+#endif // NX_UTIL_RADIX_SORT_HPP
@@ -0,0 +1,304 @@
+/* INX_AabbTree.cpp -- Dynamic AABB tree used to cull persistent objects hierarchically
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#include "./INX_AabbTree.hpp"
+
+#include <NX/NX_Log.h>
+
+#include <SDL3/SDL_assert.h>
+#include <algorithm>
+
+// ============================================================================
+// LOCAL FUNCTIONS
+// ============================================================================
+
+/** Margin added to leaves, relative to their size with a small absolute minimum */
+static NX_BoundingBox3D INX_FattenAabb(const NX_BoundingBox3D& aabb)
+{
+    NX_Vec3 margin = (aabb.max - aabb.min) * 0.1f + NX_VEC3_1(0.05f);
+    return NX_BoundingBox3D { aabb.min - margin, aabb.max + margin };
+}
+
+static NX_BoundingBox3D INX_CombineAabb(const NX_BoundingBox3D& a, const NX_BoundingBox3D& b)
+{
+    return NX_BoundingBox3D { NX_Vec3Min(a.min, b.min), NX_Vec3Max(a.max, b.max) };
+}
+
+static bool INX_ContainsAabb(const NX_BoundingBox3D& outer, const NX_BoundingBox3D& inner)
+{
+    return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z
+        && outer.max.x >= inner.max.x && outer.max.y >= inner.max.y && outer.max.z >= inner.max.z;
+}
+
+/** Half of the surface area, only used to compare insertion costs */
+static float INX_GetAabbCost(const NX_BoundingBox3D& aabb)
+{
+    NX_Vec3 d = aabb.max - aabb.min;
+    return d.x * d.y + d.y * d.z + d.z * d.x;
+}
+
+// ============================================================================
+// PUBLIC IMPLEMENTATION
+// ============================================================================
+
+int INX_AabbTree::CreateProxy(const NX_BoundingBox3D& aabb, int userData)
+{
+    int proxy = AllocateNode();
+    if (proxy == NullNode) {
+        return NullNode;
+    }
+
+    Node& node = mNodes[proxy];
+    node.aabb = INX_FattenAabb(aabb);
+    node.userData = userData;
+    node.height = 0;
+
+    InsertLeaf(proxy);
+    ++mProxyCount;
+
+    return proxy;
+}
+
+void INX_AabbTree::DestroyProxy(int proxy)
+{
+    SDL_assert(mNodes[proxy].IsLeaf());
+
+    RemoveLeaf(proxy);
+    FreeNode(proxy);
+    --mProxyCount;
+}
+
+bool INX_AabbTree::MoveProxy(int proxy, const NX_BoundingBox3D& aabb)
+{
+    SDL_assert(mNodes[proxy].IsLeaf());
+
+    if (INX_ContainsAabb(mNodes[proxy].aabb, aabb)) {
+        return false;
+    }
+
+    RemoveLeaf(proxy);
+    mNodes[proxy].aabb = INX_FattenAabb(aabb);
+    InsertLeaf(proxy);
+
+    return true;
+}
+
+void INX_AabbTree::Clear()
+{
+    mNodes.Clear();
+    mRoot = NullNode;
+    mFreeList = NullNode;
+    mProxyCount = 0;
+}
+
+// ============================================================================
+// PRIVATE IMPLEMENTATION
+// ============================================================================
+
+int INX_AabbTree::AllocateNode()
+{
+    if (mFreeList == NullNode) {
+        if (!mNodes.EmplaceBack()) {
+            NX_LOG(E, "RENDER: Failed to allocate AABB tree node (requested: %i nodes)", mNodes.GetSize() + 1);
+            return NullNode;
+        }
+        return static_cast<int>(mNodes.GetSize()) - 1;
+    }
+
+    int node = mFreeList;
+    mFreeList = mNodes[node].parent;
+    mNodes[node] = Node{};
+
+    return node;
+}
+
+void INX_AabbTree::FreeNode(int node)
+{
+    mNodes[node] = Node{};
+    mNodes[node].parent = mFreeList;
+    mFreeList = node;
+}
+
+void INX_AabbTree::InsertLeaf(int leaf)
+{
+    if (mRoot == NullNode) {
+        mRoot = leaf;
+        mNodes[leaf].parent = NullNode;
+        return;
+    }
+
+    /* --- Find the best sibling by descending the tree --- */
+
+    const NX_BoundingBox3D leafAabb = mNodes[leaf].aabb;
+    int index = mRoot;
+
+    while (!mNodes[index].IsLeaf())
+    {
+        const Node& node = mNodes[index];
+
+        float area = INX_GetAabbCost(node.aabb);
+        float combinedArea = INX_GetAabbCost(INX_CombineAabb(node.aabb, leafAabb));
+
+        // Cost of creating a new parent for this node and the new leaf
+        float cost = 2.0f * combinedArea;
+
+        // Minimum cost of pushing the leaf further down the tree
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](int child) {
+            const NX_BoundingBox3D combined = INX_CombineAabb(leafAabb, mNodes[child].aabb);
+            float childCost = INX_GetAabbCost(combined);
+            if (!mNodes[child].IsLeaf()) {
+                childCost -= INX_GetAabbCost(mNodes[child].aabb);
+            }
+            return childCost + inheritanceCost;
+        };
+
+        float cost1 = descendCost(node.child1);
+        float cost2 = descendCost(node.child2);
+
+        if (cost < cost1 && cost < cost2) {
+            break;
+        }
+
+        index = (cost1 < cost2) ? node.child1 : node.child2;
+    }
+
+    int sibling = index;
+
+    /* --- Create a new parent for the sibling and the leaf --- */
+
+    int oldParent = mNodes[sibling].parent;
+    int newParent = AllocateNode();
+    if (newParent == NullNode) {
+        return;
+    }
+
+    mNodes[newParent].parent = oldParent;
+    mNodes[newParent].aabb = INX_CombineAabb(leafAabb, mNodes[sibling].aabb);
+    mNodes[newParent].height = mNodes[sibling].height + 1;
+    mNodes[newParent].child1 = sibling;
+    mNodes[newParent].child2 = leaf;
+    mNodes[sibling].parent = newParent;
+    mNodes[leaf].parent = newParent;
+
+    if (oldParent != NullNode) {
+        if (mNodes[oldParent].child1 == sibling) mNodes[oldParent].child1 = newParent;
+        else mNodes[oldParent].child2 = newParent;
+    }
+    else {
+        mRoot = newParent;
+    }
+
+    /* --- Walk back up the tree fixing heights and boxes --- */
+
+    index = mNodes[leaf].parent;
+    while (index != NullNode) {
+        index = Balance(index);
+        Node& node = mNodes[index];
+        node.height = 1 + std::max(mNodes[node.child1].height, mNodes[node.child2].height);
+        node.aabb = INX_CombineAabb(mNodes[node.child1].aabb, mNodes[node.child2].aabb);
+        index = node.parent;
+    }
+}
+
+void INX_AabbTree::RemoveLeaf(int leaf)
+{
+    if (leaf == mRoot) {
+        mRoot = NullNode;
+        return;
+    }
+
+    int parent = mNodes[leaf].parent;
+    int grandParent = mNodes[parent].parent;
+    int sibling = (mNodes[parent].child1 == leaf) ? mNodes[parent].child2 : mNodes[parent].child1;
+
+    if (grandParent == NullNode) {
+        mRoot = sibling;
+        mNodes[sibling].parent = NullNode;
+        FreeNode(parent);
+        return;
+    }
+
+    /* --- Replace the parent by the sibling, then fix the ancestors --- */
+
+    if (mNodes[grandParent].child1 == parent) mNodes[grandParent].child1 = sibling;
+    else mNodes[grandParent].child2 = sibling;
+
+    mNodes[sibling].parent = grandParent;
+    FreeNode(parent);
+
+    int index = grandParent;
+    while (index != NullNode) {
+        index = Balance(index);
+        Node& node = mNodes[index];
+        node.height = 1 + std::max(mNodes[node.child1].height, mNodes[node.child2].height);
+        node.aabb = INX_CombineAabb(mNodes[node.child1].aabb, mNodes[node.child2].aabb);
+        index = node.parent;
+    }
+}
+
+int INX_AabbTree::Balance(int iA)
+{
+    // Performs a left or right rotation if node A is imbalanced, returns the new subtree root
+
+    Node& A = mNodes[iA];
+    if (A.IsLeaf() || A.height < 2) {
+        return iA;
+    }
+
+    int iB = A.child1;
+    int iC = A.child2;
+    Node& B = mNodes[iB];
+    Node& C = mNodes[iC];
+
+    int balance = C.height - B.height;
+
+    auto rotate = [&](int iUp, int iOther) -> int {
+        // Promotes 'iUp' (a child of A) above A, 'iOther' is the remaining child of A
+        Node& up = mNodes[iUp];
+        int iF = up.child1;
+        int iG = up.child2;
+        Node& F = mNodes[iF];
+        Node& G = mNodes[iG];
+
+        up.child1 = iA;
+        up.parent = A.parent;
+        A.parent = iUp;
+
+        if (up.parent != NullNode) {
+            if (mNodes[up.parent].child1 == iA) mNodes[up.parent].child1 = iUp;
+            else mNodes[up.parent].child2 = iUp;
+        }
+        else {
+            mRoot = iUp;
+        }
+
+        // The taller grandchild stays under 'up', the other one replaces 'up' under A
+        int iKeep = (F.height > G.height) ? iF : iG;
+        int iMove = (F.height > G.height) ? iG : iF;
+
+        up.child2 = iKeep;
+        if (A.child1 == iUp) A.child1 = iMove;
+        else A.child2 = iMove;
+        mNodes[iMove].parent = iA;
+
+        A.aabb = INX_CombineAabb(mNodes[iOther].aabb, mNodes[iMove].aabb);
+        A.height = 1 + std::max(mNodes[iOther].height, mNodes[iMove].height);
+
+        up.aabb = INX_CombineAabb(A.aabb, mNodes[iKeep].aabb);
+        up.height = 1 + std::max(A.height, mNodes[iKeep].height);
+
+        return iUp;
+    };
+
+    if (balance > 1) return rotate(iC, iB);
+    if (balance < -1) return rotate(iB, iC);
+
+    return iA;
+}
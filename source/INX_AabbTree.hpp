@@ -0,0 +1,172 @@
+/* INX_AabbTree.hpp -- Dynamic AABB tree used to cull persistent objects hierarchically
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef INX_AABB_TREE_HPP
+#define INX_AABB_TREE_HPP
+
+#include <NX/NX_Shape.h>
+#include <NX/NX_Math.h>
+
+#include "./Detail/Util/DynamicArray.hpp"
+#include "./INX_Frustum.hpp"
+
+// ============================================================================
+// AABB TREE
+// ============================================================================
+
+/**
+ * @brief Balanced binary tree of bounding boxes with one leaf per object.
+ *
+ * Leaves store a box enlarged by a margin so that small movements
+ * do not require any update of the tree. Internal nodes bound their
+ * two children, the tree is kept balanced with AVL-like rotations.
+ *
+ * Frustum queries discard whole subtrees that are outside and report
+ * every leaf of a subtree that is fully inside without further tests.
+ */
+class INX_AabbTree {
+public:
+    static constexpr int NullNode = -1;
+
+public:
+    /** Proxies management, 'userData' is returned by queries */
+    int CreateProxy(const NX_BoundingBox3D& aabb, int userData);
+    void DestroyProxy(int proxy);
+    bool MoveProxy(int proxy, const NX_BoundingBox3D& aabb);   //< Returns true if the tree was modified
+    void Clear();
+
+    /** Getters */
+    int GetUserData(int proxy) const;
+    const NX_BoundingBox3D& GetFatAabb(int proxy) const;
+    int GetHeight() const;
+    int GetProxyCount() const;
+
+    /**
+     * Calls 'func(userData, fullyInside)' for each leaf that is not outside the frustum.
+     * When 'fullyInside' is false, the leaf's fat box intersects the frustum and the
+     * object itself may still be outside it.
+     */
+    template <typename F>
+    void Query(const INX_Frustum& frustum, F&& func) const;
+
+private:
+    struct Node {
+        NX_BoundingBox3D aabb{};
+        int parent{NullNode};                  //< Next free node when the node is in the free list
+        int child1{NullNode};
+        int child2{NullNode};
+        int height{-1};                         //< Leaf = 0, free node = -1
+        int userData{-1};
+        bool IsLeaf() const { return child1 == NullNode; }
+    };
+
+private:
+    int AllocateNode();
+    void FreeNode(int node);
+    void InsertLeaf(int leaf);
+    void RemoveLeaf(int leaf);
+    int Balance(int node);
+
+    template <typename F>
+    void ReportSubtree(int node, F& func, util::DynamicArray<int>& stack) const;
+
+private:
+    util::DynamicArray<Node> mNodes{};
+    int mRoot{NullNode};
+    int mFreeList{NullNode};
+    int mProxyCount{};
+    mutable util::DynamicArray<int> mStack{};
+};
+
+// ============================================================================
+// INLINE IMPLEMENTATION
+// ============================================================================
+
+inline int INX_AabbTree::GetUserData(int proxy) const
+{
+    return mNodes[proxy].userData;
+}
+
+inline const NX_BoundingBox3D& INX_AabbTree::GetFatAabb(int proxy) const
+{
+    return mNodes[proxy].aabb;
+}
+
+inline int INX_AabbTree::GetHeight() const
+{
+    return (mRoot != NullNode) ? mNodes[mRoot].height : 0;
+}
+
+inline int INX_AabbTree::GetProxyCount() const
+{
+    return mProxyCount;
+}
+
+template <typename F>
+void INX_AabbTree::Query(const INX_Frustum& frustum, F&& func) const
+{
+    if (mRoot == NullNode) {
+        return;
+    }
+
+    util::DynamicArray<int>& stack = mStack;
+    stack.Clear();
+    stack.PushBack(mRoot);
+
+    while (!stack.IsEmpty())
+    {
+        int index = *stack.GetBack();
+        stack.PopBack();
+
+        const Node& node = mNodes[index];
+
+        switch (frustum.ClassifyAabb(node.aabb)) {
+        case INX_Frustum::Outside:
+            break;
+        case INX_Frustum::Inside:
+            ReportSubtree(index, func, stack);
+            break;
+        case INX_Frustum::Intersect:
+            if (node.IsLeaf()) {
+                func(node.userData, false);
+            }
+            else {
+                stack.PushBack(node.child2);
+                stack.PushBack(node.child1);
+            }
+            break;
+        }
+    }
+}
+
+template <typename F>
+void INX_AabbTree::ReportSubtree(int node, F& func, util::DynamicArray<int>& stack) const
+{
+    // Children are processed on top of the shared stack, the pending
+    // entries below the current size are left untouched
+
+    const size_t base = stack.GetSize();
+    stack.PushBack(node);
+
+    while (stack.GetSize() > base)
+    {
+        int index = *stack.GetBack();
+        stack.PopBack();
+
+        const Node& current = mNodes[index];
+        if (current.IsLeaf()) {
+            func(current.userData, true);
+        }
+        else {
+            stack.PushBack(current.child2);
+            stack.PushBack(current.child1);
+        }
+    }
+}
+
+#endif // INX_AABB_TREE_HPP
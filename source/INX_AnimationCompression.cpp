@@ -0,0 +1,365 @@
+/* INX_AnimationCompression.cpp -- Internal compression of animation sampling layouts
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#include "./NX_Animation.hpp"
+
+#include "./Detail/Util/DynamicArray.hpp"
+
+#include <NX/NX_Memory.h>
+#include <NX/NX_Log.h>
+
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+// ============================================================================
+// CONSTANTS
+// ============================================================================
+
+/** Tolerance used when none is given, in units for vectors and components for rotations */
+static constexpr float INX_DEFAULT_TOLERANCE = 1e-3f;
+
+/** Uniform tracks may take up to this many times the original key count to fit the tolerance */
+static constexpr uint32_t INX_MAX_RESAMPLE_FACTOR = 4;
+
+// ============================================================================
+// ORIGINAL TRACKS
+// ============================================================================
+
+template <typename Key>
+static float INX_FindKeys(const Key* keys, uint32_t keyCount, float time, uint32_t* outIdx0, uint32_t* outIdx1)
+{
+    if (keyCount == 1 || time <= keys[0].time) {
+        *outIdx0 = *outIdx1 = 0;
+        return 0.0f;
+    }
+
+    if (time >= keys[keyCount - 1].time) {
+        *outIdx0 = *outIdx1 = keyCount - 1;
+        return 0.0f;
+    }
+
+    uint32_t left = 0;
+    uint32_t right = keyCount - 1;
+
+    while (right - left > 1) {
+        uint32_t mid = (left + right) / 2;
+        if (keys[mid].time <= time) left = mid;
+        else right = mid;
+    }
+
+    *outIdx0 = left;
+    *outIdx1 = right;
+
+    float delta = keys[right].time - keys[left].time;
+    return (delta > 0.0f) ? (time - keys[left].time) / delta : 0.0f;
+}
+
+static NX_Vec3 INX_Interpolate(NX_Vec3 a, NX_Vec3 b, float t)
+{
+    return NX_Vec3Lerp(a, b, t);
+}
+
+static NX_Quat INX_Interpolate(NX_Quat a, NX_Quat b, float t)
+{
+    return NX_QuatSLerp(a, b, t);
+}
+
+template <typename Key>
+static auto INX_SampleKeys(const Key* keys, uint32_t keyCount, float time)
+{
+    uint32_t idx0, idx1;
+    float t = INX_FindKeys(keys, keyCount, time, &idx0, &idx1);
+    return INX_Interpolate(keys[idx0].value, keys[idx1].value, t);
+}
+
+static float INX_Difference(NX_Vec3 a, NX_Vec3 b)
+{
+    return NX_MAX3(std::fabs(a.x - b.x), std::fabs(a.y - b.y), std::fabs(a.z - b.z));
+}
+
+static float INX_Difference(NX_Quat a, NX_Quat b)
+{
+    // q and -q are the same rotation
+    float same = NX_MAX(NX_MAX(std::fabs(a.x - b.x), std::fabs(a.y - b.y)), NX_MAX(std::fabs(a.z - b.z), std::fabs(a.w - b.w)));
+    float flip = NX_MAX(NX_MAX(std::fabs(a.x + b.x), std::fabs(a.y + b.y)), NX_MAX(std::fabs(a.z + b.z), std::fabs(a.w + b.w)));
+    return NX_MIN(same, flip);
+}
+
+/** Calls 'func(time)' on each key and between each pair of keys, where the error is checked */
+template <typename Key, typename F>
+static bool INX_AllTestTimes(const Key* keys, uint32_t keyCount, F&& func)
+{
+    for (uint32_t k = 0; k < keyCount; k++) {
+        if (!func(keys[k].time)) return false;
+        if (k + 1 < keyCount && !func(0.5f * (keys[k].time + keys[k + 1].time))) return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// TRACK ENCODING
+// ============================================================================
+
+struct INX_CompressionPools {
+    util::DynamicArray<float> vec3Times;
+    util::DynamicArray<NX_Vec3> vec3Values;
+    util::DynamicArray<float> quatTimes;
+    util::DynamicArray<NX_Quat> quatValues;
+    util::DynamicArray<INX_QuantizedTrack> quantizedTracks;
+    util::DynamicArray<uint16_t> packedKeys;
+    bool failed = false;
+};
+
+static void INX_PackKey(uint16_t out[3], NX_Vec3 value, const INX_QuantizedTrack& track)
+{
+    INX_PackVec3(out, value, track);
+}
+
+static void INX_PackKey(uint16_t out[3], NX_Quat value, const INX_QuantizedTrack&)
+{
+    INX_PackQuat(out, NX_QuatNormalize(value));
+}
+
+static NX_Vec3 INX_UnpackKey(const uint16_t in[3], const INX_QuantizedTrack& track, NX_Vec3*)
+{
+    return INX_UnpackVec3(in, track);
+}
+
+static NX_Quat INX_UnpackKey(const uint16_t in[3], const INX_QuantizedTrack&, NX_Quat*)
+{
+    return INX_UnpackQuat(in);
+}
+
+static void INX_SetRange(INX_QuantizedTrack* track, const NX_Vec3* values, uint32_t count)
+{
+    NX_Vec3 min = values[0], max = values[0];
+    for (uint32_t i = 1; i < count; i++) {
+        min = NX_Vec3Min(min, values[i]);
+        max = NX_Vec3Max(max, values[i]);
+    }
+
+    track->rangeMin = min;
+    track->rangeStep = (max - min) / 65535.0f;
+}
+
+static void INX_SetRange(INX_QuantizedTrack*, const NX_Quat*, uint32_t)
+{
+    // Smallest three components have a fixed range
+}
+
+/**
+ * Resamples the track with uniformly spaced keys and quantizes them, with as
+ * many keys as the original track and then more until the error fits.
+ * Returns false when no key count fits, nothing is added to the pools then.
+ */
+template <typename Key>
+static bool INX_TryQuantize(const Key* keys, uint32_t keyCount, float tolerance,
+                            INX_CompressionPools* pools, INX_AnimationTrack* out)
+{
+    using Value = decltype(keys[0].value);
+
+    const float startTime = keys[0].time;
+    const float endTime = keys[keyCount - 1].time;
+
+    if (!(endTime > startTime)) {
+        return false;
+    }
+
+    util::DynamicArray<Value> samples;
+    util::DynamicArray<uint16_t> packed;
+
+    for (uint32_t factor = 1; factor <= INX_MAX_RESAMPLE_FACTOR; factor *= 2)
+    {
+        const uint32_t sampleCount = (keyCount - 1) * factor + 1;
+
+        INX_QuantizedTrack track{};
+        track.keyCount = sampleCount;
+        track.startTime = startTime;
+        track.invStep = (sampleCount - 1) / (endTime - startTime);
+
+        if (!samples.Resize(sampleCount) || !packed.Resize(3 * sampleCount)) {
+            pools->failed = true;
+            return false;
+        }
+
+        for (uint32_t i = 0; i < sampleCount; i++) {
+            float time = (i == sampleCount - 1) ? endTime : startTime + i / track.invStep;
+            samples[i] = INX_SampleKeys(keys, keyCount, time);
+        }
+
+        INX_SetRange(&track, samples.GetData(), sampleCount);
+
+        for (uint32_t i = 0; i < sampleCount; i++) {
+            INX_PackKey(&packed[3 * i], samples[i], track);
+        }
+
+        bool fits = INX_AllTestTimes(keys, keyCount, [&](float time) {
+            uint32_t idx0, idx1;
+            float t = INX_FindQuantizedKeys(track, time, &idx0, &idx1);
+            Value v0 = INX_UnpackKey(&packed[3 * idx0], track, static_cast<Value*>(nullptr));
+            Value v1 = INX_UnpackKey(&packed[3 * idx1], track, static_cast<Value*>(nullptr));
+            return INX_Difference(INX_Interpolate(v0, v1, t), INX_SampleKeys(keys, keyCount, time)) <= tolerance;
+        });
+
+        if (!fits) {
+            continue;
+        }
+
+        track.firstKey = static_cast<uint32_t>(pools->packedKeys.GetSize() / 3);
+
+        *out = INX_AnimationTrack { static_cast<uint32_t>(pools->quantizedTracks.GetSize()), sampleCount, 1 };
+
+        if (!pools->quantizedTracks.PushBack(track)) {
+            pools->failed = true;
+            return false;
+        }
+        for (uint32_t i = 0; i < 3 * sampleCount; i++) {
+            pools->failed |= !pools->packedKeys.PushBack(packed[i]);
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+template <typename Key, typename Value>
+static INX_AnimationTrack INX_StoreKeys(const Key* keys, const uint32_t* indices, uint32_t count,
+                                        util::DynamicArray<float>* times, util::DynamicArray<Value>* values,
+                                        INX_CompressionPools* pools)
+{
+    INX_AnimationTrack track { static_cast<uint32_t>(times->GetSize()), count, 0 };
+
+    for (uint32_t i = 0; i < count; i++) {
+        pools->failed |= !times->PushBack(keys[indices ? indices[i] : i].time);
+        pools->failed |= !values->PushBack(keys[indices ? indices[i] : i].value);
+    }
+
+    return track;
+}
+
+template <typename Key, typename Value>
+static INX_AnimationTrack INX_CompressTrack(const Key* keys, uint32_t keyCount, float tolerance,
+                                            util::DynamicArray<float>* times, util::DynamicArray<Value>* values,
+                                            INX_CompressionPools* pools)
+{
+    if (keyCount <= 1) {
+        return INX_StoreKeys(keys, nullptr, keyCount, times, values, pools);
+    }
+
+    /* --- Constant track, a single key --- */
+
+    bool constant = true;
+    for (uint32_t k = 1; k < keyCount && constant; k++) {
+        constant = INX_Difference(keys[k].value, keys[0].value) <= tolerance;
+    }
+
+    if (constant) {
+        const uint32_t first = 0;
+        return INX_StoreKeys(keys, &first, 1, times, values, pools);
+    }
+
+    /* --- Linear track, its first and last keys --- */
+
+    const uint32_t ends[2] = { 0, keyCount - 1 };
+
+    if (keyCount > 2 && keys[ends[1]].time > keys[0].time) {
+        bool linear = INX_AllTestTimes(keys, keyCount, [&](float time) {
+            float t = (time - keys[0].time) / (keys[ends[1]].time - keys[0].time);
+            Value expected = INX_Interpolate(keys[0].value, keys[ends[1]].value, t);
+            return INX_Difference(expected, INX_SampleKeys(keys, keyCount, time)) <= tolerance;
+        });
+        if (linear) {
+            return INX_StoreKeys(keys, ends, 2, times, values, pools);
+        }
+    }
+
+    /* --- Uniform quantized keys, or the original keys when they do not fit --- */
+
+    INX_AnimationTrack track{};
+    if (INX_TryQuantize(keys, keyCount, tolerance, pools, &track)) {
+        return track;
+    }
+
+    return INX_StoreKeys(keys, nullptr, keyCount, times, values, pools);
+}
+
+template <typename T>
+static bool INX_CopyPool(T** out, const util::DynamicArray<T>& pool)
+{
+    if (pool.IsEmpty()) {
+        return true;
+    }
+
+    *out = NX_Malloc<T>(pool.GetSize());
+    if (*out == nullptr) {
+        return false;
+    }
+
+    std::memcpy(*out, pool.GetData(), pool.GetSize() * sizeof(T));
+
+    return true;
+}
+
+// ============================================================================
+// INTERNAL FUNCTIONS
+// ============================================================================
+
+INX_AnimationLibData* INX_CompressAnimationLibData(const NX_AnimationLib* animLib, float tolerance)
+{
+    if (tolerance <= 0.0f) {
+        tolerance = INX_DEFAULT_TOLERANCE;
+    }
+
+    INX_AnimationLibData* data = NX_Calloc<INX_AnimationLibData>(1);
+    if (data == nullptr || !INX_InitAnimationClips(data, animLib)) {
+        NX_LOG(E, "RENDER: Failed to allocate the compressed animation data");
+        INX_DestroyAnimationLibData(data, animLib);
+        return nullptr;
+    }
+
+    /* --- Encode each track --- */
+
+    INX_CompressionPools pools;
+
+    for (int i = 0; i < animLib->count && !pools.failed; i++) {
+        const NX_Animation& anim = animLib->animations[i];
+        for (uint32_t j = 0; j < anim.channelCount; j++) {
+            const NX_AnimationChannel& channel = anim.channels[j];
+            INX_AnimationTracks& tracks = data->clips[i].tracks[j];
+            tracks.translation = INX_CompressTrack(channel.positionKeys, channel.positionKeyCount, tolerance, &pools.vec3Times, &pools.vec3Values, &pools);
+            tracks.rotation = INX_CompressTrack(channel.rotationKeys, channel.rotationKeyCount, tolerance, &pools.quatTimes, &pools.quatValues, &pools);
+            tracks.scale = INX_CompressTrack(channel.scaleKeys, channel.scaleKeyCount, tolerance, &pools.vec3Times, &pools.vec3Values, &pools);
+        }
+    }
+
+    /* --- Move the pools to exactly sized buffers --- */
+
+    bool copied = !pools.failed
+        && INX_CopyPool(&data->vec3Times, pools.vec3Times)
+        && INX_CopyPool(&data->vec3Values, pools.vec3Values)
+        && INX_CopyPool(&data->quatTimes, pools.quatTimes)
+        && INX_CopyPool(&data->quatValues, pools.quatValues)
+        && INX_CopyPool(&data->quantizedTracks, pools.quantizedTracks)
+        && INX_CopyPool(&data->packedKeys, pools.packedKeys);
+
+    if (!copied) {
+        NX_LOG(E, "RENDER: Failed to allocate the compressed animation data");
+        INX_DestroyAnimationLibData(data, animLib);
+        return nullptr;
+    }
+
+    data->vec3KeyCount = static_cast<uint32_t>(pools.vec3Times.GetSize());
+    data->quatKeyCount = static_cast<uint32_t>(pools.quatTimes.GetSize());
+    data->quantizedTrackCount = static_cast<uint32_t>(pools.quantizedTracks.GetSize());
+    data->packedKeyCount = static_cast<uint32_t>(pools.packedKeys.GetSize() / 3);
+    data->compressed = true;
+
+    return data;
+}
@@ -0,0 +1,419 @@
+/* INX_AssetLoader.cpp -- Loads assets on the worker threads and uploads them within a frame budget
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#include "./INX_AssetLoader.hpp"
+
+#include <NX/NX_Filesystem.h>
+#include <NX/NX_Texture.h>
+#include <NX/NX_Memory.h>
+#include <NX/NX_Log.h>
+
+#include "./Importer/ModelImporter.hpp"
+#include "./Importer/SceneImporter.hpp"
+#include "./Importer/ModelCache.hpp"
+#include "./Detail/Util/Ranges.hpp"
+#include "./INX_GlobalPool.hpp"
+#include "./INX_JobSystem.hpp"
+#include "./INX_Utils.hpp"
+#include "./NX_Font.hpp"
+
+#include <SDL3/SDL_timer.h>
+
+// ============================================================================
+// GLOBAL STATE
+// ============================================================================
+
+INX_AssetLoader INX_AssetLoads{};
+
+// ============================================================================
+// ASSET REQUEST
+// ============================================================================
+
+NX_AssetRequest::~NX_AssetRequest()
+{
+    // Partial GPU resources of a model are released with its data
+    NX_DestroyImage(&image);
+
+    // Releasing the model data only clears the views into the cache
+    NX_Free(cacheData);
+
+    INX_DestroyAudioClip_RawData(audio);
+
+    // The font is only handed to the caller once its atlas texture exists
+    NX_DestroyFont(glyphFont);
+}
+
+// ============================================================================
+// PUBLIC IMPLEMENTATION
+// ============================================================================
+
+void INX_AssetLoader::Init(float uploadBudgetMs)
+{
+    if (uploadBudgetMs <= 0.0f) {
+        uploadBudgetMs = 2.0f;
+    }
+
+    mBudgetTicks = static_cast<uint64_t>(uploadBudgetMs * 1e-3 * SDL_GetPerformanceFrequency());
+}
+
+void INX_AssetLoader::Quit()
+{
+    /* --- Wait for the workers to give back every request --- */
+
+    for (NX_AssetRequest& request : mRequests) {
+        request.cancelled.store(true, std::memory_order_relaxed);
+    }
+
+    for (NX_AssetRequest& request : mRequests) {
+        if (request.stage == NX_AssetRequest::Stage::DECODING) {
+            WaitDecoded(&request);
+        }
+    }
+
+    /* --- Everything is owned by the main thread now --- */
+
+    if (!mRequests.IsEmpty()) {
+        NX_LOG(D, "CORE: %i asset request(s) released on quit", static_cast<int>(mRequests.GetSize()));
+    }
+
+    mRequests.Clear();
+    mUploads.Clear();
+    mUploadHead = 0;
+    mDecoded.Clear();
+}
+
+NX_AssetRequest* INX_AssetLoader::Load(Type type, const char* path, NX_AssetCallback callback, void* userData,
+                                       const NX_AssetRequest::Params& params)
+{
+    if (path == nullptr) {
+        NX_LOG(E, "CORE: Failed to load asset; Path is null");
+        return nullptr;
+    }
+
+    NX_AssetRequest* request = mRequests.Create();
+    if (request == nullptr) {
+        NX_LOG(E, "CORE: Failed to load asset '%s'; Unable to allocate the request", path);
+        return nullptr;
+    }
+
+    // Reserving here ensures a worker can always hand the request back
+    bool reserved = false;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        reserved = mDecoded.Reserve(mRequests.GetSize());
+    }
+
+    request->path = path;
+    if (params.codepoints != nullptr && params.codepointCount > 0) {
+        reserved = reserved && request->codepoints.Assign(params.codepoints, params.codepoints + params.codepointCount);
+    }
+
+    // The pool is not thread-safe, the font is created here and only filled by the worker
+    if (type == Type::FONT) {
+        request->glyphFont = INX_Pool.Create<NX_Font>();
+        reserved = reserved && (request->glyphFont != nullptr);
+    }
+
+    if (!reserved || request->path.IsEmpty()) {
+        NX_LOG(E, "CORE: Failed to load asset '%s'; Unable to allocate the request", path);
+        mRequests.Destroy(request);
+        return nullptr;
+    }
+
+    request->loader = this;
+    request->type = type;
+    request->callback = callback;
+    request->userData = userData;
+    request->channelCount = params.channelCount;
+    request->fontType = params.fontType;
+    request->fontSize = params.fontSize;
+    request->codepointCount = params.codepointCount;
+
+    INX_Jobs.Submit(DecodeTask, request);
+
+    return request;
+}
+
+void INX_AssetLoader::Update()
+{
+    CollectDecoded();
+
+    if (mUploadHead == mUploads.GetSize()) {
+        return;
+    }
+
+    const uint64_t start = SDL_GetPerformanceCounter();
+
+    while (mUploadHead < mUploads.GetSize())
+    {
+        NX_AssetRequest* request = mUploads[mUploadHead];
+
+        if (request == nullptr) {
+            mUploadHead++;
+            continue;
+        }
+
+        if (UploadStep(request)) {
+            mUploadHead++;
+            Complete(request);  //< The callback may release the request
+        }
+
+        if (SDL_GetPerformanceCounter() - start >= mBudgetTicks) {
+            break;
+        }
+    }
+
+    // The queue restarts from the beginning whenever it has been drained
+    if (mUploadHead == mUploads.GetSize()) {
+        mUploads.Clear();
+        mUploadHead = 0;
+    }
+}
+
+NX_AssetStatus INX_AssetLoader::Wait(NX_AssetRequest* request)
+{
+    if (request->stage == NX_AssetRequest::Stage::DONE) {
+        return request->status;
+    }
+
+    WaitDecoded(request);
+    CollectDecoded();
+
+    if (request->stage == NX_AssetRequest::Stage::DONE) {
+        return request->status;
+    }
+
+    RemoveUpload(request);
+    while (!UploadStep(request)) { }
+
+    NX_AssetStatus status = request->status;
+    Complete(request);
+
+    return status;
+}
+
+void INX_AssetLoader::WaitDecoded(NX_AssetRequest* request)
+{
+    if (request->stage != NX_AssetRequest::Stage::DECODING) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDecodedCV.wait(lock, [request]() {
+        return request->decoded.load(std::memory_order_acquire);
+    });
+}
+
+void INX_AssetLoader::Release(NX_AssetRequest* request)
+{
+    switch (request->stage) {
+    case NX_AssetRequest::Stage::DECODING:
+        // Still held by a worker, destroyed once it comes back
+        request->cancelled.store(true, std::memory_order_relaxed);
+        return;
+    case NX_AssetRequest::Stage::UPLOADING:
+        RemoveUpload(request);
+        break;
+    case NX_AssetRequest::Stage::DONE:
+        break;
+    }
+
+    mRequests.Destroy(request);
+}
+
+// ============================================================================
+// PRIVATE IMPLEMENTATION
+// ============================================================================
+
+void INX_AssetLoader::DecodeTask(void* context)
+{
+    NX_AssetRequest* request = static_cast<NX_AssetRequest*>(context);
+
+    if (!request->cancelled.load(std::memory_order_relaxed)) {
+        request->decodeSucceeded = Decode(request);
+    }
+
+    request->loader->PushDecoded(request);
+}
+
+bool INX_AssetLoader::Decode(NX_AssetRequest* request)
+{
+    const char* path = request->path.GetCString();
+
+    switch (request->type) {
+    case Type::TEXTURE:
+        request->image = NX_LoadImage(path);
+        return (request->image.pixels != nullptr);
+    case Type::TEXTURE_DATA:
+        request->image = NX_LoadImageRaw(path);
+        return (request->image.pixels != nullptr);
+    case Type::AUDIO_CLIP:
+        return INX_DecodeAudioClip(path, &request->audio);
+    case Type::FONT:
+        return DecodeFont(request);
+    case Type::MODEL:
+        break;
+    }
+
+    size_t fileSize = 0;
+    void* fileData = NX_LoadFile(path, &fileSize);
+    if (fileData == nullptr || fileSize == 0) {
+        NX_LOG(E, "RENDER: Failed to load model data: %s", path);
+        NX_Free(fileData);
+        return false;
+    }
+
+    // A model cache is used in place, the request keeps the file until it's done
+    if (import::ModelCache::IsCache(fileData, fileSize)) {
+        request->cacheData = fileData;
+        return import::ModelCache::Load(&request->model, fileData, fileSize);
+    }
+
+    bool success = false;
+    {
+        import::SceneImporter importer(fileData, fileSize, INX_GetFileExt(path));
+        if (importer.IsValid()) {
+            success = import::ModelImporter(importer).LoadModel(&request->model);
+        }
+    }
+
+    NX_Free(fileData);
+
+    return success;
+}
+
+bool INX_AssetLoader::DecodeFont(NX_AssetRequest* request)
+{
+    const char* path = request->path.GetCString();
+
+    size_t fileSize = 0;
+    void* fileData = NX_LoadFile(path, &fileSize);
+    if (fileData == nullptr || fileSize == 0) {
+        NX_LOG(E, "RENDER: Failed to load font data: %s", path);
+        NX_Free(fileData);
+        return false;
+    }
+
+    const int* codepoints = request->codepoints.IsEmpty() ? nullptr : request->codepoints.GetData();
+
+    bool success = INX_InitFontGlyphs(
+        request->glyphFont, fileData, fileSize, request->fontType,
+        request->fontSize, codepoints, request->codepointCount
+    );
+
+    NX_Free(fileData);
+
+    return success;
+}
+
+void INX_AssetLoader::PushDecoded(NX_AssetRequest* request)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mDecoded.EmplaceBack(request);  //< Reserved on load
+        request->decoded.store(true, std::memory_order_release);
+    }
+    mDecodedCV.notify_all();
+}
+
+void INX_AssetLoader::CollectDecoded()
+{
+    while (true)
+    {
+        NX_AssetRequest* request = nullptr;
+        {
+            // Requests decoded together are taken in any order, the capacity stays reserved
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mDecoded.IsEmpty()) break;
+            request = *mDecoded.GetBack();
+            mDecoded.PopBack();
+        }
+
+        if (request->cancelled.load(std::memory_order_relaxed)) {
+            mRequests.Destroy(request);
+            continue;
+        }
+
+        request->stage = NX_AssetRequest::Stage::UPLOADING;
+
+        if (mUploads.EmplaceBack(request) == nullptr) {
+            request->decodeSucceeded = false;
+            UploadStep(request);
+            Complete(request);
+        }
+    }
+}
+
+bool INX_AssetLoader::UploadStep(NX_AssetRequest* request)
+{
+    if (!request->decodeSucceeded) {
+        request->status = NX_ASSET_FAILED;
+        return true;
+    }
+
+    /* --- Textures, audio clips and fonts are a single step --- */
+
+    switch (request->type) {
+    case Type::TEXTURE:
+    case Type::TEXTURE_DATA:
+        request->texture = NX_CreateTextureFromImage(&request->image);
+        NX_DestroyImage(&request->image);
+        request->image = NX_Image{};
+        request->status = request->texture ? NX_ASSET_READY : NX_ASSET_FAILED;
+        return true;
+    case Type::AUDIO_CLIP:
+        request->audioClip = INX_CreateAudioClip(request->audio, request->channelCount);
+        INX_DestroyAudioClip_RawData(request->audio);
+        request->audio = INX_AudioClip_RawData{};
+        request->status = request->audioClip ? NX_ASSET_READY : NX_ASSET_FAILED;
+        return true;
+    case Type::FONT:
+        if (INX_CreateFontTexture(request->glyphFont)) {
+            request->font = request->glyphFont;
+            request->glyphFont = nullptr;
+        }
+        request->status = request->font ? NX_ASSET_READY : NX_ASSET_FAILED;
+        return true;
+    case Type::MODEL:
+        break;
+    }
+
+    /* --- Models upload a mesh or a material map per step, then assemble --- */
+
+    if (request->uploadStep < request->model.GetUploadStepCount()) {
+        if (!request->model.UploadStep(request->uploadStep++)) {
+            request->status = NX_ASSET_FAILED;
+            return true;
+        }
+        return false;
+    }
+
+    request->result = request->model.Finish();
+    request->status = request->result ? NX_ASSET_READY : NX_ASSET_FAILED;
+
+    return true;
+}
+
+void INX_AssetLoader::Complete(NX_AssetRequest* request)
+{
+    request->stage = NX_AssetRequest::Stage::DONE;
+
+    if (request->callback != nullptr) {
+        request->callback(request, request->userData);
+    }
+}
+
+void INX_AssetLoader::RemoveUpload(NX_AssetRequest* request)
+{
+    for (size_t i = mUploadHead; i < mUploads.GetSize(); i++) {
+        if (mUploads[i] == request) {
+            mUploads[i] = nullptr;
+            return;
+        }
+    }
+}
@@ -0,0 +1,150 @@
+/* INX_AssetLoader.hpp -- Loads assets on the worker threads and uploads them within a frame budget
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef INX_ASSET_LOADER_HPP
+#define INX_ASSET_LOADER_HPP
+
+#include <NX/NX_AssetLoader.h>
+#include <NX/NX_Image.h>
+
+#include "./Detail/Util/DynamicArray.hpp"
+#include "./Detail/Util/ObjectPool.hpp"
+#include "./Detail/Util/String.hpp"
+#include "./Importer/ModelData.hpp"
+#include "./NX_AudioClip.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+
+class INX_AssetLoader;
+
+// ============================================================================
+// ASSET REQUEST
+// ============================================================================
+
+struct NX_AssetRequest {
+    enum class Type { TEXTURE, TEXTURE_DATA, MODEL, AUDIO_CLIP, FONT };
+    enum class Stage { DECODING, UPLOADING, DONE };
+
+    /** Parameters of the audio clip and font requests, codepoints are copied */
+    struct Params {
+        int channelCount;
+        NX_FontType fontType;
+        int fontSize;
+        const int* codepoints;
+        int codepointCount;
+    };
+
+    ~NX_AssetRequest();
+
+    INX_AssetLoader* loader{};
+    util::String path{};
+    Type type{};
+
+    NX_AssetCallback callback{};
+    void* userData{};
+
+    int channelCount{};
+    NX_FontType fontType{};
+    int fontSize{};
+    util::DynamicArray<int> codepoints{};  //< Empty for the default set
+    int codepointCount{};
+
+    /** Owned by the main thread */
+    Stage stage{Stage::DECODING};
+    NX_AssetStatus status{NX_ASSET_PENDING};
+    int uploadStep{};
+
+    /** Owned by the worker until 'decoded' is set */
+    std::atomic<bool> cancelled{false};
+    std::atomic<bool> decoded{false};
+    bool decodeSucceeded{};
+    NX_Image image{};
+    import::ModelData model{};
+    void* cacheData{};              //< Model cache file the model data points into
+    INX_AudioClip_RawData audio{};
+    NX_Font* glyphFont{};           //< Created on load, the worker rasterizes its glyphs
+
+    /** Result, handed to the caller once ready */
+    NX_Texture* texture{};
+    NX_Model* result{};
+    NX_AudioClip* audioClip{};
+    NX_Font* font{};
+};
+
+// ============================================================================
+// ASSET LOADER
+// ============================================================================
+
+/**
+ * @brief Background loading of textures, models, audio clips and fonts.
+ *
+ * Files are read and decoded, model meshes are built and font glyphs rasterized,
+ * by tasks submitted to the job system. Decoded requests come back to the main
+ * thread, where their GPU and OpenAL resources are created one step at a time (a
+ * texture, a clip, a font atlas, or a mesh or material map of a model), by Update()
+ * until the frame budget is spent, or by Wait().
+ *
+ * Requests are created, completed and destroyed on the main thread only. A
+ * request cancelled while a worker holds it is destroyed when it comes back.
+ */
+class INX_AssetLoader {
+public:
+    using Type = NX_AssetRequest::Type;
+
+public:
+    /** Lifetime, Quit() cancels and frees every request and must precede the pool unload */
+    void Init(float uploadBudgetMs);
+    void Quit();
+
+    /** Starts a request, returns nullptr if it could not be created */
+    NX_AssetRequest* Load(Type type, const char* path, NX_AssetCallback callback, void* userData,
+                          const NX_AssetRequest::Params& params = {});
+
+    /** Uploads decoded requests until the budget is spent, always doing at least one step */
+    void Update();
+
+    /** Completes a request without budget */
+    NX_AssetStatus Wait(NX_AssetRequest* request);
+
+    /** Blocks until a request has been decoded, without any GPU work */
+    void WaitDecoded(NX_AssetRequest* request);
+
+    /** Cancels a pending request and frees it */
+    void Release(NX_AssetRequest* request);
+
+private:
+    /** Worker side */
+    static void DecodeTask(void* context);
+    static bool Decode(NX_AssetRequest* request);
+    static bool DecodeFont(NX_AssetRequest* request);
+    void PushDecoded(NX_AssetRequest* request);
+
+    /** Main thread side */
+    void CollectDecoded();
+    bool UploadStep(NX_AssetRequest* request);
+    void Complete(NX_AssetRequest* request);
+    void RemoveUpload(NX_AssetRequest* request);
+
+private:
+    util::ObjectPool<NX_AssetRequest, 64> mRequests{};
+
+    util::DynamicArray<NX_AssetRequest*> mUploads{};    //< FIFO from 'mUploadHead', released entries are null
+    size_t mUploadHead{};
+    uint64_t mBudgetTicks{};
+
+    std::mutex mMutex;                                  //< Protects 'mDecoded'
+    std::condition_variable mDecodedCV;
+    util::DynamicArray<NX_AssetRequest*> mDecoded{};
+};
+
+extern INX_AssetLoader INX_AssetLoads;
+
+#endif // INX_ASSET_LOADER_HPP
@@ -0,0 +1,176 @@
+/* INX_DrawPacking.hpp -- Internal implementation details for packing draw call records
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef INX_DRAW_PACKING_HPP
+#define INX_DRAW_PACKING_HPP
+
+#include <NX/NX_Material.h>
+#include <NX/NX_Math.h>
+#include <cstdint>
+#include <array>
+#include <bit>
+
+// ============================================================================
+// GPU RECORDS
+// ============================================================================
+
+/** Shared GPU data per draw call */
+struct INX_GPUDrawShared {
+    alignas(16) NX_Mat4 matModel;
+    alignas(16) NX_Mat4 matNormal;
+    alignas(4) int32_t boneOffset;
+    alignas(4) int32_t instancing;
+    alignas(4) int32_t skinning;
+};
+
+/** Unique GPU data per draw call */
+struct INX_GPUDrawUnique {
+    alignas(16) NX_Vec4 albedoColor;
+    alignas(16) NX_Vec3 emissionColor;
+    alignas(4) float emissionEnergy;
+    alignas(4) float aoLightAffect;
+    alignas(4) float occlusion;
+    alignas(4) float roughness;
+    alignas(4) float metalness;
+    alignas(4) float normalScale;
+    alignas(4) float alphaCutOff;
+    alignas(4) float depthOffset;
+    alignas(4) float depthScale;
+    alignas(8) NX_Vec2 texOffset;
+    alignas(8) NX_Vec2 texScale;
+    alignas(4) int32_t billboard;
+    alignas(4) uint32_t layerMask;
+    alignas(8) uint64_t textureHandles[4];  //< Bindless handles or array layers (albedo, emission, ORM, normal), zero when bound
+};
+
+/** Bindless handles or array layers of the material textures, in record order */
+using INX_MaterialHandles = std::array<uint64_t, 4>;
+
+// ============================================================================
+// PACKING FUNCTIONS
+// ============================================================================
+
+/*
+ * These functions only depend on their arguments and write to a single output,
+ * they can be called from any thread as long as each output is owned by one caller.
+ */
+
+inline void INX_PackDrawShared(INX_GPUDrawShared* out, const NX_Transform& transform, int boneMatrixOffset, int instanceCount)
+{
+    NX_Mat3 matNormal = NX_TransformToNormalMat3(&transform);
+
+    out->matModel = NX_TransformToMat4(&transform);
+    out->matNormal = NX_Mat3ToMat4(&matNormal);
+    out->boneOffset = boneMatrixOffset;
+    out->instancing = (instanceCount > 0);
+    out->skinning = (boneMatrixOffset >= 0);
+}
+
+inline void INX_PackDrawUnique(INX_GPUDrawUnique* out, const NX_Material& material, uint32_t layerMask, const INX_MaterialHandles& textureHandles = {})
+{
+    out->albedoColor = NX_ColorToVec4(material.albedo.color);
+    out->emissionColor = NX_ColorToVec3(material.emission.color);
+    out->emissionEnergy = material.emission.energy;
+    out->aoLightAffect = material.orm.aoLightAffect;
+    out->occlusion = material.orm.occlusion;
+    out->roughness = material.orm.roughness;
+    out->metalness = material.orm.metalness;
+    out->normalScale = material.normal.scale;
+    out->alphaCutOff = material.alphaCutOff;
+    out->depthOffset = material.depth.offset;
+    out->depthScale = material.depth.scale;
+    out->texOffset = material.texOffset;
+    out->texScale = material.texScale;
+    out->billboard = material.billboard;
+    out->layerMask = layerMask;
+    for (size_t i = 0; i < textureHandles.size(); i++) {
+        out->textureHandles[i] = textureHandles[i];
+    }
+}
+
+// ============================================================================
+// SORT KEYS
+// ============================================================================
+
+/** Squared distance from the view position to the AABB's center */
+inline float INX_GetCenterDistanceSq(const NX_Vec3& viewPosition, const NX_BoundingBox3D& box, const NX_Transform& transform)
+{
+    NX_Vec3 local = (box.min + box.max) * 0.5f;
+    NX_Vec3 world = local * transform;
+
+    return NX_Vec3DistanceSq(viewPosition, world);
+}
+
+/** Squared distance from the view position to the AABB's farthest corner */
+inline float INX_GetFarthestDistanceSq(const NX_Vec3& viewPosition, const NX_BoundingBox3D& box, const NX_Transform& transform)
+{
+    // Rotations keep distances, so the view is moved to the rotated frame of the box where
+    // each axis of the offset to a corner only depends on the bound picked for that axis
+
+    NX_Vec3 offset = NX_Vec3Rotate(transform.translation - viewPosition, NX_QuatConjugate(transform.rotation));
+    NX_Vec3 lo = box.min * transform.scale + offset;
+    NX_Vec3 hi = box.max * transform.scale + offset;
+
+    return NX_MAX(lo.x * lo.x, hi.x * hi.x)
+         + NX_MAX(lo.y * lo.y, hi.y * hi.y)
+         + NX_MAX(lo.z * lo.z, hi.z * hi.z);
+}
+
+/**
+ * Ordering of the draw calls within a category, the category is the pass so it
+ * never needs to be part of the key. Equal keys keep their submission order.
+ */
+enum INX_SortPolicy {
+    INX_SORT_FRONT_TO_BACK,     //< [distance 32 | state 32], limits overdraw
+    INX_SORT_BACK_TO_FRONT,     //< [inverted distance 32 | state 32], for blending
+    INX_SORT_STATE              //< [state 32 | distance 32], limits state changes
+};
+
+/** Mixes a value into a 64-bit hash */
+inline uint64_t INX_HashMix(uint64_t hash, uint64_t value)
+{
+    uint64_t x = hash ^ (value + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2));
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+/**
+ * Packs the pipeline state of a draw call on 32 bits: 12 bits for the shader
+ * variant then 20 bits for the material textures and render states. Collisions
+ * only make the state order less effective, never incorrect.
+ */
+inline uint32_t INX_PackSortState(uint64_t shaderHash, uint64_t materialHash)
+{
+    return (static_cast<uint32_t>(shaderHash >> 52) << 20) | static_cast<uint32_t>(materialHash >> 44);
+}
+
+/** Maps a squared distance to an integer of the same order, negative and NaN values map to zero */
+inline uint32_t INX_QuantizeDistance(float distanceSq)
+{
+    // The bits of positive IEEE floats increase with their value
+    return (distanceSq > 0.0f) ? std::bit_cast<uint32_t>(distanceSq) : 0u;
+}
+
+inline uint64_t INX_MakeSortKey(INX_SortPolicy policy, uint32_t state, float distanceSq)
+{
+    const uint32_t distance = INX_QuantizeDistance(distanceSq);
+
+    switch (policy) {
+    case INX_SORT_FRONT_TO_BACK:
+        return (static_cast<uint64_t>(distance) << 32) | state;
+    case INX_SORT_BACK_TO_FRONT:
+        return (static_cast<uint64_t>(~distance) << 32) | state;
+    case INX_SORT_STATE:
+        return (static_cast<uint64_t>(state) << 32) | distance;
+    }
+
+    return 0;
+}
+
+#endif // INX_DRAW_PACKING_HPP
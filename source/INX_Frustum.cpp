@@ -0,0 +1,299 @@
+/* INX_Frustum.cpp -- Batch culling kernels of the frustum class
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#include "./INX_Frustum.hpp"
+
+#include <NX/NX_Platform.h>
+#include <algorithm>
+#include <cmath>
+
+// ============================================================================
+// LOCAL FUNCTIONS
+// ============================================================================
+
+/**
+ * Writes the results of 'laneCount' consecutive objects starting at 'index'.
+ * 'index' is always a multiple of the lane count, so lanes never straddle two words.
+ */
+static inline void INX_WriteCullBits(
+    uint64_t* visible, uint64_t* inside, size_t index,
+    uint32_t outsideBits, uint32_t crossingBits, uint32_t laneMask)
+{
+    const uint64_t visibleBits = ~outsideBits & laneMask;
+    visible[index >> 6] |= visibleBits << (index & 63);
+
+    if (inside != nullptr) {
+        const uint64_t insideBits = ~(outsideBits | crossingBits) & laneMask;
+        inside[index >> 6] |= insideBits << (index & 63);
+    }
+}
+
+#if defined(NX_HAS_NEON) || defined(NX_HAS_NEON_FMA)
+static inline uint32_t INX_MoveMaskNeon(uint32x4_t mask)
+{
+    static const uint32_t weights[4] = { 1, 2, 4, 8 };
+    uint32x4_t bits = vandq_u32(mask, vld1q_u32(weights));
+    uint32x2_t sum = vpadd_u32(vget_low_u32(bits), vget_high_u32(bits));
+    return vget_lane_u32(vpadd_u32(sum, sum), 0);
+}
+#endif
+
+// ============================================================================
+// PUBLIC IMPLEMENTATION
+// ============================================================================
+
+void INX_Frustum::CullBoxes(const INX_BoxBatch& boxes, uint64_t* visible, uint64_t* inside) const
+{
+    // Same tests as 'ClassifyAabb', written with the center and the extents:
+    // the box is outside a plane when 'd + r' is negative, crosses it when 'd - r' is
+
+    const size_t count = boxes.GetSize();
+    const size_t words = INX_GetCullMaskSize(count);
+
+    std::fill_n(visible, words, 0);
+    if (inside != nullptr) {
+        std::fill_n(inside, words, 0);
+    }
+
+    const float* NX_RESTRICT CX = boxes.centerX.GetData();
+    const float* NX_RESTRICT CY = boxes.centerY.GetData();
+    const float* NX_RESTRICT CZ = boxes.centerZ.GetData();
+    const float* NX_RESTRICT EX = boxes.extentX.GetData();
+    const float* NX_RESTRICT EY = boxes.extentY.GetData();
+    const float* NX_RESTRICT EZ = boxes.extentZ.GetData();
+
+    size_t i = 0;
+
+#if defined(NX_HAS_AVX)
+
+    const __m256 epsilon = _mm256_set1_ps(-1e-6f);
+    const __m256 zero = _mm256_setzero_ps();
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 cx = _mm256_loadu_ps(CX + i), cy = _mm256_loadu_ps(CY + i), cz = _mm256_loadu_ps(CZ + i);
+        __m256 ex = _mm256_loadu_ps(EX + i), ey = _mm256_loadu_ps(EY + i), ez = _mm256_loadu_ps(EZ + i);
+
+        __m256 outside = zero;
+        __m256 crossing = zero;
+
+        for (int p = 0; p < PLANE_COUNT; p++) {
+            const NX_Vec4& plane = mPlanes[p];
+            __m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+                _mm256_mul_ps(_mm256_set1_ps(plane.x), cx),
+                _mm256_mul_ps(_mm256_set1_ps(plane.y), cy)),
+                _mm256_mul_ps(_mm256_set1_ps(plane.z), cz)),
+                _mm256_set1_ps(plane.w));
+            __m256 r = _mm256_add_ps(_mm256_add_ps(
+                _mm256_mul_ps(_mm256_set1_ps(std::abs(plane.x)), ex),
+                _mm256_mul_ps(_mm256_set1_ps(std::abs(plane.y)), ey)),
+                _mm256_mul_ps(_mm256_set1_ps(std::abs(plane.z)), ez));
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(d, r), epsilon, _CMP_LT_OQ));
+            crossing = _mm256_or_ps(crossing, _mm256_cmp_ps(_mm256_sub_ps(d, r), zero, _CMP_LT_OQ));
+        }
+
+        INX_WriteCullBits(visible, inside, i, _mm256_movemask_ps(outside), _mm256_movemask_ps(crossing), 0xFF);
+    }
+
+#elif defined(NX_HAS_SSE)
+
+    const __m128 epsilon = _mm_set1_ps(-1e-6f);
+    const __m128 zero = _mm_setzero_ps();
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 cx = _mm_loadu_ps(CX + i), cy = _mm_loadu_ps(CY + i), cz = _mm_loadu_ps(CZ + i);
+        __m128 ex = _mm_loadu_ps(EX + i), ey = _mm_loadu_ps(EY + i), ez = _mm_loadu_ps(EZ + i);
+
+        __m128 outside = zero;
+        __m128 crossing = zero;
+
+        for (int p = 0; p < PLANE_COUNT; p++) {
+            const NX_Vec4& plane = mPlanes[p];
+            __m128 d = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(_mm_set1_ps(plane.x), cx),
+                _mm_mul_ps(_mm_set1_ps(plane.y), cy)),
+                _mm_mul_ps(_mm_set1_ps(plane.z), cz)),
+                _mm_set1_ps(plane.w));
+            __m128 r = _mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(_mm_set1_ps(std::abs(plane.x)), ex),
+                _mm_mul_ps(_mm_set1_ps(std::abs(plane.y)), ey)),
+                _mm_mul_ps(_mm_set1_ps(std::abs(plane.z)), ez));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(d, r), epsilon));
+            crossing = _mm_or_ps(crossing, _mm_cmplt_ps(_mm_sub_ps(d, r), zero));
+        }
+
+        INX_WriteCullBits(visible, inside, i, _mm_movemask_ps(outside), _mm_movemask_ps(crossing), 0xF);
+    }
+
+#elif defined(NX_HAS_NEON) || defined(NX_HAS_NEON_FMA)
+
+    const float32x4_t epsilon = vdupq_n_f32(-1e-6f);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4_t cx = vld1q_f32(CX + i), cy = vld1q_f32(CY + i), cz = vld1q_f32(CZ + i);
+        float32x4_t ex = vld1q_f32(EX + i), ey = vld1q_f32(EY + i), ez = vld1q_f32(EZ + i);
+
+        uint32x4_t outside = vdupq_n_u32(0);
+        uint32x4_t crossing = vdupq_n_u32(0);
+
+        for (int p = 0; p < PLANE_COUNT; p++) {
+            const NX_Vec4& plane = mPlanes[p];
+            float32x4_t d = vaddq_f32(vaddq_f32(vaddq_f32(
+                vmulq_n_f32(cx, plane.x),
+                vmulq_n_f32(cy, plane.y)),
+                vmulq_n_f32(cz, plane.z)),
+                vdupq_n_f32(plane.w));
+            float32x4_t r = vaddq_f32(vaddq_f32(
+                vmulq_n_f32(ex, std::abs(plane.x)),
+                vmulq_n_f32(ey, std::abs(plane.y))),
+                vmulq_n_f32(ez, std::abs(plane.z)));
+            outside = vorrq_u32(outside, vcltq_f32(vaddq_f32(d, r), epsilon));
+            crossing = vorrq_u32(crossing, vcltq_f32(vsubq_f32(d, r), zero));
+        }
+
+        INX_WriteCullBits(visible, inside, i, INX_MoveMaskNeon(outside), INX_MoveMaskNeon(crossing), 0xF);
+    }
+
+#endif
+
+    /* --- Remaining objects, or all of them without SIMD support --- */
+
+    for (; i < count; i++)
+    {
+        uint32_t outside = 0, crossing = 0;
+
+        for (int p = 0; p < PLANE_COUNT; p++) {
+            const NX_Vec4& plane = mPlanes[p];
+            float d = plane.x * CX[i] + plane.y * CY[i] + plane.z * CZ[i] + plane.w;
+            float r = std::abs(plane.x) * EX[i] + std::abs(plane.y) * EY[i] + std::abs(plane.z) * EZ[i];
+            outside |= (d + r < -1e-6f);
+            crossing |= (d - r < 0.0f);
+        }
+
+        INX_WriteCullBits(visible, inside, i, outside, crossing, 0x1);
+    }
+}
+
+void INX_Frustum::CullSpheres(const INX_SphereBatch& spheres, uint64_t* visible, uint64_t* inside) const
+{
+    // Same tests as 'ClassifySphere', outside when 'd < -r', crossing when 'd < r'
+
+    const size_t count = spheres.GetSize();
+    const size_t words = INX_GetCullMaskSize(count);
+
+    std::fill_n(visible, words, 0);
+    if (inside != nullptr) {
+        std::fill_n(inside, words, 0);
+    }
+
+    const float* NX_RESTRICT CX = spheres.centerX.GetData();
+    const float* NX_RESTRICT CY = spheres.centerY.GetData();
+    const float* NX_RESTRICT CZ = spheres.centerZ.GetData();
+    const float* NX_RESTRICT R = spheres.radius.GetData();
+
+    size_t i = 0;
+
+#if defined(NX_HAS_AVX)
+
+    const __m256 zero = _mm256_setzero_ps();
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 cx = _mm256_loadu_ps(CX + i), cy = _mm256_loadu_ps(CY + i), cz = _mm256_loadu_ps(CZ + i);
+        __m256 r = _mm256_loadu_ps(R + i);
+        __m256 negR = _mm256_sub_ps(zero, r);
+
+        __m256 outside = zero;
+        __m256 crossing = zero;
+
+        for (int p = 0; p < PLANE_COUNT; p++) {
+            const NX_Vec4& plane = mPlanes[p];
+            __m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+                _mm256_mul_ps(_mm256_set1_ps(plane.x), cx),
+                _mm256_mul_ps(_mm256_set1_ps(plane.y), cy)),
+                _mm256_mul_ps(_mm256_set1_ps(plane.z), cz)),
+                _mm256_set1_ps(plane.w));
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(d, negR, _CMP_LT_OQ));
+            crossing = _mm256_or_ps(crossing, _mm256_cmp_ps(d, r, _CMP_LT_OQ));
+        }
+
+        INX_WriteCullBits(visible, inside, i, _mm256_movemask_ps(outside), _mm256_movemask_ps(crossing), 0xFF);
+    }
+
+#elif defined(NX_HAS_SSE)
+
+    const __m128 zero = _mm_setzero_ps();
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 cx = _mm_loadu_ps(CX + i), cy = _mm_loadu_ps(CY + i), cz = _mm_loadu_ps(CZ + i);
+        __m128 r = _mm_loadu_ps(R + i);
+        __m128 negR = _mm_sub_ps(zero, r);
+
+        __m128 outside = zero;
+        __m128 crossing = zero;
+
+        for (int p = 0; p < PLANE_COUNT; p++) {
+            const NX_Vec4& plane = mPlanes[p];
+            __m128 d = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(_mm_set1_ps(plane.x), cx),
+                _mm_mul_ps(_mm_set1_ps(plane.y), cy)),
+                _mm_mul_ps(_mm_set1_ps(plane.z), cz)),
+                _mm_set1_ps(plane.w));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(d, negR));
+            crossing = _mm_or_ps(crossing, _mm_cmplt_ps(d, r));
+        }
+
+        INX_WriteCullBits(visible, inside, i, _mm_movemask_ps(outside), _mm_movemask_ps(crossing), 0xF);
+    }
+
+#elif defined(NX_HAS_NEON) || defined(NX_HAS_NEON_FMA)
+
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4_t cx = vld1q_f32(CX + i), cy = vld1q_f32(CY + i), cz = vld1q_f32(CZ + i);
+        float32x4_t r = vld1q_f32(R + i);
+        float32x4_t negR = vnegq_f32(r);
+
+        uint32x4_t outside = vdupq_n_u32(0);
+        uint32x4_t crossing = vdupq_n_u32(0);
+
+        for (int p = 0; p < PLANE_COUNT; p++) {
+            const NX_Vec4& plane = mPlanes[p];
+            float32x4_t d = vaddq_f32(vaddq_f32(vaddq_f32(
+                vmulq_n_f32(cx, plane.x),
+                vmulq_n_f32(cy, plane.y)),
+                vmulq_n_f32(cz, plane.z)),
+                vdupq_n_f32(plane.w));
+            outside = vorrq_u32(outside, vcltq_f32(d, negR));
+            crossing = vorrq_u32(crossing, vcltq_f32(d, r));
+        }
+
+        INX_WriteCullBits(visible, inside, i, INX_MoveMaskNeon(outside), INX_MoveMaskNeon(crossing), 0xF);
+    }
+
+#endif
+
+    /* --- Remaining objects, or all of them without SIMD support --- */
+
+    for (; i < count; i++)
+    {
+        uint32_t outside = 0, crossing = 0;
+
+        for (int p = 0; p < PLANE_COUNT; p++) {
+            float d = DistanceToPlane(mPlanes[p], NX_VEC3(CX[i], CY[i], CZ[i]));
+            outside |= (d < -R[i]);
+            crossing |= (d < R[i]);
+        }
+
+        INX_WriteCullBits(visible, inside, i, outside, crossing, 0x1);
+    }
+}
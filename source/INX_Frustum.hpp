@@ -9,10 +9,39 @@
 #ifndef INX_FRUSTUM_HPP
 #define INX_FRUSTUM_HPP
 
+#include "./Detail/Util/DynamicArray.hpp"
 #include "./NX_Shape.hpp"
 #include <NX/NX_Math.h>
 #include <array>
 
+/* === Batch Bounds === */
+
+/** World space boxes stored as structure of arrays for batch culling */
+struct INX_BoxBatch {
+    util::DynamicArray<float> centerX, centerY, centerZ;
+    util::DynamicArray<float> extentX, extentY, extentZ;
+
+    bool Push(const NX_BoundingBox3D& aabb);
+    void Set(size_t index, const NX_BoundingBox3D& aabb);
+    size_t GetSize() const;
+    void Clear();
+};
+
+/** World space spheres stored as structure of arrays for batch culling */
+struct INX_SphereBatch {
+    util::DynamicArray<float> centerX, centerY, centerZ;
+    util::DynamicArray<float> radius;
+
+    bool Push(const INX_BoundingSphere3D& sphere);
+    void Set(size_t index, const INX_BoundingSphere3D& sphere);
+    size_t GetSize() const;
+    void Clear();
+};
+
+/** Culling results are bitmasks, one bit per object stored in 64-bit words */
+size_t INX_GetCullMaskSize(size_t count);
+bool INX_TestCullMask(const uint64_t* mask, size_t index);
+
 /* === Declaration === */
 
 class INX_Frustum {
@@ -36,6 +65,9 @@ public:
     /** INX_Frustum update */
     void Update(const NX_Mat4& viewProj);
 
+    /** Planes in 'Plane' order, positive distances are inside */
+    const NX_Vec4* GetPlanes() const;
+
     /** Contains or not */
     bool ContainsPoint(const NX_Vec3& position) const;
     bool ContainsPoints(const NX_Vec3* positions, int count) const;
@@ -45,6 +77,15 @@ public:
 
     /** Classification */
     Containment ClassifySphere(const INX_BoundingSphere3D& sphere) const;
+    Containment ClassifyAabb(const NX_BoundingBox3D& aabb) const;
+
+    /**
+     * Batch classification, 'visible' and 'inside' (optional) must hold 'INX_GetCullMaskSize(count)' words.
+     * A bit is set in 'visible' when the object is not outside, and in 'inside' when it is fully inside.
+     * Uses 8 lanes with AVX, 4 lanes with SSE or NEON, and a scalar loop otherwise.
+     */
+    void CullBoxes(const INX_BoxBatch& boxes, uint64_t* visible, uint64_t* inside = nullptr) const;
+    void CullSpheres(const INX_SphereBatch& spheres, uint64_t* visible, uint64_t* inside = nullptr) const;
 
 private:
     /** Helper functions */
@@ -54,6 +95,70 @@ private:
     NX_Vec4 mPlanes[6]{};
 };
 
+/* === Batch Bounds Implementation === */
+
+inline bool INX_BoxBatch::Push(const NX_BoundingBox3D& aabb)
+{
+    NX_Vec3 center = (aabb.min + aabb.max) * 0.5f;
+    NX_Vec3 extents = (aabb.max - aabb.min) * 0.5f;
+
+    return centerX.PushBack(center.x) && centerY.PushBack(center.y) && centerZ.PushBack(center.z)
+        && extentX.PushBack(extents.x) && extentY.PushBack(extents.y) && extentZ.PushBack(extents.z);
+}
+
+inline void INX_BoxBatch::Set(size_t index, const NX_BoundingBox3D& aabb)
+{
+    NX_Vec3 center = (aabb.min + aabb.max) * 0.5f;
+    NX_Vec3 extents = (aabb.max - aabb.min) * 0.5f;
+
+    centerX[index] = center.x, centerY[index] = center.y, centerZ[index] = center.z;
+    extentX[index] = extents.x, extentY[index] = extents.y, extentZ[index] = extents.z;
+}
+
+inline size_t INX_BoxBatch::GetSize() const
+{
+    return centerX.GetSize();
+}
+
+inline void INX_BoxBatch::Clear()
+{
+    centerX.Clear(), centerY.Clear(), centerZ.Clear();
+    extentX.Clear(), extentY.Clear(), extentZ.Clear();
+}
+
+inline bool INX_SphereBatch::Push(const INX_BoundingSphere3D& sphere)
+{
+    return centerX.PushBack(sphere.center.x) && centerY.PushBack(sphere.center.y)
+        && centerZ.PushBack(sphere.center.z) && radius.PushBack(sphere.radius);
+}
+
+inline void INX_SphereBatch::Set(size_t index, const INX_BoundingSphere3D& sphere)
+{
+    centerX[index] = sphere.center.x, centerY[index] = sphere.center.y;
+    centerZ[index] = sphere.center.z, radius[index] = sphere.radius;
+}
+
+inline size_t INX_SphereBatch::GetSize() const
+{
+    return centerX.GetSize();
+}
+
+inline void INX_SphereBatch::Clear()
+{
+    centerX.Clear(), centerY.Clear(), centerZ.Clear();
+    radius.Clear();
+}
+
+inline size_t INX_GetCullMaskSize(size_t count)
+{
+    return (count + 63) / 64;
+}
+
+inline bool INX_TestCullMask(const uint64_t* mask, size_t index)
+{
+    return (mask[index >> 6] >> (index & 63)) & 1;
+}
+
 /* === Public Implementation === */
 
 inline INX_Frustum::INX_Frustum(const NX_Mat4& viewProj)
@@ -106,6 +211,11 @@ inline void INX_Frustum::Update(const NX_Mat4& viewProj)
     });
 }
 
+inline const NX_Vec4* INX_Frustum::GetPlanes() const
+{
+    return mPlanes;
+}
+
 inline bool INX_Frustum::ContainsPoint(const NX_Vec3& position) const
 {
     for (int i = 0; i < PLANE_COUNT; i++) {
@@ -193,6 +303,33 @@ inline INX_Frustum::Containment INX_Frustum::ClassifySphere(const INX_BoundingSp
     return fullyInside ? Containment::Inside : Containment::Intersect;
 }
 
+inline INX_Frustum::Containment INX_Frustum::ClassifyAabb(const NX_BoundingBox3D& aabb) const
+{
+    bool fullyInside = true;
+
+    for (int i = 0; i < PLANE_COUNT; ++i)
+    {
+        const NX_Vec4& plane = mPlanes[i];
+
+        // Farthest and nearest corners along the plane normal
+        NX_Vec3 positive = {
+            .x = (plane.x >= 0.0f) ? aabb.max.x : aabb.min.x,
+            .y = (plane.y >= 0.0f) ? aabb.max.y : aabb.min.y,
+            .z = (plane.z >= 0.0f) ? aabb.max.z : aabb.min.z
+        };
+        NX_Vec3 negative = {
+            .x = (plane.x >= 0.0f) ? aabb.min.x : aabb.max.x,
+            .y = (plane.y >= 0.0f) ? aabb.min.y : aabb.max.y,
+            .z = (plane.z >= 0.0f) ? aabb.min.z : aabb.max.z
+        };
+
+        if (DistanceToPlane(plane, positive) < -1e-6f) return Containment::Outside;
+        if (DistanceToPlane(plane, negative) < 0.0f) fullyInside = false;
+    }
+
+    return fullyInside ? Containment::Inside : Containment::Intersect;
+}
+
 /* === Private Implementation === */
 
 inline float INX_Frustum::DistanceToPlane(const NX_Vec4& plane, const NX_Vec3& position)
@@ -7,6 +7,7 @@
  */
 
 #include "./INX_GPUProgramCache.hpp"
+#include "./INX_ProgramBinaryCache.hpp"
 #include "./INX_AssetDecoder.hpp"
 
 #include "./Detail/GPU/Program.hpp"
@@ -21,6 +22,9 @@
 #include <shaders/cubemap_skybox.frag.h>
 
 #include <shaders/light_culling.comp.h>
+#include <shaders/instance_culling.comp.h>
+#include <shaders/instance_gather.comp.h>
+#include <shaders/hiz_downsample.comp.h>
 #include <shaders/skybox.vert.h>
 #include <shaders/skybox.frag.h>
 
@@ -52,9 +56,9 @@ gpu::Program& INX_GPUProgramCache::GetCubemapFromEquirectangular()
         return program;
     }
 
-    program = gpu::Program(
-        GetVertexShaderScreen(),
-        gpu::Shader(
+    program = INX_ProgramBinaries.CreateProgram(
+        GetVertexStageScreen(),
+        INX_ProgramStage(
             GL_FRAGMENT_SHADER,
             INX_ShaderDecoder(
                 CUBEMAP_FROM_EQUIRECTANGULAR_FRAG,
@@ -74,8 +78,8 @@ gpu::Program& INX_GPUProgramCache::GetCubemapIrradiance()
         return program;
     }
 
-    program = gpu::Program(
-        gpu::Shader(
+    program = INX_ProgramBinaries.CreateProgram(
+        INX_ProgramStage(
             GL_COMPUTE_SHADER,
             INX_ShaderDecoder(
                 CUBEMAP_IRRADIANCE_COMP,
@@ -95,8 +99,8 @@ gpu::Program& INX_GPUProgramCache::GetCubemapPrefilter()
         return program;
     }
 
-    program = gpu::Program(
-        gpu::Shader(
+    program = INX_ProgramBinaries.CreateProgram(
+        INX_ProgramStage(
             GL_COMPUTE_SHADER,
             INX_ShaderDecoder(
                 CUBEMAP_PREFILTER_COMP,
@@ -116,9 +120,9 @@ gpu::Program& INX_GPUProgramCache::GetCubemapSkybox()
         return program;
     }
 
-    program = gpu::Program(
-        GetVertexShaderCube(),
-        gpu::Shader(
+    program = INX_ProgramBinaries.CreateProgram(
+        GetVertexStageCube(),
+        INX_ProgramStage(
             GL_FRAGMENT_SHADER,
             INX_ShaderDecoder(
                 CUBEMAP_SKYBOX_FRAG,
@@ -138,8 +142,8 @@ gpu::Program& INX_GPUProgramCache::GetLightCulling()
         return program;
     }
 
-    program = gpu::Program(
-        gpu::Shader(
+    program = INX_ProgramBinaries.CreateProgram(
+        INX_ProgramStage(
             GL_COMPUTE_SHADER,
             INX_ShaderDecoder(
                 LIGHT_CULLING_COMP,
@@ -151,6 +155,69 @@ gpu::Program& INX_GPUProgramCache::GetLightCulling()
     return program;
 }
 
+gpu::Program& INX_GPUProgramCache::GetInstanceCulling()
+{
+    gpu::Program& program = mPrograms[INX_PROG_INSTANCE_CULLING];
+
+    if (program.IsValid()) {
+        return program;
+    }
+
+    program = INX_ProgramBinaries.CreateProgram(
+        INX_ProgramStage(
+            GL_COMPUTE_SHADER,
+            INX_ShaderDecoder(
+                INSTANCE_CULLING_COMP,
+                INSTANCE_CULLING_COMP_SIZE
+            )
+        )
+    );
+
+    return program;
+}
+
+gpu::Program& INX_GPUProgramCache::GetInstanceGather()
+{
+    gpu::Program& program = mPrograms[INX_PROG_INSTANCE_GATHER];
+
+    if (program.IsValid()) {
+        return program;
+    }
+
+    program = INX_ProgramBinaries.CreateProgram(
+        INX_ProgramStage(
+            GL_COMPUTE_SHADER,
+            INX_ShaderDecoder(
+                INSTANCE_GATHER_COMP,
+                INSTANCE_GATHER_COMP_SIZE
+            )
+        )
+    );
+
+    return program;
+}
+
+gpu::Program& INX_GPUProgramCache::GetHiZDownsample()
+{
+    gpu::Program& program = mPrograms[INX_PROG_HIZ_DOWNSAMPLE];
+
+    if (program.IsValid()) {
+        return program;
+    }
+
+    program = INX_ProgramBinaries.CreateProgram(
+        INX_ProgramStage(
+            GL_COMPUTE_SHADER,
+            INX_ShaderDecoder(
+                HIZ_DOWNSAMPLE_COMP,
+                HIZ_DOWNSAMPLE_COMP_SIZE
+            )
+        )
+    );
+
+    return program;
+}
+
 gpu::Program& INX_GPUProgramCache::GetSkybox()
 {
     gpu::Program& program = mPrograms[INX_PROG_SKYBOX];
@@ -159,15 +226,15 @@ gpu::Program& INX_GPUProgramCache::GetSkybox()
         return program;
     }
 
-    program = gpu::Program(
-        gpu::Shader(
+    program = INX_ProgramBinaries.CreateProgram(
+        INX_ProgramStage(
             GL_VERTEX_SHADER,
             INX_ShaderDecoder(
                 SKYBOX_VERT,
                 SKYBOX_VERT_SIZE
             )
         ),
-        gpu::Shader(
+        INX_ProgramStage(
             GL_FRAGMENT_SHADER,
             INX_ShaderDecoder(
                 SKYBOX_FRAG,
@@ -207,9 +274,9 @@ gpu::Program& INX_GPUProgramCache::GetBloomComposite(NX_Bloom mode)
         return program;
     }
 
-    program = gpu::Program(
-        GetVertexShaderScreen(),
-        gpu::Shader(
+    program = INX_ProgramBinaries.CreateProgram(
+        GetVertexStageScreen(),
+        INX_ProgramStage(
             GL_FRAGMENT_SHADER,
             INX_ShaderDecoder(
                 BLOOM_COMPOSITE_FRAG,
@@ -230,9 +297,9 @@ gpu::Program& INX_GPUProgramCache::GetBloomDownsample()
         return program;
     }
 
-    program = gpu::Program(
-        GetVertexShaderScreen(),
-        gpu::Shader(
+    program = INX_ProgramBinaries.CreateProgram(
+        GetVertexStageScreen(),
+        INX_ProgramStage(
             GL_FRAGMENT_SHADER,
             INX_ShaderDecoder(
                 BLOOM_DOWNSAMPLE_FRAG,
@@ -252,9 +319,9 @@ gpu::Program& INX_GPUProgramCache::GetBloomUpsample()
         return program;
     }
 
-    program = gpu::Program(
-        GetVertexShaderScreen(),
-        gpu::Shader(
+    program = INX_ProgramBinaries.CreateProgram(
+        GetVertexStageScreen(),
+        INX_ProgramStage(
             GL_FRAGMENT_SHADER,
             INX_ShaderDecoder(
                 BLOOM_UPSAMPLE_FRAG,
@@ -274,9 +341,9 @@ gpu::Program& INX_GPUProgramCache::GetSsaoPass()
         return program;
     }
 
-    program = gpu::Program(
-        GetVertexShaderScreen(),
-        gpu::Shader(
+    program = INX_ProgramBinaries.CreateProgram(
+        GetVertexStageScreen(),
+        INX_ProgramStage(
             GL_FRAGMENT_SHADER,
             INX_ShaderDecoder(
                 SSAO_PASS_FRAG,
@@ -296,9 +363,9 @@ gpu::Program& INX_GPUProgramCache::GetEdgeAwareBlur()
         return program;
     }
 
-    program = gpu::Program(
-        GetVertexShaderScreen(),
-        gpu::Shader(
+    program = INX_ProgramBinaries.CreateProgram(
+        GetVertexStageScreen(),
+        INX_ProgramStage(
             GL_FRAGMENT_SHADER,
             INX_ShaderDecoder(
                 EDGE_AWARE_BLUR_FRAG,
@@ -341,7 +408,7 @@ gpu::Program& INX_GPUProgramCache::GetOutput(NX_Tonemap tonemap)
         return program;
     }
 
-    gpu::Shader frag(
+    INX_ProgramStage frag(
         GL_FRAGMENT_SHADER,
         INX_ShaderDecoder(
             OUTPUT_FRAG,
@@ -350,7 +417,7 @@ gpu::Program& INX_GPUProgramCache::GetOutput(NX_Tonemap tonemap)
         {tonemapper}
     );
 
-    program = gpu::Program(GetVertexShaderScreen(), frag);
+    program = INX_ProgramBinaries.CreateProgram(GetVertexStageScreen(), frag);
 
     return program;
 }
@@ -363,9 +430,9 @@ gpu::Program& INX_GPUProgramCache::GetOverlay()
         return program;
     }
 
-    program = gpu::Program(
-        GetVertexShaderScreen(),
-        gpu::Shader(
+    program = INX_ProgramBinaries.CreateProgram(
+        GetVertexStageScreen(),
+        INX_ProgramStage(
             GL_FRAGMENT_SHADER,
             INX_ShaderDecoder(
                 OVERLAY_FRAG,
@@ -385,9 +452,9 @@ gpu::Program& INX_GPUProgramCache::GetScreenQuad()
         return program;
     }
 
-    program = gpu::Program(
-        GetVertexShaderScreen(),
-        gpu::Shader(
+    program = INX_ProgramBinaries.CreateProgram(
+        GetVertexStageScreen(),
+        INX_ProgramStage(
             GL_FRAGMENT_SHADER,
             INX_ShaderDecoder(
                 SCREEN_QUAD_FRAG,
@@ -404,21 +471,21 @@ void INX_GPUProgramCache::UnloadAll()
     for (gpu::Program& program : mPrograms) {
         program = gpu::Program{};
     }
-    mVertexShaderScreen = gpu::Shader{};
-    mVertexShaderCube = gpu::Shader{};
+    mVertexStageScreen = INX_ProgramStage{};
+    mVertexStageCube = INX_ProgramStage{};
 }
 
 // ============================================================================
 // PRIVATE FUNCTIONS
 // ============================================================================
 
-gpu::Shader& INX_GPUProgramCache::GetVertexShaderScreen()
+const INX_ProgramStage& INX_GPUProgramCache::GetVertexStageScreen()
 {
-    if (mVertexShaderScreen.IsValid()) {
-        return mVertexShaderScreen;
+    if (mVertexStageScreen.IsValid()) {
+        return mVertexStageScreen;
     }
 
-    mVertexShaderScreen = gpu::Shader(
+    mVertexStageScreen = INX_ProgramStage(
         GL_VERTEX_SHADER,
         INX_ShaderDecoder(
             SCREEN_VERT,
@@ -426,16 +493,16 @@ gpu::Shader& INX_GPUProgramCache::GetVertexShaderScreen()
         )
     );
 
-    return mVertexShaderScreen;
+    return mVertexStageScreen;
 }
 
-gpu::Shader& INX_GPUProgramCache::GetVertexShaderCube()
+const INX_ProgramStage& INX_GPUProgramCache::GetVertexStageCube()
 {
-    if (mVertexShaderCube.IsValid()) {
-        return mVertexShaderCube;
+    if (mVertexStageCube.IsValid()) {
+        return mVertexStageCube;
     }
 
-    mVertexShaderCube = gpu::Shader(
+    mVertexStageCube = INX_ProgramStage(
         GL_VERTEX_SHADER,
         INX_ShaderDecoder(
             CUBE_VERT,
@@ -443,5 +510,5 @@ gpu::Shader& INX_GPUProgramCache::GetVertexShaderCube()
         )
     );
 
-    return mVertexShaderCube;
+    return mVertexStageCube;
 }
@@ -11,8 +11,8 @@
 
 #include <NX/NX_Environment.h>
 
+#include "./INX_ProgramBinaryCache.hpp"
 #include "./Detail/GPU/Program.hpp"
-#include "./Detail/GPU/Shader.hpp"
 
 #include <array>
 
@@ -28,6 +28,9 @@ enum INX_ProgramID : uint16_t {
     INX_PROG_CUBEMAP_SKYBOX,
     /** Scene */
     INX_PROG_LIGHT_CULLING,
+    INX_PROG_INSTANCE_CULLING,
+    INX_PROG_INSTANCE_GATHER,
+    INX_PROG_HIZ_DOWNSAMPLE,
     INX_PROG_SKYBOX,
     /** Bloom generation */
     INX_PROG_BLOOM_DOWNSAMPLE,
@@ -71,6 +74,9 @@ public:
 
     /** Scene programs */
     gpu::Program& GetLightCulling();
+    gpu::Program& GetInstanceCulling();
+    gpu::Program& GetInstanceGather();
+    gpu::Program& GetHiZDownsample();
     gpu::Program& GetSkybox();
 
     /** Bloom programs */
@@ -97,13 +103,13 @@ public:
     void UnloadAll();
 
 private:
-    gpu::Shader& GetVertexShaderScreen();
-    gpu::Shader& GetVertexShaderCube();
+    const INX_ProgramStage& GetVertexStageScreen();
+    const INX_ProgramStage& GetVertexStageCube();
 
 private:
     std::array<gpu::Program, INX_PROG_COUNT> mPrograms{};
-    gpu::Shader mVertexShaderScreen{};
-    gpu::Shader mVertexShaderCube{};
+    INX_ProgramStage mVertexStageScreen{};     //< Shared by most programs, compiled on cache misses
+    INX_ProgramStage mVertexStageCube{};
 
 };
 
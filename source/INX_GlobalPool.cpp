@@ -13,3 +13,82 @@
 // ============================================================================
 
 INX_GlobalPool INX_Pool{};
+
+// ============================================================================
+// SHARED TEXTURES
+// ============================================================================
+
+NX_Texture* INX_GlobalPool::AcquireSharedTexture(uint64_t key)
+{
+    std::lock_guard<std::mutex> lock(mSharedMutex);
+
+    auto it = mSharedTextures.find(key);
+    if (it == mSharedTextures.end()) {
+        return nullptr;
+    }
+
+    SharedTexture& shared = it->second;
+    shared.refCount++;
+
+    mSharedReferences++;
+    mSharedHits++;
+    mSharedBytesSaved += shared.bytes;
+
+    return shared.texture;
+}
+
+bool INX_GlobalPool::ShareTexture(NX_Texture* texture, uint64_t key, size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(mSharedMutex);
+
+    // The texture is counted as created even if it cannot be shared
+    mSharedMisses++;
+
+    if (key == 0 || !mSharedTextures.try_emplace(key, SharedTexture{texture, bytes, 1}).second) {
+        return false;
+    }
+
+    texture->shareKey = key;
+    mSharedReferences++;
+
+    return true;
+}
+
+bool INX_GlobalPool::ReleaseSharedTexture(NX_Texture* texture)
+{
+    if (texture->shareKey == 0) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(mSharedMutex);
+
+    auto it = mSharedTextures.find(texture->shareKey);
+    if (it == mSharedTextures.end() || it->second.texture != texture) {
+        return true;
+    }
+
+    mSharedReferences--;
+
+    if (--it->second.refCount > 0) {
+        return false;
+    }
+
+    // Removed before the destruction, workers can no longer acquire it
+    mSharedTextures.erase(it);
+    texture->shareKey = 0;
+
+    return true;
+}
+
+NX_TextureImportStats INX_GlobalPool::GetTextureImportStats()
+{
+    std::lock_guard<std::mutex> lock(mSharedMutex);
+
+    return NX_TextureImportStats {
+        .textures = static_cast<int>(mSharedTextures.size()),
+        .references = mSharedReferences,
+        .hits = mSharedHits,
+        .misses = mSharedMisses,
+        .bytesSaved = mSharedBytesSaved
+    };
+}
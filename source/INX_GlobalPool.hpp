@@ -17,7 +17,10 @@
 #include "./Detail/Util/ObjectPool.hpp"
 #include "./NX_InstanceBuffer.hpp"
 #include "./NX_RenderTexture.hpp"
+#include "./NX_CommandList2D.hpp"
 #include "./NX_IndirectLight.hpp"
+#include "./NX_TextLayout.hpp"
+#include "./NX_SceneObject.hpp"
 #include "./NX_DynamicMesh.hpp"
 #include "./NX_AudioStream.hpp"
 #include "./NX_AudioClip.hpp"
@@ -28,6 +31,9 @@
 #include "./NX_Light.hpp"
 #include "./NX_Font.hpp"
 
+#include <unordered_map>
+#include <mutex>
+
 // ============================================================================
 // ASSETS POOL
 // ============================================================================
@@ -44,6 +50,7 @@ public:
     using InstanceBuffers   = util::ObjectPool<NX_InstanceBuffer, 32>;
     using IndirectLights    = util::ObjectPool<NX_IndirectLight, 128>;
     using RenderTextures    = util::ObjectPool<NX_RenderTexture, 16>;
+    using SceneObjects      = util::ObjectPool<NX_SceneObject, 1024>;
     using AnimationLibs     = util::ObjectPool<NX_AnimationLib, 256>;
     using DynamicMeshes     = util::ObjectPool<NX_DynamicMesh, 32>;
     using Skeletons         = util::ObjectPool<NX_Skeleton, 128>;
@@ -53,6 +60,8 @@ public:
     using Models            = util::ObjectPool<NX_Model, 128>;
     using Meshes            = util::ObjectPool<NX_Mesh, 512>;
     using Fonts             = util::ObjectPool<NX_Font, 32>;
+    using TextLayouts       = util::ObjectPool<NX_TextLayout, 1024>;
+    using CommandLists2D    = util::ObjectPool<NX_CommandList2D, 256>;
 
     /** Shaders */
     using Shaders3D         = util::ObjectPool<NX_Shader3D, 32>;
@@ -73,6 +82,25 @@ public:
 
     void UnloadAll();
 
+public:
+    /**
+     * Textures shared by imported models, identified by a key describing their
+     * content and sampler. Each material using one holds a reference, released by
+     * NX_DestroyTexture(). These functions can be called from any thread, except
+     * the release which happens on the main thread like every destruction.
+     */
+
+    /** Returns a new reference to the texture of 'key', or nullptr if there is none */
+    NX_Texture* AcquireSharedTexture(uint64_t key);
+
+    /** Registers a texture just created for 'key' with a single reference, fails if the key is taken */
+    bool ShareTexture(NX_Texture* texture, uint64_t key, size_t bytes);
+
+    /** Releases a reference, returns true if the texture must be destroyed */
+    bool ReleaseSharedTexture(NX_Texture* texture);
+
+    NX_TextureImportStats GetTextureImportStats();
+
 private:
     /** Audio */
     AudioStreams     mAudioStreams;
@@ -84,6 +112,7 @@ private:
     InstanceBuffers  mInstanceBuffers;
     IndirectLights   mIndirectLights;
     RenderTextures   mRenderTextures;
+    SceneObjects     mSceneObjects;
     AnimationLibs    mAnimationLibs;
     DynamicMeshes    mDynamicMeshes;
     Skeletons        mSkeletons;
@@ -93,11 +122,26 @@ private:
     Meshes           mMeshes;
     Lights           mLights;
     Fonts            mFonts;
+    TextLayouts      mTextLayouts;
+    CommandLists2D   mCommandLists2D;
 
     /** Shaders */
     Shaders3D        mShaders3D;
     Shaders2D        mShaders2D;
 
+    /** Shared textures */
+    struct SharedTexture {
+        NX_Texture* texture;
+        size_t bytes;
+        int refCount;
+    };
+
+    std::unordered_map<uint64_t, SharedTexture> mSharedTextures;
+    std::mutex mSharedMutex;            //< Protects the shared textures and their statistics
+    int mSharedReferences{};
+    int mSharedHits{};
+    int mSharedMisses{};
+    int64_t mSharedBytesSaved{};
 };
 
 extern INX_GlobalPool INX_Pool;
@@ -112,6 +156,7 @@ inline auto& INX_GlobalPool::Get()
     else if constexpr (std::is_same_v<T, NX_InstanceBuffer>)  return mInstanceBuffers;
     else if constexpr (std::is_same_v<T, NX_IndirectLight>)   return mIndirectLights;
     else if constexpr (std::is_same_v<T, NX_RenderTexture>)   return mRenderTextures;
+    else if constexpr (std::is_same_v<T, NX_SceneObject>)     return mSceneObjects;
     else if constexpr (std::is_same_v<T, NX_AnimationLib>)    return mAnimationLibs;
     else if constexpr (std::is_same_v<T, NX_DynamicMesh>)     return mDynamicMeshes;
     else if constexpr (std::is_same_v<T, NX_Skeleton>)        return mSkeletons;
@@ -121,6 +166,8 @@ inline auto& INX_GlobalPool::Get()
     else if constexpr (std::is_same_v<T, NX_Mesh>)            return mMeshes;
     else if constexpr (std::is_same_v<T, NX_Light>)           return mLights;
     else if constexpr (std::is_same_v<T, NX_Font>)            return mFonts;
+    else if constexpr (std::is_same_v<T, NX_TextLayout>)      return mTextLayouts;
+    else if constexpr (std::is_same_v<T, NX_CommandList2D>)   return mCommandLists2D;
     else if constexpr (std::is_same_v<T, NX_Shader3D>)        return mShaders3D;
     else if constexpr (std::is_same_v<T, NX_Shader2D>)        return mShaders2D;
     else static_assert(false, "Type not supported by INX_GlobalPool");
@@ -159,6 +206,7 @@ inline void INX_GlobalPool::UnloadAll()
     clear(mShaders2D,        "NX_Shader2D");
     clear(mShaders3D,        "NX_Shader3D");
     clear(mLights,           "NX_Light");
+    clear(mSceneObjects,     "NX_SceneObject");
     clear(mModels,           "NX_Model");
     clear(mMeshes,           "NX_Mesh");
     clear(mSkeletons,        "NX_Skeleton");
@@ -170,10 +218,19 @@ inline void INX_GlobalPool::UnloadAll()
     clear(mIndirectLights,   "NX_IndirectLight");
     clear(mRenderTextures,   "NX_RenderTexture");
     clear(mCubemaps,         "NX_Cubemap");
+    clear(mCommandLists2D,   "NX_CommandList2D");
+    clear(mTextLayouts,      "NX_TextLayout");
     clear(mFonts,            "NX_Font");
     clear(mTextures,         "NX_Texture");
     clear(mAudioClips,       "NX_AudioClip");
     clear(mAudioStreams,     "NX_AudioStream");
+
+    std::lock_guard<std::mutex> lock(mSharedMutex);
+    mSharedTextures.clear();
+    mSharedReferences = 0;
+    mSharedHits = 0;
+    mSharedMisses = 0;
+    mSharedBytesSaved = 0;
 }
 
 #endif // INX_GLOBAL_POOL_HPP
@@ -9,6 +9,7 @@
 #ifndef INX_GLOBAL_STATE_HPP
 #define INX_GLOBAL_STATE_HPP
 
+#include <NX/NX_Render2D.h>
 #include <NX/NX_Math.h>
 
 #include <SDL3/SDL_scancode.h>
@@ -57,6 +58,10 @@ extern struct INX_FrameState {
     double currentDeltaTime{};
     double elapsedTime{};
     double fpsAverage{};
+    uint32_t textureBinds{};            //< Texture bind calls of the current frame
+    uint32_t lastTextureBinds{};        //< Texture bind calls of the previous frame
+    NX_Render2DStats render2D{};        //< 2D batching statistics of the current frame
+    NX_Render2DStats lastRender2D{};    //< 2D batching statistics of the previous frame
 } INX_Frame;
 
 #endif // INX_GLOBAL_STATE_HPP
@@ -0,0 +1,432 @@
+/* INX_GlyphCache.cpp -- Internal glyph table and on-demand glyph rasterization
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#include "./INX_GlyphCache.hpp"
+
+#include <NX/NX_Memory.h>
+#include <NX/NX_Math.h>
+#include <NX/NX_Log.h>
+
+#include <SDL3/SDL_stdinc.h>
+#include <algorithm>
+#include <cmath>
+
+// ============================================================================
+// FREETYPE INCLUDES
+// ============================================================================
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_GLYPH_H
+
+// ============================================================================
+// STB RECT PACK IMPLEMENTATION
+// ============================================================================
+
+#define STB_RECT_PACK_IMPLEMENTATION
+#include <stb_rect_pack.h>
+
+// ============================================================================
+// LIFETIME
+// ============================================================================
+
+INX_GlyphCache::~INX_GlyphCache()
+{
+    NX_DestroyImage(&mAtlas);
+
+    if (mFace != nullptr) FT_Done_Face(mFace);
+    if (mLibrary != nullptr) FT_Done_FreeType(mLibrary);
+}
+
+bool INX_GlyphCache::Init(const void* fileData, size_t dataSize, NX_FontType type, int baseSize,
+                          int padding, const int* codepoints, int codepointCount)
+{
+    /* --- Render mode of the font type --- */
+
+    FT_Render_Mode renderMode{};
+    FT_Int32 loadFlags = FT_LOAD_RENDER | FT_LOAD_NO_AUTOHINT;
+
+    switch (type) {
+    case NX_FONT_NORMAL:
+        renderMode = FT_RENDER_MODE_NORMAL;
+        loadFlags |= FT_LOAD_TARGET_NORMAL;
+        break;
+    case NX_FONT_LIGHT:
+        renderMode = FT_RENDER_MODE_LIGHT;
+        loadFlags |= FT_LOAD_TARGET_LIGHT;
+        break;
+    case NX_FONT_MONO:
+        renderMode = FT_RENDER_MODE_MONO;
+        loadFlags |= FT_LOAD_TARGET_MONO;
+        break;
+    case NX_FONT_SDF:
+        renderMode = FT_RENDER_MODE_SDF;
+        loadFlags |= FT_LOAD_TARGET_NORMAL;
+        break;
+    default:
+        NX_LOG(E, "RENDER: Faild to load font; Invalid font type (%i)", type);
+        return false;
+    }
+
+    mRenderMode = renderMode;
+    mLoadFlags = loadFlags;
+    mType = type;
+    mBaseSize = baseSize;
+    mPadding = padding;
+
+    /* --- Font validation and init --- */
+
+    if (fileData == nullptr || dataSize == 0) {
+        return false;
+    }
+
+    if (!mFileData.Resize(dataSize)) {
+        return false;
+    }
+    SDL_memcpy(mFileData.GetData(), fileData, dataSize);
+
+    if (FT_Init_FreeType(&mLibrary) != 0) {
+        mLibrary = nullptr;
+        return false;
+    }
+
+    if (FT_New_Memory_Face(mLibrary, mFileData.GetData(), static_cast<FT_Long>(dataSize), 0, &mFace) != 0) {
+        mFace = nullptr;
+        return false;
+    }
+
+    if (FT_Set_Pixel_Sizes(mFace, 0, baseSize) != 0) {
+        return false;
+    }
+
+    mAscent = static_cast<int>(mFace->size->metrics.ascender >> 6);
+
+    /* --- Rasterize the requested codepoints, ASCII printable characters by default --- */
+
+    if (codepoints == nullptr) {
+        codepointCount = (codepointCount > 0) ? codepointCount : 95;
+    }
+
+    if (!mGlyphs.Reserve(codepointCount)) {
+        return false;
+    }
+
+    std::fill(mDirect, mDirect + DirectCount, -1);
+
+    int totalArea = 0;
+
+    for (int i = 0; i < codepointCount; i++)
+    {
+        int codepoint = (codepoints != nullptr) ? codepoints[i] : i + 32;
+
+        int index = (codepoint >= 0 && codepoint < DirectCount) ? mDirect[codepoint] : FindSlot(codepoint);
+        if (index >= 0 || (index = RasterizeGlyph(codepoint)) < 0) {
+            continue;
+        }
+
+        if (codepoint >= 0 && codepoint < DirectCount) mDirect[codepoint] = index;
+        else InsertSlot(codepoint, index);
+
+        const INX_Glyph& glyph = mGlyphs[index];
+        totalArea += (glyph.wGlyph + 2 * padding) * (glyph.hGlyph + 2 * padding);
+    }
+
+    /* --- Calculate atlas dimensions --- */
+
+    // NOTE: This naive method is currently the most stable and provides
+    //       the best size efficiency across various configurations,
+    //       though it can be significantly improved...
+
+    int estimatedArea = (int)(totalArea * 1.3f); // 30% safety margin
+    int atlasSize = std::max((int)roundf(sqrtf((float)estimatedArea)), 64);
+
+    // Get next po2 if necessary
+    if (!NX_IsPowerOfTwo(atlasSize)) {
+        atlasSize = NX_NextPowerOfTwo(atlasSize);
+    }
+
+    // Try rectangle first (wider than tall), use square if rectangle is too small
+    int atlasW = atlasSize;
+    int atlasH = (totalArea > atlasSize * (atlasSize / 2)) ? atlasSize : atlasSize / 2;
+
+    /* --- Pack the glyphs, growing the atlas if the estimation was too tight --- */
+
+    while (!PackAllGlyphs(atlasW, atlasH)) {
+        if (atlasH < atlasW) atlasH *= 2;
+        else atlasW *= 2;
+        if (atlasW > MaxAtlasSize) {
+            NX_LOG(E, "RENDER: Font glyphs do not fit in a %ix%i atlas", MaxAtlasSize, MaxAtlasSize);
+            return false;
+        }
+    }
+
+    /* --- Resolve the fallback glyph --- */
+
+    mFallback = (mDirect['?'] >= 0) ? mDirect['?'] : ResolveGlyph('?');
+
+    return true;
+}
+
+// ============================================================================
+// PRIVATE METHODS
+// ============================================================================
+
+int INX_GlyphCache::ResolveGlyph(int codepoint)
+{
+    // NOTE: Codepoints missing from the face are stored with the fallback index,
+    //       so FreeType is only queried once for each of them
+
+    int index = (codepoint >= 0) ? RasterizeGlyph(codepoint) : -1;
+
+    if (index < 0) {
+        if (mGlyphs.IsEmpty() && !mGlyphs.EmplaceBack()) {
+            return 0; // Only reachable if we are out of memory anyway
+        }
+        index = mFallback;
+    }
+
+    if (codepoint >= 0 && codepoint < DirectCount) {
+        mDirect[codepoint] = index;
+    }
+    else if (codepoint >= 0) {
+        InsertSlot(codepoint, index);
+    }
+
+    return index;
+}
+
+int INX_GlyphCache::RasterizeGlyph(int codepoint)
+{
+    if (mFace == nullptr) {
+        return -1;
+    }
+
+    FT_UInt glyphIndex = FT_Get_Char_Index(mFace, codepoint);
+    if (glyphIndex == 0) {
+        return -1;
+    }
+    if (FT_Load_Glyph(mFace, glyphIndex, mLoadFlags) != 0) {
+        return -1;
+    }
+
+    INX_Glyph glyph{};
+    glyph.value = codepoint;
+
+    // Space character
+    if (codepoint == 32) {
+        glyph.xAdvance = (int)(mFace->glyph->advance.x >> 6);
+        glyph.xOffset = glyph.yOffset = 0;
+        glyph.wGlyph = glyph.xAdvance;
+        glyph.hGlyph = mBaseSize;
+    }
+
+    // Regular character
+    else {
+        // Rendering the glyph
+        if (FT_Render_Glyph(mFace->glyph, static_cast<FT_Render_Mode>(mRenderMode)) != 0) {
+            return -1;
+        }
+
+        // Get glyph and bitmap references
+        const FT_GlyphSlot ftGlyph = mFace->glyph;
+        const FT_Bitmap& ftBitmap = ftGlyph->bitmap;
+
+        // Get horizontal advance and the offset needed to draw the glyph
+        glyph.xAdvance = (int)(ftGlyph->advance.x >> 6);
+        glyph.xOffset = ftGlyph->bitmap_left;
+        glyph.yOffset = mAscent - ftGlyph->bitmap_top;
+
+        // Calculating the number of pixels in the bitmap, blank glyphs only keep their metrics
+        int pixelCount = ftBitmap.width * ftBitmap.rows;
+
+        if (pixelCount > 0)
+        {
+            // Allocation to keep the bitmap in our glyph cache
+            glyph.pixels = util::MakeUniqueArray<uint8_t>(pixelCount);
+            if (glyph.pixels == nullptr) {
+                return -1;
+            }
+
+            // Copying the rasterized bitmap to our glyph cache
+            if (mType != NX_FONT_MONO) {
+                SDL_memcpy(glyph.pixels.get(), ftBitmap.buffer, pixelCount);
+            }
+            else {
+                const FT_Bitmap &bm = ftBitmap;
+                for (unsigned int y = 0; y < bm.rows; ++y) {
+                    for (unsigned int x = 0; x < bm.width; ++x) {
+                        int byteIndex = y * bm.pitch + (x >> 3);
+                        int bitIndex = 7 - (x & 7);
+                        bool pixelOn = (bm.buffer[byteIndex] >> bitIndex) & 1;
+                        glyph.pixels.get()[y * bm.width + x] = pixelOn ? 255 : 0;
+                    }
+                }
+            }
+
+            // Keeps the pixel dimensions of the glyph
+            glyph.wGlyph = ftBitmap.width;
+            glyph.hGlyph = ftBitmap.rows;
+        }
+    }
+
+    if (!mGlyphs.PushBack(std::move(glyph))) {
+        return -1;
+    }
+
+    int index = static_cast<int>(mGlyphs.GetSize()) - 1;
+
+    // Glyphs rasterized during 'Init' are packed all at once afterwards
+    if (mAtlas.pixels != nullptr && !PackGlyph(index)) {
+        mGlyphs.PopBack();
+        return -1;
+    }
+
+    return index;
+}
+
+bool INX_GlyphCache::PackGlyph(int index)
+{
+    INX_Glyph& glyph = mGlyphs[index];
+
+    if (glyph.wGlyph == 0 || glyph.hGlyph == 0) {
+        return true;
+    }
+
+    /* --- Try to fit the glyph in the current free space --- */
+
+    if (mPackNodes.IsEmpty()) {
+        return false; // Atlas reached its maximum size
+    }
+
+    stbrp_rect rect{};
+    rect.w = glyph.wGlyph + 2 * mPadding;
+    rect.h = glyph.hGlyph + 2 * mPadding;
+
+    if (stbrp_pack_rects(&mPacker, &rect, 1) && rect.was_packed) {
+        glyph.xAtlas = rect.x + mPadding;
+        glyph.yAtlas = rect.y + mPadding;
+        CopyToAtlas(glyph);
+        return mNewGlyphs.PushBack(index);
+    }
+
+    /* --- Otherwise grow the atlas and repack everything --- */
+
+    int w = mAtlas.w, h = mAtlas.h;
+
+    while (true) {
+        if (h < w) h *= 2;
+        else w *= 2;
+        if (w > MaxAtlasSize) break;
+        if (PackAllGlyphs(w, h)) return true;
+    }
+
+    // The packer state was discarded by the failed attempts, but glyphs keep
+    // their previous positions, so we just stop adding glyphs from now on
+
+    NX_LOG(W, "RENDER: Font atlas is full, missing glyphs will use the fallback");
+    mPackNodes.Clear();
+
+    return false;
+}
+
+bool INX_GlyphCache::PackAllGlyphs(int w, int h)
+{
+    const int count = static_cast<int>(mGlyphs.GetSize());
+
+    /* --- Pack every glyph at once --- */
+
+    util::DynamicArray<stbrp_rect> rects{};
+    if (!rects.Resize(count) || !mPackNodes.Resize(w)) {
+        return false;
+    }
+
+    for (int i = 0; i < count; i++) {
+        rects[i].id = i;
+        rects[i].w = (mGlyphs[i].wGlyph > 0 && mGlyphs[i].hGlyph > 0) ? mGlyphs[i].wGlyph + 2 * mPadding : 0;
+        rects[i].h = (mGlyphs[i].wGlyph > 0 && mGlyphs[i].hGlyph > 0) ? mGlyphs[i].hGlyph + 2 * mPadding : 0;
+    }
+
+    stbrp_init_target(&mPacker, w, h, mPackNodes.GetData(), w);
+
+    if (!stbrp_pack_rects(&mPacker, rects.GetData(), count)) {
+        return false;
+    }
+
+    /* --- Create the new atlas and copy the glyphs --- */
+
+    NX_Image atlas = NX_CreateImage(w, h, NX_PIXEL_FORMAT_R8);
+    if (atlas.pixels == nullptr) {
+        return false;
+    }
+
+    NX_DestroyImage(&mAtlas);
+    mAtlas = atlas;
+
+    for (int i = 0; i < count; i++) {
+        INX_Glyph& glyph = mGlyphs[rects[i].id];
+        glyph.xAtlas = rects[i].x + mPadding;
+        glyph.yAtlas = rects[i].y + mPadding;
+        CopyToAtlas(glyph);
+    }
+
+    // The whole atlas has to be uploaded again, no need to track glyphs one by one
+    mNewGlyphs.Clear();
+    mAtlasGeneration++;
+
+    return true;
+}
+
+void INX_GlyphCache::CopyToAtlas(const INX_Glyph& glyph)
+{
+    // Skip spaces and null pixels
+    if (!glyph.pixels || glyph.value == 32) {
+        return;
+    }
+
+    // Copy glyph to atlas (line by line)
+    uint8_t* atlasLine = static_cast<uint8_t*>(mAtlas.pixels) + glyph.yAtlas * mAtlas.w + glyph.xAtlas;
+    const uint8_t* glyphData = glyph.pixels.get();
+
+    for (int y = 0; y < glyph.hGlyph; y++) {
+        SDL_memcpy(atlasLine, glyphData, glyph.wGlyph);
+        atlasLine += mAtlas.w, glyphData += glyph.wGlyph;
+    }
+}
+
+void INX_GlyphCache::InsertSlot(int codepoint, int index)
+{
+    /* --- Keep the load factor under one half --- */
+
+    if (2 * (mSlotCount + 1) > static_cast<int>(mSlots.GetSize()))
+    {
+        util::DynamicArray<Slot> slots{};
+        if (!slots.Resize(std::max<size_t>(64, 2 * mSlots.GetSize()), Slot{-1, -1})) {
+            return; // The codepoint will just be resolved again next time
+        }
+
+        slots.Swap(mSlots);
+        mSlotCount = 0;
+
+        for (size_t i = 0; i < slots.GetSize(); i++) {
+            if (slots[i].codepoint >= 0) InsertSlot(slots[i].codepoint, slots[i].index);
+        }
+    }
+
+    /* --- Linear probing --- */
+
+    const uint32_t mask = static_cast<uint32_t>(mSlots.GetSize()) - 1;
+    uint32_t slot = (static_cast<uint32_t>(codepoint) * 2654435761u) & mask;
+
+    while (mSlots[slot].codepoint >= 0) {
+        if (mSlots[slot].codepoint == codepoint) return;
+        slot = (slot + 1) & mask;
+    }
+
+    mSlots[slot] = Slot{codepoint, index};
+    mSlotCount++;
+}
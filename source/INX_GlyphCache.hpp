@@ -0,0 +1,200 @@
+/* INX_GlyphCache.hpp -- Internal glyph table and on-demand glyph rasterization
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef INX_GLYPH_CACHE_HPP
+#define INX_GLYPH_CACHE_HPP
+
+#include "./Detail/Util/DynamicArray.hpp"
+#include "./Detail/Util/Memory.hpp"
+
+#include <NX/NX_Image.h>
+#include <NX/NX_Font.h>
+
+#include <stb_rect_pack.h>
+#include <cstdint>
+
+// ============================================================================
+// FORWARD DECLARATIONS
+// ============================================================================
+
+typedef struct FT_LibraryRec_* FT_Library;
+typedef struct FT_FaceRec_* FT_Face;
+
+// ============================================================================
+// GLYPH
+// ============================================================================
+
+struct INX_Glyph {
+    util::UniquePtr<uint8_t> pixels;    //< Pixels of the glyph (R8 unorm)
+    int value;                          //< Unicode codepoint value
+    int xOffset;                        //< Horizontal offset when drawing the glyph
+    int yOffset;                        //< Vertical offset when drawing the glyph
+    int xAdvance;                       //< Horizontal advance to next character position
+    uint16_t xAtlas;                    //< X-coordinate position in texture atlas
+    uint16_t yAtlas;                    //< Y-coordinate position in texture atlas
+    uint16_t wGlyph;                    //< Width in pixels of the glyph (this also applies to the atlas)
+    uint16_t hGlyph;                    //< Height in pixels of the glyph (this also applies to the atlas)
+};
+
+// ============================================================================
+// GLYPH CACHE
+// ============================================================================
+
+/**
+ * @brief Glyphs of a font face and the R8 atlas image they are packed into.
+ *
+ * Lookups are constant time: codepoints below 256 index a direct array, the
+ * others go through an open addressing hash table. Both tables also remember
+ * codepoints missing from the face, which resolve to the fallback glyph ('?').
+ *
+ * A codepoint seen for the first time is rasterized with FreeType and packed
+ * into the free space of the atlas. When the atlas is full, it grows and every
+ * glyph is packed again, which bumps the atlas generation. The GPU side is not
+ * handled here, the owner uploads the glyphs reported by 'ConsumeNewGlyphs',
+ * or the whole atlas when its generation changed.
+ */
+class INX_GlyphCache {
+public:
+    static constexpr int MaxAtlasSize = 4096;
+
+public:
+    /** Lifetime, 'fileData' is copied since FreeType reads it for the lifetime of the face */
+    INX_GlyphCache() = default;
+    ~INX_GlyphCache();
+
+    INX_GlyphCache(const INX_GlyphCache&) = delete;
+    INX_GlyphCache& operator=(const INX_GlyphCache&) = delete;
+
+    bool Init(const void* fileData, size_t dataSize, NX_FontType type, int baseSize,
+              int padding, const int* codepoints, int codepointCount);
+
+    /** Returns the glyph of 'codepoint', rasterizing it on first use, or the fallback glyph */
+    const INX_Glyph& GetGlyph(int codepoint);
+
+    /** Getters */
+    const NX_Image& GetAtlas() const;
+    uint32_t GetAtlasGeneration() const;
+    const INX_Glyph* GetGlyphs() const;
+    int GetGlyphCount() const;
+    bool HasNewGlyphs() const;
+
+    /** Calls 'func(const INX_Glyph&)' for each glyph packed since the last call, then forgets them */
+    template <typename F>
+    void ConsumeNewGlyphs(F&& func);
+
+private:
+    struct Slot {
+        int32_t codepoint;
+        int32_t index;
+    };
+
+private:
+    int ResolveGlyph(int codepoint);
+    int RasterizeGlyph(int codepoint);
+    bool PackGlyph(int index);
+    bool PackAllGlyphs(int w, int h);
+    void CopyToAtlas(const INX_Glyph& glyph);
+
+    int FindSlot(int codepoint) const;
+    void InsertSlot(int codepoint, int index);
+
+private:
+    static constexpr int DirectCount = 256;
+
+    /* --- Glyph table --- */
+
+    util::DynamicArray<INX_Glyph> mGlyphs{};
+    int32_t mDirect[DirectCount]{};     //< Glyph index of codepoints below 256, -1 when not resolved yet
+    util::DynamicArray<Slot> mSlots{};  //< Power of two sized hash table for the other codepoints
+    int mSlotCount{};
+    int mFallback{};
+
+    /* --- Atlas --- */
+
+    NX_Image mAtlas{};
+    stbrp_context mPacker{};
+    util::DynamicArray<stbrp_node> mPackNodes{};
+    util::DynamicArray<int> mNewGlyphs{};
+    uint32_t mAtlasGeneration{};
+    int mPadding{};
+
+    /* --- FreeType --- */
+
+    util::DynamicArray<uint8_t> mFileData{};
+    FT_Library mLibrary{};
+    FT_Face mFace{};
+    int32_t mLoadFlags{};
+    int mRenderMode{};
+    NX_FontType mType{};
+    int mBaseSize{};
+    int mAscent{};
+};
+
+// ============================================================================
+// INLINE IMPLEMENTATION
+// ============================================================================
+
+inline const INX_Glyph& INX_GlyphCache::GetGlyph(int codepoint)
+{
+    int index = (codepoint >= 0 && codepoint < DirectCount) ? mDirect[codepoint] : FindSlot(codepoint);
+    if (index < 0) index = ResolveGlyph(codepoint);
+    return mGlyphs[index];
+}
+
+inline int INX_GlyphCache::FindSlot(int codepoint) const
+{
+    if (mSlots.IsEmpty()) {
+        return -1;
+    }
+
+    const uint32_t mask = static_cast<uint32_t>(mSlots.GetSize()) - 1;
+    uint32_t slot = (static_cast<uint32_t>(codepoint) * 2654435761u) & mask;
+
+    while (mSlots[slot].codepoint != codepoint) {
+        if (mSlots[slot].codepoint < 0) return -1;
+        slot = (slot + 1) & mask;
+    }
+
+    return mSlots[slot].index;
+}
+
+inline const NX_Image& INX_GlyphCache::GetAtlas() const
+{
+    return mAtlas;
+}
+
+inline uint32_t INX_GlyphCache::GetAtlasGeneration() const
+{
+    return mAtlasGeneration;
+}
+
+inline const INX_Glyph* INX_GlyphCache::GetGlyphs() const
+{
+    return mGlyphs.GetData();
+}
+
+inline int INX_GlyphCache::GetGlyphCount() const
+{
+    return static_cast<int>(mGlyphs.GetSize());
+}
+
+inline bool INX_GlyphCache::HasNewGlyphs() const
+{
+    return !mNewGlyphs.IsEmpty();
+}
+
+template <typename F>
+inline void INX_GlyphCache::ConsumeNewGlyphs(F&& func)
+{
+    for (size_t i = 0; i < mNewGlyphs.GetSize(); i++) {
+        func(static_cast<const INX_Glyph&>(mGlyphs[mNewGlyphs[i]]));
+    }
+    mNewGlyphs.Clear();
+}
+
+#endif // INX_GLYPH_CACHE_HPP
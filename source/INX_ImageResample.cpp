@@ -0,0 +1,521 @@
+/* INX_ImageResample.cpp -- Internal separable image resampling in linear space
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#include "./INX_ImageResample.hpp"
+#include "./INX_PixelConvert.hpp"
+#include "./INX_JobSystem.hpp"
+
+#include <NX/NX_Platform.h>
+#include <NX/NX_Math.h>
+#include <NX/NX_Log.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <array>
+
+// ============================================================================
+// CONSTANTS
+// ============================================================================
+
+/** Approximate number of pixels processed by each job chunk */
+static constexpr size_t INX_RESAMPLE_GRAIN = 32 * 1024;
+
+/** Shape of the Kaiser window, 4 gives a good balance between sharpness and ringing */
+static constexpr float INX_KAISER_ALPHA = 4.0f;
+
+// ============================================================================
+// INTERNAL HELPERS
+// ============================================================================
+
+static NX_PixelFormat INX_GetFloatFormat(int channels)
+{
+    return static_cast<NX_PixelFormat>(NX_PIXEL_FORMAT_R32F + channels - 1);
+}
+
+static size_t INX_GetGrainRows(int width)
+{
+    return std::max<size_t>(1, INX_RESAMPLE_GRAIN / std::max(width, 1));
+}
+
+/** Calls 'func(firstRow, endRow, chunkIndex)' over all rows, split across the job system */
+template <typename F>
+static void INX_ForEachRowRange(int width, int rows, F&& func)
+{
+    const size_t grainRows = INX_GetGrainRows(width);
+
+    INX_Jobs.ParallelFor(rows, grainRows, [&](size_t begin, size_t end) {
+        func(static_cast<int>(begin), static_cast<int>(end), begin / grainRows);
+    });
+}
+
+/* === Color Space === */
+
+static inline float INX_SRGBToLinear(float c)
+{
+    return (c <= 0.04045f) ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+}
+
+static inline float INX_LinearToSRGB(float l)
+{
+    return (l <= 0.0031308f) ? l * 12.92f : 1.055f * powf(l, 1.0f / 2.4f) - 0.055f;
+}
+
+static const float* INX_GetUnormDecodeTable(bool srgb)
+{
+    static const auto tables = []() {
+        std::array<std::array<float, 256>, 2> result{};
+        for (int i = 0; i < 256; i++) {
+            result[0][i] = i / 255.0f;
+            result[1][i] = INX_SRGBToLinear(i / 255.0f);
+        }
+        return result;
+    }();
+    return tables[srgb].data();
+}
+
+static const uint8_t* INX_GetSRGBEncodeTable()
+{
+    // Indexed by the linear value quantized to 16 bits, finer than the 8-bit sRGB steps near black
+    static uint8_t table[65536];
+    static const bool initialized = []() {
+        for (int i = 0; i < 65536; i++) {
+            table[i] = static_cast<uint8_t>(INX_LinearToSRGB(i / 65535.0f) * 255.0f + 0.5f);
+        }
+        return true;
+    }();
+    (void)initialized;
+    return table;
+}
+
+static inline uint8_t INX_EncodeUnorm(float v, const uint8_t* srgbTable)
+{
+    v = NX_Saturate(v);
+    return srgbTable ? srgbTable[static_cast<int>(v * 65535.0f + 0.5f)] : static_cast<uint8_t>(v * 255.0f + 0.5f);
+}
+
+/** Decodes 'count' 8-bit pixels through the tables, alpha is premultiplied with four channels */
+template <int C>
+static void INX_DecodeUnormPixels(const uint8_t* NX_RESTRICT src, float* NX_RESTRICT dst, size_t count, const float* colorTable)
+{
+    const float* alphaTable = INX_GetUnormDecodeTable(false);
+
+    for (size_t i = 0; i < count; i++, src += C, dst += C) {
+        if constexpr (C == 4) {
+            const float alpha = alphaTable[src[3]];
+            dst[0] = colorTable[src[0]] * alpha;
+            dst[1] = colorTable[src[1]] * alpha;
+            dst[2] = colorTable[src[2]] * alpha;
+            dst[3] = alpha;
+        }
+        else {
+            for (int c = 0; c < C; c++) {
+                dst[c] = colorTable[src[c]];
+            }
+        }
+    }
+}
+
+/* === Filters === */
+
+struct INX_ResampleFilter {
+    float radius;
+    float (*weight)(float x);
+};
+
+static inline float INX_Sinc(float x)
+{
+    if (std::abs(x) < 1e-6f) return 1.0f;
+    x *= NX_PI;
+    return sinf(x) / x;
+}
+
+static float INX_BesselI0(float x)
+{
+    // Power series of the zeroth order modified Bessel function of the first kind
+    float sum = 1.0f, term = 1.0f;
+    const float halfSq = 0.25f * x * x;
+    for (int k = 1; k < 32 && term > 1e-8f * sum; k++) {
+        term *= halfSq / static_cast<float>(k * k);
+        sum += term;
+    }
+    return sum;
+}
+
+static INX_ResampleFilter INX_GetResampleFilter(NX_ImageFilter filter)
+{
+    switch (filter) {
+    case NX_IMAGE_FILTER_BILINEAR:
+        return { 1.0f, [](float x) { return std::max(1.0f - std::abs(x), 0.0f); } };
+    case NX_IMAGE_FILTER_LANCZOS:
+        return { 3.0f, [](float x) { return (std::abs(x) < 3.0f) ? INX_Sinc(x) * INX_Sinc(x / 3.0f) : 0.0f; } };
+    case NX_IMAGE_FILTER_KAISER:
+        return { 3.0f, [](float x) {
+            if (std::abs(x) >= 3.0f) return 0.0f;
+            static const float invI0Alpha = 1.0f / INX_BesselI0(INX_KAISER_ALPHA);
+            const float t = x / 3.0f;
+            return INX_Sinc(x) * INX_BesselI0(INX_KAISER_ALPHA * sqrtf(1.0f - t * t)) * invI0Alpha;
+        } };
+    case NX_IMAGE_FILTER_BOX:
+    default:
+        break;
+    }
+    return { 0.5f, [](float x) { return (x >= -0.5f && x < 0.5f) ? 1.0f : 0.0f; } };
+}
+
+/* === Weights === */
+
+/**
+ * Contributions of the source pixels to each destination pixel along one axis.
+ * Taps falling outside of the source are dropped and the rest renormalized.
+ */
+struct INX_ResampleWeights {
+    util::DynamicArray<int> first{};
+    util::DynamicArray<int> count{};
+    util::DynamicArray<float> weights{};    //< 'taps' entries per destination pixel
+    int taps{};
+};
+
+static bool INX_ComputeResampleWeights(int srcSize, int dstSize, const INX_ResampleFilter& filter, INX_ResampleWeights* out)
+{
+    const float scale = static_cast<float>(srcSize) / dstSize;
+    const float filterScale = std::max(scale, 1.0f);
+    const float support = filter.radius * filterScale;
+
+    out->taps = static_cast<int>(std::ceil(2.0f * support)) + 3;
+
+    if (!out->first.Resize(dstSize) || !out->count.Resize(dstSize) || !out->weights.Resize(static_cast<size_t>(dstSize) * out->taps)) {
+        return false;
+    }
+
+    for (int i = 0; i < dstSize; i++)
+    {
+        const float center = (i + 0.5f) * scale;
+        const int lo = std::max(static_cast<int>(std::floor(center - support)), 0);
+        const int hi = std::min(static_cast<int>(std::ceil(center + support)), srcSize - 1);
+
+        float* weights = out->weights.GetData() + static_cast<size_t>(i) * out->taps;
+        int first = -1, last = -1;
+        float sum = 0.0f;
+
+        for (int j = lo; j <= hi; j++) {
+            float w = filter.weight((j + 0.5f - center) / filterScale);
+            if (w != 0.0f) {
+                if (first < 0) first = j;
+                last = j;
+            }
+            weights[j - lo] = w;
+            sum += w;
+        }
+
+        if (first < 0 || sum == 0.0f) {
+            out->first[i] = std::clamp(static_cast<int>(center), 0, srcSize - 1);
+            out->count[i] = 1;
+            weights[0] = 1.0f;
+            continue;
+        }
+
+        // Only keep the span of non-zero weights, moved to the start of the slot
+        const int count = last - first + 1;
+        for (int t = 0; t < count; t++) {
+            weights[t] = weights[first - lo + t] / sum;
+        }
+
+        out->first[i] = first;
+        out->count[i] = count;
+    }
+
+    return true;
+}
+
+/* === Passes === */
+
+template <int C>
+static void INX_ResampleRow(const float* NX_RESTRICT src, float* NX_RESTRICT dst, const INX_ResampleWeights& weights, int dstWidth)
+{
+    const int* first = weights.first.GetData();
+    const int* count = weights.count.GetData();
+
+    for (int i = 0; i < dstWidth; i++)
+    {
+        const float* w = weights.weights.GetData() + static_cast<size_t>(i) * weights.taps;
+        const float* p = src + static_cast<size_t>(first[i]) * C;
+        const int n = count[i];
+
+        if constexpr (C == 4) {
+#if defined(NX_HAS_SSE)
+            __m128 acc = _mm_setzero_ps();
+            for (int t = 0; t < n; t++) {
+                acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(w[t]), _mm_loadu_ps(p + t * 4)));
+            }
+            _mm_storeu_ps(dst + i * 4, acc);
+            continue;
+#elif defined(NX_HAS_NEON) || defined(NX_HAS_NEON_FMA)
+            float32x4_t acc = vdupq_n_f32(0.0f);
+            for (int t = 0; t < n; t++) {
+                acc = vmlaq_n_f32(acc, vld1q_f32(p + t * 4), w[t]);
+            }
+            vst1q_f32(dst + i * 4, acc);
+            continue;
+#endif
+        }
+
+        float acc[C] = {};
+        for (int t = 0; t < n; t++) {
+            for (int c = 0; c < C; c++) {
+                acc[c] += w[t] * p[t * C + c];
+            }
+        }
+        for (int c = 0; c < C; c++) {
+            dst[i * C + c] = acc[c];
+        }
+    }
+}
+
+static void INX_AccumulateRow(float* NX_RESTRICT dst, const float* NX_RESTRICT src, float weight, size_t count)
+{
+    size_t i = 0;
+
+#if defined(NX_HAS_AVX)
+    const __m256 w = _mm256_set1_ps(weight);
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_mul_ps(w, _mm256_loadu_ps(src + i))));
+    }
+#elif defined(NX_HAS_SSE)
+    const __m128 w = _mm_set1_ps(weight);
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(w, _mm_loadu_ps(src + i))));
+    }
+#elif defined(NX_HAS_NEON) || defined(NX_HAS_NEON_FMA)
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(dst + i, vmlaq_n_f32(vld1q_f32(dst + i), vld1q_f32(src + i), weight));
+    }
+#endif
+
+    for (; i < count; i++) {
+        dst[i] += weight * src[i];
+    }
+}
+
+// ============================================================================
+// INTERNAL API
+// ============================================================================
+
+bool INX_DecodeLinearImage(const NX_Image& image, bool srgb, INX_LinearImage* out)
+{
+    const int channels = NX_GetPixelChannels(image.format);
+    if (image.pixels == nullptr || channels == 0 || image.w <= 0 || image.h <= 0) {
+        return false;
+    }
+
+    const size_t valueCount = static_cast<size_t>(image.w) * image.h * channels;
+    if (!out->pixels.Resize(valueCount)) {
+        NX_LOG(E, "IMAGE: Failed to allocate %zu bytes for image resampling", valueCount * sizeof(float));
+        return false;
+    }
+
+    out->w = image.w;
+    out->h = image.h;
+    out->channels = channels;
+
+    const size_t rowSize = static_cast<size_t>(image.w) * channels;
+    const int colorChannels = std::min(channels, 3);
+    float* pixels = out->pixels.GetData();
+
+    /* --- 8-bit channels are decoded through tables, with alpha premultiplied on the fly --- */
+
+    if (NX_GetPixelChannelBytes(image.format) == 1)
+    {
+        void (*decode)(const uint8_t*, float*, size_t, const float*) = nullptr;
+
+        switch (channels) {
+        case 1: decode = INX_DecodeUnormPixels<1>; break;
+        case 2: decode = INX_DecodeUnormPixels<2>; break;
+        case 3: decode = INX_DecodeUnormPixels<3>; break;
+        case 4: decode = INX_DecodeUnormPixels<4>; break;
+        default: return false;
+        }
+
+        const float* colorTable = INX_GetUnormDecodeTable(srgb);
+        const uint8_t* src = static_cast<const uint8_t*>(image.pixels);
+
+        INX_ForEachRowRange(image.w, image.h, [&](int begin, int end, size_t) {
+            decode(src + begin * rowSize, pixels + begin * rowSize, static_cast<size_t>(end - begin) * image.w, colorTable);
+        });
+
+        return true;
+    }
+
+    /* --- Other formats are converted to floats first --- */
+
+    INX_ConvertPixels(image.pixels, image.format, pixels, INX_GetFloatFormat(channels), image.w, image.h);
+
+    if (!srgb && channels < 4) {
+        return true;
+    }
+
+    INX_ForEachRowRange(image.w, image.h, [&](int begin, int end, size_t) {
+        for (size_t i = begin * rowSize; i < end * rowSize; i += channels) {
+            const float alpha = (channels == 4) ? pixels[i + 3] : 1.0f;
+            for (int c = 0; c < colorChannels; c++) {
+                pixels[i + c] = (srgb ? INX_SRGBToLinear(pixels[i + c]) : pixels[i + c]) * alpha;
+            }
+        }
+    });
+
+    return true;
+}
+
+NX_Image INX_EncodeLinearImage(const INX_LinearImage& image, NX_PixelFormat format, bool srgb)
+{
+    const int channels = image.channels;
+
+    if (NX_GetPixelChannels(format) != channels || image.pixels.IsEmpty()) {
+        return NX_Image{};
+    }
+
+    NX_Image result = NX_CreateImage(image.w, image.h, format);
+    if (result.pixels == nullptr) {
+        NX_LOG(E, "IMAGE: Failed to allocate resampled image (%ix%i)", image.w, image.h);
+        return result;
+    }
+
+    const size_t rowSize = static_cast<size_t>(image.w) * channels;
+    const float* src = image.pixels.GetData();
+
+    /* --- 8-bit channels are rounded to nearest, through a table for sRGB --- */
+
+    if (NX_GetPixelChannelBytes(format) == 1) {
+        const uint8_t* srgbTable = srgb ? INX_GetSRGBEncodeTable() : nullptr;
+        uint8_t* dst = static_cast<uint8_t*>(result.pixels);
+        INX_ForEachRowRange(image.w, image.h, [&](int begin, int end, size_t) {
+            for (size_t i = begin * rowSize; i < end * rowSize; i += channels) {
+                const float alpha = (channels == 4) ? src[i + 3] : 1.0f;
+                const float invAlpha = (alpha > 0.0f) ? 1.0f / alpha : 0.0f;
+                for (int c = 0; c < channels; c++) {
+                    dst[i + c] = (c < 3) ? INX_EncodeUnorm(src[i + c] * invAlpha, srgbTable) : INX_EncodeUnorm(src[i + c], nullptr);
+                }
+            }
+        });
+        return result;
+    }
+
+    /* --- Other formats are written through a float row and the conversion kernels --- */
+
+    const size_t grainRows = INX_GetGrainRows(image.w);
+    const size_t chunkCount = INX_Jobs.GetChunkCount(image.h, grainRows);
+
+    util::DynamicArray<float> rows{};
+    if (!rows.Resize(chunkCount * rowSize)) {
+        NX_LOG(E, "IMAGE: Failed to allocate %zu bytes for image resampling", chunkCount * rowSize * sizeof(float));
+        NX_DestroyImage(&result);
+        return result;
+    }
+
+    INX_PixelRowKernel kernel = INX_GetPixelRowKernel(INX_GetFloatFormat(channels), format);
+    const size_t dstStride = static_cast<size_t>(image.w) * NX_GetPixelBytes(format);
+    const int colorChannels = std::min(channels, 3);
+
+    INX_ForEachRowRange(image.w, image.h, [&](int begin, int end, size_t chunk) {
+        float* row = rows.GetData() + chunk * rowSize;
+        for (int y = begin; y < end; y++) {
+            const float* line = src + y * rowSize;
+            for (size_t i = 0; i < rowSize; i += channels) {
+                const float alpha = (channels == 4) ? line[i + 3] : 1.0f;
+                const float invAlpha = (alpha > 0.0f) ? 1.0f / alpha : 0.0f;
+                for (int c = 0; c < channels; c++) {
+                    float v = line[i + c];
+                    if (c < colorChannels) {
+                        v = (channels == 4) ? v * invAlpha : v;
+                        v = srgb ? INX_LinearToSRGB(v) : v;
+                    }
+                    row[i + c] = v;
+                }
+            }
+            kernel(row, static_cast<uint8_t*>(result.pixels) + y * dstStride, image.w);
+        }
+    });
+
+    return result;
+}
+
+bool INX_ResampleLinearImage(const INX_LinearImage& image, int w, int h, NX_ImageFilter filter, INX_LinearImage* out)
+{
+    if (image.pixels.IsEmpty() || w <= 0 || h <= 0) {
+        return false;
+    }
+
+    const int channels = image.channels;
+    const INX_ResampleFilter resampleFilter = INX_GetResampleFilter(filter);
+
+    INX_ResampleWeights weightsX{}, weightsY{};
+    util::DynamicArray<float> temp{};
+
+    const size_t srcRowSize = static_cast<size_t>(image.w) * channels;
+    const size_t dstRowSize = static_cast<size_t>(w) * channels;
+
+    bool allocated = INX_ComputeResampleWeights(image.w, w, resampleFilter, &weightsX)
+                  && INX_ComputeResampleWeights(image.h, h, resampleFilter, &weightsY)
+                  && out->pixels.Resize(dstRowSize * h);
+
+    if (allocated && w != image.w) {
+        allocated = temp.Resize(dstRowSize * image.h);
+    }
+
+    if (!allocated) {
+        NX_LOG(E, "IMAGE: Failed to allocate image resampling buffers (%ix%i to %ix%i)", image.w, image.h, w, h);
+        return false;
+    }
+
+    /* --- Horizontal pass, every source row to the destination width --- */
+
+    const float* rows = image.pixels.GetData();
+
+    if (w != image.w)
+    {
+        void (*resampleRow)(const float*, float*, const INX_ResampleWeights&, int) = nullptr;
+
+        switch (channels) {
+        case 1: resampleRow = INX_ResampleRow<1>; break;
+        case 2: resampleRow = INX_ResampleRow<2>; break;
+        case 3: resampleRow = INX_ResampleRow<3>; break;
+        case 4: resampleRow = INX_ResampleRow<4>; break;
+        default: return false;
+        }
+
+        float* dst = temp.GetData();
+        INX_ForEachRowRange(w, image.h, [&](int begin, int end, size_t) {
+            for (int y = begin; y < end; y++) {
+                resampleRow(rows + y * srcRowSize, dst + y * dstRowSize, weightsX, w);
+            }
+        });
+
+        rows = temp.GetData();
+    }
+
+    /* --- Vertical pass, each destination row accumulates its source rows --- */
+
+    float* dst = out->pixels.GetData();
+
+    INX_ForEachRowRange(w, h, [&](int begin, int end, size_t) {
+        for (int y = begin; y < end; y++) {
+            const float* weights = weightsY.weights.GetData() + static_cast<size_t>(y) * weightsY.taps;
+            float* line = dst + y * dstRowSize;
+            std::fill_n(line, dstRowSize, 0.0f);
+            for (int t = 0; t < weightsY.count[y]; t++) {
+                INX_AccumulateRow(line, rows + (weightsY.first[y] + t) * dstRowSize, weights[t], dstRowSize);
+            }
+        }
+    });
+
+    out->w = w;
+    out->h = h;
+    out->channels = channels;
+
+    return true;
+}
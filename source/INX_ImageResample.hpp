@@ -0,0 +1,41 @@
+/* INX_ImageResample.hpp -- Internal separable image resampling in linear space
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef INX_IMAGE_RESAMPLE_HPP
+#define INX_IMAGE_RESAMPLE_HPP
+
+#include "./Detail/Util/DynamicArray.hpp"
+#include <NX/NX_Image.h>
+
+// ============================================================================
+// LINEAR IMAGE
+// ============================================================================
+
+/**
+ * @brief Floating point image on which filters are applied.
+ *
+ * Color channels are always linear, and premultiplied by alpha when the image
+ * has four channels. Decoding once then resampling several times from the
+ * same linear image is how mip chains avoid repeated conversions.
+ */
+struct INX_LinearImage {
+    util::DynamicArray<float> pixels{};
+    int w{}, h{};
+    int channels{};
+};
+
+/** Decodes 'image' to linear floats, 'srgb' telling if its color channels are sRGB encoded */
+bool INX_DecodeLinearImage(const NX_Image& image, bool srgb, INX_LinearImage* out);
+
+/** Encodes 'image' to a new image of the given format, 8-bit channels are rounded to nearest */
+NX_Image INX_EncodeLinearImage(const INX_LinearImage& image, NX_PixelFormat format, bool srgb);
+
+/** Resamples 'image' to 'w' x 'h' with separable passes, rows are split across the job system */
+bool INX_ResampleLinearImage(const INX_LinearImage& image, int w, int h, NX_ImageFilter filter, INX_LinearImage* out);
+
+#endif // INX_IMAGE_RESAMPLE_HPP
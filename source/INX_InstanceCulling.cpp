@@ -0,0 +1,421 @@
+/* INX_InstanceCulling.cpp -- Per-instance GPU frustum and occlusion culling of instanced draws
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#include "./INX_InstanceCulling.hpp"
+#include "./INX_GPUProgramCache.hpp"
+#include "./INX_Utils.hpp"
+
+#include <NX/NX_Log.h>
+
+#include <cstring>
+
+// ============================================================================
+// LOCAL CONSTANTS
+// ============================================================================
+
+/** Must match the local sizes of the compute shaders */
+static constexpr uint32_t INX_InstanceGroupSize = 64;
+static constexpr uint32_t INX_HiZGroupSize = 8;
+
+/** Attributes read by 'instance_culling.comp' */
+static constexpr NX_InstanceData INX_CullAttributes = NX_INSTANCE_POSITION | NX_INSTANCE_ROTATION | NX_INSTANCE_SCALE;
+
+// ============================================================================
+// LOCAL FUNCTIONS
+// ============================================================================
+
+static void INX_ReserveBuffer(gpu::Buffer& buffer, GLenum target, size_t size)
+{
+    if (!buffer.IsValid()) {
+        buffer = gpu::Buffer(target, NX_MAX(size, size_t(64)), nullptr, GL_DYNAMIC_COPY);
+        return;
+    }
+    const size_t current = static_cast<size_t>(buffer.GetSize());
+    if (size > current) {
+        buffer.Realloc(NX_MAX(size, 2 * current), false);
+    }
+}
+
+// ============================================================================
+// CPU REFERENCE
+// ============================================================================
+
+INX_BoundingSphere3D INX_GetDrawSphere(const NX_BoundingBox3D& aabb, const NX_Transform& transform)
+{
+    NX_Vec3 localCenter = (aabb.min + aabb.max) * 0.5f;
+    NX_Vec3 halfSize = (aabb.max - aabb.min) * 0.5f;
+
+    INX_BoundingSphere3D sphere;
+    sphere.center = transform.translation + NX_Vec3Rotate(localCenter * transform.scale, transform.rotation);
+    sphere.radius = NX_Vec3Length(halfSize * transform.scale);
+
+    return sphere;
+}
+
+INX_BoundingSphere3D INX_GetInstanceSphere(
+    const INX_BoundingSphere3D& drawSphere,
+    const NX_Vec3* position, const NX_Quat* rotation, const NX_Vec3* scale)
+{
+    // Same order as 'M_TransformToMat4' in the vertex shader: scale, rotate, translate
+
+    NX_Vec3 center = drawSphere.center;
+    float radius = drawSphere.radius;
+
+    if (scale != nullptr) {
+        center = center * (*scale);
+        radius *= NX_MAX(fabsf(scale->x), NX_MAX(fabsf(scale->y), fabsf(scale->z)));
+    }
+
+    if (rotation != nullptr) {
+        center = NX_Vec3Rotate(center, NX_QuatNormalize(*rotation));
+    }
+
+    if (position != nullptr) {
+        center = center + (*position);
+    }
+
+    INX_BoundingSphere3D sphere;
+    sphere.center = center;
+    sphere.radius = radius;
+
+    return sphere;
+}
+
+size_t INX_CullInstances(
+    const INX_Frustum& frustum, const INX_BoundingSphere3D& drawSphere,
+    const NX_Vec3* positions, const NX_Quat* rotations, const NX_Vec3* scales,
+    size_t count, uint32_t* visibleIndices)
+{
+    INX_SphereBatch spheres{};
+    util::DynamicArray<uint64_t> visible{};
+
+    if (!visible.Resize(INX_GetCullMaskSize(count))) {
+        NX_LOG(E, "RENDER: Failed to allocate instance culling mask (requested: %zu instances)", count);
+        return 0;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        spheres.Push(INX_GetInstanceSphere(
+            drawSphere,
+            positions ? &positions[i] : nullptr,
+            rotations ? &rotations[i] : nullptr,
+            scales ? &scales[i] : nullptr
+        ));
+    }
+
+    frustum.CullSpheres(spheres, visible.GetData());
+
+    size_t visibleCount = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (INX_TestCullMask(visible.GetData(), i)) {
+            visibleIndices[visibleCount++] = static_cast<uint32_t>(i);
+        }
+    }
+
+    return visibleCount;
+}
+
+void INX_GatherInstances(void* dst, const void* src, size_t stride, const uint32_t* indices, size_t count)
+{
+    uint8_t* out = static_cast<uint8_t*>(dst);
+    const uint8_t* in = static_cast<const uint8_t*>(src);
+
+    for (size_t i = 0; i < count; i++) {
+        std::memcpy(out + i * stride, in + indices[i] * stride, stride);
+    }
+}
+
+// ============================================================================
+// HIERARCHICAL DEPTH
+// ============================================================================
+
+void INX_HiZBuffer::Build(const gpu::Pipeline& pipeline, const gpu::Texture& depth)
+{
+    /* --- (Re)create the pyramid if the source size changed --- */
+
+    const NX_IVec2 sourceSize = depth.GetDimensions();
+
+    if (!mTexture.IsValid() || sourceSize != mSourceSize) {
+        mTexture = gpu::Texture(
+            gpu::TextureConfig
+            {
+                .target = GL_TEXTURE_2D,
+                .internalFormat = GL_R32F,
+                .data = nullptr,
+                .width = NX_MAX(sourceSize.x / 2, 1),
+                .height = NX_MAX(sourceSize.y / 2, 1),
+                .mipmap = true,
+                .immutable = true
+            },
+            gpu::TextureParam
+            {
+                // Texel fetches outside of the base level require a mipmap filter
+                .minFilter = GL_NEAREST_MIPMAP_NEAREST,
+                .magFilter = GL_NEAREST
+            }
+        );
+        mSourceSize = sourceSize;
+    }
+
+    /* --- Reduce each level from the previous one --- */
+
+    pipeline.UseProgram(INX_Programs.GetHiZDownsample());
+
+    NX_IVec2 srcSize = sourceSize;
+    const int levelCount = mTexture.GetNumLevels();
+
+    for (int level = 0; level < levelCount; level++)
+    {
+        const NX_IVec2 dstSize = NX_IVEC2(NX_MAX(srcSize.x / 2, 1), NX_MAX(srcSize.y / 2, 1));
+
+        pipeline.BindTexture(0, (level == 0) ? depth : mTexture);
+        pipeline.BindImageTexture(0, mTexture, level, 0, GL_WRITE_ONLY);
+
+        pipeline.SetUniformInt1(0, NX_MAX(level - 1, 0));
+        pipeline.SetUniformInt2(1, srcSize);
+
+        pipeline.DispatchCompute(
+            NX_DIV_CEIL(dstSize.x, INX_HiZGroupSize),
+            NX_DIV_CEIL(dstSize.y, INX_HiZGroupSize),
+            1
+        );
+
+        // The next level reads this one with texel fetches
+        pipeline.MemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+
+        srcSize = dstSize;
+    }
+}
+
+// ============================================================================
+// INSTANCE CULLING
+// ============================================================================
+
+int INX_InstanceCulling::Enqueue(const NX_InstanceBuffer& instances, int instanceCount, const INX_BoundingSphere3D& drawSphere, bool occludable)
+{
+    // Never reads past the end of the source buffers
+    instanceCount = NX_MIN(instanceCount, static_cast<int>(instances.allocatedCount));
+    if (instanceCount <= 0) {
+        return -1;
+    }
+
+    Slot* slot = mSlots.EmplaceBack(Slot {
+        .source = &instances,
+        .sphere = drawSphere,
+        .instanceCount = static_cast<uint32_t>(instanceCount),
+        .indexOffset = mIndexCount,
+        .firstCommand = static_cast<uint32_t>(mCommands.GetSize()),
+        .commandCount = 0,
+        .occludable = occludable
+    });
+
+    if (slot == nullptr) {
+        NX_LOG(E, "RENDER: Failed to allocate instance culling slot (requested: %zu slots)", mSlots.GetSize() + 1);
+        return -1;
+    }
+
+    mIndexCount += instanceCount;
+    mOccludableCount += occludable;
+
+    return static_cast<int>(mSlots.GetSize()) - 1;
+}
+
+void INX_InstanceCulling::PushCommand(uint32_t elementCount)
+{
+    SDL_assert(!mSlots.IsEmpty());
+
+    if (!mCommands.PushBack(Command { .count = elementCount })) {
+        NX_LOG(E, "RENDER: Failed to allocate indirect draw command (requested: %zu commands)", mCommands.GetSize() + 1);
+        return;
+    }
+
+    mSlots.GetBack()->commandCount++;
+}
+
+void INX_InstanceCulling::Dispatch(const gpu::Pipeline& pipeline, const INX_Frustum& frustum)
+{
+    if (mSlots.IsEmpty()) {
+        return;
+    }
+
+    PrepareOutputs();
+
+    /* --- Reset the instance count of all the commands --- */
+
+    const size_t commandBytes = mCommands.GetSize() * sizeof(Command);
+    INX_ReserveBuffer(mCommandBuffer, GL_SHADER_STORAGE_BUFFER, commandBytes);
+    mCommandBuffer.Upload(0, commandBytes, mCommands.GetData());
+
+    Cull(pipeline, frustum, nullptr, nullptr);
+}
+
+void INX_InstanceCulling::Dispatch(const gpu::Pipeline& pipeline, const INX_Frustum& frustum, const INX_HiZBuffer& hiZ, const NX_Mat4& viewProj)
+{
+    if (mOccludableCount == 0 || !hiZ.IsValid()) {
+        return;
+    }
+
+    /* --- Reset the instance count of the occludable slots only --- */
+
+    for (size_t i = 0; i < mSlots.GetSize(); i++) {
+        const Slot& slot = mSlots[i];
+        if (slot.occludable && slot.commandCount > 0) {
+            mCommandBuffer.Upload(
+                slot.firstCommand * sizeof(Command), slot.commandCount * sizeof(Command),
+                &mCommands[slot.firstCommand]
+            );
+        }
+    }
+
+    Cull(pipeline, frustum, &hiZ, &viewProj);
+}
+
+void INX_InstanceCulling::Clear()
+{
+    mSlots.Clear();
+    mCommands.Clear();
+    mIndexCount = 0;
+    mOccludableCount = 0;
+}
+
+bool INX_InstanceCulling::ReadCommands(const gpu::Pipeline& pipeline, int slot, Command* commands)
+{
+    if (!IsCulled(slot)) {
+        return false;
+    }
+
+    const Slot& info = mSlots[slot];
+
+    // Counts were written by shader storage writes
+    pipeline.MemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+
+    const Command* mapped = mCommandBuffer.MapRange<Command>(
+        info.firstCommand * sizeof(Command), info.commandCount * sizeof(Command), GL_MAP_READ_BIT
+    );
+
+    if (mapped == nullptr) {
+        return false;
+    }
+
+    std::memcpy(commands, mapped, info.commandCount * sizeof(Command));
+
+    return mCommandBuffer.Unmap();
+}
+
+void INX_InstanceCulling::Cull(const gpu::Pipeline& pipeline, const INX_Frustum& frustum, const INX_HiZBuffer* hiZ, const NX_Mat4* viewProj)
+{
+    const bool occlusion = (hiZ != nullptr);
+
+    /* --- Test the instances and append the visible indices --- */
+
+    pipeline.UseProgram(INX_Programs.GetInstanceCulling());
+
+    const NX_Vec4* planes = frustum.GetPlanes();
+    for (int i = 0; i < INX_Frustum::PLANE_COUNT; i++) {
+        pipeline.SetUniformFloat4(i, planes[i]);
+    }
+
+    pipeline.SetUniformInt1(11, occlusion);
+
+    if (occlusion) {
+        pipeline.BindTexture(0, hiZ->GetTexture());
+        pipeline.SetUniformMat4(12, *viewProj);
+        pipeline.SetUniformInt2(13, hiZ->GetSourceSize());
+        pipeline.SetUniformInt1(14, hiZ->GetTexture().GetNumLevels());
+    }
+
+    pipeline.BindStorage(3, mIndexBuffer);
+    pipeline.BindStorage(4, mCommandBuffer);
+
+    for (size_t i = 0; i < mSlots.GetSize(); i++)
+    {
+        const Slot& slot = mSlots[i];
+        if (!IsCulled(static_cast<int>(i)) || (occlusion && !slot.occludable)) {
+            continue;
+        }
+
+        const NX_InstanceData attributes = slot.source->bufferFlags & INX_CullAttributes;
+        INX_ForEachBit(attributes, [&](int index) {
+            pipeline.BindStorage(index, slot.source->buffers[index]);
+        });
+
+        pipeline.SetUniformFloat4(6, NX_VEC4(slot.sphere.center.x, slot.sphere.center.y, slot.sphere.center.z, slot.sphere.radius));
+        pipeline.SetUniformUint1(7, slot.instanceCount);
+        pipeline.SetUniformUint1(8, slot.indexOffset);
+        pipeline.SetUniformUint1(9, GetCounterWord(slot));
+        pipeline.SetUniformUint1(10, attributes);
+
+        pipeline.DispatchCompute(NX_DIV_CEIL(slot.instanceCount, INX_InstanceGroupSize), 1, 1);
+    }
+
+    pipeline.MemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    /* --- Gather the attributes of the visible instances --- */
+
+    pipeline.UseProgram(INX_Programs.GetInstanceGather());
+
+    pipeline.BindStorage(2, mIndexBuffer);
+    pipeline.BindStorage(3, mCommandBuffer);
+
+    for (size_t i = 0; i < mSlots.GetSize(); i++)
+    {
+        const Slot& slot = mSlots[i];
+        if (!IsCulled(static_cast<int>(i)) || (occlusion && !slot.occludable)) {
+            continue;
+        }
+
+        pipeline.SetUniformUint1(1, slot.instanceCount);
+        pipeline.SetUniformUint1(2, slot.indexOffset);
+        pipeline.SetUniformUint1(3, GetCounterWord(slot));
+
+        // The first dispatch also copies the visible count to the other commands of the slot
+        bool first = true;
+
+        INX_ForEachBit(slot.source->bufferFlags, [&](int index) {
+            pipeline.BindStorage(0, slot.source->buffers[index]);
+            pipeline.BindStorage(1, mOutputs[i].buffers[index]);
+            pipeline.SetUniformUint1(0, NX_InstanceBuffer::TypeSizes[index] / sizeof(float));
+            pipeline.SetUniformUint1(4, first ? slot.commandCount : 0);
+            uint32_t threadCount = first ? NX_MAX(slot.instanceCount, slot.commandCount) : slot.instanceCount;
+            pipeline.DispatchCompute(NX_DIV_CEIL(threadCount, INX_InstanceGroupSize), 1, 1);
+            first = false;
+        });
+    }
+
+    // Compacted attributes are read as vertex attributes and counts by indirect draws
+    pipeline.MemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+}
+
+void INX_InstanceCulling::PrepareOutputs()
+{
+    /* --- Visible indices of all the slots --- */
+
+    INX_ReserveBuffer(mIndexBuffer, GL_SHADER_STORAGE_BUFFER, mIndexCount * sizeof(uint32_t));
+
+    /* --- One compacted instance buffer per slot, with the layout of its source --- */
+
+    // Slots without output are drawn without culling, see 'IsCulled'
+    if (mOutputs.GetSize() < mSlots.GetSize() && !mOutputs.Resize(mSlots.GetSize())) {
+        NX_LOG(E, "RENDER: Failed to allocate compacted instance buffers (requested: %zu buffers)", mSlots.GetSize());
+    }
+
+    for (size_t i = 0; i < NX_MIN(mOutputs.GetSize(), mSlots.GetSize()); i++)
+    {
+        const Slot& slot = mSlots[i];
+        NX_InstanceBuffer& output = mOutputs[i];
+
+        // Buffers of types missing from the source are kept but ignored by 'GetBuffer'
+        output.bufferFlags = slot.source->bufferFlags;
+        output.allocatedCount = NX_MAX(output.allocatedCount, slot.instanceCount);
+
+        INX_ForEachBit(output.bufferFlags, [&](int index) {
+            size_t size = slot.instanceCount * NX_InstanceBuffer::TypeSizes[index];
+            INX_ReserveBuffer(output.buffers[index], GL_ARRAY_BUFFER, size);
+        });
+    }
+}
@@ -0,0 +1,222 @@
+/* INX_InstanceCulling.hpp -- Per-instance GPU frustum and occlusion culling of instanced draws
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef INX_INSTANCE_CULLING_HPP
+#define INX_INSTANCE_CULLING_HPP
+
+#include <NX/NX_Shape.h>
+#include <NX/NX_Math.h>
+
+#include "./Detail/Util/DynamicArray.hpp"
+#include "./Detail/GPU/Pipeline.hpp"
+#include "./Detail/GPU/Texture.hpp"
+#include "./Detail/GPU/Buffer.hpp"
+
+#include "./NX_InstanceBuffer.hpp"
+#include "./INX_Frustum.hpp"
+#include "./NX_Shape.hpp"
+
+#include <cstddef>
+
+// ============================================================================
+// CPU REFERENCE
+// ============================================================================
+
+/** Bounds of a draw call with its own transform, instances are applied on top of it */
+INX_BoundingSphere3D INX_GetDrawSphere(const NX_BoundingBox3D& aabb, const NX_Transform& transform);
+
+/** Bounds of one instance, missing attributes use the default value of the vertex attribute */
+INX_BoundingSphere3D INX_GetInstanceSphere(
+    const INX_BoundingSphere3D& drawSphere,
+    const NX_Vec3* position, const NX_Quat* rotation, const NX_Vec3* scale
+);
+
+/**
+ * Reference of the compaction done by 'instance_culling.comp', used to validate it without a GPU.
+ * Any of the attribute arrays can be null. Writes the indices of the instances that are not
+ * outside the frustum in increasing order and returns their count. The GPU version produces
+ * the same set in an unspecified order.
+ */
+size_t INX_CullInstances(
+    const INX_Frustum& frustum, const INX_BoundingSphere3D& drawSphere,
+    const NX_Vec3* positions, const NX_Quat* rotations, const NX_Vec3* scales,
+    size_t count, uint32_t* visibleIndices
+);
+
+/** Reference of 'instance_gather.comp', copies the selected elements of 'stride' bytes */
+void INX_GatherInstances(void* dst, const void* src, size_t stride, const uint32_t* indices, size_t count);
+
+// ============================================================================
+// HIERARCHICAL DEPTH
+// ============================================================================
+
+/**
+ * @brief Max-reduced depth pyramid used for occlusion tests.
+ *
+ * Level 0 is half the resolution of the source depth, each texel stores
+ * the farthest depth of the source texels it covers, including the extra
+ * row or column of odd sizes, so that tests against it are conservative.
+ */
+class INX_HiZBuffer {
+public:
+    /** Builds the pyramid from a single-sampled depth texture */
+    void Build(const gpu::Pipeline& pipeline, const gpu::Texture& depth);
+
+    /** Getters */
+    const gpu::Texture& GetTexture() const;
+    NX_IVec2 GetSourceSize() const;
+    bool IsValid() const;
+
+private:
+    gpu::Texture mTexture{};
+    NX_IVec2 mSourceSize{};
+};
+
+// ============================================================================
+// INSTANCE CULLING
+// ============================================================================
+
+/**
+ * @brief Culls the instances of instanced draws on the GPU.
+ *
+ * Each instanced draw call of a pass gets a slot. At dispatch, one compute pass
+ * tests the bounding sphere of every instance and appends the visible indices
+ * while incrementing the instance count of the slot's indirect command, then
+ * a second pass gathers the attributes of the visible instances into an
+ * instance buffer owned by the slot. Draws then use the compacted buffer with
+ * an indirect command, the visible count never goes back to the CPU.
+ *
+ * A slot owns one command per mesh drawn with the same instances (models),
+ * they only differ by their element count.
+ */
+class INX_InstanceCulling {
+public:
+    /** Indirect command, non-indexed draws read the first four words with 'baseVertex' as 'baseInstance' */
+    struct Command {
+        uint32_t count;
+        uint32_t instanceCount;
+        uint32_t first;
+        int32_t baseVertex;
+        uint32_t baseInstance;
+    };
+
+public:
+    /** Registers the instances of a draw call, returns the slot or -1 on failure */
+    int Enqueue(const NX_InstanceBuffer& instances, int instanceCount, const INX_BoundingSphere3D& drawSphere, bool occludable);
+
+    /** Adds a command to the last enqueued slot, with the number of indices or vertices to draw */
+    void PushCommand(uint32_t elementCount);
+
+    /**
+     * Culls all the slots against the frustum. With a hierarchical depth buffer, only the occludable
+     * slots are culled again against both the frustum and the depth, 'viewProj' must then be the one
+     * used to render the depth.
+     */
+    void Dispatch(const gpu::Pipeline& pipeline, const INX_Frustum& frustum);
+    void Dispatch(const gpu::Pipeline& pipeline, const INX_Frustum& frustum, const INX_HiZBuffer& hiZ, const NX_Mat4& viewProj);
+
+    /** Clears the slots, GPU buffers are kept for the next passes */
+    void Clear();
+
+    /** Reads back the commands of a slot once culled, waits for the GPU, only meant for validation */
+    bool ReadCommands(const gpu::Pipeline& pipeline, int slot, Command* commands);
+
+    /** Getters */
+    bool IsCulled(int slot) const;          //< False if the slot is invalid or its resources could not be allocated
+    const NX_InstanceBuffer& GetInstances(int slot) const;
+    size_t GetCommandOffset(int slot, int command) const;
+    const gpu::Buffer& GetCommandBuffer() const;
+    bool HasOccludableSlots() const;
+    bool IsEmpty() const;
+
+private:
+    struct Slot {
+        const NX_InstanceBuffer* source;
+        INX_BoundingSphere3D sphere;
+        uint32_t instanceCount;
+        uint32_t indexOffset;               //< Offset of the slot in the visible indices buffer
+        uint32_t firstCommand;
+        uint32_t commandCount;
+        bool occludable;
+    };
+
+private:
+    /** Word of the instance count of the slot's first command, used as counter by the shaders */
+    static uint32_t GetCounterWord(const Slot& slot);
+
+    void Cull(const gpu::Pipeline& pipeline, const INX_Frustum& frustum, const INX_HiZBuffer* hiZ, const NX_Mat4* viewProj);
+    void PrepareOutputs();
+
+private:
+    util::DynamicArray<Slot> mSlots{};
+    util::DynamicArray<Command> mCommands{};
+    util::DynamicArray<NX_InstanceBuffer> mOutputs{};   //< Compacted instances per slot, kept between passes
+    gpu::Buffer mCommandBuffer{};
+    gpu::Buffer mIndexBuffer{};
+    uint32_t mIndexCount{};
+    int mOccludableCount{};
+};
+
+// ============================================================================
+// INLINE IMPLEMENTATION
+// ============================================================================
+
+inline const gpu::Texture& INX_HiZBuffer::GetTexture() const
+{
+    return mTexture;
+}
+
+inline NX_IVec2 INX_HiZBuffer::GetSourceSize() const
+{
+    return mSourceSize;
+}
+
+inline bool INX_HiZBuffer::IsValid() const
+{
+    return mTexture.IsValid();
+}
+
+inline bool INX_InstanceCulling::IsCulled(int slot) const
+{
+    return slot >= 0 && slot < static_cast<int>(mOutputs.GetSize()) && mSlots[slot].commandCount > 0;
+}
+
+inline const NX_InstanceBuffer& INX_InstanceCulling::GetInstances(int slot) const
+{
+    return mOutputs[slot];
+}
+
+inline size_t INX_InstanceCulling::GetCommandOffset(int slot, int command) const
+{
+    return (mSlots[slot].firstCommand + command) * sizeof(Command);
+}
+
+inline uint32_t INX_InstanceCulling::GetCounterWord(const Slot& slot)
+{
+    static_assert(sizeof(Command) % sizeof(uint32_t) == 0);
+    constexpr uint32_t commandWords = sizeof(Command) / sizeof(uint32_t);
+    constexpr uint32_t counterWord = offsetof(Command, instanceCount) / sizeof(uint32_t);
+    return slot.firstCommand * commandWords + counterWord;
+}
+
+inline const gpu::Buffer& INX_InstanceCulling::GetCommandBuffer() const
+{
+    return mCommandBuffer;
+}
+
+inline bool INX_InstanceCulling::HasOccludableSlots() const
+{
+    return mOccludableCount > 0;
+}
+
+inline bool INX_InstanceCulling::IsEmpty() const
+{
+    return mSlots.IsEmpty();
+}
+
+#endif // INX_INSTANCE_CULLING_HPP
@@ -0,0 +1,223 @@
+/* INX_JobSystem.cpp -- Internal worker pool used to spread CPU work across threads
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#include "./INX_JobSystem.hpp"
+
+#include <NX/NX_Log.h>
+#include <algorithm>
+
+// ============================================================================
+// GLOBAL STATE
+// ============================================================================
+
+INX_JobSystem INX_Jobs{};
+
+/** Set on worker threads and while a thread is executing chunks, nested submissions run inline */
+static thread_local bool INX_InsideJob = false;
+
+// ============================================================================
+// PUBLIC IMPLEMENTATION
+// ============================================================================
+
+bool INX_JobSystem::Init(int workerCount)
+{
+    if (!mWorkers.IsEmpty()) {
+        return true;
+    }
+
+    if (workerCount < 0) {
+        int cores = static_cast<int>(std::thread::hardware_concurrency());
+        workerCount = std::max(cores - 1, 0);
+    }
+
+    if (!mWorkers.Reserve(workerCount)) {
+        NX_LOG(E, "CORE: Job system worker list allocation failed (requested: %i workers)", workerCount);
+        return false;
+    }
+
+    mShouldStop = false;
+    mGeneration = 0;
+    mActiveWorkers = 0;
+
+    for (int i = 0; i < workerCount; ++i) {
+        mWorkers.EmplaceBack([this]() { WorkerLoop(); });
+    }
+
+    mWorkerCount = workerCount;
+
+    NX_LOG(D, "CORE: Job system started with %i worker thread(s)", workerCount);
+
+    return true;
+}
+
+void INX_JobSystem::Quit()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mShouldStop = true;
+    }
+    mWakeCV.notify_all();
+
+    for (size_t i = 0; i < mWorkers.GetSize(); ++i) {
+        std::thread& worker = mWorkers[i];
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    mWorkers.Clear();
+    mWorkerCount = 0;
+
+    mTasks.Clear();
+    mTaskHead = 0;
+}
+
+void INX_JobSystem::Submit(Task task, void* context)
+{
+    bool queued = false;
+
+    if (mWorkerCount > 0) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        // The queue restarts from the beginning whenever it has been drained
+        if (mTaskHead == mTasks.GetSize()) {
+            mTasks.Clear();
+            mTaskHead = 0;
+        }
+        queued = (mTasks.EmplaceBack(task, context) != nullptr);
+    }
+
+    if (!queued) {
+        task(context);
+        return;
+    }
+
+    mWakeCV.notify_one();
+}
+
+// ============================================================================
+// PRIVATE IMPLEMENTATION
+// ============================================================================
+
+void INX_JobSystem::Dispatch(Invoke invoke, void* context, size_t count, size_t grainSize)
+{
+    Batch batch {
+        .invoke = invoke,
+        .context = context,
+        .count = count,
+        .grainSize = grainSize,
+        .chunkCount = (count + grainSize - 1) / grainSize
+    };
+
+    /* --- Run inline when there is nothing to share or when nested --- */
+
+    if (mWorkerCount == 0 || batch.chunkCount <= 1 || INX_InsideJob) {
+        for (size_t begin = 0; begin < count; begin += grainSize) {
+            invoke(context, begin, std::min(begin + grainSize, count));
+        }
+        return;
+    }
+
+    /* --- Publish the batch and wake up the workers --- */
+
+    std::lock_guard<std::mutex> dispatchLock(mDispatchMutex);
+
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        // Claims of the previous batch must be over before the chunk counter restarts
+        mDoneCV.wait(lock, [this]() { return mActiveWorkers == 0; });
+        mBatch = batch;
+        mNextChunk.store(0, std::memory_order_relaxed);
+        mRemainingChunks.store(batch.chunkCount, std::memory_order_relaxed);
+        ++mGeneration;
+    }
+    mWakeCV.notify_all();
+
+    /* --- The calling thread takes its share of the work --- */
+
+    RunChunks(batch);
+
+    /* --- Wait for all chunks, and for every worker to leave the batch --- */
+
+    // Waiting for active workers to leave ensures that none of them can still
+    // hold a reference to this batch once the next one is published.
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDoneCV.wait(lock, [this]() {
+        return mRemainingChunks.load(std::memory_order_acquire) == 0 && mActiveWorkers == 0;
+    });
+
+    // A worker busy with a task during the batch only sees its generation later,
+    // the batch is cleared so that it never joins it once the caller returned
+    mBatch = Batch{};
+}
+
+void INX_JobSystem::RunChunks(const Batch& batch)
+{
+    bool wasInside = INX_InsideJob;
+    INX_InsideJob = true;
+
+    while (true) {
+        size_t chunk = mNextChunk.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= batch.chunkCount) break;
+
+        size_t begin = chunk * batch.grainSize;
+        size_t end = std::min(begin + batch.grainSize, batch.count);
+        batch.invoke(batch.context, begin, end);
+
+        mRemainingChunks.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    INX_InsideJob = wasInside;
+}
+
+void INX_JobSystem::WorkerLoop()
+{
+    INX_InsideJob = true;
+    uint64_t seenGeneration = 0;
+
+    while (true)
+    {
+        Batch batch{};
+        QueuedTask task{};
+
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWakeCV.wait(lock, [&]() {
+                return mShouldStop || mGeneration != seenGeneration || mTaskHead < mTasks.GetSize();
+            });
+            // Batches are waited on by their caller, they go before queued tasks
+            if (mGeneration != seenGeneration) {
+                seenGeneration = mGeneration;
+                if (mBatch.invoke == nullptr) {
+                    continue;   //< Already completed, see 'Dispatch'
+                }
+                batch = mBatch;
+                ++mActiveWorkers;
+            }
+            else if (mTaskHead < mTasks.GetSize()) {
+                task = mTasks[mTaskHead++];
+            }
+            else {
+                break;
+            }
+        }
+
+        if (task.task != nullptr) {
+            task.task(task.context);
+            continue;
+        }
+
+        RunChunks(batch);
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            --mActiveWorkers;
+        }
+        mDoneCV.notify_all();
+    }
+}
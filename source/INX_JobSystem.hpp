@@ -0,0 +1,140 @@
+/* INX_JobSystem.hpp -- Internal worker pool used to spread CPU work across threads
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef INX_JOB_SYSTEM_HPP
+#define INX_JOB_SYSTEM_HPP
+
+#include "./Detail/Util/DynamicArray.hpp"
+
+#include <condition_variable>
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <mutex>
+
+// ============================================================================
+// JOB SYSTEM
+// ============================================================================
+
+/**
+ * @brief Persistent pool of worker threads.
+ *
+ * Work is submitted as an index range that is split into fixed-size chunks.
+ * Chunk boundaries only depend on the range size and the grain size, never on
+ * the number of workers or on scheduling, so as long as each index writes to
+ * its own output slot the result is identical to a serial loop.
+ *
+ * The calling thread always takes part in the work and only returns once every
+ * chunk has been processed. Calls made from inside a job are executed inline.
+ *
+ * Independent tasks, such as asset decoding, can also be submitted without
+ * waiting for them. They run in submission order on the same workers, which
+ * always take a pending batch first so ParallelFor keeps its latency.
+ */
+class INX_JobSystem {
+public:
+    using Task = void(*)(void* context);
+
+public:
+    /** Lifetime, queued tasks are still run before the workers stop */
+    bool Init(int workerCount);     //< If 'workerCount' < 0, uses the number of logical cores minus one
+    void Quit();
+
+    /** Getters */
+    int GetWorkerCount() const;
+    int GetChunkCount(size_t count, size_t grainSize) const;
+
+    /** Calls 'func(begin, end)' over [0, count) split into chunks of 'grainSize' */
+    template <typename F>
+    void ParallelFor(size_t count, size_t grainSize, F&& func);
+
+    /** Queues 'task(context)' for a worker and returns, without workers it runs immediately */
+    void Submit(Task task, void* context);
+
+private:
+    using Invoke = void(*)(void* context, size_t begin, size_t end);
+
+    struct Batch {
+        Invoke invoke{};
+        void* context{};
+        size_t count{};
+        size_t grainSize{};
+        size_t chunkCount{};
+    };
+
+    struct QueuedTask {
+        Task task{};
+        void* context{};
+    };
+
+private:
+    void Dispatch(Invoke invoke, void* context, size_t count, size_t grainSize);
+    void RunChunks(const Batch& batch);
+    void WorkerLoop();
+
+private:
+    util::DynamicArray<std::thread> mWorkers{};
+    int mWorkerCount{};
+
+    std::mutex mDispatchMutex;          //< Serializes concurrent submissions
+    std::mutex mMutex;                  //< Protects the batch description and counters below
+    std::condition_variable mWakeCV;
+    std::condition_variable mDoneCV;
+
+    Batch mBatch{};
+    uint64_t mGeneration{};
+    int mActiveWorkers{};
+    bool mShouldStop{};
+
+    util::DynamicArray<QueuedTask> mTasks{};    //< FIFO from 'mTaskHead', protected by 'mMutex'
+    size_t mTaskHead{};
+
+    std::atomic<size_t> mNextChunk{};
+    std::atomic<size_t> mRemainingChunks{};
+};
+
+extern INX_JobSystem INX_Jobs;
+
+// ============================================================================
+// INLINE IMPLEMENTATION
+// ============================================================================
+
+inline int INX_JobSystem::GetWorkerCount() const
+{
+    return mWorkerCount;
+}
+
+inline int INX_JobSystem::GetChunkCount(size_t count, size_t grainSize) const
+{
+    if (grainSize == 0) grainSize = 1;
+    return static_cast<int>((count + grainSize - 1) / grainSize);
+}
+
+template <typename F>
+inline void INX_JobSystem::ParallelFor(size_t count, size_t grainSize, F&& func)
+{
+    using Func = std::remove_reference_t<F>;
+
+    if (count == 0) {
+        return;
+    }
+
+    if (grainSize == 0) {
+        grainSize = 1;
+    }
+
+    Invoke invoke = [](void* context, size_t begin, size_t end) {
+        (*static_cast<Func*>(context))(begin, end);
+    };
+
+    Dispatch(invoke, const_cast<void*>(static_cast<const void*>(&func)), count, grainSize);
+}
+
+#endif // INX_JOB_SYSTEM_HPP
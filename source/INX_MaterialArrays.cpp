@@ -0,0 +1,287 @@
+/* INX_MaterialArrays.cpp -- Material textures stored as layers of texture arrays
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#include "./INX_MaterialArrays.hpp"
+
+#include <NX/NX_Log.h>
+
+// ============================================================================
+// MATERIAL ARRAYS
+// ============================================================================
+
+INX_MaterialArrayCache INX_MaterialArrays{};
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+void INX_MaterialArrayCache::BeginPass()
+{
+    for (size_t i = 0; i < mGroups.GetSize(); i++) {
+        UpdateMipmap(mGroups[i]);
+    }
+}
+
+bool INX_MaterialArrayCache::Create(const NX_Texture& texture, const gpu::TextureConfig& config, const gpu::TextureParam& param)
+{
+    const Key key {
+        .internalFormat = config.internalFormat,
+        .width = config.width,
+        .height = config.height,
+        .mipmap = config.mipmap,
+        .param = param
+    };
+
+    if (!Allocate(key, &texture.arrayGroup, &texture.arrayLayer)) {
+        return false;
+    }
+
+    Upload(texture, config.data);
+
+    return true;
+}
+
+void INX_MaterialArrayCache::Upload(const NX_Texture& texture, const void* data)
+{
+    Group& group = mGroups[texture.arrayGroup];
+
+    group.array.Upload(data, gpu::UploadRegion {
+        .z = texture.arrayLayer,
+        .width = group.key.width,
+        .height = group.key.height
+    });
+
+    // All layers are generated at once, so uploads are batched until the next pass
+    group.mipmapStale = group.key.mipmap;
+}
+
+uint32_t INX_MaterialArrayCache::Resolve(const NX_Texture& texture)
+{
+    const gpu::Texture& gpu = texture.gpu;
+
+    /* --- Nothing to do if the layer is up to date --- */
+
+    const bool current = (texture.arrayGroup >= 0)
+        && (!gpu.IsValid() || texture.arrayRevision == gpu.GetRevision());
+
+    if (current) {
+        if (gpu.IsValid() && !texture.standalone) {
+            texture.gpu = gpu::Texture{};
+        }
+        return static_cast<uint32_t>(texture.arrayLayer);
+    }
+
+    if (!gpu.IsValid()) {
+        return 0;
+    }
+
+    /* --- Move to another group if the texture no longer matches its own --- */
+
+    const Key key = GetKey(gpu);
+
+    if (texture.arrayGroup >= 0 && !Matches(mGroups[texture.arrayGroup], key)) {
+        Release(texture);
+        mGeneration++;
+    }
+
+    if (texture.arrayGroup < 0 && !Allocate(key, &texture.arrayGroup, &texture.arrayLayer)) {
+        return 0;
+    }
+
+    /* --- Copy all levels into the layer, textures only used by materials then live there --- */
+
+    if (Copy(gpu, 0, mGroups[texture.arrayGroup].array, texture.arrayLayer)) {
+        texture.arrayRevision = gpu.GetRevision();
+        if (!texture.standalone) {
+            texture.gpu = gpu::Texture{};
+        }
+    }
+
+    return static_cast<uint32_t>(texture.arrayLayer);
+}
+
+bool INX_MaterialArrayCache::Extract(const NX_Texture& texture)
+{
+    Group& group = mGroups[texture.arrayGroup];
+    UpdateMipmap(group);
+
+    texture.gpu = gpu::Texture(
+        gpu::TextureConfig {
+            .target = GL_TEXTURE_2D,
+            .internalFormat = group.key.internalFormat,
+            .data = nullptr,
+            .width = group.key.width,
+            .height = group.key.height,
+            .depth = 0,
+            .mipmap = group.key.mipmap
+        },
+        group.key.param
+    );
+
+    if (!texture.gpu.IsValid() || !Copy(group.array, texture.arrayLayer, texture.gpu, 0)) {
+        NX_LOG(E, "RENDER: Failed to extract material texture from its array");
+        return false;
+    }
+
+    texture.arrayRevision = texture.gpu.GetRevision();
+
+    return true;
+}
+
+void INX_MaterialArrayCache::Release(const NX_Texture& texture)
+{
+    if (texture.arrayGroup < 0) {
+        return;
+    }
+
+    if (texture.arrayGroup < static_cast<int>(mGroups.GetSize())) {
+        mGroups[texture.arrayGroup].freeLayers.PushBack(texture.arrayLayer);
+    }
+
+    texture.arrayGroup = -1;
+    texture.arrayLayer = -1;
+    texture.arrayRevision = 0;
+}
+
+void INX_MaterialArrayCache::UnloadAll()
+{
+    mGroups.Clear();
+}
+
+// ============================================================================
+// PRIVATE IMPLEMENTATION
+// ============================================================================
+
+INX_MaterialArrayCache::Key INX_MaterialArrayCache::GetKey(const gpu::Texture& texture)
+{
+    return Key {
+        .internalFormat = texture.GetInternalFormat(),
+        .width = texture.GetWidth(),
+        .height = texture.GetHeight(),
+        .mipmap = texture.HasMipmap(),
+        .param = texture.GetParameters()
+    };
+}
+
+bool INX_MaterialArrayCache::Matches(const Group& group, const Key& key)
+{
+    return group.key.internalFormat == key.internalFormat
+        && group.key.width == key.width
+        && group.key.height == key.height
+        && group.key.mipmap == key.mipmap
+        && group.key.param == key.param;
+}
+
+bool INX_MaterialArrayCache::Copy(const gpu::Texture& src, int srcLayer, const gpu::Texture& dst, int dstLayer)
+{
+    const int levels = NX_MIN(src.GetNumLevels(), dst.GetNumLevels());
+
+    while (glGetError() != GL_NO_ERROR) { }   //< Only report the errors of the copy
+
+    for (int mip = 0; mip < levels; mip++) {
+        glCopyImageSubData(
+            src.GetID(), src.GetTarget(), mip, 0, 0, srcLayer,
+            dst.GetID(), dst.GetTarget(), mip, 0, 0, dstLayer,
+            NX_MAX(1, src.GetWidth() >> mip), NX_MAX(1, src.GetHeight() >> mip), 1
+        );
+    }
+
+    GLenum err = glGetError();
+    if (err != GL_NO_ERROR) {
+        NX_LOG(E, "RENDER: Failed to copy material texture: 0x%x", err);
+        return false;
+    }
+
+    return true;
+}
+
+bool INX_MaterialArrayCache::Allocate(const Key& key, int* group, int* layer)
+{
+    if (mMaxLayers == 0) {
+        glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &mMaxLayers);
+        mMaxLayers = NX_MAX(mMaxLayers, 1);
+    }
+
+    /* --- Reuse a free layer or grow a group that has room left --- */
+
+    int candidate = -1;
+
+    for (int i = 0; i < static_cast<int>(mGroups.GetSize()); i++) {
+        Group& g = mGroups[i];
+        if (!Matches(g, key)) {
+            continue;
+        }
+        if (!g.freeLayers.IsEmpty()) {
+            *group = i;
+            *layer = *g.freeLayers.GetBack();
+            g.freeLayers.PopBack();
+            return true;
+        }
+        if (candidate < 0 && g.layerCount < mMaxLayers) {
+            candidate = i;
+        }
+    }
+
+    /* --- Otherwise create a new group, arrays grow on demand --- */
+
+    if (candidate < 0) {
+        gpu::Texture array(
+            gpu::TextureConfig {
+                .target = GL_TEXTURE_2D_ARRAY,
+                .internalFormat = key.internalFormat,
+                .data = nullptr,
+                .width = key.width,
+                .height = key.height,
+                .depth = NX_MIN(4, mMaxLayers),
+                .mipmap = key.mipmap
+            },
+            key.param
+        );
+
+        if (!array.IsValid()) {
+            NX_LOG(E, "RENDER: Failed to create material texture array (%ix%i)", key.width, key.height);
+            return false;
+        }
+
+        if (!mGroups.PushBack(Group {
+            .array = std::move(array),
+            .key = key,
+            .freeLayers = {},
+            .layerCount = 0,
+            .mipmapStale = false
+        })) {
+            NX_LOG(E, "RENDER: Failed to push material texture array group");
+            return false;
+        }
+
+        candidate = static_cast<int>(mGroups.GetSize()) - 1;
+    }
+
+    Group& g = mGroups[candidate];
+
+    if (g.layerCount >= g.array.GetDepth()) {
+        g.array.ReserveLayers(NX_MIN(2 * g.array.GetDepth(), mMaxLayers), true);
+        if (g.layerCount >= g.array.GetDepth()) {
+            NX_LOG(E, "RENDER: Failed to grow material texture array (%i layers)", g.layerCount);
+            return false;
+        }
+    }
+
+    *group = candidate;
+    *layer = g.layerCount++;
+
+    return true;
+}
+
+void INX_MaterialArrayCache::UpdateMipmap(Group& group)
+{
+    if (group.mipmapStale) {
+        group.array.GenerateMipmap();
+        group.mipmapStale = false;
+    }
+}
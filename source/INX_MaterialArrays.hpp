@@ -0,0 +1,121 @@
+/* INX_MaterialArrays.hpp -- Material textures stored as layers of texture arrays
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef INX_MATERIAL_ARRAYS_HPP
+#define INX_MATERIAL_ARRAYS_HPP
+
+#include "./Detail/Util/DynamicArray.hpp"
+#include "./Detail/GPU/Texture.hpp"
+
+#include "./NX_Texture.hpp"
+
+// ============================================================================
+// MATERIAL ARRAYS
+// ============================================================================
+
+/**
+ * @brief Texture arrays storing the material textures, used without bindless support.
+ *
+ * Textures with the same size, format, mipmap and sampling parameters share a group,
+ * whose array gets one layer per texture. The scene shaders sample the arrays bound
+ * for the group with the layer stored in the draw record, so draw calls whose textures
+ * belong to the same groups share their bindings and can be merged.
+ *
+ * Imported material textures are created directly in their layer and have no texture
+ * object of their own. Other textures are moved into a layer on their first resolve,
+ * unless they are also used outside of the materials, like render targets. Only these
+ * keep both, their layer being refreshed when their revision changes.
+ *
+ * A texture whose own object is needed elsewhere gets it copied out of its layer. When
+ * its size, format or parameters changed, it moves to another group and the generation
+ * is incremented so that stored layers can be repacked. Must be used from the GL thread.
+ */
+class INX_MaterialArrayCache {
+public:
+    /** Whether the material textures are stored in the arrays */
+    static bool IsEnabled();
+
+    /** Generates the mipmaps of the layers uploaded since the last pass */
+    void BeginPass();
+
+    /** Gives a layer to a new texture without texture object and uploads its base level */
+    bool Create(const NX_Texture& texture, const gpu::TextureConfig& config, const gpu::TextureParam& param);
+
+    /** Uploads the base level of a texture that only lives in its layer */
+    void Upload(const NX_Texture& texture, const void* data);
+
+    /** Moves or copies the texture into an array if needed and returns its layer, zero on failure */
+    uint32_t Resolve(const NX_Texture& texture);
+
+    /** Creates the texture object of a texture from its layer, which is kept */
+    bool Extract(const NX_Texture& texture);
+
+    /** Array holding the layer of a texture */
+    const gpu::Texture& GetArray(const NX_Texture& texture) const;
+
+    /** Frees the layer of a texture about to be destroyed */
+    void Release(const NX_Texture& texture);
+
+    /** Incremented each time a texture moved to another layer */
+    uint32_t GetGeneration() const;
+
+    /** Destroys all arrays */
+    void UnloadAll();
+
+private:
+    struct Key {
+        GLenum internalFormat;
+        int width, height;
+        bool mipmap;
+        gpu::TextureParam param;
+    };
+
+    struct Group {
+        gpu::Texture array;
+        Key key;
+        util::DynamicArray<int> freeLayers;
+        int layerCount;                     //< Layers given so far, free ones are reused first
+        bool mipmapStale;                   //< Base levels were uploaded since the mipmaps were generated
+    };
+
+private:
+    static Key GetKey(const gpu::Texture& texture);
+    static bool Matches(const Group& group, const Key& key);
+    static bool Copy(const gpu::Texture& src, int srcLayer, const gpu::Texture& dst, int dstLayer);
+    bool Allocate(const Key& key, int* group, int* layer);
+    void UpdateMipmap(Group& group);
+
+private:
+    util::DynamicArray<Group> mGroups{};
+    gpu::Texture mEmpty{};
+    uint32_t mGeneration{};
+    int mMaxLayers{};
+};
+
+extern INX_MaterialArrayCache INX_MaterialArrays;
+
+// ============================================================================
+// INLINE IMPLEMENTATION
+// ============================================================================
+
+inline bool INX_MaterialArrayCache::IsEnabled()
+{
+    return !gpu::Texture::HasBindless();
+}
+
+inline const gpu::Texture& INX_MaterialArrayCache::GetArray(const NX_Texture& texture) const
+{
+    return (texture.arrayGroup >= 0) ? mGroups[texture.arrayGroup].array : mEmpty;
+}
+
+inline uint32_t INX_MaterialArrayCache::GetGeneration() const
+{
+    return mGeneration;
+}
+
+#endif // INX_MATERIAL_ARRAYS_HPP
@@ -0,0 +1,98 @@
+/* INX_MultiDraw.cpp -- Groups of draw calls submitted with a single multi-draw indirect call
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#include "./INX_MultiDraw.hpp"
+
+#include <NX/NX_Log.h>
+
+// ============================================================================
+// LOCAL FUNCTIONS
+// ============================================================================
+
+static void INX_UploadBuffer(gpu::Buffer& buffer, GLenum target, size_t size, const void* data)
+{
+    if (!buffer.IsValid()) {
+        buffer = gpu::Buffer(target, NX_MAX(size, size_t(64)), nullptr, GL_DYNAMIC_DRAW);
+    }
+    else if (size > static_cast<size_t>(buffer.GetSize())) {
+        buffer.Realloc(NX_MAX(size, 2 * static_cast<size_t>(buffer.GetSize())), false);
+    }
+
+    buffer.Upload(0, size, data);
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+void INX_MultiDraw::PushDraw(int uniqueIndex)
+{
+    mItems.PushBack(Item{uniqueIndex, -1});
+}
+
+void INX_MultiDraw::PushGroup(int uniqueIndex, int savedCalls)
+{
+    const int group = static_cast<int>(mGroups.GetSize());
+
+    if (!mGroups.PushBack(Group{static_cast<uint32_t>(mCommands.GetSize()), 0, savedCalls})) {
+        NX_LOG(E, "RENDER: Failed to push multi-draw group; Draw call submitted alone");
+        mItems.PushBack(Item{uniqueIndex, -1});
+        return;
+    }
+
+    mItems.PushBack(Item{uniqueIndex, group});
+}
+
+void INX_MultiDraw::PushCommand(uint32_t indexCount, uint32_t drawSharedIndex, uint32_t drawUniqueIndex)
+{
+    SDL_assert(!mGroups.IsEmpty());
+
+    const uint32_t command = static_cast<uint32_t>(mCommands.GetSize());
+
+    mCommands.PushBack(Command {
+        .count = indexCount,
+        .instanceCount = 1,
+        .firstIndex = 0,
+        .baseVertex = 0,
+        .baseInstance = command
+    });
+
+    mDrawIndices.PushBack(NX_IVEC2(
+        static_cast<int>(drawSharedIndex),
+        static_cast<int>(drawUniqueIndex)
+    ));
+
+    mGroups.GetBack()->drawCount++;
+}
+
+void INX_MultiDraw::Upload()
+{
+    if (mCommands.IsEmpty()) {
+        return;
+    }
+
+    INX_UploadBuffer(mCommandBuffer, GL_DRAW_INDIRECT_BUFFER, mCommands.GetSize() * sizeof(Command), mCommands.GetData());
+    INX_UploadBuffer(mDrawIndexBuffer, GL_ARRAY_BUFFER, mDrawIndices.GetSize() * sizeof(NX_IVec2), mDrawIndices.GetData());
+}
+
+void INX_MultiDraw::Submit(const gpu::Pipeline& pipeline, NX_VertexBuffer3D& buffer, GLenum primitive, int group) const
+{
+    const Group& g = mGroups[group];
+
+    buffer.BindDrawIndices(mDrawIndexBuffer);
+    pipeline.MultiDrawElementsIndirect(primitive, GL_UNSIGNED_INT, mCommandBuffer, g.firstCommand * sizeof(Command), g.drawCount);
+    buffer.UnbindDrawIndices();
+}
+
+void INX_MultiDraw::Clear()
+{
+    mItems.Clear();
+    mGroups.Clear();
+    mCommands.Clear();
+    mDrawIndices.Clear();
+}
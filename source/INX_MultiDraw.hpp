@@ -0,0 +1,102 @@
+/* INX_MultiDraw.hpp -- Groups of draw calls submitted with a single multi-draw indirect call
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef INX_MULTI_DRAW_HPP
+#define INX_MULTI_DRAW_HPP
+
+#include <NX/NX_Math.h>
+
+#include "./Detail/Util/DynamicArray.hpp"
+#include "./Detail/GPU/Pipeline.hpp"
+#include "./Detail/GPU/Buffer.hpp"
+
+#include "./NX_Vertex.hpp"
+
+// ============================================================================
+// MULTI DRAW
+// ============================================================================
+
+/**
+ * @brief Ordered list of draw items, where items can be groups of draw calls.
+ *
+ * The draw calls of a group share all their pipeline state and their vertex array,
+ * only their records differ. Each one gets an indexed indirect command whose base
+ * instance points to its pair of shared/unique record indices, read through the
+ * 'iDrawIndex' vertex attribute, so the whole group is submitted at once.
+ *
+ * Items keep the order in which they are pushed, a group is placed at its first draw call.
+ */
+class INX_MultiDraw {
+public:
+    /** Indexed indirect command, as read by glMultiDrawElementsIndirect */
+    struct Command {
+        uint32_t count;
+        uint32_t instanceCount;
+        uint32_t firstIndex;
+        int32_t baseVertex;
+        uint32_t baseInstance;
+    };
+
+    /** Draw calls submitted together */
+    struct Group {
+        uint32_t firstCommand;
+        uint32_t drawCount;
+        int savedCalls;         //< Renderer calls avoided compared to drawing each call alone
+    };
+
+    /** Entry of the draw list */
+    struct Item {
+        int uniqueIndex;        //< Draw call providing the pipeline state
+        int group;              //< Less than zero for draw calls submitted alone
+    };
+
+public:
+    /** Appends a draw call submitted alone */
+    void PushDraw(int uniqueIndex);
+
+    /** Appends a group, its draw calls are added with 'PushCommand' */
+    void PushGroup(int uniqueIndex, int savedCalls);
+    void PushCommand(uint32_t indexCount, uint32_t drawSharedIndex, uint32_t drawUniqueIndex);
+
+    /** Uploads the commands and draw indices of all groups */
+    void Upload();
+
+    /** Draws a group, the vertex array of 'buffer' must be bound */
+    void Submit(const gpu::Pipeline& pipeline, NX_VertexBuffer3D& buffer, GLenum primitive, int group) const;
+
+    /** Clears the list, GPU buffers are kept */
+    void Clear();
+
+    /** Getters */
+    const util::DynamicArray<Item>& GetItems() const;
+    const util::DynamicArray<Group>& GetGroups() const;
+
+private:
+    util::DynamicArray<Item> mItems{};
+    util::DynamicArray<Group> mGroups{};
+    util::DynamicArray<Command> mCommands{};
+    util::DynamicArray<NX_IVec2> mDrawIndices{};    //< Shared and unique record indices per command
+    gpu::Buffer mCommandBuffer{};
+    gpu::Buffer mDrawIndexBuffer{};
+};
+
+// ============================================================================
+// INLINE IMPLEMENTATION
+// ============================================================================
+
+inline const util::DynamicArray<INX_MultiDraw::Item>& INX_MultiDraw::GetItems() const
+{
+    return mItems;
+}
+
+inline const util::DynamicArray<INX_MultiDraw::Group>& INX_MultiDraw::GetGroups() const
+{
+    return mGroups;
+}
+
+#endif // INX_MULTI_DRAW_HPP
@@ -0,0 +1,538 @@
+/* INX_PixelConvert.cpp -- Internal row kernels converting pixels between formats
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#include "./INX_PixelConvert.hpp"
+#include "./INX_JobSystem.hpp"
+
+#include <NX/NX_Platform.h>
+#include <NX/NX_Math.h>
+
+#include <type_traits>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <array>
+
+#include <fp16.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#   define INX_X86_DISPATCH
+#   define INX_TARGET(features) __attribute__((target(features)))
+#   include <immintrin.h>
+#   include <cpuid.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#   define INX_X86_DISPATCH
+#   define INX_TARGET(features)
+#   include <immintrin.h>
+#   include <intrin.h>
+#else
+#   define INX_TARGET(features)
+#endif
+
+// ============================================================================
+// CONSTANTS
+// ============================================================================
+
+/** Below this number of pixels, images are converted on the calling thread only */
+static constexpr size_t INX_PARALLEL_PIXEL_THRESHOLD = 256 * 1024;
+
+/** Approximate number of pixels processed by each job chunk */
+static constexpr size_t INX_PARALLEL_PIXEL_GRAIN = 64 * 1024;
+
+/** Pixels remapped at once when the channel count and the type both change */
+static constexpr size_t INX_REMAP_BLOCK_SIZE = 256;
+
+// ============================================================================
+// CPU FEATURES
+// ============================================================================
+
+/**
+ * The library is built for the baseline of the target, so the SSSE3, SSE4.1 and
+ * F16C kernels are compiled with their own target attributes and only selected
+ * when the CPU running them supports the instructions.
+ */
+struct INX_CpuFeatures {
+    bool ssse3;
+    bool sse41;
+    bool f16c;
+};
+
+#if defined(INX_X86_DISPATCH)
+static INX_CpuFeatures INX_DetectCpuFeatures()
+{
+    INX_CpuFeatures features{};
+    uint32_t ecx = 0;
+
+#if defined(_MSC_VER)
+    int info[4]{};
+    __cpuid(info, 0);
+    if (info[0] < 1) return features;
+    __cpuid(info, 1);
+    ecx = static_cast<uint32_t>(info[2]);
+#else
+    unsigned int eax, ebx, edx, regEcx;
+    if (!__get_cpuid(1, &eax, &ebx, &regEcx, &edx)) return features;
+    ecx = regEcx;
+#endif
+
+    features.ssse3 = (ecx & (1u << 9)) != 0;
+    features.sse41 = (ecx & (1u << 19)) != 0;
+
+    // F16C is VEX encoded, the OS must save the AVX registers as well
+    const bool osxsave = (ecx & (1u << 27)) != 0;
+    const bool avx = (ecx & (1u << 28)) != 0;
+
+    if (osxsave && avx) {
+#if defined(_MSC_VER)
+        const uint64_t xcr0 = _xgetbv(0);
+#else
+        uint32_t lo, hi;
+        __asm__ volatile ("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+        const uint64_t xcr0 = (static_cast<uint64_t>(hi) << 32) | lo;
+#endif
+        features.f16c = (ecx & (1u << 29)) != 0 && (xcr0 & 0x6) == 0x6;
+    }
+
+    return features;
+}
+
+static const INX_CpuFeatures INX_Cpu = INX_DetectCpuFeatures();
+#endif
+
+// ============================================================================
+// CHANNEL CONVERSION
+// ============================================================================
+
+/** Storage type of 16-bit channels, which are always half floats */
+using INX_Half = uint16_t;
+
+template <typename T>
+static constexpr T INX_GetDefaultChannel(int channel)
+{
+    if (channel < 3) return T{};
+
+    if constexpr (std::is_same_v<T, uint8_t>) return 255;
+    else if constexpr (std::is_same_v<T, INX_Half>) return 0x3C00;
+    else return 1.0f;
+}
+
+static inline float INX_ChannelToFloat(uint8_t v) { return v / 255.0f; }
+static inline float INX_ChannelToFloat(INX_Half v) { return fp16_ieee_to_fp32_value(v); }
+static inline float INX_ChannelToFloat(float v) { return v; }
+
+template <typename T>
+static inline T INX_ChannelFromFloat(float v)
+{
+    if constexpr (std::is_same_v<T, uint8_t>) return static_cast<uint8_t>(NX_Saturate(v) * 255.0f);
+    else if constexpr (std::is_same_v<T, INX_Half>) return fp16_ieee_from_fp32_value(NX_CLAMP(v, -65504.0f, 65504.0f));
+    else return v;
+}
+
+/** 8-bit channels only have 256 values, their half conversion and inversion are looked up */
+static const INX_Half* INX_GetUnormToHalfTable()
+{
+    static const std::array<INX_Half, 256> table = []() {
+        std::array<INX_Half, 256> result{};
+        for (int i = 0; i < 256; i++) {
+            result[i] = INX_ChannelFromFloat<INX_Half>(INX_ChannelToFloat(static_cast<uint8_t>(i)));
+        }
+        return result;
+    }();
+    return table.data();
+}
+
+static const uint8_t* INX_GetUnormInvertTable()
+{
+    static const std::array<uint8_t, 256> table = []() {
+        std::array<uint8_t, 256> result{};
+        for (int i = 0; i < 256; i++) {
+            result[i] = INX_ChannelFromFloat<uint8_t>(1.0f - INX_ChannelToFloat(static_cast<uint8_t>(i)));
+        }
+        return result;
+    }();
+    return table.data();
+}
+
+#if defined(NX_HAS_SSE2) || defined(INX_X86_DISPATCH)
+INX_TARGET("sse2")
+static inline __m128i INX_PackUnorm8(__m128 a, __m128 b)
+{
+    // Same as the scalar saturate then truncate, the 8 bytes are returned in the low half
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(255.0f);
+
+    __m128i ia = _mm_cvttps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(a, zero), one), scale));
+    __m128i ib = _mm_cvttps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(b, zero), one), scale));
+
+    return _mm_packus_epi16(_mm_packs_epi32(ia, ib), _mm_setzero_si128());
+}
+#endif
+
+#if defined(INX_X86_DISPATCH)
+
+/* --- Kernels selected at runtime, each returns the number of channels processed --- */
+
+INX_TARGET("sse4.1,f16c")
+static size_t INX_ConvertUnormToHalf_F16C(const uint8_t* NX_RESTRICT s, INX_Half* NX_RESTRICT d, size_t n)
+{
+    size_t i = 0;
+    const __m128 scale = _mm_set1_ps(255.0f);
+    for (; i + 8 <= n; i += 8) {
+        __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(s + i));
+        __m128 lo = _mm_div_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(bytes)), scale);
+        __m128 hi = _mm_div_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(bytes, 4))), scale);
+        __m128i halves = _mm_unpacklo_epi64(
+            _mm_cvtps_ph(lo, _MM_FROUND_TO_NEAREST_INT),
+            _mm_cvtps_ph(hi, _MM_FROUND_TO_NEAREST_INT)
+        );
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i), halves);
+    }
+    return i;
+}
+
+INX_TARGET("sse4.1")
+static size_t INX_ConvertUnormToFloat_SSE41(const uint8_t* NX_RESTRICT s, float* NX_RESTRICT d, size_t n)
+{
+    size_t i = 0;
+    const __m128 scale = _mm_set1_ps(255.0f);
+    for (; i + 4 <= n; i += 4) {
+        int32_t word;
+        std::memcpy(&word, s + i, sizeof(word));
+        __m128i ints = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(word));
+        _mm_storeu_ps(d + i, _mm_div_ps(_mm_cvtepi32_ps(ints), scale));
+    }
+    return i;
+}
+
+INX_TARGET("f16c")
+static size_t INX_ConvertHalfToUnorm_F16C(const INX_Half* NX_RESTRICT s, uint8_t* NX_RESTRICT d, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128 lo = _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(s + i)));
+        __m128 hi = _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(s + i + 4)));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(d + i), INX_PackUnorm8(lo, hi));
+    }
+    return i;
+}
+
+INX_TARGET("f16c")
+static size_t INX_ConvertHalfToFloat_F16C(const INX_Half* NX_RESTRICT s, float* NX_RESTRICT d, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(d + i, _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(s + i))));
+    }
+    return i;
+}
+
+INX_TARGET("f16c")
+static size_t INX_ConvertFloatToHalf_F16C(const float* NX_RESTRICT s, INX_Half* NX_RESTRICT d, size_t n)
+{
+    size_t i = 0;
+    // Operand order matters, 'max' and 'min' return their second operand for NaNs like 'NX_CLAMP'
+    const __m128 lo = _mm_set1_ps(-65504.0f);
+    const __m128 hi = _mm_set1_ps(65504.0f);
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(s + i), lo), hi);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(d + i), _mm_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT));
+    }
+    return i;
+}
+
+INX_TARGET("ssse3")
+static size_t INX_RemapRGBToRGBA_SSSE3(const uint8_t* NX_RESTRICT s, uint8_t* NX_RESTRICT d, size_t count)
+{
+    size_t i = 0;
+    // 16 bytes are loaded for 12 used, stop before reading past the span
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000));
+    for (; i + 6 <= count; i += 4) {
+        __m128i rgb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 3 * i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 4 * i), _mm_or_si128(_mm_shuffle_epi8(rgb, shuffle), alpha));
+    }
+    return i;
+}
+
+INX_TARGET("ssse3")
+static size_t INX_RemapRGBAToRGB_SSSE3(const uint8_t* NX_RESTRICT s, uint8_t* NX_RESTRICT d, size_t count)
+{
+    size_t i = 0;
+    // 16 bytes are stored for 12 written, stop before writing past the span
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    for (; i + 6 <= count; i += 4) {
+        __m128i rgba = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 4 * i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 3 * i), _mm_shuffle_epi8(rgba, shuffle));
+    }
+    return i;
+}
+
+#endif // INX_X86_DISPATCH
+
+/** Converts 'n' channels stored contiguously, the layout is unchanged */
+template <typename S, typename D>
+static void INX_ConvertChannels(const S* NX_RESTRICT s, D* NX_RESTRICT d, size_t n)
+{
+    size_t i = 0;
+
+    if constexpr (std::is_same_v<S, D> && !std::is_same_v<S, INX_Half>) {
+        std::memcpy(d, s, n * sizeof(S));
+        return;
+    }
+    else if constexpr (std::is_same_v<S, INX_Half> && std::is_same_v<D, INX_Half>) {
+        // Same as the float round trip: infinities are clamped and NaNs end up at the lowest value
+        for (; i < n; i++) {
+            const INX_Half h = s[i], m = h & 0x7FFF;
+            d[i] = (m < 0x7C00) ? h : (m == 0x7C00) ? static_cast<INX_Half>((h & 0x8000) | 0x7BFF) : 0xFBFF;
+        }
+        return;
+    }
+    else if constexpr (std::is_same_v<S, uint8_t> && std::is_same_v<D, INX_Half>) {
+#if defined(INX_X86_DISPATCH)
+        if (INX_Cpu.sse41 && INX_Cpu.f16c) i = INX_ConvertUnormToHalf_F16C(s, d, n);
+#endif
+        const INX_Half* table = INX_GetUnormToHalfTable();
+        for (; i < n; i++) {
+            d[i] = table[s[i]];
+        }
+        return;
+    }
+    else if constexpr (std::is_same_v<S, uint8_t> && std::is_same_v<D, float>) {
+#if defined(INX_X86_DISPATCH)
+        if (INX_Cpu.sse41) i = INX_ConvertUnormToFloat_SSE41(s, d, n);
+#endif
+    }
+    else if constexpr (std::is_same_v<S, INX_Half> && std::is_same_v<D, uint8_t>) {
+#if defined(INX_X86_DISPATCH)
+        if (INX_Cpu.f16c) i = INX_ConvertHalfToUnorm_F16C(s, d, n);
+#endif
+    }
+    else if constexpr (std::is_same_v<S, INX_Half> && std::is_same_v<D, float>) {
+#if defined(INX_X86_DISPATCH)
+        if (INX_Cpu.f16c) i = INX_ConvertHalfToFloat_F16C(s, d, n);
+#endif
+    }
+    else if constexpr (std::is_same_v<S, float> && std::is_same_v<D, uint8_t>) {
+#if defined(NX_HAS_SSE2)
+        for (; i + 8 <= n; i += 8) {
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(d + i), INX_PackUnorm8(_mm_loadu_ps(s + i), _mm_loadu_ps(s + i + 4)));
+        }
+#endif
+    }
+    else if constexpr (std::is_same_v<S, float> && std::is_same_v<D, INX_Half>) {
+#if defined(INX_X86_DISPATCH)
+        if (INX_Cpu.f16c) i = INX_ConvertFloatToHalf_F16C(s, d, n);
+#endif
+    }
+
+    /* --- Remaining channels, or all of them without SIMD support --- */
+
+    for (; i < n; i++) {
+        d[i] = INX_ChannelFromFloat<D>(INX_ChannelToFloat(s[i]));
+    }
+}
+
+/** Changes the channel count of 'count' pixels without converting their values */
+template <typename T, int SC, int DC>
+static void INX_RemapChannels(const T* NX_RESTRICT s, T* NX_RESTRICT d, size_t count)
+{
+    size_t i = 0;
+
+    if constexpr (std::is_same_v<T, uint8_t> && SC == 3 && DC == 4) {
+#if defined(INX_X86_DISPATCH)
+        if (INX_Cpu.ssse3) i = INX_RemapRGBToRGBA_SSSE3(s, d, count);
+#elif defined(NX_HAS_NEON) || defined(NX_HAS_NEON_FMA)
+        for (; i + 16 <= count; i += 16) {
+            uint8x16x3_t rgb = vld3q_u8(s + 3 * i);
+            uint8x16x4_t rgba = {{ rgb.val[0], rgb.val[1], rgb.val[2], vdupq_n_u8(255) }};
+            vst4q_u8(d + 4 * i, rgba);
+        }
+#endif
+    }
+    else if constexpr (std::is_same_v<T, uint8_t> && SC == 4 && DC == 3) {
+#if defined(INX_X86_DISPATCH)
+        if (INX_Cpu.ssse3) i = INX_RemapRGBAToRGB_SSSE3(s, d, count);
+#elif defined(NX_HAS_NEON) || defined(NX_HAS_NEON_FMA)
+        for (; i + 16 <= count; i += 16) {
+            uint8x16x4_t rgba = vld4q_u8(s + 4 * i);
+            uint8x16x3_t rgb = {{ rgba.val[0], rgba.val[1], rgba.val[2] }};
+            vst3q_u8(d + 3 * i, rgb);
+        }
+#endif
+    }
+
+    /* --- Remaining pixels, or all of them without SIMD support --- */
+
+    for (; i < count; i++) {
+        for (int c = 0; c < DC; c++) {
+            d[i * DC + c] = (c < SC) ? s[i * SC + c] : INX_GetDefaultChannel<T>(c);
+        }
+    }
+}
+
+// ============================================================================
+// ROW KERNELS
+// ============================================================================
+
+template <typename S, int SC, typename D, int DC>
+static void INX_ConvertRow(const void* src, void* dst, size_t count)
+{
+    const S* s = static_cast<const S*>(src);
+    D* d = static_cast<D*>(dst);
+
+    if constexpr (SC == DC) {
+        INX_ConvertChannels(s, d, count * SC);
+    }
+    else if constexpr (std::is_same_v<S, D> && !std::is_same_v<S, INX_Half>) {
+        INX_RemapChannels<S, SC, DC>(s, d, count);
+    }
+    else {
+        // Channels are remapped in the source type through a small block, which is then converted at once
+        S block[INX_REMAP_BLOCK_SIZE * DC];
+        for (size_t i = 0; i < count; i += INX_REMAP_BLOCK_SIZE) {
+            const size_t n = std::min(INX_REMAP_BLOCK_SIZE, count - i);
+            INX_RemapChannels<S, SC, DC>(s + i * SC, block, n);
+            INX_ConvertChannels(block, d + i * DC, n * DC);
+        }
+    }
+}
+
+template <typename S, int SC>
+static INX_PixelRowKernel INX_SelectRowKernel(NX_PixelFormat dstFormat)
+{
+    switch (dstFormat) {
+    case NX_PIXEL_FORMAT_R8:        return &INX_ConvertRow<S, SC, uint8_t, 1>;
+    case NX_PIXEL_FORMAT_RG8:       return &INX_ConvertRow<S, SC, uint8_t, 2>;
+    case NX_PIXEL_FORMAT_RGB8:      return &INX_ConvertRow<S, SC, uint8_t, 3>;
+    case NX_PIXEL_FORMAT_RGBA8:     return &INX_ConvertRow<S, SC, uint8_t, 4>;
+    case NX_PIXEL_FORMAT_R16F:      return &INX_ConvertRow<S, SC, INX_Half, 1>;
+    case NX_PIXEL_FORMAT_RG16F:     return &INX_ConvertRow<S, SC, INX_Half, 2>;
+    case NX_PIXEL_FORMAT_RGB16F:    return &INX_ConvertRow<S, SC, INX_Half, 3>;
+    case NX_PIXEL_FORMAT_RGBA16F:   return &INX_ConvertRow<S, SC, INX_Half, 4>;
+    case NX_PIXEL_FORMAT_R32F:      return &INX_ConvertRow<S, SC, float, 1>;
+    case NX_PIXEL_FORMAT_RG32F:     return &INX_ConvertRow<S, SC, float, 2>;
+    case NX_PIXEL_FORMAT_RGB32F:    return &INX_ConvertRow<S, SC, float, 3>;
+    case NX_PIXEL_FORMAT_RGBA32F:   return &INX_ConvertRow<S, SC, float, 4>;
+    case NX_PIXEL_FORMAT_INVALID:   break;
+    }
+    return nullptr;
+}
+
+// ============================================================================
+// INVERSION
+// ============================================================================
+
+template <typename T, int C>
+static void INX_InvertRow(T* pixels, size_t count)
+{
+    constexpr int colorChannels = (C < 3) ? C : 3;
+
+    if constexpr (std::is_same_v<T, uint8_t>) {
+        const uint8_t* table = INX_GetUnormInvertTable();
+        for (size_t i = 0; i < count; i++) {
+            for (int c = 0; c < colorChannels; c++) {
+                pixels[i * C + c] = table[pixels[i * C + c]];
+            }
+        }
+    }
+    else {
+        for (size_t i = 0; i < count; i++) {
+            for (int c = 0; c < colorChannels; c++) {
+                pixels[i * C + c] = INX_ChannelFromFloat<T>(1.0f - INX_ChannelToFloat(pixels[i * C + c]));
+            }
+        }
+    }
+}
+
+// ============================================================================
+// INTERNAL API
+// ============================================================================
+
+INX_PixelRowKernel INX_GetPixelRowKernel(NX_PixelFormat srcFormat, NX_PixelFormat dstFormat)
+{
+    switch (srcFormat) {
+    case NX_PIXEL_FORMAT_R8:        return INX_SelectRowKernel<uint8_t, 1>(dstFormat);
+    case NX_PIXEL_FORMAT_RG8:       return INX_SelectRowKernel<uint8_t, 2>(dstFormat);
+    case NX_PIXEL_FORMAT_RGB8:      return INX_SelectRowKernel<uint8_t, 3>(dstFormat);
+    case NX_PIXEL_FORMAT_RGBA8:     return INX_SelectRowKernel<uint8_t, 4>(dstFormat);
+    case NX_PIXEL_FORMAT_R16F:      return INX_SelectRowKernel<INX_Half, 1>(dstFormat);
+    case NX_PIXEL_FORMAT_RG16F:     return INX_SelectRowKernel<INX_Half, 2>(dstFormat);
+    case NX_PIXEL_FORMAT_RGB16F:    return INX_SelectRowKernel<INX_Half, 3>(dstFormat);
+    case NX_PIXEL_FORMAT_RGBA16F:   return INX_SelectRowKernel<INX_Half, 4>(dstFormat);
+    case NX_PIXEL_FORMAT_R32F:      return INX_SelectRowKernel<float, 1>(dstFormat);
+    case NX_PIXEL_FORMAT_RG32F:     return INX_SelectRowKernel<float, 2>(dstFormat);
+    case NX_PIXEL_FORMAT_RGB32F:    return INX_SelectRowKernel<float, 3>(dstFormat);
+    case NX_PIXEL_FORMAT_RGBA32F:   return INX_SelectRowKernel<float, 4>(dstFormat);
+    case NX_PIXEL_FORMAT_INVALID:   break;
+    }
+    return nullptr;
+}
+
+bool INX_ConvertPixels(const void* src, NX_PixelFormat srcFormat, void* dst, NX_PixelFormat dstFormat, int width, int rows)
+{
+    INX_PixelRowKernel kernel = INX_GetPixelRowKernel(srcFormat, dstFormat);
+    if (kernel == nullptr || width <= 0 || rows <= 0) {
+        return false;
+    }
+
+    const size_t pixelCount = static_cast<size_t>(width) * rows;
+
+    if (pixelCount < INX_PARALLEL_PIXEL_THRESHOLD) {
+        kernel(src, dst, pixelCount);
+        return true;
+    }
+
+    /* --- Split large images by rows across the workers --- */
+
+    const size_t srcStride = static_cast<size_t>(width) * NX_GetPixelBytes(srcFormat);
+    const size_t dstStride = static_cast<size_t>(width) * NX_GetPixelBytes(dstFormat);
+    const size_t grainRows = std::max<size_t>(1, INX_PARALLEL_PIXEL_GRAIN / width);
+
+    INX_Jobs.ParallelFor(rows, grainRows, [&](size_t begin, size_t end) {
+        kernel(
+            static_cast<const uint8_t*>(src) + begin * srcStride,
+            static_cast<uint8_t*>(dst) + begin * dstStride,
+            (end - begin) * width
+        );
+    });
+
+    return true;
+}
+
+void INX_InvertPixels(void* pixels, NX_PixelFormat format, size_t count)
+{
+    void (*invert)(void*, size_t) = nullptr;
+
+    switch (format) {
+    case NX_PIXEL_FORMAT_R8:        invert = [](void* p, size_t n) { INX_InvertRow<uint8_t, 1>(static_cast<uint8_t*>(p), n); }; break;
+    case NX_PIXEL_FORMAT_RG8:       invert = [](void* p, size_t n) { INX_InvertRow<uint8_t, 2>(static_cast<uint8_t*>(p), n); }; break;
+    case NX_PIXEL_FORMAT_RGB8:      invert = [](void* p, size_t n) { INX_InvertRow<uint8_t, 3>(static_cast<uint8_t*>(p), n); }; break;
+    case NX_PIXEL_FORMAT_RGBA8:     invert = [](void* p, size_t n) { INX_InvertRow<uint8_t, 4>(static_cast<uint8_t*>(p), n); }; break;
+    case NX_PIXEL_FORMAT_R16F:      invert = [](void* p, size_t n) { INX_InvertRow<INX_Half, 1>(static_cast<INX_Half*>(p), n); }; break;
+    case NX_PIXEL_FORMAT_RG16F:     invert = [](void* p, size_t n) { INX_InvertRow<INX_Half, 2>(static_cast<INX_Half*>(p), n); }; break;
+    case NX_PIXEL_FORMAT_RGB16F:    invert = [](void* p, size_t n) { INX_InvertRow<INX_Half, 3>(static_cast<INX_Half*>(p), n); }; break;
+    case NX_PIXEL_FORMAT_RGBA16F:   invert = [](void* p, size_t n) { INX_InvertRow<INX_Half, 4>(static_cast<INX_Half*>(p), n); }; break;
+    case NX_PIXEL_FORMAT_R32F:      invert = [](void* p, size_t n) { INX_InvertRow<float, 1>(static_cast<float*>(p), n); }; break;
+    case NX_PIXEL_FORMAT_RG32F:     invert = [](void* p, size_t n) { INX_InvertRow<float, 2>(static_cast<float*>(p), n); }; break;
+    case NX_PIXEL_FORMAT_RGB32F:    invert = [](void* p, size_t n) { INX_InvertRow<float, 3>(static_cast<float*>(p), n); }; break;
+    case NX_PIXEL_FORMAT_RGBA32F:   invert = [](void* p, size_t n) { INX_InvertRow<float, 4>(static_cast<float*>(p), n); }; break;
+    case NX_PIXEL_FORMAT_INVALID:   return;
+    }
+
+    if (count < INX_PARALLEL_PIXEL_THRESHOLD) {
+        invert(pixels, count);
+        return;
+    }
+
+    const size_t bpp = NX_GetPixelBytes(format);
+
+    INX_Jobs.ParallelFor(count, INX_PARALLEL_PIXEL_GRAIN, [&](size_t begin, size_t end) {
+        invert(static_cast<uint8_t*>(pixels) + begin * bpp, end - begin);
+    });
+}
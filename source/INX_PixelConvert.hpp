@@ -0,0 +1,39 @@
+/* INX_PixelConvert.hpp -- Internal row kernels converting pixels between formats
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef INX_PIXEL_CONVERT_HPP
+#define INX_PIXEL_CONVERT_HPP
+
+#include <NX/NX_Image.h>
+#include <cstddef>
+
+// ============================================================================
+// PIXEL CONVERSION
+// ============================================================================
+
+/*
+ * One kernel is specialized for each (source, destination) pair of formats.
+ * Kernels convert whole spans of pixels and give the same results as going
+ * through 'NX_ReadPixel' and 'NX_WritePixel' for each pixel: missing color
+ * channels are zero, a missing alpha is one, 8-bit values are truncated and
+ * half floats are clamped to their finite range.
+ */
+
+/** Converts 'count' contiguous pixels, 'src' and 'dst' must not overlap */
+using INX_PixelRowKernel = void(*)(const void* src, void* dst, size_t count);
+
+/** Returns the kernel converting 'srcFormat' to 'dstFormat', null if one of them is invalid */
+INX_PixelRowKernel INX_GetPixelRowKernel(NX_PixelFormat srcFormat, NX_PixelFormat dstFormat);
+
+/** Converts 'rows' contiguous rows of 'width' pixels, large images are split across the job system */
+bool INX_ConvertPixels(const void* src, NX_PixelFormat srcFormat, void* dst, NX_PixelFormat dstFormat, int width, int rows);
+
+/** Inverts the color channels of 'count' contiguous pixels in place, alpha is left untouched */
+void INX_InvertPixels(void* pixels, NX_PixelFormat format, size_t count);
+
+#endif // INX_PIXEL_CONVERT_HPP
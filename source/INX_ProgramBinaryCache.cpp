@@ -0,0 +1,399 @@
+/* INX_ProgramBinaryCache.cpp -- Stores linked GPU programs on disk to skip their compilation on later runs
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#include "./INX_ProgramBinaryCache.hpp"
+
+#include <NX/NX_Filesystem.h>
+#include <NX/NX_DataCodec.h>
+#include <NX/NX_Log.h>
+
+#include "./Detail/Util/Memory.hpp"
+
+#include <SDL3/SDL_iostream.h>
+#include <SDL3/SDL_stdinc.h>
+
+// ============================================================================
+// PROGRAM BINARY CACHE
+// ============================================================================
+
+INX_ProgramBinaryCache INX_ProgramBinaries{};
+
+// ============================================================================
+// LOCAL FUNCTIONS
+// ============================================================================
+
+/** 64-bit FNV-1a, chained over all the data of a key */
+static uint64_t INX_HashBytes(uint64_t hash, const void* data, size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+    }
+    return hash;
+}
+
+static uint64_t INX_HashString(uint64_t hash, const char* str)
+{
+    // The length is hashed too, so consecutive strings cannot shift into each other
+    uint64_t length = str ? SDL_strlen(str) : 0;
+    hash = INX_HashBytes(hash, &length, sizeof(length));
+    return INX_HashBytes(hash, str, length);
+}
+
+static constexpr uint64_t INX_HashSeed = 0xCBF29CE484222325ull;
+
+// ============================================================================
+// DEFAULT PROVIDER
+// ============================================================================
+
+static const char* INX_GL_GetDriverString(GLenum name)
+{
+    return reinterpret_cast<const char*>(glGetString(name));
+}
+
+static int INX_GL_GetBinaryFormats(GLenum* formats, int maxCount)
+{
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &count);
+    if (count <= 0) {
+        return 0;
+    }
+
+    util::DynamicArray<GLint> all;
+    if (!all.Resize(count)) {
+        return 0;
+    }
+
+    glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, all.GetData());
+
+    for (int i = 0; i < count && i < maxCount; i++) {
+        formats[i] = static_cast<GLenum>(all[i]);
+    }
+
+    return count;
+}
+
+static GLuint INX_GL_LoadBinary(GLenum format, const void* binary, size_t size)
+{
+    GLuint program = glCreateProgram();
+    if (program == 0) {
+        return 0;
+    }
+
+    glProgramBinary(program, format, binary, static_cast<GLsizei>(size));
+
+    // A rejected binary only fails the link status, it must not be treated as a GL error
+    GLint success = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    glGetError();
+
+    if (!success) {
+        glDeleteProgram(program);
+        return 0;
+    }
+
+    return program;
+}
+
+static bool INX_GL_GetBinary(GLuint program, GLenum* format, util::DynamicArray<uint8_t>* binary)
+{
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0 || !binary->Resize(length)) {
+        return false;
+    }
+
+    GLsizei written = 0;
+    glGetProgramBinary(program, length, &written, format, binary->GetData());
+    if (written <= 0) {
+        return false;
+    }
+
+    return binary->Resize(written);
+}
+
+static void* INX_FS_ReadFile(const char* path, size_t* size)
+{
+    // PhysFS only reads from the search path, cache files are read from the write directory itself
+    const char* writeDir = NX_GetWriteDir();
+    if (writeDir == nullptr) {
+        return nullptr;
+    }
+
+    char fullPath[1024];
+    SDL_snprintf(fullPath, sizeof(fullPath), "%s/%s", writeDir, path);
+
+    return SDL_LoadFile(fullPath, size);
+}
+
+static bool INX_FS_WriteFile(const char* path, const void* data, size_t size)
+{
+    if (NX_GetWriteDir() == nullptr) {
+        return false;
+    }
+
+    if (!NX_IsDirectory(INX_ProgramBinaryCache::Directory)) {
+        NX_CreateDirectory(INX_ProgramBinaryCache::Directory);
+    }
+
+    return NX_WriteFile(path, data, size);
+}
+
+static bool INX_FS_DeleteFile(const char* path)
+{
+    return NX_GetWriteDir() != nullptr && NX_DeleteFile(path);
+}
+
+// ============================================================================
+// FILE FORMAT
+// ============================================================================
+
+bool INX_EncodeProgramBinary(util::DynamicArray<uint8_t>* file, uint64_t key, uint64_t driver,
+                             GLenum format, const void* binary, size_t size)
+{
+    if (size == 0 || size > UINT32_MAX) {
+        return false;
+    }
+
+    INX_ProgramBinaryHeader header{};
+    header.magic = INX_ProgramBinaryHeader::Magic;
+    header.version = INX_ProgramBinaryHeader::Version;
+    header.key = key;
+    header.driver = driver;
+    header.format = format;
+    header.size = static_cast<uint32_t>(size);
+    header.checksum = NX_ComputeCRC32(const_cast<void*>(binary), size);
+
+    if (!file->Resize(sizeof(header) + size)) {
+        return false;
+    }
+
+    SDL_memcpy(file->GetData(), &header, sizeof(header));
+    SDL_memcpy(file->GetData() + sizeof(header), binary, size);
+
+    return true;
+}
+
+const uint8_t* INX_DecodeProgramBinary(const void* file, size_t fileSize, uint64_t key, uint64_t driver,
+                                       GLenum* format, size_t* size)
+{
+    INX_ProgramBinaryHeader header{};
+    if (file == nullptr || fileSize < sizeof(header)) {
+        return nullptr;
+    }
+
+    SDL_memcpy(&header, file, sizeof(header));
+
+    if (header.magic != INX_ProgramBinaryHeader::Magic || header.version != INX_ProgramBinaryHeader::Version) {
+        return nullptr;
+    }
+
+    if (header.key != key || header.driver != driver) {
+        return nullptr;
+    }
+
+    if (header.size == 0 || header.size != fileSize - sizeof(header)) {
+        return nullptr;
+    }
+
+    uint8_t* binary = static_cast<uint8_t*>(const_cast<void*>(file)) + sizeof(header);
+    if (NX_ComputeCRC32(binary, header.size) != header.checksum) {
+        return nullptr;
+    }
+
+    *format = header.format;
+    *size = header.size;
+
+    return binary;
+}
+
+// ============================================================================
+// PUBLIC FUNCTIONS
+// ============================================================================
+
+void INX_ProgramBinaryCache::Init(const INX_ProgramBinaryProvider& provider)
+{
+    *this = INX_ProgramBinaryCache{};
+    mProvider = provider;
+
+    int formatCount = mProvider.getBinaryFormats(mFormats, MaxFormats);
+    mFormatCount = NX_MIN(formatCount, MaxFormats);
+
+    if (mFormatCount <= 0) {
+        NX_LOG(D, "RENDER: Program binaries are not supported by the driver; Program cache disabled");
+        return;
+    }
+
+    uint64_t hash = INX_HashSeed;
+    hash = INX_HashString(hash, mProvider.getDriverString(GL_VENDOR));
+    hash = INX_HashString(hash, mProvider.getDriverString(GL_RENDERER));
+    hash = INX_HashString(hash, mProvider.getDriverString(GL_VERSION));
+    hash = INX_HashBytes(hash, mFormats, mFormatCount * sizeof(GLenum));
+
+    mDriverHash = hash;
+    mEnabled = true;
+}
+
+void INX_ProgramBinaryCache::Quit()
+{
+    if (mEnabled) {
+        NX_LOG(D, "RENDER: Program cache; %i hits, %i misses, %i invalidated, %i rejected, %i stored",
+            mStats.hits, mStats.misses, mStats.invalidated, mStats.rejected, mStats.stored);
+    }
+
+    *this = INX_ProgramBinaryCache{};
+}
+
+bool INX_ProgramBinaryCache::IsEnabled() const
+{
+    return mEnabled;
+}
+
+uint64_t INX_ProgramBinaryCache::GetDriverHash() const
+{
+    return mDriverHash;
+}
+
+const INX_ProgramBinaryCache::Stats& INX_ProgramBinaryCache::GetStats() const
+{
+    return mStats;
+}
+
+uint64_t INX_ProgramBinaryCache::ComputeKey(std::initializer_list<const INX_ProgramStage*> stages) const
+{
+    uint64_t hash = INX_HashSeed;
+
+    for (const INX_ProgramStage* stage : stages) {
+        // The built source already contains the version directive and the defines
+        GLenum type = stage->GetStage();
+        hash = INX_HashBytes(hash, &type, sizeof(type));
+        hash = INX_HashString(hash, stage->GetSource().c_str());
+    }
+
+    return hash;
+}
+
+GLuint INX_ProgramBinaryCache::Load(uint64_t key)
+{
+    if (!mEnabled) {
+        return 0;
+    }
+
+    char path[64];
+    GetFilePath(path, sizeof(path), key);
+
+    size_t fileSize = 0;
+    util::UniquePtr<uint8_t> file(static_cast<uint8_t*>(mProvider.readFile(path, &fileSize)));
+    if (!file) {
+        mStats.misses++;
+        return 0;
+    }
+
+    /* --- Check the file, written by another driver or engine version, or damaged --- */
+
+    GLenum format{};
+    size_t size{};
+
+    const uint8_t* binary = INX_DecodeProgramBinary(file.get(), fileSize, key, mDriverHash, &format, &size);
+    if (binary == nullptr || !IsFormatSupported(format)) {
+        mProvider.deleteFile(path);
+        mStats.invalidated++;
+        mStats.misses++;
+        return 0;
+    }
+
+    /* --- Give the binary back to the driver --- */
+
+    GLuint program = mProvider.loadBinary(format, binary, size);
+    if (program == 0) {
+        NX_LOG(D, "RENDER: Program binary '%s' rejected by the driver; Compiling it again", path);
+        mProvider.deleteFile(path);
+        mStats.rejected++;
+        mStats.misses++;
+        return 0;
+    }
+
+    mStats.hits++;
+
+    return program;
+}
+
+bool INX_ProgramBinaryCache::Store(uint64_t key, GLuint program)
+{
+    if (!mEnabled || program == 0) {
+        return false;
+    }
+
+    GLenum format{};
+    util::DynamicArray<uint8_t> binary;
+
+    if (!mProvider.getBinary(program, &format, &binary) || !IsFormatSupported(format)) {
+        return false;
+    }
+
+    util::DynamicArray<uint8_t> file;
+    if (!INX_EncodeProgramBinary(&file, key, mDriverHash, format, binary.GetData(), binary.GetSize())) {
+        return false;
+    }
+
+    char path[64];
+    GetFilePath(path, sizeof(path), key);
+
+    if (!mProvider.writeFile(path, file.GetData(), file.GetSize())) {
+        return false;
+    }
+
+    mStats.stored++;
+
+    return true;
+}
+
+bool INX_ProgramBinaryCache::FinishProgram(gpu::Program* program, uint64_t key)
+{
+    if (!program->FinishLink()) {
+        return false;
+    }
+
+    if (key != 0) {
+        Store(key, program->GetID());
+    }
+
+    return true;
+}
+
+const INX_ProgramBinaryProvider& INX_ProgramBinaryCache::GetDefaultProvider()
+{
+    static constexpr INX_ProgramBinaryProvider provider = {
+        .getDriverString = INX_GL_GetDriverString,
+        .getBinaryFormats = INX_GL_GetBinaryFormats,
+        .loadBinary = INX_GL_LoadBinary,
+        .getBinary = INX_GL_GetBinary,
+        .readFile = INX_FS_ReadFile,
+        .writeFile = INX_FS_WriteFile,
+        .deleteFile = INX_FS_DeleteFile
+    };
+
+    return provider;
+}
+
+// ============================================================================
+// PRIVATE FUNCTIONS
+// ============================================================================
+
+void INX_ProgramBinaryCache::GetFilePath(char* path, size_t pathSize, uint64_t key)
+{
+    SDL_snprintf(path, pathSize, "%s/%016llx.bin", Directory, static_cast<unsigned long long>(key));
+}
+
+bool INX_ProgramBinaryCache::IsFormatSupported(GLenum format) const
+{
+    for (int i = 0; i < mFormatCount; i++) {
+        if (mFormats[i] == format) return true;
+    }
+    return false;
+}
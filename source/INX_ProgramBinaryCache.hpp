@@ -0,0 +1,273 @@
+/* INX_ProgramBinaryCache.hpp -- Stores linked GPU programs on disk to skip their compilation on later runs
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef INX_PROGRAM_BINARY_CACHE_HPP
+#define INX_PROGRAM_BINARY_CACHE_HPP
+
+#include "./Detail/Util/DynamicArray.hpp"
+#include "./Detail/GPU/Program.hpp"
+#include "./Detail/GPU/Shader.hpp"
+
+#include <initializer_list>
+#include <type_traits>
+#include <cstdint>
+#include <string>
+
+// ============================================================================
+// PROGRAM STAGE
+// ============================================================================
+
+/**
+ * Source of one stage of a program, built as it is given to the driver.
+ *
+ * The shader is only compiled when a program using the stage is missing from
+ * the cache, it is then shared by every program built from the same stage.
+ */
+class INX_ProgramStage {
+public:
+    INX_ProgramStage() = default;
+    INX_ProgramStage(GLenum stage, const char* source, std::initializer_list<const char*> defines = {});
+
+    /** Getters */
+    bool IsValid() const;
+    GLenum GetStage() const;
+    const std::string& GetSource() const;
+
+    /** Compiles the shader on first use */
+    const gpu::Shader& GetShader() const;
+
+private:
+    std::string mSource{};
+    GLenum mStage{};
+    mutable gpu::Shader mShader{};
+};
+
+inline INX_ProgramStage::INX_ProgramStage(GLenum stage, const char* source, std::initializer_list<const char*> defines)
+    : mSource(gpu::Shader::BuildSource(source, defines))
+    , mStage(stage)
+{ }
+
+inline bool INX_ProgramStage::IsValid() const
+{
+    return !mSource.empty();
+}
+
+inline GLenum INX_ProgramStage::GetStage() const
+{
+    return mStage;
+}
+
+inline const std::string& INX_ProgramStage::GetSource() const
+{
+    return mSource;
+}
+
+inline const gpu::Shader& INX_ProgramStage::GetShader() const
+{
+    if (!mShader.IsValid()) {
+        mShader = gpu::Shader(mStage, mSource);
+    }
+    return mShader;
+}
+
+// ============================================================================
+// FILE FORMAT
+// ============================================================================
+
+/**
+ * Header of a cache file, directly followed by the binary returned by the driver.
+ * Every field is checked before the binary is given back to the driver.
+ */
+struct INX_ProgramBinaryHeader {
+    static constexpr uint32_t Magic = 0x4250584E;   //< "NXPB"
+    static constexpr uint32_t Version = 1;
+
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;           //< Hash of the program sources, also gives the file name
+    uint64_t driver;        //< Hash of the driver identity
+    uint32_t format;        //< Binary format reported by the driver
+    uint32_t size;          //< Size of the binary in bytes
+    uint32_t checksum;      //< CRC32 of the binary
+    uint32_t reserved;
+};
+
+/** Writes a complete cache file in 'file' */
+bool INX_EncodeProgramBinary(util::DynamicArray<uint8_t>* file, uint64_t key, uint64_t driver,
+                             GLenum format, const void* binary, size_t size);
+
+/** Returns the binary stored in 'file', or nullptr if the file does not match this key and driver */
+const uint8_t* INX_DecodeProgramBinary(const void* file, size_t fileSize, uint64_t key, uint64_t driver,
+                                       GLenum* format, size_t* size);
+
+// ============================================================================
+// BINARY PROVIDER
+// ============================================================================
+
+/**
+ * Functions used by the cache to exchange binaries with the driver and the disk.
+ *
+ * The default provider uses OpenGL and the write directory of NX_Filesystem.
+ * Another one can be given to exercise the cache without any GPU.
+ */
+struct INX_ProgramBinaryProvider {
+    /** Returns the GL_VENDOR, GL_RENDERER or GL_VERSION string of the driver */
+    const char* (*getDriverString)(GLenum name);
+
+    /** Writes up to 'maxCount' supported binary formats and returns the total count */
+    int (*getBinaryFormats)(GLenum* formats, int maxCount);
+
+    /** Creates a linked program from a binary, returns 0 if the driver rejects it */
+    GLuint (*loadBinary)(GLenum format, const void* binary, size_t size);
+
+    /** Retrieves the binary of a linked program, returns false if the driver cannot provide it */
+    bool (*getBinary)(GLuint program, GLenum* format, util::DynamicArray<uint8_t>* binary);
+
+    /** Accesses cache files, the data returned by 'readFile' is released with NX_Free() */
+    void* (*readFile)(const char* path, size_t* size);
+    bool (*writeFile)(const char* path, const void* data, size_t size);
+    bool (*deleteFile)(const char* path);
+};
+
+// ============================================================================
+// PROGRAM BINARY CACHE
+// ============================================================================
+
+/**
+ * @brief On-disk cache of linked GPU programs.
+ *
+ * A program is found by the hash of the built sources of its stages, which
+ * contain the version directive and the defines. Its file also records the
+ * driver identity (vendor, renderer, version and binary formats) and the
+ * binary format, so a binary is only reused by the driver that produced it.
+ *
+ * Files that do not match the program or the driver, that are truncated or
+ * damaged, as well as binaries rejected by the driver, are deleted and the
+ * program is compiled again. Its new binary then takes the same file, so a
+ * driver update replaces the entries instead of accumulating stale ones.
+ */
+class INX_ProgramBinaryCache {
+public:
+    static constexpr const char* Directory = "shader_cache";
+    static constexpr int MaxFormats = 8;
+
+    struct Stats {
+        int hits;           //< Programs created from a binary
+        int misses;         //< Programs that had to be compiled
+        int invalidated;    //< Files deleted because they no longer matched
+        int rejected;       //< Binaries refused by the driver
+        int stored;         //< Files written
+    };
+
+public:
+    /** Lifetime, the cache stays disabled if the driver supports no binary format */
+    void Init(const INX_ProgramBinaryProvider& provider);
+    void Quit();
+
+    /** Getters */
+    bool IsEnabled() const;
+    uint64_t GetDriverHash() const;
+    const Stats& GetStats() const;
+
+    /** Returns the key of a program made of these stages, from their built sources */
+    uint64_t ComputeKey(std::initializer_list<const INX_ProgramStage*> stages) const;
+
+    /** Returns a program created from its cached binary, 0 if it is missing or no longer valid */
+    GLuint Load(uint64_t key);
+
+    /** Stores the binary of a program linked from the stages of 'key' */
+    bool Store(uint64_t key, GLuint program);
+
+    /** Loads a program from the cache, or compiles and stores it */
+    template <typename... Stages>
+    gpu::Program CreateProgram(const Stages&... stages);
+
+    /**
+     * Loads a program from the cache, or starts its link without waiting for the driver.
+     * A started link must be completed with FinishProgram(), given the same 'key'.
+     * The key is set to 0 when the program is already complete.
+     */
+    template <typename... Stages>
+    gpu::Program BeginProgram(uint64_t* key, const Stages&... stages);
+
+    /** Completes a program returned by BeginProgram() and stores it, returns false if it failed */
+    bool FinishProgram(gpu::Program* program, uint64_t key);
+
+    /** Returns the default provider, based on OpenGL and NX_Filesystem */
+    static const INX_ProgramBinaryProvider& GetDefaultProvider();
+
+private:
+    static void GetFilePath(char* path, size_t pathSize, uint64_t key);
+    bool IsFormatSupported(GLenum format) const;
+
+private:
+    INX_ProgramBinaryProvider mProvider{};
+    GLenum mFormats[MaxFormats]{};
+    int mFormatCount{};
+    uint64_t mDriverHash{};
+    Stats mStats{};
+    bool mEnabled{};
+};
+
+extern INX_ProgramBinaryCache INX_ProgramBinaries;
+
+// ============================================================================
+// TEMPLATE IMPLEMENTATION
+// ============================================================================
+
+template <typename... Stages>
+gpu::Program INX_ProgramBinaryCache::CreateProgram(const Stages&... stages)
+{
+    static_assert((std::is_same_v<Stages, INX_ProgramStage> && ...), "Programs are created from INX_ProgramStage");
+
+    if (!mEnabled) {
+        return gpu::Program(stages.GetShader()...);
+    }
+
+    uint64_t key = ComputeKey({&stages...});
+
+    if (GLuint id = Load(key)) {
+        gpu::Program program(id);
+        if (program.IsValid()) {
+            return program;
+        }
+    }
+
+    gpu::Program program(stages.GetShader()...);
+    if (program.IsValid()) {
+        Store(key, program.GetID());
+    }
+
+    return program;
+}
+
+template <typename... Stages>
+gpu::Program INX_ProgramBinaryCache::BeginProgram(uint64_t* key, const Stages&... stages)
+{
+    static_assert((std::is_same_v<Stages, INX_ProgramStage> && ...), "Programs are created from INX_ProgramStage");
+
+    *key = 0;
+
+    if (mEnabled) {
+        uint64_t programKey = ComputeKey({&stages...});
+        if (GLuint id = Load(programKey)) {
+            gpu::Program program(id);
+            if (program.IsValid()) {
+                return program;
+            }
+        }
+        *key = programKey;
+    }
+
+    gpu::Program program;
+    program.BeginLink({gpu::Program::Source{stages.GetStage(), stages.GetSource().c_str()}...});
+
+    return program;
+}
+
+#endif // INX_PROGRAM_BINARY_CACHE_HPP
@@ -72,7 +72,7 @@ public:
 
 public:
     /** Get all currently bound textures */
-    const TextureArray& GetTextures();
+    const TextureArray& GetTextures() const;
     
     /** Bind a texture to a specific sampler slot */
     void SetTexture(int slot, const NX_Texture* texture);
@@ -146,7 +146,7 @@ protected:
 /* === Public Implementation === */
 
 template <typename Derived>
-const INX_Shader<Derived>::TextureArray& INX_Shader<Derived>::GetTextures()
+const INX_Shader<Derived>::TextureArray& INX_Shader<Derived>::GetTextures() const
 {
     return mBindedTextures;
 }
@@ -259,7 +259,7 @@ void INX_Shader<Derived>::BindTextures(const gpu::Pipeline& pipeline, const Text
 {
     for (int i = 0; i < SAMPLER_COUNT; i++) {
         if (mSamplerExists[i]) {
-            const gpu::Texture& tex = INX_Assets.Select(textures[i], INX_TextureAsset::WHITE)->gpu;
+            const gpu::Texture& tex = INX_GetTextureGPU(INX_Assets.Select(textures[i], INX_TextureAsset::WHITE));
             pipeline.BindTexture(SamplerBinding[i], tex);
         }
     }
@@ -0,0 +1,142 @@
+/* INX_Sprite2D.hpp -- Internal implementation details for packing 2D sprite instances
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef INX_SPRITE_2D_HPP
+#define INX_SPRITE_2D_HPP
+
+#include <NX/NX_Render2D.h>
+#include <NX/NX_Math.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+
+// ============================================================================
+// INTERNAL TYPES
+// ============================================================================
+
+/**
+ * Instance record read by 'sprite.vert', matches its std430 'Sprite' struct.
+ * Replaces the four vertices and six indices (140 bytes) of a batched quad.
+ */
+struct INX_SpriteInstance2D {
+    NX_Vec2 position;           //< Center of the sprite, transform applied
+    NX_Vec2 size;               //< Negative height when the transform mirrors the sprite
+    float rotation;             //< Radians, transform rotation included
+    uint32_t color;             //< RGBA8, unpacked with 'unpackUnorm4x8'
+    uint32_t uvMin;             //< Unorm16x2, unpacked with 'unpackUnorm2x16'
+    uint32_t uvMax;             //< Unorm16x2, unpacked with 'unpackUnorm2x16'
+};
+
+static_assert(sizeof(INX_SpriteInstance2D) == 32, "Must match the std430 layout of 'Sprite'");
+
+/**
+ * Decomposition of the current 2D transform, computed once per batch of sprites.
+ * A sprite can only be expressed as an instance if the transform keeps it a
+ * rotated rectangle: either the transform is a similarity (rotation, uniform
+ * scale, mirroring), or its axes are orthogonal and the sprite is not rotated.
+ */
+struct INX_SpriteTransform2D {
+    NX_Mat3 matrix;
+    NX_Vec2 scale;              //< Length of the transformed axes
+    float rotation;             //< Angle of the transformed X axis
+    float mirror;               //< -1 if the transform mirrors, 1 otherwise
+    bool identity;              //< Only a translation, the fast path
+    bool orthogonal;            //< Axes remain perpendicular
+    bool similar;               //< Axes remain perpendicular and of the same length
+};
+
+// ============================================================================
+// INTERNAL FUNCTIONS
+// ============================================================================
+
+inline uint32_t INX_PackUnorm2x16(float x, float y)
+{
+    uint32_t ux = static_cast<uint32_t>(std::clamp(x, 0.0f, 1.0f) * 65535.0f + 0.5f);
+    uint32_t uy = static_cast<uint32_t>(std::clamp(y, 0.0f, 1.0f) * 65535.0f + 0.5f);
+    return ux | (uy << 16);
+}
+
+inline uint32_t INX_PackUnorm4x8(NX_Color color)
+{
+    uint32_t r = static_cast<uint32_t>(std::clamp(color.r, 0.0f, 1.0f) * 255.0f + 0.5f);
+    uint32_t g = static_cast<uint32_t>(std::clamp(color.g, 0.0f, 1.0f) * 255.0f + 0.5f);
+    uint32_t b = static_cast<uint32_t>(std::clamp(color.b, 0.0f, 1.0f) * 255.0f + 0.5f);
+    uint32_t a = static_cast<uint32_t>(std::clamp(color.a, 0.0f, 1.0f) * 255.0f + 0.5f);
+    return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+inline INX_SpriteTransform2D INX_MakeSpriteTransform2D(const NX_Mat3& matrix)
+{
+    constexpr float epsilon = 1e-4f;
+
+    INX_SpriteTransform2D transform{};
+    transform.matrix = matrix;
+
+    // Images of the X and Y axes, see 'NX_Vec2TransformByMat3'
+    const NX_Vec2 xAxis = NX_VEC2(matrix.m00, matrix.m01);
+    const NX_Vec2 yAxis = NX_VEC2(matrix.m10, matrix.m11);
+
+    transform.identity = (xAxis.x == 1.0f && xAxis.y == 0.0f && yAxis.x == 0.0f && yAxis.y == 1.0f);
+    if (transform.identity) {
+        transform.scale = NX_VEC2(1.0f, 1.0f);
+        transform.mirror = 1.0f;
+        transform.orthogonal = transform.similar = true;
+        return transform;
+    }
+
+    transform.scale = NX_VEC2(std::sqrt(xAxis.x * xAxis.x + xAxis.y * xAxis.y), std::sqrt(yAxis.x * yAxis.x + yAxis.y * yAxis.y));
+    transform.rotation = std::atan2(xAxis.y, xAxis.x);
+    transform.mirror = (xAxis.x * yAxis.y - xAxis.y * yAxis.x < 0.0f) ? -1.0f : 1.0f;
+
+    const float dot = xAxis.x * yAxis.x + xAxis.y * yAxis.y;
+    const float maxScale = std::max(transform.scale.x, transform.scale.y);
+
+    transform.orthogonal = (std::fabs(dot) <= epsilon * transform.scale.x * transform.scale.y);
+    transform.similar = transform.orthogonal && (std::fabs(transform.scale.x - transform.scale.y) <= epsilon * maxScale);
+
+    return transform;
+}
+
+inline bool INX_CanPackSprite2D(const INX_SpriteTransform2D& transform, const NX_Sprite2D& sprite)
+{
+    // The UV rect is stored as unorm16, regions outside of the texture (repeating or
+    // mirrored wraps) would be clamped and must keep the texcoords of a regular quad
+    const NX_Vec4& uv = sprite.uvRect;
+    const float u1 = uv.x + uv.z, v1 = uv.y + uv.w;
+    const bool uvInRange = (uv.x >= 0.0f && uv.x <= 1.0f && uv.y >= 0.0f && uv.y <= 1.0f)
+                        && (u1 >= 0.0f && u1 <= 1.0f && v1 >= 0.0f && v1 <= 1.0f);
+
+    return uvInRange && (transform.similar || (transform.orthogonal && sprite.rotation == 0.0f));
+}
+
+inline void INX_PackSprite2D(INX_SpriteInstance2D* out, const NX_Sprite2D& sprite, const INX_SpriteTransform2D& transform)
+{
+    const NX_Vec4& uv = sprite.uvRect;
+    const bool wholeTexture = (uv.z == 0.0f && uv.w == 0.0f);
+
+    out->color = INX_PackUnorm4x8(sprite.color);
+    out->uvMin = wholeTexture ? 0x00000000u : INX_PackUnorm2x16(uv.x, uv.y);
+    out->uvMax = wholeTexture ? 0xFFFFFFFFu : INX_PackUnorm2x16(uv.x + uv.z, uv.y + uv.w);
+
+    if (transform.identity) {
+        out->position = NX_VEC2(sprite.position.x + transform.matrix.m20, sprite.position.y + transform.matrix.m21);
+        out->size = sprite.size;
+        out->rotation = sprite.rotation;
+        return;
+    }
+
+    // M * R(r) * S = R(t) * diag(sx, m * sy) * R(m * r) * S, where the last rotation commutes
+    // with the scale for similarities, and is the identity for unrotated sprites
+
+    out->position = sprite.position * transform.matrix;
+    out->size = NX_VEC2(sprite.size.x * transform.scale.x, sprite.size.y * transform.scale.y * transform.mirror);
+    out->rotation = transform.rotation + transform.mirror * sprite.rotation;
+}
+
+#endif // INX_SPRITE_2D_HPP
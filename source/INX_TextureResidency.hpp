@@ -0,0 +1,92 @@
+/* INX_TextureResidency.hpp -- Internal implementation details for bindless material textures
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef INX_TEXTURE_RESIDENCY_HPP
+#define INX_TEXTURE_RESIDENCY_HPP
+
+#include <NX/NX_Material.h>
+
+#include "./INX_MaterialArrays.hpp"
+#include "./INX_GlobalAssets.hpp"
+#include "./INX_DrawPacking.hpp"
+#include "./NX_Shader3D.hpp"
+#include "./NX_Texture.hpp"
+
+// ============================================================================
+// MATERIAL TEXTURE RESIDENCY
+// ============================================================================
+
+/*
+ * When GL_ARB_bindless_texture is available, the four material textures of each
+ * draw call are made resident and their handles are stored in its unique record.
+ * The scene shaders then build their samplers from these handles, so draw calls
+ * that only differ by their textures share the same bindings.
+ *
+ * Without support, shaders that don't sample the material textures by name in
+ * their user code read them from texture arrays, see INX_MaterialArrays, and the
+ * record stores the layer of each texture instead. Other shaders get zeros and
+ * their textures are bound per draw call.
+ *
+ * Handles and layers are resolved on the GL thread when the records are packed,
+ * as textures can be replaced or moved until then.
+ */
+
+/** Whether material textures are sampled through bindless handles */
+inline bool INX_IsMaterialBindless()
+{
+    return gpu::Texture::HasBindless();
+}
+
+/** Whether the material textures are sampled from the material arrays */
+inline bool INX_IsMaterialArrayed(const NX_Material& material)
+{
+    return INX_Assets.Select(material.shader, INX_Shader3DAsset::DEFAULT)->UsesMaterialArrays();
+}
+
+/** Changes each time the stored handles or layers must be resolved again */
+inline uint32_t INX_GetMaterialTextureGeneration()
+{
+    return gpu::Texture::GetBindlessGeneration() + INX_MaterialArrays.GetGeneration();
+}
+
+/** Makes the material textures resident or gives them their array layers, must be called from the GL thread */
+inline INX_MaterialHandles INX_ResolveMaterialTextures(const NX_Material& material)
+{
+    const NX_Texture* albedo = INX_Assets.Select(material.albedo.texture, INX_TextureAsset::WHITE);
+    const NX_Texture* emission = INX_Assets.Select(material.emission.texture, INX_TextureAsset::WHITE);
+    const NX_Texture* orm = INX_Assets.Select(material.orm.texture, INX_TextureAsset::WHITE);
+    const NX_Texture* normal = INX_Assets.Select(material.normal.texture, INX_TextureAsset::NORMAL);
+
+    if (INX_IsMaterialBindless()) {
+        return INX_MaterialHandles {
+            albedo->gpu.MakeResident(),
+            emission->gpu.MakeResident(),
+            orm->gpu.MakeResident(),
+            normal->gpu.MakeResident()
+        };
+    }
+
+    if (INX_IsMaterialArrayed(material)) {
+        return INX_MaterialHandles {
+            INX_MaterialArrays.Resolve(*albedo),
+            INX_MaterialArrays.Resolve(*emission),
+            INX_MaterialArrays.Resolve(*orm),
+            INX_MaterialArrays.Resolve(*normal)
+        };
+    }
+
+    return INX_MaterialHandles{};
+}
+
+/** Texture bound for a material texture, its array when the material samples the arrays */
+inline const gpu::Texture& INX_GetMaterialTexture(const NX_Texture* texture, bool arrayed)
+{
+    return arrayed ? INX_MaterialArrays.GetArray(*texture) : INX_GetTextureGPU(texture);
+}
+
+#endif // INX_TEXTURE_RESIDENCY_HPP
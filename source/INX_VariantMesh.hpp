@@ -35,6 +35,8 @@ public:
     NX_ShadowFaceMode GetShadowFaceMode() const;
     const NX_BoundingBox3D& GetAABB() const;
     NX_Layer GetLayerMask() const;
+    NX_VertexBuffer3D* GetBuffer() const;
+    NX_PrimitiveType GetPrimitiveType() const;
 
 private:
     std::variant<const NX_Mesh*, const NX_DynamicMesh*> mMesh;
@@ -112,4 +114,22 @@ inline NX_Layer INX_VariantMesh::GetLayerMask() const
     }
 }
 
+inline NX_VertexBuffer3D* INX_VariantMesh::GetBuffer() const
+{
+    switch (mMesh.index()) {
+    case 0: [[likely]] return std::get<0>(mMesh)->buffer;
+    case 1: [[unlikely]] return std::get<1>(mMesh)->buffer;
+    default: NX_UNREACHABLE(); break;
+    }
+}
+
+inline NX_PrimitiveType INX_VariantMesh::GetPrimitiveType() const
+{
+    switch (mMesh.index()) {
+    case 0: [[likely]] return std::get<0>(mMesh)->primitiveType;
+    case 1: [[unlikely]] return std::get<1>(mMesh)->primitiveType;
+    default: NX_UNREACHABLE(); break;
+    }
+}
+
 #endif // INX_VARIANT_MESH_HPP
@@ -6,6 +6,7 @@
 
 #include "./TextureLoader.hpp"
 #include "./SceneImporter.hpp"
+#include "./ModelData.hpp"
 #include "./AssimpHelper.hpp"
 
 #include <assimp/GltfMaterial.h>
@@ -21,12 +22,12 @@ public:
     /** Constructors */
     MaterialImporter(const SceneImporter& importer);
 
-    /** Loads the materials and stores them in the specified model */
-    bool LoadMaterials(NX_Model* model);
+    /** Loads the materials and the images of their maps, their textures are created on upload */
+    bool LoadMaterials(ModelData* model);
 
 private:
     /** Loads a material into memory */
-    void LoadMaterial(NX_Material* material, int index);
+    void LoadMaterial(ModelData::Material* material, int index);
 
 private:
     const SceneImporter& mImporter;
@@ -41,16 +42,16 @@ inline MaterialImporter::MaterialImporter(const SceneImporter& importer)
     SDL_assert(importer.IsValid());
 }
 
-inline bool MaterialImporter::LoadMaterials(NX_Model* model)
+inline bool MaterialImporter::LoadMaterials(ModelData* model)
 {
-    model->materialCount = mImporter.GetMaterialCount();
-    model->materials = NX_Malloc<NX_Material>(model->materialCount);
-    if (model->materials == nullptr) {
+    if (!model->materials.Resize(mImporter.GetMaterialCount())) {
         NX_LOG(E, "RENDER: Unable to allocate memory for materials; The model will be invalid");
         return false;
     }
 
-    for (size_t i = 0; i < model->materialCount; i++) {
+    mTextureLoader.LoadImages(model);
+
+    for (size_t i = 0; i < model->materials.GetSize(); i++) {
         LoadMaterial(&model->materials[i], i);
     }
 
@@ -59,17 +60,27 @@ inline bool MaterialImporter::LoadMaterials(NX_Model* model)
 
 /* === Private Material === */
 
-inline void MaterialImporter::LoadMaterial(NX_Material* material, int index)
+inline void MaterialImporter::LoadMaterial(ModelData::Material* data, int index)
 {
     const aiMaterial* aiMat = mImporter.GetMaterial(index);
+    NX_Material* material = &data->material;
+
+    // Maps sharing the texture of another one have a key but no image
+    auto hasImage = [data](ModelData::Map map) {
+        return data->images[map].key != 0;
+    };
 
     /* --- Initialize material defaults --- */
 
     *material = NX_GetDefaultMaterial();
 
-    /* --- Load albedo map --- */
+    // Textures are only created by the upload steps, the model owns them
+    material->albedo.texture = nullptr;
+    material->emission.texture = nullptr;
+    material->orm.texture = nullptr;
+    material->normal.texture = nullptr;
 
-    material->albedo.texture = mTextureLoader.Get(index, TextureLoader::MAP_ALBEDO);
+    /* --- Load albedo map --- */
 
     aiColor4D color;
     if (aiMat->Get(AI_MATKEY_BASE_COLOR, color) == AI_SUCCESS) {
@@ -97,8 +108,7 @@ inline void MaterialImporter::LoadMaterial(NX_Material* material, int index)
 
     /* --- Load emission map --- */
 
-    material->emission.texture = mTextureLoader.Get(index, TextureLoader::MAP_EMISSION);
-    if (material->emission.texture != nullptr) {
+    if (hasImage(ModelData::MAP_EMISSION)) {
         material->emission.energy = 1.0f;
     }
 
@@ -110,8 +120,6 @@ inline void MaterialImporter::LoadMaterial(NX_Material* material, int index)
 
     /* --- Load ORM map --- */
 
-    material->orm.texture = mTextureLoader.Get(index, TextureLoader::MAP_ORM);
-
     float roughness;
     if (aiMat->Get(AI_MATKEY_ROUGHNESS_FACTOR, roughness) == AI_SUCCESS) {
         material->orm.roughness = roughness;
@@ -124,8 +132,7 @@ inline void MaterialImporter::LoadMaterial(NX_Material* material, int index)
 
     /* --- Load normal map --- */
 
-    material->normal.texture = mTextureLoader.Get(index, TextureLoader::MAP_NORMAL);
-    if (material->normal.texture != nullptr) {
+    if (hasImage(ModelData::MAP_NORMAL)) {
         float normalScale;
         if (aiMat->Get(AI_MATKEY_BUMPSCALING, normalScale) == AI_SUCCESS) {
             material->normal.scale = normalScale;
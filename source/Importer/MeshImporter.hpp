@@ -5,6 +5,7 @@
 
 #include "./SceneImporter.hpp"
 #include "./AssimpHelper.hpp"
+#include "./ModelData.hpp"
 #include "NX/NX_Mesh.h"
 #include "NX/NX_MeshData.h"
 
@@ -21,16 +22,16 @@ public:
     /** Constructors */
     MeshImporter(const SceneImporter& importer);
 
-    /** Loads the meshes and stores them in the specified model */
-    bool LoadMeshes(NX_Model* model);
+    /** Builds the data of every mesh, their GPU meshes are created on upload */
+    bool LoadMeshes(ModelData* model);
 
 private:
     /** Iterate through all nodes to load meshes */
-    bool LoadRecursive(NX_Model* model, const aiNode* node, const NX_Mat4& parentTransform);
+    bool LoadRecursive(ModelData* model, const aiNode* node, const NX_Mat4& parentTransform);
 
     /** Loads a mesh into memory */
     template <bool HasBones>
-    NX_Mesh* LoadMesh(const aiMesh* mesh, const NX_Mat4& transform);
+    bool LoadMesh(ModelData::Mesh* result, const aiMesh* mesh, const NX_Mat4& transform);
 
 private:
     const SceneImporter& mImporter;
@@ -44,38 +45,39 @@ inline MeshImporter::MeshImporter(const SceneImporter& importer)
     SDL_assert(importer.IsValid());
 }
 
-inline bool MeshImporter::LoadMeshes(NX_Model* model)
+inline bool MeshImporter::LoadMeshes(ModelData* model)
 {
-    model->meshCount = mImporter.GetScene()->mNumMeshes;
+    const int meshCount = mImporter.GetScene()->mNumMeshes;
 
-    model->meshes = static_cast<NX_Mesh**>(SDL_calloc(model->meshCount, sizeof(NX_Mesh*)));
-    if (model->meshes == nullptr) {
+    if (!model->meshes.Resize(meshCount)) {
         NX_LOG(E, "RENDER: Unable to allocate memory for meshes; The model will be invalid");
         return false;
     }
 
-    model->meshMaterials = static_cast<int*>(SDL_calloc(model->meshCount, sizeof(int)));
-    if (model->meshMaterials == nullptr) {
+    if (!model->meshMaterials.Resize(meshCount)) {
         NX_LOG(E, "RENDER: Unable to allocate memory for mesh materials array; The model will be invalid");
-        SDL_free(model->meshes);
         return false;
     }
 
+    for (int i = 0; i < meshCount; i++) {
+        model->meshes[i] = ModelData::Mesh{};
+        model->meshMaterials[i] = 0;
+    }
+
     if (!LoadRecursive(model, mImporter.GetRootNode(), NX_MAT4_IDENTITY)) {
-        for (int i = 0; i < model->meshCount; i++) {
-            NX_DestroyMesh(model->meshes[i]);
-        }
-        SDL_free(model->meshMaterials);
-        SDL_free(model->meshes);
         return false;
     }
 
     model->aabb.min = NX_VEC3(+FLT_MAX, +FLT_MAX, +FLT_MAX);
     model->aabb.max = NX_VEC3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
 
-    for (int i = 0; i < model->meshCount; ++i) {
-        model->aabb.min = NX_Vec3Min(model->aabb.min, model->meshes[i]->aabb.min);
-        model->aabb.max = NX_Vec3Max(model->aabb.max, model->meshes[i]->aabb.max);
+    for (int i = 0; i < meshCount; ++i) {
+        if (model->meshes[i].data.vertices == nullptr) {
+            NX_LOG(E, "RENDER: Mesh [%d] is not referenced by the scene; The model will be invalid", i);
+            return false;
+        }
+        model->aabb.min = NX_Vec3Min(model->aabb.min, model->meshes[i].aabb.min);
+        model->aabb.max = NX_Vec3Max(model->aabb.max, model->meshes[i].aabb.max);
     }
 
     return true;
@@ -83,7 +85,7 @@ inline bool MeshImporter::LoadMeshes(NX_Model* model)
 
 /* === Private Implementation === */
 
-inline bool MeshImporter::LoadRecursive(NX_Model* model, const aiNode* node, const NX_Mat4& parentTransform)
+inline bool MeshImporter::LoadRecursive(ModelData* model, const aiNode* node, const NX_Mat4& parentTransform)
 {
     NX_Mat4 localTransform = AssimpCast<NX_Mat4>(node->mTransformation);
     NX_Mat4 globalTransform = NX_Mat4Mul(&localTransform, &parentTransform);
@@ -95,14 +97,15 @@ inline bool MeshImporter::LoadRecursive(NX_Model* model, const aiNode* node, con
 
         model->meshMaterials[meshIndex] = mesh->mMaterialIndex;
 
-        if (mesh->mNumBones) {
-            model->meshes[meshIndex] = LoadMesh<true>(mesh, globalTransform);
-        }
-        else {
-            model->meshes[meshIndex] = LoadMesh<false>(mesh, globalTransform);
-        }
+        // A mesh referenced by several nodes keeps the last one, as before
+        ModelData::Mesh* result = &model->meshes[meshIndex];
+        NX_DestroyMeshData(&result->data);
 
-        if (model->meshes[meshIndex] == nullptr) {
+        bool loaded = mesh->mNumBones
+            ? LoadMesh<true>(result, mesh, globalTransform)
+            : LoadMesh<false>(result, mesh, globalTransform);
+
+        if (!loaded) {
             NX_LOG(E, "RENDER: Unable to load mesh [%d]; The model will be invalid", node->mMeshes[i]);
             return false;
         }
@@ -118,20 +121,20 @@ inline bool MeshImporter::LoadRecursive(NX_Model* model, const aiNode* node, con
 }
 
 template <bool HasBones>
-NX_Mesh* MeshImporter::LoadMesh(const aiMesh* mesh, const NX_Mat4& transform)
+bool MeshImporter::LoadMesh(ModelData::Mesh* result, const aiMesh* mesh, const NX_Mat4& transform)
 {
     /* --- Validate input parameters --- */
 
     if (!mesh) {
         NX_LOG(E, "RENDER: Invalid parameters during assimp mesh processing");
-        return nullptr;
+        return false;
     }
 
     /* --- Validate mesh data presence --- */
 
     if (mesh->mNumVertices == 0 || mesh->mNumFaces == 0) {
         NX_LOG(E, "RENDER: Empty mesh detected during assimp mesh processing");
-        return nullptr;
+        return false;
     }
 
     /* --- Allocate vertex and index buffers --- */
@@ -142,7 +145,7 @@ NX_Mesh* MeshImporter::LoadMesh(const aiMesh* mesh, const NX_Mat4& transform)
     NX_MeshData data = NX_CreateMeshData(vertexCount, indexCount);
     if (!data.vertices || !data.indices) {
         NX_LOG(E, "RENDER: Failed to load mesh; Unable to allocate mesh data");
-        return nullptr;
+        return false;
     }
 
     /* --- Initialize bounding box --- */
@@ -331,13 +334,13 @@ NX_Mesh* MeshImporter::LoadMesh(const aiMesh* mesh, const NX_Mat4& transform)
         if (face->mNumIndices != 3) {
             NX_LOG(E, "RENDER: Non-triangular face detected (indices: %u)", face->mNumIndices);
             NX_DestroyMeshData(&data);
-            return nullptr;
+            return false;
         }
         for (uint32_t j = 0; j < 3; j++) {
             if (face->mIndices[j] >= mesh->mNumVertices) {
                 NX_LOG(E, "RENDER: Invalid vertex index (%u >= %u)", face->mIndices[j], mesh->mNumVertices);
                 NX_DestroyMeshData(&data);
-                return nullptr;
+                return false;
             }
         }
         data.indices[indexOffset++] = face->mIndices[0];
@@ -350,14 +353,15 @@ NX_Mesh* MeshImporter::LoadMesh(const aiMesh* mesh, const NX_Mat4& transform)
     if (indexOffset != indexCount) {
         NX_LOG(E, "RENDER: Inconsistency in the number of indices (%zu != %zu)", indexOffset, indexCount);
         NX_DestroyMeshData(&data);
-        return nullptr;
+        return false;
     }
 
-    /* --- Create the mesh in the pool and return it --- */
+    /* --- Keep the data until the mesh is created on the main thread --- */
 
-    NX_Mesh* modelMesh = NX_CreateMesh(NX_PRIMITIVE_TRIANGLES, &data, &aabb);
-    NX_DestroyMeshData(&data);
-    return modelMesh;
+    result->data = data;
+    result->aabb = aabb;
+
+    return true;
 }
 
 } // namespace import
@@ -0,0 +1,713 @@
+/* ModelCache.hpp -- Nexium binary model format, models stored ready to upload
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef NX_IMPORT_MODEL_CACHE_HPP
+#define NX_IMPORT_MODEL_CACHE_HPP
+
+#include <NX/NX_Animation.h>
+#include <NX/NX_Memory.h>
+#include <NX/NX_Log.h>
+
+#include "../Detail/Util/DynamicArray.hpp"
+#include "../INX_GlobalPool.hpp"
+#include "../NX_Animation.hpp"
+#include "./ModelData.hpp"
+
+#include <unordered_map>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <bit>
+
+namespace import {
+
+/* === Declaration === */
+
+/**
+ * Model cache, a single binary file holding a model ready to upload.
+ *
+ * Every record and array is stored at an offset aligned to 16 bytes, laid out
+ * as in memory, so a loaded file is used in place: the mesh data and images of
+ * the model data point into it until they are uploaded. Only the skeleton and
+ * animation keys, which their objects own, are copied.
+ *
+ * The header records the version and the size of the stored structures, a cache
+ * written by another version or platform is rejected and must be regenerated
+ * from its source model.
+ */
+class ModelCache {
+public:
+    static constexpr uint64_t Alignment = 16;
+
+public:
+    /** Whether the data starts like a model cache, it may still be invalid */
+    static bool IsCache(const void* data, size_t size);
+
+    /** Writes a model and its optional animations, the images must have been kept (see ModelData::shareTextures) */
+    static bool Save(util::DynamicArray<uint8_t>* out, const ModelData& model, const NX_AnimationLib* animLib);
+
+    /** Fills model data pointing into 'data', which must be aligned to 16 bytes and outlive the upload steps */
+    static bool Load(ModelData* model, const void* data, size_t size);
+
+    /** Creates an animation library from the animations of a cache, copying their keys, 'data' can be unaligned */
+    static NX_AnimationLib* LoadAnimationLib(const void* data, size_t size);
+
+private:
+    static constexpr char Magic[8] = { 'N', 'X', 'M', 'O', 'D', 'E', 'L', '\0' };
+    static constexpr uint32_t Version = 1;
+
+    struct ImageRecord {
+        uint64_t pixels;
+        uint64_t key;
+        int32_t w, h;
+        int32_t format;
+        int32_t wrap;
+    };
+
+    struct MaterialRecord {
+        ImageRecord images[ModelData::MAP_COUNT];
+        NX_Color albedoColor;
+        NX_Color emissionColor;
+        float emissionEnergy;
+        float aoLightAffect;
+        float occlusion;
+        float roughness;
+        float metalness;
+        float normalScale;
+        float depthOffset;
+        float depthScale;
+        float alphaCutOff;
+        NX_Vec2 texOffset;
+        NX_Vec2 texScale;
+        int32_t depthTest;
+        int32_t billboard;
+        int32_t shading;
+        int32_t blend;
+        int32_t cull;
+    };
+
+    struct MeshRecord {
+        uint64_t vertices;
+        uint64_t indices;
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        int32_t material;
+        NX_BoundingBox3D aabb;
+    };
+
+    struct ChannelRecord {
+        uint64_t positionKeys;
+        uint64_t rotationKeys;
+        uint64_t scaleKeys;
+        uint32_t positionKeyCount;
+        uint32_t rotationKeyCount;
+        uint32_t scaleKeyCount;
+        int32_t boneIndex;
+    };
+
+    struct AnimationRecord {
+        char name[32];
+        uint64_t channels;
+        uint32_t channelCount;
+        int32_t boneCount;
+        float ticksPerSecond;
+        float duration;
+    };
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t layout;            //< Sizes of the stored structures, see GetLayout()
+        uint64_t fileSize;
+
+        NX_BoundingBox3D aabb;
+        uint32_t meshCount;
+        uint32_t materialCount;
+        uint32_t boneCount;
+        uint32_t animationCount;
+
+        uint64_t meshes;
+        uint64_t materials;
+        uint64_t bones;
+        uint64_t boneOffsets;
+        uint64_t bindLocal;
+        uint64_t bindPose;
+        uint64_t animations;
+    };
+
+    /** Reads arrays of the cache, checking that they fit in the file */
+    class Reader {
+    public:
+        Reader(const void* data, size_t size);
+
+        template<typename T>
+        const T* Get(uint64_t offset, uint64_t count);
+
+        bool IsValid() const { return mValid; }
+
+    private:
+        const uint8_t* mData;
+        size_t mSize;
+        bool mValid;
+    };
+
+private:
+    static uint32_t GetLayout();
+    static const Header* GetHeader(const void* data, size_t size);
+
+    /** Appends an array aligned for the cache, returns its offset */
+    static uint64_t Append(util::DynamicArray<uint8_t>* out, const void* data, size_t size, bool* success);
+
+    /** Key of a cached map under the sampler of the model being loaded */
+    static uint64_t GetKey(uint64_t key, const ModelData& model);
+};
+
+/* === Public Implementation === */
+
+inline bool ModelCache::IsCache(const void* data, size_t size)
+{
+    return (data != nullptr && size >= sizeof(Header) && std::memcmp(data, Magic, sizeof(Magic)) == 0);
+}
+
+inline bool ModelCache::Save(util::DynamicArray<uint8_t>* out, const ModelData& model, const NX_AnimationLib* animLib)
+{
+    bool success = true;
+
+    out->Clear();
+    Append(out, nullptr, sizeof(Header), &success);
+
+    /* --- Mesh data --- */
+
+    util::DynamicArray<MeshRecord> meshes{};
+    success &= meshes.Resize(model.meshes.GetSize());
+
+    for (size_t i = 0; success && i < model.meshes.GetSize(); i++) {
+        const ModelData::Mesh& mesh = model.meshes[i];
+        meshes[i] = MeshRecord {
+            .vertices = Append(out, mesh.data.vertices, mesh.data.vertexCount * sizeof(NX_Vertex3D), &success),
+            .indices = Append(out, mesh.data.indices, mesh.data.indexCount * sizeof(uint32_t), &success),
+            .vertexCount = static_cast<uint32_t>(mesh.data.vertexCount),
+            .indexCount = static_cast<uint32_t>(mesh.data.indexCount),
+            .material = model.meshMaterials[i],
+            .aabb = mesh.aabb
+        };
+    }
+
+    /* --- Materials, maps sharing a key within the model are stored once --- */
+
+    util::DynamicArray<MaterialRecord> materials{};
+    success &= materials.Resize(model.materials.GetSize());
+
+    std::unordered_map<uint64_t, ImageRecord> images{};
+
+    for (size_t i = 0; success && i < model.materials.GetSize(); i++)
+    {
+        const ModelData::Material& src = model.materials[i];
+        const NX_Material& mat = src.material;
+
+        MaterialRecord& dst = materials[i];
+        dst = MaterialRecord {
+            .albedoColor = mat.albedo.color,
+            .emissionColor = mat.emission.color,
+            .emissionEnergy = mat.emission.energy,
+            .aoLightAffect = mat.orm.aoLightAffect,
+            .occlusion = mat.orm.occlusion,
+            .roughness = mat.orm.roughness,
+            .metalness = mat.orm.metalness,
+            .normalScale = mat.normal.scale,
+            .depthOffset = mat.depth.offset,
+            .depthScale = mat.depth.scale,
+            .alphaCutOff = mat.alphaCutOff,
+            .texOffset = mat.texOffset,
+            .texScale = mat.texScale,
+            .depthTest = mat.depth.test,
+            .billboard = mat.billboard,
+            .shading = mat.shading,
+            .blend = mat.blend,
+            .cull = mat.cull
+        };
+
+        for (int j = 0; j < ModelData::MAP_COUNT; j++)
+        {
+            const ModelData::Image& image = src.images[j];
+            if (image.key == 0) {
+                continue;
+            }
+
+            if (image.image.pixels != nullptr && images.find(image.key) == images.end()) {
+                size_t bytes = size_t(NX_GetPixelBytes(image.image.format)) * image.image.w * image.image.h;
+                images[image.key] = ImageRecord {
+                    .pixels = Append(out, image.image.pixels, bytes, &success),
+                    .key = image.key,
+                    .w = image.image.w,
+                    .h = image.image.h,
+                    .format = image.image.format,
+                    .wrap = image.wrap
+                };
+            }
+
+            auto it = images.find(image.key);
+            if (it == images.end()) {
+                NX_LOG(E, "RENDER: Failed to save model cache; Material [%i] map [%i] was not decoded", int(i), j);
+                return false;
+            }
+
+            dst.images[j] = it->second;
+        }
+    }
+
+    /* --- Skeleton --- */
+
+    const NX_Skeleton& skeleton = model.skeleton;
+    const size_t boneCount = static_cast<size_t>(skeleton.boneCount);
+
+    Header header {
+        .version = Version,
+        .layout = GetLayout(),
+        .aabb = model.aabb,
+        .meshCount = static_cast<uint32_t>(meshes.GetSize()),
+        .materialCount = static_cast<uint32_t>(materials.GetSize()),
+        .boneCount = static_cast<uint32_t>(boneCount),
+        .animationCount = static_cast<uint32_t>(animLib ? animLib->count : 0)
+    };
+
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+
+    header.bones = Append(out, skeleton.bones, boneCount * sizeof(NX_BoneInfo), &success);
+    header.boneOffsets = Append(out, skeleton.boneOffsets, boneCount * sizeof(NX_Mat4), &success);
+    header.bindLocal = Append(out, skeleton.bindLocal, boneCount * sizeof(NX_Mat4), &success);
+    header.bindPose = Append(out, skeleton.bindPose, boneCount * sizeof(NX_Mat4), &success);
+
+    /* --- Animations, compressed libraries no longer have their keys --- */
+
+    if (animLib != nullptr && animLib->internal != nullptr && animLib->internal->compressed) {
+        NX_LOG(E, "RENDER: Failed to save model cache; Compressed animations cannot be saved");
+        return false;
+    }
+
+    util::DynamicArray<AnimationRecord> animations{};
+    success &= animations.Resize(header.animationCount);
+
+    for (uint32_t i = 0; success && i < header.animationCount; i++)
+    {
+        const NX_Animation& anim = animLib->animations[i];
+
+        util::DynamicArray<ChannelRecord> channels{};
+        success &= channels.Resize(anim.channelCount);
+
+        for (uint32_t j = 0; success && j < anim.channelCount; j++) {
+            const NX_AnimationChannel& channel = anim.channels[j];
+            channels[j] = ChannelRecord {
+                .positionKeys = Append(out, channel.positionKeys, channel.positionKeyCount * sizeof(NX_Vec3Key), &success),
+                .rotationKeys = Append(out, channel.rotationKeys, channel.rotationKeyCount * sizeof(NX_QuatKey), &success),
+                .scaleKeys = Append(out, channel.scaleKeys, channel.scaleKeyCount * sizeof(NX_Vec3Key), &success),
+                .positionKeyCount = channel.positionKeyCount,
+                .rotationKeyCount = channel.rotationKeyCount,
+                .scaleKeyCount = channel.scaleKeyCount,
+                .boneIndex = channel.boneIndex
+            };
+        }
+
+        AnimationRecord& record = animations[i];
+        record = AnimationRecord {
+            .channels = Append(out, channels.GetData(), channels.GetSize() * sizeof(ChannelRecord), &success),
+            .channelCount = anim.channelCount,
+            .boneCount = anim.boneCount,
+            .ticksPerSecond = anim.ticksPerSecond,
+            .duration = anim.duration
+        };
+        std::memcpy(record.name, anim.name, sizeof(record.name));
+    }
+
+    /* --- Record tables, then the header in front --- */
+
+    header.meshes = Append(out, meshes.GetData(), meshes.GetSize() * sizeof(MeshRecord), &success);
+    header.materials = Append(out, materials.GetData(), materials.GetSize() * sizeof(MaterialRecord), &success);
+    header.animations = Append(out, animations.GetData(), animations.GetSize() * sizeof(AnimationRecord), &success);
+    header.fileSize = out->GetSize();
+
+    if (!success) {
+        NX_LOG(E, "RENDER: Failed to save model cache; Out of memory");
+        return false;
+    }
+
+    std::memcpy(out->GetData(), &header, sizeof(Header));
+
+    return true;
+}
+
+inline bool ModelCache::Load(ModelData* model, const void* data, size_t size)
+{
+    const Header* header = GetHeader(data, size);
+    if (header == nullptr) {
+        return false;
+    }
+
+    Reader reader(data, size);
+
+    const MeshRecord* meshes = reader.Get<MeshRecord>(header->meshes, header->meshCount);
+    const MaterialRecord* materials = reader.Get<MaterialRecord>(header->materials, header->materialCount);
+
+    if (!reader.IsValid()
+        || !model->meshes.Resize(header->meshCount)
+        || !model->meshMaterials.Resize(header->meshCount)
+        || !model->materials.Resize(header->materialCount))
+    {
+        NX_LOG(E, "RENDER: Failed to load model cache; Invalid or truncated data");
+        return false;
+    }
+
+    model->cache = data;
+    model->aabb = header->aabb;
+
+    /* --- Meshes point into the cache --- */
+
+    for (uint32_t i = 0; i < header->meshCount; i++)
+    {
+        const MeshRecord& record = meshes[i];
+
+        ModelData::Mesh& mesh = model->meshes[i];
+        mesh.data.vertices = const_cast<NX_Vertex3D*>(reader.Get<NX_Vertex3D>(record.vertices, record.vertexCount));
+        mesh.data.indices = const_cast<uint32_t*>(reader.Get<uint32_t>(record.indices, record.indexCount));
+        mesh.data.vertexCount = static_cast<int>(record.vertexCount);
+        mesh.data.indexCount = static_cast<int>(record.indexCount);
+        mesh.aabb = record.aabb;
+
+        if (mesh.data.vertices == nullptr || record.vertexCount > INT32_MAX || record.indexCount > INT32_MAX) {
+            NX_LOG(E, "RENDER: Failed to load model cache; Mesh [%i] has no vertices", int(i));
+            return false;
+        }
+
+        if (record.indexCount > 0 && mesh.data.indices == nullptr) {
+            NX_LOG(E, "RENDER: Failed to load model cache; Mesh [%i] indices are truncated", int(i));
+            return false;
+        }
+
+        // The indices are uploaded as is, one out of range would read past the vertex buffer
+        for (uint32_t k = 0; k < record.indexCount; k++) {
+            if (mesh.data.indices[k] >= record.vertexCount) {
+                NX_LOG(E, "RENDER: Failed to load model cache; Mesh [%i] index [%u] is out of range", int(i), k);
+                return false;
+            }
+        }
+
+        bool validMaterial = (record.material >= 0 && record.material < static_cast<int32_t>(header->materialCount));
+        model->meshMaterials[i] = validMaterial ? record.material : 0;
+    }
+
+    /* --- Materials, their maps point into the cache --- */
+
+    for (uint32_t i = 0; i < header->materialCount; i++)
+    {
+        const MaterialRecord& record = materials[i];
+        ModelData::Material& material = model->materials[i];
+
+        NX_Material& mat = material.material;
+        mat = NX_GetDefaultMaterial();
+
+        // Textures are only created by the upload steps, the model owns them
+        mat.albedo = { nullptr, record.albedoColor };
+        mat.emission = { nullptr, record.emissionColor, record.emissionEnergy };
+        mat.orm = { nullptr, record.aoLightAffect, record.occlusion, record.roughness, record.metalness };
+        mat.normal = { nullptr, record.normalScale };
+        mat.depth = { static_cast<NX_DepthTest>(record.depthTest), record.depthOffset, record.depthScale };
+        mat.alphaCutOff = record.alphaCutOff;
+        mat.texOffset = record.texOffset;
+        mat.texScale = record.texScale;
+        mat.billboard = static_cast<NX_BillboardMode>(record.billboard);
+        mat.shading = static_cast<NX_ShadingMode>(record.shading);
+        mat.blend = static_cast<NX_BlendMode>(record.blend);
+        mat.cull = static_cast<NX_CullMode>(record.cull);
+
+        for (int j = 0; j < ModelData::MAP_COUNT; j++)
+        {
+            const ImageRecord& src = record.images[j];
+            if (src.key == 0) {
+                continue;
+            }
+
+            if (src.format <= NX_PIXEL_FORMAT_INVALID || src.format > NX_PIXEL_FORMAT_RGBA32F || src.w <= 0 || src.h <= 0) {
+                NX_LOG(E, "RENDER: Failed to load model cache; Material [%i] map [%i] has an invalid format or size", int(i), j);
+                return false;
+            }
+
+            NX_PixelFormat format = static_cast<NX_PixelFormat>(src.format);
+            int pixelBytes = NX_GetPixelBytes(format);
+
+            ModelData::Image& image = material.images[j];
+            image.image.pixels = const_cast<uint8_t*>(reader.Get<uint8_t>(src.pixels, uint64_t(pixelBytes) * src.w * src.h));
+            image.image.w = src.w;
+            image.image.h = src.h;
+            image.image.format = format;
+            image.wrap = static_cast<NX_TextureWrap>(src.wrap);
+            image.key = GetKey(src.key, *model);
+
+            if (image.image.pixels == nullptr) {
+                NX_LOG(E, "RENDER: Failed to load model cache; Material [%i] map [%i] is invalid", int(i), j);
+                return false;
+            }
+        }
+    }
+
+    /* --- Skeleton, copied since the model owns it --- */
+
+    if (header->boneCount > 0)
+    {
+        const NX_BoneInfo* bones = reader.Get<NX_BoneInfo>(header->bones, header->boneCount);
+        const NX_Mat4* boneOffsets = reader.Get<NX_Mat4>(header->boneOffsets, header->boneCount);
+        const NX_Mat4* bindLocal = reader.Get<NX_Mat4>(header->bindLocal, header->boneCount);
+        const NX_Mat4* bindPose = reader.Get<NX_Mat4>(header->bindPose, header->boneCount);
+
+        if (reader.IsValid()) {
+            NX_Skeleton& skeleton = model->skeleton;
+            skeleton.bones = NX_Malloc<NX_BoneInfo>(header->boneCount);
+            skeleton.boneOffsets = NX_Malloc<NX_Mat4>(header->boneCount);
+            skeleton.bindLocal = NX_Malloc<NX_Mat4>(header->boneCount);
+            skeleton.bindPose = NX_Malloc<NX_Mat4>(header->boneCount);
+
+            if (!skeleton.bones || !skeleton.boneOffsets || !skeleton.bindLocal || !skeleton.bindPose) {
+                NX_LOG(E, "RENDER: Failed to load model cache; Unable to allocate the skeleton");
+                return false;
+            }
+
+            std::memcpy(skeleton.bones, bones, header->boneCount * sizeof(NX_BoneInfo));
+            std::memcpy(skeleton.boneOffsets, boneOffsets, header->boneCount * sizeof(NX_Mat4));
+            std::memcpy(skeleton.bindLocal, bindLocal, header->boneCount * sizeof(NX_Mat4));
+            std::memcpy(skeleton.bindPose, bindPose, header->boneCount * sizeof(NX_Mat4));
+            skeleton.boneCount = static_cast<int>(header->boneCount);
+        }
+    }
+
+    if (!reader.IsValid()) {
+        NX_LOG(E, "RENDER: Failed to load model cache; Invalid or truncated data");
+        return false;
+    }
+
+    return true;
+}
+
+inline NX_AnimationLib* ModelCache::LoadAnimationLib(const void* data, size_t size)
+{
+    // Everything is copied, an unaligned buffer only needs an aligned copy for the reads
+    if (IsCache(data, size) && reinterpret_cast<uintptr_t>(data) % Alignment != 0) {
+        void* copy = NX_Malloc(size);
+        if (copy == nullptr) {
+            NX_LOG(E, "RENDER: Unable to allocate memory for animations");
+            return nullptr;
+        }
+        std::memcpy(copy, data, size);
+        NX_AnimationLib* animLib = LoadAnimationLib(copy, size);
+        NX_Free(copy);
+        return animLib;
+    }
+
+    const Header* header = GetHeader(data, size);
+    if (header == nullptr) {
+        return nullptr;
+    }
+
+    if (header->animationCount == 0) {
+        NX_LOG(E, "RENDER: No animations found");
+        return nullptr;
+    }
+
+    Reader reader(data, size);
+
+    const AnimationRecord* records = reader.Get<AnimationRecord>(header->animations, header->animationCount);
+    if (!reader.IsValid()) {
+        NX_LOG(E, "RENDER: Failed to load model cache; Invalid or truncated data");
+        return nullptr;
+    }
+
+    NX_AnimationLib* animLib = INX_Pool.Create<NX_AnimationLib>();
+    NX_Animation* animations = NX_Calloc<NX_Animation>(header->animationCount);
+
+    if (animLib == nullptr || animations == nullptr) {
+        NX_LOG(E, "RENDER: Unable to allocate memory for animations");
+        INX_Pool.Destroy(animLib);
+        NX_Free(animations);
+        return nullptr;
+    }
+
+    animLib->animations = animations;
+    animLib->count = static_cast<int>(header->animationCount);
+
+    /* --- Keys are copied, the library owns them --- */
+
+    bool success = true;
+
+    for (uint32_t i = 0; success && i < header->animationCount; i++)
+    {
+        const AnimationRecord& record = records[i];
+        const ChannelRecord* channels = reader.Get<ChannelRecord>(record.channels, record.channelCount);
+
+        NX_Animation& anim = animations[i];
+        std::memcpy(anim.name, record.name, sizeof(anim.name));
+        anim.name[sizeof(anim.name) - 1] = '\0';
+        anim.ticksPerSecond = record.ticksPerSecond;
+        anim.duration = record.duration;
+        anim.boneCount = record.boneCount;
+
+        anim.channels = NX_Calloc<NX_AnimationChannel>(record.channelCount);
+        success = reader.IsValid() && (anim.channels != nullptr || record.channelCount == 0);
+        if (!success) break;
+
+        anim.channelCount = record.channelCount;
+
+        for (uint32_t j = 0; success && j < record.channelCount; j++)
+        {
+            const ChannelRecord& src = channels[j];
+            NX_AnimationChannel& channel = anim.channels[j];
+
+            const NX_Vec3Key* positionKeys = reader.Get<NX_Vec3Key>(src.positionKeys, src.positionKeyCount);
+            const NX_QuatKey* rotationKeys = reader.Get<NX_QuatKey>(src.rotationKeys, src.rotationKeyCount);
+            const NX_Vec3Key* scaleKeys = reader.Get<NX_Vec3Key>(src.scaleKeys, src.scaleKeyCount);
+
+            channel.boneIndex = src.boneIndex;
+            channel.positionKeys = NX_Malloc<NX_Vec3Key>(src.positionKeyCount);
+            channel.rotationKeys = NX_Malloc<NX_QuatKey>(src.rotationKeyCount);
+            channel.scaleKeys = NX_Malloc<NX_Vec3Key>(src.scaleKeyCount);
+
+            success = reader.IsValid()
+                && (channel.positionKeys || src.positionKeyCount == 0)
+                && (channel.rotationKeys || src.rotationKeyCount == 0)
+                && (channel.scaleKeys || src.scaleKeyCount == 0)
+                && (src.boneIndex >= 0 && src.boneIndex < record.boneCount);
+
+            if (success) {
+                std::memcpy(channel.positionKeys, positionKeys, src.positionKeyCount * sizeof(NX_Vec3Key));
+                std::memcpy(channel.rotationKeys, rotationKeys, src.rotationKeyCount * sizeof(NX_QuatKey));
+                std::memcpy(channel.scaleKeys, scaleKeys, src.scaleKeyCount * sizeof(NX_Vec3Key));
+                channel.positionKeyCount = src.positionKeyCount;
+                channel.rotationKeyCount = src.rotationKeyCount;
+                channel.scaleKeyCount = src.scaleKeyCount;
+            }
+        }
+    }
+
+    if (!success) {
+        NX_LOG(E, "RENDER: Failed to load animations from model cache; Invalid data or out of memory");
+        NX_DestroyAnimationLib(animLib);
+        return nullptr;
+    }
+
+    return animLib;
+}
+
+/* === Private Implementation === */
+
+inline ModelCache::Reader::Reader(const void* data, size_t size)
+    : mData(static_cast<const uint8_t*>(data)), mSize(size), mValid(data != nullptr)
+{ }
+
+template<typename T>
+inline const T* ModelCache::Reader::Get(uint64_t offset, uint64_t count)
+{
+    if (!mValid || count == 0) {
+        return nullptr;
+    }
+
+    // Offsets are aligned in the file, the file itself was checked on load
+    if (offset % Alignment != 0 || offset > mSize || count > (mSize - offset) / sizeof(T)) {
+        mValid = false;
+        return nullptr;
+    }
+
+    return reinterpret_cast<const T*>(mData + offset);
+}
+
+inline uint32_t ModelCache::GetLayout()
+{
+    // Any change of a stored structure changes the layout, along with the byte order
+    const uint32_t sizes[] = {
+        sizeof(Header), sizeof(MeshRecord), sizeof(MaterialRecord), sizeof(ImageRecord),
+        sizeof(AnimationRecord), sizeof(ChannelRecord), sizeof(NX_Vertex3D), sizeof(NX_BoneInfo),
+        sizeof(NX_Mat4), sizeof(NX_Vec3Key), sizeof(NX_QuatKey), 0x01020304u
+    };
+
+    uint32_t hash = 2166136261u;
+    for (uint32_t size : sizes) {
+        hash = (hash ^ size) * 16777619u;
+    }
+
+    return hash;
+}
+
+inline const ModelCache::Header* ModelCache::GetHeader(const void* data, size_t size)
+{
+    if (!IsCache(data, size)) {
+        NX_LOG(E, "RENDER: Failed to load model cache; Not a model cache");
+        return nullptr;
+    }
+
+    if (reinterpret_cast<uintptr_t>(data) % Alignment != 0) {
+        NX_LOG(E, "RENDER: Failed to load model cache; Data must be aligned to %i bytes", int(Alignment));
+        return nullptr;
+    }
+
+    const Header* header = static_cast<const Header*>(data);
+
+    if (header->version != Version || header->layout != GetLayout()) {
+        NX_LOG(E, "RENDER: Failed to load model cache; Written by another version or platform, it must be regenerated");
+        return nullptr;
+    }
+
+    if (header->fileSize != size) {
+        NX_LOG(E, "RENDER: Failed to load model cache; Expected %llu bytes, got %zu",
+               static_cast<unsigned long long>(header->fileSize), size);
+        return nullptr;
+    }
+
+    return header;
+}
+
+inline uint64_t ModelCache::Append(util::DynamicArray<uint8_t>* out, const void* data, size_t size, bool* success)
+{
+    if (!*success || size == 0) {
+        return 0;
+    }
+
+    size_t offset = (out->GetSize() + Alignment - 1) & ~(Alignment - 1);
+
+    // Grows geometrically, resizing alone allocates the exact size
+    if (offset + size > out->GetCapacity() && !out->Reserve(std::max(offset + size, 2 * out->GetCapacity()))) {
+        *success = false;
+        return 0;
+    }
+
+    if (!out->Resize(offset + size, 0)) {
+        *success = false;
+        return 0;
+    }
+
+    if (data != nullptr) {
+        std::memcpy(out->GetData() + offset, data, size);
+    }
+
+    return offset;
+}
+
+inline uint64_t ModelCache::GetKey(uint64_t key, const ModelData& model)
+{
+    // The key saved covers the content, the sampler is the one of the current import
+    const uint64_t sampler[] = {
+        key, static_cast<uint64_t>(model.filter), std::bit_cast<uint32_t>(model.anisotropy)
+    };
+
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (uint64_t value : sampler) {
+        hash = (hash ^ value) * 0x100000001B3ull;
+        hash ^= hash >> 29;
+    }
+
+    return (hash != 0) ? hash : 1;
+}
+
+} // namespace import
+
+#endif // NX_IMPORT_MODEL_CACHE_HPP
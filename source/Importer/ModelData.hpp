@@ -0,0 +1,289 @@
+/* ModelData.hpp -- Imported model kept in memory until its GPU resources are created
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef NX_IMPORT_MODEL_DATA_HPP
+#define NX_IMPORT_MODEL_DATA_HPP
+
+#include <NX/NX_MeshData.h>
+#include <NX/NX_Material.h>
+#include <NX/NX_Skeleton.h>
+#include <NX/NX_Texture.h>
+#include <NX/NX_Memory.h>
+#include <NX/NX_Model.h>
+#include <NX/NX_Log.h>
+#include <NX/NX_Image.h>
+#include <NX/NX_Mesh.h>
+
+#include "../Detail/Util/DynamicArray.hpp"
+#include "../Detail/Util/Ranges.hpp"
+#include "../INX_GlobalPool.hpp"
+
+#include <array>
+
+namespace import {
+
+/* === Declaration === */
+
+/**
+ * Model imported in memory, before any GPU resource is created.
+ *
+ * Filling it only involves CPU work, so it can be done on any thread. The
+ * GPU resources are then created on the main thread, one mesh or texture per
+ * upload step so the work can be spread over several frames, and Finish()
+ * assembles the model. Everything not handed to the model is released on
+ * destruction, which must then happen on the main thread.
+ */
+class ModelData {
+public:
+    enum Map {
+        MAP_ALBEDO      = 0,
+        MAP_EMISSION    = 1,
+        MAP_ORM         = 2,
+        MAP_NORMAL      = 3,
+        MAP_COUNT
+    };
+
+    struct Mesh {
+        NX_MeshData data;           //< Released once uploaded, unless it points into the cache
+        NX_BoundingBox3D aabb;
+        NX_Mesh* mesh;
+    };
+
+    struct Image {
+        NX_Image image;             //< Owned unless it points into the cache, released once uploaded
+        NX_TextureWrap wrap;
+        uint64_t key;               //< Identifies the texture among shared ones, zero if the map has none
+        NX_Texture* texture;        //< Shared texture found before decoding, already referenced
+    };
+
+    struct Material {
+        NX_Material material;       //< Its textures are set by the upload steps
+        std::array<Image, MAP_COUNT> images;
+    };
+
+public:
+    ModelData() = default;
+    ~ModelData();
+
+    ModelData(const ModelData&) = delete;
+    ModelData& operator=(const ModelData&) = delete;
+
+    /** Upload steps, a mesh or a material map each */
+    int GetUploadStepCount() const;
+    bool UploadStep(int step);
+
+    /** Creates the model from the uploaded resources, once every step succeeded */
+    NX_Model* Finish();
+
+    /** Creates a skeleton owning the bone arrays, which are cleared from 'skeleton' */
+    static NX_Skeleton* CreateSkeleton(NX_Skeleton* skeleton);
+
+private:
+    /** Releases data once uploaded, only clears it if it belongs to the cache */
+    void ReleaseData(NX_MeshData* data);
+    void ReleaseData(NX_Image* image);
+
+public:
+    util::DynamicArray<Mesh> meshes{};
+    util::DynamicArray<int> meshMaterials{};
+    util::DynamicArray<Material> materials{};
+    NX_Skeleton skeleton{};         //< Bone arrays, empty if the model is not skinned
+    NX_BoundingBox3D aabb{};
+
+    /** Sampler of the textures, taken when the import starts */
+    NX_TextureFilter filter{NX_GetDefaultTextureFilter()};
+    float anisotropy{NX_GetDefaultTextureAnisotropy()};
+
+    /** Whether maps can take a texture already shared instead of their image, see TextureLoader */
+    bool shareTextures{true};
+
+    /** Model cache file the mesh data and images point into, it must outlive the upload steps */
+    const void* cache{};
+};
+
+/* === Public Implementation === */
+
+inline ModelData::~ModelData()
+{
+    for (Mesh& mesh : meshes) {
+        ReleaseData(&mesh.data);
+        NX_DestroyMesh(mesh.mesh);
+    }
+
+    for (Material& material : materials) {
+        for (Image& image : material.images) {
+            ReleaseData(&image.image);
+            NX_DestroyTexture(image.texture);
+        }
+        NX_DestroyTexture(material.material.albedo.texture);
+        NX_DestroyTexture(material.material.emission.texture);
+        NX_DestroyTexture(material.material.orm.texture);
+        NX_DestroyTexture(material.material.normal.texture);
+    }
+
+    NX_Free(skeleton.bones);
+    NX_Free(skeleton.boneOffsets);
+    NX_Free(skeleton.bindLocal);
+    NX_Free(skeleton.bindPose);
+}
+
+inline int ModelData::GetUploadStepCount() const
+{
+    return static_cast<int>(meshes.GetSize() + MAP_COUNT * materials.GetSize());
+}
+
+inline bool ModelData::UploadStep(int step)
+{
+    /* --- Meshes come first --- */
+
+    if (step < static_cast<int>(meshes.GetSize())) {
+        Mesh& mesh = meshes[step];
+        if (mesh.data.vertices == nullptr) {
+            NX_LOG(E, "RENDER: Mesh [%d] is not referenced by the scene; The model will be invalid", step);
+            return false;
+        }
+        mesh.mesh = NX_CreateMesh(NX_PRIMITIVE_TRIANGLES, &mesh.data, &mesh.aabb);
+        ReleaseData(&mesh.data);
+        return (mesh.mesh != nullptr);
+    }
+
+    /* --- Then material maps, a missing texture keeps the material default --- */
+
+    step -= static_cast<int>(meshes.GetSize());
+
+    Material& material = materials[step / MAP_COUNT];
+    Image& image = material.images[step % MAP_COUNT];
+
+    NX_Texture* texture = image.texture;
+    image.texture = nullptr;
+
+    // Another material, or a model loaded meanwhile, may have created it since the decoding
+    if (texture == nullptr && image.key != 0) {
+        texture = INX_Pool.AcquireSharedTexture(image.key);
+    }
+
+    if (texture == nullptr && image.image.pixels != nullptr) {
+        texture = INX_CreateMaterialTexture(&image.image, image.wrap, filter);
+        if (texture != nullptr) {
+            size_t bytes = size_t(NX_GetPixelBytes(image.image.format)) * image.image.w * image.image.h;
+            INX_Pool.ShareTexture(texture, image.key, bytes);
+        }
+    }
+
+    ReleaseData(&image.image);
+
+    if (texture == nullptr) {
+        return true;
+    }
+
+    switch (step % MAP_COUNT) {
+    case MAP_ALBEDO:
+        material.material.albedo.texture = texture;
+        break;
+    case MAP_EMISSION:
+        material.material.emission.texture = texture;
+        break;
+    case MAP_ORM:
+        material.material.orm.texture = texture;
+        break;
+    case MAP_NORMAL:
+        material.material.normal.texture = texture;
+        break;
+    default:
+        NX_UNREACHABLE();
+        break;
+    }
+
+    return true;
+}
+
+inline NX_Model* ModelData::Finish()
+{
+    /* --- Allocate the model and its arrays --- */
+
+    int meshCount = static_cast<int>(meshes.GetSize());
+    int materialCount = static_cast<int>(materials.GetSize());
+
+    NX_Mesh** modelMeshes = static_cast<NX_Mesh**>(SDL_calloc(meshCount, sizeof(NX_Mesh*)));
+    int* modelMeshMaterials = static_cast<int*>(SDL_calloc(meshCount, sizeof(int)));
+    NX_Material* modelMaterials = NX_Malloc<NX_Material>(materialCount);
+
+    NX_Model* model = INX_Pool.Create<NX_Model>();
+
+    if (model == nullptr || !modelMeshes || !modelMeshMaterials || (materialCount > 0 && !modelMaterials)) {
+        NX_LOG(E, "RENDER: Failed to load model; Unable to allocate the model");
+        INX_Pool.Destroy(model);
+        NX_Free(modelMaterials);
+        NX_Free(modelMeshMaterials);
+        NX_Free(modelMeshes);
+        return nullptr;
+    }
+
+    /* --- Hand over the resources, they are no longer released here --- */
+
+    for (int i = 0; i < meshCount; i++) {
+        modelMeshes[i] = meshes[i].mesh;
+        modelMeshMaterials[i] = meshMaterials[i];
+        meshes[i].mesh = nullptr;
+    }
+
+    for (int i = 0; i < materialCount; i++) {
+        modelMaterials[i] = materials[i].material;
+        materials[i].material = NX_Material{};
+    }
+
+    model->meshes = modelMeshes;
+    model->materials = modelMaterials;
+    model->meshMaterials = modelMeshMaterials;
+    model->meshCount = meshCount;
+    model->materialCount = materialCount;
+    model->aabb = aabb;
+    model->skeleton = CreateSkeleton(&skeleton);
+
+    return model;
+}
+
+inline NX_Skeleton* ModelData::CreateSkeleton(NX_Skeleton* skeleton)
+{
+    if (skeleton->boneCount == 0) {
+        return nullptr;
+    }
+
+    NX_Skeleton* result = INX_Pool.Create<NX_Skeleton>();
+    if (result == nullptr) {
+        NX_LOG(E, "RENDER: Failed to create skeleton; Object pool issue");
+        return nullptr;
+    }
+
+    *result = *skeleton;
+    *skeleton = NX_Skeleton{};
+
+    return result;
+}
+
+/* === Private Implementation === */
+
+inline void ModelData::ReleaseData(NX_MeshData* data)
+{
+    if (cache == nullptr) {
+        NX_DestroyMeshData(data);
+    }
+    *data = NX_MeshData{};
+}
+
+inline void ModelData::ReleaseData(NX_Image* image)
+{
+    if (cache == nullptr) {
+        NX_DestroyImage(image);
+    }
+    *image = NX_Image{};
+}
+
+} // namespace import
+
+#endif // NX_IMPORT_MODEL_DATA_HPP
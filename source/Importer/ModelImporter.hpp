@@ -0,0 +1,51 @@
+#ifndef NX_IMPORT_MODEL_IMPORTER_HPP
+#define NX_IMPORT_MODEL_IMPORTER_HPP
+
+#include "./MaterialImporter.hpp"
+#include "./SkeletonImporter.hpp"
+#include "./SceneImporter.hpp"
+#include "./MeshImporter.hpp"
+#include "./ModelData.hpp"
+
+#include <SDL3/SDL_assert.h>
+
+namespace import {
+
+/* === Declaration === */
+
+class ModelImporter {
+public:
+    /** Constructors */
+    ModelImporter(const SceneImporter& importer);
+
+    /** Loads meshes, materials and skeleton in memory, can be called from any thread */
+    bool LoadModel(ModelData* model);
+
+private:
+    const SceneImporter& mImporter;
+};
+
+/* === Public Implementation === */
+
+inline ModelImporter::ModelImporter(const SceneImporter& importer)
+    : mImporter(importer)
+{
+    SDL_assert(importer.IsValid());
+}
+
+inline bool ModelImporter::LoadModel(ModelData* model)
+{
+    if (!MeshImporter(mImporter).LoadMeshes(model)) {
+        return false;
+    }
+
+    if (!MaterialImporter(mImporter).LoadMaterials(model)) {
+        return false;
+    }
+
+    return SkeletonImporter(mImporter).LoadSkeleton(&model->skeleton);
+}
+
+} // namespace import
+
+#endif // NX_IMPORT_MODEL_IMPORTER_HPP
@@ -4,8 +4,8 @@
 #include <NX/NX_Skeleton.h>
 #include <NX/NX_Memory.h>
 
-#include "../INX_GlobalPool.hpp"
 #include "./SceneImporter.hpp"
+#include "./ModelData.hpp"
 #include "./AssimpHelper.hpp"
 
 #include <SDL3/SDL_assert.h>
@@ -20,6 +20,9 @@ public:
     SkeletonImporter(const SceneImporter& importer);
     NX_Skeleton* ProcessSkeleton();
 
+    /** Fills the bone arrays of 'skeleton' without creating it, left empty if there are no bones */
+    bool LoadSkeleton(NX_Skeleton* skeleton);
+
 private:
     void BuildSkeletonRecursive(
         const aiNode* node, int parentIndex,
@@ -30,7 +33,7 @@ private:
 
 private:
     /**
-     * Owned by the resulting NX_Skeleton, do not free here.
+     * Owned by the resulting skeleton, do not free here.
      * Stored as members to share with BuildSkeletonRecursive.
      */
     NX_BoneInfo* mBones{nullptr};
@@ -48,10 +51,29 @@ inline SkeletonImporter::SkeletonImporter(const SceneImporter& importer)
 }
 
 inline NX_Skeleton* SkeletonImporter::ProcessSkeleton()
+{
+    NX_Skeleton skeleton{};
+    if (!LoadSkeleton(&skeleton)) {
+        return nullptr;
+    }
+
+    NX_Skeleton* result = ModelData::CreateSkeleton(&skeleton);
+    if (result == nullptr) {
+        NX_Free(skeleton.bones);
+        NX_Free(skeleton.boneOffsets);
+        NX_Free(skeleton.bindLocal);
+        NX_Free(skeleton.bindPose);
+    }
+
+    return result;
+}
+
+inline bool SkeletonImporter::LoadSkeleton(NX_Skeleton* skeleton)
 {
     int boneCount = mImporter.GetBoneCount();
     if (boneCount == 0) {
-        return nullptr;
+        *skeleton = NX_Skeleton{};
+        return true;
     }
 
     /* --- Allocate bone arrays --- */
@@ -67,7 +89,7 @@ inline NX_Skeleton* SkeletonImporter::ProcessSkeleton()
         NX_Free(mBindLocal);
         NX_Free(mBindPose);
         NX_Free(mBones);
-        return nullptr;
+        return false;
     }
 
     /* --- Initialize parent indices --- */
@@ -93,9 +115,7 @@ inline NX_Skeleton* SkeletonImporter::ProcessSkeleton()
 
     BuildSkeletonRecursive(mImporter.GetRootNode(), -1, NX_MAT4_IDENTITY);
 
-    /* --- Create skeleton --- */
-
-    NX_Skeleton* skeleton = INX_Pool.Create<NX_Skeleton>();
+    /* --- Fill skeleton --- */
 
     skeleton->bones = mBones;
     skeleton->boneCount = boneCount;
@@ -103,7 +123,7 @@ inline NX_Skeleton* SkeletonImporter::ProcessSkeleton()
     skeleton->bindLocal = mBindLocal;
     skeleton->bindPose = mBindPose;
 
-    return skeleton;
+    return true;
 }
 
 /* === Private Implementation === */
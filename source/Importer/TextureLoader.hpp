@@ -2,7 +2,10 @@
 #define NX_IMPORT_DETAIL_TEXTURE_LOADER_HPP
 
 #include "../Detail/Util/DynamicArray.hpp"
+#include "../INX_GlobalPool.hpp"
+#include "../INX_JobSystem.hpp"
 #include "./SceneImporter.hpp"
+#include "./ModelData.hpp"
 
 #include <NX/NX_Texture.h>
 #include <NX/NX_Image.h>
@@ -13,10 +16,9 @@
 #include <assimp/texture.h>
 #include <assimp/types.h>
 
-#include <condition_variable>
-#include <thread>
-#include <queue>
-#include <array>
+#include <unordered_map>
+#include <cstring>
+#include <bit>
 
 namespace import {
 
@@ -24,46 +26,61 @@ namespace import {
 
 class TextureLoader {
 public:
-    enum Map {
-        MAP_ALBEDO      = 0,
-        MAP_EMISSION    = 1,
-        MAP_ORM         = 2,
-        MAP_NORMAL      = 3,
-        MAP_COUNT
-    };
+    using Map = ModelData::Map;
 
 public:
     TextureLoader(const SceneImporter& importer);
-    NX_Texture* Get(int materialIndex, Map map);
+
+    /**
+     * Decodes the images of every material map, the materials of 'model' must be allocated.
+     *
+     * Each map gets a key made of its sources (file path or embedded data), sampler
+     * and color space, zero if it has no texture. Maps whose key is already used by
+     * a shared texture get a reference to it instead of an image, and maps sharing
+     * a key within the model are only decoded once, the others find the texture
+     * when they are uploaded.
+     */
+    void LoadImages(ModelData* model);
 
 private:
+    /** Texture referenced by a material, found without decoding it */
+    struct Source {
+        aiString path;
+        aiTextureMapMode wrap[2];
+        bool found;
+    };
+
+    /** Textures composing a material map, one per channel for the ORM map */
+    struct MapSources {
+        Source channels[3];
+        aiTextureMapMode wrap;
+        bool composed;          //< Channels are merged into an RGB image
+        bool invertRoughness;   //< The roughness comes from a shininess map
+        bool asData;            //< Linear data rather than sRGB color
+    };
+
     /** Temporary image data */
     struct Image {
-        aiTextureMapMode wrap[2];
         NX_Image image;
         bool owned;
     };
 
-    /** Material map array */
-    using MaterialTextures = std::array<NX_Texture*, MAP_COUNT>;
-    using MaterialImages = std::array<Image, MAP_COUNT>;
-
 private:
-    /** Base loading function */
-    bool LoadImage(Image* image, const aiMaterial* material, aiTextureType type, uint32_t index, bool asData);
-    bool LoadImage(Image* image, const aiMaterial* material, Map map);
+    /** Source finding functions, they mirror the fallbacks of each map */
+    bool FindSource(Source* source, const aiMaterial* material, aiTextureType type, uint32_t index);
+    bool FindSources(MapSources* sources, const aiMaterial* material, Map map);
+    bool FindSourcesORM(MapSources* sources, const aiMaterial* material);
 
-    /** Loading functions */
-    bool LoadImageAlbedo(Image* image, const aiMaterial* material);
-    bool LoadImageEmission(Image* image, const aiMaterial* material);
-    bool LoadImageORM(Image* image, const aiMaterial* material);
-    bool LoadImageNormal(Image* image, const aiMaterial* material);
+    /** Decoding functions */
+    bool DecodeSource(Image* image, const Source& source, bool asData);
+    NX_Image DecodeMap(const MapSources& sources);
 
     /** Helpers */
+    uint64_t GetKey(const MapSources& sources, const ModelData& model, const uint64_t* embeddedHashes) const;
+    static uint64_t HashData(uint64_t hash, const void* data, size_t size);
     static NX_TextureWrap GetWrapMode(aiTextureMapMode wrap);
 
 private:
-    util::DynamicArray<MaterialTextures> mTextures;
     const SceneImporter& mImporter;
 };
 
@@ -71,119 +88,189 @@ private:
 
 inline TextureLoader::TextureLoader(const SceneImporter& importer)
     : mImporter(importer)
-{
-    // REVIEW: This is a quick implementation, but it's at least faster than before.
-    //         Note that one of the current big issues is that if two materials use
-    //         the same texture, that texture will be loaded twice. I haven't
-    //         encountered a model where this happens yet, but it is possible!
+{ }
 
-    const int matCount = importer.GetMaterialCount();
-    mTextures.Resize(matCount);
+inline void TextureLoader::LoadImages(ModelData* model)
+{
+    const size_t mapCount = model->materials.GetSize() * ModelData::MAP_COUNT;
 
-    /* --- Temporary storage of images --- */
+    /* --- Find the sources of every map --- */
 
-    util::DynamicArray<MaterialImages> images;
-    images.Resize(matCount);
+    util::DynamicArray<MapSources> sources{};
+    if (!sources.Resize(mapCount)) {
+        NX_LOG(E, "RENDER: Failed to load material textures; Out of memory");
+        return;
+    }
 
-    /* --- Thread pool setup --- */
+    for (size_t job = 0; job < mapCount; job++) {
+        int i = static_cast<int>(job / ModelData::MAP_COUNT);
+        int j = static_cast<int>(job % ModelData::MAP_COUNT);
+        FindSources(&sources[job], mImporter.GetMaterial(i), Map(j));
+    }
 
-    const int totalJobs = matCount * MAP_COUNT;
-    std::atomic<int> nextJob(0);
+    /* --- Hash the embedded images, they are identified by content across models --- */
 
-    const int numThreads = std::min((unsigned int)std::thread::hardware_concurrency(), (unsigned int)totalJobs);
-    std::vector<std::thread> pool;
-    pool.reserve(numThreads);
+    const int embeddedCount = mImporter.GetTextureCount();
 
-    /* --- Simple queue to store ready image indices --- */
+    util::DynamicArray<uint64_t> embeddedHashes{};
+    if (!embeddedHashes.Resize(embeddedCount)) {
+        NX_LOG(E, "RENDER: Failed to load material textures; Out of memory");
+        return;
+    }
 
-    std::mutex readyMutex;
-    std::condition_variable readyCV;
-    std::queue<std::pair<int,int>> readyQueue;
+    INX_Jobs.ParallelFor(embeddedCount, 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const aiTexture* aiTex = mImporter.GetTexture(static_cast<int>(i));
+            size_t size = (aiTex->mHeight == 0) ? aiTex->mWidth : size_t(aiTex->mWidth) * aiTex->mHeight * sizeof(aiTexel);
+            uint64_t hash = HashData(0xCBF29CE484222325ull, &aiTex->mHeight, sizeof(aiTex->mHeight));
+            embeddedHashes[i] = HashData(hash, aiTex->pcData, size);
+        }
+    });
 
-    /* --- Launch loading threads --- */
+    /* --- Keep one map per key, reuse textures already created by other imports --- */
 
-    for (int t = 0; t < numThreads; ++t)
-    {
-        pool.emplace_back([&] {
-            while (true)
-            {
-                int jobIndex = nextJob.fetch_add(1);
-                if (jobIndex >= totalJobs) break;
-
-                int i = jobIndex / MAP_COUNT;
-                int j = jobIndex % MAP_COUNT;
-
-                LoadImage(&images[i][j], importer.GetMaterial(i), Map(j));
-
-                // Indicate that the image is ready for upload
-                {
-                    std::lock_guard<std::mutex> lock(readyMutex);
-                    readyQueue.push({i,j});
-                }
-                readyCV.notify_one();
-            }
-        });
-    }
+    auto getImage = [model](size_t job) -> ModelData::Image& {
+        return model->materials[job / ModelData::MAP_COUNT].images[job % ModelData::MAP_COUNT];
+    };
 
-    /* --- Progressive upload loop --- */
+    util::DynamicArray<size_t> decodes{};
+    std::unordered_map<uint64_t, size_t> firstJobs{};
 
-    int uploadedCount = 0;
-    while (uploadedCount < totalJobs)
+    for (size_t job = 0; job < mapCount; job++)
     {
-        std::pair<int,int> job;
-        {
-            std::unique_lock<std::mutex> lock(readyMutex);
-            readyCV.wait(lock, [&]{ return !readyQueue.empty(); });
-            job = readyQueue.front();
-            readyQueue.pop();
+        const MapSources& source = sources[job];
+        if (!source.channels[0].found && !source.channels[1].found && !source.channels[2].found) {
+            continue;
         }
 
-        int i = job.first;
-        int j = job.second;
-        auto& img = images[i][j];
-
-        if (img.image.pixels) {
-            mTextures[i][j] = NX_CreateTextureFromImageEx(
-                &img.image, GetWrapMode(img.wrap[0]),
-                NX_GetDefaultTextureFilter()
-            );
-            if (img.owned) {
-                NX_DestroyImage(&img.image);
-                img.image.pixels = nullptr;
-                img.owned = false;
-            }
+        ModelData::Image& result = getImage(job);
+        result.key = GetKey(source, *model, embeddedHashes.GetData());
+        result.wrap = GetWrapMode(source.wrap);
+
+        if (!firstJobs.try_emplace(result.key, job).second) {
+            continue;
         }
-        else {
-            mTextures[i][j] = nullptr;
+
+        if (model->shareTextures) {
+            result.texture = INX_Pool.AcquireSharedTexture(result.key);
         }
 
-        uploadedCount++;
+        if (result.texture == nullptr && decodes.EmplaceBack(job) == nullptr) {
+            result.key = 0;
+        }
     }
 
-    /* --- Join threads --- */
+    /* --- Decode the remaining maps, each writes to its own slot --- */
+
+    // When called from a worker this runs inline
+    INX_Jobs.ParallelFor(decodes.GetSize(), 1, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; k++) {
+            getImage(decodes[k]).image = DecodeMap(sources[decodes[k]]);
+        }
+    });
+
+    /* --- Maps whose image could not be decoded have no texture, neither do their duplicates --- */
+
+    for (size_t job = 0; job < mapCount; job++)
+    {
+        ModelData::Image& result = getImage(job);
+        if (result.key == 0) {
+            continue;
+        }
 
-    for (std::thread& t : pool) {
-        t.join();
+        const ModelData::Image& first = getImage(firstJobs[result.key]);
+        if (first.image.pixels == nullptr && first.texture == nullptr) {
+            result.key = 0;
+        }
     }
 }
 
-inline NX_Texture* TextureLoader::Get(int materialIndex, Map map)
+/* === Private Implementation === */
+
+inline bool TextureLoader::FindSource(Source* source, const aiMaterial* material, aiTextureType type, uint32_t index)
 {
-    return mTextures[materialIndex][map];
+    source->found = (material->GetTexture(type, index, &source->path, nullptr, nullptr, nullptr, nullptr, source->wrap) == AI_SUCCESS);
+    return source->found;
 }
 
-/* === Private Implementation === */
+inline bool TextureLoader::FindSources(MapSources* sources, const aiMaterial* material, Map map)
+{
+    *sources = MapSources{};
+
+    switch (map) {
+    case ModelData::MAP_ALBEDO:
+        if (!FindSource(&sources->channels[0], material, aiTextureType_BASE_COLOR, 0)) {
+            FindSource(&sources->channels[0], material, aiTextureType_DIFFUSE, 0);
+        }
+        break;
+    case ModelData::MAP_EMISSION:
+        FindSource(&sources->channels[0], material, aiTextureType_EMISSIVE, 0);
+        break;
+    case ModelData::MAP_ORM:
+        return FindSourcesORM(sources, material);
+    case ModelData::MAP_NORMAL:
+        FindSource(&sources->channels[0], material, aiTextureType_NORMALS, 0);
+        sources->asData = true;
+        break;
+    case ModelData::MAP_COUNT:
+        NX_UNREACHABLE();
+        break;
+    }
+
+    sources->wrap = sources->channels[0].wrap[0];
 
-inline bool TextureLoader::LoadImage(Image* image, const aiMaterial* material, aiTextureType type, uint32_t index, bool asData)
+    return sources->channels[0].found;
+}
+
+inline bool TextureLoader::FindSourcesORM(MapSources* sources, const aiMaterial* material)
 {
-    aiString path{};
-    if (material->GetTexture(type, index, &path, nullptr, nullptr, nullptr, nullptr, image->wrap) != AI_SUCCESS) {
-        return false; // No texture of this type
+    Source& occlusion = sources->channels[0];
+    Source& roughness = sources->channels[1];
+    Source& metalness = sources->channels[2];
+
+    sources->composed = true;
+    sources->asData = true;
+
+    /* --- Find occlusion map --- */
+
+    if (!FindSource(&occlusion, material, aiTextureType_AMBIENT_OCCLUSION, 0)) {
+        FindSource(&occlusion, material, aiTextureType_LIGHTMAP, 0);
     }
 
-    if (path.data[0] == '*')
+    /* --- Find roughness map --- */
+
+    if (!FindSource(&roughness, material, aiTextureType_DIFFUSE_ROUGHNESS, 0)) {
+        sources->invertRoughness = FindSource(&roughness, material, aiTextureType_SHININESS, 0);
+    }
+
+    /* --- Find metalness map, or the glTF map packing both --- */
+
+    if (!FindSource(&metalness, material, aiTextureType_METALNESS, 0) && !roughness.found) {
+        if (FindSource(&roughness, material, AI_MATKEY_GLTF_PBRMETALLICROUGHNESS_METALLICROUGHNESS_TEXTURE)) {
+            metalness = roughness;
+        }
+    }
+
+    /* --- The wrap mode of the first found among metalness, roughness, occlusion --- */
+
+    if (metalness.found) sources->wrap = metalness.wrap[0];
+    else if (roughness.found) sources->wrap = roughness.wrap[0];
+    else if (occlusion.found) sources->wrap = occlusion.wrap[0];
+
+    return (occlusion.found || roughness.found || metalness.found);
+}
+
+inline bool TextureLoader::DecodeSource(Image* image, const Source& source, bool asData)
+{
+    *image = Image{};
+
+    if (!source.found) {
+        return false;
+    }
+
+    if (source.path.data[0] == '*')
     {
-        int textureIndex = atoi(&path.data[1]);
+        int textureIndex = atoi(&source.path.data[1]);
         const aiTexture* aiTex = mImporter.GetTexture(textureIndex);
 
         if (aiTex->mHeight == 0) {
@@ -199,146 +286,149 @@ inline bool TextureLoader::LoadImage(Image* image, const aiMaterial* material, a
             image->image.w = aiTex->mWidth;
             image->image.h = aiTex->mHeight;
             image->image.format = NX_PIXEL_FORMAT_RGBA8;
-            // NOTE: No need to copy the data here, the image will be immediately
-            //       uploaded to the GPU without being retained afterward
+            // NOTE: The data belongs to the importer, it is only read while
+            //       the map is composed or copied
             image->image.pixels = aiTex->pcData;
             image->owned = false;
         }
     }
     else {
         if (asData) {
-            image->image = NX_LoadImageRaw(path.data);
+            image->image = NX_LoadImageRaw(source.path.data);
         }
         else {
-            image->image = NX_LoadImage(path.data);
-        }
-        if (image->image.pixels != nullptr) {
-            image->owned = true;
+            image->image = NX_LoadImage(source.path.data);
         }
+        image->owned = (image->image.pixels != nullptr);
     }
 
-    return true;
+    return (image->image.pixels != nullptr);
 }
 
-inline bool TextureLoader::LoadImage(Image* image, const aiMaterial* material, Map map)
+inline NX_Image TextureLoader::DecodeMap(const MapSources& sources)
 {
-    switch (map) {
-    case MAP_ALBEDO:
-        return LoadImageAlbedo(image, material);
-    case MAP_EMISSION:
-        return LoadImageEmission(image, material);
-    case MAP_ORM:
-        return LoadImageORM(image, material);
-    case MAP_NORMAL:
-        return LoadImageNormal(image, material);
-    case MAP_COUNT:
-        NX_UNREACHABLE();
-        break;
-    }
-    return false;
-}
+    /* --- Single source maps are copied if the importer owns their data --- */
 
-inline bool TextureLoader::LoadImageAlbedo(Image* image, const aiMaterial* material)
-{
-    bool valid = LoadImage(image, material, aiTextureType_BASE_COLOR, 0, false);
-    if (!valid) {
-        valid = LoadImage(image, material, aiTextureType_DIFFUSE, 0, false);
+    if (!sources.composed) {
+        Image image{};
+        if (!DecodeSource(&image, sources.channels[0], sources.asData)) {
+            return NX_Image{};
+        }
+        if (!image.owned) {
+            const NX_Image& src = image.image;
+            return NX_CreateImageFromData(src.pixels, src.w, src.h, src.format, src.format);
+        }
+        return image.image;
     }
-    return valid;
-}
 
-inline bool TextureLoader::LoadImageEmission(Image* image, const aiMaterial* material)
-{
-    return LoadImage(image, material, aiTextureType_EMISSIVE, 0, false);
-}
+    /* --- Decode each channel, a source packing several channels is decoded once --- */
 
-inline bool TextureLoader::LoadImageORM(Image* image, const aiMaterial* material)
-{
-    Image imOcclusion{};
-    Image imRoughness{};
-    Image imMetalness{};
+    Image images[3]{};
+    const NX_Image* channels[3]{};
 
-    /* --- Load occlusion map --- */
+    for (int i = 0; i < 3; i++)
+    {
+        const Source& source = sources.channels[i];
 
-    bool retOcclusion = LoadImage(&imOcclusion, material, aiTextureType_AMBIENT_OCCLUSION, 0, true);
-    if (!retOcclusion) {
-        retOcclusion = LoadImage(&imOcclusion, material, aiTextureType_LIGHTMAP, 0, true);
-    }
+        int same = -1;
+        for (int k = 0; k < i && source.found; k++) {
+            if (sources.channels[k].found && std::strcmp(sources.channels[k].path.data, source.path.data) == 0) {
+                same = k;
+                break;
+            }
+        }
 
-    /* --- Load roughness map --- */
+        if (same >= 0) {
+            channels[i] = channels[same];
+            continue;
+        }
 
-    bool retRoughness = LoadImage(&imRoughness, material, aiTextureType_DIFFUSE_ROUGHNESS, 0, true);
-    if (!retRoughness) {
-        retRoughness = LoadImage(&imOcclusion, material, aiTextureType_SHININESS, 0, true);
-        if (retRoughness) {
-            NX_InvertImage(&imRoughness.image);
+        if (DecodeSource(&images[i], source, true)) {
+            channels[i] = &images[i].image;
         }
     }
 
-    /* --- Load metalness map --- */
-
-    bool retMetalness = LoadImage(&imMetalness, material, aiTextureType_METALNESS, 0, true);
-    if (!retMetalness && !retRoughness) {
-        retRoughness = LoadImage(
-            &imRoughness, material,
-            AI_MATKEY_GLTF_PBRMETALLICROUGHNESS_METALLICROUGHNESS_TEXTURE, true
-        );
-        if (retRoughness) {
-            retMetalness = retRoughness;
-            imMetalness = imRoughness;
+    if (sources.invertRoughness && channels[1] == &images[1].image) {
+        if (!images[1].owned) {
+            const NX_Image& src = images[1].image;
+            images[1].image = NX_CreateImageFromData(src.pixels, src.w, src.h, src.format, src.format);
+            images[1].owned = true;
         }
+        NX_InvertImage(&images[1].image);
     }
 
-    /* --- If no image could be loaded we return --- */
+    /* --- Compose ORM map and free the sources --- */
 
-    if (!retOcclusion && !retRoughness && !retMetalness) {
-        return false;
+    NX_Image result{};
+    if (channels[0] || channels[1] || channels[2]) {
+        result = NX_ComposeImagesRGB(channels, NX_WHITE);
     }
 
-    /* --- Compose ORM map and fill out data --- */
+    for (Image& image : images) {
+        if (image.owned) {
+            NX_DestroyImage(&image.image);
+        }
+    }
 
-    const NX_Image* sources[3] = {
-        retOcclusion ? &imOcclusion.image : nullptr,
-        retRoughness ? &imRoughness.image : nullptr,
-        retMetalness ? &imMetalness.image : nullptr
-    };
+    return result;
+}
 
-    image->image = NX_ComposeImagesRGB(sources, NX_WHITE);
-    image->owned = true;
+inline uint64_t TextureLoader::GetKey(const MapSources& sources, const ModelData& model, const uint64_t* embeddedHashes) const
+{
+    /* --- Sampler and color space --- */
+
+    const uint32_t state[] = {
+        static_cast<uint32_t>(GetWrapMode(sources.wrap)),
+        static_cast<uint32_t>(model.filter),
+        std::bit_cast<uint32_t>(model.anisotropy),
+        static_cast<uint32_t>(sources.composed),
+        static_cast<uint32_t>(sources.invertRoughness),
+        static_cast<uint32_t>(sources.asData)
+    };
 
-    if (retMetalness) {
-        image->wrap[0] = imMetalness.wrap[0];
-        image->wrap[1] = imMetalness.wrap[1];
-    }
-    else if (retRoughness) {
-        image->wrap[0] = imRoughness.wrap[0];
-        image->wrap[1] = imRoughness.wrap[1];
-    }
-    else if (retOcclusion) {
-        image->wrap[0] = imOcclusion.wrap[0];
-        image->wrap[1] = imOcclusion.wrap[1];
-    }
+    uint64_t hash = HashData(0xCBF29CE484222325ull, state, sizeof(state));
 
-    /* --- Free allocated data --- */
+    /* --- Files are identified by path, embedded images by content --- */
 
-    if (imOcclusion.owned) {
-        NX_DestroyImage(&imOcclusion.image);
-    }
+    for (int i = 0; i < (sources.composed ? 3 : 1); i++)
+    {
+        const Source& source = sources.channels[i];
 
-    if (imRoughness.owned) {
-        NX_DestroyImage(&imRoughness.image);
-    }
+        uint64_t tag = !source.found ? 0 : (source.path.data[0] == '*') ? 1 : 2;
+        hash = HashData(hash, &tag, sizeof(tag));
 
-    if (imMetalness.owned && imMetalness.image.pixels != imRoughness.image.pixels) {
-        NX_DestroyImage(&imMetalness.image);
+        if (tag == 1) {
+            uint64_t content = embeddedHashes[atoi(&source.path.data[1])];
+            hash = HashData(hash, &content, sizeof(content));
+        }
+        else if (tag == 2) {
+            uint64_t length = source.path.length;
+            hash = HashData(hash, &length, sizeof(length));
+            hash = HashData(hash, source.path.data, source.path.length);
+        }
     }
 
-    return true;
+    // Zero marks textures that are not shared
+    return (hash != 0) ? hash : 1;
 }
 
-inline bool TextureLoader::LoadImageNormal(Image* image, const aiMaterial* material)
+inline uint64_t TextureLoader::HashData(uint64_t hash, const void* data, size_t size)
 {
-    return LoadImage(image, material, aiTextureType_NORMALS, 0, true);
+    // FNV-1a over 64-bit words, with a shift so high bits reach the low ones
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        hash = (hash ^ word) * 0x100000001B3ull;
+        hash ^= hash >> 29;
+    }
+    for (; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+    }
+
+    return hash;
 }
 
 inline NX_TextureWrap TextureLoader::GetWrapMode(aiTextureMapMode wrap)
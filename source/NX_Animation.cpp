@@ -6,12 +6,195 @@
  * For conditions of distribution and use, see accompanying LICENSE file.
  */
 
-#include <NX/NX_Animation.h>
+#include "./NX_Animation.hpp"
 
 #include <NX/NX_Filesystem.h>
 #include <NX/NX_Memory.h>
 
 #include "./Importer/AnimationImporter.hpp"
+#include "./Importer/ModelCache.hpp"
+
+// ============================================================================
+// INTERNAL FUNCTIONS
+// ============================================================================
+
+bool INX_InitAnimationClips(INX_AnimationLibData* data, const NX_AnimationLib* animLib)
+{
+    data->clips = NX_Calloc<INX_AnimationClip>(animLib->count);
+    if (data->clips == nullptr) {
+        return false;
+    }
+
+    uint32_t cursorOffset = 0;
+
+    for (int i = 0; i < animLib->count; i++)
+    {
+        const NX_Animation& anim = animLib->animations[i];
+        INX_AnimationClip& clip = data->clips[i];
+
+        clip.boneToChannel = NX_Malloc<int>(anim.boneCount);
+        clip.tracks = NX_Calloc<INX_AnimationTracks>(anim.channelCount);
+        if ((anim.boneCount > 0 && !clip.boneToChannel) || (anim.channelCount > 0 && !clip.tracks)) {
+            return false;
+        }
+
+        clip.firstCursor = cursorOffset;
+        cursorOffset += 3 * anim.channelCount;
+
+        for (int b = 0; b < anim.boneCount; b++) {
+            clip.boneToChannel[b] = -1;
+        }
+
+        // Like the previous linear search, the first channel of a bone wins
+        for (uint32_t j = 0; j < anim.channelCount; j++) {
+            int bone = anim.channels[j].boneIndex;
+            if (bone >= 0 && bone < anim.boneCount && clip.boneToChannel[bone] < 0) {
+                clip.boneToChannel[bone] = static_cast<int>(j);
+            }
+        }
+    }
+
+    data->cursorCount = cursorOffset;
+
+    return true;
+}
+
+INX_AnimationLibData* INX_CreateAnimationLibData(const NX_AnimationLib* animLib)
+{
+    /* --- Count the keys of the whole library --- */
+
+    size_t vec3KeyCount = 0;
+    size_t quatKeyCount = 0;
+
+    for (int i = 0; i < animLib->count; i++) {
+        const NX_Animation& anim = animLib->animations[i];
+        for (uint32_t j = 0; j < anim.channelCount; j++) {
+            const NX_AnimationChannel& channel = anim.channels[j];
+            vec3KeyCount += channel.positionKeyCount + channel.scaleKeyCount;
+            quatKeyCount += channel.rotationKeyCount;
+        }
+    }
+
+    /* --- Allocate the pools --- */
+
+    INX_AnimationLibData* data = NX_Calloc<INX_AnimationLibData>(1);
+    if (data == nullptr) {
+        return nullptr;
+    }
+
+    data->vec3Times = NX_Malloc<float>(vec3KeyCount);
+    data->vec3Values = NX_Malloc<NX_Vec3>(vec3KeyCount);
+    data->quatTimes = NX_Malloc<float>(quatKeyCount);
+    data->quatValues = NX_Malloc<NX_Quat>(quatKeyCount);
+    data->vec3KeyCount = static_cast<uint32_t>(vec3KeyCount);
+    data->quatKeyCount = static_cast<uint32_t>(quatKeyCount);
+
+    bool allocated = (vec3KeyCount == 0 || (data->vec3Times && data->vec3Values))
+                  && (quatKeyCount == 0 || (data->quatTimes && data->quatValues));
+
+    if (!allocated || !INX_InitAnimationClips(data, animLib)) {
+        NX_LOG(E, "RENDER: Failed to allocate the animation sampling data");
+        INX_DestroyAnimationLibData(data, animLib);
+        return nullptr;
+    }
+
+    /* --- Split times and values of each track --- */
+
+    uint32_t vec3Offset = 0;
+    uint32_t quatOffset = 0;
+
+    auto copyVec3 = [&](const NX_Vec3Key* keys, uint32_t count) {
+        INX_AnimationTrack track { vec3Offset, count, 0 };
+        for (uint32_t k = 0; k < count; k++) {
+            data->vec3Times[vec3Offset + k] = keys[k].time;
+            data->vec3Values[vec3Offset + k] = keys[k].value;
+        }
+        vec3Offset += count;
+        return track;
+    };
+
+    auto copyQuat = [&](const NX_QuatKey* keys, uint32_t count) {
+        INX_AnimationTrack track { quatOffset, count, 0 };
+        for (uint32_t k = 0; k < count; k++) {
+            data->quatTimes[quatOffset + k] = keys[k].time;
+            data->quatValues[quatOffset + k] = keys[k].value;
+        }
+        quatOffset += count;
+        return track;
+    };
+
+    for (int i = 0; i < animLib->count; i++) {
+        const NX_Animation& anim = animLib->animations[i];
+        for (uint32_t j = 0; j < anim.channelCount; j++) {
+            const NX_AnimationChannel& channel = anim.channels[j];
+            INX_AnimationTracks& tracks = data->clips[i].tracks[j];
+            tracks.translation = copyVec3(channel.positionKeys, channel.positionKeyCount);
+            tracks.rotation = copyQuat(channel.rotationKeys, channel.rotationKeyCount);
+            tracks.scale = copyVec3(channel.scaleKeys, channel.scaleKeyCount);
+        }
+    }
+
+    return data;
+}
+
+bool INX_EnsureAnimationLibData(const NX_AnimationLib* animLib)
+{
+    if (animLib->internal != nullptr) {
+        return true;
+    }
+
+    // The layout is a cache of the public keys, built on first use like the shader programs
+    INX_AnimationLibData* data = INX_CreateAnimationLibData(animLib);
+    if (data == nullptr) {
+        NX_LOG(E, "RENDER: Failed to build the sampling data of the animation library");
+        return false;
+    }
+
+    const_cast<NX_AnimationLib*>(animLib)->internal = data;
+
+    return true;
+}
+
+void INX_DestroyAnimationLibData(INX_AnimationLibData* data, const NX_AnimationLib* animLib)
+{
+    if (data == nullptr) {
+        return;
+    }
+
+    if (data->clips != nullptr) {
+        for (int i = 0; i < animLib->count; i++) {
+            NX_Free(data->clips[i].boneToChannel);
+            NX_Free(data->clips[i].tracks);
+        }
+    }
+
+    NX_Free(data->clips);
+    NX_Free(data->vec3Times);
+    NX_Free(data->vec3Values);
+    NX_Free(data->quatTimes);
+    NX_Free(data->quatValues);
+    NX_Free(data->quantizedTracks);
+    NX_Free(data->packedKeys);
+    NX_Free(data);
+}
+
+size_t INX_GetAnimationLibDataSize(const INX_AnimationLibData* data, const NX_AnimationLib* animLib)
+{
+    size_t size = sizeof(INX_AnimationLibData);
+
+    for (int i = 0; i < animLib->count; i++) {
+        const NX_Animation& anim = animLib->animations[i];
+        size += sizeof(INX_AnimationClip) + anim.boneCount * sizeof(int);
+        size += anim.channelCount * sizeof(INX_AnimationTracks);
+    }
+
+    size += data->vec3KeyCount * (sizeof(float) + sizeof(NX_Vec3));
+    size += data->quatKeyCount * (sizeof(float) + sizeof(NX_Quat));
+    size += data->quantizedTrackCount * sizeof(INX_QuantizedTrack);
+    size += data->packedKeyCount * 3 * sizeof(uint16_t);
+
+    return size;
+}
 
 // ============================================================================
 // PUBLIC API
@@ -33,12 +216,30 @@ NX_AnimationLib* NX_LoadAnimationLib(const char* filePath)
 
 NX_AnimationLib* NX_LoadAnimationLibFromData(const void* data, unsigned int size, const char* hint)
 {
-    import::SceneImporter importer(data, size, hint);
-    if (!importer.IsValid()) {
+    NX_AnimationLib* animLib = nullptr;
+
+    if (import::ModelCache::IsCache(data, size)) {
+        animLib = import::ModelCache::LoadAnimationLib(data, size);
+    }
+    else {
+        import::SceneImporter importer(data, size, hint);
+        if (!importer.IsValid()) {
+            return nullptr;
+        }
+        animLib = import::AnimationImporter(importer).LoadAnimationLib();
+    }
+
+    if (animLib == nullptr) {
         return nullptr;
     }
 
-    return import::AnimationImporter(importer).LoadAnimationLib();
+    animLib->internal = INX_CreateAnimationLibData(animLib);
+    if (animLib->internal == nullptr) {
+        NX_DestroyAnimationLib(animLib);
+        return nullptr;
+    }
+
+    return animLib;
 }
 
 void NX_DestroyAnimationLib(NX_AnimationLib* animLib)
@@ -47,6 +248,8 @@ void NX_DestroyAnimationLib(NX_AnimationLib* animLib)
         return;
     }
 
+    INX_DestroyAnimationLibData(animLib->internal, animLib);
+
     for (int i = 0; i < animLib->count; i++) {
         NX_Animation& anim = animLib->animations[i];
         for (int j = 0; j < anim.channelCount; j++) {
@@ -61,6 +264,46 @@ void NX_DestroyAnimationLib(NX_AnimationLib* animLib)
     INX_Pool.Destroy(animLib);
 }
 
+bool NX_CompressAnimationLib(NX_AnimationLib* animLib, float tolerance)
+{
+    if (!INX_EnsureAnimationLibData(animLib)) {
+        return false;
+    }
+
+    if (animLib->internal->compressed) {
+        return true;
+    }
+
+    INX_AnimationLibData* data = INX_CompressAnimationLibData(animLib, tolerance);
+    if (data == nullptr) {
+        return false;
+    }
+
+    size_t previousSize = INX_GetAnimationLibDataSize(animLib->internal, animLib);
+    size_t compressedSize = INX_GetAnimationLibDataSize(data, animLib);
+
+    INX_DestroyAnimationLibData(animLib->internal, animLib);
+    animLib->internal = data;
+
+    for (int i = 0; i < animLib->count; i++) {
+        NX_Animation& anim = animLib->animations[i];
+        for (uint32_t j = 0; j < anim.channelCount; j++) {
+            NX_AnimationChannel& channel = anim.channels[j];
+            previousSize += channel.positionKeyCount * sizeof(NX_Vec3Key);
+            previousSize += channel.rotationKeyCount * sizeof(NX_QuatKey);
+            previousSize += channel.scaleKeyCount * sizeof(NX_Vec3Key);
+            NX_Free(channel.positionKeys);
+            NX_Free(channel.rotationKeys);
+            NX_Free(channel.scaleKeys);
+            channel = NX_AnimationChannel { .boneIndex = channel.boneIndex };
+        }
+    }
+
+    NX_LOG(D, "RENDER: Animation library compressed from %zu to %zu bytes", previousSize, compressedSize);
+
+    return true;
+}
+
 int NX_GetAnimationIndex(const NX_AnimationLib* animLib, const char* name)
 {
     for (int i = 0; i < animLib->count; i++) {
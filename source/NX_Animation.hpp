@@ -0,0 +1,201 @@
+/* NX_Animation.hpp -- API definition for Nexium's animation module
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef NX_ANIMATION_HPP
+#define NX_ANIMATION_HPP
+
+#include <NX/NX_Animation.h>
+#include <NX/NX_Math.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+
+// ============================================================================
+// INTERNAL TYPES
+// ============================================================================
+
+/** Keyframes of one component of a channel, a range in the library pools */
+struct INX_AnimationTrack {
+    uint32_t firstKey;                  //< In the float pools, or index of the quantized track
+    uint32_t keyCount : 31;
+    uint32_t quantized : 1;             //< Stored as an 'INX_QuantizedTrack'
+};
+
+/**
+ * Compressed track, keys are uniformly spaced in time so only their values are
+ * stored, as three 16-bit words each. Rotations use the smallest three encoding,
+ * vectors are quantized over the range of the track.
+ */
+struct INX_QuantizedTrack {
+    uint32_t firstKey;                  //< In the packed pool, three words per key
+    uint32_t keyCount;
+    float startTime;                    //< Time of the first key
+    float invStep;                      //< Inverse of the time between two keys
+    NX_Vec3 rangeMin;                   //< Vector tracks, value of the zero word
+    NX_Vec3 rangeStep;                  //< Vector tracks, value difference between two consecutive words
+};
+
+struct INX_AnimationTracks {
+    INX_AnimationTrack translation;     //< In the Vec3 pools
+    INX_AnimationTrack rotation;        //< In the Quat pools
+    INX_AnimationTrack scale;           //< In the Vec3 pools
+};
+
+struct INX_AnimationClip {
+    int* boneToChannel;                 //< One entry per bone of the animation, -1 if not animated
+    INX_AnimationTracks* tracks;        //< One entry per channel
+    uint32_t firstCursor;               //< First of the three key cursors of each channel in a player
+};
+
+/**
+ * Sampling layout of a library, built once when loaded. Key times and values
+ * are stored in separate contiguous arrays, so that seeking a key only walks
+ * through times and interpolating only reads the two values it needs.
+ */
+struct INX_AnimationLibData {
+    INX_AnimationClip* clips;           //< One entry per animation
+
+    float* vec3Times;
+    NX_Vec3* vec3Values;
+    float* quatTimes;
+    NX_Quat* quatValues;
+
+    INX_QuantizedTrack* quantizedTracks;
+    uint16_t* packedKeys;
+
+    uint32_t vec3KeyCount;
+    uint32_t quatKeyCount;
+    uint32_t quantizedTrackCount;
+    uint32_t packedKeyCount;            //< Number of keys, each taking three words
+
+    uint32_t cursorCount;               //< Number of key cursors a player needs
+    bool compressed;                    //< Built by compression, the channel keys are released
+};
+
+// ============================================================================
+// INTERNAL FUNCTIONS
+// ============================================================================
+
+/** Allocates the clips of the layout, with their bone to channel tables and cursor offsets */
+bool INX_InitAnimationClips(INX_AnimationLibData* data, const NX_AnimationLib* animLib);
+
+/** Builds the sampling layout of the library animations, returns null on failure */
+INX_AnimationLibData* INX_CreateAnimationLibData(const NX_AnimationLib* animLib);
+
+/** Builds the layout of a library whose 'internal' is still null (filled by hand), returns false on failure */
+bool INX_EnsureAnimationLibData(const NX_AnimationLib* animLib);
+
+/** Builds a compressed sampling layout, keys within 'tolerance' of the originals, returns null on failure */
+INX_AnimationLibData* INX_CompressAnimationLibData(const NX_AnimationLib* animLib, float tolerance);
+
+/** Releases data created with 'INX_CreateAnimationLibData' or 'INX_CompressAnimationLibData' */
+void INX_DestroyAnimationLibData(INX_AnimationLibData* data, const NX_AnimationLib* animLib);
+
+/** Returns the memory used by the keys and tracks of the sampling layout, in bytes */
+size_t INX_GetAnimationLibDataSize(const INX_AnimationLibData* data, const NX_AnimationLib* animLib);
+
+// ============================================================================
+// KEY QUANTIZATION
+// ============================================================================
+
+/** Range of the three smallest components of a unit quaternion */
+static constexpr float INX_QuatSmallestRange = 1.41421356f;
+
+inline void INX_PackQuat(uint16_t out[3], NX_Quat q)
+{
+    const float c[4] = { q.x, q.y, q.z, q.w };
+
+    int largest = 0;
+    for (int i = 1; i < 4; i++) {
+        if (std::fabs(c[i]) > std::fabs(c[largest])) largest = i;
+    }
+
+    // q and -q are the same rotation, so the dropped component is made positive
+    const float sign = (c[largest] < 0.0f) ? -1.0f : 1.0f;
+
+    for (int i = 0, j = 0; i < 4; i++) {
+        if (i == largest) continue;
+        float v = (sign * c[i] / INX_QuatSmallestRange + 0.5f) * 32767.0f;
+        v = (v < 0.0f) ? 0.0f : (v > 32767.0f) ? 32767.0f : v;
+        out[j++] = static_cast<uint16_t>(v + 0.5f);
+    }
+
+    // The index of the dropped component goes in the spare bit of two words
+    out[0] |= static_cast<uint16_t>((largest & 1) << 15);
+    out[1] |= static_cast<uint16_t>((largest >> 1) << 15);
+}
+
+inline NX_Quat INX_UnpackQuat(const uint16_t in[3])
+{
+    const int largest = (in[0] >> 15) | ((in[1] >> 15) << 1);
+
+    float s[3];
+    for (int i = 0; i < 3; i++) {
+        s[i] = ((in[i] & 0x7FFF) / 32767.0f - 0.5f) * INX_QuatSmallestRange;
+    }
+
+    float w = 1.0f - (s[0] * s[0] + s[1] * s[1] + s[2] * s[2]);
+    w = (w > 0.0f) ? std::sqrt(w) : 0.0f;
+
+    float c[4];
+    for (int i = 0, j = 0; i < 4; i++) {
+        c[i] = (i == largest) ? w : s[j++];
+    }
+
+    return NX_QUAT(c[0], c[1], c[2], c[3]);
+}
+
+inline void INX_PackVec3(uint16_t out[3], NX_Vec3 v, const INX_QuantizedTrack& track)
+{
+    const float c[3] = { v.x, v.y, v.z };
+    const float min[3] = { track.rangeMin.x, track.rangeMin.y, track.rangeMin.z };
+    const float step[3] = { track.rangeStep.x, track.rangeStep.y, track.rangeStep.z };
+
+    for (int i = 0; i < 3; i++) {
+        float q = (step[i] > 0.0f) ? (c[i] - min[i]) / step[i] : 0.0f;
+        q = (q < 0.0f) ? 0.0f : (q > 65535.0f) ? 65535.0f : q;
+        out[i] = static_cast<uint16_t>(q + 0.5f);
+    }
+}
+
+inline NX_Vec3 INX_UnpackVec3(const uint16_t in[3], const INX_QuantizedTrack& track)
+{
+    return NX_VEC3(
+        track.rangeMin.x + in[0] * track.rangeStep.x,
+        track.rangeMin.y + in[1] * track.rangeStep.y,
+        track.rangeMin.z + in[2] * track.rangeStep.z
+    );
+}
+
+/** Same keys and factor as a search in the original track, found in constant time */
+inline float INX_FindQuantizedKeys(const INX_QuantizedTrack& track, float time, uint32_t* outIdx0, uint32_t* outIdx1)
+{
+    const float x = (time - track.startTime) * track.invStep;
+    const uint32_t last = track.keyCount - 1;
+
+    if (track.keyCount == 1 || x <= 0.0f) {
+        *outIdx0 = *outIdx1 = 0;
+        return 0.0f;
+    }
+
+    if (x >= static_cast<float>(last)) {
+        *outIdx0 = *outIdx1 = last;
+        return 0.0f;
+    }
+
+    uint32_t idx0 = static_cast<uint32_t>(x);
+    if (idx0 >= last) idx0 = last - 1;
+
+    *outIdx0 = idx0;
+    *outIdx1 = idx0 + 1;
+
+    return x - idx0;
+}
+
+#endif // NX_ANIMATION_HPP
@@ -3,130 +3,282 @@
 #include <NX/NX_Math.h>
 
 #include "./INX_GlobalPool.hpp"
+#include "./INX_JobSystem.hpp"
+
+#include "./NX_Animation.hpp"
+
+// ============================================================================
+// INTERNAL TYPES
+// ============================================================================
+
+/** Number of floats per bone in the local and blended poses: translation, rotation, scale */
+static constexpr int INX_PoseComponents = 10;
+
+struct INX_AnimationLODLevel {
+    float maxScreenSize;
+    int updateInterval;
+    uint8_t* boneMask;                  //< One entry per bone, null when all bones are evaluated
+};
+
+/**
+ * Playback data of a player. Poses are stored component by component
+ * (all translation X, then all translation Y, ...) so that weighting and
+ * normalizing them are plain loops over contiguous floats.
+ */
+struct INX_AnimationPlayerData {
+    uint32_t* cursors;                  //< Last left key of each track, indexed from 'INX_AnimationClip::firstCursor'
+    float* local;                       //< Sampled pose of the current animation, zero for bones without channel
+    float* blend;                       //< Weighted sum of the sampled poses
+    uint8_t* animated;                  //< Non-zero for bones affected by at least one weighted animation
+
+    /* --- Level of detail --- */
+
+    INX_AnimationLODLevel* lods;        //< Copy of the levels, from the most to the least detailed
+    int lodCount;
+    int lodLevel;                       //< Active level, -1 for full detail
+
+    float* prevBlend;                   //< Pose evaluated at the start of the current interval
+    float* nextBlend;                   //< Pose evaluated ahead, at the end of the current interval
+    uint8_t* prevAnimated;
+    uint8_t* nextAnimated;
+    int lodFrame;                       //< Updates since the last evaluation, -1 when both poses must be evaluated again
+};
 
 // ============================================================================
 // INTERNAL INTERPOLATION FUNCTIONS
 // ============================================================================
 
-template <typename T>
-void INX_FindKeyFrames(const T* keys, uint32_t keyCount, float time,
-                       uint32_t* outIdx0, uint32_t* outIdx1, float* outT)
+/**
+ * Same result as a binary search for the keys surrounding 'time', but starts
+ * from the key found during the previous update. Playback usually advances
+ * by less than a key per frame, so the search rarely goes past the first steps.
+ */
+static float INX_SeekKeyFrames(const float* times, uint32_t keyCount, float time,
+                               uint32_t* cursor, uint32_t* outIdx0, uint32_t* outIdx1)
 {
-    if (keyCount == 0) {
+    if (keyCount == 1 || time <= times[0]) {
         *outIdx0 = *outIdx1 = 0;
-        *outT = 0.0f;
-        return;
+        return 0.0f;
     }
 
-    if (keyCount == 1 || time <= keys[0].time) {
-        *outIdx0 = *outIdx1 = 0;
-        *outT = 0.0f;
-        return;
+    const uint32_t last = keyCount - 1;
+
+    if (time >= times[last]) {
+        *outIdx0 = *outIdx1 = last;
+        return 0.0f;
     }
 
-    if (time >= keys[keyCount - 1].time) {
-        *outIdx0 = *outIdx1 = keyCount - 1;
-        *outT = 0.0f;
-        return;
+    // Here times[0] < time < times[last], so the left key is in [0, last)
+    uint32_t left = (*cursor < last) ? *cursor : 0;
+
+    if (times[left] > time) {
+        left = 0; //< Rewound or looped, search from the start
     }
 
-    uint32_t left = 0;
-    uint32_t right = keyCount - 1;
+    uint32_t steps = 0;
+    while (times[left + 1] <= time && steps < 4) {
+        left++, steps++;
+    }
 
-    while (right - left > 1) {
-        uint32_t mid = (left + right) / 2;
-        if (keys[mid].time <= time) left = mid;
-        else right = mid;
+    if (times[left + 1] <= time) {
+        uint32_t right = last;
+        while (right - left > 1) {
+            uint32_t mid = (left + right) / 2;
+            if (times[mid] <= time) left = mid;
+            else right = mid;
+        }
     }
 
+    *cursor = left;
     *outIdx0 = left;
-    *outIdx1 = right;
+    *outIdx1 = left + 1;
 
-    float t0 = keys[*outIdx0].time;
-    float t1 = keys[*outIdx1].time;
-    float delta = t1 - t0;
+    float t0 = times[left];
+    float delta = times[left + 1] - t0;
 
-    *outT = (delta > 0.0f) ? (time - t0) / delta : 0.0f;
+    return (delta > 0.0f) ? (time - t0) / delta : 0.0f;
 }
 
-static NX_Transform INX_InterpolateChannel(const NX_AnimationChannel* channel, float time)
+static NX_Vec3 INX_SampleVec3(const INX_AnimationLibData& data, const INX_AnimationTrack& track,
+                              float time, uint32_t* cursor, NX_Vec3 fallback)
 {
-    NX_Transform result = NX_TRANSFORM_IDENTITY;
+    if (track.keyCount == 0) {
+        return fallback;
+    }
 
-    if (channel->positionKeyCount > 0) {
+    if (track.quantized) {
+        const INX_QuantizedTrack& quantized = data.quantizedTracks[track.firstKey];
+        const uint16_t* keys = data.packedKeys + 3 * quantized.firstKey;
         uint32_t idx0, idx1;
-        float t;
-        INX_FindKeyFrames(channel->positionKeys, channel->positionKeyCount, time, &idx0, &idx1, &t);
-        const NX_Vec3& v0 = channel->positionKeys[idx0].value;
-        const NX_Vec3& v1 = channel->positionKeys[idx1].value;
-        result.translation = NX_Vec3Lerp(v0, v1, t);
+        float t = INX_FindQuantizedKeys(quantized, time, &idx0, &idx1);
+        return NX_Vec3Lerp(INX_UnpackVec3(&keys[3 * idx0], quantized), INX_UnpackVec3(&keys[3 * idx1], quantized), t);
     }
 
-    if (channel->rotationKeyCount > 0) {
-        uint32_t idx0, idx1;
-        float t;
-        INX_FindKeyFrames(channel->rotationKeys, channel->rotationKeyCount, time, &idx0, &idx1, &t);
-        const NX_Quat& q0 = channel->rotationKeys[idx0].value;
-        const NX_Quat& q1 = channel->rotationKeys[idx1].value;
-        result.rotation = NX_QuatSLerp(q0, q1, t);
+    uint32_t idx0, idx1;
+    float t = INX_SeekKeyFrames(data.vec3Times + track.firstKey, track.keyCount, time, cursor, &idx0, &idx1);
+    const NX_Vec3* values = data.vec3Values + track.firstKey;
+
+    return NX_Vec3Lerp(values[idx0], values[idx1], t);
+}
+
+static NX_Quat INX_SampleQuat(const INX_AnimationLibData& data, const INX_AnimationTrack& track,
+                              float time, uint32_t* cursor)
+{
+    if (track.keyCount == 0) {
+        return NX_QUAT_IDENTITY;
     }
 
-    if (channel->scaleKeyCount > 0) {
+    if (track.quantized) {
+        const INX_QuantizedTrack& quantized = data.quantizedTracks[track.firstKey];
+        const uint16_t* keys = data.packedKeys + 3 * quantized.firstKey;
         uint32_t idx0, idx1;
-        float t;
-        INX_FindKeyFrames(channel->scaleKeys, channel->scaleKeyCount, time, &idx0, &idx1, &t);
-        const NX_Vec3& s0 = channel->scaleKeys[idx0].value;
-        const NX_Vec3& s1 = channel->scaleKeys[idx1].value;
-        result.scale = NX_Vec3Lerp(s0, s1, t);
+        float t = INX_FindQuantizedKeys(quantized, time, &idx0, &idx1);
+        return NX_QuatSLerp(INX_UnpackQuat(&keys[3 * idx0]), INX_UnpackQuat(&keys[3 * idx1]), t);
     }
 
-    return result;
+    uint32_t idx0, idx1;
+    float t = INX_SeekKeyFrames(data.quatTimes + track.firstKey, track.keyCount, time, cursor, &idx0, &idx1);
+    const NX_Quat* values = data.quatValues + track.firstKey;
+
+    return NX_QuatSLerp(values[idx0], values[idx1], t);
 }
 
 // ============================================================================
 // INTERNAL POSE COMPUTATION
 // ============================================================================
 
-static const NX_AnimationChannel* INX_FindChannelForBone(const NX_Animation& anim, int iBone)
+static void INX_SampleAnimation(NX_AnimationPlayer& player, int iAnim, float time,
+                                const uint8_t* boneMask, uint8_t* animated)
 {
-    for (int i = 0; i < anim.channelCount; i++) {
-        if (anim.channels[i].boneIndex == iBone) {
-            return &anim.channels[i];
+    const INX_AnimationLibData& data = *player.animLib->internal;
+    const INX_AnimationClip& clip = data.clips[iAnim];
+    const int animBoneCount = player.animLib->animations[iAnim].boneCount;
+
+    const int boneCount = player.skeleton->boneCount;
+    float* local = player.internal->local;
+
+    for (int iBone = 0; iBone < boneCount; iBone++)
+    {
+        int iChannel = (iBone < animBoneCount) ? clip.boneToChannel[iBone] : -1;
+
+        // Masked out bones are handled like bones without channel and keep their bind pose
+        if (boneMask != nullptr && boneMask[iBone] == 0) {
+            iChannel = -1;
         }
+
+        if (iChannel < 0) {
+            for (int c = 0; c < INX_PoseComponents; c++) {
+                local[c * boneCount + iBone] = 0.0f;
+            }
+            continue;
+        }
+
+        const INX_AnimationTracks& tracks = clip.tracks[iChannel];
+        uint32_t* cursors = player.internal->cursors + clip.firstCursor + 3 * iChannel;
+
+        NX_Vec3 translation = INX_SampleVec3(data, tracks.translation, time, &cursors[0], NX_VEC3_ZERO);
+        NX_Quat rotation = INX_SampleQuat(data, tracks.rotation, time, &cursors[1]);
+        NX_Vec3 scale = INX_SampleVec3(data, tracks.scale, time, &cursors[2], NX_VEC3_ONE);
+
+        local[0 * boneCount + iBone] = translation.x;
+        local[1 * boneCount + iBone] = translation.y;
+        local[2 * boneCount + iBone] = translation.z;
+        local[3 * boneCount + iBone] = rotation.x;
+        local[4 * boneCount + iBone] = rotation.y;
+        local[5 * boneCount + iBone] = rotation.z;
+        local[6 * boneCount + iBone] = rotation.w;
+        local[7 * boneCount + iBone] = scale.x;
+        local[8 * boneCount + iBone] = scale.y;
+        local[9 * boneCount + iBone] = scale.z;
+
+        animated[iBone] = 1;
     }
-    return nullptr;
 }
 
-static void INX_ComputePose(NX_AnimationPlayer& player, float totalWeight)
+static float INX_WrapStateTime(const NX_AnimationState& state, const NX_Animation& anim, float time)
+{
+    float durationInSeconds = anim.duration / anim.ticksPerSecond;
+
+    if (time >= durationInSeconds) {
+        time = state.loop ? std::fmod(time, durationInSeconds) : durationInSeconds;
+    }
+
+    return time;
+}
+
+static void INX_EvaluatePose(NX_AnimationPlayer& player, float totalWeight, float timeAhead,
+                             const uint8_t* boneMask, float* blend, uint8_t* animated)
 {
     const int boneCount = player.skeleton->boneCount;
     const int animCount = player.animLib->count;
+    const int floatCount = INX_PoseComponents * boneCount;
     NX_AnimationState* states = player.states;
 
-    for (int iBone = 0; iBone < boneCount; iBone++)
+    const float* local = player.internal->local;
+
+    SDL_memset(blend, 0, floatCount * sizeof(float));
+    SDL_memset(animated, 0, boneCount * sizeof(uint8_t));
+
+    for (int iAnim = 0; iAnim < animCount; iAnim++)
     {
-        NX_Transform blended{};
-        bool isAnimated{false};
+        const NX_Animation& anim = player.animLib->animations[iAnim];
+        const NX_AnimationState& state = states[iAnim];
+        if (state.weight <= 0.0f) continue;
+
+        float time = state.currentTime;
+        if (timeAhead > 0.0f) {
+            time = INX_WrapStateTime(state, anim, time + timeAhead);
+        }
+
+        INX_SampleAnimation(player, iAnim, time * anim.ticksPerSecond, boneMask, animated);
+
+        const float w = state.weight / totalWeight;
+        for (int i = 0; i < floatCount; i++) {
+            blend[i] += local[i] * w;
+        }
+    }
+}
 
-        for (int iAnim = 0; iAnim < animCount; iAnim++)
-        {
-            const NX_Animation& anim = player.animLib->animations[iAnim];
-            const NX_AnimationState& state = states[iAnim];
-            if (state.weight <= 0.0f) continue;
+static void INX_InterpolatePose(NX_AnimationPlayer& player, float t)
+{
+    const int boneCount = player.skeleton->boneCount;
+    INX_AnimationPlayerData& data = *player.internal;
 
-            const NX_AnimationChannel* channel = INX_FindChannelForBone(anim, iBone);
-            if (!channel) continue;
-            isAnimated = true;
+    const float* prev = data.prevBlend;
+    const float* next = data.nextBlend;
+    float* blend = data.blend;
 
-            NX_Transform local = INX_InterpolateChannel(channel, state.currentTime * anim.ticksPerSecond);
-            float w = state.weight / totalWeight;
+    for (int i = 0; i < INX_PoseComponents * boneCount; i++) {
+        blend[i] = prev[i] + (next[i] - prev[i]) * t;
+    }
 
-            blended.translation += local.translation * w;
-            blended.rotation += local.rotation * w;
-            blended.scale += local.scale * w;
+    // Rotations are summed quaternions, take the shortest path between both
+    for (int iBone = 0; iBone < boneCount; iBone++) {
+        float dot = 0.0f;
+        for (int c = 3; c < 7; c++) {
+            dot += prev[c * boneCount + iBone] * next[c * boneCount + iBone];
         }
+        if (dot < 0.0f) {
+            for (int c = 3; c < 7; c++) {
+                int i = c * boneCount + iBone;
+                blend[i] = prev[i] - (next[i] + prev[i]) * t;
+            }
+        }
+    }
+}
 
-        if (isAnimated) {
+static void INX_ComposePose(NX_AnimationPlayer& player, const float* blend, const uint8_t* animated)
+{
+    const int boneCount = player.skeleton->boneCount;
+
+    for (int iBone = 0; iBone < boneCount; iBone++)
+    {
+        if (animated[iBone]) {
+            NX_Transform blended = {
+                .translation = NX_VEC3(blend[0 * boneCount + iBone], blend[1 * boneCount + iBone], blend[2 * boneCount + iBone]),
+                .rotation = NX_QUAT(blend[3 * boneCount + iBone], blend[4 * boneCount + iBone], blend[5 * boneCount + iBone], blend[6 * boneCount + iBone]),
+                .scale = NX_VEC3(blend[7 * boneCount + iBone], blend[8 * boneCount + iBone], blend[9 * boneCount + iBone]),
+            };
             blended.rotation = NX_QuatNormalize(blended.rotation);
             player.currentPose[iBone] = NX_TransformToMat4(&blended);
         }
@@ -146,12 +298,130 @@ static void INX_ComputePose(NX_AnimationPlayer& player, float totalWeight)
     }
 }
 
+static void INX_ComputePose(NX_AnimationPlayer& player, float totalWeight, float dt)
+{
+    INX_AnimationPlayerData& data = *player.internal;
+
+    const INX_AnimationLODLevel* lod = (data.lodLevel >= 0) ? &data.lods[data.lodLevel] : nullptr;
+    const uint8_t* boneMask = lod ? lod->boneMask : nullptr;
+    const int interval = lod ? lod->updateInterval : 1;
+
+    /* --- Full rate, evaluate the pose of this update --- */
+
+    if (interval <= 1) {
+        INX_EvaluatePose(player, totalWeight, 0.0f, boneMask, data.blend, data.animated);
+        INX_ComposePose(player, data.blend, data.animated);
+        return;
+    }
+
+    /* --- Throttled, evaluate the pose at the end of the interval when entering it --- */
+
+    // The pose evaluated ahead for the end of the previous interval starts the new
+    // one, so that each interval costs a single evaluation and adds no latency
+
+    if (data.lodFrame < 0 || data.lodFrame >= interval)
+    {
+        if (data.lodFrame < 0) {
+            INX_EvaluatePose(player, totalWeight, 0.0f, boneMask, data.nextBlend, data.nextAnimated);
+        }
+
+        std::swap(data.prevBlend, data.nextBlend);
+        std::swap(data.prevAnimated, data.nextAnimated);
+
+        INX_EvaluatePose(player, totalWeight, interval * dt, boneMask, data.nextBlend, data.nextAnimated);
+
+        // Bones animated in only one of both poses take the other pose as is
+        const int boneCount = player.skeleton->boneCount;
+        for (int iBone = 0; iBone < boneCount; iBone++) {
+            if (data.prevAnimated[iBone] == data.nextAnimated[iBone]) {
+                data.animated[iBone] = data.prevAnimated[iBone];
+                continue;
+            }
+            float* src = data.prevAnimated[iBone] ? data.prevBlend : data.nextBlend;
+            float* dst = data.prevAnimated[iBone] ? data.nextBlend : data.prevBlend;
+            for (int c = 0; c < INX_PoseComponents; c++) {
+                dst[c * boneCount + iBone] = src[c * boneCount + iBone];
+            }
+            data.animated[iBone] = 1;
+        }
+
+        data.lodFrame = 0;
+    }
+
+    INX_InterpolatePose(player, static_cast<float>(data.lodFrame) / interval);
+    INX_ComposePose(player, data.blend, data.animated);
+
+    data.lodFrame++;
+}
+
+static float INX_GetScreenSize(const NX_Camera& camera, const NX_BoundingBox3D& aabb, const NX_Transform& transform)
+{
+    NX_Vec3 center = (aabb.min + aabb.max) * 0.5f;
+    NX_Vec3 extents = (aabb.max - aabb.min) * 0.5f;
+
+    float maxScale = NX_MAX3(std::fabs(transform.scale.x), std::fabs(transform.scale.y), std::fabs(transform.scale.z));
+    float radius = NX_Vec3Length(extents) * maxScale;
+
+    center = transform.translation + NX_Vec3Rotate(center * transform.scale, transform.rotation);
+
+    if (camera.projection == NX_PROJECTION_ORTHOGRAPHIC) {
+        return (camera.fov > 0.0f) ? radius / camera.fov : 1.0f;
+    }
+
+    float distance = NX_Vec3Distance(center, camera.position);
+    if (distance <= radius) {
+        return 1.0f;
+    }
+
+    // Fraction of the screen height covered by the bounding sphere
+    return radius / (distance * std::tan(0.5f * camera.fov));
+}
+
+// ============================================================================
+// INTERNAL UPDATE
+// ============================================================================
+
+static void INX_UpdatePlayer(NX_AnimationPlayer* player, float dt)
+{
+    const int boneCount = player->skeleton->boneCount;
+    const int animCount = player->animLib->count;
+
+    NX_AnimationState* states = player->states;
+    NX_Mat4* pose = player->currentPose;
+
+    float totalWeight = 0.0f;
+    for (int iAnim = 0; iAnim < animCount; iAnim++) {
+        totalWeight += states[iAnim].weight;
+    }
+
+    if (totalWeight <= 0.0f) {
+        SDL_memcpy(pose, player->skeleton->bindPose, boneCount * sizeof(NX_Mat4));
+        player->internal->lodFrame = -1;
+    }
+    else {
+        INX_ComputePose(*player, totalWeight, dt);
+    }
+
+    if (player->skinningPose != nullptr) {
+        NX_Mat4MulBatch(player->skinningPose, player->skeleton->boneOffsets, pose, boneCount);
+    }
+
+    for (int iAnim = 0; iAnim < animCount; iAnim++) {
+        NX_AnimationState& state = states[iAnim];
+        state.currentTime = INX_WrapStateTime(state, player->animLib->animations[iAnim], state.currentTime + dt);
+    }
+}
+
 // ============================================================================
 // PUBLIC API
 // ============================================================================
 
 NX_AnimationPlayer* NX_CreateAnimationPlayer(const NX_Skeleton* skeleton, const NX_AnimationLib* animLib)
 {
+    if (!INX_EnsureAnimationLibData(animLib)) {
+        return nullptr;
+    }
+
     NX_AnimationPlayer* player = INX_Pool.Create<NX_AnimationPlayer>();
 
     player->skeleton = skeleton;
@@ -160,50 +430,178 @@ NX_AnimationPlayer* NX_CreateAnimationPlayer(const NX_Skeleton* skeleton, const
     player->states = NX_Calloc<NX_AnimationState>(animLib->count);
     player->currentPose = NX_Calloc<NX_Mat4>(skeleton->boneCount);
 
+    player->internal = NX_Calloc<INX_AnimationPlayerData>(1);
+    player->internal->cursors = NX_Calloc<uint32_t>(animLib->internal->cursorCount);
+    player->internal->local = NX_Calloc<float>(INX_PoseComponents * skeleton->boneCount);
+    player->internal->blend = NX_Calloc<float>(INX_PoseComponents * skeleton->boneCount);
+    player->internal->animated = NX_Calloc<uint8_t>(skeleton->boneCount);
+    player->internal->lodLevel = -1;
+    player->internal->lodFrame = -1;
+
     return player;
 }
 
 void NX_DestroyAnimationPlayer(NX_AnimationPlayer* player)
 {
+    NX_SetAnimationPlayerLODs(player, nullptr, 0);
+
+    NX_Free(player->internal->animated);
+    NX_Free(player->internal->blend);
+    NX_Free(player->internal->local);
+    NX_Free(player->internal->cursors);
+    NX_Free(player->internal);
+
+    NX_Free(player->skinningPose);
     NX_Free(player->currentPose);
     NX_Free(player->states);
 
     INX_Pool.Destroy(player);
 }
 
+void NX_SetAnimationPlayerSkinning(NX_AnimationPlayer* player, bool enabled)
+{
+    if (enabled == (player->skinningPose != nullptr)) {
+        return;
+    }
+
+    if (!enabled) {
+        NX_Free(player->skinningPose);
+        player->skinningPose = nullptr;
+        return;
+    }
+
+    const int boneCount = player->skeleton->boneCount;
+
+    player->skinningPose = NX_Malloc<NX_Mat4>(boneCount);
+    if (player->skinningPose == nullptr) {
+        NX_LOG(E, "RENDER: Failed to allocate the skinning matrices of an animation player");
+        return;
+    }
+
+    // Valid until the next update, like the current pose
+    NX_Mat4MulBatch(player->skinningPose, player->skeleton->boneOffsets, player->currentPose, boneCount);
+}
+
 void NX_UpdateAnimationPlayer(NX_AnimationPlayer* player, float dt)
 {
+    INX_UpdatePlayer(player, dt);
+}
+
+void NX_UpdateAnimationPlayers(NX_AnimationPlayer* const* players, int count, float dt)
+{
+    if (players == nullptr || count <= 0) {
+        return;
+    }
+
+    // Players only write to their own data, so they can be updated in any order
+    constexpr size_t grainSize = 2;
+
+    INX_Jobs.ParallelFor(static_cast<size_t>(count), grainSize, [players, dt](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            INX_UpdatePlayer(players[i], dt);
+        }
+    });
+}
+
+void NX_SetAnimationPlayerLODs(NX_AnimationPlayer* player, const NX_AnimationLOD* lods, int count)
+{
+    INX_AnimationPlayerData& data = *player->internal;
     const int boneCount = player->skeleton->boneCount;
-    const int animCount = player->animLib->count;
 
-    NX_AnimationState* states = player->states;
-    NX_Mat4* pose = player->currentPose;
+    /* --- Release the previous levels --- */
 
-    float totalWeight = 0.0f;
-    for (int iAnim = 0; iAnim < animCount; iAnim++) {
-        totalWeight += states[iAnim].weight;
+    for (int i = 0; i < data.lodCount; i++) {
+        NX_Free(data.lods[i].boneMask);
     }
 
-    if (totalWeight <= 0.0f) {
-        SDL_memcpy(pose, player->skeleton->bindPose, boneCount * sizeof(NX_Mat4));
+    NX_Free(data.lods);
+    NX_Free(data.prevBlend);
+    NX_Free(data.nextBlend);
+    NX_Free(data.prevAnimated);
+    NX_Free(data.nextAnimated);
+
+    data.lods = nullptr;
+    data.prevBlend = data.nextBlend = nullptr;
+    data.prevAnimated = data.nextAnimated = nullptr;
+    data.lodCount = 0;
+    data.lodLevel = -1;
+    data.lodFrame = -1;
+
+    if (lods == nullptr || count <= 0) {
+        return;
     }
-    else {
-        INX_ComputePose(*player, totalWeight);
+
+    /* --- Copy the new ones --- */
+
+    data.lods = NX_Calloc<INX_AnimationLODLevel>(count);
+    if (data.lods == nullptr) {
+        NX_LOG(E, "RENDER: Failed to allocate the animation levels of detail");
+        return;
     }
 
-    for (int iAnim = 0; iAnim < animCount; iAnim++)
-    {
-        const NX_Animation& anim = player->animLib->animations[iAnim];
-        NX_AnimationState& state = states[iAnim];
+    bool throttled = false;
 
-        state.currentTime += dt;
+    for (int i = 0; i < count; i++)
+    {
+        INX_AnimationLODLevel& level = data.lods[i];
+        level.maxScreenSize = lods[i].maxScreenSize;
+        level.updateInterval = NX_MAX(lods[i].updateInterval, 1);
+        throttled |= (level.updateInterval > 1);
+
+        if (lods[i].boneMask != nullptr) {
+            level.boneMask = NX_Malloc<uint8_t>(boneCount);
+            if (level.boneMask == nullptr) continue; //< Falls back to all bones
+            for (int iBone = 0; iBone < boneCount; iBone++) {
+                level.boneMask[iBone] = lods[i].boneMask[iBone] ? 1 : 0;
+            }
+        }
+    }
 
-        float durationInSeconds = anim.duration / anim.ticksPerSecond;
+    data.lodCount = count;
 
-        if (state.currentTime >= durationInSeconds) {
-            state.currentTime = state.loop
-                ? std::fmod(state.currentTime, durationInSeconds)
-                : durationInSeconds;
+    if (throttled) {
+        data.prevBlend = NX_Calloc<float>(INX_PoseComponents * boneCount);
+        data.nextBlend = NX_Calloc<float>(INX_PoseComponents * boneCount);
+        data.prevAnimated = NX_Calloc<uint8_t>(boneCount);
+        data.nextAnimated = NX_Calloc<uint8_t>(boneCount);
+        if (!data.prevBlend || !data.nextBlend || !data.prevAnimated || !data.nextAnimated) {
+            NX_LOG(E, "RENDER: Failed to allocate the animation levels of detail");
+            NX_SetAnimationPlayerLODs(player, nullptr, 0);
         }
     }
 }
+
+void NX_SetAnimationPlayerLOD(NX_AnimationPlayer* player, int level)
+{
+    INX_AnimationPlayerData& data = *player->internal;
+
+    level = (level >= data.lodCount) ? data.lodCount - 1 : NX_MAX(level, -1);
+    if (level == data.lodLevel) {
+        return;
+    }
+
+    data.lodLevel = level;
+    data.lodFrame = -1;
+}
+
+int NX_GetAnimationPlayerLOD(const NX_AnimationPlayer* player)
+{
+    return player->internal->lodLevel;
+}
+
+int NX_SelectAnimationPlayerLOD(NX_AnimationPlayer* player, const NX_Camera* camera,
+                                const NX_BoundingBox3D* aabb, const NX_Transform* transform)
+{
+    const INX_AnimationPlayerData& data = *player->internal;
+
+    float screenSize = INX_GetScreenSize(*camera, *aabb, transform ? *transform : NX_TRANSFORM_IDENTITY);
+
+    int level = -1;
+    for (int i = 0; i < data.lodCount; i++) {
+        if (screenSize <= data.lods[i].maxScreenSize) level = i;
+    }
+
+    NX_SetAnimationPlayerLOD(player, level);
+
+    return level;
+}
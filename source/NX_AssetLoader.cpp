@@ -0,0 +1,94 @@
+/* NX_AssetLoader.cpp -- API definition for Nexium's asynchronous asset loading module
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#include <NX/NX_AssetLoader.h>
+
+#include <NX/NX_Log.h>
+
+#include "./INX_AssetLoader.hpp"
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+NX_AssetRequest* NX_LoadTextureAsync(const char* filePath, NX_AssetCallback callback, void* userData)
+{
+    return INX_AssetLoads.Load(NX_AssetRequest::Type::TEXTURE, filePath, callback, userData);
+}
+
+NX_AssetRequest* NX_LoadTextureAsDataAsync(const char* filePath, NX_AssetCallback callback, void* userData)
+{
+    return INX_AssetLoads.Load(NX_AssetRequest::Type::TEXTURE_DATA, filePath, callback, userData);
+}
+
+NX_AssetRequest* NX_LoadModelAsync(const char* filePath, NX_AssetCallback callback, void* userData)
+{
+    return INX_AssetLoads.Load(NX_AssetRequest::Type::MODEL, filePath, callback, userData);
+}
+
+NX_AssetRequest* NX_LoadAudioClipAsync(const char* filePath, int channelCount, NX_AssetCallback callback, void* userData)
+{
+    if (channelCount <= 0) {
+        NX_LOG(E, "AUDIO: Invalid channel count %d", channelCount);
+        return nullptr;
+    }
+
+    NX_AssetRequest::Params params{};
+    params.channelCount = channelCount;
+
+    return INX_AssetLoads.Load(NX_AssetRequest::Type::AUDIO_CLIP, filePath, callback, userData, params);
+}
+
+NX_AssetRequest* NX_LoadFontAsync(const char* filePath, NX_FontType type, int baseSize,
+                                  const int* codepoints, int codepointCount,
+                                  NX_AssetCallback callback, void* userData)
+{
+    NX_AssetRequest::Params params{};
+    params.fontType = type;
+    params.fontSize = baseSize;
+    params.codepoints = codepoints;
+    params.codepointCount = codepointCount;
+
+    return INX_AssetLoads.Load(NX_AssetRequest::Type::FONT, filePath, callback, userData, params);
+}
+
+NX_AssetStatus NX_GetAssetStatus(const NX_AssetRequest* request)
+{
+    return request->status;
+}
+
+NX_Texture* NX_GetAssetTexture(const NX_AssetRequest* request)
+{
+    return (request->status == NX_ASSET_READY) ? request->texture : nullptr;
+}
+
+NX_Model* NX_GetAssetModel(const NX_AssetRequest* request)
+{
+    return (request->status == NX_ASSET_READY) ? request->result : nullptr;
+}
+
+NX_AudioClip* NX_GetAssetAudioClip(const NX_AssetRequest* request)
+{
+    return (request->status == NX_ASSET_READY) ? request->audioClip : nullptr;
+}
+
+NX_Font* NX_GetAssetFont(const NX_AssetRequest* request)
+{
+    return (request->status == NX_ASSET_READY) ? request->font : nullptr;
+}
+
+NX_AssetStatus NX_WaitAsset(NX_AssetRequest* request)
+{
+    return INX_AssetLoads.Wait(request);
+}
+
+void NX_ReleaseAssetRequest(NX_AssetRequest* request)
+{
+    if (request == nullptr) return;
+    INX_AssetLoads.Release(request);
+}
@@ -6,6 +6,7 @@
  * For conditions of distribution and use, see accompanying LICENSE file.
  */
 
+#include "./NX_AudioStream.hpp"
 #include "./NX_Audio.hpp"
 #include <NX/NX_Log.h>
 
@@ -104,11 +105,17 @@ bool INX_AudioState_Init(NX_AppDesc* desc)
         return false;
     }
 
+    if (!INX_AudioStreams_Init(*desc)) {
+        return false;
+    }
+
     return true;
 }
 
 void INX_AudioState_Quit()
 {
+    INX_AudioStreams_Quit();
+
     alcDestroyContext(INX_Audio.alContext);
     INX_Audio.alContext = nullptr;
 
@@ -44,17 +44,6 @@ NX_AudioClip::~NX_AudioClip()
     }
 }
 
-// ============================================================================
-// INTERNAL TYPES
-// ============================================================================
-
-struct INX_AudioClip_RawData {
-    void* pcmData{};
-    size_t pcmDataSize{};
-    ALsizei sampleRate{};
-    ALenum format{};
-};
-
 // ============================================================================
 // INTERNAL FUNCTIONS
 // ============================================================================
@@ -215,20 +204,11 @@ void INX_DestroyAudioClip_RawData(INX_AudioClip_RawData& rawData)
     NX_Free(rawData.pcmData);
 }
 
-// ============================================================================
-// PUBLIC API
-// ============================================================================
-
-NX_AudioClip* NX_LoadAudioClip(const char* filePath, int channelCount)
+bool INX_DecodeAudioClip(const char* filePath, INX_AudioClip_RawData* rawData)
 {
-    if (channelCount <= 0) {
-        NX_LOG(E, "AUDIO: Invalid channel count %d", channelCount);
-        return nullptr;
-    }
-
     if (!filePath) {
         NX_LOG(E, "AUDIO: Null file path");
-        return nullptr;
+        return false;
     }
 
     /* --- Load file data --- */
@@ -237,64 +217,62 @@ NX_AudioClip* NX_LoadAudioClip(const char* filePath, int channelCount)
     void* fileData = NX_LoadFile(filePath, &fileSize);
     if (!fileData) {
         NX_LOG(E, "AUDIO: Unable to load file '%s'", filePath);
-        return nullptr;
+        return false;
     }
 
     /* --- Decode according to format --- */
 
-    INX_AudioClip_RawData audioData;
     auto format = INX_GetAudioFormat(static_cast<const uint8_t*>(fileData), fileSize);
 
     switch (format) {
         case INX_AudioFormat::WAV:
-            audioData = INX_LoadAudioClip_RawData_WAV(fileData, fileSize);
+            *rawData = INX_LoadAudioClip_RawData_WAV(fileData, fileSize);
             break;
         case INX_AudioFormat::FLAC:
-            audioData = INX_LoadAudioClip_RawData_FLAC(fileData, fileSize);
+            *rawData = INX_LoadAudioClip_RawData_FLAC(fileData, fileSize);
             break;
         case INX_AudioFormat::MP3:
-            audioData = INX_LoadAudioClip_RawData_MP3(fileData, fileSize);
+            *rawData = INX_LoadAudioClip_RawData_MP3(fileData, fileSize);
             break;
         case INX_AudioFormat::OGG:
-            audioData = INX_LoadAudioClip_RawData_OGG(fileData, fileSize);
+            *rawData = INX_LoadAudioClip_RawData_OGG(fileData, fileSize);
             break;
         default:
             NX_LOG(E, "AUDIO: Unknown audio format for '%s'", filePath);
             NX_Free(fileData);
-            return nullptr;
+            return false;
     }
 
     NX_Free(fileData);
 
-    if (!audioData.pcmData) {
+    if (!rawData->pcmData) {
         NX_LOG(E, "AUDIO: Failed to decode audio file '%s'", filePath);
-        return nullptr;
+        return false;
     }
 
+    return true;
+}
+
+NX_AudioClip* INX_CreateAudioClip(const INX_AudioClip_RawData& rawData, int channelCount)
+{
     /* --- Create the OpenAL buffer --- */
 
     ALuint buffer = 0;
     alGenBuffers(1, &buffer);
     if (alGetError() != AL_NO_ERROR) {
         NX_LOG(E, "AUDIO: Could not generate OpenAL buffer");
-        INX_DestroyAudioClip_RawData(audioData);
         return nullptr;
     }
 
     /* --- Load data into the buffer --- */
 
-    alBufferData(buffer, audioData.format, audioData.pcmData, audioData.pcmDataSize, audioData.sampleRate);
+    alBufferData(buffer, rawData.format, rawData.pcmData, rawData.pcmDataSize, rawData.sampleRate);
     if (alGetError() != AL_NO_ERROR) {
         NX_LOG(E, "AUDIO: Could not buffer data to OpenAL");
-        INX_DestroyAudioClip_RawData(audioData);
         alDeleteBuffers(1, &buffer);
         return nullptr;
     }
 
-    /* --- Cleanup PCM data (no longer needed now) --- */
-
-    INX_DestroyAudioClip_RawData(audioData);
-
     /* --- Create the OpenAL sources --- */
 
     util::FixedArray<ALuint> sources(channelCount, channelCount);
@@ -322,6 +300,28 @@ NX_AudioClip* NX_LoadAudioClip(const char* filePath, int channelCount)
     return INX_Pool.Create<NX_AudioClip>(std::move(sources), buffer);
 }
 
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+NX_AudioClip* NX_LoadAudioClip(const char* filePath, int channelCount)
+{
+    if (channelCount <= 0) {
+        NX_LOG(E, "AUDIO: Invalid channel count %d", channelCount);
+        return nullptr;
+    }
+
+    INX_AudioClip_RawData audioData;
+    if (!INX_DecodeAudioClip(filePath, &audioData)) {
+        return nullptr;
+    }
+
+    NX_AudioClip* clip = INX_CreateAudioClip(audioData, channelCount);
+    INX_DestroyAudioClip_RawData(audioData);
+
+    return clip;
+}
+
 void NX_DestroyAudioClip(NX_AudioClip* clip)
 {
     INX_Pool.Destroy(clip);
@@ -12,10 +12,40 @@
 #include "./Detail/Util/FixedArray.hpp"
 #include <al.h>
 
+#include <cstddef>
+
+// ============================================================================
+// OPAQUE DEFINITION
+// ============================================================================
+
 struct NX_AudioClip {
     util::FixedArray<ALuint> sources{};
     ALuint buffer{};
     ~NX_AudioClip();
 };
 
+// ============================================================================
+// INTERNAL TYPES
+// ============================================================================
+
+struct INX_AudioClip_RawData {
+    void* pcmData{};
+    size_t pcmDataSize{};
+    ALsizei sampleRate{};
+    ALenum format{};
+};
+
+// ============================================================================
+// INTERNAL FUNCTIONS
+// ============================================================================
+
+/** Reads and decodes a clip file into PCM data, without any OpenAL call so it can run on a worker */
+bool INX_DecodeAudioClip(const char* filePath, INX_AudioClip_RawData* rawData);
+
+/** Creates the buffer and sources of a clip from decoded PCM data, the data stays owned by the caller */
+NX_AudioClip* INX_CreateAudioClip(const INX_AudioClip_RawData& rawData, int channelCount);
+
+/** Frees decoded PCM data */
+void INX_DestroyAudioClip_RawData(INX_AudioClip_RawData& rawData);
+
 #endif // NX_AUDIO_CLIP_HPP
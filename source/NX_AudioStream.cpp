@@ -16,13 +16,14 @@
 #include "./INX_GlobalPool.hpp"
 
 #include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_stdinc.h>
 
 #include <condition_variable>
 #include <algorithm>
+#include <chrono>
 #include <thread>
 #include <atomic>
 #include <mutex>
-#include <array>
 
 // ============================================================================
 // DECODER HELPERS
@@ -142,258 +143,465 @@ static void INX_SeekToStart(const NX_AudioStream& stream)
 }
 
 // ============================================================================
-// OPAQUE DEFINITION
+// STREAM BUFFERS
 // ============================================================================
 
-NX_AudioStream::~NX_AudioStream()
+static size_t INX_GetBufferBytes(const NX_AudioStream& stream)
 {
-    INX_DestroyDecoder(decoder, audioFormat);
+    return static_cast<size_t>(stream.bufferFrames) * stream.channels * sizeof(int16_t);
+}
 
-    if (source > 0) {
-        alDeleteSources(1, &source);
-        alDeleteBuffers(BufferCount, buffers.data());
+static void INX_DeleteStreamBuffers(NX_AudioStream* stream)
+{
+    if (!stream->buffers.IsEmpty()) {
+        alDeleteBuffers(static_cast<ALsizei>(stream->buffers.GetSize()), stream->buffers.GetData());
     }
+
+    stream->buffers.Clear();
+    stream->freeBuffers.Clear();
+    stream->stagedBytes.Clear();
+    stream->staging.reset();
+    stream->stagedCount = 0;
 }
 
-// ============================================================================
-// STREAM PLAYER
-// ============================================================================
+static bool INX_CreateStreamBuffers(NX_AudioStream* stream, int bufferCount, int bufferFrames)
+{
+    stream->bufferFrames = bufferFrames;
+
+    if (!stream->buffers.Resize(bufferCount) || !stream->stagedBytes.Resize(bufferCount) || !stream->freeBuffers.Reserve(bufferCount)) {
+        return false;
+    }
+
+    stream->staging = util::MakeUniqueArray<uint8_t>(bufferCount * INX_GetBufferBytes(*stream));
+    if (!stream->staging) {
+        return false;
+    }
 
-struct INX_StreamPlayer {
-    static constexpr size_t MaxDecodeBuffers = 32;
-    static constexpr size_t DecodeBufferSize = NX_AudioStream::BufferSize;
+    alGenBuffers(bufferCount, stream->buffers.GetData());
+    if (alGetError() != AL_NO_ERROR) {
+        stream->buffers.Clear();
+        return false;
+    }
 
-    std::thread streamThread;
-    std::mutex streamMutex;      // For activeStreams
-    std::mutex bufferMutex;      // For the buffer pool
-    std::condition_variable cv;
-    std::atomic<bool> shouldStop{false};
+    for (int i = 0; i < bufferCount; i++) {
+        stream->freeBuffers.PushBack(stream->buffers[i]);
+    }
 
-    util::DynamicArray<NX_AudioStream*> activeStreams;
-    std::array<util::UniquePtr<uint8_t>, MaxDecodeBuffers> decodeBuffers;
-    std::array<bool, MaxDecodeBuffers> bufferAvailable;
+    return true;
+}
 
-    INX_StreamPlayer();
-    ~INX_StreamPlayer();
+/** Decodes up to 'count' buffers into the staging memory, only one thread may own the decoder */
+static void INX_DecodeBuffers(NX_AudioStream* stream, int count)
+{
+    const size_t bufferBytes = INX_GetBufferBytes(*stream);
+    const size_t frameBytes = stream->channels * sizeof(int16_t);
 
-    void addStream(NX_AudioStream* stream);
-    void removeStream(NX_AudioStream* stream);
-    void prepareStream(NX_AudioStream* stream);
+    stream->stagedCount = 0;
 
-    uint8_t* requestBuffer();
-    void releaseBuffer(uint8_t* buffer);
+    for (int i = 0; i < count && !stream->endOfData; i++)
+    {
+        uint8_t* data = stream->staging.get() + i * bufferBytes;
+        size_t framesRead = INX_DecodeSamples(*stream, data, stream->bufferFrames);
 
-private:
-    void threadFunc();
-    void updateStreams();
-    bool updateStream(NX_AudioStream* stream);
-    bool fillBuffer(NX_AudioStream* stream, ALuint buffer);
-};
+        if (framesRead == 0 && stream->shouldLoop) {
+            INX_SeekToStart(*stream);
+            framesRead = INX_DecodeSamples(*stream, data, stream->bufferFrames);
+        }
 
-INX_StreamPlayer::INX_StreamPlayer()
+        if (framesRead == 0) {
+            stream->endOfData = true;
+            break;
+        }
+
+        stream->stagedBytes[i] = static_cast<uint32_t>(framesRead * frameBytes);
+        stream->stagedCount++;
+    }
+}
+
+/** Uploads the staged buffers into free OpenAL buffers and queues them on the source */
+static void INX_QueueStagedBuffers(NX_AudioStream* stream)
 {
-    bufferAvailable.fill(true);
-    for (auto& buffer : decodeBuffers) {
-        buffer = util::MakeUniqueArray<uint8_t>(DecodeBufferSize);
+    const size_t bufferBytes = INX_GetBufferBytes(*stream);
+
+    for (int i = 0; i < stream->stagedCount && !stream->freeBuffers.IsEmpty(); i++) {
+        ALuint buffer = *stream->freeBuffers.GetBack();
+        stream->freeBuffers.PopBack();
+        alBufferData(buffer, stream->format, stream->staging.get() + i * bufferBytes, stream->stagedBytes[i], stream->sampleRate);
+        alSourceQueueBuffers(stream->source, 1, &buffer);
     }
 
-    streamThread = std::thread([this]() { threadFunc(); });
+    stream->stagedCount = 0;
 }
 
-INX_StreamPlayer::~INX_StreamPlayer()
+/** Stops the source and detaches all of its buffers, which all become free */
+static void INX_ReleaseStreamBuffers(NX_AudioStream* stream)
 {
-    shouldStop = true;
-    cv.notify_one();
+    // A source that never played does not mark its buffers as processed when stopped,
+    // detaching them is the only way to get all of them back without playing
+    alSourceStop(stream->source);
+    alSourcei(stream->source, AL_BUFFER, 0);
 
-    if (streamThread.joinable()) {
-        streamThread.join();
+    stream->freeBuffers.Clear();
+    for (size_t i = 0; i < stream->buffers.GetSize(); i++) {
+        stream->freeBuffers.PushBack(stream->buffers[i]);
     }
 }
 
-void INX_StreamPlayer::addStream(NX_AudioStream* stream)
+/** Stops the source, rewinds the decoder and fills every buffer, the stream must not be scheduled */
+static void INX_PrepareStream(NX_AudioStream* stream)
 {
-    std::lock_guard<std::mutex> lock(streamMutex);
+    INX_ReleaseStreamBuffers(stream);
 
-    auto it = std::find(activeStreams.Begin(), activeStreams.End(), stream);
-    if (it == activeStreams.End()) {
-        activeStreams.PushBack(stream);
-        cv.notify_one();
-    }
+    INX_SeekToStart(*stream);
+    stream->endOfData = false;
+    stream->needsPrepare = false;
+
+    INX_DecodeBuffers(stream, static_cast<int>(stream->freeBuffers.GetSize()));
+    INX_QueueStagedBuffers(stream);
 }
 
-void INX_StreamPlayer::removeStream(NX_AudioStream* stream)
+// ============================================================================
+// STREAM SCHEDULER
+// ============================================================================
+
+/**
+ * @brief Keeps the streams fed, the one closest to starvation first.
+ *
+ * The scheduler thread owns every OpenAL call made on playing streams. For each
+ * stream it unqueues the processed buffers, uploads what the decoding threads
+ * produced, and tracks the deadline at which the queued audio runs out. It then
+ * sleeps until the next buffer of any stream is expected to be processed, or
+ * until a decode completes.
+ *
+ * Decoding runs on a small pool of threads, outside of the scheduler mutex.
+ * A stream has at most one decode in flight, owning its decoder and staging
+ * memory, and pending decodes are taken by earliest deadline.
+ *
+ * Controls from the main thread (stop, rewind, destroy) first take the stream
+ * out of the scheduler, waiting for its decode, so they never race with it.
+ */
+class INX_StreamScheduler {
+public:
+    /** Lifetime */
+    bool Init(const NX_AppDesc& desc);
+    void Quit();
+
+    /** Getters */
+    int GetBufferCount() const { return mBufferCount; }
+    int GetBufferFrames() const { return mBufferFrames; }
+
+    /** Stream controls */
+    void Play(NX_AudioStream* stream);
+    void Pause(NX_AudioStream* stream);
+    bool Remove(NX_AudioStream* stream);    //< Returns true if the stream was scheduled
+
+private:
+    static int64_t Now();
+
+    void SchedulerLoop();
+    void DecoderLoop();
+    int64_t Service(NX_AudioStream* stream, int64_t now);    //< Returns the next time to look at it, or < 0 once finished
+
+private:
+    std::thread mThread;
+    util::DynamicArray<std::thread> mDecoders{};
+
+    std::mutex mMutex;                          //< Protects the lists and the scheduling state of the streams
+    std::condition_variable mWakeCV;
+    std::condition_variable mDecodeCV;
+    std::condition_variable mIdleCV;
+
+    util::DynamicArray<NX_AudioStream*> mActiveStreams{};
+    util::DynamicArray<NX_AudioStream*> mDecodeQueue{};
+
+    int mBufferCount{NX_AudioStream::DefaultBufferCount};
+    int mBufferFrames{NX_AudioStream::DefaultBufferFrames};
+    bool mWakeRequested{};
+    bool mShouldStop{};
+};
+
+static INX_StreamScheduler INX_Streams;
+
+bool INX_StreamScheduler::Init(const NX_AppDesc& desc)
 {
-    std::lock_guard<std::mutex> lock(streamMutex);
+    mBufferCount = (desc.audio.streamBufferCount > 1) ? desc.audio.streamBufferCount : NX_AudioStream::DefaultBufferCount;
+    mBufferFrames = (desc.audio.streamBufferFrames > 0) ? desc.audio.streamBufferFrames : NX_AudioStream::DefaultBufferFrames;
+    mShouldStop = false;
+
+    int decoderCount = (desc.audio.streamDecoders > 0) ? desc.audio.streamDecoders : 2;
+    if (!mDecoders.Reserve(decoderCount)) {
+        return false;
+    }
 
-    auto it = std::find(activeStreams.Begin(), activeStreams.End(), stream);
-    if (it != activeStreams.End()) {
-        activeStreams.Erase(it);
+    for (int i = 0; i < decoderCount; i++) {
+        mDecoders.EmplaceBack([this]() { DecoderLoop(); });
     }
+
+    mThread = std::thread([this]() { SchedulerLoop(); });
+
+    NX_LOG(D, "AUDIO: Stream scheduler started with %i decoding thread(s), %i buffers of %i frames per stream",
+           decoderCount, mBufferCount, mBufferFrames);
+
+    return true;
 }
 
-void INX_StreamPlayer::prepareStream(NX_AudioStream* stream)
+void INX_StreamScheduler::Quit()
 {
-    for (size_t i = 0; i < NX_AudioStream::BufferCount; ++i) {
-        fillBuffer(stream, stream->buffers[i]);
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mShouldStop = true;
+    }
+
+    mWakeCV.notify_one();
+    mDecodeCV.notify_all();
+
+    if (mThread.joinable()) {
+        mThread.join();
     }
+
+    for (size_t i = 0; i < mDecoders.GetSize(); i++) {
+        mDecoders[i].join();
+    }
+
+    mDecoders.Clear();
+    mActiveStreams.Clear();
+    mDecodeQueue.Clear();
 }
 
-uint8_t* INX_StreamPlayer::requestBuffer()
+void INX_StreamScheduler::Play(NX_AudioStream* stream)
 {
-    std::lock_guard<std::mutex> lock(bufferMutex);
+    std::unique_lock<std::mutex> lock(mMutex);
 
-    for (size_t i = 0; i < MaxDecodeBuffers; ++i) {
-        if (bufferAvailable[i]) {
-            bufferAvailable[i] = false;
-            return decodeBuffers[i].get();
-        }
+    if (stream->isPlaying && !stream->isPaused) {
+        return;
+    }
+
+    // Not scheduled once finished, so its buffers can be filled outside of the lock
+    if (!stream->isPlaying && stream->needsPrepare) {
+        lock.unlock();
+        INX_PrepareStream(stream);
+        lock.lock();
     }
 
-    return nullptr;
+    stream->isPaused = false;
+    stream->isPlaying = true;
+    stream->deadline = Now();
+
+    alSourcePlay(stream->source);
+
+    if (std::find(mActiveStreams.Begin(), mActiveStreams.End(), stream) == mActiveStreams.End()) {
+        mActiveStreams.PushBack(stream);
+    }
+
+    mWakeRequested = true;
+    lock.unlock();
+    mWakeCV.notify_one();
 }
 
-void INX_StreamPlayer::releaseBuffer(uint8_t* buffer)
+void INX_StreamScheduler::Pause(NX_AudioStream* stream)
 {
-    std::lock_guard<std::mutex> lock(bufferMutex);
+    std::lock_guard<std::mutex> lock(mMutex);
 
-    for (size_t i = 0; i < MaxDecodeBuffers; ++i) {
-        if (decodeBuffers[i].get() == buffer) {
-            bufferAvailable[i] = true;
-            break;
-        }
+    if (stream->isPlaying && !stream->isPaused) {
+        alSourcePause(stream->source);
+        stream->isPaused = true;
     }
 }
 
-bool INX_StreamPlayer::fillBuffer(NX_AudioStream* stream, ALuint buffer)
+bool INX_StreamScheduler::Remove(NX_AudioStream* stream)
 {
-    uint8_t* decodeBuffer = requestBuffer();
-    if (!decodeBuffer) {
-        return false;
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    auto it = std::find(mActiveStreams.Begin(), mActiveStreams.End(), stream);
+    bool scheduled = (it != mActiveStreams.End());
+    if (scheduled) {
+        mActiveStreams.Erase(it);
     }
 
-    int channels = INX_GetChannelCount(*stream);
-    int sampleRate = INX_GetSampleRate(*stream);
-    size_t samplesToRead = DecodeBufferSize / (channels * sizeof(int16_t));
+    // A decode not started yet is dropped, one in flight is awaited
+    auto queued = std::find(mDecodeQueue.Begin(), mDecodeQueue.End(), stream);
+    if (queued != mDecodeQueue.End()) {
+        mDecodeQueue.Erase(queued);
+        stream->decoding = false;
+    }
 
-    size_t samplesRead = INX_DecodeSamples(*stream, decodeBuffer, samplesToRead);
+    mIdleCV.wait(lock, [stream]() { return !stream->decoding; });
 
-    if (samplesRead == 0 && stream->shouldLoop) {
-        INX_SeekToStart(*stream);
-        samplesRead = INX_DecodeSamples(*stream, decodeBuffer, samplesToRead);
-    }
+    // Decoded data that was not uploaded yet is dropped
+    stream->stagedCount = 0;
 
-    bool success = false;
-    if (samplesRead > 0) {
-        size_t dataSize = samplesRead * channels * sizeof(int16_t);
-        alBufferData(buffer, stream->format, decodeBuffer, dataSize, sampleRate);
-        alSourceQueueBuffers(stream->source, 1, &buffer);
-        success = true;
-    }
+    return scheduled;
+}
 
-    releaseBuffer(decodeBuffer);
-    return success;
+int64_t INX_StreamScheduler::Now()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
 }
 
-bool INX_StreamPlayer::updateStream(NX_AudioStream* stream)
+int64_t INX_StreamScheduler::Service(NX_AudioStream* stream, int64_t now)
 {
-    if (stream->isPaused) {
-        return false;
+    constexpr int64_t NoWake = INT64_MAX;
+
+    if (stream->isPaused || stream->decoding) {
+        return NoWake;
     }
 
-    ALint sourceState;
-    alGetSourcei(stream->source, AL_SOURCE_STATE, &sourceState);
+    /* --- Collect the processed buffers and queue the decoded ones --- */
 
     ALint processed = 0;
     alGetSourcei(stream->source, AL_BUFFERS_PROCESSED, &processed);
 
-    bool endOfStream = false;
-
-    while (processed > 0 && !shouldStop) {
-        ALuint buffer;
+    for (ALint i = 0; i < processed; i++) {
+        ALuint buffer = 0;
         alSourceUnqueueBuffers(stream->source, 1, &buffer);
-        if (!fillBuffer(stream, buffer)) endOfStream = true;
-        processed--;
+        stream->freeBuffers.PushBack(buffer);
     }
 
-    ALint queued = 0;
-    alGetSourcei(stream->source, AL_BUFFERS_QUEUED, &queued);
+    INX_QueueStagedBuffers(stream);
+
+    // Counted here rather than with AL_BUFFERS_QUEUED, which mojoAL does not
+    // reset when the buffers are detached by 'INX_ReleaseStreamBuffers'
+    const ALint queued = static_cast<ALint>(stream->buffers.GetSize() - stream->freeBuffers.GetSize());
+
+    ALint state = 0, offset = 0;
+    alGetSourcei(stream->source, AL_SOURCE_STATE, &state);
+    alGetSourcei(stream->source, AL_SAMPLE_OFFSET, &offset);
 
-    if (queued == 0 && endOfStream) {
-        INX_SeekToStart(*stream);
+    /* --- End of a stream that does not loop --- */
+
+    if (queued == 0 && stream->endOfData) {
+        alSourceStop(stream->source);
         stream->isPlaying = false;
-        prepareStream(stream);
-        return true;
+        stream->needsPrepare = true;
+        return -1;
     }
-    else if (sourceState != AL_PLAYING && !stream->isPaused && queued > 0) {
+
+    /* --- Restart a source that ran out of data --- */
+
+    if (state != AL_PLAYING && queued > 0) {
         alSourcePlay(stream->source);
+        stream->underruns++;
+    }
+
+    /* --- Update the deadline and request a decode for the free buffers --- */
+
+    const int64_t bufferTime = (static_cast<int64_t>(stream->bufferFrames) * 1000000000) / stream->sampleRate;
+    const int64_t playedTime = (static_cast<int64_t>(offset % stream->bufferFrames) * 1000000000) / stream->sampleRate;
+
+    stream->deadline = now + NX_MAX(queued * bufferTime - playedTime, int64_t(0));
+
+    if (!stream->freeBuffers.IsEmpty() && !stream->endOfData) {
+        stream->requestedCount = static_cast<int>(stream->freeBuffers.GetSize());
+        stream->decoding = true;
+        mDecodeQueue.PushBack(stream);
+        mDecodeCV.notify_one();
+        return NoWake;
     }
 
-    return false;
+    // Next look once the buffer being played is processed
+    return now + NX_MAX(bufferTime - playedTime, int64_t(1000000));
 }
 
-void INX_StreamPlayer::updateStreams()
+void INX_StreamScheduler::SchedulerLoop()
 {
-    std::lock_guard<std::mutex> lock(streamMutex);
+    constexpr int64_t MaxSleep = 100000000;
 
-    for (size_t i = activeStreams.GetSize(); i > 0; --i) {
-        size_t idx = i - 1;
-        NX_AudioStream* stream = activeStreams[idx];
-        if (stream && updateStream(stream)) {
-            activeStreams.Erase(activeStreams.Begin() + idx);
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    while (!mShouldStop)
+    {
+        const int64_t now = Now();
+        int64_t wake = now + MaxSleep;
+
+        for (size_t i = mActiveStreams.GetSize(); i > 0; --i) {
+            NX_AudioStream* stream = mActiveStreams[i - 1];
+            int64_t next = Service(stream, now);
+            if (next < 0) mActiveStreams.Erase(mActiveStreams.Begin() + (i - 1));
+            else wake = NX_MIN(wake, next);
         }
+
+        auto timeout = std::chrono::steady_clock::time_point(std::chrono::nanoseconds(wake));
+        mWakeCV.wait_until(lock, timeout, [this]() { return mWakeRequested || mShouldStop; });
+        mWakeRequested = false;
     }
 }
 
-void INX_StreamPlayer::threadFunc()
+void INX_StreamScheduler::DecoderLoop()
 {
-    while (!shouldStop)
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    while (true)
     {
-        {
-            std::unique_lock<std::mutex> lock(streamMutex);
-            cv.wait(lock, [this]() { 
-                return !activeStreams.IsEmpty() || shouldStop.load(); 
-            });
+        mDecodeCV.wait(lock, [this]() { return !mDecodeQueue.IsEmpty() || mShouldStop; });
+        if (mShouldStop) break;
 
-            if (shouldStop) break;
-        }
+        /* --- Take the stream closest to starvation --- */
 
-        updateStreams();
+        auto next = std::min_element(mDecodeQueue.Begin(), mDecodeQueue.End(),
+            [](const NX_AudioStream* a, const NX_AudioStream* b) { return a->deadline < b->deadline; }
+        );
+
+        NX_AudioStream* stream = *next;
+        mDecodeQueue.Erase(next);
+
+        /* --- Decode outside of the lock, the stream is owned until 'decoding' is cleared --- */
+
+        lock.unlock();
+        INX_DecodeBuffers(stream, stream->requestedCount);
+        lock.lock();
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(16));
+        stream->decoding = false;
+        mWakeRequested = true;
+
+        mIdleCV.notify_all();
+        mWakeCV.notify_one();
     }
 }
 
-static INX_StreamPlayer& INX_GetStreamPlayer()
+// ============================================================================
+// OPAQUE DEFINITION
+// ============================================================================
+
+NX_AudioStream::~NX_AudioStream()
 {
-    static INX_StreamPlayer player;
-    return player;
+    INX_Streams.Remove(this);
+
+    if (source > 0) {
+        alSourceStop(source);
+        alSourcei(source, AL_BUFFER, 0);
+        alDeleteSources(1, &source);
+    }
+
+    INX_DeleteStreamBuffers(this);
+    INX_DestroyDecoder(decoder, audioFormat);
 }
 
 // ============================================================================
-// PUBLIC API
+// INTERNAL FUNCTIONS
 // ============================================================================
 
-NX_AudioStream* NX_LoadAudioStream(const char* filePath)
+bool INX_AudioStreams_Init(const NX_AppDesc& desc)
 {
-    if (!filePath) {
-        NX_LOG(E, "AUDIO: File path is null");
-        return nullptr;
-    }
+    return INX_Streams.Init(desc);
+}
 
-    /* --- Load the file --- */
+void INX_AudioStreams_Quit()
+{
+    INX_Streams.Quit();
+}
 
-    size_t fileSize = 0;
-    util::UniquePtr<uint8_t> fileData(static_cast<uint8_t*>(NX_LoadFile(filePath, &fileSize)));
-    if (!fileData) {
-        NX_LOG(E, "AUDIO: Failed to load file: %s", filePath);
-        return nullptr;
-    }
+// ============================================================================
+// PUBLIC API
+// ============================================================================
 
+static NX_AudioStream* INX_CreateAudioStream(util::UniquePtr<uint8_t> fileData, size_t fileSize)
+{
     /* --- Determine the format --- */
 
     INX_AudioFormat audioFormat = INX_GetAudioFormat(fileData.get(), fileSize);
     if (audioFormat == INX_AudioFormat::Unknown) {
-        NX_LOG(E, "AUDIO: Unknown format: %s", filePath);
+        NX_LOG(E, "AUDIO: Unknown audio stream format");
         return nullptr;
     }
 
@@ -413,41 +621,77 @@ NX_AudioStream* NX_LoadAudioStream(const char* filePath)
         return nullptr;
     }
 
+    /* --- Create the stream, owning the decoder from here --- */
+
+    NX_AudioStream* stream = INX_Pool.Create<NX_AudioStream>();
+    if (stream == nullptr) {
+        NX_LOG(E, "AUDIO: Failed to allocate audio stream");
+        INX_DestroyDecoder(decoder, audioFormat);
+        return nullptr;
+    }
+
+    stream->format = (channels == 2) ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16;
+    stream->audioData = std::move(fileData);
+    stream->audioFormat = audioFormat;
+    stream->decoder = decoder;
+    stream->channels = INX_GetChannelCount(*stream);
+    stream->sampleRate = INX_GetSampleRate(*stream);
+
     /* --- Create OpenAL resources --- */
 
-    ALenum format = (channels == 2) ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16;
-    
-    std::array<ALuint, NX_AudioStream::BufferCount> buffers{};
-    alGenBuffers(NX_AudioStream::BufferCount, buffers.data());
-    if (alGetError() != AL_NO_ERROR) {
+    if (!INX_CreateStreamBuffers(stream, INX_Streams.GetBufferCount(), INX_Streams.GetBufferFrames())) {
         NX_LOG(E, "AUDIO: Failed to create buffers");
-        INX_DestroyDecoder(decoder, audioFormat);
+        INX_Pool.Destroy(stream);
         return nullptr;
     }
 
-    ALuint source{};
-    alGenSources(1, &source);
+    alGenSources(1, &stream->source);
     if (alGetError() != AL_NO_ERROR) {
         NX_LOG(E, "AUDIO: Failed to create source");
-        alDeleteBuffers(NX_AudioStream::BufferCount, buffers.data());
-        INX_DestroyDecoder(decoder, audioFormat);
+        stream->source = 0;
+        INX_Pool.Destroy(stream);
         return nullptr;
     }
 
-    /* --- Create the stream --- */
+    INX_PrepareStream(stream);
 
-    NX_AudioStream* stream = INX_Pool.Create<NX_AudioStream>();
-    
-    stream->buffers = buffers;
-    stream->source = source;
-    stream->format = format;
-    stream->audioData = std::move(fileData);
-    stream->audioFormat = audioFormat;
-    stream->decoder = decoder;
+    return stream;
+}
+
+NX_AudioStream* NX_LoadAudioStream(const char* filePath)
+{
+    if (!filePath) {
+        NX_LOG(E, "AUDIO: File path is null");
+        return nullptr;
+    }
 
-    INX_GetStreamPlayer().prepareStream(stream);
+    size_t fileSize = 0;
+    util::UniquePtr<uint8_t> fileData(static_cast<uint8_t*>(NX_LoadFile(filePath, &fileSize)));
+    if (!fileData) {
+        NX_LOG(E, "AUDIO: Failed to load file: %s", filePath);
+        return nullptr;
+    }
 
-    return stream;
+    return INX_CreateAudioStream(std::move(fileData), fileSize);
+}
+
+NX_AudioStream* NX_LoadAudioStreamFromData(const void* data, size_t size)
+{
+    if (!data || size == 0) {
+        NX_LOG(E, "AUDIO: Audio stream data is empty");
+        return nullptr;
+    }
+
+    // The decoders read from memory while playing, so the stream keeps its own copy
+    util::UniquePtr<uint8_t> fileData = util::MakeUniqueArray<uint8_t>(size);
+    if (!fileData) {
+        NX_LOG(E, "AUDIO: Failed to allocate audio stream data");
+        return nullptr;
+    }
+
+    SDL_memcpy(fileData.get(), data, size);
+
+    return INX_CreateAudioStream(std::move(fileData), size);
 }
 
 void NX_DestroyAudioStream(NX_AudioStream* stream)
@@ -457,67 +701,42 @@ void NX_DestroyAudioStream(NX_AudioStream* stream)
 
 void NX_PlayAudioStream(NX_AudioStream* stream)
 {
-    if (stream->isPaused && stream->isPlaying) {
-        alSourcePlay(stream->source);
-        stream->isPaused = false;
-        return;
-    }
-
-    INX_GetStreamPlayer().addStream(stream);
-    alSourcePlay(stream->source);
-    
-    stream->isPaused = false;
-    stream->isPlaying = true;
+    INX_Streams.Play(stream);
 }
 
 void NX_PauseAudioStream(NX_AudioStream* stream)
 {
-    if (stream->isPlaying && !stream->isPaused) {
-        alSourcePause(stream->source);
-        stream->isPaused = true;
-    }
+    INX_Streams.Pause(stream);
 }
 
 void NX_StopAudioStream(NX_AudioStream* stream)
 {
     if (!stream->isPlaying) return;
 
-    INX_GetStreamPlayer().removeStream(stream);
-    alSourceStop(stream->source);
-
-    ALint queued = 0;
-    alGetSourcei(stream->source, AL_BUFFERS_QUEUED, &queued);
-    if (queued > 0) {
-        ALuint buffers[NX_AudioStream::BufferCount];
-        alSourceUnqueueBuffers(stream->source, queued, buffers);
-    }
+    INX_Streams.Remove(stream);
 
-    INX_SeekToStart(*stream);
     stream->isPaused = false;
     stream->isPlaying = false;
 
-    INX_GetStreamPlayer().prepareStream(stream);
+    INX_PrepareStream(stream);
 }
 
 void NX_RewindAudioStream(NX_AudioStream* stream)
 {
-    bool wasPlaying = (stream->isPlaying && !stream->isPaused);
+    INX_Streams.Remove(stream);
 
-    if (stream->isPaused) {
-        alSourceStop(stream->source);
-        ALint queued = 0;
-        alGetSourcei(stream->source, AL_BUFFERS_QUEUED, &queued);
-        if (queued > 0) {
-            ALuint buffers[NX_AudioStream::BufferCount];
-            alSourceUnqueueBuffers(stream->source, queued, buffers);
-        }
-    }
+    bool wasPlaying = stream->isPlaying;
+    bool wasPaused = stream->isPaused;
 
-    INX_SeekToStart(*stream);
-    INX_GetStreamPlayer().prepareStream(stream);
+    INX_PrepareStream(stream);
 
-    if (wasPlaying) {
-        alSourcePlay(stream->source);
+    // A paused stream stays paused, it is scheduled again once resumed
+    stream->isPlaying = false;
+    if (wasPlaying && !wasPaused) {
+        INX_Streams.Play(stream);
+    }
+    else if (wasPlaying) {
+        stream->isPlaying = true;
     }
 }
 
@@ -536,6 +755,35 @@ void NX_SetAudioStreamLoop(NX_AudioStream* stream, bool loop)
     stream->shouldLoop = loop;
 }
 
+bool NX_SetAudioStreamBuffering(NX_AudioStream* stream, int bufferCount, int bufferFrames)
+{
+    bufferCount = (bufferCount > 1) ? bufferCount : INX_Streams.GetBufferCount();
+    bufferFrames = (bufferFrames > 0) ? bufferFrames : INX_Streams.GetBufferFrames();
+
+    INX_Streams.Remove(stream);
+
+    stream->isPaused = false;
+    stream->isPlaying = false;
+
+    INX_ReleaseStreamBuffers(stream);
+    INX_DeleteStreamBuffers(stream);
+
+    if (!INX_CreateStreamBuffers(stream, bufferCount, bufferFrames)) {
+        NX_LOG(E, "AUDIO: Failed to create buffers; %i buffers of %i frames", bufferCount, bufferFrames);
+        INX_DeleteStreamBuffers(stream);
+        return false;
+    }
+
+    INX_PrepareStream(stream);
+
+    return true;
+}
+
+int NX_GetAudioStreamUnderruns(const NX_AudioStream* stream)
+{
+    return stream->underruns;
+}
+
 float NX_GetAudioStreamDuration(const NX_AudioStream* stream)
 {
     switch (stream->audioFormat) {
@@ -9,6 +9,9 @@
 #ifndef NX_AUDIO_STREAM_HPP
 #define NX_AUDIO_STREAM_HPP
 
+#include <NX/NX_Init.h>
+
+#include "./Detail/Util/DynamicArray.hpp"
 #include "./Detail/Util/Memory.hpp"
 #include "./INX_AudioUtils.hpp"
 
@@ -16,22 +19,25 @@
 #include <dr_flac.h>
 #include <dr_wav.h>
 #include <dr_mp3.h>
-#include <array>
+#include <atomic>
 #include <al.h>
 
 struct NX_AudioStream {
-    static constexpr size_t BufferCount = 3;
-    static constexpr size_t BufferSize = 256 * 32 * 2 * 2; // frames * blocks * channels * bytes
+    static constexpr int DefaultBufferCount = 4;
+    static constexpr int DefaultBufferFrames = 4096;
 
     // OpenAL resources
-    std::array<ALuint, BufferCount> buffers{};
+    util::DynamicArray<ALuint> buffers{};
+    util::DynamicArray<ALuint> freeBuffers{};       //< Unqueued buffers, waiting for decoded data
     ALuint source{};
     ALenum format{};
 
     // Audio data and decoder
     util::UniquePtr<uint8_t> audioData{};
     INX_AudioFormat audioFormat{};
-    
+    int channels{};
+    int sampleRate{};
+
     union Decoder {
         drwav* wav;
         drflac* flac;
@@ -39,12 +45,36 @@ struct NX_AudioStream {
         stb_vorbis* ogg;
     } decoder{};
 
+    // Decoded buffers, owned by a decoding thread while 'decoding' is set
+    util::UniquePtr<uint8_t> staging{};
+    util::DynamicArray<uint32_t> stagedBytes{};
+    int bufferFrames{};
+    int requestedCount{};
+    int stagedCount{};
+    bool decoding{};
+    bool endOfData{};                               //< The decoder reached the end without looping
+    bool needsPrepare{};                            //< Finished, its buffers must be filled before playing again
+
+    // Scheduling
+    int64_t deadline{};                             //< Time in nanoseconds at which the queued audio runs out
+    std::atomic<int> underruns{};
+
     // State flags
-    bool shouldLoop{};
-    bool isPaused{};
-    bool isPlaying{};
+    std::atomic<bool> shouldLoop{};
+    std::atomic<bool> isPaused{};
+    std::atomic<bool> isPlaying{};
 
     ~NX_AudioStream();
 };
 
+// ============================================================================
+// INTERNAL FUNCTIONS
+// ============================================================================
+
+/** Starts the stream scheduler and its decoding threads, called by INX_AudioState_Init() */
+bool INX_AudioStreams_Init(const NX_AppDesc& desc);
+
+/** Stops the stream scheduler, called by INX_AudioState_Quit() once the streams are destroyed */
+void INX_AudioStreams_Quit();
+
 #endif // NX_AUDIO_STREAM_HPP
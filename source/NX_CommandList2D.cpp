@@ -0,0 +1,36 @@
+/* NX_CommandList2D.cpp -- API definition for Nexium's 2D command list module
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#include "./NX_CommandList2D.hpp"
+#include "./INX_GlobalPool.hpp"
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+// NOTE: Recording and replay are part of the 2D renderer, see 'NX_Render2D.cpp'
+
+NX_CommandList2D* NX_CreateCommandList2D()
+{
+    return INX_Pool.Create<NX_CommandList2D>();
+}
+
+void NX_DestroyCommandList2D(NX_CommandList2D* list)
+{
+    INX_Pool.Destroy(list);
+}
+
+int NX_GetCommandList2DDrawCount(const NX_CommandList2D* list)
+{
+    return static_cast<int>(list->commands.GetSize());
+}
+
+int NX_GetCommandList2DVertexCount(const NX_CommandList2D* list)
+{
+    return static_cast<int>(list->vertices.GetSize());
+}
@@ -0,0 +1,61 @@
+/* NX_CommandList2D.hpp -- API definition for Nexium's 2D command list module
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef NX_COMMAND_LIST_2D_HPP
+#define NX_COMMAND_LIST_2D_HPP
+
+#include <NX/NX_CommandList2D.h>
+#include <NX/NX_Shader2D.h>
+#include <NX/NX_Texture.h>
+#include <NX/NX_Vertex.h>
+#include <NX/NX_Font.h>
+
+#include "./Detail/Util/DynamicArray.hpp"
+#include "./Detail/GPU/VertexArray.hpp"
+#include "./Detail/GPU/Buffer.hpp"
+
+// ============================================================================
+// INTERNAL TYPES
+// ============================================================================
+
+/** Draw call of a list, the shader uniforms and textures are those current at replay */
+struct INX_Command2D {
+    NX_Shader2D* shader;
+    const NX_Texture* texture;  //< Shapes only
+    const NX_Font* font;        //< Text only
+    uint32_t atlasGeneration;   //< Atlas layout the glyph coordinates refer to
+    uint32_t offset, count;     //< Range in the index buffer (in number of indices)
+    bool text;
+};
+
+/** Glyph quad of a list, its texture coordinates are resolved again once the atlas of its font changed */
+struct INX_RecordedGlyph2D {
+    const NX_Font* font;        //< Font selected when recorded
+    uint32_t vertex;            //< First of the four vertices of the quad
+    int32_t codepoint;
+    uint32_t atlasGeneration;   //< Atlas layout the texture coordinates refer to
+};
+
+// ============================================================================
+// OPAQUE DEFINITION
+// ============================================================================
+
+struct NX_CommandList2D {
+    /** Recorded data, the CPU copy allows composing the list into another one */
+    util::DynamicArray<NX_Vertex2D> vertices{};
+    util::DynamicArray<uint32_t> indices{};
+    util::DynamicArray<INX_Command2D> commands{};
+    util::DynamicArray<INX_RecordedGlyph2D> glyphs{};
+
+    /** Static GPU copy, uploaded when the recording ends */
+    gpu::Buffer vbo{};
+    gpu::Buffer ebo{};
+    gpu::VertexArray vao{};
+};
+
+#endif // NX_COMMAND_LIST_2D_HPP
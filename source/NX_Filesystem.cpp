@@ -6,12 +6,58 @@
  * For conditions of distribution and use, see accompanying LICENSE file.
  */
 
+#include "./NX_Filesystem.hpp"
+
 #include <NX/NX_Filesystem.h>
 #include <NX/NX_Memory.h>
 
+#include <SDL3/SDL_filesystem.h>
 #include <SDL3/SDL_stdinc.h>
 #include <physfs.h>
 
+// ============================================================================
+// PHYSFS COMPATIBILITY
+// ============================================================================
+
+static void* INX_PhysFS_malloc(PHYSFS_uint64 size)
+{
+    return SDL_malloc(static_cast<size_t>(size));
+}
+
+static void* INX_PhysFS_realloc(void* ptr, PHYSFS_uint64 size)
+{
+    return SDL_realloc(ptr, static_cast<size_t>(size));
+}
+
+// ============================================================================
+// INTERNAL FUNCTIONS
+// ============================================================================
+
+bool INX_FilesystemState_Init()
+{
+    static constexpr PHYSFS_Allocator Allocator = {
+        .Init = nullptr,
+        .Deinit = nullptr,
+        .Malloc = INX_PhysFS_malloc,
+        .Realloc = INX_PhysFS_realloc,
+        .Free = SDL_free
+    };
+
+    if (PHYSFS_setAllocator(&Allocator) == 0) {
+        return false;
+    }
+
+    if (PHYSFS_init(nullptr) == 0) {
+        return false;
+    }
+
+    if (PHYSFS_mount(SDL_GetBasePath(), "/", 1) == 0) {
+        return false;
+    }
+
+    return true;
+}
+
 // ============================================================================
 // PUBLIC API
 // ============================================================================
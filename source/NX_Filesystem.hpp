@@ -0,0 +1,21 @@
+/* NX_Filesystem.hpp -- API definition for Nexium's filesystem module
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef NX_FILESYSTEM_HPP
+#define NX_FILESYSTEM_HPP
+
+#include <NX/NX_Filesystem.h>
+
+// ============================================================================
+// INTERNAL FUNCTIONS
+// ============================================================================
+
+/** Should be called in NX_Init(), mounts the base path of the application */
+bool INX_FilesystemState_Init();
+
+#endif // NX_FILESYSTEM_HPP
@@ -11,32 +11,19 @@
 
 #include <NX/NX_Font.h>
 
-#include "./Detail/Util/FixedArray.hpp"
-#include "./Detail/Util/Memory.hpp"
+#include "./INX_GlyphCache.hpp"
 #include "./NX_Texture.hpp"
 
 // ============================================================================
 // OPAQUE DEFINITION
 // ============================================================================
 
-struct INX_Glyph {
-    util::UniquePtr<uint8_t> pixels;    //< Pixels of the glyph (R8 unorm)
-    int value;                          //< Unicode codepoint value
-    int xOffset;                        //< Horizontal offset when drawing the glyph
-    int yOffset;                        //< Vertical offset when drawing the glyph
-    int xAdvance;                       //< Horizontal advance to next character position
-    uint16_t xAtlas;                    //< X-coordinate position in texture atlas
-    uint16_t yAtlas;                    //< Y-coordinate position in texture atlas
-    uint16_t wGlyph;                    //< Width in pixels of the glyph (this also applies to the atlas)
-    uint16_t hGlyph;                    //< Height in pixels of the glyph (this also applies to the atlas)
-};
-
 struct NX_Font {
-    int baseSize{};                       //< Base font size (default character height in pixels)
-    int glyphPadding{};                   //< Padding around glyphs in the texture atlas
-    NX_Texture* texture{};                //< Texture atlas containing all glyph images
-    util::FixedArray<INX_Glyph> glyphs{}; //< Array of glyph information structures
-    NX_FontType type{};                   //< Font rendering type used during text rendering
+    int baseSize{};                         //< Base font size (default character height in pixels)
+    NX_Texture* texture{};                  //< Texture atlas containing all glyph images
+    mutable INX_GlyphCache glyphs{};        //< Glyph table, filled on demand during lookups
+    mutable uint32_t textureGeneration{};   //< Atlas generation currently stored in the texture
+    NX_FontType type{};                     //< Font rendering type used during text rendering
     ~NX_Font();
 };
 
@@ -44,6 +31,33 @@ struct NX_Font {
 // INTERNAL FUNCTIONS
 // ============================================================================
 
+/** Rasterizes the initial glyphs into the atlas image, without any GPU work so it can run on a worker */
+bool INX_InitFontGlyphs(NX_Font* font, const void* fileData, size_t dataSize, NX_FontType type, int baseSize, const int* codepoints, int codepointCount);
+
+/** Creates the atlas texture of a font whose glyphs were initialized */
+bool INX_CreateFontTexture(NX_Font* font);
+
+/** Returns the glyph of 'codepoint', rasterized into the atlas image on first use */
 const INX_Glyph& INX_GetFontGlyph(const NX_Font* font, int codepoint);
 
+/** Returns true if the atlas was grown since the last texture update, moving existing glyphs */
+bool INX_IsFontTextureStale(const NX_Font* font);
+
+/** Uploads the glyphs added since the last update, or the whole atlas if it was grown */
+void INX_UpdateFontTexture(const NX_Font* font);
+
+// ============================================================================
+// INLINE IMPLEMENTATION
+// ============================================================================
+
+inline const INX_Glyph& INX_GetFontGlyph(const NX_Font* font, int codepoint)
+{
+    return font->glyphs.GetGlyph(codepoint);
+}
+
+inline bool INX_IsFontTextureStale(const NX_Font* font)
+{
+    return font->glyphs.GetAtlasGeneration() != font->textureGeneration;
+}
+
 #endif // NX_FONT_HPP
@@ -11,11 +11,16 @@
 #include <NX/NX_Math.h>
 #include <NX/NX_Log.h>
 
+#include "./INX_ImageResample.hpp"
+#include "./INX_PixelConvert.hpp"
+#include "./Detail/Util/DynamicArray.hpp"
+
 #include <SDL3/SDL_stdinc.h>
 #include <fp16.h>
 
 #include <initializer_list>
 #include <algorithm>
+#include <utility>
 #include <cstdint>
 #include <cmath>
 
@@ -176,10 +181,7 @@ NX_Image NX_CreateImageFromData(const void* pixels, int w, int h, NX_PixelFormat
         SDL_memcpy(dstPixels, pixels, size * dstBpp);
     }
     else {
-        for (int i = 0; i < size; i++) {
-            NX_Color color = NX_ReadPixel(pixels, i, srcFormat);
-            NX_WritePixel(dstPixels, i, dstFormat, color);
-        }
+        INX_ConvertPixels(pixels, srcFormat, dstPixels, dstFormat, w, h);
     }
 
     image.pixels = dstPixels;
@@ -484,10 +486,7 @@ NX_Image NX_CopyImage(const NX_Image* image, NX_PixelFormat format)
         SDL_memcpy(pixels, image->pixels, size * bpp);
     }
     else {
-        for (int i = 0; i < size; i++) {
-            NX_Color color = NX_ReadPixel(image->pixels, i, image->format);
-            NX_WritePixel(pixels, i, format, color);
-        }
+        INX_ConvertPixels(image->pixels, image->format, pixels, format, image->w, image->h);
     }
 
     result.pixels = pixels;
@@ -625,10 +624,7 @@ void NX_ConvertImage(NX_Image* image, NX_PixelFormat format)
         return;
     }
 
-    for (int i = 0; i < size; i++) {
-        NX_Color color = NX_ReadPixel(image->pixels, i, image->format);
-        NX_WritePixel(pixels, i, format, color);
-    }
+    INX_ConvertPixels(image->pixels, image->format, pixels, format, image->w, image->h);
 
     SDL_free(image->pixels);
 
@@ -642,18 +638,7 @@ void NX_InvertImage(const NX_Image* image)
         return;
     }
 
-    NX_PixelFormat format = image->format;
-    void* pixels = image->pixels;
-
-    int size = image->w * image->h;
-
-    for (int i = 0; i < size; i++) {
-        NX_Color color = NX_ReadPixel(pixels, i, format);
-        color.r = 1.0f - color.r;
-        color.g = 1.0f - color.g;
-        color.b = 1.0f - color.b;
-        NX_WritePixel(pixels, i, format, color);
-    }
+    INX_InvertPixels(image->pixels, image->format, static_cast<size_t>(image->w) * image->h);
 }
 
 void NX_BlitImage(
@@ -687,22 +672,152 @@ void NX_BlitImage(
     int srcStartX = srcX + ((startOffsetX * scaleX) >> 16);
     int srcStartY = srcY + ((startOffsetY * scaleY) >> 16);
 
-    for (int y = 0; y < clipDstH; y++) {
-        for (int x = 0; x < clipDstW; x++)
-        {
-            int srcPixelX = srcStartX + ((x * scaleX) >> 16);
-            int srcPixelY = srcStartY + ((y * scaleY) >> 16);
+    /* --- Blitting a region onto itself changes nothing --- */
+
+    const bool identity = (src->pixels == dst->pixels) && (src->w == dst->w) && (src->format == dst->format)
+        && (scaleX == (1 << 16)) && (scaleY == (1 << 16)) && (srcStartX == clipDstX) && (srcStartY == clipDstY);
+
+    if (identity) {
+        return;
+    }
+
+    INX_PixelRowKernel kernel = INX_GetPixelRowKernel(src->format, dst->format);
+    if (kernel == nullptr) {
+        return;
+    }
+
+    const int srcBpp = NX_GetPixelBytes(src->format);
+    const int dstBpp = NX_GetPixelBytes(dst->format);
+
+    const uint8_t* srcPixels = static_cast<const uint8_t*>(src->pixels);
+    uint8_t* dstPixels = static_cast<uint8_t*>(dst->pixels);
+
+    const int lastRow = srcY + srcH - 1;
+    const size_t srcPitch = static_cast<size_t>(src->w) * srcBpp;
+
+    /* --- Overlapping images are read from a copy of the source rows --- */
+
+    // The kernels expect distinct memory, and rows written first could be read again afterwards
+    const uint8_t* srcEnd = srcPixels + static_cast<size_t>(src->h) * srcPitch;
+    const uint8_t* dstEnd = dstPixels + static_cast<size_t>(dst->h) * dst->w * dstBpp;
+
+    util::DynamicArray<uint8_t> srcCopy{};
+    int srcFirstRow = 0;
+
+    if (srcPixels < dstEnd && dstPixels < srcEnd) {
+        const size_t bytes = static_cast<size_t>(lastRow - srcStartY + 1) * srcPitch;
+        if (!srcCopy.Resize(bytes)) {
+            NX_LOG(E, "IMAGE: failed to allocate %zu bytes for image blit", bytes);
+            return;
+        }
+        SDL_memcpy(srcCopy.GetData(), srcPixels + static_cast<size_t>(srcStartY) * srcPitch, bytes);
+        srcPixels = srcCopy.GetData();
+        srcFirstRow = srcStartY;
+    }
+
+    /* --- Without horizontal scaling, source rows are converted directly --- */
+
+    util::DynamicArray<uint8_t> row{};
+    const bool gather = (scaleX != (1 << 16)) || (srcStartX + clipDstW > src->w);
+
+    if (gather && !row.Resize(clipDstW * srcBpp)) {
+        NX_LOG(E, "IMAGE: failed to allocate %i bytes for image blit", clipDstW * srcBpp);
+        return;
+    }
+
+    for (int y = 0; y < clipDstH; y++)
+    {
+        int srcPixelY = srcStartY + ((y * scaleY) >> 16);
+        if (srcPixelY > lastRow) srcPixelY = lastRow;
+
+        const uint8_t* srcRow = srcPixels + static_cast<size_t>(srcPixelY - srcFirstRow) * srcPitch;
+        uint8_t* dstRow = dstPixels + (static_cast<size_t>(clipDstY + y) * dst->w + clipDstX) * dstBpp;
+
+        if (!gather) {
+            kernel(srcRow + static_cast<size_t>(srcStartX) * srcBpp, dstRow, clipDstW);
+            continue;
+        }
 
+        for (int x = 0; x < clipDstW; x++) {
+            int srcPixelX = srcStartX + ((x * scaleX) >> 16);
             if (srcPixelX >= src->w) srcPixelX = src->w - 1;
-            if (srcPixelY >= src->h) srcPixelY = src->h - 1;
+            SDL_memcpy(row.GetData() + x * srcBpp, srcRow + static_cast<size_t>(srcPixelX) * srcBpp, srcBpp);
+        }
+
+        kernel(row.GetData(), dstRow, clipDstW);
+    }
+}
+
+NX_Image NX_ResizeImage(const NX_Image* image, int w, int h, NX_ImageFilter filter, bool srgb)
+{
+    if (image == NULL || image->pixels == NULL || w <= 0 || h <= 0) {
+        return NX_Image{};
+    }
+
+    INX_LinearImage source{};
+    INX_LinearImage resized{};
 
-            int srcIndex = srcPixelY * src->w + srcPixelX;
-            int dstIndex = (clipDstY + y) * dst->w + (clipDstX + x);
+    if (!INX_DecodeLinearImage(*image, srgb, &source)) {
+        return NX_Image{};
+    }
+
+    if (!INX_ResampleLinearImage(source, w, h, filter, &resized)) {
+        return NX_Image{};
+    }
+
+    return INX_EncodeLinearImage(resized, image->format, srgb);
+}
+
+int NX_GenImageMipmaps(const NX_Image* image, NX_Image* mipmaps, int maxLevels, NX_ImageFilter filter, bool srgb)
+{
+    if (image == NULL || image->pixels == NULL || image->w <= 0 || image->h <= 0) {
+        return 0;
+    }
 
-            NX_Color color = NX_ReadPixel(src->pixels, srcIndex, src->format);
-            NX_WritePixel(dst->pixels, dstIndex, dst->format, color);
+    int levelCount = 0;
+    for (int size = NX_MAX(image->w, image->h); size > 1; size >>= 1) {
+        levelCount++;
+    }
+
+    if (mipmaps == NULL) {
+        return levelCount;
+    }
+
+    levelCount = NX_MIN(levelCount, maxLevels);
+    if (levelCount <= 0) {
+        return 0;
+    }
+
+    /* --- Decode once, each level is then filtered from the previous one --- */
+
+    INX_LinearImage previous{};
+    INX_LinearImage current{};
+
+    if (!INX_DecodeLinearImage(*image, srgb, &previous)) {
+        return 0;
+    }
+
+    for (int level = 0; level < levelCount; level++)
+    {
+        const int w = NX_MAX(previous.w >> 1, 1);
+        const int h = NX_MAX(previous.h >> 1, 1);
+
+        mipmaps[level] = NX_Image{};
+        if (INX_ResampleLinearImage(previous, w, h, filter, &current)) {
+            mipmaps[level] = INX_EncodeLinearImage(current, image->format, srgb);
+        }
+
+        if (mipmaps[level].pixels == NULL) {
+            for (int i = 0; i < level; i++) {
+                NX_DestroyImage(&mipmaps[i]);
+            }
+            return 0;
         }
+
+        std::swap(previous, current);
     }
+
+    return levelCount;
 }
 
 int NX_GetPixelBytes(NX_PixelFormat format)
@@ -10,16 +10,20 @@
 #include <NX/NX_Random.h>
 #include <NX/NX_Log.h>
 
+#include "./INX_ProgramBinaryCache.hpp"
 #include "./INX_GPUProgramCache.hpp"
+#include "./INX_MaterialArrays.hpp"
 #include "./INX_GlobalAssets.hpp"
 #include "./INX_GlobalState.hpp"
+#include "./INX_AssetLoader.hpp"
 #include "./INX_GlobalPool.hpp"
+#include "./INX_JobSystem.hpp"
 
+#include "./NX_Filesystem.hpp"
 #include "./NX_Render3D.hpp"
 #include "./NX_Render2D.hpp"
 #include "./NX_Audio.hpp"
 
-#include <SDL3/SDL_filesystem.h>
 #include <SDL3/SDL_stdinc.h>
 #include <SDL3/SDL_error.h>
 #include <SDL3/SDL_video.h>
@@ -27,21 +31,6 @@
 #include <SDL3/SDL_init.h>
 #include <SDL3/SDL_log.h>
 #include <glad/gles2.h>
-#include <physfs.h>
-
-// ============================================================================
-// PHYSFS COMPATIBILITY
-// ============================================================================
-
-static void* INX_PhysFS_malloc(PHYSFS_uint64 size)
-{
-    return SDL_malloc(static_cast<size_t>(size));
-}
-
-static void* INX_PhysFS_realloc(void* ptr, PHYSFS_uint64 size)
-{
-    return SDL_realloc(ptr, static_cast<size_t>(size));
-}
 
 // ============================================================================
 // LOCAL INIT FUNCTIONS
@@ -85,31 +74,6 @@ static bool INX_SDL_Init(const NX_AppDesc& desc)
     return true;
 }
 
-static bool INX_PhysFS_Init()
-{
-    static constexpr PHYSFS_Allocator Allocator = {
-        .Init = nullptr,
-        .Deinit = nullptr,
-        .Malloc = INX_PhysFS_malloc,
-        .Realloc = INX_PhysFS_realloc,
-        .Free = SDL_free
-    };
-
-    if (PHYSFS_setAllocator(&Allocator) == 0) {
-        return false;
-    }
-
-    if (PHYSFS_init(nullptr) == 0) {
-        return false;
-    }
-
-    if (PHYSFS_mount(SDL_GetBasePath(), "/", 1) == 0) {
-        return false;
-    }
-
-    return true;
-}
-
 static SDL_WindowFlags INX_GetWindowFlags(NX_Flags flags)
 {
     SDL_WindowFlags windowFlags = 0;
@@ -222,6 +186,10 @@ static bool INX_DisplayState_Init(const char* title, int w, int h, const NX_AppD
 
     INX_Display.glProfile = useOpenGLES ? SDL_GL_CONTEXT_PROFILE_ES : SDL_GL_CONTEXT_PROFILE_CORE;
 
+    /* --- Init the program binary cache --- */
+
+    INX_ProgramBinaries.Init(INX_ProgramBinaryCache::GetDefaultProvider());
+
     /* --- Set VSync --- */
 
     if (desc.flags & NX_FLAG_VSYNC_HINT) {
@@ -317,10 +285,19 @@ bool NX_InitEx(const char* title, int w, int h, NX_AppDesc* desc)
         return false;
     }
 
-    if (!INX_PhysFS_Init()) {
+    if (!INX_FilesystemState_Init()) {
+        return false;
+    }
+
+    // The job system takes a negative count to pick it from the number of cores
+    int workerCount = (desc->workerCount == 0) ? -1 : NX_MAX(desc->workerCount, 0);
+
+    if (!INX_Jobs.Init(workerCount)) {
         return false;
     }
 
+    INX_AssetLoads.Init(desc->assets.uploadBudget);
+
     /* --- Init each modules --- */
 
     if (!INX_DisplayState_Init(title, w, h, *desc)) {
@@ -350,9 +327,14 @@ bool NX_InitEx(const char* title, int w, int h, NX_AppDesc* desc)
 
 void NX_Quit()
 {
+    // Pending requests hold GPU resources and are still referenced by workers
+    INX_AssetLoads.Quit();
+
     INX_Programs.UnloadAll();
+    INX_MaterialArrays.UnloadAll();
     INX_Assets.UnloadAll();
     INX_Pool.UnloadAll();
+    INX_ProgramBinaries.Quit();
 
     INX_Render3DState_Quit();
     INX_Render2DState_Quit();
@@ -364,5 +346,7 @@ void NX_Quit()
     INX_GamepadState_Quit();
     INX_FrameState_Quit();
 
+    INX_Jobs.Quit();
+
     SDL_Quit();
 }
@@ -48,8 +48,9 @@ struct NX_InstanceBuffer {
 
 inline const gpu::Buffer* NX_InstanceBuffer::GetBuffer(NX_InstanceData type) const
 {
+    // Flags are checked too, compacted copies keep the buffers of types their current source lacks
     const gpu::Buffer& buffer = this->buffers[INX_BitScanForward(type)];
-    return buffer.IsValid() ? &buffer : nullptr;
+    return ((this->bufferFlags & type) && buffer.IsValid()) ? &buffer : nullptr;
 }
 
 #endif // NX_INSTANCE_BUFFER_HPP
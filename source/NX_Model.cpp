@@ -9,10 +9,11 @@
 #include <NX/NX_Model.h>
 
 #include "./Importer/AnimationImporter.hpp"
-#include "./Importer/MaterialImporter.hpp"
-#include "./Importer/SkeletonImporter.hpp"
+#include "./Importer/ModelImporter.hpp"
 #include "./Importer/SceneImporter.hpp"
-#include "./Importer/MeshImporter.hpp"
+#include "./Importer/ModelCache.hpp"
+#include "./Importer/ModelData.hpp"
+#include "./Detail/Util/DynamicArray.hpp"
 #include "./INX_Utils.hpp"
 
 #include "./INX_GlobalPool.hpp"
@@ -22,6 +23,48 @@
 #include <NX/NX_Memory.h>
 #include <NX/NX_Log.h>
 
+// ============================================================================
+// INTERNAL FUNCTIONS
+// ============================================================================
+
+static NX_Model* INX_UploadModel(import::ModelData* modelData)
+{
+    for (int i = 0; i < modelData->GetUploadStepCount(); i++) {
+        if (!modelData->UploadStep(i)) {
+            return nullptr;
+        }
+    }
+
+    return modelData->Finish();
+}
+
+static NX_Model* INX_LoadModelCache(const void* data, size_t size)
+{
+    // The cache is read in place, only a misaligned buffer is copied first
+    void* copy = nullptr;
+    if (reinterpret_cast<uintptr_t>(data) % import::ModelCache::Alignment != 0) {
+        copy = NX_Malloc(size);
+        if (copy == nullptr) {
+            NX_LOG(E, "RENDER: Failed to load model cache; Out of memory");
+            return nullptr;
+        }
+        SDL_memcpy(copy, data, size);
+        data = copy;
+    }
+
+    NX_Model* model = nullptr;
+    {
+        import::ModelData modelData;
+        if (import::ModelCache::Load(&modelData, data, size)) {
+            model = INX_UploadModel(&modelData);
+        }
+    }
+
+    NX_Free(copy);
+
+    return model;
+}
+
 // ============================================================================
 // PUBLIC API
 // ============================================================================
@@ -43,30 +86,61 @@ NX_Model* NX_LoadModel(const char* filePath)
 
 NX_Model* NX_LoadModelFromData(const void* data, size_t size, const char* hint)
 {
+    if (import::ModelCache::IsCache(data, size)) {
+        return INX_LoadModelCache(data, size);
+    }
+
     import::SceneImporter importer(data, size, hint);
     if (!importer.IsValid()) {
         return nullptr;
     }
 
-    NX_Model* model = INX_Pool.Create<NX_Model>();
-    if (model == nullptr) {
-        NX_LOG(E, "RENDER: Failed to load model; Object pool issue");
+    import::ModelData modelData;
+    if (!import::ModelImporter(importer).LoadModel(&modelData)) {
         return nullptr;
     }
 
-    if (!import::MeshImporter(importer).LoadMeshes(model)) {
-        NX_DestroyModel(model);
-        return nullptr;
+    return INX_UploadModel(&modelData);
+}
+
+bool NX_SaveModelCache(const char* modelPath, const char* cachePath)
+{
+    size_t fileSize = 0;
+    void* fileData = NX_LoadFile(modelPath, &fileSize);
+    if (fileData == nullptr || fileSize == 0) {
+        NX_LOG(E, "RENDER: Failed to load model data: %s", modelPath);
+        NX_Free(fileData);
+        return false;
     }
 
-    if (!import::MaterialImporter(importer).LoadMaterials(model)) {
-        NX_DestroyModel(model);
-        return nullptr;
+    util::DynamicArray<uint8_t> cache{};
+    bool success = false;
+    {
+        import::SceneImporter importer(fileData, fileSize, INX_GetFileExt(modelPath));
+        if (importer.IsValid())
+        {
+            // The cache stores every image, none is taken from the shared textures
+            import::ModelData modelData;
+            modelData.shareTextures = false;
+
+            if (import::ModelImporter(importer).LoadModel(&modelData)) {
+                NX_AnimationLib* animLib = nullptr;
+                if (importer.GetAnimationCount() > 0) {
+                    animLib = import::AnimationImporter(importer).LoadAnimationLib();
+                }
+                success = import::ModelCache::Save(&cache, modelData, animLib);
+                NX_DestroyAnimationLib(animLib);
+            }
+        }
     }
 
-    model->skeleton = import::SkeletonImporter(importer).ProcessSkeleton();
+    NX_Free(fileData);
 
-    return model;
+    if (success) {
+        success = NX_WriteFile(cachePath, cache.GetData(), cache.GetSize());
+    }
+
+    return success;
 }
 
 void NX_DestroyModel(NX_Model* model)
@@ -90,6 +164,11 @@ void NX_DestroyModel(NX_Model* model)
     INX_Pool.Destroy(model);
 }
 
+NX_TextureImportStats NX_GetTextureImportStats(void)
+{
+    return INX_Pool.GetTextureImportStats();
+}
+
 void NX_UpdateModelAABB(NX_Model* model)
 {
     if (!model || !model->meshes) {
@@ -17,14 +17,20 @@
 #include "./INX_GPUProgramCache.hpp"
 #include "./INX_GlobalAssets.hpp"
 #include "./INX_GlobalPool.hpp"
+#include "./INX_GlobalState.hpp"
+#include "./INX_Sprite2D.hpp"
+#include "./NX_CommandList2D.hpp"
+#include "./NX_TextLayout.hpp"
 #include "./NX_Shader2D.hpp"
 #include "./NX_Texture.hpp"
 
+#include "./Detail/Util/DynamicArray.hpp"
 #include "./Detail/Util/StaticArray.hpp"
 #include "./Detail/Util/Memory.hpp"
 #include "./Detail/Util/Ranges.hpp"
 
 #include "./Detail/GPU/VertexArray.hpp"
+#include "./Detail/GPU/RingBuffer.hpp"
 #include "./Detail/GPU/Pipeline.hpp"
 #include "./Detail/GPU/Buffer.hpp"
 #include "NX/NX_Math.h"
@@ -37,13 +43,13 @@
 // ============================================================================
 
 enum class INX_DrawMode2D {
-    SHAPE, TEXT
+    SHAPE, TEXT, SPRITE
 };
 
 struct INX_DrawCall2D {
     /** Constructors */
     INX_DrawCall2D() = default;
-    INX_DrawCall2D(NX_Shader2D* s, const NX_Texture* t, size_t o);
+    INX_DrawCall2D(NX_Shader2D* s, const NX_Texture* t, size_t o, INX_DrawMode2D m = INX_DrawMode2D::SHAPE);
     INX_DrawCall2D(NX_Shader2D* s, const NX_Font* f, size_t o);
 
     /** Shader related data */
@@ -58,12 +64,12 @@ struct INX_DrawCall2D {
     };
 
     /** Draw call info */
-    size_t offset, count;       //< Offset and count in the index buffer (in number of indices)
+    size_t offset, count;       //< Offset and count in the index buffer (in number of indices), or in the sprite buffer for sprites
     INX_DrawMode2D mode;
 };
 
-inline INX_DrawCall2D::INX_DrawCall2D(NX_Shader2D* s, const NX_Texture* t, size_t o)
-    : shader(s), texture(t), offset(o), count(0), mode(INX_DrawMode2D::SHAPE)
+inline INX_DrawCall2D::INX_DrawCall2D(NX_Shader2D* s, const NX_Texture* t, size_t o, INX_DrawMode2D m)
+    : shader(s), texture(t), offset(o), count(0), mode(m)
 {
     if (s != nullptr) {
         shaderTextures = s->GetTextures();
@@ -75,10 +81,26 @@ inline INX_DrawCall2D::INX_DrawCall2D(NX_Shader2D* s, const NX_Font* f, size_t o
     : shader(s), font(f), offset(o), count(0), mode(INX_DrawMode2D::TEXT)
 { }
 
-struct INX_VertexBuffer2D {
+struct INX_Batch2D {
+    /** GPU buffers, vertices, indices and sprites are written directly in their current segment */
+    gpu::RingBuffer vbo{};
+    gpu::RingBuffer ebo{};
+    gpu::RingBuffer sbo{};
     gpu::VertexArray vao{};
-    gpu::Buffer vbo{};
-    gpu::Buffer ebo{};
+
+    /** Memory of the current segments, null until the first primitive of the batch */
+    NX_Vertex2D* vertices{nullptr};
+    void* indices{nullptr};
+    INX_SpriteInstance2D* sprites{nullptr};
+    int vertexCount{0};
+    int indexCount{0};
+    int spriteCount{0};
+
+    /** Room of the current batch, what is left of the frame segment after the previous flushes */
+    int vertexCapacity{0};
+    int indexCapacity{0};
+    int spriteCapacity{0};
+    GLenum indexType{GL_UNSIGNED_SHORT};
 };
 
 struct INX_FrameUniform2D {
@@ -92,18 +114,17 @@ struct INX_FrameUniform2D {
 
 struct INX_Render2DState {
     /** Constants */
-    static constexpr int MaxDrawCalls = 128;
-    static constexpr int MaxVertices = 4096;
-    static constexpr int MaxIndices = 6144;
+    static constexpr int DefaultBatchVertices = 16384;
+    static constexpr int MaxBatchVertices16 = 65536;        //< Addressable with 16-bit indices
+    static constexpr int MaxBatchVertices32 = 1 << 20;
+    static constexpr int MaxBatchSprites = 1 << 18;
 
     /** CPU Buffers */
-    util::StaticArray<INX_DrawCall2D, MaxDrawCalls> drawCalls{};
-    util::StaticArray<NX_Vertex2D, MaxVertices> vertices{};
-    util::StaticArray<uint16_t, MaxIndices> indices{};
+    util::DynamicArray<INX_DrawCall2D> drawCalls{};
     util::StaticArray<NX_Mat3, 16> matrixStack{};
 
     /** GPU Buffers */
-    INX_VertexBuffer2D vertexBuffer{};
+    INX_Batch2D batch{};
     gpu::Buffer uniformBuffer{};
 
     /** Framebuffer */
@@ -116,6 +137,12 @@ struct INX_Render2DState {
     const NX_Font* currentFont{nullptr};
     const NX_Texture* currentTexture{nullptr};
     const NX_RenderTexture* currentTarget{nullptr};
+
+    /** Recording, the batch writes in the list instead, see 'NX_BeginCommandList2D' */
+    NX_CommandList2D* recording{nullptr};
+    struct {
+        GLenum indexType;
+    } savedBatch{};                             //< Restored once the recording ends
 };
 
 static util::UniquePtr<INX_Render2DState> INX_Render2D{};
@@ -124,40 +151,18 @@ static util::UniquePtr<INX_Render2DState> INX_Render2D{};
 // INTERNAL FUNCTIONS
 // ============================================================================
 
-bool INX_Render2DState_Init(NX_AppDesc* desc)
+static int INX_Render2D_GetMaxBatchVertices()
 {
-    INX_Render2D = util::MakeUnique<INX_Render2DState>();
-    if (INX_Render2D == nullptr) {
-        return false;
-    }
-
-    /* --- Set default app descrition values --- */
-
-    if (desc->render2D.resolution < NX_IVEC2_ONE) {
-        desc->render2D.resolution = NX_GetDisplaySize();
-    }
-
-    if (desc->render2D.sampleCount < 1) {
-        desc->render2D.sampleCount = 1;
-    }
-
-    /* --- Push first transform matrix --- */
-
-    INX_Render2D->matrixStack.PushBack(NX_MAT3_IDENTITY);
-
-    /* --- Create the vertex buffer --- */
-
-    INX_VertexBuffer2D& vertexBuffer = INX_Render2D->vertexBuffer;
-
-    size_t vboSize = INX_Render2DState::MaxVertices * sizeof(NX_Vertex2D);
-    size_t eboSize = INX_Render2DState::MaxIndices * sizeof(uint16_t);
-
-    vertexBuffer.vbo = gpu::Buffer(GL_ARRAY_BUFFER, vboSize, nullptr, GL_DYNAMIC_DRAW);
-    vertexBuffer.ebo = gpu::Buffer(GL_ELEMENT_ARRAY_BUFFER, eboSize, nullptr, GL_DYNAMIC_DRAW);
+    return (INX_Render2D->batch.indexType == GL_UNSIGNED_INT)
+        ? INX_Render2DState::MaxBatchVertices32
+        : INX_Render2DState::MaxBatchVertices16;
+}
 
-    vertexBuffer.vao = gpu::VertexArray(&vertexBuffer.ebo, {
+static gpu::VertexArray INX_Render2D_CreateVertexArray(gpu::Buffer* vbo, gpu::Buffer* ebo)
+{
+    return gpu::VertexArray(ebo, {
         gpu::VertexBufferDesc {
-            .buffer = &vertexBuffer.vbo,
+            .buffer = vbo,
             .attributes = {
                 gpu::VertexAttribute {
                     .location = 0,
@@ -189,6 +194,91 @@ bool INX_Render2DState_Init(NX_AppDesc* desc)
             }
         }
     });
+}
+
+static void INX_Render2D_UpdateBatchRoom()
+{
+    INX_Batch2D& batch = INX_Render2D->batch;
+
+    const size_t indexSize = (batch.indexType == GL_UNSIGNED_INT) ? sizeof(uint32_t) : sizeof(uint16_t);
+
+    batch.vertexCapacity = static_cast<int>(batch.vbo.GetAvailable() / sizeof(NX_Vertex2D));
+    batch.indexCapacity = static_cast<int>(batch.ebo.GetAvailable() / indexSize);
+    batch.spriteCapacity = static_cast<int>(batch.sbo.GetAvailable() / sizeof(INX_SpriteInstance2D));
+}
+
+static bool INX_Render2D_CreateBatch(int vertexCapacity, int spriteCapacity)
+{
+    INX_Batch2D& batch = INX_Render2D->batch;
+
+    vertexCapacity = std::min(vertexCapacity, INX_Render2D_GetMaxBatchVertices());
+    spriteCapacity = std::min(spriteCapacity, INX_Render2DState::MaxBatchSprites);
+    int indexCapacity = vertexCapacity * 3 / 2; //< Six indices per quad
+
+    size_t indexSize = (batch.indexType == GL_UNSIGNED_INT) ? sizeof(uint32_t) : sizeof(uint16_t);
+
+    gpu::RingBuffer vbo(GL_ARRAY_BUFFER, vertexCapacity * sizeof(NX_Vertex2D));
+    gpu::RingBuffer ebo(GL_ELEMENT_ARRAY_BUFFER, indexCapacity * indexSize);
+    gpu::RingBuffer sbo(GL_SHADER_STORAGE_BUFFER, spriteCapacity * sizeof(INX_SpriteInstance2D));
+
+    if (!vbo.IsValid() || !ebo.IsValid() || !sbo.IsValid()) {
+        NX_LOG(E, "RENDER: Failed to create the 2D batch buffers (%i vertices, %i sprites)", vertexCapacity, spriteCapacity);
+        return false; //< The previous buffers, if any, are kept
+    }
+
+    batch.vbo = std::move(vbo);
+    batch.ebo = std::move(ebo);
+    batch.sbo = std::move(sbo);
+
+    batch.vao = INX_Render2D_CreateVertexArray(&batch.vbo.GetBuffer(), &batch.ebo.GetBuffer());
+
+    batch.vertices = nullptr;
+    batch.indices = nullptr;
+    batch.sprites = nullptr;
+    batch.vertexCount = 0;
+    batch.indexCount = 0;
+    batch.spriteCount = 0;
+
+    INX_Render2D_UpdateBatchRoom();
+
+    INX_Frame.render2D.batchCapacity = vertexCapacity;
+
+    return true;
+}
+
+bool INX_Render2DState_Init(NX_AppDesc* desc)
+{
+    INX_Render2D = util::MakeUnique<INX_Render2DState>();
+    if (INX_Render2D == nullptr) {
+        return false;
+    }
+
+    /* --- Set default app descrition values --- */
+
+    if (desc->render2D.resolution < NX_IVEC2_ONE) {
+        desc->render2D.resolution = NX_GetDisplaySize();
+    }
+
+    if (desc->render2D.sampleCount < 1) {
+        desc->render2D.sampleCount = 1;
+    }
+
+    if (desc->render2D.batchVertices <= 0) {
+        desc->render2D.batchVertices = INX_Render2DState::DefaultBatchVertices;
+    }
+
+    /* --- Push first transform matrix --- */
+
+    INX_Render2D->matrixStack.PushBack(NX_MAT3_IDENTITY);
+
+    /* --- Create the batch buffers --- */
+
+    INX_Render2D->batch.indexType = desc->render2D.batchIndices32 ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+
+    // Sprites start with the room of as many quads
+    if (!INX_Render2D_CreateBatch(desc->render2D.batchVertices, desc->render2D.batchVertices / 4)) {
+        return false;
+    }
 
     /* --- Create the uniform buffer --- */
 
@@ -237,157 +327,312 @@ void INX_Render2DState_Quit()
     INX_Render2D.reset();
 }
 
+static void INX_Render2D_UseProgram(const gpu::Pipeline& pipeline, const NX_Shader2D* shader, INX_DrawMode2D mode,
+                                    const NX_Texture* texture, const NX_Font* font)
+{
+    switch (mode) {
+    case INX_DrawMode2D::SHAPE:
+        if (texture != nullptr) {
+            pipeline.UseProgram(shader->GetProgram(NX_Shader2D::Variant::SHAPE_TEXTURE));
+            pipeline.BindTexture(0, INX_GetTextureGPU(texture));
+        }
+        else {
+            pipeline.UseProgram(shader->GetProgram(NX_Shader2D::Variant::SHAPE_COLOR));
+        }
+        break;
+    case INX_DrawMode2D::SPRITE:
+        if (texture != nullptr) {
+            pipeline.UseProgram(shader->GetProgram(NX_Shader2D::Variant::SPRITE_TEXTURE));
+            pipeline.BindTexture(0, INX_GetTextureGPU(texture));
+        }
+        else {
+            pipeline.UseProgram(shader->GetProgram(NX_Shader2D::Variant::SPRITE_COLOR));
+        }
+        break;
+    case INX_DrawMode2D::TEXT:
+        font = INX_Assets.Select(font, INX_FontAsset::DEFAULT);
+        switch (NX_GetFontType(font)) {
+        case NX_FONT_NORMAL:
+        case NX_FONT_LIGHT:
+        case NX_FONT_MONO:
+            pipeline.UseProgram(shader->GetProgram(NX_Shader2D::Variant::TEXT_BITMAP));
+            break;
+        case NX_FONT_SDF:
+            pipeline.UseProgram(shader->GetProgram(NX_Shader2D::Variant::TEXT_SDF));
+            break;
+        }
+        pipeline.BindTexture(0, font->texture->gpu);
+        break;
+    }
+}
+
 static void INX_Render2D_Flush()
 {
-    if (INX_Render2D->drawCalls.IsEmpty() || INX_Render2D->vertices.IsEmpty()) {
+    INX_Batch2D& batch = INX_Render2D->batch;
+
+    // While recording, the batch is the list being recorded
+    if (INX_Render2D->recording != nullptr) {
         return;
     }
 
-    /* --- Upload to vertex buffer --- */
+    if (INX_Render2D->drawCalls.IsEmpty() || (batch.vertexCount == 0 && batch.spriteCount == 0)) {
+        return;
+    }
 
-    INX_Render2D->vertexBuffer.vbo.Upload(
-        0, INX_Render2D->vertices.GetSize() * sizeof(NX_Vertex2D),
-        INX_Render2D->vertices.GetData()
-    );
+    /* --- Commit the written segments --- */
 
-    INX_Render2D->vertexBuffer.ebo.Upload(
-        0, INX_Render2D->indices.GetSize() * sizeof(uint16_t),
-        INX_Render2D->indices.GetData()
-    );
+    const size_t indexSize = (batch.indexType == GL_UNSIGNED_INT) ? sizeof(uint32_t) : sizeof(uint16_t);
+
+    const GLintptr vertexOffset = batch.vbo.Commit(batch.vertexCount * sizeof(NX_Vertex2D));
+    const GLintptr indexOffset = batch.ebo.Commit(batch.indexCount * indexSize);
+    const GLintptr spriteOffset = batch.sbo.Commit(batch.spriteCount * sizeof(INX_SpriteInstance2D));
+
+    // Segments are sized in whole elements, these divisions are exact
+    const GLint baseVertex = static_cast<GLint>(vertexOffset / sizeof(NX_Vertex2D));
+    const GLint firstIndex = static_cast<GLint>(indexOffset / indexSize);
+    const GLuint firstSprite = static_cast<GLuint>(spriteOffset / sizeof(INX_SpriteInstance2D));
 
     /* --- Setup pipeline --- */
 
     gpu::Pipeline pipeline;
 
     pipeline.SetBlendMode(gpu::BlendMode::Premultiplied);
-    pipeline.BindVertexArray(INX_Render2D->vertexBuffer.vao);
     pipeline.BindUniform(0, INX_Render2D->uniformBuffer);
+    pipeline.BindStorage(0, batch.sbo.GetBuffer());
     pipeline.BindFramebuffer(INX_Render2D->framebuffer);
     pipeline.SetViewport(INX_Render2D->framebuffer);
 
     /* --- Render all draw calls --- */
 
-    for (const INX_DrawCall2D& call : INX_Render2D->drawCalls)
+    int drawCount = 0;
+
+    for (size_t i = 0; i < INX_Render2D->drawCalls.GetSize(); i++)
     {
+        const INX_DrawCall2D& call = INX_Render2D->drawCalls[i];
+        if (call.count == 0) {
+            continue;
+        }
+
         const NX_Shader2D* shader = INX_Assets.Select(call.shader, INX_Shader2DAsset::DEFAULT);
 
         shader->BindUniforms(pipeline, call.shaderDynamicRangeIndex);
         shader->BindTextures(pipeline, call.shaderTextures);
 
-        switch (call.mode) {
-        case INX_DrawMode2D::SHAPE:
-            if (call.texture != nullptr) {
-                pipeline.UseProgram(shader->GetProgram(NX_Shader2D::Variant::SHAPE_TEXTURE));
-                pipeline.BindTexture(0, *reinterpret_cast<const gpu::Texture*>(call.texture));
-            }
-            else {
-                pipeline.UseProgram(shader->GetProgram(NX_Shader2D::Variant::SHAPE_COLOR));
-            }
-            break;
-        case INX_DrawMode2D::TEXT:
-            const NX_Font* font = INX_Assets.Select(call.font, INX_FontAsset::DEFAULT);
-            switch (NX_GetFontType(font)) {
-            case NX_FONT_NORMAL:
-            case NX_FONT_LIGHT:
-            case NX_FONT_MONO:
-                pipeline.UseProgram(shader->GetProgram(NX_Shader2D::Variant::TEXT_BITMAP));
-                break;
-            case NX_FONT_SDF:
-                pipeline.UseProgram(shader->GetProgram(NX_Shader2D::Variant::TEXT_SDF));
-                break;
-            }
-            pipeline.BindTexture(0, font->texture->gpu);
-            break;
+        INX_Render2D_UseProgram(
+            pipeline, shader, call.mode,
+            (call.mode != INX_DrawMode2D::TEXT) ? call.texture : nullptr,
+            (call.mode == INX_DrawMode2D::TEXT) ? call.font : nullptr
+        );
+
+        // Only command lists are transformed on the GPU, see 'NX_DrawCommandList2D'
+        pipeline.SetUniformFloat4(1, NX_WHITE);
+        pipeline.SetUniformMat3(2, NX_MAT3_IDENTITY);
+
+        if (call.mode == INX_DrawMode2D::SPRITE) {
+            // Sprites are expanded from 'gl_VertexID' and 'gl_InstanceID', no attributes
+            pipeline.UnbindVertexArray();
+            pipeline.SetUniformUint1(0, firstSprite + call.offset);
+            pipeline.DrawInstanced(GL_TRIANGLES, 6, call.count);
+        }
+        else {
+            pipeline.BindVertexArray(batch.vao);
+            pipeline.DrawElementsBaseVertex(
+                GL_TRIANGLES, batch.indexType,
+                firstIndex + call.offset, call.count,
+                baseVertex
+            );
         }
 
-        pipeline.DrawElements(
-            GL_TRIANGLES, GL_UNSIGNED_SHORT,
-            call.offset, call.count
-        );
+        drawCount++;
     }
 
-    /* --- Reset --- */
+    /* --- Reset, the next batch follows in the frame segment --- */
+
+    INX_Frame.render2D.flushes++;
+    INX_Frame.render2D.drawCalls += drawCount;
+    INX_Frame.render2D.vertices += batch.vertexCount;
+    INX_Frame.render2D.indices += batch.indexCount;
+    INX_Frame.render2D.sprites += batch.spriteCount;
 
     INX_Render2D->drawCalls.Clear();
-    INX_Render2D->vertices.Clear();
-    INX_Render2D->indices.Clear();
+
+    batch.vertices = nullptr;
+    batch.indices = nullptr;
+    batch.sprites = nullptr;
+    batch.vertexCount = 0;
+    batch.indexCount = 0;
+    batch.spriteCount = 0;
+
+    INX_Render2D_UpdateBatchRoom();
 }
 
-static void INX_Render2D_EnsureDrawCall(INX_DrawMode2D mode, int vertices, int indices)
+void INX_Render2DState_EndFrame()
 {
-    if (INX_Render2D->vertices.GetSize() + vertices > INX_Render2DState::MaxVertices ||
-        INX_Render2D->indices.GetSize() + indices > INX_Render2DState::MaxIndices) {
-        INX_Render2D_Flush();
+    if (INX_Render2D == nullptr) {
+        return;
     }
 
-    if (INX_Render2D->drawCalls.IsEmpty()) {
-        switch (mode) {
-        case INX_DrawMode2D::SHAPE:
-            INX_Render2D->drawCalls.EmplaceBack(
-                INX_Render2D->currentShader,
-                INX_Render2D->currentTexture,
-                0
-            );
-            break;
-        case INX_DrawMode2D::TEXT:
-            INX_Render2D->drawCalls.EmplaceBack(
-                INX_Render2D->currentShader,
-                INX_Render2D->currentFont,
-                0
-            );
-            break;
+    // Data left in the batch belongs to this frame segment
+    INX_Render2D_Flush();
+
+    INX_Batch2D& batch = INX_Render2D->batch;
+
+    batch.vbo.Advance();
+    batch.ebo.Advance();
+    batch.sbo.Advance();
+
+    // While recording, the room is that of the list and given back at the end
+    if (INX_Render2D->recording == nullptr) {
+        INX_Render2D_UpdateBatchRoom();
+    }
+}
+
+static void INX_Render2D_ReserveRecording(int vertices, int indices)
+{
+    INX_Batch2D& batch = INX_Render2D->batch;
+    NX_CommandList2D* list = INX_Render2D->recording;
+
+    // The list arrays are used as the batch memory, their size being the capacity
+    if (batch.vertexCount + vertices > batch.vertexCapacity) {
+        size_t capacity = std::max(2 * list->vertices.GetSize(), static_cast<size_t>(batch.vertexCount + vertices));
+        if (!list->vertices.Resize(std::max<size_t>(capacity, 256))) {
+            NX_LOG(E, "RENDER: Failed to grow the command list vertices (requested: %zu)", capacity);
+        }
+    }
+
+    if (batch.indexCount + indices > batch.indexCapacity) {
+        size_t capacity = std::max(2 * list->indices.GetSize(), static_cast<size_t>(batch.indexCount + indices));
+        if (!list->indices.Resize(std::max<size_t>(capacity, 384))) {
+            NX_LOG(E, "RENDER: Failed to grow the command list indices (requested: %zu)", capacity);
         }
+    }
+
+    batch.vertices = list->vertices.GetData();
+    batch.indices = list->indices.GetData();
+    batch.vertexCapacity = static_cast<int>(list->vertices.GetSize());
+    batch.indexCapacity = static_cast<int>(list->indices.GetSize());
+}
+
+static void INX_Render2D_ReserveBatch(int vertices, int indices, int sprites)
+{
+    INX_Batch2D& batch = INX_Render2D->batch;
+
+    // Lists only hold vertices, recorded sprites are written as quads
+    if (INX_Render2D->recording != nullptr) {
+        INX_Render2D_ReserveRecording(vertices, indices);
         return;
     }
 
-    INX_DrawCall2D& call = *INX_Render2D->drawCalls.GetBack();
+    const bool verticesFull = (batch.vertexCount + vertices > batch.vertexCapacity || batch.indexCount + indices > batch.indexCapacity);
+    const bool spritesFull = (batch.spriteCount + sprites > batch.spriteCapacity);
 
-    if (call.count == 0) {
-        call.shader = INX_Render2D->currentShader;
-        call.mode = mode;
-        switch (mode) {
-        case INX_DrawMode2D::SHAPE:
-            call.texture = INX_Render2D->currentTexture;
-            break;
-        case INX_DrawMode2D::TEXT:
-            call.font = INX_Render2D->currentFont;
-            break;
+    if (verticesFull || spritesFull)
+    {
+        INX_Render2D_Flush();
+
+        // Running out of space means the frame needs a larger segment, the
+        // capacity is doubled (or more for a single large primitive)
+
+        int vertexCapacity = static_cast<int>(batch.vbo.GetSegmentSize() / sizeof(NX_Vertex2D));
+        int spriteCapacity = static_cast<int>(batch.sbo.GetSegmentSize() / sizeof(INX_SpriteInstance2D));
+
+        if (verticesFull && vertexCapacity < INX_Render2D_GetMaxBatchVertices()) {
+            vertexCapacity = std::max(2 * vertexCapacity, std::max(vertices, (2 * indices + 2) / 3));
+        }
+
+        if (spritesFull && spriteCapacity < INX_Render2DState::MaxBatchSprites) {
+            spriteCapacity = std::max(2 * spriteCapacity, sprites);
+        }
+
+        const bool vertexGrowth = (vertexCapacity != static_cast<int>(batch.vbo.GetSegmentSize() / sizeof(NX_Vertex2D)));
+        const bool spriteGrowth = (spriteCapacity != static_cast<int>(batch.sbo.GetSegmentSize() / sizeof(INX_SpriteInstance2D)));
+
+        if (vertexGrowth || spriteGrowth) {
+            NX_LOG(D, "RENDER: Growing the 2D batch to %i vertices and %i sprites",
+                   std::min(vertexCapacity, INX_Render2D_GetMaxBatchVertices()),
+                   std::min(spriteCapacity, INX_Render2DState::MaxBatchSprites));
+            INX_Render2D_CreateBatch(vertexCapacity, spriteCapacity);
+        }
+
+        // At the largest capacity, the rest of the frame goes on in the next
+        // segment, which may wait for the GPU to be done reading it
+        const bool stillFull = (vertices > batch.vertexCapacity || indices > batch.indexCapacity || sprites > batch.spriteCapacity);
+
+        if (stillFull) {
+            batch.vbo.Advance();
+            batch.ebo.Advance();
+            batch.sbo.Advance();
+            INX_Render2D_UpdateBatchRoom();
         }
-        return;
     }
 
-    if (call.mode == mode && call.shader == INX_Render2D->currentShader) {
-        switch (call.mode) {
-        case INX_DrawMode2D::SHAPE:
-            if (call.texture == INX_Render2D->currentTexture) {
-                return;
-            }
-            break;
-        case INX_DrawMode2D::TEXT:
-            if (call.font == INX_Render2D->currentFont) {
-                return;
+    if (batch.vertices == nullptr) {
+        batch.vertices = static_cast<NX_Vertex2D*>(batch.vbo.Acquire());
+        batch.indices = batch.ebo.Acquire();
+        batch.sprites = static_cast<INX_SpriteInstance2D*>(batch.sbo.Acquire());
+    }
+}
+
+static void INX_Render2D_EnsureDrawCall(INX_DrawMode2D mode, int vertices, int indices, int sprites = 0)
+{
+    INX_Render2D_ReserveBatch(vertices, indices, sprites);
+
+    // Sprite draw calls address the sprite buffer, the others the index buffer
+    const size_t offset = (mode == INX_DrawMode2D::SPRITE)
+        ? INX_Render2D->batch.spriteCount
+        : INX_Render2D->batch.indexCount;
+
+    if (!INX_Render2D->drawCalls.IsEmpty())
+    {
+        INX_DrawCall2D& call = *INX_Render2D->drawCalls.GetBack();
+
+        if (call.count == 0) {
+            call.shader = INX_Render2D->currentShader;
+            call.offset = offset;
+            call.mode = mode;
+            switch (mode) {
+            case INX_DrawMode2D::SHAPE:
+            case INX_DrawMode2D::SPRITE:
+                call.texture = INX_Render2D->currentTexture;
+                break;
+            case INX_DrawMode2D::TEXT:
+                call.font = INX_Render2D->currentFont;
+                break;
             }
-            break;
+            return;
         }
-    }
 
-    if (INX_Render2D->drawCalls.GetSize() == INX_Render2DState::MaxDrawCalls) {
-        INX_Render2D_Flush();
+        if (call.mode == mode && call.shader == INX_Render2D->currentShader) {
+            switch (call.mode) {
+            case INX_DrawMode2D::SHAPE:
+            case INX_DrawMode2D::SPRITE:
+                if (call.texture == INX_Render2D->currentTexture) {
+                    return;
+                }
+                break;
+            case INX_DrawMode2D::TEXT:
+                if (call.font == INX_Render2D->currentFont) {
+                    return;
+                }
+                break;
+            }
+        }
     }
 
     switch (mode) {
     case INX_DrawMode2D::SHAPE:
+    case INX_DrawMode2D::SPRITE:
         INX_Render2D->drawCalls.EmplaceBack(
             INX_Render2D->currentShader,
             INX_Render2D->currentTexture,
-            INX_Render2D->indices.GetSize()
+            offset, mode
         );
         break;
     case INX_DrawMode2D::TEXT:
         INX_Render2D->drawCalls.EmplaceBack(
             INX_Render2D->currentShader,
             INX_Render2D->currentFont,
-            INX_Render2D->indices.GetSize()
+            offset
         );
         break;
     }
@@ -412,38 +657,172 @@ static void INX_Render2D_Blit()
 
     pipeline.SetBlendMode(gpu::BlendMode::Premultiplied);
     pipeline.Draw(GL_TRIANGLES, 3);
+
+    // Refreshes the material array layer of the target if it is sampled by materials
+    if (INX_Render2D->currentTarget != nullptr) {
+        INX_Render2D->currentTarget->color->gpu.BumpRevision();
+    }
 }
 
-static uint16_t INX_Render2D_NextVertexIndex()
+static uint32_t INX_Render2D_NextVertexIndex()
 {
-    return static_cast<uint16_t>(INX_Render2D->vertices.GetSize());
+    return static_cast<uint32_t>(INX_Render2D->batch.vertexCount);
 }
 
 static void INX_Render2D_AddVertex(float x, float y, float u, float v)
 {
-    SDL_assert(INX_Render2D->vertices.GetSize() < INX_Render2DState::MaxVertices);
-    INX_Render2D->vertices.EmplaceBack(
+    INX_Batch2D& batch = INX_Render2D->batch;
+    SDL_assert(batch.vertexCount < batch.vertexCapacity);
+
+    batch.vertices[batch.vertexCount++] = NX_Vertex2D {
         NX_VEC2(x, y) * (*INX_Render2D->matrixStack.GetBack()),
         NX_VEC2(u, v), INX_Render2D->currentColor
-    );
+    };
 }
 
 static void INX_Render2D_AddVertex(const NX_Vertex2D& vertex)
 {
-    SDL_assert(INX_Render2D->vertices.GetSize() < INX_Render2DState::MaxVertices);
-    INX_Render2D->vertices.EmplaceBack(
+    INX_Batch2D& batch = INX_Render2D->batch;
+    SDL_assert(batch.vertexCount < batch.vertexCapacity);
+
+    batch.vertices[batch.vertexCount++] = NX_Vertex2D {
         vertex.position * (*INX_Render2D->matrixStack.GetBack()),
         vertex.texcoord, vertex.color
-    );
+    };
 }
 
-static void INX_Render2D_AddIndex(uint16_t index)
+static void INX_Render2D_AddIndex(uint32_t index)
 {
-    SDL_assert(INX_Render2D->indices.GetSize() < INX_Render2DState::MaxIndices);
-    INX_Render2D->indices.EmplaceBack(index);
+    INX_Batch2D& batch = INX_Render2D->batch;
+    SDL_assert(batch.indexCount < batch.indexCapacity);
+
+    if (batch.indexType == GL_UNSIGNED_INT) {
+        static_cast<uint32_t*>(batch.indices)[batch.indexCount++] = index;
+    }
+    else {
+        static_cast<uint16_t*>(batch.indices)[batch.indexCount++] = static_cast<uint16_t>(index);
+    }
+
     INX_Render2D->drawCalls.GetBack()->count++;
 }
 
+template <typename T>
+static void INX_Render2D_WriteQuadIndices(T* indices, uint32_t firstVertex, int quadCount)
+{
+    for (int i = 0; i < quadCount; i++, indices += 6) {
+        T base = static_cast<T>(firstVertex + 4 * i);
+        indices[0] = base + 0;
+        indices[1] = base + 1;
+        indices[2] = base + 2;
+        indices[3] = base + 0;
+        indices[4] = base + 2;
+        indices[5] = base + 3;
+    }
+}
+
+static void INX_Render2D_AddQuadIndices(uint32_t firstVertex, int quadCount)
+{
+    INX_Batch2D& batch = INX_Render2D->batch;
+    SDL_assert(batch.indexCount + 6 * quadCount <= batch.indexCapacity);
+
+    if (batch.indexType == GL_UNSIGNED_INT) {
+        INX_Render2D_WriteQuadIndices(static_cast<uint32_t*>(batch.indices) + batch.indexCount, firstVertex, quadCount);
+    }
+    else {
+        INX_Render2D_WriteQuadIndices(static_cast<uint16_t*>(batch.indices) + batch.indexCount, firstVertex, quadCount);
+    }
+
+    batch.indexCount += 6 * quadCount;
+    INX_Render2D->drawCalls.GetBack()->count += 6 * quadCount;
+}
+
+static void INX_Render2D_RecordGlyph(const NX_Font* font, uint32_t firstVertex, int codepoint)
+{
+    NX_CommandList2D* list = INX_Render2D->recording;
+    if (list == nullptr) {
+        return;
+    }
+
+    if (!list->glyphs.PushBack(INX_RecordedGlyph2D{font, firstVertex, codepoint, font->glyphs.GetAtlasGeneration()})) {
+        NX_LOG(E, "RENDER: Failed to record a command list glyph; Its texture coordinates will not follow the atlas");
+    }
+}
+
+static bool INX_Render2D_ResolveListGlyphs(NX_CommandList2D* list)
+{
+    // The glyphs of a list are already rasterized, resolving them again does not grow
+    // the atlas in practice, but the loop still covers an atlas moving them meanwhile
+
+    bool changed = false;
+
+    for (bool stale = true; stale;)
+    {
+        stale = false;
+
+        for (size_t i = 0; i < list->glyphs.GetSize(); i++)
+        {
+            INX_RecordedGlyph2D& record = list->glyphs[i];
+
+            const INX_GlyphCache& glyphs = record.font->glyphs;
+            if (record.atlasGeneration == glyphs.GetAtlasGeneration()) {
+                continue;
+            }
+
+            const INX_Glyph& glyph = INX_GetFontGlyph(record.font, record.codepoint);
+
+            float iwAtlas = 1.0f / glyphs.GetAtlas().w;
+            float ihAtlas = 1.0f / glyphs.GetAtlas().h;
+
+            float u0 = glyph.xAtlas * iwAtlas;
+            float v0 = glyph.yAtlas * ihAtlas;
+            float u1 = u0 + glyph.wGlyph * iwAtlas;
+            float v1 = v0 + glyph.hGlyph * ihAtlas;
+
+            // Same vertex order as 'NX_DrawCodepoint2D' and 'NX_DrawTextLayout2D'
+            NX_Vertex2D* vertices = &list->vertices[record.vertex];
+            vertices[0].texcoord = NX_VEC2(u0, v0);
+            vertices[1].texcoord = NX_VEC2(u0, v1);
+            vertices[2].texcoord = NX_VEC2(u1, v1);
+            vertices[3].texcoord = NX_VEC2(u1, v0);
+
+            record.atlasGeneration = glyphs.GetAtlasGeneration();
+            changed = stale = true;
+        }
+    }
+
+    /* --- Text draw calls now refer to the current atlas layouts --- */
+
+    for (size_t i = 0; i < list->commands.GetSize(); i++) {
+        INX_Command2D& command = list->commands[i];
+        if (command.text) {
+            command.atlasGeneration = INX_Assets.Select(command.font, INX_FontAsset::DEFAULT)->glyphs.GetAtlasGeneration();
+        }
+    }
+
+    return changed;
+}
+
+static void INX_Render2D_RefreshCommandList(const NX_CommandList2D* list)
+{
+    bool stale = false;
+
+    for (size_t i = 0; i < list->commands.GetSize() && !stale; i++) {
+        const INX_Command2D& command = list->commands[i];
+        stale = command.text && INX_Assets.Select(command.font, INX_FontAsset::DEFAULT)->glyphs.GetAtlasGeneration() != command.atlasGeneration;
+    }
+
+    if (!stale) {
+        return;
+    }
+
+    // Drawing only holds const lists, updating their glyphs is their only change to them
+    NX_CommandList2D* mutableList = const_cast<NX_CommandList2D*>(list);
+
+    if (INX_Render2D_ResolveListGlyphs(mutableList) && mutableList->vbo.IsValid()) {
+        mutableList->vbo.Upload(0, mutableList->vertices.GetSize() * sizeof(NX_Vertex2D), mutableList->vertices.GetData());
+    }
+}
+
 static float INX_Render2D_ToPixelSize(float unit)
 {
     if (!NX_IsMat3Identity(INX_Render2D->matrixStack.GetBack())) {
@@ -488,6 +867,11 @@ void NX_End2D()
     });
 }
 
+NX_Render2DStats NX_GetRender2DStats()
+{
+    return INX_Frame.lastRender2D;
+}
+
 void NX_SetColor2D(NX_Color color)
 {
     INX_Render2D->currentColor = color;
@@ -737,7 +1121,7 @@ void NX_DrawLineEx2D(const NX_Vertex2D* v0, const NX_Vertex2D* v1, float thickne
     float nx = -d.y * thickness * 0.5f;
     float ny = +d.x * thickness * 0.5f;
 
-    uint16_t baseIndex = INX_Render2D_NextVertexIndex();
+    uint32_t baseIndex = INX_Render2D_NextVertexIndex();
 
     /* --- Adding vertices and indices --- */
 
@@ -791,7 +1175,7 @@ void NX_DrawTriangleEx2D(const NX_Vertex2D* v0, const NX_Vertex2D* v1, const NX_
 {
     INX_Render2D_EnsureDrawCall(INX_DrawMode2D::SHAPE, 3, 3);
 
-    uint16_t baseIndex = INX_Render2D_NextVertexIndex();
+    uint32_t baseIndex = INX_Render2D_NextVertexIndex();
 
     INX_Render2D_AddVertex(*v0);
     INX_Render2D_AddVertex(*v1);
@@ -818,7 +1202,7 @@ void NX_DrawQuadEx2D(const NX_Vertex2D* v0, const NX_Vertex2D* v1, const NX_Vert
 {
     INX_Render2D_EnsureDrawCall(INX_DrawMode2D::SHAPE, 4, 6);
 
-    uint16_t baseIndex = INX_Render2D_NextVertexIndex();
+    uint32_t baseIndex = INX_Render2D_NextVertexIndex();
 
     INX_Render2D_AddVertex(*v0);
     INX_Render2D_AddVertex(*v1);
@@ -838,7 +1222,7 @@ void NX_DrawRect2D(float x, float y, float w, float h)
 {
     INX_Render2D_EnsureDrawCall(INX_DrawMode2D::SHAPE, 4, 6);
 
-    uint16_t baseIndex = INX_Render2D_NextVertexIndex();
+    uint32_t baseIndex = INX_Render2D_NextVertexIndex();
 
     INX_Render2D_AddVertex(x, y, 0.0f, 0.0f);
     INX_Render2D_AddVertex(x + w, y, 1.0f, 0.0f);
@@ -891,8 +1275,8 @@ void NX_DrawRectRounded2D(float x, float y, float w, float h, float radius, int
 
     INX_Render2D_EnsureDrawCall(INX_DrawMode2D::SHAPE, totalVertices, totalIndices);
 
-    uint16_t baseIndex = INX_Render2D_NextVertexIndex();
-    uint16_t currentIndex = 0;
+    uint32_t baseIndex = INX_Render2D_NextVertexIndex();
+    uint32_t currentIndex = 0;
 
     /* --- Corner centers and angle data --- */
 
@@ -911,7 +1295,7 @@ void NX_DrawRectRounded2D(float x, float y, float w, float h, float radius, int
         float startAngle = cornerData[corner][2];
         float angleRange = cornerData[corner][3] - startAngle;
         float angleStep = angleRange / segments;
-        uint16_t centerIdx = currentIndex++;
+        uint32_t centerIdx = currentIndex++;
         INX_Render2D_AddVertex(cx, cy, 0.5f, 0.5f);
         for (int i = 0; i <= segments; i++) {
             float angle = startAngle + i * angleStep;
@@ -941,7 +1325,7 @@ void NX_DrawRectRounded2D(float x, float y, float w, float h, float radius, int
     };
 
     for (int rect = 0; rect < 3; rect++) {
-        uint16_t rectStart = currentIndex;
+        uint32_t rectStart = currentIndex;
         float uvs[4][2] = {
             {0.0f, 0.0f},
             {1.0f, 0.0f},
@@ -955,7 +1339,7 @@ void NX_DrawRectRounded2D(float x, float y, float w, float h, float radius, int
                 uvs[i][0], uvs[i][1]
             );
         }
-        uint16_t indices[6] = {0, 1, 2, 0, 2, 3};
+        uint32_t indices[6] = {0, 1, 2, 0, 2, 3};
         for (int i = 0; i < 6; i++) {
             INX_Render2D_AddIndex(baseIndex + rectStart + indices[i]);
         }
@@ -995,8 +1379,8 @@ void NX_DrawRectRoundedBorder2D(float x, float y, float w, float h, float radius
 
     INX_Render2D_EnsureDrawCall(INX_DrawMode2D::SHAPE, totalVertices, totalIndices);
 
-    uint16_t baseIndex = INX_Render2D_NextVertexIndex();
-    uint16_t currentIndex = 0;
+    uint32_t baseIndex = INX_Render2D_NextVertexIndex();
+    uint32_t currentIndex = 0;
 
     /* --- Corner data --- */
 
@@ -1016,7 +1400,7 @@ void NX_DrawRectRoundedBorder2D(float x, float y, float w, float h, float radius
         float angleRange = cornerData[corner][3] - startAngle;
         float angleStep = angleRange / segments;
 
-        uint16_t cornerStart = currentIndex;
+        uint32_t cornerStart = currentIndex;
 
         // Generation of pairs of vertices and quads
         for (int i = 0; i <= segments; i++) {
@@ -1029,7 +1413,7 @@ void NX_DrawRectRoundedBorder2D(float x, float y, float w, float h, float radius
             INX_Render2D_AddVertex(cx + cosA * outerRadius, cy + sinA * outerRadius, 0.5f, 0.5f);
 
             if (i > 0) {
-                uint16_t base = baseIndex + cornerStart + (i - 1) * 2;
+                uint32_t base = baseIndex + cornerStart + (i - 1) * 2;
                 // Quad with 2 triangles
                 INX_Render2D_AddIndex(base);
                 INX_Render2D_AddIndex(base + 1);
@@ -1062,7 +1446,7 @@ void NX_DrawRectRoundedBorder2D(float x, float y, float w, float h, float radius
     /* --- Generation of straight segments --- */
 
     for (int seg = 0; seg < 4; seg++) {
-        uint16_t segStart = currentIndex;
+        uint32_t segStart = currentIndex;
         float uvs[4][2] = {
             {0.0f, 0.0f},
             {1.0f, 0.0f},
@@ -1076,7 +1460,7 @@ void NX_DrawRectRoundedBorder2D(float x, float y, float w, float h, float radius
                 uvs[i][0], uvs[i][1]
             );
         }
-        uint16_t indices[6] = {0, 1, 2, 0, 2, 3};
+        uint32_t indices[6] = {0, 1, 2, 0, 2, 3};
         for (int i = 0; i < 6; i++) {
             INX_Render2D_AddIndex(baseIndex + segStart + indices[i]);
         }
@@ -1090,7 +1474,7 @@ void NX_DrawCircle2D(NX_Vec2 center, float radius, int segments)
 
     INX_Render2D_EnsureDrawCall(INX_DrawMode2D::SHAPE, segments + 1, segments * 3);
 
-    uint16_t baseIndex = INX_Render2D_NextVertexIndex();
+    uint32_t baseIndex = INX_Render2D_NextVertexIndex();
 
     INX_Render2D_AddVertex(center.x, center.y, 0.5f, 0.5f);
 
@@ -1164,7 +1548,7 @@ void NX_DrawEllipse2D(NX_Vec2 center, NX_Vec2 radius, int segments)
 
     INX_Render2D_EnsureDrawCall(INX_DrawMode2D::SHAPE, segments + 1, segments * 3);
 
-    uint16_t baseIndex = INX_Render2D_NextVertexIndex();
+    uint32_t baseIndex = INX_Render2D_NextVertexIndex();
 
     INX_Render2D_AddVertex(center.x, center.y, 0.5f, 0.5f);
 
@@ -1250,7 +1634,7 @@ void NX_DrawPieSlice2D(NX_Vec2 center, float radius, float startAngle, float end
 
     INX_Render2D_EnsureDrawCall(INX_DrawMode2D::SHAPE, segments + 2, segments * 3);
 
-    uint16_t baseIndex = INX_Render2D_NextVertexIndex();
+    uint32_t baseIndex = INX_Render2D_NextVertexIndex();
 
     INX_Render2D_AddVertex(center.x, center.y, 0.5f, 0.5f);
 
@@ -1321,7 +1705,7 @@ void NX_DrawRing2D(NX_Vec2 center, float innerRadius, float outerRadius, int seg
 
     INX_Render2D_EnsureDrawCall(INX_DrawMode2D::SHAPE, segments * 2, segments * 6);
 
-    uint16_t baseIndex = INX_Render2D_NextVertexIndex();
+    uint32_t baseIndex = INX_Render2D_NextVertexIndex();
 
     float deltaAngle = NX_TAU / segments;
     float cosDelta = std::cos(deltaAngle);
@@ -1423,7 +1807,7 @@ void NX_DrawRingArc2D(NX_Vec2 center, float innerRadius, float outerRadius,
 
     INX_Render2D_EnsureDrawCall(INX_DrawMode2D::SHAPE, (segments + 1) * 2, segments * 6);
 
-    uint16_t baseIndex = INX_Render2D_NextVertexIndex();
+    uint32_t baseIndex = INX_Render2D_NextVertexIndex();
 
     for (int i = 0; i <= segments; i++) {
         float outerX = center.x + outerRadius * cosA;
@@ -1691,6 +2075,14 @@ void NX_DrawCodepoint2D(int codepoint, NX_Vec2 position, float fontSize)
     const NX_Font* font = INX_Assets.Select(INX_Render2D->currentFont, INX_FontAsset::DEFAULT);
     const INX_Glyph& glyph = INX_GetFontGlyph(font, codepoint);
 
+    /* --- Upload glyphs rasterized on demand before using the atlas --- */
+
+    if (INX_IsFontTextureStale(font)) {
+        INX_Render2D_Flush(); // Batched glyphs refer to the previous atlas layout
+    }
+
+    INX_UpdateFontTexture(font);
+
     /* --- Calculate the scale factor based on font size --- */
 
     float scale = fontSize / font->baseSize;
@@ -1717,7 +2109,7 @@ void NX_DrawCodepoint2D(int codepoint, NX_Vec2 position, float fontSize)
 
     INX_Render2D_EnsureDrawCall(INX_DrawMode2D::TEXT, 4, 6);
 
-    uint16_t baseIndex = INX_Render2D_NextVertexIndex();
+    uint32_t baseIndex = INX_Render2D_NextVertexIndex();
 
     INX_Render2D_AddVertex(xDst, yDst, u0, v0);
     INX_Render2D_AddVertex(xDst, yDst + hDst, u0, v1);
@@ -1731,6 +2123,8 @@ void NX_DrawCodepoint2D(int codepoint, NX_Vec2 position, float fontSize)
     INX_Render2D_AddIndex(baseIndex + 0);
     INX_Render2D_AddIndex(baseIndex + 2);
     INX_Render2D_AddIndex(baseIndex + 3);
+
+    INX_Render2D_RecordGlyph(font, baseIndex, codepoint);
 }
 
 void NX_DrawCodepoints2D(const int* codepoints, int length, NX_Vec2 position, float fontSize, NX_Vec2 spacing)
@@ -1796,3 +2190,381 @@ void NX_DrawText2D(const char* text, NX_Vec2 position, float fontSize, NX_Vec2 s
         i += codepointByteCount;
     }
 }
+
+void NX_DrawTextLayout2D(const NX_TextLayout* layout, NX_Vec2 position)
+{
+    /* --- Compute the layout again only if it was invalidated --- */
+
+    const NX_Font* font = INX_UpdateTextLayout(layout);
+
+    if (INX_IsFontTextureStale(font)) {
+        INX_Render2D_Flush(); // Batched glyphs refer to the previous atlas layout
+    }
+
+    INX_UpdateFontTexture(font);
+
+    /* --- Fold the position into the current transform once --- */
+
+    const NX_Mat3& mat = *INX_Render2D->matrixStack.GetBack();
+    const NX_Vec2 origin = position * mat;
+    const NX_Vec2 xAxis = NX_VEC2(mat.m00, mat.m01);
+    const NX_Vec2 yAxis = NX_VEC2(mat.m10, mat.m11);
+    const NX_Color color = INX_Render2D->currentColor;
+
+    /* --- Push the quads by batches fitting in the buffers --- */
+
+    const NX_Font* currentFont = INX_Render2D->currentFont;
+    INX_Render2D->currentFont = layout->font;
+
+    INX_Batch2D& batch = INX_Render2D->batch;
+
+    const INX_TextQuad* quads = layout->quads.GetData();
+    int remaining = static_cast<int>(layout->quads.GetSize());
+
+    while (remaining > 0)
+    {
+        // Asks room for as many quads as possible, the batch being flushed
+        // and grown when needed, then takes whatever it can hold
+        int count = std::min(remaining, INX_Render2D_GetMaxBatchVertices() / 4);
+        INX_Render2D_EnsureDrawCall(INX_DrawMode2D::TEXT, 4 * count, 6 * count);
+
+        count = std::min(count, std::min(
+            (batch.vertexCapacity - batch.vertexCount) / 4,
+            (batch.indexCapacity - batch.indexCount) / 6
+        ));
+
+        NX_Vertex2D* vertices = batch.vertices + batch.vertexCount;
+
+        for (int i = 0; i < count; i++, vertices += 4)
+        {
+            const INX_TextQuad& quad = quads[i];
+
+            NX_Vec2 p0 = origin + xAxis * quad.x0 + yAxis * quad.y0;
+            NX_Vec2 dx = xAxis * (quad.x1 - quad.x0);
+            NX_Vec2 dy = yAxis * (quad.y1 - quad.y0);
+
+            vertices[0] = NX_Vertex2D { p0, NX_VEC2(quad.u0, quad.v0), color };
+            vertices[1] = NX_Vertex2D { p0 + dy, NX_VEC2(quad.u0, quad.v1), color };
+            vertices[2] = NX_Vertex2D { p0 + dx + dy, NX_VEC2(quad.u1, quad.v1), color };
+            vertices[3] = NX_Vertex2D { p0 + dx, NX_VEC2(quad.u1, quad.v0), color };
+
+            INX_Render2D_RecordGlyph(font, batch.vertexCount + 4 * i, quad.codepoint);
+        }
+
+        INX_Render2D_AddQuadIndices(batch.vertexCount, count);
+        batch.vertexCount += 4 * count;
+
+        quads += count;
+        remaining -= count;
+    }
+
+    INX_Render2D->currentFont = currentFont;
+}
+
+void NX_DrawSprite2D(NX_Vec2 position, NX_Vec2 size, float rotation)
+{
+    const NX_Sprite2D sprite {
+        .position = position,
+        .size = size,
+        .rotation = rotation,
+        .uvRect = NX_Vec4 {},
+        .color = INX_Render2D->currentColor
+    };
+
+    NX_DrawSprites2D(&sprite, 1);
+}
+
+void NX_DrawSprites2D(const NX_Sprite2D* sprites, int count)
+{
+    /* --- Decompose the current transform once for all sprites --- */
+
+    const INX_SpriteTransform2D transform = INX_MakeSpriteTransform2D(*INX_Render2D->matrixStack.GetBack());
+    const bool recording = (INX_Render2D->recording != nullptr);
+
+    INX_Batch2D& batch = INX_Render2D->batch;
+
+    /* --- Push the sprites by runs fitting in the sprite buffer --- */
+
+    int i = 0;
+
+    while (i < count)
+    {
+        // Sprites the transform would shear, or whose UVs leave the texture, are drawn
+        // as quads, rare enough to simply be handled one by one, like all sprites
+        // recorded in a list
+        if (recording || !INX_CanPackSprite2D(transform, sprites[i]))
+        {
+            const NX_Sprite2D& sprite = sprites[i++];
+
+            const bool wholeTexture = (sprite.uvRect.z == 0.0f && sprite.uvRect.w == 0.0f);
+            const NX_Vec4 uv = wholeTexture ? NX_Vec4 {0.0f, 0.0f, 1.0f, 1.0f} : sprite.uvRect;
+
+            const float c = std::cos(sprite.rotation);
+            const float s = std::sin(sprite.rotation);
+            const NX_Vec2 dx = NX_VEC2(c, s) * (0.5f * sprite.size.x);
+            const NX_Vec2 dy = NX_VEC2(-s, c) * (0.5f * sprite.size.y);
+
+            INX_Render2D_EnsureDrawCall(INX_DrawMode2D::SHAPE, 4, 6);
+
+            uint32_t baseIndex = INX_Render2D_NextVertexIndex();
+
+            INX_Render2D_AddVertex(NX_Vertex2D { sprite.position - dx - dy, NX_VEC2(uv.x, uv.y), sprite.color });
+            INX_Render2D_AddVertex(NX_Vertex2D { sprite.position + dx - dy, NX_VEC2(uv.x + uv.z, uv.y), sprite.color });
+            INX_Render2D_AddVertex(NX_Vertex2D { sprite.position + dx + dy, NX_VEC2(uv.x + uv.z, uv.y + uv.w), sprite.color });
+            INX_Render2D_AddVertex(NX_Vertex2D { sprite.position - dx + dy, NX_VEC2(uv.x, uv.y + uv.w), sprite.color });
+
+            INX_Render2D_AddIndex(baseIndex + 0);
+            INX_Render2D_AddIndex(baseIndex + 1);
+            INX_Render2D_AddIndex(baseIndex + 2);
+
+            INX_Render2D_AddIndex(baseIndex + 0);
+            INX_Render2D_AddIndex(baseIndex + 2);
+            INX_Render2D_AddIndex(baseIndex + 3);
+            continue;
+        }
+
+        // Asks room for the remaining sprites, the batch being flushed
+        // and grown when needed, then takes whatever it can hold
+        int run = std::min(count - i, INX_Render2DState::MaxBatchSprites);
+        INX_Render2D_EnsureDrawCall(INX_DrawMode2D::SPRITE, 0, 0, run);
+        run = std::min(run, batch.spriteCapacity - batch.spriteCount);
+
+        INX_SpriteInstance2D* instances = batch.sprites + batch.spriteCount;
+        int packed = 0;
+
+        while (packed < run && INX_CanPackSprite2D(transform, sprites[i])) {
+            INX_PackSprite2D(&instances[packed++], sprites[i++], transform);
+        }
+
+        batch.spriteCount += packed;
+        INX_Render2D->drawCalls.GetBack()->count += packed;
+    }
+}
+
+void NX_BeginCommandList2D(NX_CommandList2D* list)
+{
+    if (INX_Render2D->recording != nullptr) {
+        NX_LOG(E, "RENDER: A command list is already being recorded");
+        return;
+    }
+
+    // Everything drawn so far goes out before the batch is repurposed
+    INX_Render2D_Flush();
+    INX_Render2D->drawCalls.Clear();
+
+    /* --- Record in the list space --- */
+
+    if (!INX_Render2D->matrixStack.PushBack(NX_MAT3_IDENTITY)) {
+        NX_LOG(E, "RENDER: Transformation stack overflow");
+        return;
+    }
+
+    /* --- Redirect the batch to the list memory --- */
+
+    INX_Batch2D& batch = INX_Render2D->batch;
+
+    INX_Render2D->savedBatch = {
+        batch.indexType
+    };
+
+    list->vertices.Clear();
+    list->indices.Clear();
+    list->commands.Clear();
+    list->glyphs.Clear();
+
+    batch.vertices = nullptr;
+    batch.indices = nullptr;
+    batch.vertexCapacity = 0;
+    batch.indexCapacity = 0;
+    batch.spriteCapacity = 0;
+    batch.indexType = GL_UNSIGNED_INT;
+
+    INX_Render2D->recording = list;
+}
+
+void NX_EndCommandList2D()
+{
+    NX_CommandList2D* list = INX_Render2D->recording;
+    if (list == nullptr) {
+        NX_LOG(E, "RENDER: No command list is being recorded");
+        return;
+    }
+
+    INX_Batch2D& batch = INX_Render2D->batch;
+
+    /* --- Keep the recorded draw calls --- */
+
+    if (!list->commands.Reserve(INX_Render2D->drawCalls.GetSize())) {
+        NX_LOG(E, "RENDER: Failed to allocate the command list draw calls");
+    }
+
+    for (size_t i = 0; i < INX_Render2D->drawCalls.GetSize(); i++)
+    {
+        const INX_DrawCall2D& call = INX_Render2D->drawCalls[i];
+        if (call.count == 0) {
+            continue;
+        }
+
+        const bool text = (call.mode == INX_DrawMode2D::TEXT);
+        const NX_Font* font = text ? INX_Assets.Select(call.font, INX_FontAsset::DEFAULT) : nullptr;
+
+        list->commands.PushBack(INX_Command2D {
+            .shader = call.shader,
+            .texture = text ? nullptr : call.texture,
+            .font = text ? call.font : nullptr,
+            .atlasGeneration = text ? font->glyphs.GetAtlasGeneration() : 0,
+            .offset = static_cast<uint32_t>(call.offset),
+            .count = static_cast<uint32_t>(call.count),
+            .text = text
+        });
+    }
+
+    /* --- Trim the arrays to the recorded data and upload it --- */
+
+    (void)list->vertices.Resize(batch.vertexCount);
+    (void)list->indices.Resize(batch.indexCount);
+
+    // Glyphs recorded before the atlas of their font grew during the recording
+    INX_Render2D_ResolveListGlyphs(list);
+
+    const GLsizeiptr vboSize = list->vertices.GetSize() * sizeof(NX_Vertex2D);
+    const GLsizeiptr eboSize = list->indices.GetSize() * sizeof(uint32_t);
+
+    if (vboSize > 0)
+    {
+        // Buffers are only recreated when the list grows, along with the vertex array
+        if (!list->vbo.IsValid() || list->vbo.GetSize() < vboSize || list->ebo.GetSize() < eboSize) {
+            list->vbo = gpu::Buffer(GL_ARRAY_BUFFER, vboSize, list->vertices.GetData(), GL_STATIC_DRAW);
+            list->ebo = gpu::Buffer(GL_ELEMENT_ARRAY_BUFFER, eboSize, list->indices.GetData(), GL_STATIC_DRAW);
+            list->vao = INX_Render2D_CreateVertexArray(&list->vbo, &list->ebo);
+        }
+        else {
+            list->vbo.Upload(0, vboSize, list->vertices.GetData());
+            list->ebo.Upload(0, eboSize, list->indices.GetData());
+        }
+    }
+
+    /* --- Give the batch back --- */
+
+    INX_Render2D->drawCalls.Clear();
+    INX_Render2D->matrixStack.PopBack();
+    INX_Render2D->recording = nullptr;
+
+    batch.vertices = nullptr;
+    batch.indices = nullptr;
+    batch.vertexCount = 0;
+    batch.indexCount = 0;
+    batch.indexType = INX_Render2D->savedBatch.indexType;
+
+    INX_Render2D_UpdateBatchRoom();
+}
+
+void NX_DrawCommandList2D(const NX_CommandList2D* list, NX_Vec2 position)
+{
+    if (list == INX_Render2D->recording) {
+        NX_LOG(W, "RENDER: A command list cannot be drawn into itself");
+        return;
+    }
+
+    if (list->commands.IsEmpty()) {
+        return;
+    }
+
+    /* --- Glyphs recorded before the atlas of their font grew are resolved again --- */
+
+    INX_Render2D_RefreshCommandList(list);
+
+    const NX_Mat3 transform = NX_Mat3Translate2D(position) * (*INX_Render2D->matrixStack.GetBack());
+    const NX_Color tint = INX_Render2D->currentColor;
+
+    /* --- Inside another recording, the list is copied into it --- */
+
+    if (INX_Render2D->recording != nullptr)
+    {
+        INX_Batch2D& batch = INX_Render2D->batch;
+
+        const int vertexCount = static_cast<int>(list->vertices.GetSize());
+        INX_Render2D_ReserveBatch(vertexCount, 0, 0);
+
+        const uint32_t baseVertex = INX_Render2D_NextVertexIndex();
+
+        for (int i = 0; i < vertexCount; i++) {
+            const NX_Vertex2D& vertex = list->vertices[i];
+            batch.vertices[batch.vertexCount++] = NX_Vertex2D {
+                vertex.position * transform,
+                vertex.texcoord, vertex.color * tint
+            };
+        }
+
+        NX_Shader2D* currentShader = INX_Render2D->currentShader;
+        const NX_Texture* currentTexture = INX_Render2D->currentTexture;
+        const NX_Font* currentFont = INX_Render2D->currentFont;
+
+        for (size_t i = 0; i < list->commands.GetSize(); i++)
+        {
+            const INX_Command2D& command = list->commands[i];
+
+            INX_Render2D->currentShader = command.shader;
+            INX_Render2D->currentTexture = command.texture;
+            INX_Render2D->currentFont = command.font;
+
+            INX_Render2D_EnsureDrawCall(command.text ? INX_DrawMode2D::TEXT : INX_DrawMode2D::SHAPE, 0, command.count);
+
+            for (uint32_t j = 0; j < command.count; j++) {
+                INX_Render2D_AddIndex(baseVertex + list->indices[command.offset + j]);
+            }
+        }
+
+        INX_Render2D->currentShader = currentShader;
+        INX_Render2D->currentTexture = currentTexture;
+        INX_Render2D->currentFont = currentFont;
+
+        // The copied glyphs follow the atlas of their font in the other list as well
+        for (size_t i = 0; i < list->glyphs.GetSize(); i++) {
+            const INX_RecordedGlyph2D& record = list->glyphs[i];
+            INX_Render2D_RecordGlyph(record.font, baseVertex + record.vertex, record.codepoint);
+        }
+
+        return;
+    }
+
+    /* --- Otherwise its draw calls are issued as they are --- */
+
+    INX_Render2D_Flush();
+
+    gpu::Pipeline pipeline;
+
+    pipeline.SetBlendMode(gpu::BlendMode::Premultiplied);
+    pipeline.BindUniform(0, INX_Render2D->uniformBuffer);
+    pipeline.BindFramebuffer(INX_Render2D->framebuffer);
+    pipeline.SetViewport(INX_Render2D->framebuffer);
+    pipeline.BindVertexArray(list->vao);
+
+    for (size_t i = 0; i < list->commands.GetSize(); i++)
+    {
+        const INX_Command2D& command = list->commands[i];
+
+        if (command.text) {
+            INX_UpdateFontTexture(INX_Assets.Select(command.font, INX_FontAsset::DEFAULT));
+        }
+
+        // Shader data is the current one, as for any other draw
+        const NX_Shader2D* shader = INX_Assets.Select(command.shader, INX_Shader2DAsset::DEFAULT);
+
+        shader->BindUniforms(pipeline, shader->GetDynamicRangeIndex());
+        shader->BindTextures(pipeline, shader->GetTextures());
+
+        INX_Render2D_UseProgram(
+            pipeline, shader,
+            command.text ? INX_DrawMode2D::TEXT : INX_DrawMode2D::SHAPE,
+            command.texture, command.font
+        );
+
+        pipeline.SetUniformFloat4(1, tint);
+        pipeline.SetUniformMat3(2, transform);
+
+        pipeline.DrawElements(GL_TRIANGLES, GL_UNSIGNED_INT, command.offset, command.count);
+    }
+
+    INX_Frame.render2D.drawCalls += static_cast<int>(list->commands.GetSize());
+}
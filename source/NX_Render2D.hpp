@@ -21,4 +21,7 @@ bool INX_Render2DState_Init(NX_AppDesc* desc);
 /** Should be call in NX_Quit() */
 void INX_Render2DState_Quit();
 
+/** Should be called once per frame, before the buffer swap */
+void INX_Render2DState_EndFrame();
+
 #endif // NX_RENDER_2D_HPP
@@ -21,6 +21,7 @@
 #include <NX/NX_Log.h>
 
 #include "./NX_InstanceBuffer.hpp"
+#include "./NX_SceneObject.hpp"
 #include "./NX_RenderTexture.hpp"
 #include "./NX_Shader3D.hpp"
 #include "./NX_Texture.hpp"
@@ -41,13 +42,19 @@
 
 #include "./INX_GPUProgramCache.hpp"
 #include "./INX_GlobalAssets.hpp"
+#include "./INX_DrawPacking.hpp"
+#include "./INX_JobSystem.hpp"
 #include "./INX_VariantMesh.hpp"
 #include "./INX_RenderUtils.hpp"
 #include "./INX_GlobalPool.hpp"
+#include "./INX_InstanceCulling.hpp"
+#include "./INX_MultiDraw.hpp"
+#include "./INX_TextureResidency.hpp"
 #include "./INX_GPUBridge.hpp"
 #include "./INX_Frustum.hpp"
 #include "NX/NX_Material.h"
 
+#include <algorithm>
 #include <numeric>
 
 // ============================================================================
@@ -100,6 +107,7 @@ struct INX_DrawShared {
     /** Instances data */
     const NX_InstanceBuffer* instances;
     int instanceCount;
+    int culledInstances;                    //< Slot in the instance culling, if less than zero the instances are drawn as is
     /** Animations */
     int boneMatrixOffset;                   //< If less than zero, no animation assigned
     /** Unique data */
@@ -114,14 +122,24 @@ struct INX_DrawUnique {
     NX_Material material;
     /** Additionnal data */
     NX_Shader3D::TextureArray textures;     //< Array containing the textures linked to the material shader at the time of draw (if any)
+    INX_MaterialHandles textureHandles;     //< Bindless handles or array layers of the material textures, resolved at upload
     int dynamicRangeIndex;                  //< Index of the material shader's dynamic uniform buffer range (if any)
     /** Shared/Unique data */
     int sharedDataIndex;                    //< Index to the shared data that this unique draw call data depends on
     int uniqueDataIndex;                    //< Is actually the index of INX_DrawUnique itself, useful when iterating through sorted categories
+    int retainedSlot;                       //< Slot of the scene object this draw call comes from, -1 for immediate draw calls (no shared data)
     /** Object type */
     INX_DrawType type;
 };
 
+/** Pipeline state of a draw call, opaque lit draw calls with equal keys can be grouped */
+using INX_DrawStateKey = std::array<uintptr_t, 15>;
+
+struct INX_MultiDrawEntry {
+    INX_DrawStateKey key;
+    int position;                           //< Position of the draw call in its sorted category
+};
+
 /** Data for active lights */
 struct INX_ActiveLight {
     NX_Light* light;
@@ -196,34 +214,6 @@ struct INX_GPUEnvironment {
     alignas(4) int32_t tonemapMode;
 };
 
-/** Shared GPU data per draw call */
-struct INX_GPUDrawShared {
-    alignas(16) NX_Mat4 matModel;
-    alignas(16) NX_Mat4 matNormal;
-    alignas(4) int32_t boneOffset;
-    alignas(4) int32_t instancing;
-    alignas(4) int32_t skinning;
-};
-
-/** Unique GPU data per draw call */
-struct INX_GPUDrawUnique {
-    alignas(16) NX_Vec4 albedoColor;
-    alignas(16) NX_Vec3 emissionColor;
-    alignas(4) float emissionEnergy;
-    alignas(4) float aoLightAffect;
-    alignas(4) float occlusion;
-    alignas(4) float roughness;
-    alignas(4) float metalness;
-    alignas(4) float normalScale;
-    alignas(4) float alphaCutOff;
-    alignas(4) float depthOffset;
-    alignas(4) float depthScale;
-    alignas(8) NX_Vec2 texOffset;
-    alignas(8) NX_Vec2 texScale;
-    alignas(4) int32_t billboard;
-    alignas(4) uint32_t layerMask;
-};
-
 /** Reflection probe data */
 struct INX_GPUReflectionProbe {
     alignas(16) NX_Vec3 position;
@@ -250,6 +240,9 @@ struct INX_SceneState {
     gpu::Texture targetDepth{};        //< D24
     gpu::Framebuffer framebuffer{};
 
+    /** Max depth pyramid of the pre-pass, used for occlusion culling */
+    INX_HiZBuffer hiZ{};
+
     /** Additionnal framebuffers */
     gpu::SwapBuffer swapFramebuffer{};      //< Ping-pong buffer used during scene post process
     gpu::SwapBuffer swapHalfRes{};          //< Secondary ping-pong buffer in half resolution
@@ -334,7 +327,25 @@ struct INX_DrawCallState {
 
     /** Sorted draw call indices array */
     util::BucketArray<int, INX_DrawType, DRAW_TYPE_COUNT> sortedUnique{};
-    util::DynamicArray<float> sortDistances{}; ///< Sorting cache
+    util::DynamicArray<uint64_t> sortKeys{};   ///< Sorting cache
+
+    /** Immediate draw calls waiting for the end of the pass to enter 'sortedUnique' */
+    util::DynamicArray<int> pendingUnique{};    //< Unique indices in submission order, -1 once culled
+    util::DynamicArray<int> pendingCulled{};    //< Positions in 'pendingUnique' of the draw calls to frustum test, one per box
+    INX_BoxBatch pendingBoxes{};
+
+    /** Batch culling results */
+    util::DynamicArray<uint64_t> cullVisible{};
+    util::DynamicArray<uint64_t> cullInside{};
+
+    /** Per-instance GPU culling of instanced draw calls */
+    INX_InstanceCulling instanceCulling{};
+
+    /** Opaque lit draw list, with the groups submitted by multi-draw indirect */
+    INX_MultiDraw multiDraw{};
+    util::DynamicArray<int> multiDrawOrder{};                   ///< Grouping cache
+    util::DynamicArray<int> multiDrawRuns{};                    ///< Grouping cache
+    util::DynamicArray<INX_MultiDrawEntry> multiDrawEntries{};  ///< Grouping cache
 
     /** Draw call data stored in VRAM */
     gpu::StagingBuffer<INX_GPUReflectionProbe> reflectionProbeBuffer{};
@@ -344,6 +355,7 @@ struct INX_DrawCallState {
 
     /** Additional infos */
     uint32_t reflectionProbeCount{};
+    uint32_t retainedCapacity{};            //< Number of scene object slots at the start of the shared/unique buffers
 };
 
 struct INX_Render3DState {
@@ -712,6 +724,10 @@ static void INX_InitDrawCallState(INX_DrawCallState* drawCalls)
     if (!drawCalls->sortedUnique.Reserve(drawCallReserveCount)) {
         NX_LOG(E, "RENDER: Visible unique draw call list pre-allocation failed (requested: %i entries)", drawCallReserveCount);
     }
+
+    if (!drawCalls->pendingUnique.Reserve(drawCallReserveCount)) {
+        NX_LOG(E, "RENDER: Pending unique draw call list pre-allocation failed (requested: %i entries)", drawCallReserveCount);
+    }
 }
 
 // ============================================================================
@@ -871,6 +887,10 @@ static void INX_EndRenderPass()
     INX_Render3D->drawCalls.sortedUnique.Clear();
     INX_Render3D->drawCalls.sharedData.Clear();
     INX_Render3D->drawCalls.uniqueData.Clear();
+    INX_Render3D->drawCalls.pendingUnique.Clear();
+    INX_Render3D->drawCalls.pendingCulled.Clear();
+    INX_Render3D->drawCalls.pendingBoxes.Clear();
+    INX_Render3D->drawCalls.instanceCulling.Clear();
 }
 
 static INX_RenderPassView INX_GetRenderPassView()
@@ -912,15 +932,52 @@ static INX_DrawType INX_GetDrawType(const NX_Material& material)
     return INX_DrawType(type);
 }
 
+static bool INX_IsInstanceCullingEnabled(const NX_InstanceBuffer* instances)
+{
+    // Cubemap faces are rendered with their own frustum while the
+    // instances are only culled once per pass, they are drawn as is
+    return instances != nullptr
+        && NX_FLAG_CHECK(INX_Render3D->renderFlags, NX_RENDER_INSTANCE_CULLING)
+        && INX_Render3D->renderPass != INX_RenderPass::RENDER_CUBEMAP;
+}
+
+static bool INX_CanCullInstances(const NX_Material& material)
+{
+    // Billboards are rotated in the vertex shader, away from the bounds used for the tests
+    return material.billboard == NX_BILLBOARD_DISABLED;
+}
+
+static bool INX_CanOccludeInstances(const NX_Material& material)
+{
+    // Occluded fragments must fail their own depth test against the pre-pass depth
+    return INX_Render3D->renderPass == INX_RenderPass::RENDER_SCENE
+        && NX_FLAG_CHECK(INX_Render3D->renderFlags, NX_RENDER_OCCLUSION_CULLING)
+        && material.depth.test == NX_DEPTH_TEST_LESS
+        && material.depth.offset >= 0.0f && material.depth.scale >= 1.0f;
+}
+
+static uint32_t INX_GetElementCount(const INX_VariantMesh& mesh)
+{
+    const NX_VertexBuffer3D* buffer = mesh.GetBuffer();
+    bool isIndexed = (buffer->ebo.IsValid() && buffer->indexCount > 0);
+    return isIndexed ? buffer->indexCount : buffer->vertexCount;
+}
+
 static int INX_ComputeBoneMatrices(const NX_Model& model)
 {
     const NX_Skeleton& skeleton = *model.skeleton;
-
-    const NX_Mat4* currentPose = (model.player != nullptr)
-        ? model.player->currentPose : skeleton.bindPose;
+    const NX_AnimationPlayer* player = model.player;
 
     int boneMatrixOffset = -1;
     NX_Mat4* bones = INX_Render3D->drawCalls.boneBuffer.StageMap(skeleton.boneCount, &boneMatrixOffset);
+
+    // Skinning matrices already computed during the player update
+    if (player != nullptr && player->skinningPose != nullptr && player->skeleton == &skeleton) {
+        SDL_memcpy(bones, player->skinningPose, skeleton.boneCount * sizeof(NX_Mat4));
+        return boneMatrixOffset;
+    }
+
+    const NX_Mat4* currentPose = (player != nullptr) ? player->currentPose : skeleton.bindPose;
     NX_Mat4MulBatch(bones, skeleton.boneOffsets, currentPose, skeleton.boneCount);
 
     return boneMatrixOffset;
@@ -935,23 +992,36 @@ static void INX_PushDrawCall(
         return;
     }
 
+    INX_DrawCallState& state = INX_Render3D->drawCalls;
+    int sharedIndex = state.sharedData.GetSize();
+    int uniqueIndex = state.uniqueData.GetSize();
+
+    // The frustum test is deferred to 'INX_CullPendingDrawCalls' so that
+    // all the draw calls of the pass are tested at once
+    int culledInstances = -1;
+
     if (instanceCount == 0) [[likely]] {
         if ((INX_Render3D->renderFlags & NX_RENDER_FRUSTUM_CULLING) != 0) {
             INX_OrientedBoundingBox3D obb(mesh.GetAABB(), transform);
-            if (!view.frustum->ContainsObb(obb)) {
-                return;
-            }
+            state.pendingBoxes.Push(obb.GetAabb());
+            state.pendingCulled.PushBack(state.pendingUnique.GetSize());
+        }
+    }
+    else if (INX_IsInstanceCullingEnabled(instances) && INX_CanCullInstances(material)) {
+        culledInstances = state.instanceCulling.Enqueue(
+            *instances, instanceCount, INX_GetDrawSphere(mesh.GetAABB(), transform),
+            INX_CanOccludeInstances(material)
+        );
+        if (culledInstances >= 0) {
+            state.instanceCulling.PushCommand(INX_GetElementCount(mesh));
         }
     }
-
-    INX_DrawCallState& state = INX_Render3D->drawCalls;
-    int sharedIndex = state.sharedData.GetSize();
-    int uniqueIndex = state.uniqueData.GetSize();
 
     state.sharedData.EmplaceBack(INX_DrawShared {
         .transform = transform,
         .instances = instances,
         .instanceCount = instanceCount,
+        .culledInstances = culledInstances,
         .boneMatrixOffset = -1,
         .uniqueDataIndex = uniqueIndex,
         .uniqueDataCount = 1
@@ -961,9 +1031,11 @@ static void INX_PushDrawCall(
         .mesh = mesh,
         .material = material,
         .textures = {},
+        .textureHandles = {},               //< Resolved at upload
         .dynamicRangeIndex = -1,
         .sharedDataIndex = sharedIndex,
         .uniqueDataIndex = uniqueIndex,
+        .retainedSlot = -1,
         .type = INX_GetDrawType(material)
     };
 
@@ -972,7 +1044,7 @@ static void INX_PushDrawCall(
         uniqueData.dynamicRangeIndex = material.shader->GetDynamicRangeIndex();
     }
 
-    state.sortedUnique.Push(uniqueData.type, state.uniqueData.GetSize());
+    state.pendingUnique.PushBack(uniqueIndex);
     state.uniqueData.PushBack(uniqueData);
 }
 
@@ -985,6 +1057,9 @@ static void INX_PushDrawCall(
 
     /* --- Classification du model par rapport au frustum --- */
 
+    // A model crossing the frustum has the boxes of its meshes tested
+    // with all the draw calls of the pass by 'INX_CullPendingDrawCalls'
+
     bool fullyInside = true;
     if (instanceCount == 0) [[likely]] {
         if ((INX_Render3D->renderFlags & NX_RENDER_FRUSTUM_CULLING) != 0) {
@@ -1010,18 +1085,15 @@ static void INX_PushDrawCall(
             continue;
         }
 
-        if (!fullyInside) /* 'false' means frustum culling is enabled */ {
-            INX_OrientedBoundingBox3D obb(mesh.aabb, transform);
-            if (!view.frustum->ContainsObb(obb)) continue;
-        }
-
         INX_DrawUnique uniqueData{
             .mesh = model.meshes[i],
             .material = model.materials[model.meshMaterials[i]],
             .textures = {},
+            .textureHandles = {},           //< Resolved at upload
             .dynamicRangeIndex = -1,
             .sharedDataIndex = sharedIndex,
             .uniqueDataIndex = static_cast<int>(state.uniqueData.GetSize()),
+            .retainedSlot = -1,
             .type = INX_GetDrawType(model.materials[model.meshMaterials[i]])
         };
 
@@ -1030,7 +1102,13 @@ static void INX_PushDrawCall(
             uniqueData.dynamicRangeIndex = uniqueData.material.shader->GetDynamicRangeIndex();
         }
 
-        state.sortedUnique.Push(uniqueData.type, state.uniqueData.GetSize());
+        if (!fullyInside) /* 'false' means frustum culling is enabled */ {
+            INX_OrientedBoundingBox3D obb(mesh.aabb, transform);
+            state.pendingBoxes.Push(obb.GetAabb());
+            state.pendingCulled.PushBack(state.pendingUnique.GetSize());
+        }
+
+        state.pendingUnique.PushBack(state.uniqueData.GetSize());
         state.uniqueData.PushBack(uniqueData);
         ++uniqueCount;
     }
@@ -1046,18 +1124,244 @@ static void INX_PushDrawCall(
         boneMatrixOffset = INX_ComputeBoneMatrices(model);
     }
 
+    /* --- Register the instances for culling, with one command per mesh --- */
+
+    int culledInstances = -1;
+
+    if (instanceCount > 0 && INX_IsInstanceCullingEnabled(instances))
+    {
+        bool cullable = true;
+        bool occludable = true;
+
+        for (int i = uniqueIndex; i < uniqueIndex + uniqueCount; i++) {
+            cullable = cullable && INX_CanCullInstances(state.uniqueData[i].material);
+            occludable = occludable && INX_CanOccludeInstances(state.uniqueData[i].material);
+        }
+
+        if (cullable) {
+            culledInstances = state.instanceCulling.Enqueue(
+                *instances, instanceCount, INX_GetDrawSphere(model.aabb, transform), occludable
+            );
+        }
+
+        if (culledInstances >= 0) {
+            for (int i = uniqueIndex; i < uniqueIndex + uniqueCount; i++) {
+                state.instanceCulling.PushCommand(INX_GetElementCount(state.uniqueData[i].mesh));
+            }
+        }
+    }
+
     /* --- Push shared draw call data --- */
 
     state.sharedData.EmplaceBack(INX_DrawShared {
         .transform = transform,
         .instances = instances,
         .instanceCount = instanceCount,
+        .culledInstances = culledInstances,
         .boneMatrixOffset = boneMatrixOffset,
         .uniqueDataIndex = uniqueIndex,
         .uniqueDataCount = uniqueCount
     });
 }
 
+static void INX_CullPendingDrawCalls()
+{
+    INX_DrawCallState& state = INX_Render3D->drawCalls;
+
+    /* --- Test the boxes of all the pending draw calls at once --- */
+
+    const size_t boxCount = state.pendingBoxes.GetSize();
+
+    if (boxCount > 0)
+    {
+        INX_RenderPassView view = INX_GetRenderPassView();
+
+        const size_t maskSize = INX_GetCullMaskSize(boxCount);
+        state.cullVisible.Resize(maskSize);
+        state.cullInside.Resize(maskSize);
+
+        view.frustum->CullBoxes(state.pendingBoxes, state.cullVisible.GetData(), state.cullInside.GetData());
+
+        // Boxes crossing a plane still need the exact OBB test, rejected draw calls are
+        // removed from the pending list, and a shared entry left empty is not packed
+
+        for (size_t i = 0; i < boxCount; i++) {
+            if (INX_TestCullMask(state.cullInside.GetData(), i)) {
+                continue;
+            }
+            int& pending = state.pendingUnique[state.pendingCulled[i]];
+            const INX_DrawUnique& unique = state.uniqueData[pending];
+            INX_DrawShared& shared = state.sharedData[unique.sharedDataIndex];
+            if (!INX_TestCullMask(state.cullVisible.GetData(), i)
+                || !view.frustum->ContainsObb(INX_OrientedBoundingBox3D(unique.mesh.GetAABB(), shared.transform))) {
+                if (shared.uniqueDataCount == 1) shared.uniqueDataCount = 0;
+                pending = -1;
+            }
+        }
+    }
+
+    /* --- Submit the remaining draw calls in their submission order --- */
+
+    for (size_t i = 0; i < state.pendingUnique.GetSize(); i++) {
+        if (state.pendingUnique[i] >= 0) {
+            const INX_DrawUnique& unique = state.uniqueData[state.pendingUnique[i]];
+            state.sortedUnique.Push(unique.type, unique.uniqueDataIndex);
+        }
+    }
+
+    state.pendingUnique.Clear();
+    state.pendingCulled.Clear();
+    state.pendingBoxes.Clear();
+}
+
+static void INX_CullInstancedDrawCalls(const gpu::Pipeline& pipeline)
+{
+    // Overwrites the storage bindings, must be called before the draw call buffers are bound
+
+    INX_InstanceCulling& culling = INX_Render3D->drawCalls.instanceCulling;
+    if (culling.IsEmpty()) {
+        return;
+    }
+
+    culling.Dispatch(pipeline, *INX_GetRenderPassView().frustum);
+}
+
+static void INX_CollectSceneObjects()
+{
+    // Below this count a linear pass over the slots is faster than walking the tree
+    constexpr int hierarchicalThreshold = 256;
+
+    const INX_SceneObjectStore& store = INX_SceneObjects;
+    if (store.aliveCount == 0) {
+        return;
+    }
+
+    INX_DrawCallState& state = INX_Render3D->drawCalls;
+    INX_RenderPassView view = INX_GetRenderPassView();
+
+    const bool frustumCulling = NX_FLAG_CHECK(INX_Render3D->renderFlags, NX_RENDER_FRUSTUM_CULLING);
+
+    auto push = [&](int slot, bool fullyInside)
+    {
+        if ((store.states[slot] & INX_SceneObjectStore::SLOT_VISIBLE) != INX_SceneObjectStore::SLOT_VISIBLE) {
+            return;
+        }
+
+        if ((view.cullMask & store.layerMasks[slot]) == 0) {
+            return;
+        }
+
+        if (!fullyInside && !view.frustum->ContainsObb(store.bounds[slot])) {
+            return;
+        }
+
+        const NX_SceneObject& object = *store.objects[slot];
+
+        INX_DrawUnique uniqueData{
+            .mesh = object.mesh,
+            .material = object.material,
+            .textures = {},
+            .textureHandles = {},               //< Packed with the slot
+            .dynamicRangeIndex = -1,
+            .sharedDataIndex = -1,
+            .uniqueDataIndex = static_cast<int>(state.uniqueData.GetSize()),
+            .retainedSlot = slot,
+            .type = INX_GetDrawType(object.material)
+        };
+
+        if (object.material.shader != nullptr) {
+            uniqueData.textures = object.material.shader->GetTextures();
+            uniqueData.dynamicRangeIndex = object.material.shader->GetDynamicRangeIndex();
+        }
+
+        state.sortedUnique.Push(uniqueData.type, state.uniqueData.GetSize());
+        state.uniqueData.PushBack(uniqueData);
+    };
+
+    // Leaves whose fat box is fully inside the frustum contain their object,
+    // only leaves crossing a plane still need the exact OBB test
+    if (frustumCulling && store.aliveCount >= hierarchicalThreshold) {
+        store.tree.Query(*view.frustum, push);
+        return;
+    }
+
+    const int slotCount = store.GetSlotCount();
+
+    if (!frustumCulling) {
+        for (int slot = 0; slot < slotCount; slot++) {
+            push(slot, true);
+        }
+        return;
+    }
+
+    const size_t maskSize = INX_GetCullMaskSize(slotCount);
+    state.cullVisible.Resize(maskSize);
+    state.cullInside.Resize(maskSize);
+
+    view.frustum->CullBoxes(store.cullBoxes, state.cullVisible.GetData(), state.cullInside.GetData());
+
+    for (int slot = 0; slot < slotCount; slot++) {
+        if (INX_TestCullMask(state.cullVisible.GetData(), slot)) {
+            push(slot, INX_TestCullMask(state.cullInside.GetData(), slot));
+        }
+    }
+}
+
+static void INX_UploadSceneObjects()
+{
+    INX_DrawCallState& state = INX_Render3D->drawCalls;
+    INX_SceneObjectStore& store = INX_SceneObjects;
+
+    /* --- Grow the retained region, immediate records are stored after it --- */
+
+    const uint32_t slotCount = store.GetSlotCount();
+
+    if (slotCount > state.retainedCapacity) {
+        state.retainedCapacity = NX_MAX(2 * state.retainedCapacity, NX_MAX(slotCount, 64u));
+        state.sharedBuffer.Reserve(state.retainedCapacity * sizeof(INX_GPUDrawShared), false);
+        state.uniqueBuffer.Reserve(state.retainedCapacity * sizeof(INX_GPUDrawUnique), false);
+        store.MarkAllDirty();
+    }
+
+    /* --- Repack all slots when a texture replaced its bindless handle or moved to another array layer --- */
+
+    if (store.textureGeneration != INX_GetMaterialTextureGeneration()) {
+        store.textureGeneration = INX_GetMaterialTextureGeneration();
+        store.MarkAllDirty();
+    }
+
+    /* --- Upload only the slots that changed since the last upload --- */
+
+    store.FlushDirty([&state, &store](int firstSlot, int count) {
+        state.sharedBuffer.Upload(
+            firstSlot * sizeof(INX_GPUDrawShared), count * sizeof(INX_GPUDrawShared),
+            &store.gpuShared[firstSlot]
+        );
+        state.uniqueBuffer.Upload(
+            firstSlot * sizeof(INX_GPUDrawUnique), count * sizeof(INX_GPUDrawUnique),
+            &store.gpuUnique[firstSlot]
+        );
+    });
+}
+
+static void INX_ResolveDrawTextures()
+{
+    INX_DrawCallState& state = INX_Render3D->drawCalls;
+
+    // Handles and layers can change with any texture update until now, they are resolved
+    // here on the GL thread. Scene objects keep the ones of their slot, their textures are
+    // still resolved so that their array layers are refreshed or moved before the upload.
+
+    INX_MaterialArrays.BeginPass();
+
+    for (INX_DrawUnique& unique : state.uniqueData) {
+        INX_MaterialHandles handles = INX_ResolveMaterialTextures(unique.material);
+        if (unique.retainedSlot < 0) {
+            unique.textureHandles = handles;
+        }
+    }
+}
+
 static void INX_UploadDrawCalls()
 {
     INX_DrawCallState& state = INX_Render3D->drawCalls;
@@ -1065,142 +1369,199 @@ static void INX_UploadDrawCalls()
     state.reflectionProbeBuffer.Upload();
     state.boneBuffer.Upload();
 
+    INX_ResolveDrawTextures();
+    INX_UploadSceneObjects();
+
+    /* --- Upload immediate draw calls after the scene objects slots --- */
+
+    // The unique entries of scene objects are interleaved with the immediate ones,
+    // their slots in the immediate range are simply left unused
+
     const size_t sharedCount = state.sharedData.GetSize();
+    if (sharedCount == 0) {
+        return;
+    }
+
     const size_t uniqueCount = state.uniqueData.GetSize();
     const size_t sharedBytes = sharedCount * sizeof(INX_GPUDrawShared);
     const size_t uniqueBytes = uniqueCount * sizeof(INX_GPUDrawUnique);
+    const size_t sharedOffset = state.retainedCapacity * sizeof(INX_GPUDrawShared);
+    const size_t uniqueOffset = state.retainedCapacity * sizeof(INX_GPUDrawUnique);
+    const bool keepRetained = (state.retainedCapacity > 0);
 
-    state.sharedBuffer.Reserve(sharedBytes, false);
-    state.uniqueBuffer.Reserve(uniqueBytes, false);
+    state.sharedBuffer.Reserve(sharedOffset + sharedBytes, keepRetained);
+    state.uniqueBuffer.Reserve(uniqueOffset + uniqueBytes, keepRetained);
 
     INX_GPUDrawShared* sharedBuffer = state.sharedBuffer.MapRange<INX_GPUDrawShared>(
-        0, sharedBytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT
+        sharedOffset, sharedBytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT
     );
 
     INX_GPUDrawUnique* uniqueBuffer = state.uniqueBuffer.MapRange<INX_GPUDrawUnique>(
-        0, uniqueBytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT
+        uniqueOffset, uniqueBytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT
     );
 
-    for (size_t i = 0; i < sharedCount; i++)
-    {
-        const INX_DrawShared& shared = state.sharedData[i];
-
-        NX_Mat3 matNormal = NX_TransformToNormalMat3(&shared.transform);
+    // Each shared entry owns the contiguous range of unique entries that follows it,
+    // so a chunk of shared entries never writes outside of its own slots in both buffers
 
-        INX_GPUDrawShared& gpuShared = sharedBuffer[i];
-        gpuShared.matModel = NX_TransformToMat4(&shared.transform);
-        gpuShared.matNormal = NX_Mat3ToMat4(&matNormal);
-        gpuShared.boneOffset = shared.boneMatrixOffset;
-        gpuShared.instancing = (shared.instanceCount > 0);
-        gpuShared.skinning = (shared.boneMatrixOffset >= 0);
-
-        const int uniqueStart = shared.uniqueDataIndex;
-        const int uniqueEnd = uniqueStart + shared.uniqueDataCount;
-
-        for (int j = uniqueStart; j < uniqueEnd; j++)
-        {
-            const INX_DrawUnique& unique = state.uniqueData[j];
-            const NX_Material& material = unique.material;
-
-            INX_GPUDrawUnique& gpuUnique = uniqueBuffer[j];
-            gpuUnique.albedoColor = NX_ColorToVec4(material.albedo.color);
-            gpuUnique.emissionColor = NX_ColorToVec3(material.emission.color);
-            gpuUnique.emissionEnergy = material.emission.energy;
-            gpuUnique.aoLightAffect = material.orm.aoLightAffect;
-            gpuUnique.occlusion = material.orm.occlusion;
-            gpuUnique.roughness = material.orm.roughness;
-            gpuUnique.metalness = material.orm.metalness;
-            gpuUnique.normalScale = material.normal.scale;
-            gpuUnique.alphaCutOff = material.alphaCutOff;
-            gpuUnique.depthOffset = material.depth.offset;
-            gpuUnique.depthScale = material.depth.scale;
-            gpuUnique.texOffset = material.texOffset;
-            gpuUnique.texScale = material.texScale;
-            gpuUnique.billboard = material.billboard;
-            gpuUnique.layerMask = unique.mesh.GetLayerMask();
+    auto pack = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const INX_DrawShared& shared = state.sharedData[i];
+            if (shared.uniqueDataCount == 0) {
+                continue;   // Rejected by the frustum test
+            }
+            INX_PackDrawShared(&sharedBuffer[i], shared.transform, shared.boneMatrixOffset, shared.instanceCount);
+            const int uniqueEnd = shared.uniqueDataIndex + shared.uniqueDataCount;
+            for (int j = shared.uniqueDataIndex; j < uniqueEnd; j++) {
+                const INX_DrawUnique& unique = state.uniqueData[j];
+                INX_PackDrawUnique(&uniqueBuffer[j], unique.material, unique.mesh.GetLayerMask(), unique.textureHandles);
+            }
         }
+    };
+
+    if (NX_FLAG_CHECK(INX_Render3D->renderFlags, NX_RENDER_MULTITHREADED)) {
+        constexpr size_t grainSize = 128;
+        INX_Jobs.ParallelFor(sharedCount, grainSize, pack);
+    }
+    else {
+        pack(0, sharedCount);
     }
 
     state.sharedBuffer.Unmap();
     state.uniqueBuffer.Unmap();
 }
 
-static void INX_SortDrawCalls(const NX_Vec3& viewPosition)
+static INX_DrawStateKey INX_GetDrawStateKey(const INX_DrawUnique& unique)
 {
-    INX_DrawCallState& state = INX_Render3D->drawCalls;
-    util::DynamicArray<float>& sortDistances = state.sortDistances;
+    // Everything bound by the opaque lit loops for this draw call, the shader first.
+    // Bindless material textures are read from the records, they are left out,
+    // arrayed ones are keyed by their arrays so that their draw calls can merge.
 
-    if (NX_FLAG_CHECK(INX_Render3D->renderFlags, NX_RENDER_SORT_OPAQUE))
-    {
-        const size_t count = state.uniqueData.GetSize();
-        sortDistances.Resize(count);
+    const NX_Material& mat = unique.material;
+    const bool bound = !INX_IsMaterialBindless();
+    const bool arrayed = bound && INX_IsMaterialArrayed(mat);
 
-        for (size_t i = 0; i < count; ++i)
-        {
-            const INX_DrawUnique& unique = state.uniqueData[i];
-            const INX_DrawShared& shared = state.sharedData[unique.sharedDataIndex];
+    auto texture = [bound, arrayed](const NX_Texture* texture) -> uintptr_t {
+        return bound ? reinterpret_cast<uintptr_t>(&INX_GetMaterialTexture(texture, arrayed)) : 0;
+    };
 
-            const NX_BoundingBox3D& box = unique.mesh.GetAABB();
-            const NX_Transform& transform = shared.transform;
+    return INX_DrawStateKey {
+        reinterpret_cast<uintptr_t>(INX_Assets.Select(mat.shader, INX_Shader3DAsset::DEFAULT)),
+        reinterpret_cast<uintptr_t>(unique.mesh.GetBuffer()),
+        texture(INX_Assets.Select(mat.albedo.texture, INX_TextureAsset::WHITE)),
+        texture(INX_Assets.Select(mat.emission.texture, INX_TextureAsset::WHITE)),
+        texture(INX_Assets.Select(mat.orm.texture, INX_TextureAsset::WHITE)),
+        texture(INX_Assets.Select(mat.normal.texture, INX_TextureAsset::NORMAL)),
+        reinterpret_cast<uintptr_t>(unique.textures[0]),
+        reinterpret_cast<uintptr_t>(unique.textures[1]),
+        reinterpret_cast<uintptr_t>(unique.textures[2]),
+        reinterpret_cast<uintptr_t>(unique.textures[3]),
+        static_cast<uintptr_t>(unique.dynamicRangeIndex + 1),
+        static_cast<uintptr_t>(unique.mesh.GetPrimitiveType()),
+        static_cast<uintptr_t>(mat.shading),
+        static_cast<uintptr_t>(mat.depth.test),
+        static_cast<uintptr_t>(mat.cull)
+    };
+}
 
-            // Distance from view position to the AABB's center
+static uint32_t INX_GetSortState(const INX_DrawUnique& unique)
+{
+    const INX_DrawStateKey key = INX_GetDrawStateKey(unique);
 
-            NX_Vec3 local = (box.min + box.max) * 0.5f;
-            NX_Vec3 world = local * transform;
+    // The shader and its shading mode select the program variant,
+    // the other entries are the textures and states bound with it
+    constexpr size_t shadingEntry = 12;
 
-            sortDistances[i] = NX_Vec3DistanceSq(viewPosition, world);
-        }
+    uint64_t shaderHash = INX_HashMix(INX_HashMix(0, key[0]), key[shadingEntry]);
 
-        state.sortedUnique.Sort(DRAW_OPAQUE_LIT, [&sortDistances](int a, int b) {
-            return sortDistances[a] < sortDistances[b];
-        });
+    uint64_t materialHash = 0;
+    for (size_t i = 1; i < key.size(); i++) {
+        if (i != shadingEntry) materialHash = INX_HashMix(materialHash, key[i]);
+    }
 
-        state.sortedUnique.Sort(DRAW_OPAQUE_UNLIT, [&sortDistances](int a, int b) {
-            return sortDistances[a] < sortDistances[b];
-        });
+    return INX_PackSortState(shaderHash, materialHash);
+}
+
+static void INX_SortDrawCalls(const NX_Vec3& viewPosition)
+{
+    INX_DrawCallState& state = INX_Render3D->drawCalls;
+    util::DynamicArray<uint64_t>& sortKeys = state.sortKeys;
+
+    const bool sortState = NX_FLAG_CHECK(INX_Render3D->renderFlags, NX_RENDER_SORT_STATE);
+    const bool sortOpaque = sortState || NX_FLAG_CHECK(INX_Render3D->renderFlags, NX_RENDER_SORT_OPAQUE);
+    const bool sortTransparent = NX_FLAG_CHECK(INX_Render3D->renderFlags, NX_RENDER_SORT_TRANSPARENT);
+    if (!sortOpaque && !sortTransparent) {
+        return;
     }
 
-    if (NX_FLAG_CHECK(INX_Render3D->renderFlags, NX_RENDER_SORT_TRANSPARENT))
-    {
-        const size_t count = state.uniqueData.GetSize();
-        sortDistances.Resize(count);
+    /* --- Compute the sort keys, one slot per draw call --- */
 
-        for (size_t i = 0; i < count; ++i)
-        {
-            const INX_DrawUnique& unique = state.uniqueData[i];
-            const INX_DrawShared& shared = state.sharedData[unique.sharedDataIndex];
+    // Opaque draw calls use the distance to their center, and
+    // transparent ones the distance to their farthest corner
+
+    const INX_SortPolicy opaquePolicy = sortState ? INX_SORT_STATE : INX_SORT_FRONT_TO_BACK;
 
+    const size_t count = state.uniqueData.GetSize();
+    sortKeys.Resize(count);
+
+    auto computeKeys = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const INX_DrawUnique& unique = state.uniqueData[i];
+            const NX_Transform& transform = (unique.retainedSlot >= 0)
+                ? INX_SceneObjects.transforms[unique.retainedSlot]
+                : state.sharedData[unique.sharedDataIndex].transform;
             const NX_BoundingBox3D& box = unique.mesh.GetAABB();
-            const NX_Transform& transform = shared.transform;
-
-            // Distance from view position to the AABB's farthest corner
-
-            const NX_Vec3 corners[8] = {
-                NX_VEC3(box.min.x, box.min.y, box.min.z) * transform,
-                NX_VEC3(box.max.x, box.min.y, box.min.z) * transform,
-                NX_VEC3(box.min.x, box.max.y, box.min.z) * transform,
-                NX_VEC3(box.max.x, box.max.y, box.min.z) * transform,
-                NX_VEC3(box.min.x, box.min.y, box.max.z) * transform,
-                NX_VEC3(box.max.x, box.min.y, box.max.z) * transform,
-                NX_VEC3(box.min.x, box.max.y, box.max.z) * transform,
-                NX_VEC3(box.max.x, box.max.y, box.max.z) * transform
-            };
-
-            float maxDistSq = NX_Vec3DistanceSq(viewPosition, corners[0]);
-            for (int i = 1; i < 8; ++i) {
-                float distSq = NX_Vec3DistanceSq(viewPosition, corners[i]);
-                if (distSq > maxDistSq) maxDistSq = distSq;
-            }
+            const uint32_t stateBits = INX_GetSortState(unique);
+            sortKeys[i] = (unique.type == DRAW_TRANSPARENT)
+                ? INX_MakeSortKey(INX_SORT_BACK_TO_FRONT, stateBits, INX_GetFarthestDistanceSq(viewPosition, box, transform))
+                : INX_MakeSortKey(opaquePolicy, stateBits, INX_GetCenterDistanceSq(viewPosition, box, transform));
+        }
+    };
 
-            sortDistances[i] = maxDistSq;
+    if (NX_FLAG_CHECK(INX_Render3D->renderFlags, NX_RENDER_MULTITHREADED)) {
+        constexpr size_t grainSize = 256;
+        INX_Jobs.ParallelFor(count, grainSize, computeKeys);
+    }
+    else {
+        computeKeys(0, count);
+    }
+
+    /* --- Radix sort of the categories, equal keys keep their submission order --- */
+
+    auto getKey = [&sortKeys](int uniqueIndex) {
+        return sortKeys[uniqueIndex];
+    };
+
+    auto sortCategory = [&](INX_DrawType type) {
+        if (!state.sortedUnique.SortByKey(type, getKey)) {
+            NX_LOG(E, "RENDER: Failed to allocate sort buffers; Draw calls are left in submission order");
         }
+    };
 
-        state.sortedUnique.Sort(DRAW_TRANSPARENT, [&sortDistances](int a, int b) {
-            return sortDistances[a] > sortDistances[b];
-        });
+    if (sortOpaque) {
+        sortCategory(DRAW_OPAQUE_LIT);
+        sortCategory(DRAW_OPAQUE_UNLIT);
+    }
+
+    if (sortTransparent) {
+        sortCategory(DRAW_TRANSPARENT);
     }
 }
 
+static void INX_BindMaterialTextures(const gpu::Pipeline& pipeline, const NX_Material& mat)
+{
+    // Bindless material textures are sampled through the handles of the records
+    if (INX_IsMaterialBindless()) {
+        return;
+    }
+
+    const bool arrayed = INX_IsMaterialArrayed(mat);
+
+    pipeline.BindTexture(0, INX_GetMaterialTexture(INX_Assets.Select(mat.albedo.texture, INX_TextureAsset::WHITE), arrayed));
+    pipeline.BindTexture(1, INX_GetMaterialTexture(INX_Assets.Select(mat.emission.texture, INX_TextureAsset::WHITE), arrayed));
+    pipeline.BindTexture(2, INX_GetMaterialTexture(INX_Assets.Select(mat.orm.texture, INX_TextureAsset::WHITE), arrayed));
+    pipeline.BindTexture(3, INX_GetMaterialTexture(INX_Assets.Select(mat.normal.texture, INX_TextureAsset::NORMAL), arrayed));
+}
+
 static void INX_Draw3D(const gpu::Pipeline& pipeline, const INX_DrawUnique& unique, const INX_DrawShared& shared)
 {
     /* --- Gets data according to the type of mesh to be drawn --- */
@@ -1238,7 +1599,22 @@ static void INX_Draw3D(const gpu::Pipeline& pipeline, const INX_DrawUnique& uniq
     bool useInstancing = (shared.instances && shared.instanceCount > 0);
 
     pipeline.BindVertexArray(buffer->vao);
-    if (useInstancing) [[unlikely]] {
+
+    if (useInstancing) [[unlikely]]
+    {
+        // Culled instances are compacted on the GPU along with the count of the indirect command
+        const INX_InstanceCulling& culling = INX_Render3D->drawCalls.instanceCulling;
+
+        if (culling.IsCulled(shared.culledInstances)) {
+            const int command = unique.uniqueDataIndex - shared.uniqueDataIndex;
+            const size_t offset = culling.GetCommandOffset(shared.culledInstances, command);
+            buffer->BindInstances(culling.GetInstances(shared.culledInstances));
+            isIndexed ?
+                pipeline.DrawElementsIndirect(primitive, GL_UNSIGNED_INT, culling.GetCommandBuffer(), offset) :
+                pipeline.DrawArraysIndirect(primitive, culling.GetCommandBuffer(), offset);
+            return;
+        }
+
         buffer->BindInstances(*shared.instances);
     }
 
@@ -1256,9 +1632,173 @@ static void INX_Draw3D(const gpu::Pipeline& pipeline, const INX_DrawUnique& uniq
 
 static void INX_Draw3D(const gpu::Pipeline& pipeline, const INX_DrawUnique& unique)
 {
+    if (unique.retainedSlot >= 0) {
+        static constexpr INX_DrawShared noInstances{};
+        INX_Draw3D(pipeline, unique, noInstances);
+        return;
+    }
+
     INX_Draw3D(pipeline, unique, INX_Render3D->drawCalls.sharedData[unique.sharedDataIndex]);
 }
 
+static NX_IVec2 INX_GetDrawIndices(const INX_DrawUnique& unique)
+{
+    // Scene objects records are stored in their slot at the start of the buffers,
+    // records of immediate draw calls are stored right after
+
+    if (unique.retainedSlot >= 0) {
+        return NX_IVEC2(unique.retainedSlot, unique.retainedSlot);
+    }
+
+    const int base = static_cast<int>(INX_Render3D->drawCalls.retainedCapacity);
+    return NX_IVEC2(base + unique.sharedDataIndex, base + unique.uniqueDataIndex);
+}
+
+static void INX_SetDrawIndices(const gpu::Pipeline& pipeline, const INX_DrawUnique& unique)
+{
+    NX_IVec2 indices = INX_GetDrawIndices(unique);
+    pipeline.SetUniformUint1(0, indices.x);
+    pipeline.SetUniformUint1(1, indices.y);
+}
+
+static bool INX_GetMultiDrawKey(const INX_DrawUnique& unique, INX_DrawStateKey* key)
+{
+    /* --- Only single indexed draws can join a group --- */
+
+    if (unique.retainedSlot < 0) {
+        const INX_DrawShared& shared = INX_Render3D->drawCalls.sharedData[unique.sharedDataIndex];
+        if (shared.instances && shared.instanceCount > 0) return false;
+    }
+
+    const NX_VertexBuffer3D* buffer = unique.mesh.GetBuffer();
+    if (!buffer->ebo.IsValid() || buffer->indexCount <= 0) {
+        return false;
+    }
+
+    *key = INX_GetDrawStateKey(unique);
+
+    return true;
+}
+
+static void INX_BatchDrawCalls()
+{
+    // Renderer calls issued per draw call by each loop of 'INX_RenderSceneOpaqueLit'.
+    // A group issues them once, plus the bind and unbind of its draw indices.
+    constexpr int stateCalls = 5;               //< Program, cull mode, depth function or resolution, shader textures and uniforms
+    constexpr int materialTextureCalls = 4;     //< Albedo, emission, ORM and normal, unless bindless
+    constexpr int drawIndexCalls = 2;           //< Shared and unique draw indices
+    constexpr int submitCalls = 2;              //< Vertex array and draw
+    constexpr int groupIndexCalls = 2;          //< Bind and unbind of the per-draw index attribute
+
+    const int callsPerDraw = stateCalls + drawIndexCalls + submitCalls
+        + (INX_IsMaterialBindless() ? 0 : materialTextureCalls);
+    const int callsPerGroup = callsPerDraw + groupIndexCalls;
+
+    INX_DrawCallState& state = INX_Render3D->drawCalls;
+    INX_MultiDraw& multiDraw = state.multiDraw;
+
+    multiDraw.Clear();
+
+    auto catView = state.sortedUnique.GetCategory(DRAW_OPAQUE_LIT);
+
+    if (!NX_FLAG_CHECK(INX_Render3D->renderFlags, NX_RENDER_MULTI_DRAW) || !gpu::Pipeline::HasMultiDrawIndirect()) {
+        for (int uniqueIndex : catView) {
+            multiDraw.PushDraw(uniqueIndex);
+        }
+        return;
+    }
+
+    /* --- Collect the keys of the draw calls that can be grouped --- */
+
+    state.multiDrawOrder.Clear();
+    state.multiDrawEntries.Clear();
+
+    for (int uniqueIndex : catView) {
+        INX_MultiDrawEntry entry{};
+        entry.position = static_cast<int>(state.multiDrawOrder.GetSize());
+        if (INX_GetMultiDrawKey(state.uniqueData[uniqueIndex], &entry.key)) {
+            state.multiDrawEntries.PushBack(entry);
+        }
+        state.multiDrawOrder.PushBack(uniqueIndex);
+    }
+
+    /* --- Gather equal keys, draw calls keep their relative order within a group --- */
+
+    std::sort(state.multiDrawEntries.Begin(), state.multiDrawEntries.End(),
+        [](const INX_MultiDrawEntry& a, const INX_MultiDrawEntry& b) {
+            if (a.key != b.key) return a.key < b.key;
+            return a.position < b.position;
+        }
+    );
+
+    // Each position stores the first entry of its group, or -1 when drawn alone
+    state.multiDrawRuns.Assign(state.multiDrawOrder.GetSize(), -1);
+
+    const int entryCount = static_cast<int>(state.multiDrawEntries.GetSize());
+
+    for (int begin = 0, end = 0; begin < entryCount; begin = end) {
+        end = begin + 1;
+        while (end < entryCount && state.multiDrawEntries[end].key == state.multiDrawEntries[begin].key) {
+            end++;
+        }
+        if (end - begin < 2) continue;
+        for (int i = begin; i < end; i++) {
+            state.multiDrawRuns[state.multiDrawEntries[i].position] = begin;
+        }
+    }
+
+    /* --- Build the draw list, a group takes the place of its first draw call --- */
+
+    for (int position = 0; position < static_cast<int>(state.multiDrawOrder.GetSize()); position++)
+    {
+        const int uniqueIndex = state.multiDrawOrder[position];
+        const int begin = state.multiDrawRuns[position];
+
+        if (begin < 0) {
+            multiDraw.PushDraw(uniqueIndex);
+            continue;
+        }
+
+        if (state.multiDrawEntries[begin].position != position) {
+            continue;
+        }
+
+        int end = begin + 1;
+        while (end < entryCount && state.multiDrawEntries[end].key == state.multiDrawEntries[begin].key) {
+            end++;
+        }
+
+        multiDraw.PushGroup(uniqueIndex, 2 * (callsPerDraw * (end - begin) - callsPerGroup));
+
+        for (int i = begin; i < end; i++) {
+            const INX_DrawUnique& unique = state.uniqueData[state.multiDrawOrder[state.multiDrawEntries[i].position]];
+            const NX_IVec2 indices = INX_GetDrawIndices(unique);
+            multiDraw.PushCommand(unique.mesh.GetBuffer()->indexCount, indices.x, indices.y);
+        }
+    }
+
+    multiDraw.Upload();
+}
+
+static void INX_Draw3D(const gpu::Pipeline& pipeline, const INX_DrawUnique& unique, const INX_MultiDraw::Item& item)
+{
+    if (item.group < 0) {
+        INX_SetDrawIndices(pipeline, unique);
+        INX_Draw3D(pipeline, unique);
+        return;
+    }
+
+    // Indices of each draw call are read from the 'iDrawIndex' attribute
+    pipeline.SetUniformUint1(0, 0);
+    pipeline.SetUniformUint1(1, 0);
+
+    NX_VertexBuffer3D* buffer = unique.mesh.GetBuffer();
+    GLenum primitive = INX_GPU_GetPrimitiveType(unique.mesh.GetPrimitiveType());
+
+    pipeline.BindVertexArray(buffer->vao);
+    INX_Render3D->drawCalls.multiDraw.Submit(pipeline, *buffer, primitive, item.group);
+}
+
 static void INX_ProcessFrustum(const NX_Camera& camera, float aspect)
 {
     INX_SceneState& scene = INX_Render3D->scene;
@@ -1622,10 +2162,10 @@ static void INX_RenderSceneOpaqueLit(const gpu::Pipeline& pipeline)
     const INX_ShadowingState& shadowing = INX_Render3D->shadowing;
     const INX_LightingState& lighting = INX_Render3D->lighting;
 
-    /* --- Get view over all lit opaque objects --- */
+    /* --- Get the list of lit opaque objects, with their multi-draw groups --- */
 
-    auto catView = drawCalls.sortedUnique.GetCategory(DRAW_OPAQUE_LIT);
-    if (catView.IsEmpty()) return;
+    const auto& drawItems = drawCalls.multiDraw.GetItems();
+    if (drawItems.IsEmpty()) return;
 
     /* --- Setup common pipeline state --- */
 
@@ -1643,9 +2183,9 @@ static void INX_RenderSceneOpaqueLit(const gpu::Pipeline& pipeline)
     pipeline.SetColorWrite(gpu::ColorWrite::RGBA);
     scene.framebuffer.SetDrawBuffers({1});
 
-    for (int uniqueIndex : catView)
+    for (const INX_MultiDraw::Item& item : drawItems)
     {
-        const INX_DrawUnique& unique = drawCalls.uniqueData[uniqueIndex];
+        const INX_DrawUnique& unique = drawCalls.uniqueData[item.uniqueIndex];
         const NX_Material& mat = unique.material;
 
         const NX_Shader3D* shader = INX_Assets.Select(mat.shader, INX_Shader3DAsset::DEFAULT);
@@ -1657,14 +2197,24 @@ static void INX_RenderSceneOpaqueLit(const gpu::Pipeline& pipeline)
         shader->BindTextures(pipeline, unique.textures);
         shader->BindUniforms(pipeline, unique.dynamicRangeIndex);
 
-        pipeline.BindTexture(0, INX_Assets.Select(mat.albedo.texture, INX_TextureAsset::WHITE)->gpu);
-        pipeline.BindTexture(1, INX_Assets.Select(mat.emission.texture, INX_TextureAsset::WHITE)->gpu);
-        pipeline.BindTexture(2, INX_Assets.Select(mat.orm.texture, INX_TextureAsset::WHITE)->gpu);
-        pipeline.BindTexture(3, INX_Assets.Select(mat.normal.texture, INX_TextureAsset::NORMAL)->gpu);
-        pipeline.SetUniformUint1(0, unique.sharedDataIndex);
-        pipeline.SetUniformUint1(1, unique.uniqueDataIndex);
+        INX_BindMaterialTextures(pipeline, mat);
 
-        INX_Draw3D(pipeline, unique);
+        INX_Draw3D(pipeline, unique, item);
+    }
+
+    /* --- Cull occludable instances against the pre-pass depth --- */
+
+    // The depth is only readable without multisampling, it is resolved after the whole scene
+    INX_InstanceCulling& instanceCulling = INX_Render3D->drawCalls.instanceCulling;
+
+    if (instanceCulling.HasOccludableSlots() && scene.framebuffer.GetSampleCount() <= 1)
+    {
+        scene.hiZ.Build(pipeline, scene.targetDepth);
+        instanceCulling.Dispatch(pipeline, scene.viewFrustum, scene.hiZ, scene.viewFrustum.viewProj);
+
+        pipeline.BindStorage(0, drawCalls.sharedBuffer);
+        pipeline.BindStorage(1, drawCalls.uniqueBuffer);
+        pipeline.BindStorage(2, drawCalls.boneBuffer);
     }
 
     /* --- Compute screen space ambient occlusion --- */
@@ -1734,9 +2284,9 @@ static void INX_RenderSceneOpaqueLit(const gpu::Pipeline& pipeline)
     pipeline.SetDepthMode(gpu::DepthMode::TestOnly);
     pipeline.SetDepthFunc(gpu::DepthFunc::Equal);
 
-    for (int uniqueIndex : catView)
+    for (const INX_MultiDraw::Item& item : drawItems)
     {
-        const INX_DrawUnique& unique = drawCalls.uniqueData[uniqueIndex];
+        const INX_DrawUnique& unique = drawCalls.uniqueData[item.uniqueIndex];
         const NX_Material& mat = unique.material;
 
         const NX_Shader3D* shader = INX_Assets.Select(mat.shader, INX_Shader3DAsset::DEFAULT);
@@ -1746,16 +2296,11 @@ static void INX_RenderSceneOpaqueLit(const gpu::Pipeline& pipeline)
         shader->BindTextures(pipeline, unique.textures);
         shader->BindUniforms(pipeline, unique.dynamicRangeIndex);
 
-        pipeline.BindTexture(0, INX_Assets.Select(mat.albedo.texture, INX_TextureAsset::WHITE)->gpu);
-        pipeline.BindTexture(1, INX_Assets.Select(mat.emission.texture, INX_TextureAsset::WHITE)->gpu);
-        pipeline.BindTexture(2, INX_Assets.Select(mat.orm.texture, INX_TextureAsset::WHITE)->gpu);
-        pipeline.BindTexture(3, INX_Assets.Select(mat.normal.texture, INX_TextureAsset::NORMAL)->gpu);
+        INX_BindMaterialTextures(pipeline, mat);
 
-        pipeline.SetUniformUint1(0, unique.sharedDataIndex);
-        pipeline.SetUniformUint1(1, unique.uniqueDataIndex);
         pipeline.SetUniformFloat2(2, NX_IVec2Rcp(scene.framebuffer.GetDimensions()));
 
-        INX_Draw3D(pipeline, unique);
+        INX_Draw3D(pipeline, unique, item);
     }
 }
 
@@ -1812,12 +2357,8 @@ static void INX_RenderScene(const gpu::Pipeline& pipeline, Args&&... args)
         shader->BindTextures(pipeline, unique.textures);
         shader->BindUniforms(pipeline, unique.dynamicRangeIndex);
 
-        pipeline.BindTexture(0, INX_Assets.Select(mat.albedo.texture, INX_TextureAsset::WHITE)->gpu);
-        pipeline.BindTexture(1, INX_Assets.Select(mat.emission.texture, INX_TextureAsset::WHITE)->gpu);
-        pipeline.BindTexture(2, INX_Assets.Select(mat.orm.texture, INX_TextureAsset::WHITE)->gpu);
-        pipeline.BindTexture(3, INX_Assets.Select(mat.normal.texture, INX_TextureAsset::NORMAL)->gpu);
-        pipeline.SetUniformUint1(0, unique.sharedDataIndex);
-        pipeline.SetUniformUint1(1, unique.uniqueDataIndex);
+        INX_BindMaterialTextures(pipeline, mat);
+        INX_SetDrawIndices(pipeline, unique);
 
         INX_Draw3D(pipeline, unique);
     }
@@ -1897,6 +2438,11 @@ static void INX_PostFinal(const gpu::Texture& source)
     pipeline.BindTexture(0, source);
 
     pipeline.Draw(GL_TRIANGLES, 3);
+
+    // Refreshes the material array layer of the target if it is sampled by materials
+    if (scene.target != nullptr) {
+        scene.target->color->gpu.BumpRevision();
+    }
 }
 
 // ============================================================================
@@ -1930,6 +2476,9 @@ void NX_End3D()
         return;
     }
 
+    INX_CullPendingDrawCalls();
+    INX_CollectSceneObjects();
+
     /* --- Renders the scene --- */
 
     INX_SceneState& scene = INX_Render3D->scene;
@@ -1939,6 +2488,7 @@ void NX_End3D()
         gpu::Pipeline pipeline;
 
         INX_UploadDrawCalls();
+        INX_CullInstancedDrawCalls(pipeline);
 
         if (INX_CollectActiveLights(scene.viewFrustum.cullMask)) {
             INX_UploadLightData();
@@ -1959,6 +2509,7 @@ void NX_End3D()
         });
 
         INX_SortDrawCalls(scene.viewFrustum.position);
+        INX_BatchDrawCalls();
 
         pipeline.BindFramebuffer(scene.framebuffer);
         pipeline.SetViewport(scene.framebuffer);
@@ -1976,10 +2527,12 @@ void NX_End3D()
         // REVIEW: We can collect the used programs rather than iterating over all programs
         INX_Pool.ForEach<NX_Shader3D>([](NX_Shader3D& shader) {
             shader.ClearDynamicBuffer();
+            shader.PollPrecompile();
         });
     }
     else {
         // Fast path when there are no draw calls
+        INX_Render3D->drawCalls.multiDraw.Clear();
         gpu::Pipeline([&scene](const gpu::Pipeline& pipeline) { // NOLINT
             pipeline.BindFramebuffer(scene.framebuffer);
             pipeline.SetViewport(scene.framebuffer);
@@ -2070,6 +2623,9 @@ void NX_EndShadow3D()
         return;
     }
 
+    INX_CullPendingDrawCalls();
+    INX_CollectSceneObjects();
+
     /* --- Retrieving useful references --- */
 
     INX_ShadowingState& shadowing = INX_Render3D->shadowing;
@@ -2084,6 +2640,7 @@ void NX_EndShadow3D()
 
     if (!drawCalls.sortedUnique.IsEmpty()) {
         INX_UploadDrawCalls();
+        INX_CullInstancedDrawCalls(pipeline);
         pipeline.BindUniform(0, shadowing.frameUniform);
         pipeline.BindStorage(0, drawCalls.sharedBuffer);
         pipeline.BindStorage(1, drawCalls.uniqueBuffer);
@@ -2165,9 +2722,13 @@ void NX_EndShadow3D()
             shader->BindTextures(pipeline, unique.textures);
             shader->BindUniforms(pipeline, unique.dynamicRangeIndex);
 
-            pipeline.BindTexture(0, INX_Assets.Select(mat.albedo.texture, INX_TextureAsset::WHITE)->gpu);
-            pipeline.SetUniformUint1(0, unique.sharedDataIndex);
-            pipeline.SetUniformUint1(1, unique.uniqueDataIndex);
+            if (!INX_IsMaterialBindless()) {
+                pipeline.BindTexture(0, INX_GetMaterialTexture(
+                    INX_Assets.Select(mat.albedo.texture, INX_TextureAsset::WHITE), shader->UsesMaterialArrays()
+                ));
+            }
+
+            INX_SetDrawIndices(pipeline, unique);
 
             INX_Draw3D(pipeline, unique);
         }
@@ -2205,6 +2766,9 @@ void NX_EndCubemap3D()
         return;
     }
 
+    INX_CullPendingDrawCalls();
+    INX_CollectSceneObjects();
+
     INX_SceneState& scene = INX_Render3D->scene;
     gpu::Framebuffer& framebuffer = scene.cubemap->framebuffer;
 
@@ -2348,3 +2912,18 @@ void NX_DrawReflectionProbe3D(const NX_IndirectLight* indirectLight, const NX_Pr
 
     INX_Render3D->drawCalls.reflectionProbeCount++;
 }
+
+int NX_GetMultiDrawGroups3D(NX_MultiDrawGroup3D* groups, int maxGroups)
+{
+    const auto& multiDrawGroups = INX_Render3D->drawCalls.multiDraw.GetGroups();
+    const int groupCount = static_cast<int>(multiDrawGroups.GetSize());
+
+    if (groups != nullptr) {
+        for (int i = 0; i < NX_MIN(groupCount, maxGroups); i++) {
+            groups[i].drawCount = static_cast<int>(multiDrawGroups[i].drawCount);
+            groups[i].savedCalls = multiDrawGroups[i].savedCalls;
+        }
+    }
+
+    return groupCount;
+}
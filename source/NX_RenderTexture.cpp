@@ -31,6 +31,7 @@ NX_RenderTexture* NX_CreateRenderTexture(int w, int h)
     NX_RenderTexture* target = INX_Pool.Create<NX_RenderTexture>();
 
     target->color = NX_CreateTexture(w, h, nullptr, NX_PIXEL_FORMAT_RGBA8);
+    target->color->standalone = true;
 
     target->depth = gpu::Texture(
         gpu::TextureConfig
@@ -9,6 +9,8 @@
 #include <NX/NX_Runtime.h>
 
 #include "./INX_GlobalState.hpp"
+#include "./INX_AssetLoader.hpp"
+#include "./NX_Render2D.hpp"
 
 #include <SDL3/SDL_events.h>
 #include <SDL3/SDL_stdinc.h>
@@ -27,6 +29,9 @@ bool NX_FrameStep(void)
 
     static bool firstFrame = true;
 
+    // Fences the 2D streaming segments written during the frame
+    INX_Render2DState_EndFrame();
+
     if (!firstFrame) {
         SDL_GL_SwapWindow(INX_Display.window);
     }
@@ -60,6 +65,22 @@ bool NX_FrameStep(void)
     double currentFPS = 1.0 / INX_Frame.currentDeltaTime;
     INX_Frame.fpsAverage = INX_Frame.fpsAverage * (1.0 - smoothingFactor) + currentFPS * smoothingFactor;
 
+    /* --- Reset per-frame counters --- */
+
+    INX_Frame.lastTextureBinds = INX_Frame.textureBinds;
+    INX_Frame.textureBinds = 0;
+
+    INX_Frame.lastRender2D = INX_Frame.render2D;
+    INX_Frame.render2D.flushes = 0;
+    INX_Frame.render2D.drawCalls = 0;
+    INX_Frame.render2D.vertices = 0;
+    INX_Frame.render2D.indices = 0;
+    INX_Frame.render2D.sprites = 0;
+
+    /* --- Create the GPU resources of assets loaded in the background --- */
+
+    INX_AssetLoads.Update();
+
     /* --- Update input state --- */
 
     // Shift current >> previous key state
@@ -185,6 +206,11 @@ int NX_GetFPS(void)
     return static_cast<int>(INX_Frame.fpsAverage + 0.5f);
 }
 
+int NX_GetTextureBindCount(void)
+{
+    return static_cast<int>(INX_Frame.lastTextureBinds);
+}
+
 void NX_SetTargetFPS(int fps)
 {
     INX_Frame.targetDeltaTime = 1.0 / static_cast<double>(fps);
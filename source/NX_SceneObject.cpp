@@ -0,0 +1,255 @@
+/* NX_SceneObject.cpp -- API definition for Nexium's retained scene object module
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#include "./NX_SceneObject.hpp"
+
+#include <NX/NX_Log.h>
+
+#include "./INX_TextureResidency.hpp"
+#include "./INX_GlobalPool.hpp"
+#include <algorithm>
+
+// ============================================================================
+// GLOBAL STATE
+// ============================================================================
+
+INX_SceneObjectStore INX_SceneObjects{};
+
+// ============================================================================
+// OPAQUE IMPLEMENTATION
+// ============================================================================
+
+NX_SceneObject::NX_SceneObject(const NX_Mesh* mesh, const NX_Material& material)
+    : mesh(mesh), material(material)
+{
+    slot = INX_SceneObjects.Acquire(this);
+}
+
+NX_SceneObject::~NX_SceneObject()
+{
+    if (slot >= 0) {
+        INX_SceneObjects.Release(slot);
+    }
+}
+
+// ============================================================================
+// STORE IMPLEMENTATION
+// ============================================================================
+
+int INX_SceneObjectStore::Acquire(NX_SceneObject* object)
+{
+    int slot = -1;
+
+    if (!freeSlots.IsEmpty()) {
+        slot = *freeSlots.GetBack();
+        freeSlots.PopBack();
+    }
+    else {
+        slot = GetSlotCount();
+        bool ok = objects.PushBack(nullptr)
+               && transforms.PushBack(NX_TRANSFORM_IDENTITY)
+               && bounds.EmplaceBack() != nullptr
+               && cullBoxes.Push(NX_BoundingBox3D{})
+               && layerMasks.PushBack(0)
+               && states.PushBack(0)
+               && treeProxies.PushBack(INX_AabbTree::NullNode)
+               && gpuShared.EmplaceBack() != nullptr
+               && gpuUnique.EmplaceBack() != nullptr;
+        if (!ok) {
+            NX_LOG(E, "RENDER: Failed to allocate a scene object slot (requested: %i slots)", slot + 1);
+            return -1;
+        }
+    }
+
+    objects[slot] = object;
+    transforms[slot] = NX_TRANSFORM_IDENTITY;
+    layerMasks[slot] = object->mesh->layerMask;
+    states[slot] = (states[slot] & SLOT_DIRTY) | SLOT_ALIVE | SLOT_ACTIVE;
+
+    bounds[slot] = INX_OrientedBoundingBox3D(object->mesh->aabb, transforms[slot]);
+    NX_BoundingBox3D aabb = bounds[slot].GetAabb();
+    cullBoxes.Set(slot, aabb);
+    treeProxies[slot] = tree.CreateProxy(aabb, slot);
+    MarkDirty(slot, SLOT_DIRTY);
+
+    ++aliveCount;
+
+    return slot;
+}
+
+void INX_SceneObjectStore::Release(int slot)
+{
+    // The slot may still be in the dirty list, 'PackDirty' skips dead slots
+    objects[slot] = nullptr;
+    states[slot] &= SLOT_DIRTY;
+
+    if (treeProxies[slot] != INX_AabbTree::NullNode) {
+        tree.DestroyProxy(treeProxies[slot]);
+        treeProxies[slot] = INX_AabbTree::NullNode;
+    }
+
+    freeSlots.PushBack(slot);
+    --aliveCount;
+}
+
+void INX_SceneObjectStore::SetTransform(int slot, const NX_Transform& transform)
+{
+    transforms[slot] = transform;
+    UpdateBounds(slot);
+    MarkDirty(slot, SLOT_DIRTY_SHARED);
+}
+
+void INX_SceneObjectStore::SetLayerMask(int slot, NX_Layer layerMask)
+{
+    layerMasks[slot] = layerMask;
+    MarkDirty(slot, SLOT_DIRTY_UNIQUE);
+}
+
+void INX_SceneObjectStore::UpdateBounds(int slot)
+{
+    bounds[slot] = INX_OrientedBoundingBox3D(objects[slot]->mesh->aabb, transforms[slot]);
+    NX_BoundingBox3D aabb = bounds[slot].GetAabb();
+    cullBoxes.Set(slot, aabb);
+
+    if (treeProxies[slot] != INX_AabbTree::NullNode) {
+        tree.MoveProxy(treeProxies[slot], aabb);
+    }
+}
+
+void INX_SceneObjectStore::MarkAllDirty()
+{
+    for (int slot = 0; slot < GetSlotCount(); slot++) {
+        if (states[slot] & SLOT_ALIVE) {
+            MarkDirty(slot, SLOT_DIRTY);
+        }
+    }
+}
+
+void INX_SceneObjectStore::PackDirty()
+{
+    size_t keptCount = 0;
+
+    for (size_t i = 0; i < dirtySlots.GetSize(); i++)
+    {
+        int slot = dirtySlots[i];
+        uint8_t& state = states[slot];
+
+        // Slots released since they were flagged have nothing to upload
+        if ((state & SLOT_ALIVE) == 0) {
+            state = 0;
+            continue;
+        }
+
+        if (state & SLOT_DIRTY_SHARED) {
+            INX_PackDrawShared(&gpuShared[slot], transforms[slot], -1, 0);
+        }
+
+        if (state & SLOT_DIRTY_UNIQUE) {
+            INX_PackDrawUnique(
+                &gpuUnique[slot], objects[slot]->material, layerMasks[slot],
+                INX_ResolveMaterialTextures(objects[slot]->material)
+            );
+        }
+
+        state &= ~SLOT_DIRTY;
+        dirtySlots[keptCount++] = slot;
+    }
+
+    dirtySlots.Resize(keptCount);
+
+    // Sorted so that the upload can merge neighboring slots
+    std::sort(dirtySlots.GetData(), dirtySlots.GetData() + dirtySlots.GetSize());
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+NX_SceneObject* NX_CreateSceneObject(const NX_Mesh* mesh, const NX_Material* material)
+{
+    if (mesh == nullptr) {
+        NX_LOG(E, "RENDER: Failed to create scene object; Mesh cannot be null");
+        return nullptr;
+    }
+
+    NX_SceneObject* object = INX_Pool.Create<NX_SceneObject>(
+        mesh, material ? *material : NX_GetDefaultMaterial()
+    );
+
+    if (object != nullptr && object->slot < 0) {
+        INX_Pool.Destroy(object);
+        return nullptr;
+    }
+
+    return object;
+}
+
+void NX_DestroySceneObject(NX_SceneObject* object)
+{
+    INX_Pool.Destroy(object);
+}
+
+bool NX_IsSceneObjectActive(const NX_SceneObject* object)
+{
+    return INX_SceneObjects.states[object->slot] & INX_SceneObjectStore::SLOT_ACTIVE;
+}
+
+void NX_SetSceneObjectActive(NX_SceneObject* object, bool active)
+{
+    uint8_t& state = INX_SceneObjects.states[object->slot];
+    state = active
+        ? (state | INX_SceneObjectStore::SLOT_ACTIVE)
+        : (state & ~INX_SceneObjectStore::SLOT_ACTIVE);
+}
+
+const NX_Mesh* NX_GetSceneObjectMesh(const NX_SceneObject* object)
+{
+    return object->mesh;
+}
+
+void NX_SetSceneObjectMesh(NX_SceneObject* object, const NX_Mesh* mesh)
+{
+    if (mesh == nullptr) {
+        NX_LOG(W, "RENDER: Cannot assign a null mesh to a scene object");
+        return;
+    }
+
+    object->mesh = mesh;
+    INX_SceneObjects.UpdateBounds(object->slot);
+}
+
+NX_Material NX_GetSceneObjectMaterial(const NX_SceneObject* object)
+{
+    return object->material;
+}
+
+void NX_SetSceneObjectMaterial(NX_SceneObject* object, const NX_Material* material)
+{
+    object->material = material ? *material : NX_GetDefaultMaterial();
+    INX_SceneObjects.MarkDirty(object->slot, INX_SceneObjectStore::SLOT_DIRTY_UNIQUE);
+}
+
+NX_Transform NX_GetSceneObjectTransform(const NX_SceneObject* object)
+{
+    return INX_SceneObjects.transforms[object->slot];
+}
+
+void NX_SetSceneObjectTransform(NX_SceneObject* object, const NX_Transform* transform)
+{
+    INX_SceneObjects.SetTransform(object->slot, *transform);
+}
+
+NX_Layer NX_GetSceneObjectLayerMask(const NX_SceneObject* object)
+{
+    return INX_SceneObjects.layerMasks[object->slot];
+}
+
+void NX_SetSceneObjectLayerMask(NX_SceneObject* object, NX_Layer layers)
+{
+    INX_SceneObjects.SetLayerMask(object->slot, layers);
+}
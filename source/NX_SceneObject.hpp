@@ -0,0 +1,151 @@
+/* NX_SceneObject.hpp -- API definition for Nexium's retained scene object module
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef NX_SCENE_OBJECT_HPP
+#define NX_SCENE_OBJECT_HPP
+
+#include <NX/NX_SceneObject.h>
+#include <NX/NX_Math.h>
+
+#include "./Detail/Util/DynamicArray.hpp"
+#include "./INX_DrawPacking.hpp"
+#include "./INX_AabbTree.hpp"
+#include "./NX_Shape.hpp"
+
+// ============================================================================
+// OPAQUE DEFINITION
+// ============================================================================
+
+/**
+ * Holds the data only needed when the object is drawn.
+ * Everything touched by culling, sorting and uploads lives in the
+ * slot of 'INX_SceneObjects' referenced by 'slot'.
+ */
+struct NX_SceneObject {
+    NX_SceneObject(const NX_Mesh* mesh, const NX_Material& material);
+    ~NX_SceneObject();
+
+    const NX_Mesh* mesh{};
+    NX_Material material{};
+    int slot{-1};
+};
+
+// ============================================================================
+// SCENE OBJECT STORE
+// ============================================================================
+
+/**
+ * Structure of arrays indexed by slot, slots are stable for the whole lifetime
+ * of an object and are recycled once it is destroyed.
+ *
+ * The GPU records of each slot are kept packed on the CPU side, setters only
+ * flag the slot, and 'PackDirty' repacks flagged slots once before upload.
+ *
+ * Every alive slot also owns a leaf in 'tree', moved along with its bounds,
+ * so that render passes can cull the whole set hierarchically.
+ */
+struct INX_SceneObjectStore {
+    /** Slot state bits */
+    static constexpr uint8_t SLOT_ALIVE         = 1 << 0;
+    static constexpr uint8_t SLOT_ACTIVE        = 1 << 1;
+    static constexpr uint8_t SLOT_DIRTY_SHARED  = 1 << 2;
+    static constexpr uint8_t SLOT_DIRTY_UNIQUE  = 1 << 3;
+
+    static constexpr uint8_t SLOT_VISIBLE = SLOT_ALIVE | SLOT_ACTIVE;
+    static constexpr uint8_t SLOT_DIRTY = SLOT_DIRTY_SHARED | SLOT_DIRTY_UNIQUE;
+
+    /** Slots management */
+    int Acquire(NX_SceneObject* object);
+    void Release(int slot);
+    int GetSlotCount() const;
+
+    /** Updates */
+    void SetTransform(int slot, const NX_Transform& transform);
+    void SetLayerMask(int slot, NX_Layer layerMask);
+    void UpdateBounds(int slot);
+    void MarkDirty(int slot, uint8_t dirtyBits);
+    void MarkAllDirty();
+
+    /** Packing, calls 'func(firstSlot, slotCount)' for each run of slots to upload */
+    template <typename F>
+    void FlushDirty(F&& func);
+
+    /** Per slot data */
+    util::DynamicArray<NX_SceneObject*> objects{};
+    util::DynamicArray<NX_Transform> transforms{};
+    util::DynamicArray<INX_OrientedBoundingBox3D> bounds{};     //< World space, updated with the transform or the mesh
+    INX_BoxBatch cullBoxes{};                                   //< World space box enclosing 'bounds', for batch culling
+    util::DynamicArray<NX_Layer> layerMasks{};
+    util::DynamicArray<uint8_t> states{};
+    util::DynamicArray<int> treeProxies{};                      //< Leaf of the slot in 'tree'
+
+    /** Packed GPU records per slot */
+    util::DynamicArray<INX_GPUDrawShared> gpuShared{};
+    util::DynamicArray<INX_GPUDrawUnique> gpuUnique{};
+
+    /** Hierarchy over the world space bounds of alive slots */
+    INX_AabbTree tree{};
+
+    /** Slot lists */
+    util::DynamicArray<int> dirtySlots{};
+    util::DynamicArray<int> freeSlots{};
+    int aliveCount{};
+
+    /** Material texture generation the unique records were packed with, see INX_TextureResidency */
+    uint32_t textureGeneration{};
+
+private:
+    void PackDirty();
+};
+
+extern INX_SceneObjectStore INX_SceneObjects;
+
+// ============================================================================
+// INLINE IMPLEMENTATION
+// ============================================================================
+
+inline int INX_SceneObjectStore::GetSlotCount() const
+{
+    return static_cast<int>(states.GetSize());
+}
+
+inline void INX_SceneObjectStore::MarkDirty(int slot, uint8_t dirtyBits)
+{
+    if ((states[slot] & SLOT_DIRTY) == 0) {
+        dirtySlots.PushBack(slot);
+    }
+    states[slot] |= dirtyBits;
+}
+
+template <typename F>
+void INX_SceneObjectStore::FlushDirty(F&& func)
+{
+    // Runs separated by only a few clean slots are merged, re-uploading
+    // a handful of unchanged records is cheaper than an extra upload call
+    constexpr int maxGap = 8;
+
+    if (dirtySlots.IsEmpty()) {
+        return;
+    }
+
+    PackDirty();
+
+    size_t i = 0;
+    while (i < dirtySlots.GetSize()) {
+        int first = dirtySlots[i];
+        int last = first;
+        while (++i < dirtySlots.GetSize() && dirtySlots[i] - last <= maxGap) {
+            last = dirtySlots[i];
+        }
+        func(first, last - first + 1);
+    }
+
+    dirtySlots.Clear();
+}
+
+#endif // NX_SCENE_OBJECT_HPP
@@ -10,11 +10,13 @@
 
 #include <NX/NX_Filesystem.h>
 
+#include "./INX_ProgramBinaryCache.hpp"
 #include "./INX_AssetDecoder.hpp"
 #include "./INX_GlobalPool.hpp"
 
 #include <shaders/shape.vert.h>
 #include <shaders/shape.frag.h>
+#include <shaders/sprite.vert.h>
 
 // ============================================================================
 // OPAQUE DEFINITION
@@ -22,23 +24,27 @@
 
 NX_Shader2D::NX_Shader2D()
 {
-    /* --- Compile shaders --- */
+    /* --- Build shader stages, compiled only on cache misses --- */
 
     INX_ShaderDecoder vertCode(SHAPE_VERT, SHAPE_VERT_SIZE);
+    INX_ShaderDecoder vertSpriteCode(SPRITE_VERT, SPRITE_VERT_SIZE);
     INX_ShaderDecoder fragCode(SHAPE_FRAG, SHAPE_FRAG_SIZE);
 
-    gpu::Shader vertShape(GL_VERTEX_SHADER, vertCode);
-    gpu::Shader fragShapeColor(GL_FRAGMENT_SHADER, fragCode, {"SHAPE_COLOR"});
-    gpu::Shader fragShapeTexture(GL_FRAGMENT_SHADER, fragCode, {"SHAPE_TEXTURE"});
-    gpu::Shader fragTextBitmap(GL_FRAGMENT_SHADER, fragCode, {"TEXT_BITMAP"});
-    gpu::Shader fragTextSDF(GL_FRAGMENT_SHADER, fragCode, {"TEXT_SDF"});
-
-    /* --- Link all programs --- */
-
-    mPrograms[Variant::SHAPE_COLOR]   = gpu::Program(vertShape, fragShapeColor);
-    mPrograms[Variant::SHAPE_TEXTURE] = gpu::Program(vertShape, fragShapeTexture);
-    mPrograms[Variant::TEXT_BITMAP]   = gpu::Program(vertShape, fragTextBitmap);
-    mPrograms[Variant::TEXT_SDF]      = gpu::Program(vertShape, fragTextSDF);
+    INX_ProgramStage vertShape(GL_VERTEX_SHADER, vertCode);
+    INX_ProgramStage vertSprite(GL_VERTEX_SHADER, vertSpriteCode);
+    INX_ProgramStage fragShapeColor(GL_FRAGMENT_SHADER, fragCode, {"SHAPE_COLOR"});
+    INX_ProgramStage fragShapeTexture(GL_FRAGMENT_SHADER, fragCode, {"SHAPE_TEXTURE"});
+    INX_ProgramStage fragTextBitmap(GL_FRAGMENT_SHADER, fragCode, {"TEXT_BITMAP"});
+    INX_ProgramStage fragTextSDF(GL_FRAGMENT_SHADER, fragCode, {"TEXT_SDF"});
+
+    /* --- Load or link all programs --- */
+
+    mPrograms[Variant::SHAPE_COLOR]    = INX_ProgramBinaries.CreateProgram(vertShape, fragShapeColor);
+    mPrograms[Variant::SHAPE_TEXTURE]  = INX_ProgramBinaries.CreateProgram(vertShape, fragShapeTexture);
+    mPrograms[Variant::TEXT_BITMAP]    = INX_ProgramBinaries.CreateProgram(vertShape, fragTextBitmap);
+    mPrograms[Variant::TEXT_SDF]       = INX_ProgramBinaries.CreateProgram(vertShape, fragTextSDF);
+    mPrograms[Variant::SPRITE_COLOR]   = INX_ProgramBinaries.CreateProgram(vertSprite, fragShapeColor);
+    mPrograms[Variant::SPRITE_TEXTURE] = INX_ProgramBinaries.CreateProgram(vertSprite, fragShapeTexture);
 }
 
 NX_Shader2D::NX_Shader2D(const char* vert, const char* frag)
@@ -51,6 +57,7 @@ NX_Shader2D::NX_Shader2D(const char* vert, const char* frag)
     /* --- Prepare base sources --- */
 
     util::String vertCode = INX_ShaderDecoder(SHAPE_VERT, SHAPE_VERT_SIZE).GetCode();
+    util::String vertSpriteCode = INX_ShaderDecoder(SPRITE_VERT, SPRITE_VERT_SIZE).GetCode();
     util::String fragCode = INX_ShaderDecoder(SHAPE_FRAG, SHAPE_FRAG_SIZE).GetCode();
 
     /* --- Process and insert the user code --- */
@@ -58,6 +65,7 @@ NX_Shader2D::NX_Shader2D(const char* vert, const char* frag)
     if (vert != nullptr) {
         util::String vertUser = ProcessUserCode(vert);
         InsertUserCode(vertCode, vertMarker, vertUser.GetCString());
+        InsertUserCode(vertSpriteCode, vertMarker, vertUser.GetCString());
     }
 
     if (frag != nullptr) {
@@ -65,20 +73,23 @@ NX_Shader2D::NX_Shader2D(const char* vert, const char* frag)
         InsertUserCode(fragCode, fragMarker, fragUser.GetCString());
     }
 
-    /* --- Compile shaders --- */
+    /* --- Build shader stages, compiled only on cache misses --- */
 
-    gpu::Shader vertShape(GL_VERTEX_SHADER, vertCode.GetCString());
-    gpu::Shader fragShapeColor(GL_FRAGMENT_SHADER, fragCode.GetCString(), {"SHAPE_COLOR"});
-    gpu::Shader fragShapeTexture(GL_FRAGMENT_SHADER, fragCode.GetCString(), {"SHAPE_TEXTURE"});
-    gpu::Shader fragTextBitmap(GL_FRAGMENT_SHADER, fragCode.GetCString(), {"TEXT_BITMAP"});
-    gpu::Shader fragTextSDF(GL_FRAGMENT_SHADER, fragCode.GetCString(), {"TEXT_SDF"});
+    INX_ProgramStage vertShape(GL_VERTEX_SHADER, vertCode.GetCString());
+    INX_ProgramStage vertSprite(GL_VERTEX_SHADER, vertSpriteCode.GetCString());
+    INX_ProgramStage fragShapeColor(GL_FRAGMENT_SHADER, fragCode.GetCString(), {"SHAPE_COLOR"});
+    INX_ProgramStage fragShapeTexture(GL_FRAGMENT_SHADER, fragCode.GetCString(), {"SHAPE_TEXTURE"});
+    INX_ProgramStage fragTextBitmap(GL_FRAGMENT_SHADER, fragCode.GetCString(), {"TEXT_BITMAP"});
+    INX_ProgramStage fragTextSDF(GL_FRAGMENT_SHADER, fragCode.GetCString(), {"TEXT_SDF"});
 
-    /* --- Link all programs --- */
+    /* --- Load or link all programs --- */
 
-    mPrograms[Variant::SHAPE_COLOR]   = gpu::Program(vertShape, fragShapeColor);
-    mPrograms[Variant::SHAPE_TEXTURE] = gpu::Program(vertShape, fragShapeTexture);
-    mPrograms[Variant::TEXT_BITMAP]   = gpu::Program(vertShape, fragTextBitmap);
-    mPrograms[Variant::TEXT_SDF]      = gpu::Program(vertShape, fragTextSDF);
+    mPrograms[Variant::SHAPE_COLOR]    = INX_ProgramBinaries.CreateProgram(vertShape, fragShapeColor);
+    mPrograms[Variant::SHAPE_TEXTURE]  = INX_ProgramBinaries.CreateProgram(vertShape, fragShapeTexture);
+    mPrograms[Variant::TEXT_BITMAP]    = INX_ProgramBinaries.CreateProgram(vertShape, fragTextBitmap);
+    mPrograms[Variant::TEXT_SDF]       = INX_ProgramBinaries.CreateProgram(vertShape, fragTextSDF);
+    mPrograms[Variant::SPRITE_COLOR]   = INX_ProgramBinaries.CreateProgram(vertSprite, fragShapeColor);
+    mPrograms[Variant::SPRITE_TEXTURE] = INX_ProgramBinaries.CreateProgram(vertSprite, fragShapeTexture);
 
     /* --- Collect uniform block sizes and setup bindings --- */
 
@@ -26,6 +26,8 @@ struct INX_ShaderTraits<NX_Shader2D> {
         SHAPE_TEXTURE,
         TEXT_BITMAP,
         TEXT_SDF,
+        SPRITE_COLOR,
+        SPRITE_TEXTURE,
         VARIANT_COUNT
     };
 };
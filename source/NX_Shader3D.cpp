@@ -10,9 +10,12 @@
 
 #include <NX/NX_Filesystem.h>
 
+#include "./INX_ProgramBinaryCache.hpp"
 #include "./INX_AssetDecoder.hpp"
 #include "./INX_GlobalPool.hpp"
 
+#include <SDL3/SDL_timer.h>
+
 #include <shaders/scene.vert.h>
 #include <shaders/scene_lit.frag.h>
 #include <shaders/scene_unlit.frag.h>
@@ -24,105 +27,245 @@
 // ============================================================================
 
 NX_Shader3D::NX_Shader3D()
+    : NX_Shader3D(nullptr, nullptr)
+{ }
+
+NX_Shader3D::NX_Shader3D(const char* vert, const char* frag)
 {
-    /* --- Compile shaders --- */
+    static_assert(NX_SHADER3D_VARIANT_COUNT == VariantCount, "NX_SHADER3D_VARIANT_* bits must follow the variants");
+
+    /* --- Process the user code, inserted when a variant is built --- */
+
+    if (vert != nullptr) {
+        mVertUser = ProcessUserCode(vert);
+    }
+
+    if (frag != nullptr) {
+        mFragUser = ProcessUserCode(frag);
+    }
+
+    /* --- Find the uniform blocks, their buffers are created once a variant gives their size --- */
 
-    INX_ShaderDecoder vertSceneCode(SCENE_VERT, SCENE_VERT_SIZE);
-    INX_ShaderDecoder fragLitCode(SCENE_LIT_FRAG, SCENE_LIT_FRAG_SIZE);
-    INX_ShaderDecoder fragUnlitCode(SCENE_UNLIT_FRAG, SCENE_UNLIT_FRAG_SIZE);
-    INX_ShaderDecoder fragPrepassCode(SCENE_PREPASS_FRAG, SCENE_PREPASS_FRAG_SIZE);
-    INX_ShaderDecoder fragShadowCode(SCENE_SHADOW_FRAG, SCENE_SHADOW_FRAG_SIZE);
+    for (int i = 0; i < UNIFORM_COUNT; ++i) {
+        mUniformDeclared[i] = mVertUser.Contains(UniformName[i]) || mFragUser.Contains(UniformName[i]);
+    }
 
-    gpu::Shader vertScene(GL_VERTEX_SHADER, vertSceneCode);
-    gpu::Shader vertShadow(GL_VERTEX_SHADER, vertSceneCode, {"SHADOW"});
-    gpu::Shader fragLitGeneric(GL_FRAGMENT_SHADER, fragLitCode, {"GENERIC"});
-    gpu::Shader fragLitPrepass(GL_FRAGMENT_SHADER, fragLitCode, {"PREPASS"});
-    gpu::Shader fragUnlit(GL_FRAGMENT_SHADER, fragUnlitCode);
-    gpu::Shader fragPrepass(GL_FRAGMENT_SHADER, fragPrepassCode);
-    gpu::Shader fragShadow(GL_FRAGMENT_SHADER, fragShadowCode);
+    /* --- Without bindless, material textures come from arrays unless the user code samples them by name --- */
 
-    /* --- Link all programs --- */
+    constexpr const char* materialSamplers[] = {"uTexAlbedo", "uTexEmission", "uTexORM", "uTexNormal"};
 
-    mPrograms[Variant::LIT_GENERIC] = gpu::Program(vertScene, fragLitGeneric);
-    mPrograms[Variant::LIT_PREPASS] = gpu::Program(vertScene, fragLitPrepass);
-    mPrograms[Variant::UNLIT]       = gpu::Program(vertScene, fragUnlit);
-    mPrograms[Variant::PREPASS]     = gpu::Program(vertScene, fragPrepass);
-    mPrograms[Variant::SHADOW]      = gpu::Program(vertShadow, fragShadow);
+    mMaterialArrays = !gpu::Texture::HasBindless();
+    for (const char* sampler : materialSamplers) {
+        mMaterialArrays = mMaterialArrays && !mVertUser.Contains(sampler) && !mFragUser.Contains(sampler);
+    }
 }
 
-NX_Shader3D::NX_Shader3D(const char* vert, const char* frag)
+void NX_Shader3D::UpdateStaticBuffer(size_t offset, size_t size, const void* data)
+{
+    if (mStaticBuffer.IsValid() || !mUniformDeclared[STATIC_UNIFORM]) {
+        INX_Shader::UpdateStaticBuffer(offset, size, data);
+        return;
+    }
+
+    // No variant compiled yet, the data is uploaded when the buffer is created
+    if (offset + size > mStaticStaging.GetSize() && !mStaticStaging.Resize(offset + size)) {
+        NX_LOG(E, "RENDER: Failed to keep static uniform data (offset=%zu, size=%zu)", offset, size);
+        return;
+    }
+
+    SDL_memcpy(mStaticStaging.GetData() + offset, data, size);
+}
+
+void NX_Shader3D::UpdateDynamicBuffer(size_t size, const void* data)
+{
+    // Sized from the first upload, the per-draw data keeps the same size
+    if (!mDynamicBuffer.buffer.IsValid() && mUniformDeclared[DYNAMIC_UNIFORM] && size > 0) {
+        int alignment = gpu::Pipeline::GetUniformBufferOffsetAlignment();
+        int alignedSize = NX_ALIGN_UP(8 * size, alignment);
+        mDynamicBuffer.buffer = gpu::Buffer(GL_UNIFORM_BUFFER, alignedSize, nullptr, GL_DYNAMIC_DRAW);
+        if (!mDynamicBuffer.ranges.Reserve(8)) {
+            NX_LOG(E, "RENDER: Dynamic uniform buffer range info reservation failed (requested: 8 entries)");
+        }
+    }
+
+    INX_Shader::UpdateDynamicBuffer(size, data);
+}
+
+void NX_Shader3D::Precompile(NX_Shader3DVariants variants, bool background)
+{
+    bool parallel = background && gpu::Program::HasParallelCompile();
+
+    for (int i = 0; i < VariantCount; ++i) {
+        const VariantState& state = mVariants[i];
+        if (!(variants & (1 << i)) || mPrograms[i].IsValid() || state.pending || state.failed) {
+            continue;
+        }
+        if (parallel) BeginVariant(static_cast<Variant>(i));
+        else CompileVariant(static_cast<Variant>(i));
+    }
+}
+
+void NX_Shader3D::PollPrecompile()
+{
+    for (int i = 0; i < VariantCount; ++i) {
+        if (mVariants[i].pending && !mPrograms[i].IsLinkPending()) {
+            FinishVariant(static_cast<Variant>(i));
+        }
+    }
+}
+
+NX_Shader3DStats NX_Shader3D::GetStats() const
+{
+    NX_Shader3DStats stats{};
+
+    for (int i = 0; i < VariantCount; ++i) {
+        const VariantState& state = mVariants[i];
+        if (mPrograms[i].IsValid()) {
+            stats.compiled |= (1 << i);
+            stats.compileTime[i] = state.compileTime;
+            stats.compiledCount++;
+        }
+        else if (state.pending) {
+            stats.pending |= (1 << i);
+        }
+        else if (state.failed) {
+            stats.failed |= (1 << i);
+        }
+    }
+
+    return stats;
+}
+
+void NX_Shader3D::BuildStages(Variant variant, INX_ProgramStage* vert, INX_ProgramStage* frag)
 {
     /* --- Constants --- */
 
     constexpr const char* vertMarker = "#define vertex()";
     constexpr const char* fragMarker = "#define fragment()";
 
-    /* --- Prepare base sources --- */
+    // Material textures are sampled through the handles of the draw records when supported,
+    // otherwise from the material arrays with the layers of the draw records
+    const char* bindless = gpu::Texture::HasBindless() ? "BINDLESS" : nullptr;
+    const char* arrays = mMaterialArrays ? "TEXTURE_ARRAYS" : nullptr;
 
-    util::String vertSceneCode   = INX_ShaderDecoder(SCENE_VERT, SCENE_VERT_SIZE).GetCode();
-    util::String fragLitCode     = INX_ShaderDecoder(SCENE_LIT_FRAG, SCENE_LIT_FRAG_SIZE).GetCode();
-    util::String fragUnlitCode   = INX_ShaderDecoder(SCENE_UNLIT_FRAG, SCENE_UNLIT_FRAG_SIZE).GetCode();
-    util::String fragPrepassCode = INX_ShaderDecoder(SCENE_PREPASS_FRAG, SCENE_PREPASS_FRAG_SIZE).GetCode();
+    /* --- Vertex stage --- */
 
-    /* --- Process and insert the user code --- */
+    util::String vertCode = INX_ShaderDecoder(SCENE_VERT, SCENE_VERT_SIZE).GetCode();
 
-    if (vert != nullptr) {
-        util::String vertUser = ProcessUserCode(vert);
-        InsertUserCode(vertSceneCode, vertMarker, vertUser.GetCString());
+    if (!mVertUser.IsEmpty()) {
+        InsertUserCode(vertCode, vertMarker, mVertUser.GetCString());
     }
 
-    if (frag != nullptr) {
-        util::String fragUser = ProcessUserCode(frag);
-        InsertUserCode(fragLitCode, fragMarker, fragUser.GetCString());
-        InsertUserCode(fragUnlitCode, fragMarker, fragUser.GetCString());
-        InsertUserCode(fragPrepassCode, fragMarker, fragUser.GetCString());
+    *vert = INX_ProgramStage(GL_VERTEX_SHADER, vertCode.GetCString(), {(variant == Variant::SHADOW) ? "SHADOW" : nullptr});
+
+    /* --- Fragment stage --- */
+
+    const char* define = nullptr;
+    util::String fragCode;
+
+    switch (variant) {
+    case Variant::LIT_GENERIC:
+        fragCode = INX_ShaderDecoder(SCENE_LIT_FRAG, SCENE_LIT_FRAG_SIZE).GetCode();
+        define = "GENERIC";
+        break;
+    case Variant::LIT_PREPASS:
+        fragCode = INX_ShaderDecoder(SCENE_LIT_FRAG, SCENE_LIT_FRAG_SIZE).GetCode();
+        define = "PREPASS";
+        break;
+    case Variant::UNLIT:
+        fragCode = INX_ShaderDecoder(SCENE_UNLIT_FRAG, SCENE_UNLIT_FRAG_SIZE).GetCode();
+        break;
+    case Variant::PREPASS:
+        fragCode = INX_ShaderDecoder(SCENE_PREPASS_FRAG, SCENE_PREPASS_FRAG_SIZE).GetCode();
+        break;
+    case Variant::SHADOW:
+    default:
+        fragCode = INX_ShaderDecoder(SCENE_SHADOW_FRAG, SCENE_SHADOW_FRAG_SIZE).GetCode();
+        break;
     }
 
-    /* --- Compile shaders --- */
+    // The shadow fragment stage only writes depth, it has no user entry point
+    if (variant != Variant::SHADOW && !mFragUser.IsEmpty()) {
+        InsertUserCode(fragCode, fragMarker, mFragUser.GetCString());
+    }
 
-    gpu::Shader vertScene(GL_VERTEX_SHADER, vertSceneCode.GetCString());
-    gpu::Shader vertShadow(GL_VERTEX_SHADER, vertSceneCode.GetCString(), {"SHADOW"});
-    gpu::Shader fragLitGeneric(GL_FRAGMENT_SHADER, fragLitCode.GetCString(), {"GENERIC"});
-    gpu::Shader fragLitPrepass(GL_FRAGMENT_SHADER, fragLitCode.GetCString(), {"PREPASS"});
-    gpu::Shader fragUnlit(GL_FRAGMENT_SHADER, fragUnlitCode.GetCString());
-    gpu::Shader fragPrepass(GL_FRAGMENT_SHADER, fragPrepassCode.GetCString());
-    gpu::Shader fragShadow(GL_FRAGMENT_SHADER, INX_ShaderDecoder(SCENE_SHADOW_FRAG, SCENE_SHADOW_FRAG_SIZE));
+    *frag = INX_ProgramStage(GL_FRAGMENT_SHADER, fragCode.GetCString(), {define, bindless, arrays});
+}
 
-    /* --- Link all programs --- */
+void NX_Shader3D::CompileVariant(Variant variant)
+{
+    if (mVariants[variant].pending) {
+        FinishVariant(variant);
+        return;
+    }
 
-    mPrograms[Variant::LIT_GENERIC] = gpu::Program(vertScene, fragLitGeneric);
-    mPrograms[Variant::LIT_PREPASS] = gpu::Program(vertScene, fragLitPrepass);
-    mPrograms[Variant::UNLIT]       = gpu::Program(vertScene, fragUnlit);
-    mPrograms[Variant::PREPASS]     = gpu::Program(vertScene, fragPrepass);
-    mPrograms[Variant::SHADOW]      = gpu::Program(vertShadow, fragShadow);
+    mVariants[variant].beginTicks = SDL_GetPerformanceCounter();
 
-    /* --- Collect uniform block sizes and setup bindings --- */
+    INX_ProgramStage vert, frag;
+    BuildStages(variant, &vert, &frag);
 
-    size_t bufferSize[UNIFORM_COUNT] = {};
-    for (int i = 0; i < VariantCount; ++i) {
-        auto& program = mPrograms[i];
-        for (int j = 0; j < UNIFORM_COUNT; ++j) {
-            int blockIndex = program.GetUniformBlockIndex(UniformName[j]);
-            if (blockIndex < 0) continue;
-            program.SetUniformBlockBinding(blockIndex, UniformBinding[j]);
-            if (bufferSize[j] == 0) {
-                bufferSize[j] = program.GetUniformBlockSize(blockIndex);
-            }
-        }
+    mPrograms[variant] = INX_ProgramBinaries.CreateProgram(vert, frag);
+
+    SetupVariant(variant);
+}
+
+void NX_Shader3D::BeginVariant(Variant variant)
+{
+    VariantState& state = mVariants[variant];
+    state.beginTicks = SDL_GetPerformanceCounter();
+
+    INX_ProgramStage vert, frag;
+    BuildStages(variant, &vert, &frag);
+
+    gpu::Program& program = mPrograms[variant];
+    program = INX_ProgramBinaries.BeginProgram(&state.cacheKey, vert, frag);
+
+    // Programs loaded from the cache are ready immediately
+    state.pending = (program.GetID() != 0 && !program.IsValid());
+    if (!state.pending) {
+        SetupVariant(variant);
     }
+}
+
+void NX_Shader3D::FinishVariant(Variant variant)
+{
+    VariantState& state = mVariants[variant];
+
+    INX_ProgramBinaries.FinishProgram(&mPrograms[variant], state.cacheKey);
+    state.cacheKey = 0;
+    state.pending = false;
+
+    SetupVariant(variant);
+}
+
+void NX_Shader3D::SetupVariant(Variant variant)
+{
+    VariantState& state = mVariants[variant];
+    gpu::Program& program = mPrograms[variant];
 
-    /* --- Allocate uniform buffers --- */
+    state.compileTime = 1000.0f * (SDL_GetPerformanceCounter() - state.beginTicks) / SDL_GetPerformanceFrequency();
 
-    if (bufferSize[STATIC_UNIFORM] > 0) {
-        mStaticBuffer = gpu::Buffer(GL_UNIFORM_BUFFER, bufferSize[STATIC_UNIFORM], nullptr, GL_DYNAMIC_DRAW);
+    if (!program.IsValid()) {
+        NX_LOG(E, "RENDER: Failed to compile 3D shader variant %i; It will not be drawn", variant);
+        state.failed = true;
+        return;
     }
 
-    if (bufferSize[DYNAMIC_UNIFORM] > 0) {
-        int alignment = gpu::Pipeline::GetUniformBufferOffsetAlignment();
-        int alignedSize = NX_ALIGN_UP(8 * bufferSize[DYNAMIC_UNIFORM], alignment);
-        mDynamicBuffer.buffer = gpu::Buffer(GL_UNIFORM_BUFFER, alignedSize, nullptr, GL_DYNAMIC_DRAW);
-        if (!mDynamicBuffer.ranges.Reserve(8)) {
-            NX_LOG(E, "RENDER: Dynamic uniform buffer range info reservation failed (requested: 8 entries)");
+    /* --- Setup bindings, and the static buffer on the first variant declaring it --- */
+
+    for (int i = 0; i < UNIFORM_COUNT; ++i) {
+        int blockIndex = program.GetUniformBlockIndex(UniformName[i]);
+        if (blockIndex < 0) continue;
+        program.SetUniformBlockBinding(blockIndex, UniformBinding[i]);
+        if (i != STATIC_UNIFORM || mStaticBuffer.IsValid()) continue;
+        size_t blockSize = program.GetUniformBlockSize(blockIndex);
+        mStaticBuffer = gpu::Buffer(GL_UNIFORM_BUFFER, blockSize, nullptr, GL_DYNAMIC_DRAW);
+        if (!mStaticStaging.IsEmpty()) {
+            if (mStaticStaging.GetSize() > blockSize) {
+                NX_LOG(E, "RENDER: Static uniform data out of bounds (data=%zu > buffer=%zu)", mStaticStaging.GetSize(), blockSize);
+            }
+            mStaticBuffer.Upload(0, NX_MIN(mStaticStaging.GetSize(), blockSize), mStaticStaging.GetData());
+            mStaticStaging = util::DynamicArray<uint8_t>{};
         }
     }
 }
@@ -168,3 +311,14 @@ void NX_UpdateDynamicShader3DBuffer(NX_Shader3D* shader, size_t size, const void
 {
     shader->UpdateDynamicBuffer(size, data);
 }
+
+void NX_PrecompileShader3D(NX_Shader3D* shader, NX_Shader3DVariants variants, bool background)
+{
+    shader->Precompile(variants, background);
+}
+
+NX_Shader3DStats NX_GetShader3DStats(NX_Shader3D* shader)
+{
+    shader->PollPrecompile();
+    return shader->GetStats();
+}
@@ -9,7 +9,9 @@
 #ifndef NX_RENDER_SHADER_3D_HPP
 #define NX_RENDER_SHADER_3D_HPP
 
+#include "./INX_ProgramBinaryCache.hpp"
 #include "./INX_Shader.hpp"
+#include <NX/NX_Shader3D.h>
 #include <NX/NX_Material.h>
 
 // ============================================================================
@@ -31,6 +33,14 @@ struct INX_ShaderTraits<NX_Shader3D> {
     };
 };
 
+/**
+ * 3D material shader, made of the scene shaders with the user code inserted.
+ *
+ * Variants are compiled on their first use by a draw, or ahead of time with
+ * Precompile(), on the driver threads when parallel compilation is supported.
+ * The uniform buffers are created once a variant declaring them is ready,
+ * static data uploaded before that is kept until then.
+ */
 class NX_Shader3D : public INX_Shader<NX_Shader3D> {
 public:
     using Variant = INX_ShaderTraits<NX_Shader3D>::Variant;
@@ -38,9 +48,69 @@ public:
 public:
     NX_Shader3D(); //< Creates default shader
     NX_Shader3D(const char* vertexCode, const char* fragmentCode);
+
+    /** Get the program of a variant, compiled or completed here if needed */
+    const gpu::Program& GetProgram(Variant variant) const;
     const gpu::Program& GetProgramFromMaterial(const NX_Material& material, bool prepass = false) const;
+
+    /** Uniform buffer uploads, done before the buffers exist when no variant is compiled yet */
+    void UpdateStaticBuffer(size_t offset, size_t size, const void* data);
+    void UpdateDynamicBuffer(size_t size, const void* data);
+
+    /** Compiles a set of variants ahead of time, see NX_PrecompileShader3D() */
+    void Precompile(NX_Shader3DVariants variants, bool background);
+
+    /** Completes the variants compiled in the background that are ready, called once per frame */
+    void PollPrecompile();
+
+    /** Returns the compilation state of the variants */
+    NX_Shader3DStats GetStats() const;
+
+    /** Whether the material textures are sampled from the material arrays, see INX_TextureResidency */
+    bool UsesMaterialArrays() const;
+
+private:
+    struct VariantState {
+        uint64_t cacheKey;      //< Key to store the program once linked, 0 if it is not cached
+        uint64_t beginTicks;    //< Performance counter when the compilation started
+        float compileTime;      //< Milliseconds taken to become ready
+        bool pending;           //< Linking on the driver threads
+        bool failed;            //< Failed to compile, never retried
+    };
+
+private:
+    void BuildStages(Variant variant, INX_ProgramStage* vert, INX_ProgramStage* frag);
+    void CompileVariant(Variant variant);
+    void BeginVariant(Variant variant);
+    void FinishVariant(Variant variant);
+    void SetupVariant(Variant variant);
+
+private:
+    util::String mVertUser{};
+    util::String mFragUser{};
+    std::array<VariantState, VariantCount> mVariants{};
+    std::array<bool, UNIFORM_COUNT> mUniformDeclared{};
+    util::DynamicArray<uint8_t> mStaticStaging{};
+    bool mMaterialArrays{};
 };
 
+inline bool NX_Shader3D::UsesMaterialArrays() const
+{
+    return mMaterialArrays;
+}
+
+inline const gpu::Program& NX_Shader3D::GetProgram(Variant variant) const
+{
+    const gpu::Program& program = mPrograms[variant];
+
+    // Draws only hold const shaders, compiling a variant is their only change to it
+    if (!program.IsValid() && !mVariants[variant].failed) {
+        const_cast<NX_Shader3D*>(this)->CompileVariant(variant);
+    }
+
+    return program;
+}
+
 inline const gpu::Program& NX_Shader3D::GetProgramFromMaterial(const NX_Material& material, bool prepass) const
 {
     Variant variant = Variant::LIT_GENERIC;
@@ -52,7 +122,7 @@ inline const gpu::Program& NX_Shader3D::GetProgramFromMaterial(const NX_Material
         variant = Variant::LIT_PREPASS;
     }
 
-    return INX_Shader::GetProgram(variant);
+    return GetProgram(variant);
 }
 
 #endif // NX_RENDER_SHADER_3D_HPP
@@ -17,6 +17,7 @@
 // ============================================================================
 
 struct INX_BoundingSphere3D {
+    INX_BoundingSphere3D() = default;
     INX_BoundingSphere3D(const NX_BoundingBox3D& aabb, const NX_Transform& transform);
     NX_Vec3 center;
     float radius;
@@ -33,7 +34,9 @@ inline INX_BoundingSphere3D::INX_BoundingSphere3D(const NX_BoundingBox3D& aabb,
 }
 
 struct INX_OrientedBoundingBox3D {
+    INX_OrientedBoundingBox3D() = default;
     INX_OrientedBoundingBox3D(const NX_BoundingBox3D& aabb, const NX_Transform& transform);
+    NX_BoundingBox3D GetAabb() const;
     std::array<NX_Vec3, 3> axes;    // world-space axes, length = scale
     NX_Vec3 center, extents;        // world-space center and local extents
 };
@@ -49,4 +52,16 @@ inline INX_OrientedBoundingBox3D::INX_OrientedBoundingBox3D(const NX_BoundingBox
     this->extents = (aabb.max - aabb.min) * 0.5f;
 }
 
+inline NX_BoundingBox3D INX_OrientedBoundingBox3D::GetAabb() const
+{
+    NX_Vec3 halfSize = NX_Vec3Abs(this->axes[0]) * this->extents.x
+                     + NX_Vec3Abs(this->axes[1]) * this->extents.y
+                     + NX_Vec3Abs(this->axes[2]) * this->extents.z;
+
+    return NX_BoundingBox3D {
+        .min = this->center - halfSize,
+        .max = this->center + halfSize
+    };
+}
+
 #endif // NX_SHAPE_HPP
@@ -0,0 +1,207 @@
+/* NX_TextLayout.cpp -- API definition for Nexium's text layout module
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#include "./NX_TextLayout.hpp"
+
+#include "./INX_GlobalAssets.hpp"
+#include "./INX_GlobalPool.hpp"
+
+#include <NX/NX_Codepoint.h>
+#include <NX/NX_Log.h>
+
+#include <SDL3/SDL_stdinc.h>
+#include <algorithm>
+
+// ============================================================================
+// INTERNAL FUNCTIONS
+// ============================================================================
+
+static void INX_BuildTextLayout(const NX_TextLayout* layout, const NX_Font* font)
+{
+    const NX_Image& atlas = font->glyphs.GetAtlas();
+    const float iwAtlas = 1.0f / atlas.w;
+    const float ihAtlas = 1.0f / atlas.h;
+
+    const float scale = layout->fontSize / font->baseSize;
+    const int count = static_cast<int>(layout->codepoints.GetSize());
+
+    layout->quads.Clear();
+    layout->lines.Clear();
+
+    if (!layout->quads.Reserve(count)) {
+        NX_LOG(E, "RENDER: Failed to allocate text layout quads");
+        return;
+    }
+
+    NX_Vec2 offset = NX_VEC2_ZERO;
+    INX_TextLine line{};
+    float lineWidth = 0.0f;
+    int lineChars = 0;
+
+    float maxWidth = 0.0f;
+    int maxChars = 0;
+
+    // NOTE: Quads are placed like in 'NX_DrawText2D', and the bounds are
+    //       measured like in 'NX_MeasureText', so both stay interchangeable
+
+    auto endLine = [&]() {
+        line.width = lineWidth * scale + (lineChars > 0 ? (lineChars - 1) * layout->spacing.x : 0);
+        layout->lines.PushBack(line);
+        maxWidth = std::max(maxWidth, lineWidth);
+        maxChars = std::max(maxChars, lineChars);
+    };
+
+    for (int i = 0; i < count; i++)
+    {
+        const int codepoint = layout->codepoints[i];
+
+        if (codepoint == '\n') {
+            endLine();
+            line = INX_TextLine { static_cast<int>(layout->quads.GetSize()), 0, 0.0f };
+            lineWidth = 0.0f, lineChars = 0;
+            offset.y += (layout->fontSize + layout->spacing.y);
+            offset.x = 0.0f;
+            continue;
+        }
+
+        const INX_Glyph& glyph = INX_GetFontGlyph(font, codepoint);
+
+        if (codepoint != ' ' && codepoint != '\t') {
+            float x0 = offset.x + glyph.xOffset * scale;
+            float y0 = offset.y + glyph.yOffset * scale;
+            float u0 = glyph.xAtlas * iwAtlas;
+            float v0 = glyph.yAtlas * ihAtlas;
+            layout->quads.PushBack(INX_TextQuad {
+                x0, y0, x0 + glyph.wGlyph * scale, y0 + glyph.hGlyph * scale,
+                u0, v0, u0 + glyph.wGlyph * iwAtlas, v0 + glyph.hGlyph * ihAtlas,
+                codepoint
+            });
+            line.quadCount++;
+        }
+
+        offset.x += ((glyph.xAdvance == 0) ? glyph.wGlyph : glyph.xAdvance) * scale + layout->spacing.x;
+        lineWidth += (glyph.xAdvance > 0) ? glyph.xAdvance : (glyph.wGlyph + glyph.xOffset);
+        lineChars++;
+    }
+
+    endLine();
+
+    layout->size = NX_Vec2 {
+        .x = maxWidth * scale + (maxChars > 0 ? (maxChars - 1) * layout->spacing.x : 0),
+        .y = layout->lines.GetSize() * layout->fontSize + (layout->lines.GetSize() - 1) * layout->spacing.y
+    };
+}
+
+const NX_Font* INX_UpdateTextLayout(const NX_TextLayout* layout)
+{
+    const NX_Font* font = INX_Assets.Select(layout->font, INX_FontAsset::DEFAULT);
+
+    if (!layout->dirty && layout->atlasGeneration == font->glyphs.GetAtlasGeneration()) {
+        return font;
+    }
+
+    // Glyphs rasterized during the build can grow the atlas, moving those
+    // already laid out, in which case we simply go through the text again
+
+    do {
+        layout->atlasGeneration = font->glyphs.GetAtlasGeneration();
+        INX_BuildTextLayout(layout, font);
+    } while (layout->atlasGeneration != font->glyphs.GetAtlasGeneration());
+
+    layout->dirty = false;
+
+    return font;
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+NX_TextLayout* NX_CreateTextLayout(const NX_Font* font, const char* text, float fontSize, NX_Vec2 spacing)
+{
+    NX_TextLayout* layout = INX_Pool.Create<NX_TextLayout>();
+
+    layout->font = font;
+    layout->fontSize = fontSize;
+    layout->spacing = spacing;
+
+    NX_SetTextLayoutText(layout, text);
+
+    return layout;
+}
+
+void NX_DestroyTextLayout(NX_TextLayout* layout)
+{
+    INX_Pool.Destroy(layout);
+}
+
+void NX_SetTextLayoutText(NX_TextLayout* layout, const char* text)
+{
+    text = (text != nullptr) ? text : "";
+
+    if (!layout->text.IsEmpty() && SDL_strcmp(layout->text.GetData(), text) == 0) {
+        return;
+    }
+
+    /* --- Keep a copy of the text to detect changes --- */
+
+    size_t length = SDL_strlen(text);
+
+    if (!layout->text.Resize(length + 1)) {
+        NX_LOG(E, "RENDER: Failed to allocate text layout string");
+        layout->text.Clear();
+        return;
+    }
+
+    SDL_memcpy(layout->text.GetData(), text, length + 1);
+
+    /* --- Decode the codepoints once --- */
+
+    layout->codepoints.Clear();
+    if (!layout->codepoints.Reserve(length)) {
+        NX_LOG(E, "RENDER: Failed to allocate text layout codepoints");
+    }
+
+    for (size_t i = 0; i < length;) {
+        int byteCount = 0;
+        layout->codepoints.PushBack(NX_GetCodepointNext(&text[i], &byteCount));
+        i += byteCount;
+    }
+
+    layout->dirty = true;
+}
+
+void NX_SetTextLayoutFont(NX_TextLayout* layout, const NX_Font* font)
+{
+    layout->dirty |= (layout->font != font);
+    layout->font = font;
+}
+
+void NX_SetTextLayoutFontSize(NX_TextLayout* layout, float fontSize)
+{
+    layout->dirty |= (layout->fontSize != fontSize);
+    layout->fontSize = fontSize;
+}
+
+void NX_SetTextLayoutSpacing(NX_TextLayout* layout, NX_Vec2 spacing)
+{
+    layout->dirty |= (layout->spacing.x != spacing.x || layout->spacing.y != spacing.y);
+    layout->spacing = spacing;
+}
+
+NX_Vec2 NX_GetTextLayoutSize(const NX_TextLayout* layout)
+{
+    INX_UpdateTextLayout(layout);
+    return layout->size;
+}
+
+int NX_GetTextLayoutLineCount(const NX_TextLayout* layout)
+{
+    INX_UpdateTextLayout(layout);
+    return static_cast<int>(layout->lines.GetSize());
+}
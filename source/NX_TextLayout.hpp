@@ -0,0 +1,61 @@
+/* NX_TextLayout.hpp -- API definition for Nexium's text layout module
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef NX_TEXT_LAYOUT_HPP
+#define NX_TEXT_LAYOUT_HPP
+
+#include <NX/NX_TextLayout.h>
+
+#include "./Detail/Util/DynamicArray.hpp"
+#include "./NX_Font.hpp"
+
+// ============================================================================
+// INTERNAL TYPES
+// ============================================================================
+
+/** Glyph quad relative to the layout origin, with its normalized atlas coordinates */
+struct INX_TextQuad {
+    float x0, y0, x1, y1;
+    float u0, v0, u1, v1;
+    int codepoint;              //< Kept for command lists, see 'INX_RecordedGlyph2D'
+};
+
+struct INX_TextLine {
+    int firstQuad;              //< Index of the first quad of the line
+    int quadCount;              //< Number of visible glyphs on the line
+    float width;                //< Width of the line in pixels, spacing included
+};
+
+// ============================================================================
+// OPAQUE DEFINITION
+// ============================================================================
+
+struct NX_TextLayout {
+    /** Source of the layout */
+    util::DynamicArray<char> text{};            //< Copy of the UTF-8 text, null-terminated
+    util::DynamicArray<int> codepoints{};       //< Decoded codepoints of the text
+    const NX_Font* font{};
+    float fontSize{};
+    NX_Vec2 spacing{};
+
+    /** Computed on demand, see 'INX_UpdateTextLayout' */
+    mutable util::DynamicArray<INX_TextQuad> quads{};
+    mutable util::DynamicArray<INX_TextLine> lines{};
+    mutable NX_Vec2 size{};
+    mutable uint32_t atlasGeneration{};         //< Quads are also invalidated when the atlas is grown
+    mutable bool dirty{true};
+};
+
+// ============================================================================
+// INTERNAL FUNCTIONS
+// ============================================================================
+
+/** Computes the layout again if it was invalidated, returns the font it uses */
+const NX_Font* INX_UpdateTextLayout(const NX_TextLayout* layout);
+
+#endif // NX_TEXT_LAYOUT_HPP
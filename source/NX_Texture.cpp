@@ -10,6 +10,7 @@
 #include <NX/NX_Log.h>
 
 #include "./Detail/GPU/Texture.hpp"
+#include "./INX_MaterialArrays.hpp"
 #include "./INX_GlobalPool.hpp"
 #include "./INX_GPUBridge.hpp"
 
@@ -67,6 +68,70 @@ static GLenum INX_GetWrap(NX_TextureWrap wrap)
     return glWrap;
 }
 
+static gpu::Texture& INX_GetEditableGPU(NX_Texture* texture)
+{
+    // The texture object is only needed until the next resolve, which moves the changes back into its layer
+    if (INX_IsTextureLayerOnly(texture)) {
+        INX_MaterialArrays.Extract(*texture);
+    }
+    return texture->gpu;
+}
+
+NX_Texture* INX_CreateMaterialTexture(const NX_Image* image, NX_TextureWrap wrap, NX_TextureFilter filter)
+{
+    if (image == nullptr || !INX_MaterialArrays.IsEnabled()) {
+        return NX_CreateTextureFromImageEx(image, wrap, filter);
+    }
+
+    bool genMipmap = (filter == NX_TEXTURE_FILTER_TRILINEAR);
+    std::pair<GLenum, GLenum> glFilter = INX_GetFilter(filter, genMipmap);
+    GLenum glWrap = INX_GetWrap(wrap);
+
+    NX_Texture* texture = INX_Pool.Create<NX_Texture>();
+    if (texture == nullptr) {
+        return nullptr;
+    }
+
+    bool created = INX_MaterialArrays.Create(
+        *texture,
+        gpu::TextureConfig
+        {
+            .target = GL_TEXTURE_2D,
+            .internalFormat = INX_GPU_GetInternalFormat(image->format, false),
+            .data = image->pixels,
+            .width = image->w,
+            .height = image->h,
+            .depth = 0,
+            .mipmap = genMipmap
+        },
+        gpu::TextureParam
+        {
+            .minFilter = glFilter.first,
+            .magFilter = glFilter.second,
+            .sWrap = glWrap,
+            .tWrap = glWrap,
+            .rWrap = glWrap,
+            .anisotropy = INX_DefaultAnisotropy
+        }
+    );
+
+    if (!created) {
+        INX_Pool.Destroy(texture);
+        return NX_CreateTextureFromImageEx(image, wrap, filter);
+    }
+
+    return texture;
+}
+
+const gpu::Texture& INX_GetTextureGPU(const NX_Texture* texture)
+{
+    texture->standalone = true;
+    if (INX_IsTextureLayerOnly(texture)) {
+        INX_MaterialArrays.Extract(*texture);
+    }
+    return texture->gpu;
+}
+
 // ============================================================================
 // PUBLIC API
 // ============================================================================
@@ -195,20 +260,29 @@ NX_Texture* NX_LoadTextureAsData(const char* filePath)
 
 void NX_DestroyTexture(NX_Texture* texture)
 {
+    if (texture == nullptr || !INX_Pool.ReleaseSharedTexture(texture)) {
+        return;
+    }
+    INX_MaterialArrays.Release(*texture);
     INX_Pool.Destroy(texture);
 }
 
 NX_IVec2 NX_GetTextureSize(const NX_Texture* texture)
 {
+    if (INX_IsTextureLayerOnly(texture)) {
+        return INX_MaterialArrays.GetArray(*texture).GetDimensions();
+    }
     return texture->gpu.GetDimensions();
 }
 
 void NX_SetTextureParameters(NX_Texture* texture, NX_TextureFilter filter, NX_TextureWrap wrap, float anisotropy)
 {
-    std::pair<GLenum, GLenum> glFilter = INX_GetFilter(filter, texture->gpu.HasMipmap());
+    gpu::Texture& gpu = INX_GetEditableGPU(texture);
+
+    std::pair<GLenum, GLenum> glFilter = INX_GetFilter(filter, gpu.HasMipmap());
     GLenum glWrap = INX_GetWrap(wrap);
 
-    texture->gpu.SetParameters({
+    gpu.SetParameters({
         .minFilter = glFilter.first,
         .magFilter = glFilter.second,
         .sWrap = glWrap,
@@ -220,34 +294,44 @@ void NX_SetTextureParameters(NX_Texture* texture, NX_TextureFilter filter, NX_Te
 
 void NX_SetTextureAnisotropy(NX_Texture* texture, float anisotropy)
 {
-    texture->gpu.SetAnisotropy(anisotropy);
+    INX_GetEditableGPU(texture).SetAnisotropy(anisotropy);
 }
 
 void NX_SetTextureFilter(NX_Texture* texture, NX_TextureFilter filter)
 {
-    std::pair<GLenum, GLenum> glFilter = INX_GetFilter(filter, texture->gpu.HasMipmap());
-    texture->gpu.SetFilter(glFilter.first, glFilter.second);
+    gpu::Texture& gpu = INX_GetEditableGPU(texture);
+    std::pair<GLenum, GLenum> glFilter = INX_GetFilter(filter, gpu.HasMipmap());
+    gpu.SetFilter(glFilter.first, glFilter.second);
 }
 
 void NX_SetTextureWrap(NX_Texture* texture, NX_TextureWrap wrap)
 {
     GLenum glWrap = INX_GetWrap(wrap);
-    texture->gpu.SetWrap(glWrap, glWrap, glWrap);
+    INX_GetEditableGPU(texture).SetWrap(glWrap, glWrap, glWrap);
 }
 
 void NX_UploadTexture(NX_Texture* texture, const NX_Image* image)
 {
     NX_Image source = *image;
 
-    NX_PixelFormat texFormat = INX_GPU_GetPixelFormat(texture->gpu.GetInternalFormat());
+    // Textures living in a material array layer are uploaded in place
+    const bool layered = INX_IsTextureLayerOnly(texture);
+    const gpu::Texture& storage = layered ? INX_MaterialArrays.GetArray(*texture) : texture->gpu;
+
+    NX_PixelFormat texFormat = INX_GPU_GetPixelFormat(storage.GetInternalFormat());
 
     if (texFormat != image->format) {
         source = NX_CopyImage(image, texFormat);
     }
 
-    texture->gpu.Upload(image->pixels, 0, 0);
-    if (texture->gpu.HasMipmap()) {
-        texture->gpu.GenerateMipmap();
+    if (layered) {
+        INX_MaterialArrays.Upload(*texture, source.pixels);
+    }
+    else {
+        texture->gpu.Upload(image->pixels, 0, 0);
+        if (texture->gpu.HasMipmap()) {
+            texture->gpu.GenerateMipmap();
+        }
     }
 
     if (source.pixels != image->pixels) {
@@ -257,5 +341,9 @@ void NX_UploadTexture(NX_Texture* texture, const NX_Image* image)
 
 void NX_GenerateMipmap(NX_Texture* texture)
 {
+    // The mipmaps of the array layers are generated with their uploads
+    if (INX_IsTextureLayerOnly(texture)) {
+        return;
+    }
     texture->gpu.GenerateMipmap();
 }
@@ -17,7 +17,36 @@
 // ============================================================================
 
 struct NX_Texture {
-    gpu::Texture gpu;
+    mutable gpu::Texture gpu;   //< Own texture object, empty while the texture only lives in a material array layer
+    uint64_t shareKey{};        //< Non-zero if shared by imported models, see INX_GlobalPool
+    mutable bool standalone{};  //< Used outside of the material arrays, its own texture object is kept
+
+    /** Layer in the material texture arrays, see INX_MaterialArrays */
+    mutable int arrayGroup{-1};
+    mutable int arrayLayer{-1};
+    mutable uint32_t arrayRevision{};
 };
 
+// ============================================================================
+// INTERNAL FUNCTIONS
+// ============================================================================
+
+/** Whether the texture only lives in a material array layer, without texture object of its own */
+bool INX_IsTextureLayerOnly(const NX_Texture* texture);
+
+/** Creates a texture sampled by materials, directly as a layer of the material arrays when they are used */
+NX_Texture* INX_CreateMaterialTexture(const NX_Image* image, NX_TextureWrap wrap, NX_TextureFilter filter);
+
+/** Returns the own texture object, copied out of the material arrays on the first use outside of them */
+const gpu::Texture& INX_GetTextureGPU(const NX_Texture* texture);
+
+// ============================================================================
+// INLINE IMPLEMENTATION
+// ============================================================================
+
+inline bool INX_IsTextureLayerOnly(const NX_Texture* texture)
+{
+    return !texture->gpu.IsValid() && texture->arrayGroup >= 0;
+}
+
 #endif // NX_TEXTURE_HPP
@@ -30,6 +30,10 @@ struct NX_VertexBuffer3D {
     void BindInstances(const NX_InstanceBuffer& instances);
     void UnbindInstances();
 
+    /** Per-draw indices of multi-draw commands, fetched with the base instance of each command */
+    void BindDrawIndices(const gpu::Buffer& drawIndices);
+    void UnbindDrawIndices();
+
     /** Members */
     gpu::VertexArray vao{};
     gpu::Buffer vbo{};
@@ -186,6 +190,19 @@ inline NX_VertexBuffer3D::NX_VertexBuffer3D(const NX_Vertex3D* vertices, int ver
         }
     };
 
+    constexpr gpu::VertexAttribute iDrawIndex {
+        .location = 12,
+        .size = 2,
+        .type = GL_INT,
+        .normalized = false,
+        .stride = sizeof(NX_IVec2),
+        .offset = 0,
+        .divisor = 1,
+        .defaultValue = {
+            .vInt = NX_IVEC4(0, 0, 0, 0),
+        }
+    };
+
     /* --- Create vertex array --- */
 
     vao = gpu::VertexArray(
@@ -238,6 +255,13 @@ inline NX_VertexBuffer3D::NX_VertexBuffer3D(const NX_Vertex3D* vertices, int ver
                 .attributes = {
                     iCustom
                 }
+            },
+            gpu::VertexBufferDesc
+            {
+                .buffer = nullptr,
+                .attributes = {
+                    iDrawIndex
+                }
             }
         }
     );
@@ -298,4 +322,23 @@ inline void NX_VertexBuffer3D::UnbindInstances()
     });
 }
 
+inline void NX_VertexBuffer3D::BindDrawIndices(const gpu::Buffer& drawIndices)
+{
+    // Instance attributes would also be offset by the base instance, they are reset to their default values
+
+    vao.BindVertexBuffers({
+        { 1, nullptr },
+        { 2, nullptr },
+        { 3, nullptr },
+        { 4, nullptr },
+        { 5, nullptr },
+        { 6, &drawIndices }
+    });
+}
+
+inline void NX_VertexBuffer3D::UnbindDrawIndices()
+{
+    vao.UnbindVertexBuffer(6);
+}
+
 #endif // NX_VERTEX_HPP
@@ -0,0 +1,133 @@
+/* bench_animation.hpp -- Synthetic skeletons, animations and players shared by the animation benchmarks
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef NX_BENCH_ANIMATION_HPP
+#define NX_BENCH_ANIMATION_HPP
+
+#include <NX/Nexium.h>
+
+#include "NX_Animation.hpp"
+
+#include <deque>
+#include <vector>
+
+// ============================================================================
+// ANIMATION DATA
+// ============================================================================
+
+/**
+ * Synthetic skeleton and animation library. The skeleton is generated here,
+ * the keys are filled by each bench through 'AddChannel', then the library
+ * is assembled by 'FinishAnimationLib'.
+ */
+struct BenchData {
+    NX_Skeleton skeleton{};
+    NX_AnimationLib animLib{};
+    std::vector<NX_BoneInfo> bones;
+    std::vector<NX_Mat4> boneOffsets;
+    std::vector<NX_Mat4> bindLocal;
+    std::vector<NX_Mat4> bindPose;
+    std::vector<NX_Animation> animations;
+    std::vector<std::vector<NX_AnimationChannel>> channels;
+    std::deque<std::vector<NX_Vec3Key>> vec3Keys;  //< Stable references while growing
+    std::deque<std::vector<NX_QuatKey>> quatKeys;
+};
+
+/** Skeleton made of a few chains under a root, with 'animCount' empty animations */
+inline void GenSkeleton(BenchData* data, int boneCount, int animCount)
+{
+    data->bones.resize(boneCount);
+    data->boneOffsets.resize(boneCount);
+    data->bindLocal.resize(boneCount);
+    data->bindPose.resize(boneCount);
+
+    for (int i = 0; i < boneCount; i++) {
+        data->bones[i].parent = (i == 0) ? -1 : (i % 8 == 1) ? 0 : i - 1;
+        data->bindLocal[i] = NX_Mat4Translate(NX_VEC3(0.0f, 0.1f, 0.0f));
+        data->bindPose[i] = (i == 0) ? data->bindLocal[0] : NX_Mat4Mul(&data->bindLocal[i], &data->bindPose[data->bones[i].parent]);
+        data->boneOffsets[i] = NX_Mat4Inverse(&data->bindPose[i]);
+    }
+
+    data->skeleton.bones = data->bones.data();
+    data->skeleton.boneCount = boneCount;
+    data->skeleton.boneOffsets = data->boneOffsets.data();
+    data->skeleton.bindLocal = data->bindLocal.data();
+    data->skeleton.bindPose = data->bindPose.data();
+
+    data->animations.assign(animCount, NX_Animation{});
+    data->channels.assign(animCount, {});
+}
+
+/** Adds a channel to an animation, with room for the given number of keys per track */
+inline NX_AnimationChannel& AddChannel(BenchData* data, int anim, int boneIndex,
+                                       uint32_t positionCount, uint32_t rotationCount, uint32_t scaleCount)
+{
+    NX_AnimationChannel& channel = data->channels[anim].emplace_back();
+
+    channel.positionKeys = (positionCount > 0) ? data->vec3Keys.emplace_back(positionCount).data() : nullptr;
+    channel.rotationKeys = (rotationCount > 0) ? data->quatKeys.emplace_back(rotationCount).data() : nullptr;
+    channel.scaleKeys = (scaleCount > 0) ? data->vec3Keys.emplace_back(scaleCount).data() : nullptr;
+    channel.positionKeyCount = positionCount;
+    channel.rotationKeyCount = rotationCount;
+    channel.scaleKeyCount = scaleCount;
+    channel.boneIndex = boneIndex;
+
+    return channel;
+}
+
+/** Points the animations to their channels and builds the sampling layout of the library */
+inline void FinishAnimationLib(BenchData* data, float duration, float ticksPerSecond)
+{
+    const int animCount = static_cast<int>(data->animations.size());
+
+    for (int a = 0; a < animCount; a++) {
+        NX_Animation& anim = data->animations[a];
+        anim.channels = data->channels[a].data();
+        anim.channelCount = static_cast<uint32_t>(data->channels[a].size());
+        anim.ticksPerSecond = ticksPerSecond;
+        anim.duration = duration;
+        anim.boneCount = data->skeleton.boneCount;
+    }
+
+    data->animLib.animations = data->animations.data();
+    data->animLib.count = animCount;
+    data->animLib.internal = INX_CreateAnimationLibData(&data->animLib);
+}
+
+/**
+ * Players looping every animation from a random start time, within 'maxStartTime'.
+ * Each player blends two animations, or plays a single one when 'blend' is false.
+ * The generator is seeded identically on each call, so that the players of two
+ * calls start identically.
+ */
+inline std::vector<NX_AnimationPlayer*> CreatePlayers(const NX_Skeleton* skeleton, const NX_AnimationLib* animLib,
+                                                      int count, float maxStartTime, bool blend)
+{
+    std::vector<NX_AnimationPlayer*> players(count);
+    NX_RandGen gen = NX_CreateRandGenTemp(42);
+
+    for (int i = 0; i < count; i++) {
+        NX_AnimationPlayer* player = NX_CreateAnimationPlayer(skeleton, animLib);
+        for (int a = 0; a < animLib->count; a++) {
+            player->states[a].loop = true;
+            player->states[a].currentTime = NX_RandRangeFloat(&gen, 0.0f, maxStartTime);
+        }
+        if (blend) {
+            player->states[i % animLib->count].weight = 0.6f;
+            player->states[(i + 1) % animLib->count].weight = 0.4f;
+        }
+        else {
+            player->states[i % animLib->count].weight = 1.0f;
+        }
+        players[i] = player;
+    }
+
+    return players;
+}
+
+#endif // NX_BENCH_ANIMATION_HPP
@@ -0,0 +1,189 @@
+/* bench_animation_compression.cpp -- Headless validation and benchmark of compressed animation clips
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+/*
+ * Builds a synthetic motion capture library, baked at 30 keys per second:
+ * smooth rotations on every bone, a moving root, constant bone offsets and
+ * scales, and a few linear tracks. The library is sampled:
+ *
+ *   - From the full precision layout built when a library is loaded.
+ *   - From the layout produced by 'NX_CompressAnimationLib', with constant
+ *     and linear tracks reduced and the others uniformly quantized.
+ *
+ * Reports the memory of the keys in both cases, the number of tracks of each
+ * kind, the update throughput of players and the largest error on bone origins.
+ */
+
+#include <NX/Nexium.h>
+
+#include "NX_Animation.hpp"
+#include "bench_animation.hpp"
+#include "bench_common.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cmath>
+#include <vector>
+
+// ============================================================================
+// BENCH DATA
+// ============================================================================
+
+static float Wave(float time, const float params[4])
+{
+    return params[0] * std::sin(params[1] * time + params[2]) + params[3] * std::sin(2.7f * params[1] * time);
+}
+
+static void GenData(BenchData* data, int boneCount, int animCount, int keyCount, NX_RandGen* gen)
+{
+    GenSkeleton(data, boneCount, animCount);
+
+    for (int a = 0; a < animCount; a++)
+    {
+        for (int c = 0; c < boneCount; c++)
+        {
+            NX_AnimationChannel& channel = AddChannel(data, a, c, keyCount, keyCount, keyCount);
+
+            NX_Vec3 axis = NX_Vec3Normalize(NX_VEC3(NX_RandFloat(gen) + 0.1f, NX_RandFloat(gen), NX_RandFloat(gen)));
+            float params[4] = {
+                NX_RandRangeFloat(gen, 0.2f, 0.8f), NX_RandRangeFloat(gen, 1.0f, 4.0f),
+                NX_RandRangeFloat(gen, 0.0f, NX_TAU), NX_RandRangeFloat(gen, 0.0f, 0.1f)
+            };
+
+            const bool linearRotation = (c % 16 == 15);
+
+            for (int k = 0; k < keyCount; k++) {
+                float time = k / 30.0f;
+                float angle = linearRotation ? 0.01f * k : Wave(time, params);
+
+                NX_Vec3 position = NX_VEC3(0.0f, 0.1f, 0.0f);
+                if (c == 0) {
+                    position = NX_VEC3(1.5f * time, 0.9f + 0.05f * std::sin(8.0f * time), 0.3f * std::sin(time));
+                }
+
+                channel.positionKeys[k] = NX_Vec3Key { position, 30.0f * time };
+                channel.rotationKeys[k] = NX_QuatKey { NX_QuatFromAxisAngle(axis, angle), 30.0f * time };
+                channel.scaleKeys[k] = NX_Vec3Key { NX_VEC3_ONE, 30.0f * time };
+            }
+        }
+    }
+
+    FinishAnimationLib(data, static_cast<float>(keyCount - 1), 30.0f);
+}
+
+static size_t ChannelKeysSize(const NX_AnimationLib& animLib)
+{
+    size_t size = 0;
+    for (int i = 0; i < animLib.count; i++) {
+        const NX_Animation& anim = animLib.animations[i];
+        for (uint32_t j = 0; j < anim.channelCount; j++) {
+            size += anim.channels[j].positionKeyCount * sizeof(NX_Vec3Key);
+            size += anim.channels[j].rotationKeyCount * sizeof(NX_QuatKey);
+            size += anim.channels[j].scaleKeyCount * sizeof(NX_Vec3Key);
+        }
+    }
+    return size;
+}
+
+// ============================================================================
+// ENTRY POINT
+// ============================================================================
+
+int main(void)
+{
+    const int boneCount = 64;
+    const int animCount = 16;
+    const int keyCount = 301;
+    const int playerCount = 200;
+    const int frameCount = 240;
+    const float tolerance = 1e-3f;
+    const float dt = 1.0f / 60.0f;
+
+    NX_RandGen gen = NX_CreateRandGenTemp(1337);
+
+    BenchData data;
+    GenData(&data, boneCount, animCount, keyCount, &gen);
+
+    /* --- Compression --- */
+
+    // Both libraries share the channels, only their sampling layouts differ
+    const NX_AnimationLib& rawLib = data.animLib;
+    NX_AnimationLib compressedLib = rawLib;
+
+    INX_AnimationLibData* compressed = nullptr;
+    double compressTime = Measure([&]() {
+        compressed = INX_CompressAnimationLibData(&compressedLib, tolerance);
+    });
+
+    if (compressed == nullptr) {
+        return 1;
+    }
+
+    compressedLib.internal = compressed;
+
+    int trackKinds[4] = {}; //< constant, linear, quantized, original
+    for (int i = 0; i < animCount; i++) {
+        for (int j = 0; j < boneCount; j++) {
+            const INX_AnimationTracks& tracks = compressed->clips[i].tracks[j];
+            for (const INX_AnimationTrack* track : { &tracks.translation, &tracks.rotation, &tracks.scale }) {
+                int kind = track->quantized ? 2 : (track->keyCount == 1) ? 0 : (track->keyCount == 2) ? 1 : 3;
+                trackKinds[kind]++;
+            }
+        }
+    }
+
+    // Once compressed, a loaded library no longer keeps the channel keys
+    const size_t rawSize = INX_GetAnimationLibDataSize(rawLib.internal, &rawLib) + ChannelKeysSize(rawLib);
+    const size_t compressedSize = INX_GetAnimationLibDataSize(compressed, &compressedLib);
+
+    /* --- Playback of both layouts --- */
+
+    std::vector<NX_AnimationPlayer*> rawPlayers = CreatePlayers(&data.skeleton, &rawLib, playerCount, 8.0f, false);
+    std::vector<NX_AnimationPlayer*> compressedPlayers = CreatePlayers(&data.skeleton, &compressedLib, playerCount, 8.0f, false);
+
+    double rawTime = 0.0, compressedTime = 0.0;
+    float maxError = 0.0f;
+
+    for (int f = 0; f < frameCount; f++)
+    {
+        rawTime += Measure([&]() {
+            for (NX_AnimationPlayer* player : rawPlayers) NX_UpdateAnimationPlayer(player, dt);
+        });
+        compressedTime += Measure([&]() {
+            for (NX_AnimationPlayer* player : compressedPlayers) NX_UpdateAnimationPlayer(player, dt);
+        });
+
+        for (int i = 0; i < playerCount; i++) {
+            const NX_Mat4* a = rawPlayers[i]->currentPose;
+            const NX_Mat4* b = compressedPlayers[i]->currentPose;
+            for (int j = 0; j < boneCount; j++) {
+                NX_Vec3 pa = NX_VEC3(a[j].a[12], a[j].a[13], a[j].a[14]);
+                NX_Vec3 pb = NX_VEC3(b[j].a[12], b[j].a[13], b[j].a[14]);
+                maxError = std::max(maxError, NX_Vec3Distance(pa, pb));
+            }
+        }
+    }
+
+    const double updates = double(frameCount) * playerCount;
+
+    printf("Animations: %i, bones: %i, keys per track: %i, tolerance: %g\n", animCount, boneCount, keyCount, tolerance);
+    printf("Tracks: %i constant, %i linear, %i quantized, %i original (compressed in %.1f ms)\n",
+           trackKinds[0], trackKinds[1], trackKinds[2], trackKinds[3], compressTime);
+    printf("%-24s | %12s | %14s\n", "layout", "memory (KB)", "updates/s");
+    printf("%-24s | %12.1f | %14.0f\n", "full precision", rawSize / 1024.0, updates / (rawTime / 1000.0));
+    printf("%-24s | %12.1f | %14.0f\n", "compressed", compressedSize / 1024.0, updates / (compressedTime / 1000.0));
+    printf("Memory saved: %.1f%%, max bone origin error: %g\n", 100.0 * (1.0 - double(compressedSize) / rawSize), maxError);
+
+    for (NX_AnimationPlayer* player : rawPlayers) NX_DestroyAnimationPlayer(player);
+    for (NX_AnimationPlayer* player : compressedPlayers) NX_DestroyAnimationPlayer(player);
+
+    INX_DestroyAnimationLibData(rawLib.internal, &rawLib);
+    INX_DestroyAnimationLibData(compressed, &compressedLib);
+
+    return (maxError < 0.01f && compressedSize < rawSize) ? 0 : 1;
+}
@@ -0,0 +1,194 @@
+/* bench_animation_lod.cpp -- Headless validation and benchmark of animation levels of detail
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+/*
+ * Plays a crowd of characters spread in front of a camera, without any GPU work:
+ *
+ *   - At full detail, every pose evaluated on every update.
+ *   - With levels of detail picked by 'NX_SelectAnimationPlayerLOD' from the
+ *     screen size of each character: updated every 2 or 4 frames with
+ *     interpolated poses, the smallest ones with half of their bones.
+ *
+ * Reports the update time of the crowd in both cases and the error of the
+ * interpolated poses against the full detail ones, measured on bone origins.
+ * A player with levels but at level -1 must match the full detail exactly.
+ */
+
+#include <NX/Nexium.h>
+
+#include "NX_Animation.hpp"
+#include "bench_animation.hpp"
+#include "bench_common.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+// ============================================================================
+// BENCH DATA
+// ============================================================================
+
+static void GenData(BenchData* data, int boneCount, int animCount, int keyCount, NX_RandGen* gen)
+{
+    GenSkeleton(data, boneCount, animCount);
+
+    // Smooth motions sampled at 30 keys per second, like baked animations
+    const float duration = (keyCount - 1) / 30.0f;
+
+    for (int a = 0; a < animCount; a++)
+    {
+        for (int c = 0; c < boneCount; c++)
+        {
+            NX_AnimationChannel& channel = AddChannel(data, a, c, keyCount, keyCount, 0);
+
+            NX_Vec3 axis = NX_Vec3Normalize(NX_VEC3(NX_RandFloat(gen) + 0.1f, NX_RandFloat(gen), NX_RandFloat(gen)));
+            float phase = NX_RandRangeFloat(gen, 0.0f, NX_TAU);
+
+            for (int k = 0; k < keyCount; k++) {
+                float time = duration * k / (keyCount - 1);
+                float wave = std::sin(NX_TAU * time / duration + phase);
+                channel.positionKeys[k] = NX_Vec3Key { NX_VEC3(0.02f * wave, 0.1f, 0.0f), 30.0f * time };
+                channel.rotationKeys[k] = NX_QuatKey { NX_QuatFromAxisAngle(axis, 0.6f * wave), 30.0f * time };
+            }
+        }
+    }
+
+    FinishAnimationLib(data, 30.0f * duration, 30.0f);
+}
+
+static std::vector<NX_AnimationPlayer*> CreatePlayers(BenchData* data, int count)
+{
+    return CreatePlayers(&data->skeleton, &data->animLib, count, 2.0f, true);
+}
+
+static float PoseError(const NX_Mat4* a, const NX_Mat4* b, int boneCount)
+{
+    float error = 0.0f;
+    for (int i = 0; i < boneCount; i++) {
+        NX_Vec3 pa = NX_VEC3(a[i].a[12], a[i].a[13], a[i].a[14]);
+        NX_Vec3 pb = NX_VEC3(b[i].a[12], b[i].a[13], b[i].a[14]);
+        error = std::max(error, NX_Vec3Distance(pa, pb));
+    }
+    return error;
+}
+
+// ============================================================================
+// ENTRY POINT
+// ============================================================================
+
+int main(void)
+{
+    const int characterCount = 500;
+    const int boneCount = 64;
+    const int animCount = 4;
+    const int keyCount = 61;
+    const int frameCount = 240;
+    const float dt = 1.0f / 60.0f;
+
+    NX_RandGen gen = NX_CreateRandGenTemp(1337);
+
+    BenchData data;
+    GenData(&data, boneCount, animCount, keyCount, &gen);
+
+    /* --- Crowd spread from 2 to 200 units in front of the camera --- */
+
+    NX_Camera camera = NX_BASE_CAMERA;
+    camera.position = NX_VEC3_ZERO;
+    camera.rotation = NX_QUAT_IDENTITY;
+
+    const NX_BoundingBox3D aabb = { NX_VEC3(-0.5f, 0.0f, -0.5f), NX_VEC3(0.5f, 1.8f, 0.5f) };
+    std::vector<NX_Transform> transforms(characterCount, NX_TRANSFORM_IDENTITY);
+
+    for (int i = 0; i < characterCount; i++) {
+        float distance = 2.0f + 198.0f * std::pow(NX_RandFloat(&gen), 0.5f);
+        transforms[i].translation = NX_VEC3(NX_RandRangeFloat(&gen, -0.5f, 0.5f) * distance, 0.0f, -distance);
+    }
+
+    /* --- Levels: every 2 frames, every 4 frames, every 4 frames with half the bones --- */
+
+    bool halfMask[boneCount];
+    for (int i = 0; i < boneCount; i++) {
+        halfMask[i] = (i % 8 < 4);
+    }
+
+    const NX_AnimationLOD lods[] = {
+        { 0.15f, 2, nullptr },
+        { 0.05f, 4, nullptr },
+        { 0.02f, 4, halfMask },
+    };
+
+    std::vector<NX_AnimationPlayer*> full = CreatePlayers(&data, characterCount);
+    std::vector<NX_AnimationPlayer*> lod = CreatePlayers(&data, characterCount);
+
+    for (NX_AnimationPlayer* player : lod) {
+        NX_SetAnimationPlayerLODs(player, lods, 3);
+    }
+
+    int levelCounts[4] = {};
+    for (int i = 0; i < characterCount; i++) {
+        levelCounts[1 + NX_SelectAnimationPlayerLOD(lod[i], &camera, &aabb, &transforms[i])]++;
+    }
+
+    /* --- Update both crowds, measuring the error of interpolated poses --- */
+
+    double fullTime = 0.0, lodTime = 0.0;
+    float maxError[4] = {};
+    bool fullDetailExact = true;
+
+    for (int f = 0; f < frameCount; f++)
+    {
+        fullTime += Measure([&]() {
+            for (NX_AnimationPlayer* player : full) NX_UpdateAnimationPlayer(player, dt);
+        });
+        lodTime += Measure([&]() {
+            for (NX_AnimationPlayer* player : lod) NX_UpdateAnimationPlayer(player, dt);
+        });
+
+        for (int i = 0; i < characterCount; i++) {
+            int level = NX_GetAnimationPlayerLOD(lod[i]);
+            if (level == 2) continue; //< Masked bones differ by design
+            float error = PoseError(full[i]->currentPose, lod[i]->currentPose, boneCount);
+            maxError[1 + level] = std::max(maxError[1 + level], error);
+            if (level < 0) fullDetailExact &= (error == 0.0f);
+        }
+    }
+
+    /* --- Masked bones keep their bind pose relative to their parent --- */
+
+    bool maskMatch = true;
+    for (int i = 0; i < characterCount; i++) {
+        if (NX_GetAnimationPlayerLOD(lod[i]) != 2) continue;
+        const NX_Mat4* pose = lod[i]->currentPose;
+        for (int b = 1; b < boneCount; b++) {
+            if (halfMask[b]) continue;
+            NX_Mat4 expected = NX_Mat4Mul(&data.bindLocal[b], &pose[data.bones[b].parent]);
+            maskMatch &= (PoseError(&expected, &pose[b], 1) < 1e-5f);
+        }
+    }
+
+    printf("Characters: %i, bones: %i, frames: %i\n", characterCount, boneCount, frameCount);
+    printf("%-24s | %10s | %14s\n", "level", "players", "max error");
+    const char* names[4] = { "full detail", "every 2 updates", "every 4 updates", "every 4, half bones" };
+    for (int l = 0; l < 4; l++) {
+        if (l == 3) printf("%-24s | %10i | %14s\n", names[l], levelCounts[l], maskMatch ? "bind pose" : "MISMATCH");
+        else printf("%-24s | %10i | %14.6f\n", names[l], levelCounts[l], maxError[l]);
+    }
+    printf("%-24s | %10.3f ms/frame\n", "update, full detail", fullTime / frameCount);
+    printf("%-24s | %10.3f ms/frame (%.0f%%)\n", "update, with levels", lodTime / frameCount, 100.0 * lodTime / fullTime);
+
+    for (NX_AnimationPlayer* player : full) NX_DestroyAnimationPlayer(player);
+    for (NX_AnimationPlayer* player : lod) NX_DestroyAnimationPlayer(player);
+
+    INX_DestroyAnimationLibData(data.animLib.internal, &data.animLib);
+
+    bool success = fullDetailExact && maskMatch && maxError[1] < 0.01f && maxError[2] < 0.01f;
+
+    return success ? 0 : 1;
+}
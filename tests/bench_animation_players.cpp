@@ -0,0 +1,139 @@
+/* bench_animation_players.cpp -- Headless validation and benchmark of batched animation player updates
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+/*
+ * Updates from 10 to 10,000 players of a synthetic animation library, without any GPU work:
+ *
+ *   - One by one with 'NX_UpdateAnimationPlayer', followed by the skinning
+ *     matrices computed like the renderer does for each draw.
+ *   - At once with 'NX_UpdateAnimationPlayers' on the job system, the
+ *     players producing their skinning matrices themselves.
+ *
+ * Throughputs are reported in player updates per second. Both paths must
+ * produce identical poses and skinning matrices.
+ */
+
+#include <NX/Nexium.h>
+
+#include "INX_JobSystem.hpp"
+#include "NX_Animation.hpp"
+#include "bench_animation.hpp"
+#include "bench_common.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// ============================================================================
+// BENCH DATA
+// ============================================================================
+
+static void GenData(BenchData* data, int boneCount, int animCount, int keyCount, NX_RandGen* gen)
+{
+    GenSkeleton(data, boneCount, animCount);
+
+    const float duration = 60.0f;
+
+    for (int a = 0; a < animCount; a++) {
+        for (int c = 0; c < boneCount; c++) {
+            NX_AnimationChannel& channel = AddChannel(data, a, c, keyCount, keyCount, 0);
+            for (int k = 0; k < keyCount; k++) {
+                float time = duration * k / (keyCount - 1);
+                NX_Vec3 axis = NX_Vec3Normalize(NX_VEC3(NX_RandFloat(gen) + 0.1f, NX_RandFloat(gen), NX_RandFloat(gen)));
+                channel.positionKeys[k] = NX_Vec3Key { NX_VEC3(NX_RandRangeFloat(gen, -0.1f, 0.1f), 0.1f, 0.0f), time };
+                channel.rotationKeys[k] = NX_QuatKey { NX_QuatFromAxisAngle(axis, NX_RandRangeFloat(gen, -1.0f, 1.0f)), time };
+            }
+        }
+    }
+
+    FinishAnimationLib(data, duration, 30.0f);
+}
+
+static std::vector<NX_AnimationPlayer*> CreatePlayers(BenchData* data, int count, bool skinning)
+{
+    std::vector<NX_AnimationPlayer*> players = CreatePlayers(&data->skeleton, &data->animLib, count, 2.0f, true);
+
+    for (NX_AnimationPlayer* player : players) {
+        NX_SetAnimationPlayerSkinning(player, skinning);
+    }
+
+    return players;
+}
+
+// ============================================================================
+// ENTRY POINT
+// ============================================================================
+
+int main(void)
+{
+    const int boneCount = 64;
+    const int animCount = 4;
+    const int keyCount = 31;
+    const int updatesPerCase = 40000;
+    const float dt = 1.0f / 60.0f;
+
+    if (!INX_Jobs.Init(-1)) {
+        return 1;
+    }
+
+    NX_RandGen gen = NX_CreateRandGenTemp(1337);
+
+    BenchData data;
+    GenData(&data, boneCount, animCount, keyCount, &gen);
+
+    std::vector<NX_Mat4> skinning(boneCount);
+    bool allMatch = true;
+
+    printf("Workers: %i, bones: %i, animations: %i\n", INX_Jobs.GetWorkerCount(), boneCount, animCount);
+    printf("%-8s | %14s | %14s | %8s | %s\n", "players", "serial (up/s)", "batch (up/s)", "speedup", "match");
+
+    for (int playerCount : { 10, 100, 1000, 10000 })
+    {
+        const int frameCount = std::max(updatesPerCase / playerCount, 2);
+
+        std::vector<NX_AnimationPlayer*> serial = CreatePlayers(&data, playerCount, false);
+        std::vector<NX_AnimationPlayer*> batch = CreatePlayers(&data, playerCount, true);
+
+        double serialTime = Measure([&]() {
+            for (int f = 0; f < frameCount; f++) {
+                for (NX_AnimationPlayer* player : serial) {
+                    NX_UpdateAnimationPlayer(player, dt);
+                    NX_Mat4MulBatch(skinning.data(), data.skeleton.boneOffsets, player->currentPose, boneCount);
+                }
+            }
+        });
+
+        double batchTime = Measure([&]() {
+            for (int f = 0; f < frameCount; f++) {
+                NX_UpdateAnimationPlayers(batch.data(), playerCount, dt);
+            }
+        });
+
+        bool match = true;
+        for (int i = 0; i < playerCount && match; i++) {
+            NX_Mat4MulBatch(skinning.data(), data.skeleton.boneOffsets, serial[i]->currentPose, boneCount);
+            match = std::memcmp(serial[i]->currentPose, batch[i]->currentPose, boneCount * sizeof(NX_Mat4)) == 0
+                 && std::memcmp(skinning.data(), batch[i]->skinningPose, boneCount * sizeof(NX_Mat4)) == 0;
+        }
+        allMatch &= match;
+
+        const double updates = double(frameCount) * playerCount;
+        printf("%-8i | %14.0f | %14.0f | %7.2fx | %s\n", playerCount,
+               updates / (serialTime / 1000.0), updates / (batchTime / 1000.0),
+               serialTime / batchTime, match ? "yes" : "NO");
+
+        for (NX_AnimationPlayer* player : serial) NX_DestroyAnimationPlayer(player);
+        for (NX_AnimationPlayer* player : batch) NX_DestroyAnimationPlayer(player);
+    }
+
+    INX_DestroyAnimationLibData(data.animLib.internal, &data.animLib);
+    INX_Jobs.Quit();
+
+    return allMatch ? 0 : 1;
+}
@@ -0,0 +1,292 @@
+/* bench_animation_sampling.cpp -- Headless validation and benchmark of animation pose evaluation
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+/*
+ * Plays a synthetic animation library on many characters, without any GPU work:
+ *
+ *   - With the previous evaluation: for each bone and animation, a linear
+ *     search of the bone channel followed by a binary search of each track.
+ *   - With 'NX_UpdateAnimationPlayer': bone to channel tables, key cursors
+ *     kept between updates and poses blended component by component.
+ *
+ * Channels are stored in a shuffled order, like importers may produce them.
+ * Throughputs are reported in character updates per second; the poses of
+ * both evaluations must match on every frame.
+ */
+
+#include <NX/Nexium.h>
+
+#include "NX_Animation.hpp"
+#include "bench_animation.hpp"
+#include "bench_common.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cmath>
+#include <vector>
+
+// ============================================================================
+// BENCH DATA
+// ============================================================================
+
+static void GenData(BenchData* data, int boneCount, int animCount, int keyCount, NX_RandGen* gen)
+{
+    GenSkeleton(data, boneCount, animCount);
+
+    /* --- Animations, every bone but the last ones animated --- */
+
+    const float duration = 60.0f;
+    const int animatedCount = boneCount - boneCount / 8;
+
+    for (int a = 0; a < animCount; a++)
+    {
+        std::vector<int> order(animatedCount);
+        for (int i = 0; i < animatedCount; i++) order[i] = i;
+        for (int i = animatedCount - 1; i > 0; i--) {
+            std::swap(order[i], order[NX_RandRangeInt(gen, 0, i + 1)]);
+        }
+
+        for (int c = 0; c < animatedCount; c++)
+        {
+            // Some tracks are missing or constant, like in imported files
+            uint32_t counts[3] = {
+                (c % 5 == 0) ? 0u : static_cast<uint32_t>(keyCount),
+                static_cast<uint32_t>(keyCount),
+                (c % 3 == 0) ? 1u : static_cast<uint32_t>(keyCount)
+            };
+
+            NX_AnimationChannel& channel = AddChannel(data, a, order[c], counts[0], counts[1], counts[2]);
+
+            for (uint32_t k = 0; k < counts[0]; k++) {
+                channel.positionKeys[k].time = duration * k / (counts[0] - 1);
+                channel.positionKeys[k].value = NX_VEC3(NX_RandRangeFloat(gen, -0.1f, 0.1f), 0.1f, NX_RandRangeFloat(gen, -0.1f, 0.1f));
+            }
+            for (uint32_t k = 0; k < counts[1]; k++) {
+                channel.rotationKeys[k].time = duration * k / (counts[1] - 1);
+                NX_Vec3 axis = NX_Vec3Normalize(NX_VEC3(NX_RandFloat(gen) + 0.1f, NX_RandFloat(gen), NX_RandFloat(gen)));
+                channel.rotationKeys[k].value = NX_QuatFromAxisAngle(axis, NX_RandRangeFloat(gen, -1.0f, 1.0f));
+            }
+            for (uint32_t k = 0; k < counts[2]; k++) {
+                channel.scaleKeys[k].time = (counts[2] > 1) ? duration * k / (counts[2] - 1) : 0.0f;
+                channel.scaleKeys[k].value = NX_VEC3(1.0f, NX_RandRangeFloat(gen, 0.9f, 1.1f), 1.0f);
+            }
+        }
+    }
+
+    FinishAnimationLib(data, duration, 30.0f);
+}
+
+// ============================================================================
+// PREVIOUS EVALUATION
+// ============================================================================
+
+template <typename T>
+static float FindKeyFrames(const T* keys, uint32_t keyCount, float time, uint32_t* idx0, uint32_t* idx1)
+{
+    if (keyCount == 1 || time <= keys[0].time) {
+        *idx0 = *idx1 = 0;
+        return 0.0f;
+    }
+    if (time >= keys[keyCount - 1].time) {
+        *idx0 = *idx1 = keyCount - 1;
+        return 0.0f;
+    }
+
+    uint32_t left = 0, right = keyCount - 1;
+    while (right - left > 1) {
+        uint32_t mid = (left + right) / 2;
+        if (keys[mid].time <= time) left = mid;
+        else right = mid;
+    }
+
+    *idx0 = left, *idx1 = right;
+    float delta = keys[right].time - keys[left].time;
+    return (delta > 0.0f) ? (time - keys[left].time) / delta : 0.0f;
+}
+
+static NX_Transform InterpolateChannel(const NX_AnimationChannel* channel, float time)
+{
+    NX_Transform result = NX_TRANSFORM_IDENTITY;
+    uint32_t i0, i1;
+
+    if (channel->positionKeyCount > 0) {
+        float t = FindKeyFrames(channel->positionKeys, channel->positionKeyCount, time, &i0, &i1);
+        result.translation = NX_Vec3Lerp(channel->positionKeys[i0].value, channel->positionKeys[i1].value, t);
+    }
+    if (channel->rotationKeyCount > 0) {
+        float t = FindKeyFrames(channel->rotationKeys, channel->rotationKeyCount, time, &i0, &i1);
+        result.rotation = NX_QuatSLerp(channel->rotationKeys[i0].value, channel->rotationKeys[i1].value, t);
+    }
+    if (channel->scaleKeyCount > 0) {
+        float t = FindKeyFrames(channel->scaleKeys, channel->scaleKeyCount, time, &i0, &i1);
+        result.scale = NX_Vec3Lerp(channel->scaleKeys[i0].value, channel->scaleKeys[i1].value, t);
+    }
+
+    return result;
+}
+
+static void ComputePoseReference(const NX_Skeleton& skeleton, const NX_AnimationLib& animLib,
+                                 const NX_AnimationState* states, NX_Mat4* pose)
+{
+    float totalWeight = 0.0f;
+    for (int i = 0; i < animLib.count; i++) {
+        totalWeight += states[i].weight;
+    }
+
+    for (int iBone = 0; iBone < skeleton.boneCount; iBone++)
+    {
+        NX_Transform blended{};
+        bool isAnimated = false;
+
+        for (int iAnim = 0; iAnim < animLib.count; iAnim++)
+        {
+            const NX_Animation& anim = animLib.animations[iAnim];
+            if (states[iAnim].weight <= 0.0f) continue;
+
+            const NX_AnimationChannel* channel = nullptr;
+            for (uint32_t i = 0; i < anim.channelCount && !channel; i++) {
+                if (anim.channels[i].boneIndex == iBone) channel = &anim.channels[i];
+            }
+            if (!channel) continue;
+            isAnimated = true;
+
+            NX_Transform local = InterpolateChannel(channel, states[iAnim].currentTime * anim.ticksPerSecond);
+            float w = states[iAnim].weight / totalWeight;
+
+            blended.translation += local.translation * w;
+            blended.rotation += local.rotation * w;
+            blended.scale += local.scale * w;
+        }
+
+        if (isAnimated) {
+            blended.rotation = NX_QuatNormalize(blended.rotation);
+            pose[iBone] = NX_TransformToMat4(&blended);
+        }
+        else {
+            pose[iBone] = skeleton.bindLocal[iBone];
+        }
+
+        int parent = skeleton.bones[iBone].parent;
+        if (parent >= 0) {
+            pose[iBone] = NX_Mat4Mul(&pose[iBone], &pose[parent]);
+        }
+        else {
+            NX_Mat4 invLocalBind = NX_Mat4Inverse(&skeleton.bindLocal[iBone]);
+            NX_Mat4 parentGlobalScene = NX_Mat4Mul(&invLocalBind, &skeleton.bindPose[iBone]);
+            pose[iBone] = NX_Mat4Mul(&pose[iBone], &parentGlobalScene);
+        }
+    }
+}
+
+static void AdvanceReference(const NX_AnimationLib& animLib, NX_AnimationState* states, float dt)
+{
+    // Same time update as 'NX_UpdateAnimationPlayer'
+    for (int i = 0; i < animLib.count; i++) {
+        const NX_Animation& anim = animLib.animations[i];
+        float duration = anim.duration / anim.ticksPerSecond;
+        states[i].currentTime += dt;
+        if (states[i].currentTime >= duration) {
+            states[i].currentTime = states[i].loop ? std::fmod(states[i].currentTime, duration) : duration;
+        }
+    }
+}
+
+// ============================================================================
+// ENTRY POINT
+// ============================================================================
+
+int main(void)
+{
+    const int characterCount = 200;
+    const int boneCount = 64;
+    const int animCount = 6;
+    const int keyCount = 61;
+    const int frameCount = 240;
+    const float dt = 1.0f / 60.0f;
+
+    NX_RandGen gen = NX_CreateRandGenTemp(1337);
+
+    BenchData data;
+    GenData(&data, boneCount, animCount, keyCount, &gen);
+
+    /* --- Characters, each blending two animations from its own start time --- */
+
+    std::vector<NX_AnimationPlayer*> players(characterCount);
+    std::vector<NX_AnimationState> refStates(characterCount * animCount);
+    std::vector<NX_Mat4> refPoses(characterCount * boneCount);
+
+    for (int c = 0; c < characterCount; c++)
+    {
+        NX_AnimationPlayer* player = NX_CreateAnimationPlayer(&data.skeleton, &data.animLib);
+
+        for (int a = 0; a < animCount; a++) {
+            player->states[a].loop = true;
+            player->states[a].currentTime = NX_RandRangeFloat(&gen, 0.0f, 2.0f);
+        }
+        player->states[c % animCount].weight = 0.7f;
+        player->states[(c + 1) % animCount].weight = 0.3f;
+
+        std::copy(player->states, player->states + animCount, refStates.begin() + c * animCount);
+        players[c] = player;
+    }
+
+    /* --- Poses of both evaluations on every frame --- */
+
+    float maxError = 0.0f;
+
+    for (int f = 0; f < frameCount; f++) {
+        for (int c = 0; c < characterCount; c++) {
+            NX_Mat4* refPose = &refPoses[c * boneCount];
+            NX_AnimationState* states = &refStates[c * animCount];
+            ComputePoseReference(data.skeleton, data.animLib, states, refPose);
+            AdvanceReference(data.animLib, states, dt);
+            NX_UpdateAnimationPlayer(players[c], dt);
+            for (int b = 0; b < boneCount; b++) {
+                for (int i = 0; i < 16; i++) {
+                    maxError = std::max(maxError, std::fabs(refPose[b].a[i] - players[c]->currentPose[b].a[i]));
+                }
+            }
+        }
+    }
+
+    /* --- Throughputs --- */
+
+    double refTime = Measure([&]() {
+        for (int f = 0; f < frameCount; f++) {
+            for (int c = 0; c < characterCount; c++) {
+                NX_AnimationState* states = &refStates[c * animCount];
+                ComputePoseReference(data.skeleton, data.animLib, states, &refPoses[c * boneCount]);
+                AdvanceReference(data.animLib, states, dt);
+            }
+        }
+    });
+
+    double newTime = Measure([&]() {
+        for (int f = 0; f < frameCount; f++) {
+            for (int c = 0; c < characterCount; c++) {
+                NX_UpdateAnimationPlayer(players[c], dt);
+            }
+        }
+    });
+
+    const double updates = double(frameCount) * characterCount;
+
+    printf("Characters: %i, bones: %i, animations: %i, keys per track: %i\n", characterCount, boneCount, animCount, keyCount);
+    printf("%-24s | %12s | %14s | %12s\n", "path", "time (ms)", "updates/s", "ms/frame");
+    printf("%-24s | %12.3f | %14.0f | %12.4f\n", "linear scan + search", refTime, updates / (refTime / 1000.0), refTime / frameCount);
+    printf("%-24s | %12.3f | %14.0f | %12.4f\n", "tables + cursors", newTime, updates / (newTime / 1000.0), newTime / frameCount);
+    printf("Max pose error: %g\n", maxError);
+
+    for (NX_AnimationPlayer* player : players) {
+        NX_DestroyAnimationPlayer(player);
+    }
+
+    INX_DestroyAnimationLibData(data.animLib.internal, &data.animLib);
+
+    return (maxError < 1e-4f) ? 0 : 1;
+}
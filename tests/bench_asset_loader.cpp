@@ -0,0 +1,213 @@
+/* bench_asset_loader.cpp -- Headless validation and benchmark of asynchronous asset loading
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+/*
+ * Loads the test models, images, audio clips and font through the asset loader,
+ * stopping before any GPU or OpenAL work: files are read from the PhysFS search
+ * path and decoded, model meshes are built and font glyphs rasterized, by the job
+ * system workers.
+ *
+ * Every asset is first loaded without workers, which decodes them one after
+ * the other on the calling thread, then with one worker per logical core.
+ * The decoded meshes, images, samples and glyphs must be identical in both runs.
+ *
+ * Reports the time taken to decode the whole set in both cases. Also checks
+ * that requests released while they are still decoding are freed safely.
+ */
+
+#include <NX/Nexium.h>
+
+#include "INX_AssetLoader.hpp"
+#include "INX_JobSystem.hpp"
+#include "NX_Filesystem.hpp"
+#include "NX_Font.hpp"
+#include "bench_common.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+struct Asset {
+    const char* path;
+    NX_AssetRequest::Type type;
+    NX_AssetRequest::Params params;
+};
+
+static const Asset Assets[] = {
+    { "models/CesiumMan.glb", NX_AssetRequest::Type::MODEL },
+    { "models/DamagedHelmet.glb", NX_AssetRequest::Type::MODEL },
+    { "models/MultiUVTest.glb", NX_AssetRequest::Type::MODEL },
+    { "images/spritesheet.png", NX_AssetRequest::Type::TEXTURE },
+    { "images/uv-grid.png", NX_AssetRequest::Type::TEXTURE },
+    { "images/wabbit_alpha.png", NX_AssetRequest::Type::TEXTURE_DATA },
+    { "audio/sine.wav", NX_AssetRequest::Type::AUDIO_CLIP, { .channelCount = 1 } },
+    { "audio/sine.flac", NX_AssetRequest::Type::AUDIO_CLIP, { .channelCount = 1 } },
+    { "audio/sine.mp3", NX_AssetRequest::Type::AUDIO_CLIP, { .channelCount = 1 } },
+    { "audio/sine.ogg", NX_AssetRequest::Type::AUDIO_CLIP, { .channelCount = 1 } },
+    { "fonts/Eater-Regular.ttf", NX_AssetRequest::Type::FONT, { .fontType = NX_FONT_NORMAL, .fontSize = 32 } },
+    { "fonts/Eater-Regular.ttf", NX_AssetRequest::Type::FONT, { .fontType = NX_FONT_SDF, .fontSize = 48 } },
+};
+
+static constexpr int AssetCount = sizeof(Assets) / sizeof(Assets[0]);
+
+static uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+    }
+    return hash;
+}
+
+static uint64_t HashImage(uint64_t hash, const NX_Image& image)
+{
+    hash = HashBytes(hash, &image.w, sizeof(image.w));
+    hash = HashBytes(hash, &image.h, sizeof(image.h));
+    hash = HashBytes(hash, &image.format, sizeof(image.format));
+    if (image.pixels != nullptr) {
+        hash = HashBytes(hash, image.pixels, NX_GetPixelBytes(image.format) * image.w * image.h);
+    }
+    return hash;
+}
+
+/** Digest of everything decoded for a request, 0 if decoding failed */
+static uint64_t HashDecoded(const NX_AssetRequest* request)
+{
+    if (!request->decodeSucceeded) {
+        return 0;
+    }
+
+    uint64_t hash = 0xCBF29CE484222325ull;
+
+    switch (request->type) {
+    case NX_AssetRequest::Type::TEXTURE:
+    case NX_AssetRequest::Type::TEXTURE_DATA:
+        return HashImage(hash, request->image);
+    case NX_AssetRequest::Type::AUDIO_CLIP:
+        hash = HashBytes(hash, &request->audio.sampleRate, sizeof(request->audio.sampleRate));
+        hash = HashBytes(hash, &request->audio.format, sizeof(request->audio.format));
+        return HashBytes(hash, request->audio.pcmData, request->audio.pcmDataSize);
+    case NX_AssetRequest::Type::FONT:
+        for (int i = 0; i < request->glyphFont->glyphs.GetGlyphCount(); i++) {
+            const INX_Glyph& glyph = request->glyphFont->glyphs.GetGlyphs()[i];
+            hash = HashBytes(hash, &glyph.value, offsetof(INX_Glyph, hGlyph) + sizeof(glyph.hGlyph) - offsetof(INX_Glyph, value));
+        }
+        return HashImage(hash, request->glyphFont->glyphs.GetAtlas());
+    case NX_AssetRequest::Type::MODEL:
+        break;
+    }
+
+    const import::ModelData& model = request->model;
+
+    for (size_t i = 0; i < model.meshes.GetSize(); i++) {
+        const NX_MeshData& data = model.meshes[i].data;
+        hash = HashBytes(hash, data.vertices, data.vertexCount * sizeof(NX_Vertex3D));
+        hash = HashBytes(hash, data.indices, data.indexCount * sizeof(uint32_t));
+        hash = HashBytes(hash, &model.meshMaterials[i], sizeof(int));
+    }
+
+    for (size_t i = 0; i < model.materials.GetSize(); i++) {
+        for (const import::ModelData::Image& image : model.materials[i].images) {
+            hash = HashImage(hash, image.image);
+        }
+    }
+
+    return HashBytes(hash, &model.skeleton.boneCount, sizeof(int));
+}
+
+/** Decodes every asset, returns the time taken in milliseconds */
+static double DecodeAll(std::vector<uint64_t>* hashes)
+{
+    NX_AssetRequest* requests[AssetCount]{};
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < AssetCount; i++) {
+        requests[i] = INX_AssetLoads.Load(Assets[i].type, Assets[i].path, nullptr, nullptr, Assets[i].params);
+    }
+
+    for (NX_AssetRequest* request : requests) {
+        if (request) INX_AssetLoads.WaitDecoded(request);
+    }
+
+    double elapsed = Elapsed(start);
+
+    hashes->clear();
+    for (NX_AssetRequest* request : requests) {
+        hashes->push_back(request ? HashDecoded(request) : 0);
+        NX_ReleaseAssetRequest(request);
+    }
+
+    return elapsed;
+}
+
+// ============================================================================
+// ENTRY POINT
+// ============================================================================
+
+int main(void)
+{
+    if (!INX_FilesystemState_Init() || !NX_AddSearchPath(RESOURCES_PATH, true)) {
+        printf("Failed to mount the test resources\n");
+        return 1;
+    }
+
+    INX_AssetLoads.Init(0.0f);
+
+    /* --- Serial and parallel decoding --- */
+
+    std::vector<uint64_t> serial, parallel;
+
+    INX_Jobs.Init(0);
+    double serialMs = DecodeAll(&serial);
+    INX_Jobs.Quit();
+
+    INX_Jobs.Init(-1);
+    int workerCount = INX_Jobs.GetWorkerCount();
+    double parallelMs = DecodeAll(&parallel);
+
+    printf("Decoding\n");
+    {
+        bool allDecoded = true;
+        for (uint64_t hash : serial) allDecoded &= (hash != 0);
+
+        Check(allDecoded, "every model, image, clip and font is decoded");
+        Check(serial == parallel, "workers decode the same assets as the calling thread");
+
+        printf("  %i assets, %.1f ms on the calling thread, %.1f ms with %i workers\n",
+               AssetCount, serialMs, parallelMs, workerCount);
+    }
+
+    /* --- Cancellation --- */
+
+    printf("Cancellation\n");
+    {
+        for (int round = 0; round < 4; round++) {
+            for (const Asset& asset : Assets) {
+                NX_ReleaseAssetRequest(INX_AssetLoads.Load(asset.type, asset.path, nullptr, nullptr, asset.params));
+            }
+        }
+
+        NX_AssetRequest* pending = INX_AssetLoads.Load(Assets[0].type, Assets[0].path, nullptr, nullptr);
+        INX_AssetLoads.Quit();
+
+        Check(pending != nullptr, "pending and released requests are waited for and freed on quit");
+    }
+
+    INX_Jobs.Quit();
+
+    printf("%s\n", Failures ? "FAILED" : "All checks passed");
+
+    return Failures ? 1 : 0;
+}
@@ -0,0 +1,148 @@
+/* bench_audio_streams.cpp -- Headless validation and benchmark of the audio stream scheduler
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+/*
+ * Plays from 1 to 64 looping streams at once through mojoAL on SDL's dummy
+ * audio driver, which consumes audio in real time without any output device.
+ * The streams are generated WAV files loaded with 'NX_LoadAudioStreamFromData'.
+ *
+ * Each count is played with low latency buffering (3 buffers of 1024 frames,
+ * about 64 ms queued) and with the default buffering, while the main thread
+ * stays busy like a game would. Reports the underruns counted by the streams.
+ * Every stream must still be playing at the end of each case.
+ */
+
+#include <NX/Nexium.h>
+
+#include "NX_Audio.hpp"
+
+#include <cstdio>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// WAV GENERATION
+// ============================================================================
+
+static std::vector<uint8_t> GenWav(int sampleRate, int frameCount, float frequency)
+{
+    const uint32_t dataSize = frameCount * 2 * sizeof(int16_t);
+    std::vector<uint8_t> wav(44 + dataSize);
+    uint8_t* p = wav.data();
+
+    auto put32 = [&p](uint32_t v) { std::memcpy(p, &v, 4); p += 4; };
+    auto put16 = [&p](uint16_t v) { std::memcpy(p, &v, 2); p += 2; };
+    auto tag = [&p](const char* s) { std::memcpy(p, s, 4); p += 4; };
+
+    tag("RIFF"); put32(36 + dataSize); tag("WAVE");
+    tag("fmt "); put32(16); put16(1); put16(2);
+    put32(sampleRate); put32(sampleRate * 4); put16(4); put16(16);
+    tag("data"); put32(dataSize);
+
+    for (int i = 0; i < frameCount; i++) {
+        int16_t s = static_cast<int16_t>(8000.0f * std::sin(NX_TAU * frequency * i / sampleRate));
+        put16(s); put16(s);
+    }
+
+    return wav;
+}
+
+// ============================================================================
+// ENTRY POINT
+// ============================================================================
+
+int main(void)
+{
+    const int sampleRate = 48000;
+    const float caseSeconds = 1.5f;
+
+#if defined(_WIN32)
+    _putenv_s("SDL_AUDIO_DRIVER", "dummy");
+#else
+    setenv("SDL_AUDIO_DRIVER", "dummy", 1);
+#endif
+
+    NX_AppDesc desc{};
+    desc.audio.streamDecoders = 2;
+
+    if (!INX_AudioState_Init(&desc)) {
+        printf("Failed to open the audio device\n");
+        return 1;
+    }
+
+    struct Buffering { const char* name; int count; int frames; };
+    const Buffering bufferings[] = {
+        { "3 x 1024 frames", 3, 1024 },
+        { "default", 0, 0 },
+    };
+
+    bool allPlaying = true;
+
+    printf("%-8s | %-16s | %10s | %8s\n", "streams", "buffering", "underruns", "playing");
+
+    for (int streamCount : { 1, 8, 32, 64 })
+    {
+        std::vector<std::vector<uint8_t>> files;
+        for (int i = 0; i < streamCount; i++) {
+            files.push_back(GenWav(sampleRate, sampleRate, 220.0f + 10.0f * i));
+        }
+
+        for (const Buffering& buffering : bufferings)
+        {
+            std::vector<NX_AudioStream*> streams;
+
+            for (const std::vector<uint8_t>& file : files) {
+                NX_AudioStream* stream = NX_LoadAudioStreamFromData(file.data(), file.size());
+                if (stream == nullptr) {
+                    printf("Failed to load a stream\n");
+                    return 1;
+                }
+                NX_SetAudioStreamLoop(stream, true);
+                NX_SetAudioStreamBuffering(stream, buffering.count, buffering.frames);
+                streams.push_back(stream);
+            }
+
+            for (NX_AudioStream* stream : streams) {
+                NX_PlayAudioStream(stream);
+            }
+
+            /* --- Keep the main thread busy in 10 ms frames --- */
+
+            auto end = std::chrono::steady_clock::now() + std::chrono::duration<float>(caseSeconds);
+            volatile float sink = 0.0f;
+
+            while (std::chrono::steady_clock::now() < end) {
+                auto frameEnd = std::chrono::steady_clock::now() + std::chrono::milliseconds(10);
+                while (std::chrono::steady_clock::now() < frameEnd) {
+                    sink = sink + std::sqrt(static_cast<float>(sink) + 1.0f);
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(6));
+            }
+
+            int underruns = 0, playing = 0;
+            for (NX_AudioStream* stream : streams) {
+                underruns += NX_GetAudioStreamUnderruns(stream);
+                playing += NX_IsAudioStreamPlaying(stream);
+                NX_DestroyAudioStream(stream);
+            }
+
+            allPlaying &= (playing == streamCount);
+
+            printf("%-8i | %-16s | %10i | %4i/%-3i\n", streamCount, buffering.name, underruns, playing, streamCount);
+        }
+    }
+
+    INX_AudioState_Quit();
+
+    return allPlaying ? 0 : 1;
+}
@@ -0,0 +1,48 @@
+/* bench_common.hpp -- Helpers shared by the headless benchmarks
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#ifndef NX_BENCH_COMMON_HPP
+#define NX_BENCH_COMMON_HPP
+
+#include <cstdio>
+#include <chrono>
+
+// ============================================================================
+// TIMING
+// ============================================================================
+
+/** Runs 'func' once and returns the time it took, in milliseconds */
+template <typename F>
+inline double Measure(F&& func)
+{
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+/** Milliseconds elapsed since 'start' */
+inline double Elapsed(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// ============================================================================
+// CHECKS
+// ============================================================================
+
+/** Number of failed checks, benches return non-zero when it is not zero */
+inline int Failures = 0;
+
+inline void Check(bool condition, const char* what)
+{
+    printf("  [%s] %s\n", condition ? "ok" : "FAILED", what);
+    Failures += !condition;
+}
+
+#endif // NX_BENCH_COMMON_HPP
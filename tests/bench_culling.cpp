@@ -0,0 +1,266 @@
+/* bench_culling.cpp -- Headless benchmark of linear, batched and hierarchical frustum culling
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+/*
+ * Culls a set of persistent objects with the view, a shadow caster and a probe
+ * frustum, with a linear pass over all OBBs, with the SIMD batch kernel followed
+ * by the exact test of the boxes crossing a plane, and through the AABB tree used
+ * for scene objects. A fraction of the objects moves between iterations.
+ * All methods must produce exactly the same visible set.
+ *
+ * The batch kernels alone are then compared to the scalar classification
+ * functions, for boxes and spheres, and must produce the same bitmasks.
+ */
+
+#include <NX/Nexium.h>
+
+#include "INX_AabbTree.hpp"
+#include "INX_Frustum.hpp"
+#include "bench_common.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+// ============================================================================
+// BENCH DATA
+// ============================================================================
+
+struct BenchScene {
+    std::vector<NX_Transform> transforms;
+    std::vector<INX_OrientedBoundingBox3D> bounds;
+    std::vector<int> proxies;
+    INX_BoxBatch boxes;
+    NX_BoundingBox3D localAabb;
+    INX_AabbTree tree;
+};
+
+static void GenScene(BenchScene& scene, size_t count, NX_RandGen* gen)
+{
+    scene.transforms.resize(count);
+    scene.bounds.resize(count);
+    scene.proxies.resize(count);
+    scene.localAabb = { NX_VEC3_1(-0.5f), NX_VEC3_1(0.5f) };
+
+    for (size_t i = 0; i < count; i++) {
+        NX_Transform& transform = scene.transforms[i];
+        transform = NX_TRANSFORM_IDENTITY;
+        transform.translation = NX_VEC3(
+            NX_RandRangeFloat(gen, -500.0f, 500.0f),
+            NX_RandRangeFloat(gen, -20.0f, 20.0f),
+            NX_RandRangeFloat(gen, -500.0f, 500.0f)
+        );
+        transform.rotation = NX_QuatFromEuler(NX_VEC3(
+            NX_RandRangeFloat(gen, 0.0f, NX_TAU),
+            NX_RandRangeFloat(gen, 0.0f, NX_TAU),
+            NX_RandRangeFloat(gen, 0.0f, NX_TAU)
+        ));
+        scene.bounds[i] = INX_OrientedBoundingBox3D(scene.localAabb, transform);
+        scene.boxes.Push(scene.bounds[i].GetAabb());
+        scene.proxies[i] = scene.tree.CreateProxy(scene.bounds[i].GetAabb(), static_cast<int>(i));
+    }
+}
+
+static void MoveObjects(BenchScene& scene, size_t stride, float time)
+{
+    for (size_t i = 0; i < scene.transforms.size(); i += stride) {
+        NX_Transform& transform = scene.transforms[i];
+        transform.translation.y += 0.5f * sinf(time + static_cast<float>(i));
+        scene.bounds[i] = INX_OrientedBoundingBox3D(scene.localAabb, transform);
+        scene.boxes.Set(i, scene.bounds[i].GetAabb());
+        scene.tree.MoveProxy(scene.proxies[i], scene.bounds[i].GetAabb());
+    }
+}
+
+// ============================================================================
+// CULLING METHODS
+// ============================================================================
+
+static void CullLinear(const BenchScene& scene, const INX_Frustum& frustum, std::vector<int>& out)
+{
+    out.clear();
+    for (size_t i = 0; i < scene.bounds.size(); i++) {
+        if (frustum.ContainsObb(scene.bounds[i])) {
+            out.push_back(static_cast<int>(i));
+        }
+    }
+}
+
+static void CullBatch(const BenchScene& scene, const INX_Frustum& frustum, std::vector<int>& out)
+{
+    static std::vector<uint64_t> visible, inside;
+    visible.resize(INX_GetCullMaskSize(scene.boxes.GetSize()));
+    inside.resize(visible.size());
+
+    frustum.CullBoxes(scene.boxes, visible.data(), inside.data());
+
+    out.clear();
+    for (size_t i = 0; i < scene.bounds.size(); i++) {
+        if (!INX_TestCullMask(visible.data(), i)) continue;
+        if (INX_TestCullMask(inside.data(), i) || frustum.ContainsObb(scene.bounds[i])) {
+            out.push_back(static_cast<int>(i));
+        }
+    }
+}
+
+static void CullTree(const BenchScene& scene, const INX_Frustum& frustum, std::vector<int>& out)
+{
+    out.clear();
+    scene.tree.Query(frustum, [&](int index, bool fullyInside) {
+        if (fullyInside || frustum.ContainsObb(scene.bounds[index])) {
+            out.push_back(index);
+        }
+    });
+}
+
+// ============================================================================
+// KERNELS
+// ============================================================================
+
+static bool RunKernels(const INX_Frustum& frustum, size_t count, NX_RandGen* gen, int iterations)
+{
+    INX_BoxBatch boxes{};
+    INX_SphereBatch spheres{};
+
+    std::vector<NX_BoundingBox3D> aabbs(count);
+    std::vector<INX_BoundingSphere3D> sphereList;
+
+    for (size_t i = 0; i < count; i++) {
+        NX_Vec3 center = NX_VEC3(
+            NX_RandRangeFloat(gen, -500.0f, 500.0f),
+            NX_RandRangeFloat(gen, -20.0f, 20.0f),
+            NX_RandRangeFloat(gen, -500.0f, 500.0f)
+        );
+        NX_Vec3 extents = NX_VEC3_1(NX_RandRangeFloat(gen, 0.1f, 4.0f));
+        aabbs[i] = { center - extents, center + extents };
+        sphereList.emplace_back(aabbs[i], NX_TRANSFORM_IDENTITY);
+        boxes.Push(aabbs[i]);
+        spheres.Push(sphereList.back());
+    }
+
+    const size_t maskSize = INX_GetCullMaskSize(count);
+    std::vector<uint64_t> scalarVisible(maskSize), scalarInside(maskSize);
+    std::vector<uint64_t> batchVisible(maskSize), batchInside(maskSize);
+
+    auto scalarMasks = [&](auto&& classify) {
+        std::fill(scalarVisible.begin(), scalarVisible.end(), 0);
+        std::fill(scalarInside.begin(), scalarInside.end(), 0);
+        for (size_t i = 0; i < count; i++) {
+            INX_Frustum::Containment containment = classify(i);
+            if (containment != INX_Frustum::Outside) scalarVisible[i >> 6] |= 1ull << (i & 63);
+            if (containment == INX_Frustum::Inside) scalarInside[i >> 6] |= 1ull << (i & 63);
+        }
+    };
+
+    double scalarBoxTime = 0.0, batchBoxTime = 0.0;
+    double scalarSphereTime = 0.0, batchSphereTime = 0.0;
+    bool boxMatch = true, sphereMatch = true;
+
+    for (int it = 0; it < iterations; it++)
+    {
+        scalarBoxTime += Measure([&]() {
+            scalarMasks([&](size_t i) { return frustum.ClassifyAabb(aabbs[i]); });
+        }) / iterations;
+        batchBoxTime += Measure([&]() {
+            frustum.CullBoxes(boxes, batchVisible.data(), batchInside.data());
+        }) / iterations;
+        boxMatch = boxMatch && (scalarVisible == batchVisible) && (scalarInside == batchInside);
+
+        scalarSphereTime += Measure([&]() {
+            scalarMasks([&](size_t i) { return frustum.ClassifySphere(sphereList[i]); });
+        }) / iterations;
+        batchSphereTime += Measure([&]() {
+            frustum.CullSpheres(spheres, batchVisible.data(), batchInside.data());
+        }) / iterations;
+        sphereMatch = sphereMatch && (scalarVisible == batchVisible) && (scalarInside == batchInside);
+    }
+
+    printf("%8zu | %-6s | %11.3f | %11.3f | %6.1fx | %s\n", count, "box",
+           scalarBoxTime, batchBoxTime, scalarBoxTime / batchBoxTime, boxMatch ? "yes" : "NO");
+    printf("%8zu | %-6s | %11.3f | %11.3f | %6.1fx | %s\n", count, "sphere",
+           scalarSphereTime, batchSphereTime, scalarSphereTime / batchSphereTime, sphereMatch ? "yes" : "NO");
+
+    return boxMatch && sphereMatch;
+}
+
+// ============================================================================
+// ENTRY POINT
+// ============================================================================
+
+int main(void)
+{
+    struct BenchView {
+        const char* name;
+        INX_Frustum frustum;
+    };
+
+    /* --- Frustums of the three render pass kinds --- */
+
+    const NX_Vec3 viewPosition = NX_VEC3(0.0f, 10.0f, -520.0f);
+    NX_Mat4 view = NX_Mat4LookAt(viewPosition, NX_VEC3_ZERO, NX_VEC3_UP);
+    NX_Mat4 proj = NX_Mat4Perspective(60.0f * static_cast<float>(NX_DEG2RAD), 16.0f / 9.0f, 0.1f, 400.0f);
+
+    NX_Mat4 casterView = NX_Mat4LookAt(NX_VEC3(100.0f, 100.0f, 0.0f), NX_VEC3(100.0f, 0.0f, 1.0f), NX_VEC3_UP);
+    NX_Mat4 casterProj = NX_Mat4Ortho(-150.0f, 150.0f, -150.0f, 150.0f, 0.1f, 200.0f);
+
+    NX_Mat4 probeView = NX_Mat4LookAt(NX_VEC3(-200.0f, 0.0f, 200.0f), NX_VEC3(-200.0f, 0.0f, 300.0f), NX_VEC3_UP);
+    NX_Mat4 probeProj = NX_Mat4Perspective(90.0f * static_cast<float>(NX_DEG2RAD), 1.0f, 0.1f, 100.0f);
+
+    const BenchView views[] = {
+        { "view", INX_Frustum(view * proj) },
+        { "caster", INX_Frustum(casterView * casterProj) },
+        { "probe", INX_Frustum(probeView * probeProj) },
+    };
+
+    const size_t counts[] = { 1000, 10000, 100000 };
+    const int iterations = 20;
+
+    NX_RandGen gen = NX_CreateRandGenTemp(1337);
+    bool allMatch = true;
+
+    /* --- Persistent objects culling --- */
+
+    printf("%8s | %-6s | %8s | %11s | %11s | %11s | %s\n", "objects", "pass", "visible", "linear (ms)", "batch (ms)", "tree (ms)", "match");
+
+    for (size_t count : counts)
+    {
+        BenchScene scene{};
+        GenScene(scene, count, &gen);
+
+        for (const BenchView& pass : views)
+        {
+            std::vector<int> linear, batched, hierarchical;
+            double linearTime = 0.0, batchTime = 0.0, treeTime = 0.0;
+            bool match = true;
+
+            for (int it = 0; it < iterations; it++) {
+                MoveObjects(scene, 32, static_cast<float>(it));
+                linearTime += Measure([&]() { CullLinear(scene, pass.frustum, linear); }) / iterations;
+                batchTime += Measure([&]() { CullBatch(scene, pass.frustum, batched); }) / iterations;
+                treeTime += Measure([&]() { CullTree(scene, pass.frustum, hierarchical); }) / iterations;
+                std::sort(hierarchical.begin(), hierarchical.end());
+                match = match && (linear == batched) && (linear == hierarchical);
+            }
+
+            allMatch = allMatch && match;
+
+            printf("%8zu | %-6s | %8zu | %11.3f | %11.3f | %11.3f | %s\n", count, pass.name, linear.size(),
+                   linearTime, batchTime, treeTime, match ? "yes" : "NO");
+        }
+    }
+
+    /* --- Batch kernels against the scalar classification --- */
+
+    printf("\n%8s | %-6s | %11s | %11s | %7s | %s\n", "objects", "bounds", "scalar (ms)", "batch (ms)", "speedup", "match");
+
+    for (size_t count : counts) {
+        allMatch = RunKernels(views[0].frustum, count, &gen, iterations) && allMatch;
+    }
+
+    return allMatch ? 0 : 1;
+}
@@ -0,0 +1,214 @@
+/* bench_draw_calls.cpp -- Headless benchmark of the draw call recording and packing stages
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+/*
+ * Runs the CPU side of the 3D draw call pipeline without any window or GPU:
+ * culling, GPU record packing and sort key computation. Each stage is run
+ * serially then on the job system, and both outputs are compared byte-for-byte.
+ */
+
+#include <NX/Nexium.h>
+
+#include "INX_DrawPacking.hpp"
+#include "INX_JobSystem.hpp"
+#include "INX_Frustum.hpp"
+#include "bench_common.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <vector>
+
+// ============================================================================
+// BENCH DATA
+// ============================================================================
+
+struct BenchObject {
+    NX_Transform transform;
+    NX_BoundingBox3D aabb;
+    NX_Material material;
+    uint32_t layerMask;
+    bool transparent;
+};
+
+struct BenchOutput {
+    std::vector<uint8_t> visible;
+    std::vector<int> drawList;
+    std::vector<INX_GPUDrawShared> shared;
+    std::vector<INX_GPUDrawUnique> unique;
+    std::vector<float> distances;
+    std::vector<int> order;
+};
+
+struct BenchTimings {
+    double cull;
+    double pack;
+    double sort;
+};
+
+static std::vector<BenchObject> GenObjects(size_t count)
+{
+    std::vector<BenchObject> objects(count);
+    NX_Material material = NX_GetDefaultMaterial();
+
+    NX_RandGen gen = NX_CreateRandGenTemp(1337);
+
+    for (size_t i = 0; i < count; i++) {
+        BenchObject& obj = objects[i];
+        obj.transform = NX_TRANSFORM_IDENTITY;
+        obj.transform.translation = NX_VEC3(
+            NX_RandRangeFloat(&gen, -200.0f, 200.0f),
+            NX_RandRangeFloat(&gen, -20.0f, 20.0f),
+            NX_RandRangeFloat(&gen, -200.0f, 200.0f)
+        );
+        obj.transform.rotation = NX_QuatFromEuler(NX_VEC3(
+            NX_RandRangeFloat(&gen, 0.0f, NX_TAU),
+            NX_RandRangeFloat(&gen, 0.0f, NX_TAU),
+            NX_RandRangeFloat(&gen, 0.0f, NX_TAU)
+        ));
+        obj.aabb = { NX_VEC3_1(-0.5f), NX_VEC3_1(0.5f) };
+        obj.material = material;
+        obj.material.orm.roughness = NX_RandFloat(&gen);
+        obj.layerMask = 1u << (i % 16);
+        obj.transparent = (i % 8) == 0;
+    }
+
+    return objects;
+}
+
+// ============================================================================
+// STAGES
+// ============================================================================
+
+template <typename Loop>
+static BenchTimings RunStages(const std::vector<BenchObject>& objects, const INX_Frustum& frustum,
+                              const NX_Vec3& viewPosition, BenchOutput& out, Loop&& loop)
+{
+    BenchTimings timings{};
+
+    /* --- Recording: cull into per-object flags, then compact in submission order --- */
+
+    timings.cull = Measure([&]() {
+        out.visible.resize(objects.size());
+        loop(objects.size(), 256, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                INX_OrientedBoundingBox3D obb(objects[i].aabb, objects[i].transform);
+                out.visible[i] = frustum.ContainsObb(obb);
+            }
+        });
+        out.drawList.clear();
+        for (size_t i = 0; i < objects.size(); i++) {
+            if (out.visible[i]) out.drawList.push_back(static_cast<int>(i));
+        }
+    });
+
+    /* --- Packing of the GPU records --- */
+
+    timings.pack = Measure([&]() {
+        const size_t count = out.drawList.size();
+        out.shared.resize(count);
+        out.unique.resize(count);
+        loop(count, 128, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                const BenchObject& obj = objects[out.drawList[i]];
+                INX_PackDrawShared(&out.shared[i], obj.transform, -1, 0);
+                INX_PackDrawUnique(&out.unique[i], obj.material, obj.layerMask);
+            }
+        });
+    });
+
+    /* --- Sort keys and sorting --- */
+
+    timings.sort = Measure([&]() {
+        const size_t count = out.drawList.size();
+        out.distances.resize(count);
+        loop(count, 256, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                const BenchObject& obj = objects[out.drawList[i]];
+                out.distances[i] = obj.transparent
+                    ? INX_GetFarthestDistanceSq(viewPosition, obj.aabb, obj.transform)
+                    : INX_GetCenterDistanceSq(viewPosition, obj.aabb, obj.transform);
+            }
+        });
+        out.order.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            out.order[i] = static_cast<int>(i);
+        }
+        std::sort(out.order.begin(), out.order.end(), [&](int a, int b) {
+            if (out.distances[a] != out.distances[b]) return out.distances[a] < out.distances[b];
+            return a < b;
+        });
+    });
+
+    return timings;
+}
+
+template <typename T>
+static bool SameBytes(const std::vector<T>& a, const std::vector<T>& b)
+{
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+}
+
+// ============================================================================
+// ENTRY POINT
+// ============================================================================
+
+int main(void)
+{
+    if (!INX_Jobs.Init(-1)) {
+        return 1;
+    }
+
+    printf("Worker threads: %i (+ calling thread)\n", INX_Jobs.GetWorkerCount());
+    printf("%8s | %8s | %-8s | %10s | %10s | %10s | %s\n", "objects", "visible", "mode", "cull (ms)", "pack (ms)", "sort (ms)", "match");
+
+    const NX_Vec3 viewPosition = NX_VEC3(0.0f, 10.0f, -220.0f);
+    NX_Mat4 view = NX_Mat4LookAt(viewPosition, NX_VEC3_ZERO, NX_VEC3_UP);
+    NX_Mat4 proj = NX_Mat4Perspective(60.0f * static_cast<float>(NX_DEG2RAD), 16.0f / 9.0f, 0.1f, 1000.0f);
+    INX_Frustum frustum(view * proj);
+
+    auto serialLoop = [](size_t count, size_t, auto&& func) { func(0, count); };
+    auto parallelLoop = [](size_t count, size_t grain, auto&& func) { INX_Jobs.ParallelFor(count, grain, func); };
+
+    const size_t counts[] = { 1000, 10000, 20000, 100000 };
+    const int iterations = 10;
+
+    bool allMatch = true;
+
+    for (size_t count : counts)
+    {
+        std::vector<BenchObject> objects = GenObjects(count);
+
+        BenchOutput serial{}, parallel{};
+        BenchTimings serialTime{}, parallelTime{};
+
+        for (int it = 0; it < iterations; it++) {
+            BenchTimings s = RunStages(objects, frustum, viewPosition, serial, serialLoop);
+            BenchTimings p = RunStages(objects, frustum, viewPosition, parallel, parallelLoop);
+            serialTime.cull += s.cull / iterations, parallelTime.cull += p.cull / iterations;
+            serialTime.pack += s.pack / iterations, parallelTime.pack += p.pack / iterations;
+            serialTime.sort += s.sort / iterations, parallelTime.sort += p.sort / iterations;
+        }
+
+        bool match = SameBytes(serial.drawList, parallel.drawList)
+                  && SameBytes(serial.shared, parallel.shared)
+                  && SameBytes(serial.unique, parallel.unique)
+                  && SameBytes(serial.order, parallel.order);
+
+        allMatch = allMatch && match;
+
+        printf("%8zu | %8zu | %-8s | %10.3f | %10.3f | %10.3f |\n", count, serial.drawList.size(), "serial",
+               serialTime.cull, serialTime.pack, serialTime.sort);
+        printf("%8zu | %8zu | %-8s | %10.3f | %10.3f | %10.3f | %s\n", count, parallel.drawList.size(), "parallel",
+               parallelTime.cull, parallelTime.pack, parallelTime.sort, match ? "yes" : "NO");
+    }
+
+    INX_Jobs.Quit();
+
+    return allMatch ? 0 : 1;
+}
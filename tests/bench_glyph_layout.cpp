@@ -0,0 +1,248 @@
+/* bench_glyph_layout.cpp -- Headless validation and benchmark of glyph lookups during text layout
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+/*
+ * Lays out a long mixed text, summing advances and emitting one quad per glyph
+ * like 'NX_DrawText2D' does, without any GPU work:
+ *
+ *   - With the previous linear scan of the glyph array for every codepoint.
+ *   - With the glyph cache tables, all glyphs already rasterized.
+ *   - With a cache created with ASCII only, the first pass rasterizing and
+ *     packing every other glyph on demand.
+ *
+ * Throughputs are reported in glyphs per second. Every path must produce the
+ * same quads, and missing codepoints must resolve to the fallback glyph.
+ */
+
+#include <NX/Nexium.h>
+
+#include "INX_GlyphCache.hpp"
+#include "bench_common.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <vector>
+
+// ============================================================================
+// BENCH DATA
+// ============================================================================
+
+struct Quad {
+    float x, y, w, h;
+    int u, v;
+};
+
+static std::vector<uint8_t> LoadFontFile(const char* path)
+{
+    std::vector<uint8_t> data;
+
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr) {
+        return data;
+    }
+
+    fseek(file, 0, SEEK_END);
+    data.resize(static_cast<size_t>(ftell(file)));
+    fseek(file, 0, SEEK_SET);
+
+    if (fread(data.data(), 1, data.size(), file) != data.size()) {
+        data.clear();
+    }
+
+    fclose(file);
+
+    return data;
+}
+
+static std::vector<int> GenText(int length, NX_RandGen* gen)
+{
+    // Mostly ASCII, with Latin-1, Latin Extended, Greek, Cyrillic and CJK
+    // codepoints which the font may or may not provide
+
+    static const int ranges[][2] = {
+        { 0x0020, 0x007E }, { 0x00A0, 0x00FF }, { 0x0100, 0x017F },
+        { 0x0370, 0x03FF }, { 0x0400, 0x04FF }, { 0x4E00, 0x4FFF },
+    };
+
+    std::vector<int> text(length);
+
+    for (int i = 0; i < length; i++) {
+        const int* range = ranges[(i % 4 == 0) ? NX_RandRangeInt(gen, 1, 6) : 0];
+        text[i] = (i % 61 == 60) ? '\n' : NX_RandRangeInt(gen, range[0], range[1] + 1);
+    }
+
+    return text;
+}
+
+// ============================================================================
+// LAYOUT
+// ============================================================================
+
+static const INX_Glyph& LinearLookup(const INX_Glyph* glyphs, int count, int codepoint)
+{
+    // Same search as the previous 'INX_GetGlyphIndex'
+    int index = 0, fallbackIndex = 0;
+
+    for (int i = 0; i < count; i++) {
+        if (glyphs[i].value == codepoint) {
+            index = i;
+            break;
+        }
+        else if (glyphs[i].value == '?') {
+            fallbackIndex = i;
+        }
+    }
+
+    if (!index && glyphs[0].value != codepoint) {
+        index = fallbackIndex;
+    }
+
+    return glyphs[index];
+}
+
+template <typename Lookup>
+static void Layout(const std::vector<int>& text, float scale, Lookup&& lookup, std::vector<Quad>* quads)
+{
+    float x = 0.0f, y = 0.0f;
+    quads->clear();
+
+    for (int codepoint : text)
+    {
+        const INX_Glyph& glyph = lookup(codepoint);
+
+        if (codepoint == '\n') {
+            y += 32.0f * scale;
+            x = 0.0f;
+            continue;
+        }
+
+        if (codepoint != ' ') {
+            quads->push_back(Quad {
+                x + glyph.xOffset * scale, y + glyph.yOffset * scale,
+                glyph.wGlyph * scale, glyph.hGlyph * scale,
+                glyph.xAtlas, glyph.yAtlas
+            });
+        }
+
+        x += ((glyph.xAdvance > 0) ? glyph.xAdvance : glyph.wGlyph) * scale;
+    }
+}
+
+static bool SameLayout(const std::vector<Quad>& a, const std::vector<Quad>& b, bool compareAtlas)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].x != b[i].x || a[i].y != b[i].y || a[i].w != b[i].w || a[i].h != b[i].h) {
+            return false;
+        }
+        if (compareAtlas && (a[i].u != b[i].u || a[i].v != b[i].v)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// ============================================================================
+// ENTRY POINT
+// ============================================================================
+
+int main(void)
+{
+    const int baseSize = 32;
+    const int textLength = 1 << 20;
+    const int iterations = 5;
+    const float scale = 0.75f;
+
+    std::vector<uint8_t> fontData = LoadFontFile(RESOURCES_PATH "fonts/Eater-Regular.ttf");
+    if (fontData.empty()) {
+        printf("Failed to load the font file\n");
+        return 1;
+    }
+
+    NX_RandGen gen = NX_CreateRandGenTemp(1337);
+    std::vector<int> text = GenText(textLength, &gen);
+
+    /* --- Every codepoint of the text rasterized up front --- */
+
+    std::vector<int> codepoints(text);
+    std::sort(codepoints.begin(), codepoints.end());
+    codepoints.erase(std::unique(codepoints.begin(), codepoints.end()), codepoints.end());
+
+    INX_GlyphCache full;
+    if (!full.Init(fontData.data(), fontData.size(), NX_FONT_NORMAL, baseSize, 4,
+                   codepoints.data(), static_cast<int>(codepoints.size()))) {
+        return 1;
+    }
+
+    // The linear scan goes through the same glyph array
+    const INX_Glyph* glyphs = full.GetGlyphs();
+    const int glyphCount = full.GetGlyphCount();
+
+    printf("Text: %i codepoints (%zu distinct), font glyphs: %i, atlas: %ix%i\n",
+           textLength, codepoints.size(), glyphCount, full.GetAtlas().w, full.GetAtlas().h);
+    printf("%-24s | %12s | %14s | %s\n", "path", "time (ms)", "glyphs/s", "match");
+
+    /* --- Linear scan --- */
+
+    std::vector<Quad> expected, quads;
+    expected.reserve(textLength);
+    quads.reserve(textLength);
+
+    double linearTime = Measure([&]() {
+        Layout(text, scale, [&](int codepoint) -> const INX_Glyph& {
+            return LinearLookup(glyphs, glyphCount, codepoint);
+        }, &expected);
+    });
+
+    printf("%-24s | %12.3f | %14.0f | %s\n", "linear scan", linearTime, textLength / (linearTime / 1000.0), "-");
+
+    /* --- Glyph cache, warm --- */
+
+    double tableTime = 1e30;
+    for (int it = 0; it < iterations; it++) {
+        tableTime = std::min(tableTime, Measure([&]() {
+            Layout(text, scale, [&](int codepoint) -> const INX_Glyph& {
+                return full.GetGlyph(codepoint);
+            }, &quads);
+        }));
+    }
+
+    bool tableMatch = SameLayout(expected, quads, true);
+    printf("%-24s | %12.3f | %14.0f | %s\n", "table (warm)", tableTime, textLength / (tableTime / 1000.0),
+           tableMatch ? "yes" : "NO");
+
+    /* --- Glyph cache, rasterizing on demand --- */
+
+    INX_GlyphCache lazy;
+    if (!lazy.Init(fontData.data(), fontData.size(), NX_FONT_NORMAL, baseSize, 4, nullptr, 95)) {
+        return 1;
+    }
+
+    const int initialCount = lazy.GetGlyphCount();
+
+    double coldTime = Measure([&]() {
+        Layout(text, scale, [&](int codepoint) -> const INX_Glyph& {
+            return lazy.GetGlyph(codepoint);
+        }, &quads);
+    });
+
+    // Atlas positions differ since glyphs were packed in another order
+    bool lazyMatch = SameLayout(expected, quads, false) && (lazy.GetGlyphCount() == glyphCount);
+
+    printf("%-24s | %12.3f | %14.0f | %s\n", "table (on demand)", coldTime, textLength / (coldTime / 1000.0),
+           lazyMatch ? "yes" : "NO");
+    printf("On demand: %i glyphs rasterized, atlas %ix%i after %u regrowth(s)\n",
+           lazy.GetGlyphCount() - initialCount, lazy.GetAtlas().w, lazy.GetAtlas().h, lazy.GetAtlasGeneration() - 1);
+
+    return (tableMatch && lazyMatch) ? 0 : 1;
+}
@@ -0,0 +1,255 @@
+/* bench_image_resize.cpp -- Headless validation and benchmark of CPU image resampling
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+/*
+ * Resizes a random RGBA8 image with the nearest neighbor 'NX_BlitImage' and
+ * with 'NX_ResizeImage' for each filter, then builds its mip chain with blits
+ * and with 'NX_GenImageMipmaps'. Before timing, checks that:
+ *
+ *   - A constant image stays exactly constant with every filter, in linear and sRGB.
+ *   - A 2x box reduction equals the average of each 2x2 block.
+ *   - The mip chain goes down to 1x1 with halved dimensions.
+ */
+
+#include <NX/Nexium.h>
+
+#include "INX_JobSystem.hpp"
+#include "bench_common.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+
+// ============================================================================
+// BENCH DATA
+// ============================================================================
+
+static const NX_ImageFilter FILTERS[] = {
+    NX_IMAGE_FILTER_BOX, NX_IMAGE_FILTER_BILINEAR, NX_IMAGE_FILTER_LANCZOS, NX_IMAGE_FILTER_KAISER,
+};
+
+static const char* FILTER_NAMES[] = {
+    "box", "bilinear", "lanczos", "kaiser",
+};
+
+static NX_Image GenNoiseImage(int w, int h, NX_PixelFormat format, NX_RandGen* gen)
+{
+    NX_Image image = NX_CreateImage(w, h, format);
+
+    for (int i = 0; i < w * h; i++) {
+        NX_Color color = NX_COLOR(
+            NX_RandRangeFloat(gen, 0.0f, 1.0f),
+            NX_RandRangeFloat(gen, 0.0f, 1.0f),
+            NX_RandRangeFloat(gen, 0.0f, 1.0f),
+            NX_RandRangeFloat(gen, 0.0f, 1.0f)
+        );
+        NX_WritePixel(image.pixels, i, format, color);
+    }
+
+    return image;
+}
+
+// ============================================================================
+// CHECKS
+// ============================================================================
+
+static bool CheckConstantImage()
+{
+    NX_Image image = NX_CreateImage(64, 48, NX_PIXEL_FORMAT_RGBA8);
+    const uint8_t pixel[4] = { 200, 37, 3, 128 };
+
+    for (int i = 0; i < image.w * image.h; i++) {
+        std::memcpy(static_cast<uint8_t*>(image.pixels) + i * 4, pixel, 4);
+    }
+
+    bool match = true;
+
+    for (NX_ImageFilter filter : FILTERS) {
+        for (int srgb = 0; srgb < 2; srgb++) {
+            NX_Image resized[2] = {
+                NX_ResizeImage(&image, 27, 19, filter, srgb),
+                NX_ResizeImage(&image, 150, 101, filter, srgb)
+            };
+            for (NX_Image& result : resized) {
+                for (int i = 0; i < result.w * result.h && match; i++) {
+                    match = (std::memcmp(static_cast<uint8_t*>(result.pixels) + i * 4, pixel, 4) == 0);
+                }
+                match = match && (result.pixels != nullptr);
+                NX_DestroyImage(&result);
+            }
+        }
+    }
+
+    NX_DestroyImage(&image);
+
+    return match;
+}
+
+static bool CheckBoxReduction(NX_RandGen* gen)
+{
+    NX_Image image = GenNoiseImage(128, 96, NX_PIXEL_FORMAT_RGB32F, gen);
+    NX_Image half = NX_ResizeImage(&image, 64, 48, NX_IMAGE_FILTER_BOX, false);
+
+    bool match = (half.pixels != nullptr);
+
+    for (int y = 0; y < half.h && match; y++) {
+        for (int x = 0; x < half.w && match; x++) {
+            NX_Color c00 = NX_GetImagePixel(&image, 2 * x + 0, 2 * y + 0);
+            NX_Color c10 = NX_GetImagePixel(&image, 2 * x + 1, 2 * y + 0);
+            NX_Color c01 = NX_GetImagePixel(&image, 2 * x + 0, 2 * y + 1);
+            NX_Color c11 = NX_GetImagePixel(&image, 2 * x + 1, 2 * y + 1);
+            NX_Color result = NX_GetImagePixel(&half, x, y);
+            match = std::abs(result.r - 0.25f * (c00.r + c10.r + c01.r + c11.r)) < 1e-5f
+                 && std::abs(result.g - 0.25f * (c00.g + c10.g + c01.g + c11.g)) < 1e-5f
+                 && std::abs(result.b - 0.25f * (c00.b + c10.b + c01.b + c11.b)) < 1e-5f;
+        }
+    }
+
+    NX_DestroyImage(&half);
+    NX_DestroyImage(&image);
+
+    return match;
+}
+
+static bool CheckMipChain(NX_RandGen* gen)
+{
+    NX_Image image = GenNoiseImage(300, 17, NX_PIXEL_FORMAT_RGBA16F, gen);
+    NX_Image mipmaps[16];
+
+    const int expected = NX_GenImageMipmaps(&image, nullptr, 0, NX_IMAGE_FILTER_KAISER, false);
+    const int count = NX_GenImageMipmaps(&image, mipmaps, 16, NX_IMAGE_FILTER_KAISER, false);
+
+    bool match = (expected == 8 && count == expected);
+    int w = image.w, h = image.h;
+
+    for (int i = 0; i < count; i++) {
+        w = std::max(w >> 1, 1);
+        h = std::max(h >> 1, 1);
+        match = match && (mipmaps[i].w == w) && (mipmaps[i].h == h) && (mipmaps[i].format == image.format);
+        NX_DestroyImage(&mipmaps[i]);
+    }
+
+    NX_DestroyImage(&image);
+
+    return match && (w == 1) && (h == 1);
+}
+
+// ============================================================================
+// CASES
+// ============================================================================
+
+static void RunResizeCases(const NX_Image& image, int w, int h, int iterations)
+{
+    const double megapixels = (static_cast<double>(w) * h) / 1e6;
+
+    double blitTime = 0.0;
+    for (int it = 0; it < iterations; it++) {
+        blitTime += Measure([&]() {
+            NX_Image result = NX_CreateImage(w, h, image.format);
+            NX_BlitImage(&image, 0, 0, image.w, image.h, &result, 0, 0, w, h);
+            NX_DestroyImage(&result);
+        }) / iterations;
+    }
+
+    printf("%5ix%-5i | %-10s | %-6s | %10.3f | %10.1f\n", w, h, "blit", "-", blitTime, megapixels / (blitTime / 1000.0));
+
+    for (int f = 0; f < 4; f++) {
+        for (int srgb = 0; srgb < 2; srgb++) {
+            double time = 0.0;
+            for (int it = 0; it < iterations; it++) {
+                time += Measure([&]() {
+                    NX_Image result = NX_ResizeImage(&image, w, h, FILTERS[f], srgb);
+                    NX_DestroyImage(&result);
+                }) / iterations;
+            }
+            printf("%5ix%-5i | %-10s | %-6s | %10.3f | %10.1f\n", w, h, FILTER_NAMES[f], srgb ? "srgb" : "linear",
+                   time, megapixels / (time / 1000.0));
+        }
+    }
+}
+
+static void RunMipCases(const NX_Image& image, int iterations)
+{
+    NX_Image mipmaps[16];
+    const int count = NX_GenImageMipmaps(&image, nullptr, 0, NX_IMAGE_FILTER_BOX, false);
+
+    double blitTime = 0.0;
+    for (int it = 0; it < iterations; it++) {
+        blitTime += Measure([&]() {
+            const NX_Image* previous = &image;
+            for (int i = 0; i < count; i++) {
+                const int w = std::max(previous->w >> 1, 1);
+                const int h = std::max(previous->h >> 1, 1);
+                mipmaps[i] = NX_CreateImage(w, h, image.format);
+                NX_BlitImage(previous, 0, 0, previous->w, previous->h, &mipmaps[i], 0, 0, w, h);
+                previous = &mipmaps[i];
+            }
+            for (int i = 0; i < count; i++) {
+                NX_DestroyImage(&mipmaps[i]);
+            }
+        }) / iterations;
+    }
+
+    printf("%-11s | %-10s | %-6s | %10.3f |\n", "mip chain", "blit", "-", blitTime);
+
+    for (int f = 0; f < 4; f++) {
+        for (int srgb = 0; srgb < 2; srgb++) {
+            double time = 0.0;
+            for (int it = 0; it < iterations; it++) {
+                time += Measure([&]() {
+                    int generated = NX_GenImageMipmaps(&image, mipmaps, 16, FILTERS[f], srgb);
+                    for (int i = 0; i < generated; i++) {
+                        NX_DestroyImage(&mipmaps[i]);
+                    }
+                }) / iterations;
+            }
+            printf("%-11s | %-10s | %-6s | %10.3f |\n", "mip chain", FILTER_NAMES[f], srgb ? "srgb" : "linear", time);
+        }
+    }
+}
+
+// ============================================================================
+// ENTRY POINT
+// ============================================================================
+
+int main(void)
+{
+    const int size = 2048;
+    const int iterations = 3;
+
+    if (!INX_Jobs.Init(-1)) {
+        return 1;
+    }
+
+    NX_RandGen gen = NX_CreateRandGenTemp(1337);
+
+    bool constant = CheckConstantImage();
+    bool box = CheckBoxReduction(&gen);
+    bool mips = CheckMipChain(&gen);
+
+    printf("constant image: %s\n", constant ? "yes" : "NO");
+    printf("box reduction: %s\n", box ? "yes" : "NO");
+    printf("mip chain: %s\n", mips ? "yes" : "NO");
+
+    printf("Image: %ix%i RGBA8, worker threads: %i (+ calling thread)\n", size, size, INX_Jobs.GetWorkerCount());
+    printf("%-11s | %-10s | %-6s | %10s | %10s\n", "target", "method", "space", "time (ms)", "MP/s");
+
+    NX_Image image = GenNoiseImage(size, size, NX_PIXEL_FORMAT_RGBA8, &gen);
+
+    RunResizeCases(image, size / 2, size / 2, iterations);
+    RunResizeCases(image, size / 4, size / 4, iterations);
+    RunResizeCases(image, size * 3 / 2, size * 3 / 2, iterations);
+    RunMipCases(image, iterations);
+
+    NX_DestroyImage(&image);
+
+    INX_Jobs.Quit();
+
+    return (constant && box && mips) ? 0 : 1;
+}
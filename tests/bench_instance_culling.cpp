@@ -0,0 +1,298 @@
+/* bench_instance_culling.cpp -- Headless validation and benchmark of the per-instance culling reference
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+/*
+ * Checks the CPU reference of the GPU instance culling without any GPU:
+ *
+ *   - The bounding sphere of each instance must contain the corners of the
+ *     mesh box transformed like the vertex shader does (draw, then instance).
+ *   - The compacted indices must be exactly the instances that are not
+ *     outside the frustum according to the scalar sphere classification.
+ *   - The gathered attributes must be the ones of the visible instances.
+ *
+ * Instance buffers with and without rotations and scales are tested, the
+ * timings give the CPU cost that the GPU culling removes from the frame.
+ *
+ * When a GL context can be created, the instances are also culled on the GPU
+ * and the indirect commands are read back: every command of the slot must
+ * keep its element count and get the visible count of the CPU reference.
+ */
+
+#include <NX/Nexium.h>
+
+#include "INX_InstanceCulling.hpp"
+#include "INX_Frustum.hpp"
+#include "bench_common.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// ============================================================================
+// BENCH DATA
+// ============================================================================
+
+struct BenchInstances {
+    std::vector<NX_Vec3> positions;
+    std::vector<NX_Quat> rotations;
+    std::vector<NX_Vec3> scales;
+    std::vector<NX_Color> colors;
+};
+
+static void GenInstances(BenchInstances& instances, size_t count, NX_RandGen* gen)
+{
+    instances.positions.resize(count);
+    instances.rotations.resize(count);
+    instances.scales.resize(count);
+    instances.colors.resize(count);
+
+    for (size_t i = 0; i < count; i++) {
+        instances.positions[i] = NX_VEC3(
+            NX_RandRangeFloat(gen, -500.0f, 500.0f),
+            NX_RandRangeFloat(gen, -20.0f, 20.0f),
+            NX_RandRangeFloat(gen, -500.0f, 500.0f)
+        );
+        instances.rotations[i] = NX_QuatFromEuler(NX_VEC3(
+            NX_RandRangeFloat(gen, 0.0f, NX_TAU),
+            NX_RandRangeFloat(gen, 0.0f, NX_TAU),
+            NX_RandRangeFloat(gen, 0.0f, NX_TAU)
+        ));
+        instances.scales[i] = NX_VEC3(
+            NX_RandRangeFloat(gen, 0.25f, 3.0f),
+            NX_RandRangeFloat(gen, 0.25f, 3.0f),
+            NX_RandRangeFloat(gen, -3.0f, -0.25f)
+        );
+        instances.colors[i] = NX_COLOR(
+            static_cast<float>(i), 0.0f, 1.0f, 1.0f
+        );
+    }
+}
+
+// ============================================================================
+// CHECKS
+// ============================================================================
+
+/** Applies the instance transform like 'M_TransformToMat4' in the vertex shader */
+static NX_Vec3 TransformInstance(NX_Vec3 point, const NX_Vec3* position, const NX_Quat* rotation, const NX_Vec3* scale)
+{
+    if (scale) point = point * (*scale);
+    if (rotation) point = NX_Vec3Rotate(point, NX_QuatNormalize(*rotation));
+    if (position) point = point + (*position);
+    return point;
+}
+
+static bool CheckBounds(const NX_BoundingBox3D& aabb, const NX_Transform& transform, const BenchInstances& instances,
+                        const NX_Vec3* positions, const NX_Quat* rotations, const NX_Vec3* scales)
+{
+    const INX_BoundingSphere3D drawSphere = INX_GetDrawSphere(aabb, transform);
+
+    for (size_t i = 0; i < instances.positions.size(); i++)
+    {
+        const NX_Vec3* position = positions ? &positions[i] : nullptr;
+        const NX_Quat* rotation = rotations ? &rotations[i] : nullptr;
+        const NX_Vec3* scale = scales ? &scales[i] : nullptr;
+
+        INX_BoundingSphere3D sphere = INX_GetInstanceSphere(drawSphere, position, rotation, scale);
+
+        for (int c = 0; c < 8; c++) {
+            NX_Vec3 corner = NX_VEC3(
+                (c & 1) ? aabb.max.x : aabb.min.x,
+                (c & 2) ? aabb.max.y : aabb.min.y,
+                (c & 4) ? aabb.max.z : aabb.min.z
+            );
+            corner = NX_Vec3Rotate(corner * transform.scale, transform.rotation) + transform.translation;
+            corner = TransformInstance(corner, position, rotation, scale);
+            if (NX_Vec3Distance(corner, sphere.center) > sphere.radius * 1.0001f + 1e-4f) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static bool RunCase(const char* name, const INX_Frustum& frustum, const BenchInstances& instances,
+                    const NX_Vec3* positions, const NX_Quat* rotations, const NX_Vec3* scales, int iterations)
+{
+    const size_t count = instances.positions.size();
+
+    const NX_BoundingBox3D aabb = { NX_VEC3(-0.5f, 0.0f, -0.5f), NX_VEC3(0.5f, 2.0f, 0.5f) };
+    NX_Transform transform = NX_TRANSFORM_IDENTITY;
+    transform.translation = NX_VEC3(0.0f, 1.0f, 0.0f);
+    transform.rotation = NX_QuatFromEuler(NX_VEC3(0.0f, 0.5f, 0.0f));
+    transform.scale = NX_VEC3(1.0f, 1.5f, 1.0f);
+
+    const INX_BoundingSphere3D drawSphere = INX_GetDrawSphere(aabb, transform);
+
+    /* --- Scalar classification, one instance at a time --- */
+
+    std::vector<uint32_t> expected;
+    expected.reserve(count);
+
+    double scalarTime = 0.0;
+    for (int it = 0; it < iterations; it++) {
+        scalarTime += Measure([&]() {
+            expected.clear();
+            for (size_t i = 0; i < count; i++) {
+                INX_BoundingSphere3D sphere = INX_GetInstanceSphere(
+                    drawSphere,
+                    positions ? &positions[i] : nullptr,
+                    rotations ? &rotations[i] : nullptr,
+                    scales ? &scales[i] : nullptr
+                );
+                if (frustum.ClassifySphere(sphere) != INX_Frustum::Outside) {
+                    expected.push_back(static_cast<uint32_t>(i));
+                }
+            }
+        }) / iterations;
+    }
+
+    /* --- Reference of the GPU compaction --- */
+
+    std::vector<uint32_t> visible(count);
+    size_t visibleCount = 0;
+
+    double referenceTime = 0.0;
+    for (int it = 0; it < iterations; it++) {
+        referenceTime += Measure([&]() {
+            visibleCount = INX_CullInstances(frustum, drawSphere, positions, rotations, scales, count, visible.data());
+        }) / iterations;
+    }
+
+    visible.resize(visibleCount);
+    bool match = (visible == expected);
+
+    /* --- Gather of the visible colors --- */
+
+    std::vector<NX_Color> gathered(visibleCount);
+    INX_GatherInstances(gathered.data(), instances.colors.data(), sizeof(NX_Color), visible.data(), visibleCount);
+
+    for (size_t i = 0; i < visibleCount && match; i++) {
+        match = (std::memcmp(&gathered[i], &instances.colors[visible[i]], sizeof(NX_Color)) == 0);
+    }
+
+    /* --- Bounds of the instances --- */
+
+    bool bounds = CheckBounds(aabb, transform, instances, positions, rotations, scales);
+
+    printf("%8zu | %-9s | %8zu | %11.3f | %14.3f | %-6s | %s\n", count, name, visibleCount,
+           scalarTime, referenceTime, bounds ? "yes" : "NO", match ? "yes" : "NO");
+
+    return match && bounds;
+}
+
+/** Culls on the GPU and reads the indirect commands back, skipped without a GL context */
+static bool RunGpuCase(const INX_Frustum& frustum, const BenchInstances& instances)
+{
+    NX_AppDesc desc{};
+    desc.flags = NX_FLAG_WINDOW_HIDDEN;
+    desc.workerCount = -1;
+
+    if (!NX_InitEx("Instance culling", 64, 64, &desc)) {
+        printf("GPU check skipped, no GL context\n");
+        return true;
+    }
+
+    const size_t count = instances.positions.size();
+    const uint32_t elementCounts[] = { 36, 6 };
+
+    const NX_BoundingBox3D aabb = { NX_VEC3(-0.5f, 0.0f, -0.5f), NX_VEC3(0.5f, 2.0f, 0.5f) };
+    const INX_BoundingSphere3D drawSphere = INX_GetDrawSphere(aabb, NX_TRANSFORM_IDENTITY);
+
+    std::vector<uint32_t> visible(count);
+    size_t expected = INX_CullInstances(
+        frustum, drawSphere, instances.positions.data(), instances.rotations.data(),
+        instances.scales.data(), count, visible.data()
+    );
+
+    NX_InstanceData attributes = NX_INSTANCE_POSITION | NX_INSTANCE_ROTATION | NX_INSTANCE_SCALE;
+    NX_InstanceBuffer* buffer = NX_CreateInstanceBuffer(attributes, count);
+    NX_UpdateInstanceBuffer(buffer, NX_INSTANCE_POSITION, 0, count, instances.positions.data());
+    NX_UpdateInstanceBuffer(buffer, NX_INSTANCE_ROTATION, 0, count, instances.rotations.data());
+    NX_UpdateInstanceBuffer(buffer, NX_INSTANCE_SCALE, 0, count, instances.scales.data());
+
+    bool match = false;
+    INX_InstanceCulling::Command commands[2]{};
+    {
+        gpu::Pipeline pipeline;
+        INX_InstanceCulling culling;
+
+        int slot = culling.Enqueue(*buffer, static_cast<int>(count), drawSphere, false);
+        for (uint32_t elementCount : elementCounts) {
+            culling.PushCommand(elementCount);
+        }
+
+        culling.Dispatch(pipeline, frustum);
+        match = culling.ReadCommands(pipeline, slot, commands);
+    }
+
+    // Spheres touching a plane may be classified differently by the GPU rounding
+    auto closeTo = [](uint32_t value, size_t reference) {
+        return (value + 2 >= reference) && (value <= reference + 2);
+    };
+
+    for (int i = 0; i < 2 && match; i++) {
+        match = (commands[i].count == elementCounts[i])
+             && closeTo(commands[i].instanceCount, expected)
+             && (commands[i].instanceCount == commands[0].instanceCount)
+             && (commands[i].first == 0 && commands[i].baseVertex == 0 && commands[i].baseInstance == 0);
+    }
+
+    printf("GPU commands: %u/%u visible, %u/%u elements, %s\n",
+           commands[0].instanceCount, static_cast<uint32_t>(expected),
+           commands[0].count, elementCounts[0], match ? "match" : "MISMATCH");
+
+    NX_DestroyInstanceBuffer(buffer);
+    NX_Quit();
+
+    return match;
+}
+
+// ============================================================================
+// ENTRY POINT
+// ============================================================================
+
+int main(void)
+{
+    const NX_Vec3 viewPosition = NX_VEC3(0.0f, 10.0f, -520.0f);
+    NX_Mat4 view = NX_Mat4LookAt(viewPosition, NX_VEC3_ZERO, NX_VEC3_UP);
+    NX_Mat4 proj = NX_Mat4Perspective(60.0f * static_cast<float>(NX_DEG2RAD), 16.0f / 9.0f, 0.1f, 400.0f);
+    const INX_Frustum frustum(view * proj);
+
+    const size_t counts[] = { 1000, 10000, 100000 };
+    const int iterations = 20;
+
+    NX_RandGen gen = NX_CreateRandGenTemp(1337);
+    bool allMatch = true;
+
+    printf("%8s | %-9s | %8s | %11s | %14s | %-6s | %s\n",
+           "count", "attribs", "visible", "scalar (ms)", "reference (ms)", "bounds", "match");
+
+    for (size_t count : counts)
+    {
+        BenchInstances instances{};
+        GenInstances(instances, count, &gen);
+
+        const NX_Vec3* positions = instances.positions.data();
+        const NX_Quat* rotations = instances.rotations.data();
+        const NX_Vec3* scales = instances.scales.data();
+
+        allMatch = RunCase("pos", frustum, instances, positions, nullptr, nullptr, iterations) && allMatch;
+        allMatch = RunCase("pos+rot", frustum, instances, positions, rotations, nullptr, iterations) && allMatch;
+        allMatch = RunCase("all", frustum, instances, positions, rotations, scales, iterations) && allMatch;
+    }
+
+    {
+        BenchInstances instances{};
+        GenInstances(instances, 10000, &gen);
+        allMatch = RunGpuCase(frustum, instances) && allMatch;
+    }
+
+    return allMatch ? 0 : 1;
+}
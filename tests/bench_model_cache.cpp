@@ -0,0 +1,248 @@
+/* bench_model_cache.cpp -- Headless validation and benchmark of the binary model cache
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+/*
+ * Imports the test models up to their decoded images, without any GPU work,
+ * saves them as model caches in memory and loads the caches back.
+ *
+ * The loaded model data must match the import: vertices, indices, materials,
+ * decoded maps and skeleton, along with the animation keys. Reports the time
+ * taken by the import and by the cache load, with the size of each cache.
+ */
+
+#include <NX/Nexium.h>
+
+#include "Importer/AnimationImporter.hpp"
+#include "Importer/ModelImporter.hpp"
+#include "Importer/SceneImporter.hpp"
+#include "Importer/ModelCache.hpp"
+#include "INX_JobSystem.hpp"
+#include "NX_Filesystem.hpp"
+#include "INX_Utils.hpp"
+#include "bench_common.hpp"
+
+#include <cstring>
+#include <cstdio>
+#include <chrono>
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+static const char* Models[] = {
+    "models/CesiumMan.glb",
+    "models/DamagedHelmet.glb",
+    "models/MultiUVTest.glb",
+};
+
+static bool SameBytes(const void* a, const void* b, size_t size)
+{
+    return (size == 0) || (a != nullptr && b != nullptr && std::memcmp(a, b, size) == 0);
+}
+
+static bool SameMeshes(const import::ModelData& a, const import::ModelData& b)
+{
+    if (a.meshes.GetSize() != b.meshes.GetSize()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < a.meshes.GetSize(); i++) {
+        const NX_MeshData& ma = a.meshes[i].data;
+        const NX_MeshData& mb = b.meshes[i].data;
+        if (ma.vertexCount != mb.vertexCount || ma.indexCount != mb.indexCount) return false;
+        if (!SameBytes(ma.vertices, mb.vertices, ma.vertexCount * sizeof(NX_Vertex3D))) return false;
+        if (!SameBytes(ma.indices, mb.indices, ma.indexCount * sizeof(uint32_t))) return false;
+        if (a.meshMaterials[i] != b.meshMaterials[i]) return false;
+    }
+
+    return true;
+}
+
+static bool SameMaterials(const import::ModelData& a, const import::ModelData& b)
+{
+    if (a.materials.GetSize() != b.materials.GetSize()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < a.materials.GetSize(); i++) {
+        const NX_Material& ma = a.materials[i].material;
+        const NX_Material& mb = b.materials[i].material;
+        if (!SameBytes(&ma.albedo.color, &mb.albedo.color, sizeof(NX_Color))) return false;
+        if (!SameBytes(&ma.emission.color, &mb.emission.color, sizeof(NX_Color))) return false;
+        if (ma.emission.energy != mb.emission.energy) return false;
+        if (ma.orm.roughness != mb.orm.roughness || ma.orm.metalness != mb.orm.metalness) return false;
+        if (ma.normal.scale != mb.normal.scale) return false;
+        if (ma.shading != mb.shading || ma.blend != mb.blend || ma.cull != mb.cull) return false;
+    }
+
+    return true;
+}
+
+static bool SameImages(const import::ModelData& a, const import::ModelData& b, int* maps)
+{
+    for (size_t i = 0; i < a.materials.GetSize(); i++) {
+        for (int m = 0; m < import::ModelData::MAP_COUNT; m++) {
+            const NX_Image& ia = a.materials[i].images[m].image;
+            const NX_Image& ib = b.materials[i].images[m].image;
+            if ((ia.pixels == nullptr) != (ib.pixels == nullptr)) return false;
+            if (ia.pixels == nullptr) continue;
+            if (ia.w != ib.w || ia.h != ib.h || ia.format != ib.format) return false;
+            if (a.materials[i].images[m].wrap != b.materials[i].images[m].wrap) return false;
+            size_t bytes = size_t(NX_GetPixelBytes(ia.format)) * ia.w * ia.h;
+            if (!SameBytes(ia.pixels, ib.pixels, bytes)) return false;
+            *maps += 1;
+        }
+    }
+
+    return true;
+}
+
+static bool SameSkeleton(const NX_Skeleton& a, const NX_Skeleton& b)
+{
+    size_t count = static_cast<size_t>(a.boneCount);
+
+    return (a.boneCount == b.boneCount)
+        && SameBytes(a.bones, b.bones, count * sizeof(NX_BoneInfo))
+        && SameBytes(a.boneOffsets, b.boneOffsets, count * sizeof(NX_Mat4))
+        && SameBytes(a.bindLocal, b.bindLocal, count * sizeof(NX_Mat4))
+        && SameBytes(a.bindPose, b.bindPose, count * sizeof(NX_Mat4));
+}
+
+static bool SameAnimations(const NX_AnimationLib* a, const NX_AnimationLib* b)
+{
+    if (a == nullptr || b == nullptr || a->count != b->count) {
+        return false;
+    }
+
+    for (int i = 0; i < a->count; i++) {
+        const NX_Animation& aa = a->animations[i];
+        const NX_Animation& ab = b->animations[i];
+        if (aa.channelCount != ab.channelCount || aa.boneCount != ab.boneCount) return false;
+        if (aa.duration != ab.duration || aa.ticksPerSecond != ab.ticksPerSecond) return false;
+        if (std::strcmp(aa.name, ab.name) != 0) return false;
+        for (uint32_t c = 0; c < aa.channelCount; c++) {
+            const NX_AnimationChannel& ca = aa.channels[c];
+            const NX_AnimationChannel& cb = ab.channels[c];
+            if (ca.boneIndex != cb.boneIndex) return false;
+            if (ca.positionKeyCount != cb.positionKeyCount) return false;
+            if (ca.rotationKeyCount != cb.rotationKeyCount) return false;
+            if (ca.scaleKeyCount != cb.scaleKeyCount) return false;
+            if (!SameBytes(ca.positionKeys, cb.positionKeys, ca.positionKeyCount * sizeof(NX_Vec3Key))) return false;
+            if (!SameBytes(ca.rotationKeys, cb.rotationKeys, ca.rotationKeyCount * sizeof(NX_QuatKey))) return false;
+            if (!SameBytes(ca.scaleKeys, cb.scaleKeys, ca.scaleKeyCount * sizeof(NX_Vec3Key))) return false;
+        }
+    }
+
+    return true;
+}
+
+// ============================================================================
+// ENTRY POINT
+// ============================================================================
+
+int main(void)
+{
+    if (!INX_FilesystemState_Init() || !NX_AddSearchPath(RESOURCES_PATH, true)) {
+        printf("Failed to mount the test resources\n");
+        return 1;
+    }
+
+    INX_Jobs.Init(-1);
+
+    for (const char* path : Models)
+    {
+        printf("%s\n", path);
+
+        size_t fileSize = 0;
+        void* fileData = NX_LoadFile(path, &fileSize);
+        if (fileData == nullptr) {
+            Check(false, "the model file is found");
+            continue;
+        }
+
+        /* --- Import, the maps keep their images --- */
+
+        import::ModelData imported;
+        imported.shareTextures = false;
+
+        NX_AnimationLib* animLib = nullptr;
+        bool importOk = false;
+
+        auto start = std::chrono::steady_clock::now();
+        {
+            import::SceneImporter importer(fileData, fileSize, INX_GetFileExt(path));
+            if (importer.IsValid()) {
+                importOk = import::ModelImporter(importer).LoadModel(&imported);
+                if (importOk && importer.GetAnimationCount() > 0) {
+                    animLib = import::AnimationImporter(importer).LoadAnimationLib();
+                }
+            }
+        }
+        double importMs = Elapsed(start);
+
+        NX_Free(fileData);
+        Check(importOk, "the model is imported");
+
+        /* --- Save and load back --- */
+
+        util::DynamicArray<uint8_t> cache{};
+        Check(import::ModelCache::Save(&cache, imported, animLib), "the cache is saved");
+        Check(import::ModelCache::IsCache(cache.GetData(), cache.GetSize()), "the cache is recognized");
+
+        import::ModelData loaded;
+
+        start = std::chrono::steady_clock::now();
+        bool loadOk = import::ModelCache::Load(&loaded, cache.GetData(), cache.GetSize());
+        double loadMs = Elapsed(start);
+
+        Check(loadOk, "the cache is loaded");
+        Check(loaded.cache == cache.GetData(), "the loaded data points into the cache");
+
+        int maps = 0;
+        Check(SameMeshes(imported, loaded), "meshes match the import");
+        Check(SameMaterials(imported, loaded), "materials match the import");
+        Check(SameImages(imported, loaded, &maps), "decoded maps match the import");
+        Check(SameSkeleton(imported.skeleton, loaded.skeleton), "the skeleton matches the import");
+
+        /* --- Animations --- */
+
+        if (animLib != nullptr) {
+            start = std::chrono::steady_clock::now();
+            NX_AnimationLib* cachedLib = import::ModelCache::LoadAnimationLib(cache.GetData(), cache.GetSize());
+            double animMs = Elapsed(start);
+
+            Check(SameAnimations(animLib, cachedLib), "animation keys match the import");
+            printf("  %i animations loaded in %.2f ms\n", animLib->count, animMs);
+
+            NX_DestroyAnimationLib(cachedLib);
+            NX_DestroyAnimationLib(animLib);
+        }
+
+        /* --- Rejections --- */
+
+        cache[8] ^= 0xFF;
+        {
+            import::ModelData outdated;
+            Check(!import::ModelCache::Load(&outdated, cache.GetData(), cache.GetSize()), "an outdated cache is rejected");
+        }
+        cache[8] ^= 0xFF;
+        {
+            import::ModelData truncated;
+            Check(!import::ModelCache::Load(&truncated, cache.GetData(), cache.GetSize() / 2), "a truncated cache is rejected");
+        }
+
+        printf("  %zu meshes, %i maps, %.1f MB cache, %.1f ms import, %.2f ms cache load\n",
+               loaded.meshes.GetSize(), maps, cache.GetSize() / (1024.0 * 1024.0), importMs, loadMs);
+    }
+
+    INX_Jobs.Quit();
+
+    printf("%s\n", Failures ? "FAILED" : "All checks passed");
+
+    return Failures ? 1 : 0;
+}
@@ -0,0 +1,161 @@
+/* bench_pixel_convert.cpp -- Headless validation and benchmark of the pixel conversion kernels
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+/*
+ * Converts a random image between every pair of pixel formats:
+ *
+ *   - With the previous per-pixel path, 'NX_ReadPixel' then 'NX_WritePixel'.
+ *   - With the row kernel alone, on the calling thread.
+ *   - With 'INX_ConvertPixels', split across the job system.
+ *
+ * Throughputs are reported in MB/s, counting the bytes read and written.
+ * Kernels must produce exactly the same bytes as the per-pixel path.
+ */
+
+#include <NX/Nexium.h>
+
+#include "INX_PixelConvert.hpp"
+#include "INX_JobSystem.hpp"
+#include "bench_common.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <vector>
+
+// ============================================================================
+// BENCH DATA
+// ============================================================================
+
+static const NX_PixelFormat FORMATS[] = {
+    NX_PIXEL_FORMAT_R8, NX_PIXEL_FORMAT_RG8, NX_PIXEL_FORMAT_RGB8, NX_PIXEL_FORMAT_RGBA8,
+    NX_PIXEL_FORMAT_R16F, NX_PIXEL_FORMAT_RG16F, NX_PIXEL_FORMAT_RGB16F, NX_PIXEL_FORMAT_RGBA16F,
+    NX_PIXEL_FORMAT_R32F, NX_PIXEL_FORMAT_RG32F, NX_PIXEL_FORMAT_RGB32F, NX_PIXEL_FORMAT_RGBA32F,
+};
+
+static const char* FORMAT_NAMES[] = {
+    "INVALID", "R8", "RG8", "RGB8", "RGBA8",
+    "R16F", "RG16F", "RGB16F", "RGBA16F",
+    "R32F", "RG32F", "RGB32F", "RGBA32F",
+};
+
+static std::vector<uint8_t> GenPixels(NX_PixelFormat format, size_t count, NX_RandGen* gen)
+{
+    // Float values go a bit out of [0, 1] to exercise the clamps, with a few out of the half range
+    std::vector<uint8_t> pixels(count * NX_GetPixelBytes(format));
+
+    for (size_t i = 0; i < count; i++) {
+        NX_Color color = NX_COLOR(
+            NX_RandRangeFloat(gen, -0.25f, 1.25f),
+            NX_RandRangeFloat(gen, -0.25f, 1.25f),
+            NX_RandRangeFloat(gen, -0.25f, 1.25f),
+            NX_RandRangeFloat(gen, 0.0f, 1.0f)
+        );
+        if (i % 997 == 0) {
+            color.r = 1e6f;
+            color.g = -1e6f;
+        }
+        NX_WritePixel(pixels.data(), static_cast<int>(i), format, color);
+    }
+
+    return pixels;
+}
+
+static double GetThroughput(size_t bytes, double milliseconds)
+{
+    return (milliseconds > 0.0) ? (bytes / (1024.0 * 1024.0)) / (milliseconds / 1000.0) : 0.0;
+}
+
+// ============================================================================
+// CASES
+// ============================================================================
+
+static bool RunPair(NX_PixelFormat srcFormat, NX_PixelFormat dstFormat, const std::vector<uint8_t>& src,
+                    int width, int height, int referenceRows, int iterations)
+{
+    const size_t count = static_cast<size_t>(width) * height;
+    const size_t referenceCount = static_cast<size_t>(width) * referenceRows;
+    const size_t pairBytes = NX_GetPixelBytes(srcFormat) + NX_GetPixelBytes(dstFormat);
+
+    std::vector<uint8_t> expected(referenceCount * NX_GetPixelBytes(dstFormat));
+    std::vector<uint8_t> serial(count * NX_GetPixelBytes(dstFormat));
+    std::vector<uint8_t> parallel(count * NX_GetPixelBytes(dstFormat));
+
+    INX_PixelRowKernel kernel = INX_GetPixelRowKernel(srcFormat, dstFormat);
+    if (kernel == nullptr) {
+        return false;
+    }
+
+    /* --- Per-pixel path, on the first rows only --- */
+
+    double referenceTime = Measure([&]() {
+        for (size_t i = 0; i < referenceCount; i++) {
+            NX_WritePixel(expected.data(), static_cast<int>(i), dstFormat, NX_ReadPixel(src.data(), static_cast<int>(i), srcFormat));
+        }
+    });
+
+    /* --- Kernels, best of all iterations --- */
+
+    double serialTime = 1e30, parallelTime = 1e30;
+
+    for (int it = 0; it < iterations; it++) {
+        serialTime = std::min(serialTime, Measure([&]() { kernel(src.data(), serial.data(), count); }));
+        parallelTime = std::min(parallelTime, Measure([&]() {
+            INX_ConvertPixels(src.data(), srcFormat, parallel.data(), dstFormat, width, height);
+        }));
+    }
+
+    bool match = std::memcmp(expected.data(), serial.data(), expected.size()) == 0
+              && std::memcmp(serial.data(), parallel.data(), serial.size()) == 0;
+
+    printf("%-8s | %-8s | %12.1f | %12.1f | %12.1f | %s\n",
+           FORMAT_NAMES[srcFormat], FORMAT_NAMES[dstFormat],
+           GetThroughput(referenceCount * pairBytes, referenceTime),
+           GetThroughput(count * pairBytes, serialTime),
+           GetThroughput(count * pairBytes, parallelTime),
+           match ? "yes" : "NO");
+
+    return match;
+}
+
+// ============================================================================
+// ENTRY POINT
+// ============================================================================
+
+int main(void)
+{
+    const int width = 2048;
+    const int height = 2048;
+    const int referenceRows = 128;
+    const int iterations = 5;
+
+    if (!INX_Jobs.Init(-1)) {
+        return 1;
+    }
+
+    printf("Image: %ix%i, worker threads: %i (+ calling thread)\n", width, height, INX_Jobs.GetWorkerCount());
+    printf("%-8s | %-8s | %12s | %12s | %12s | %s\n", "src", "dst", "pixel (MB/s)", "row (MB/s)", "jobs (MB/s)", "match");
+
+    NX_RandGen gen = NX_CreateRandGenTemp(1337);
+    bool allMatch = true;
+
+    for (NX_PixelFormat srcFormat : FORMATS)
+    {
+        std::vector<uint8_t> src = GenPixels(srcFormat, static_cast<size_t>(width) * height, &gen);
+
+        for (NX_PixelFormat dstFormat : FORMATS) {
+            if (dstFormat != srcFormat) {
+                allMatch = RunPair(srcFormat, dstFormat, src, width, height, referenceRows, iterations) && allMatch;
+            }
+        }
+    }
+
+    INX_Jobs.Quit();
+
+    return allMatch ? 0 : 1;
+}
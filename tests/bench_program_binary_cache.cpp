@@ -0,0 +1,314 @@
+/* bench_program_binary_cache.cpp -- Headless validation and benchmark of the program binary cache
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+/*
+ * Drives the program binary cache through a fake provider: programs are
+ * "linked" into binaries derived from their sources, and cache files live in
+ * memory. No GPU or write directory is needed.
+ *
+ * Validates the key derivation (sources, defines and stages), the round trip
+ * of the file format, and the invalidation of entries written by another
+ * driver or engine version, truncated or damaged files, and binaries rejected
+ * by the driver, which must all fall back to compiling and be stored again.
+ *
+ * Reports the cost of looking up a program on hits, for sources and binaries
+ * of the size of the scene shaders.
+ */
+
+#include <NX/Nexium.h>
+
+#include "INX_ProgramBinaryCache.hpp"
+#include "bench_common.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// FAKE PROVIDER
+// ============================================================================
+
+static constexpr GLenum FakeFormat = 0x1234;
+
+static struct FakeDriver {
+    std::map<std::string, std::vector<uint8_t>> files;
+    std::map<GLuint, std::vector<uint8_t>> programs;
+    std::string version = "4.6 fake 1.0";
+    bool rejectBinaries = false;
+    int formatCount = 1;
+    GLuint nextProgram = 1;
+} Fake;
+
+static const char* FakeGetDriverString(GLenum name)
+{
+    switch (name) {
+    case GL_VENDOR: return "Nexium";
+    case GL_RENDERER: return "Fake renderer";
+    default: return Fake.version.c_str();
+    }
+}
+
+static int FakeGetBinaryFormats(GLenum* formats, int maxCount)
+{
+    for (int i = 0; i < Fake.formatCount && i < maxCount; i++) {
+        formats[i] = FakeFormat + i;
+    }
+    return Fake.formatCount;
+}
+
+static GLuint FakeLoadBinary(GLenum format, const void* binary, size_t size)
+{
+    if (Fake.rejectBinaries || format != FakeFormat) {
+        return 0;
+    }
+
+    GLuint id = Fake.nextProgram++;
+    const uint8_t* bytes = static_cast<const uint8_t*>(binary);
+    Fake.programs[id].assign(bytes, bytes + size);
+
+    return id;
+}
+
+static bool FakeGetBinary(GLuint program, GLenum* format, util::DynamicArray<uint8_t>* binary)
+{
+    auto it = Fake.programs.find(program);
+    if (it == Fake.programs.end() || !binary->Resize(it->second.size())) {
+        return false;
+    }
+
+    std::memcpy(binary->GetData(), it->second.data(), it->second.size());
+    *format = FakeFormat;
+
+    return true;
+}
+
+static void* FakeReadFile(const char* path, size_t* size)
+{
+    auto it = Fake.files.find(path);
+    if (it == Fake.files.end()) {
+        return nullptr;
+    }
+
+    void* data = NX_Malloc(it->second.size());
+    std::memcpy(data, it->second.data(), it->second.size());
+    *size = it->second.size();
+
+    return data;
+}
+
+static bool FakeWriteFile(const char* path, const void* data, size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    Fake.files[path].assign(bytes, bytes + size);
+    return true;
+}
+
+static bool FakeDeleteFile(const char* path)
+{
+    return Fake.files.erase(path) > 0;
+}
+
+static constexpr INX_ProgramBinaryProvider FakeProvider = {
+    .getDriverString = FakeGetDriverString,
+    .getBinaryFormats = FakeGetBinaryFormats,
+    .loadBinary = FakeLoadBinary,
+    .getBinary = FakeGetBinary,
+    .readFile = FakeReadFile,
+    .writeFile = FakeWriteFile,
+    .deleteFile = FakeDeleteFile
+};
+
+/** "Links" a program, its binary is derived from the sources of its stages */
+static GLuint FakeLink(const INX_ProgramStage& vert, const INX_ProgramStage& frag, size_t binarySize)
+{
+    std::vector<uint8_t> binary(binarySize);
+    const std::string sources = vert.GetSource() + frag.GetSource();
+
+    for (size_t i = 0; i < binarySize; i++) {
+        binary[i] = static_cast<uint8_t>(sources[i % sources.size()] ^ (i * 31));
+    }
+
+    GLuint id = Fake.nextProgram++;
+    Fake.programs[id] = std::move(binary);
+
+    return id;
+}
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+/** Loads the program from the cache, or links and stores it, like CreateProgram() */
+static GLuint GetProgram(INX_ProgramBinaryCache& cache, const INX_ProgramStage& vert, const INX_ProgramStage& frag, size_t binarySize)
+{
+    uint64_t key = cache.ComputeKey({&vert, &frag});
+
+    if (GLuint id = cache.Load(key)) {
+        return id;
+    }
+
+    GLuint id = FakeLink(vert, frag, binarySize);
+    cache.Store(key, id);
+
+    return id;
+}
+
+static std::string CacheFile(const INX_ProgramBinaryCache& cache, const INX_ProgramStage& vert, const INX_ProgramStage& frag)
+{
+    char path[64];
+    snprintf(path, sizeof(path), "%s/%016llx.bin", INX_ProgramBinaryCache::Directory,
+             static_cast<unsigned long long>(cache.ComputeKey({&vert, &frag})));
+    return path;
+}
+
+static std::string GenSource(size_t size, int seed)
+{
+    std::string source = "uniform float uSeed" + std::to_string(seed) + ";\n";
+    while (source.size() < size) {
+        source += "vec4 f" + std::to_string(source.size()) + "(vec4 v) { return v * " + std::to_string(seed) + ".0; }\n";
+    }
+    return source;
+}
+
+// ============================================================================
+// ENTRY POINT
+// ============================================================================
+
+int main(void)
+{
+    const size_t sourceSize = 48 * 1024;
+    const size_t binarySize = 256 * 1024;
+    const int variantCount = 32;
+
+    const std::string vertSource = GenSource(sourceSize, 1);
+    const std::string fragSource = GenSource(sourceSize, 2);
+
+    INX_ProgramStage vert(GL_VERTEX_SHADER, vertSource.c_str());
+    INX_ProgramStage fragA(GL_FRAGMENT_SHADER, fragSource.c_str(), {"GENERIC"});
+    INX_ProgramStage fragB(GL_FRAGMENT_SHADER, fragSource.c_str(), {"PREPASS"});
+
+    std::vector<INX_ProgramStage> variants;
+    for (int i = 0; i < variantCount; i++) {
+        std::string define = "VARIANT " + std::to_string(i);
+        variants.emplace_back(GL_FRAGMENT_SHADER, fragSource.c_str(), std::initializer_list<const char*>{define.c_str()});
+    }
+
+    INX_ProgramBinaryCache cache;
+    cache.Init(FakeProvider);
+
+    /* --- Key derivation --- */
+
+    printf("Key derivation\n");
+    {
+        INX_ProgramStage fragA2(GL_FRAGMENT_SHADER, fragSource.c_str(), {"GENERIC"});
+        INX_ProgramStage fragAsVert(GL_VERTEX_SHADER, fragSource.c_str(), {"GENERIC"});
+        INX_ProgramStage fragEdited(GL_FRAGMENT_SHADER, (fragSource + " ").c_str(), {"GENERIC"});
+
+        uint64_t key = cache.ComputeKey({&vert, &fragA});
+        Check(cache.IsEnabled(), "cache enabled with one binary format");
+        Check(key == cache.ComputeKey({&vert, &fragA2}), "same sources and defines give the same key");
+        Check(key != cache.ComputeKey({&vert, &fragB}), "another define gives another key");
+        Check(key != cache.ComputeKey({&vert, &fragEdited}), "an edited source gives another key");
+        Check(key != cache.ComputeKey({&vert, &fragAsVert}), "another stage gives another key");
+        Check(key != cache.ComputeKey({&fragA, &vert}), "the order of the stages is part of the key");
+    }
+
+    /* --- Cold and warm runs --- */
+
+    printf("Cold and warm runs\n");
+    {
+        for (const INX_ProgramStage& frag : variants) GetProgram(cache, vert, frag, binarySize);
+        Check(cache.GetStats().misses == variantCount && cache.GetStats().stored == variantCount, "cold run compiles and stores every program");
+
+        GLuint linked = FakeLink(vert, variants[0], binarySize);
+
+        cache.Init(FakeProvider);
+        GLuint loaded = GetProgram(cache, vert, variants[0], binarySize);
+        for (int i = 1; i < variantCount; i++) GetProgram(cache, vert, variants[i], binarySize);
+
+        Check(cache.GetStats().hits == variantCount && cache.GetStats().misses == 0, "warm run loads every program");
+        Check(Fake.programs[loaded] == Fake.programs[linked], "loaded binary is the stored one");
+    }
+
+    /* --- Invalidation --- */
+
+    printf("Invalidation\n");
+    {
+        const std::string path = CacheFile(cache, vert, variants[1]);
+
+        auto expectRecovery = [&](const char* what, int INX_ProgramBinaryCache::Stats::* counter) {
+            cache.Init(FakeProvider);
+            GetProgram(cache, vert, variants[1], binarySize);
+            const INX_ProgramBinaryCache::Stats stats = cache.GetStats();
+            GetProgram(cache, vert, variants[1], binarySize);
+            bool ok = (stats.misses == 1 && stats.*counter == 1 && stats.stored == 1 && cache.GetStats().hits == 1);
+            Check(ok, what);
+        };
+
+        Fake.files[path][sizeof(INX_ProgramBinaryHeader) + 100] ^= 0xFF;
+        expectRecovery("damaged binary is invalidated, compiled and stored again", &INX_ProgramBinaryCache::Stats::invalidated);
+
+        Fake.files[path].resize(Fake.files[path].size() / 2);
+        expectRecovery("truncated file is invalidated", &INX_ProgramBinaryCache::Stats::invalidated);
+
+        Fake.files[path][4] = 0xEE;
+        expectRecovery("file of another engine version is invalidated", &INX_ProgramBinaryCache::Stats::invalidated);
+
+        Fake.files[CacheFile(cache, vert, variants[2])] = Fake.files[path];
+        cache.Init(FakeProvider);
+        GetProgram(cache, vert, variants[2], binarySize);
+        Check(cache.GetStats().invalidated == 1, "file of another program is invalidated");
+
+        Fake.rejectBinaries = true;
+        cache.Init(FakeProvider);
+        GetProgram(cache, vert, variants[1], binarySize);
+        Fake.rejectBinaries = false;
+        GetProgram(cache, vert, variants[1], binarySize);
+        const INX_ProgramBinaryCache::Stats& stats = cache.GetStats();
+        Check(stats.rejected == 1 && stats.stored == 1 && stats.hits == 1, "binary rejected by the driver is compiled and stored again");
+
+        uint64_t driver = cache.GetDriverHash();
+        size_t fileCount = Fake.files.size();
+        Fake.version = "4.6 fake 2.0";
+        expectRecovery("driver update invalidates the entry", &INX_ProgramBinaryCache::Stats::invalidated);
+        Check(cache.GetDriverHash() != driver, "driver identity includes its version");
+        Check(Fake.files.size() == fileCount, "entries are replaced in place, not accumulated");
+
+        Fake.formatCount = 0;
+        cache.Init(FakeProvider);
+        Check(!cache.IsEnabled() && cache.Load(cache.ComputeKey({&vert, &variants[1]})) == 0, "cache disabled without binary formats");
+        Fake.formatCount = 1;
+    }
+
+    /* --- Lookup cost --- */
+
+    printf("Lookup cost\n");
+    {
+        cache.Init(FakeProvider);
+        for (const INX_ProgramStage& frag : variants) GetProgram(cache, vert, frag, binarySize);
+
+        cache.Init(FakeProvider);
+
+        const int rounds = 8;
+        double ms = Measure([&]() {
+            for (int r = 0; r < rounds; r++) {
+                for (const INX_ProgramStage& frag : variants) cache.Load(cache.ComputeKey({&vert, &frag}));
+            }
+        });
+
+        double us = 1000.0 * ms / (rounds * variantCount);
+        printf("  %i hits, %.1f us per program (sources: 2 x %zu KB, binary: %zu KB)\n",
+               cache.GetStats().hits, us, sourceSize / 1024, binarySize / 1024);
+    }
+
+    printf("%s\n", Failures ? "FAILED" : "All checks passed");
+
+    return Failures ? 1 : 0;
+}
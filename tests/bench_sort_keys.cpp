@@ -0,0 +1,263 @@
+/* bench_sort_keys.cpp -- Headless validation and benchmark of the draw call sort keys
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+/*
+ * Sorts a synthetic opaque category the way 'INX_SortDrawCalls' does, and
+ * compares it to the previous comparator sort on distances:
+ *
+ *   - The radix sort of each policy must give the same order as a stable
+ *     comparison sort of the same keys.
+ *   - Front-to-back keys must order the draws by increasing distance.
+ *   - The analytic farthest corner distance must match the 8 corners one.
+ *
+ * The program and material columns count the state changes issued when
+ * drawing in the resulting order, the state policy minimizes them.
+ */
+
+#include <NX/Nexium.h>
+
+#include "Detail/Util/BucketArray.hpp"
+#include "INX_DrawPacking.hpp"
+#include "bench_common.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+// ============================================================================
+// BENCH DATA
+// ============================================================================
+
+enum BenchCategory { BENCH_OPAQUE, BENCH_CATEGORY_COUNT };
+
+struct BenchDraw {
+    int program;
+    int material;
+    float distanceSq;
+    uint32_t state;
+};
+
+static void GenDraws(std::vector<BenchDraw>& draws, size_t count, int programCount, int materialCount, NX_RandGen* gen)
+{
+    const NX_Vec3 viewPosition = NX_VEC3(0.0f, 10.0f, -520.0f);
+    draws.resize(count);
+
+    for (size_t i = 0; i < count; i++) {
+        BenchDraw& draw = draws[i];
+        draw.program = NX_RandRangeInt(gen, 0, programCount);
+        draw.material = NX_RandRangeInt(gen, 0, materialCount);
+        NX_Vec3 position = NX_VEC3(
+            NX_RandRangeFloat(gen, -500.0f, 500.0f),
+            NX_RandRangeFloat(gen, -20.0f, 20.0f),
+            NX_RandRangeFloat(gen, -500.0f, 500.0f)
+        );
+        draw.distanceSq = NX_Vec3DistanceSq(viewPosition, position);
+        draw.state = INX_PackSortState(
+            INX_HashMix(0, static_cast<uint64_t>(draw.program)),
+            INX_HashMix(0, static_cast<uint64_t>(draw.material))
+        );
+    }
+}
+
+// ============================================================================
+// CHECKS
+// ============================================================================
+
+static void CountStateChanges(const std::vector<BenchDraw>& draws, const std::vector<int>& order, int* programs, int* materials)
+{
+    *programs = 0;
+    *materials = 0;
+
+    int program = -1;
+    int material = -1;
+
+    for (int index : order) {
+        const BenchDraw& draw = draws[index];
+        if (draw.program != program) {
+            program = draw.program;
+            (*programs)++;
+        }
+        if (draw.material != material) {
+            material = draw.material;
+            (*materials)++;
+        }
+    }
+}
+
+static bool CheckFarthestDistance(NX_RandGen* gen, int iterations)
+{
+    for (int it = 0; it < iterations; it++)
+    {
+        NX_BoundingBox3D box = { NX_VEC3(-0.5f, 0.0f, -1.0f), NX_VEC3(1.5f, 2.0f, 0.25f) };
+        NX_Vec3 viewPosition = NX_VEC3(
+            NX_RandRangeFloat(gen, -50.0f, 50.0f),
+            NX_RandRangeFloat(gen, -50.0f, 50.0f),
+            NX_RandRangeFloat(gen, -50.0f, 50.0f)
+        );
+
+        NX_Transform transform = NX_TRANSFORM_IDENTITY;
+        transform.translation = NX_VEC3(
+            NX_RandRangeFloat(gen, -20.0f, 20.0f),
+            NX_RandRangeFloat(gen, -20.0f, 20.0f),
+            NX_RandRangeFloat(gen, -20.0f, 20.0f)
+        );
+        transform.rotation = NX_QuatFromEuler(NX_VEC3(
+            NX_RandRangeFloat(gen, 0.0f, NX_TAU),
+            NX_RandRangeFloat(gen, 0.0f, NX_TAU),
+            NX_RandRangeFloat(gen, 0.0f, NX_TAU)
+        ));
+        transform.scale = NX_VEC3(
+            NX_RandRangeFloat(gen, 0.25f, 3.0f),
+            NX_RandRangeFloat(gen, 0.25f, 3.0f),
+            NX_RandRangeFloat(gen, -3.0f, -0.25f)
+        );
+
+        float expected = 0.0f;
+        for (int c = 0; c < 8; c++) {
+            NX_Vec3 corner = NX_VEC3(
+                (c & 1) ? box.max.x : box.min.x,
+                (c & 2) ? box.max.y : box.min.y,
+                (c & 4) ? box.max.z : box.min.z
+            );
+            expected = NX_MAX(expected, NX_Vec3DistanceSq(viewPosition, corner * transform));
+        }
+
+        float distanceSq = INX_GetFarthestDistanceSq(viewPosition, box, transform);
+        if (fabsf(distanceSq - expected) > expected * 1e-4f + 1e-4f) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// ============================================================================
+// CASES
+// ============================================================================
+
+static bool RunDistanceCase(const std::vector<BenchDraw>& draws, int iterations)
+{
+    util::BucketArray<int, BenchCategory, BENCH_CATEGORY_COUNT> sorted{};
+    std::vector<int> order;
+
+    double sortTime = 0.0;
+    for (int it = 0; it < iterations; it++) {
+        sorted.Clear();
+        for (size_t i = 0; i < draws.size(); i++) {
+            sorted.Push(BENCH_OPAQUE, static_cast<int>(i));
+        }
+        sortTime += Measure([&]() {
+            sorted.Sort(BENCH_OPAQUE, [&draws](int a, int b) {
+                if (draws[a].distanceSq != draws[b].distanceSq) return draws[a].distanceSq < draws[b].distanceSq;
+                return a < b;
+            });
+        }) / iterations;
+    }
+
+    auto view = sorted.GetCategory(BENCH_OPAQUE);
+    for (size_t i = 0; i < view.GetSize(); i++) {
+        order.push_back(view[i]);
+    }
+
+    int programs = 0, materials = 0;
+    CountStateChanges(draws, order, &programs, &materials);
+
+    printf("%8zu | %-14s | %9.3f | %8d | %9d | %s\n", draws.size(), "comparator", sortTime, programs, materials, "-");
+
+    return true;
+}
+
+static bool RunKeyCase(const char* name, INX_SortPolicy policy, const std::vector<BenchDraw>& draws, int iterations)
+{
+    const size_t count = draws.size();
+
+    util::BucketArray<int, BenchCategory, BENCH_CATEGORY_COUNT> sorted{};
+    std::vector<uint64_t> keys(count);
+
+    /* --- Keys and radix sort, as done at the end of a pass --- */
+
+    double sortTime = 0.0;
+    for (int it = 0; it < iterations; it++) {
+        sorted.Clear();
+        for (size_t i = 0; i < count; i++) {
+            sorted.Push(BENCH_OPAQUE, static_cast<int>(i));
+        }
+        sortTime += Measure([&]() {
+            for (size_t i = 0; i < count; i++) {
+                keys[i] = INX_MakeSortKey(policy, draws[i].state, draws[i].distanceSq);
+            }
+            sorted.SortByKey(BENCH_OPAQUE, [&keys](int index) {
+                return keys[index];
+            });
+        }) / iterations;
+    }
+
+    std::vector<int> order;
+    auto view = sorted.GetCategory(BENCH_OPAQUE);
+    for (size_t i = 0; i < view.GetSize(); i++) {
+        order.push_back(view[i]);
+    }
+
+    /* --- Same order as a stable comparison sort of the keys --- */
+
+    std::vector<int> expected(count);
+    for (size_t i = 0; i < count; i++) {
+        expected[i] = static_cast<int>(i);
+    }
+    std::stable_sort(expected.begin(), expected.end(), [&keys](int a, int b) {
+        return keys[a] < keys[b];
+    });
+
+    bool match = (order == expected);
+
+    if (policy == INX_SORT_FRONT_TO_BACK) {
+        for (size_t i = 1; i < count && match; i++) {
+            match = (draws[order[i - 1]].distanceSq <= draws[order[i]].distanceSq);
+        }
+    }
+
+    int programs = 0, materials = 0;
+    CountStateChanges(draws, order, &programs, &materials);
+
+    printf("%8zu | %-14s | %9.3f | %8d | %9d | %s\n", count, name, sortTime, programs, materials, match ? "yes" : "NO");
+
+    return match;
+}
+
+// ============================================================================
+// ENTRY POINT
+// ============================================================================
+
+int main(void)
+{
+    const size_t counts[] = { 1000, 10000, 100000 };
+    const int programCount = 8;
+    const int materialCount = 64;
+    const int iterations = 20;
+
+    NX_RandGen gen = NX_CreateRandGenTemp(1337);
+    bool allMatch = true;
+
+    printf("%8s | %-14s | %9s | %8s | %9s | %s\n",
+           "count", "order", "sort (ms)", "programs", "materials", "match");
+
+    for (size_t count : counts)
+    {
+        std::vector<BenchDraw> draws;
+        GenDraws(draws, count, programCount, materialCount, &gen);
+
+        allMatch = RunDistanceCase(draws, iterations) && allMatch;
+        allMatch = RunKeyCase("front-to-back", INX_SORT_FRONT_TO_BACK, draws, iterations) && allMatch;
+        allMatch = RunKeyCase("state", INX_SORT_STATE, draws, iterations) && allMatch;
+    }
+
+    bool farthest = CheckFarthestDistance(&gen, 10000);
+    printf("farthest corner distance: %s\n", farthest ? "yes" : "NO");
+
+    return (allMatch && farthest) ? 0 : 1;
+}
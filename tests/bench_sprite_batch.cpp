@@ -0,0 +1,243 @@
+/* bench_sprite_batch.cpp -- Headless validation and benchmark of 2D sprite instance packing
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+/*
+ * Writes a large number of rotated sprites into CPU buffers, without any GPU work:
+ *
+ *   - As batched quads, like 'NX_DrawRect2D' through 'NX_Render2D' does: four
+ *     transformed vertices and six indices per sprite.
+ *   - As sprite instances, like 'NX_DrawSprites2D' does: one 32 bytes record
+ *     per sprite, the corners being generated by 'sprite.vert'.
+ *
+ * Throughputs are reported in sprites per second, along with the bytes written.
+ * For each transform kind the instance corners, expanded on the CPU like the
+ * vertex shader does, must match the quad corners; sheared transforms must be
+ * rejected so those sprites fall back to quads.
+ */
+
+#include <NX/Nexium.h>
+
+#include "INX_Sprite2D.hpp"
+#include "bench_common.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cmath>
+#include <vector>
+
+// ============================================================================
+// BENCH DATA
+// ============================================================================
+
+static std::vector<NX_Sprite2D> GenSprites(int count, NX_RandGen* gen)
+{
+    std::vector<NX_Sprite2D> sprites(count);
+
+    for (NX_Sprite2D& sprite : sprites) {
+        sprite.position = NX_VEC2(NX_RandRangeFloat(gen, 0.0f, 800.0f), NX_RandRangeFloat(gen, 0.0f, 450.0f));
+        sprite.size = NX_VEC2(NX_RandRangeFloat(gen, 8.0f, 64.0f), NX_RandRangeFloat(gen, 8.0f, 64.0f));
+        sprite.rotation = NX_RandRangeFloat(gen, -NX_PI, NX_PI);
+        sprite.uvRect = NX_Vec4 { 0.25f, 0.5f, 0.25f, 0.25f };
+        sprite.color = NX_ColorFromHSV(360 * NX_RandFloat(gen), 1, 1, 1);
+    }
+
+    return sprites;
+}
+
+// ============================================================================
+// WRITERS
+// ============================================================================
+
+static void LocalCorners(const NX_Sprite2D& sprite, NX_Vec2 corners[4])
+{
+    // Same corners as the quad fallback of 'NX_DrawSprites2D'
+    const float c = std::cos(sprite.rotation);
+    const float s = std::sin(sprite.rotation);
+    const NX_Vec2 dx = NX_VEC2(c, s) * (0.5f * sprite.size.x);
+    const NX_Vec2 dy = NX_VEC2(-s, c) * (0.5f * sprite.size.y);
+
+    corners[0] = sprite.position - dx - dy;
+    corners[1] = sprite.position + dx - dy;
+    corners[2] = sprite.position + dx + dy;
+    corners[3] = sprite.position - dx + dy;
+}
+
+static void WriteQuads(const std::vector<NX_Sprite2D>& sprites, const NX_Mat3& matrix,
+                       std::vector<NX_Vertex2D>* vertices, std::vector<uint16_t>* indices)
+{
+    NX_Vertex2D* v = vertices->data();
+    uint16_t* i = indices->data();
+    uint16_t base = 0;
+
+    for (const NX_Sprite2D& sprite : sprites)
+    {
+        NX_Vec2 corners[4];
+        LocalCorners(sprite, corners);
+
+        const NX_Vec4& uv = sprite.uvRect;
+        v[0] = NX_Vertex2D { corners[0] * matrix, NX_VEC2(uv.x, uv.y), sprite.color };
+        v[1] = NX_Vertex2D { corners[1] * matrix, NX_VEC2(uv.x + uv.z, uv.y), sprite.color };
+        v[2] = NX_Vertex2D { corners[2] * matrix, NX_VEC2(uv.x + uv.z, uv.y + uv.w), sprite.color };
+        v[3] = NX_Vertex2D { corners[3] * matrix, NX_VEC2(uv.x, uv.y + uv.w), sprite.color };
+
+        i[0] = base + 0, i[1] = base + 1, i[2] = base + 2;
+        i[3] = base + 0, i[4] = base + 2, i[5] = base + 3;
+
+        v += 4, i += 6, base += 4; //< Wraps like a 16-bit batch would be flushed
+    }
+}
+
+static int WriteInstances(const std::vector<NX_Sprite2D>& sprites, const INX_SpriteTransform2D& transform,
+                          std::vector<INX_SpriteInstance2D>* instances)
+{
+    INX_SpriteInstance2D* out = instances->data();
+    int count = 0;
+
+    for (const NX_Sprite2D& sprite : sprites) {
+        if (INX_CanPackSprite2D(transform, sprite)) {
+            INX_PackSprite2D(&out[count++], sprite, transform);
+        }
+    }
+
+    return count;
+}
+
+static void ExpandInstance(const INX_SpriteInstance2D& instance, NX_Vec2 corners[4])
+{
+    // Same expansion as 'sprite.vert', in the order of 'LocalCorners'
+    static const NX_Vec2 local[4] = {
+        { -0.5f, -0.5f }, { 0.5f, -0.5f }, { 0.5f, 0.5f }, { -0.5f, 0.5f }
+    };
+
+    const float c = std::cos(instance.rotation);
+    const float s = std::sin(instance.rotation);
+
+    for (int i = 0; i < 4; i++) {
+        NX_Vec2 p = NX_VEC2(local[i].x * instance.size.x, local[i].y * instance.size.y);
+        corners[i] = instance.position + NX_VEC2(c * p.x - s * p.y, s * p.x + c * p.y);
+    }
+}
+
+static bool CheckTransform(const std::vector<NX_Sprite2D>& sprites, const NX_Mat3& matrix, bool expectPacked)
+{
+    const INX_SpriteTransform2D transform = INX_MakeSpriteTransform2D(matrix);
+
+    for (const NX_Sprite2D& sprite : sprites)
+    {
+        if (!INX_CanPackSprite2D(transform, sprite)) {
+            if (expectPacked && sprite.rotation != 0.0f) return false;
+            continue;
+        }
+
+        NX_Vec2 expected[4], corners[4];
+        LocalCorners(sprite, expected);
+
+        INX_SpriteInstance2D instance;
+        INX_PackSprite2D(&instance, sprite, transform);
+        ExpandInstance(instance, corners);
+
+        for (int i = 0; i < 4; i++) {
+            NX_Vec2 e = expected[i] * matrix;
+            float tolerance = 1e-3f * std::max(1.0f, std::max(std::fabs(e.x), std::fabs(e.y)));
+            if (std::fabs(e.x - corners[i].x) > tolerance || std::fabs(e.y - corners[i].y) > tolerance) {
+                return false;
+            }
+        }
+    }
+
+    // Rotated sprites under a non similar transform must all be rejected
+    if (!transform.similar) {
+        for (const NX_Sprite2D& sprite : sprites) {
+            if (sprite.rotation != 0.0f && INX_CanPackSprite2D(transform, sprite)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// ============================================================================
+// ENTRY POINT
+// ============================================================================
+
+int main(void)
+{
+    const int spriteCount = 1 << 20;
+    const int iterations = 5;
+
+    NX_RandGen gen = NX_CreateRandGenTemp(1337);
+    std::vector<NX_Sprite2D> sprites = GenSprites(spriteCount, &gen);
+
+    /* --- Throughput under a similarity --- */
+
+    const NX_Mat3 matrix = NX_Mat3Transform2D(NX_VEC2(400.0f, 225.0f), 0.3f, NX_VEC2(1.5f, 1.5f));
+    const INX_SpriteTransform2D transform = INX_MakeSpriteTransform2D(matrix);
+
+    std::vector<NX_Vertex2D> vertices(4 * spriteCount);
+    std::vector<uint16_t> indices(6 * spriteCount);
+    std::vector<INX_SpriteInstance2D> instances(spriteCount);
+
+    printf("Sprites: %i\n", spriteCount);
+    printf("%-24s | %12s | %14s | %10s\n", "path", "time (ms)", "sprites/s", "bytes/spr");
+
+    double quadTime = 1e30;
+    for (int it = 0; it < iterations; it++) {
+        quadTime = std::min(quadTime, Measure([&]() {
+            WriteQuads(sprites, matrix, &vertices, &indices);
+        }));
+    }
+
+    printf("%-24s | %12.3f | %14.0f | %10zu\n", "quads", quadTime, spriteCount / (quadTime / 1000.0),
+           4 * sizeof(NX_Vertex2D) + 6 * sizeof(uint16_t));
+
+    int packed = 0;
+    double instanceTime = 1e30;
+    for (int it = 0; it < iterations; it++) {
+        instanceTime = std::min(instanceTime, Measure([&]() {
+            packed = WriteInstances(sprites, transform, &instances);
+        }));
+    }
+
+    printf("%-24s | %12.3f | %14.0f | %10zu\n", "instances", instanceTime, spriteCount / (instanceTime / 1000.0),
+           sizeof(INX_SpriteInstance2D));
+
+    /* --- Instance corners against quad corners --- */
+
+    struct Case { const char* name; NX_Mat3 matrix; bool similar; };
+
+    const Case cases[] = {
+        { "identity", NX_MAT3_IDENTITY, true },
+        { "translation", NX_Mat3Translate2D(NX_VEC2(12.5f, -40.0f)), true },
+        { "similarity", matrix, true },
+        { "mirrored", NX_Mat3Transform2D(NX_VEC2(100.0f, 50.0f), -1.1f, NX_VEC2(-2.0f, 2.0f)), true },
+        { "axis aligned", NX_Mat3Scale2D(NX_VEC2(2.0f, 0.5f)), false },
+        { "sheared", NX_Mat3Scale2D(NX_VEC2(3.0f, 1.0f)) * NX_Mat3Rotate2D(0.7f), false },
+    };
+
+    bool allMatch = (packed == spriteCount);
+
+    printf("%-24s | %s\n", "transform", "match");
+
+    for (const Case& c : cases) {
+        bool match = CheckTransform(sprites, c.matrix, c.similar);
+        printf("%-24s | %s\n", c.name, match ? "yes" : "NO");
+        allMatch &= match;
+    }
+
+    /* --- Texture regions outside of the texture keep the quad path --- */
+
+    NX_Sprite2D repeated = sprites[0];
+    repeated.uvRect = NX_Vec4 { -0.5f, 0.0f, 2.0f, 3.0f };
+
+    bool repeatedQuad = !INX_CanPackSprite2D(INX_MakeSpriteTransform2D(NX_MAT3_IDENTITY), repeated);
+    printf("%-24s | %s\n", "repeated uv as quad", repeatedQuad ? "yes" : "NO");
+    allMatch &= repeatedQuad;
+
+    return allMatch ? 0 : 1;
+}
@@ -0,0 +1,210 @@
+/* bench_texture_sharing.cpp -- Headless validation and benchmark of the texture sharing between imported models
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+/*
+ * Imports the test models up to their decoded images, without any GPU work.
+ * The decoded maps are then registered as shared textures, with placeholders
+ * holding no GL object, as the upload steps would do.
+ *
+ * Importing the models again must find every map among the shared textures
+ * and decode nothing, unless the sampler differs. Reports the time taken by
+ * both imports, along with the hits and bytes saved.
+ */
+
+#include <NX/Nexium.h>
+
+#include "Importer/ModelImporter.hpp"
+#include "Importer/SceneImporter.hpp"
+#include "INX_GlobalPool.hpp"
+#include "INX_JobSystem.hpp"
+#include "NX_Filesystem.hpp"
+#include "INX_Utils.hpp"
+#include "bench_common.hpp"
+
+#include <cstdio>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+static const char* Models[] = {
+    "models/CesiumMan.glb",
+    "models/DamagedHelmet.glb",
+    "models/MultiUVTest.glb",
+};
+
+static constexpr int ModelCount = sizeof(Models) / sizeof(Models[0]);
+
+struct ImportCounts {
+    int maps;           //< Maps with a texture
+    int decoded;        //< Maps decoded by this import
+    int shared;         //< Maps given a shared texture before decoding
+};
+
+static ImportCounts Count(const import::ModelData& model)
+{
+    ImportCounts counts{};
+    for (size_t i = 0; i < model.materials.GetSize(); i++) {
+        for (const import::ModelData::Image& image : model.materials[i].images) {
+            counts.maps += (image.key != 0);
+            counts.decoded += (image.image.pixels != nullptr);
+            counts.shared += (image.texture != nullptr);
+        }
+    }
+    return counts;
+}
+
+/** Imports every model, returns the time taken in milliseconds */
+static double ImportAll(std::vector<std::unique_ptr<import::ModelData>>* models)
+{
+    models->clear();
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (const char* path : Models)
+    {
+        auto model = std::make_unique<import::ModelData>();
+
+        size_t fileSize = 0;
+        void* fileData = NX_LoadFile(path, &fileSize);
+        {
+            import::SceneImporter importer(fileData, fileSize, INX_GetFileExt(path));
+            if (importer.IsValid()) {
+                import::ModelImporter(importer).LoadModel(model.get());
+            }
+        }
+        NX_Free(fileData);
+
+        models->push_back(std::move(model));
+    }
+
+    return Elapsed(start);
+}
+
+/** Registers the decoded maps like the upload steps, with placeholder textures */
+static void ShareDecoded(std::vector<std::unique_ptr<import::ModelData>>& models, std::vector<NX_Texture*>* textures)
+{
+    for (auto& model : models) {
+        for (size_t i = 0; i < model->materials.GetSize(); i++) {
+            for (import::ModelData::Image& image : model->materials[i].images) {
+                if (image.image.pixels == nullptr) continue;
+                NX_Texture* texture = INX_Pool.Create<NX_Texture>();
+                size_t bytes = size_t(NX_GetPixelBytes(image.image.format)) * image.image.w * image.image.h;
+                INX_Pool.ShareTexture(texture, image.key, bytes);
+                textures->push_back(texture);
+            }
+        }
+    }
+}
+
+static ImportCounts Total(const std::vector<std::unique_ptr<import::ModelData>>& models)
+{
+    ImportCounts total{};
+    for (const auto& model : models) {
+        ImportCounts counts = Count(*model);
+        total.maps += counts.maps;
+        total.decoded += counts.decoded;
+        total.shared += counts.shared;
+    }
+    return total;
+}
+
+// ============================================================================
+// ENTRY POINT
+// ============================================================================
+
+int main(void)
+{
+    if (!INX_FilesystemState_Init() || !NX_AddSearchPath(RESOURCES_PATH, true)) {
+        printf("Failed to mount the test resources\n");
+        return 1;
+    }
+
+    INX_Jobs.Init(-1);
+
+    std::vector<std::unique_ptr<import::ModelData>> first, second, other;
+    std::vector<NX_Texture*> textures;
+
+    /* --- First import, everything is decoded --- */
+
+    printf("First import\n");
+
+    double firstMs = ImportAll(&first);
+    ImportCounts firstCounts = Total(first);
+    {
+        Check(firstCounts.maps > 0, "the models have textured materials");
+        Check(firstCounts.shared == 0, "no texture is shared yet");
+        Check(firstCounts.decoded == firstCounts.maps, "every map is decoded once");
+
+        ShareDecoded(first, &textures);
+        first.clear();
+
+        NX_TextureImportStats stats = NX_GetTextureImportStats();
+        Check(stats.textures == firstCounts.decoded, "every decoded map is registered");
+    }
+
+    /* --- Second import, everything is shared --- */
+
+    printf("Second import\n");
+
+    double secondMs = ImportAll(&second);
+    ImportCounts secondCounts = Total(second);
+    {
+        NX_TextureImportStats stats = NX_GetTextureImportStats();
+
+        Check(secondCounts.maps == firstCounts.maps, "the same maps are found");
+        Check(secondCounts.decoded == 0, "no map is decoded again");
+        Check(secondCounts.shared == secondCounts.maps, "every map gets the texture of the first import");
+        Check(stats.hits == secondCounts.maps, "every map counts as a hit");
+        Check(stats.references == 2 * secondCounts.maps, "each map holds a reference");
+
+        printf("  %i maps, %.1f ms decoding, %.1f ms sharing, %.1f MB saved\n",
+               secondCounts.maps, firstMs, secondMs, stats.bytesSaved / (1024.0 * 1024.0));
+    }
+
+    /* --- Another sampler, nothing is shared --- */
+
+    printf("Sampler\n");
+    {
+        NX_TextureFilter filter = NX_GetDefaultTextureFilter();
+        NX_SetDefaultTextureFilter(filter == NX_TEXTURE_FILTER_POINT ? NX_TEXTURE_FILTER_BILINEAR : NX_TEXTURE_FILTER_POINT);
+        ImportAll(&other);
+        NX_SetDefaultTextureFilter(filter);
+
+        ImportCounts counts = Total(other);
+        Check(counts.shared == 0 && counts.decoded == counts.maps, "textures with another filter are decoded again");
+        other.clear();
+    }
+
+    /* --- Release --- */
+
+    printf("Release\n");
+    {
+        second.clear();
+
+        NX_TextureImportStats stats = NX_GetTextureImportStats();
+        Check(stats.references == static_cast<int>(textures.size()), "imports release their references");
+
+        for (NX_Texture* texture : textures) {
+            NX_DestroyTexture(texture);
+        }
+
+        stats = NX_GetTextureImportStats();
+        Check(stats.textures == 0 && stats.references == 0, "textures leave the registry with their last reference");
+        Check(INX_Pool.Get<NX_Texture>().IsEmpty(), "textures are destroyed with their last reference");
+    }
+
+    INX_Jobs.Quit();
+
+    printf("%s\n", Failures ? "FAILED" : "All checks passed");
+
+    return Failures ? 1 : 0;
+}
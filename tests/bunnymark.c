@@ -20,7 +20,9 @@ typedef struct {
 } Bunny;
 
 static Bunny bunnies[MAX_BUNNIES];
+static NX_Sprite2D sprites[MAX_BUNNIES];
 static int bunnyCount = 0;
+static bool useSprites = false;
 
 /* --- Bunny Functions --- */
 
@@ -54,6 +56,15 @@ static void Bunny_Draw(const Bunny* bunny)
     NX_DrawRect2D(bunny->position.x - 16, bunny->position.y - 16, 32, 32);
 }
 
+static void Bunny_ToSprite(const Bunny* bunny, NX_Sprite2D* sprite)
+{
+    *sprite = (NX_Sprite2D) {
+        .position = bunny->position,
+        .size = NX_VEC2(32, 32),
+        .color = bunny->color
+    };
+}
+
 /* --- Main Program --- */
 
 int main(void)
@@ -77,10 +88,17 @@ int main(void)
     {
         /* --- Update window title --- */
 
+        NX_Render2DStats stats = NX_GetRender2DStats();
+
         NX_SetWindowTitle(CMN_FormatText(
-            "Nexium - BunnyMark - Bunnies: %i - FPS: %i", bunnyCount, NX_GetFPS()
+            "Nexium - BunnyMark - Bunnies: %i - FPS: %i - %s (SPACE) - Draw calls: %i",
+            bunnyCount, NX_GetFPS(), useSprites ? "Sprites" : "Quads", stats.drawCalls
         ));
 
+        if (NX_IsKeyJustPressed(NX_KEY_SPACE)) {
+            useSprites = !useSprites;
+        }
+
         float delta = NX_GetDeltaTime();
 
         /* --- Add new bunnies on mouse press --- */
@@ -94,9 +112,18 @@ int main(void)
         /* --- 2D Rendering --- */
 
         NX_Begin2D(NULL);
-        for (int i = 0; i < bunnyCount; i++) {
-            Bunny_Update(&bunnies[i], delta);
-            Bunny_Draw(&bunnies[i]);
+        if (useSprites) {
+            for (int i = 0; i < bunnyCount; i++) {
+                Bunny_Update(&bunnies[i], delta);
+                Bunny_ToSprite(&bunnies[i], &sprites[i]);
+            }
+            NX_DrawSprites2D(sprites, bunnyCount);
+        }
+        else {
+            for (int i = 0; i < bunnyCount; i++) {
+                Bunny_Update(&bunnies[i], delta);
+                Bunny_Draw(&bunnies[i]);
+            }
         }
         NX_End2D();
     }
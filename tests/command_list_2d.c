@@ -0,0 +1,118 @@
+/* command_list_2d.c -- Test of recorded 2D command lists
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#include <NX/Nexium.h>
+#include "./common.h"
+
+/* --- Recording --- */
+
+static void RecordGauge(NX_CommandList2D* gauge)
+{
+    NX_BeginCommandList2D(gauge);
+    {
+        NX_SetColor2D(NX_DARK_GRAY);
+        NX_DrawCircle2D(NX_VEC2_ZERO, 40, 64);
+
+        NX_SetColor2D(NX_LIGHT_GRAY);
+        NX_DrawRing2D(NX_VEC2_ZERO, 34, 40, 64);
+
+        for (int i = 0; i <= 10; i++) {
+            float angle = NX_PI * (0.75f + 1.5f * i / 10.0f);
+            NX_Vec2 dir = NX_VEC2(cosf(angle), sinf(angle));
+            NX_DrawLine2D(NX_Vec2Scale(dir, 26), NX_Vec2Scale(dir, 32), 2);
+        }
+    }
+    NX_EndCommandList2D();
+}
+
+static void RecordPanel(NX_CommandList2D* panel, const NX_CommandList2D* gauge, int gaugeCount)
+{
+    NX_BeginCommandList2D(panel);
+    {
+        NX_SetColor2D(NX_COLOR(0.1f, 0.1f, 0.15f, 0.9f));
+        NX_DrawRectRounded2D(0, 0, 110 * gaugeCount + 10, 120, 12, 16);
+
+        NX_SetColor2D(NX_WHITE);
+        NX_DrawRectRoundedBorder2D(0, 0, 110 * gaugeCount + 10, 120, 12, 16, 2);
+        NX_DrawText2D("Recorded panel", NX_VEC2(12, 6), 16, NX_VEC2_ONE);
+
+        // Lists are composed by drawing them while recording
+        for (int i = 0; i < gaugeCount; i++) {
+            NX_DrawCommandList2D(gauge, NX_VEC2(65 + 110 * i, 70));
+        }
+    }
+    NX_EndCommandList2D();
+}
+
+/* --- Main Program --- */
+
+int main(void)
+{
+    NX_AppDesc desc = {
+        .render2D.resolution = { 800, 450 },
+        .flags = NX_FLAG_VSYNC_HINT,
+        .targetFPS = 60
+    };
+
+    NX_InitEx("Nexium - Command List 2D", 800, 450, &desc);
+    NX_AddSearchPath(RESOURCES_PATH, false);
+
+    NX_CommandList2D* gauge = NX_CreateCommandList2D();
+    NX_CommandList2D* panel = NX_CreateCommandList2D();
+
+    int gaugeCount = 3;
+
+    RecordGauge(gauge);
+    RecordPanel(panel, gauge, gaugeCount);
+
+    while (NX_FrameStep())
+    {
+        /* --- Record again only when the content changes --- */
+
+        if (NX_IsKeyJustPressed(NX_KEY_SPACE)) {
+            gaugeCount = 1 + gaugeCount % 6;
+            RecordPanel(panel, gauge, gaugeCount);
+        }
+
+        float time = (float)NX_GetElapsedTime();
+
+        /* --- Replay the panels with their own transform and tint --- */
+
+        NX_Begin2D(NULL);
+        {
+            NX_SetColor2D(NX_BLACK);
+            NX_DrawRect2D(0, 0, NX_GetWindowWidth(), NX_GetWindowHeight());
+
+            NX_SetColor2D(NX_WHITE);
+            NX_DrawCommandList2D(panel, NX_VEC2(20, 20));
+
+            NX_Push2D();
+            NX_Translate2D(NX_VEC2(400, 300));
+            NX_Rotate2D(0.25f * sinf(time));
+            NX_SetColor2D(NX_ColorFromHSV(fmodf(60 * time, 360), 0.5f, 1, 1));
+            NX_DrawCommandList2D(panel, NX_VEC2(-60 * gaugeCount, -60));
+            NX_Pop2D();
+
+            NX_Render2DStats stats = NX_GetRender2DStats();
+
+            NX_SetColor2D(NX_YELLOW);
+            NX_DrawText2D(
+                CMN_FormatText("Gauges: %i (SPACE) - Recorded draws: %i - Draw calls: %i",
+                               gaugeCount, NX_GetCommandList2DDrawCount(panel), stats.drawCalls),
+                NX_VEC2(10, NX_GetWindowHeight() - 26), 16, NX_VEC2_ONE
+            );
+        }
+        NX_End2D();
+    }
+
+    NX_DestroyCommandList2D(panel);
+    NX_DestroyCommandList2D(gauge);
+    NX_Quit();
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+/* scene_objects.c -- Retained scene objects test, mostly static with a few moving ones
+ *
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * For conditions of distribution and use, see accompanying LICENSE file.
+ */
+
+#include <NX/Nexium.h>
+#include "./common.h"
+
+#define GRID_SIZE 21
+#define OBJECT_COUNT (GRID_SIZE * GRID_SIZE * GRID_SIZE)
+#define MOVING_STRIDE 64
+
+int main(void)
+{
+    /* --- Initialize application --- */
+
+    NX_AppDesc desc = {
+        .render3D.resolution = { 800, 600 },
+        .render3D.sampleCount = 4,
+    };
+
+    NX_InitEx("Nexium - Scene Objects", 800, 450, &desc);
+
+    /* --- Create cube mesh and unlit material --- */
+
+    NX_Mesh* cube = NX_GenMeshCube(NX_VEC3_1(0.5f), NX_IVEC3_ONE);
+    NX_Material material = NX_GetDefaultMaterial();
+    material.shading = NX_SHADING_UNLIT;
+
+    /* --- Create the scene objects once --- */
+
+    static NX_SceneObject* objects[OBJECT_COUNT];
+    static NX_Vec3 positions[OBJECT_COUNT];
+
+    int index = 0;
+    for (int z = -10; z <= 10; z++)
+     for (int y = -10; y <= 10; y++)
+      for (float x = -10; x <= 10; x++) {
+        material.albedo.color = NX_ColorFromHSV(NX_Remap(x, -10, 10, 0, 360), 1, 1, 1);
+
+        NX_Transform transform = NX_TRANSFORM_IDENTITY;
+        transform.translation = NX_VEC3(x, y, z);
+
+        objects[index] = NX_CreateSceneObject(cube, &material);
+        NX_SetSceneObjectTransform(objects[index], &transform);
+        positions[index++] = transform.translation;
+    }
+
+    /* --- Main loop --- */
+
+    while (NX_FrameStep())
+    {
+        /* --- Only a fraction of the objects are updated each frame --- */
+
+        float time = NX_GetElapsedTime();
+
+        for (int i = 0; i < OBJECT_COUNT; i += MOVING_STRIDE) {
+            NX_Transform transform = NX_TRANSFORM_IDENTITY;
+            transform.translation = positions[i];
+            transform.translation.y += 0.5f * sinf(time * 2.0f + i);
+            NX_SetSceneObjectTransform(objects[i], &transform);
+        }
+
+        /* --- 3D rendering --- */
+
+        NX_Begin3D(NULL, NULL, NX_RENDER_FRUSTUM_CULLING);
+        NX_End3D();
+
+        /* --- 2D overlay --- */
+
+        NX_Begin2D(NULL);
+        NX_SetColor2D(NX_BLACK);
+        NX_DrawText2D(
+            CMN_FormatText("FPS: %i", NX_GetFPS()),
+            NX_VEC2(10, 10), 16, NX_VEC2_ONE
+        );
+        NX_End2D();
+    }
+
+    /* --- Cleanup --- */
+
+    for (int i = 0; i < OBJECT_COUNT; i++) {
+        NX_DestroySceneObject(objects[i]);
+    }
+
+    NX_DestroyMesh(cube);
+    NX_Quit();
+
+    return 0;
+}